@@ -85,6 +85,20 @@ struct whc_seq_entry {
 };
 #endif
 
+/* Volatile writers index their samples by sequence number in a ring array: they only retain
+   samples that have not been acknowledged by all readers yet, so the sequence numbers in the WHC
+   span a limited range and finding one is a matter of indexing.  Transient-local writers may
+   retain arbitrarily old samples and use a hash table instead, as does a volatile writer once its
+   sequence numbers become so sparse that the ring array would be mostly empty. */
+#define WHC_SEQ_RING_INITIAL_SIZE 64u
+#define WHC_SEQ_RING_MIN_OCCUPANCY 8u /* at least 1 in 8 slots in use when growing */
+
+struct whc_seq_ring {
+  struct whc_node **nodes; /* NULL if samples are indexed in seq_hash */
+  uint32_t size; /* power of 2 */
+  seqno_t base; /* samples with seq in [base, base + size) are at nodes[seq % size] */
+};
+
 struct whc_writer_info {
   dds_writer * writer; /* can be NULL, eg in case of whc for built-in writers */
   unsigned is_transient_local: 1;
@@ -109,10 +123,11 @@ struct whc_impl {
   seqno_t max_drop_seq; /* samples in whc with seq <= max_drop_seq => transient-local */
   struct whc_intvnode *open_intv; /* interval where next sample will go (usually) */
   struct whc_node *maxseq_node; /* NULL if empty; if not in open_intv, open_intv is empty */
+  struct whc_seq_ring seq_ring;
 #if USE_EHH
-  struct ddsrt_ehh *seq_hash;
+  struct ddsrt_ehh *seq_hash; /* NULL if samples are indexed in seq_ring */
 #else
-  struct ddsrt_hh *seq_hash;
+  struct ddsrt_hh *seq_hash; /* NULL if samples are indexed in seq_ring */
 #endif
   struct ddsrt_hh *idx_hash;
   ddsrt_avl_tree_t seq;
@@ -316,9 +331,20 @@ static void check_whc (const struct whc_impl *whc)
 #endif
 }
 
-static void insert_whcn_in_hash (struct whc_impl *whc, struct whc_node *whcn)
+#if USE_EHH
+static struct ddsrt_ehh *whc_seq_hash_new (void)
+{
+  return ddsrt_ehh_new (sizeof (struct whc_seq_entry), 32, whc_seq_entry_hash, whc_seq_entry_eq);
+}
+#else
+static struct ddsrt_hh *whc_seq_hash_new (void)
+{
+  return ddsrt_hh_new (1, whc_node_hash, whc_node_eq);
+}
+#endif
+
+static void insert_whcn_in_seq_hash (struct whc_impl *whc, struct whc_node *whcn)
 {
-  /* precondition: whcn is not in hash */
 #if USE_EHH
   struct whc_seq_entry e = { .seq = whcn->seq, .whcn = whcn };
   if (!ddsrt_ehh_add (whc->seq_hash, &e))
@@ -329,9 +355,81 @@ static void insert_whcn_in_hash (struct whc_impl *whc, struct whc_node *whcn)
 #endif
 }
 
+static uint32_t whc_seq_ring_pos (const struct whc_seq_ring *ring, seqno_t seq)
+{
+  return (uint32_t) seq & (ring->size - 1);
+}
+
+static void whc_seq_ring_to_hash (struct whc_impl *whc)
+{
+  struct whc_seq_ring * const ring = &whc->seq_ring;
+  TRACE ("whc_seq_ring_to_hash(%p size %"PRIu32" samples %"PRIu32")\n", (void *) whc, ring->size, whc->seq_size);
+  whc->seq_hash = whc_seq_hash_new ();
+  for (uint32_t i = 0; i < ring->size; i++)
+  {
+    if (ring->nodes[i])
+      insert_whcn_in_seq_hash (whc, ring->nodes[i]);
+  }
+  ddsrt_free (ring->nodes);
+  ring->nodes = NULL;
+}
+
+static bool whc_seq_ring_insert (struct whc_impl *whc, struct whc_node *whcn)
+{
+  /* Returns false if the ring array has been replaced by a hash table and whcn still needs
+     to be added to it */
+  struct whc_seq_ring * const ring = &whc->seq_ring;
+  if (whcn->seq - ring->base >= ring->size)
+  {
+    /* Sequence numbers only increase, so the ring can move up to the lowest sequence number
+       in the WHC (whcn is not in the interval tree yet), and if that doesn't suffice, grow */
+    const struct whc_intvnode *intv = ddsrt_avl_find_min (&whc_seq_treedef, &whc->seq);
+    ring->base = (whc->seq_size == 0) ? whcn->seq : intv->min;
+    assert (whcn->seq >= ring->base);
+    const uint64_t span = (uint64_t) (whcn->seq - ring->base) + 1;
+    if (span > ring->size)
+    {
+      uint64_t size = ring->size;
+      while (size < span)
+        size *= 2;
+      if (size > UINT32_MAX / 2 || size > ((uint64_t) whc->seq_size + 1) * WHC_SEQ_RING_MIN_OCCUPANCY)
+      {
+        whc_seq_ring_to_hash (whc);
+        return false;
+      }
+      struct whc_node **nodes = ddsrt_calloc ((size_t) size, sizeof (*nodes));
+      for (uint32_t i = 0; i < ring->size; i++)
+      {
+        if (ring->nodes[i])
+          nodes[(uint32_t) ring->nodes[i]->seq & (uint32_t) (size - 1)] = ring->nodes[i];
+      }
+      ddsrt_free (ring->nodes);
+      ring->nodes = nodes;
+      ring->size = (uint32_t) size;
+    }
+  }
+  assert (ring->nodes[whc_seq_ring_pos (ring, whcn->seq)] == NULL);
+  ring->nodes[whc_seq_ring_pos (ring, whcn->seq)] = whcn;
+  return true;
+}
+
+static void insert_whcn_in_hash (struct whc_impl *whc, struct whc_node *whcn)
+{
+  /* precondition: whcn is not in hash */
+  if (whc->seq_ring.nodes == NULL || !whc_seq_ring_insert (whc, whcn))
+    insert_whcn_in_seq_hash (whc, whcn);
+}
+
 static void remove_whcn_from_hash (struct whc_impl *whc, struct whc_node *whcn)
 {
   /* precondition: whcn is in hash */
+  if (whc->seq_ring.nodes != NULL)
+  {
+    const uint32_t pos = whc_seq_ring_pos (&whc->seq_ring, whcn->seq);
+    assert (whc->seq_ring.nodes[pos] == whcn);
+    whc->seq_ring.nodes[pos] = NULL;
+    return;
+  }
 #if USE_EHH
   struct whc_seq_entry e = { .seq = whcn->seq };
   if (!ddsrt_ehh_remove (whc->seq_hash, &e))
@@ -344,6 +442,13 @@ static void remove_whcn_from_hash (struct whc_impl *whc, struct whc_node *whcn)
 
 static struct whc_node *whc_findseq (const struct whc_impl *whc, seqno_t seq)
 {
+  if (whc->seq_ring.nodes != NULL)
+  {
+    const struct whc_seq_ring * const ring = &whc->seq_ring;
+    if (seq < ring->base || seq - ring->base >= ring->size)
+      return NULL;
+    return ring->nodes[whc_seq_ring_pos (ring, seq)];
+  }
 #if USE_EHH
   struct whc_seq_entry e = { .seq = seq }, *r;
   if ((r = ddsrt_ehh_lookup (whc->seq_hash, &e)) != NULL)
@@ -465,11 +570,18 @@ struct whc *whc_new (struct ddsi_domaingv *gv, const struct whc_writer_info *wri
   whc->sample_overhead = sample_overhead;
   whc->fragment_size = gv->config.fragment_size;
   whc->idx_hash = ddsrt_hh_new (1, whc_idxnode_hash_key, whc_idxnode_eq_key);
-#if USE_EHH
-  whc->seq_hash = ddsrt_ehh_new (sizeof (struct whc_seq_entry), 32, whc_seq_entry_hash, whc_seq_entry_eq);
-#else
-  whc->seq_hash = ddsrt_hh_new (1, whc_node_hash, whc_node_eq);
-#endif
+  if (wrinfo->is_transient_local)
+  {
+    whc->seq_ring.nodes = NULL;
+    whc->seq_hash = whc_seq_hash_new ();
+  }
+  else
+  {
+    whc->seq_ring.nodes = ddsrt_calloc (WHC_SEQ_RING_INITIAL_SIZE, sizeof (*whc->seq_ring.nodes));
+    whc->seq_ring.size = WHC_SEQ_RING_INITIAL_SIZE;
+    whc->seq_ring.base = 1;
+    whc->seq_hash = NULL;
+  }
 
 #ifdef DDS_HAS_LIFESPAN
   lifespan_init (gv, &whc->lifespan, offsetof(struct whc_impl, lifespan), offsetof(struct whc_node, lifespan), whc_sample_expired_cb);
@@ -553,11 +665,16 @@ void whc_default_free (struct whc *whc_generic)
     nn_freelist_fini (&whc_node_freelist, ddsrt_free);
   ddsrt_mutex_unlock (&dds_global.m_mutex);
 
+  if (whc->seq_ring.nodes != NULL)
+    ddsrt_free (whc->seq_ring.nodes);
+  else
+  {
 #if USE_EHH
-  ddsrt_ehh_free (whc->seq_hash);
+    ddsrt_ehh_free (whc->seq_hash);
 #else
-  ddsrt_hh_free (whc->seq_hash);
+    ddsrt_hh_free (whc->seq_hash);
 #endif
+  }
   ddsrt_mutex_destroy (&whc->lock);
   ddsrt_free (whc);
 }
@@ -66,24 +66,77 @@ static bool deregister_pub_loan(dds_writer *wr, const void *pub_loan)
     return false;
 }
 
-static void *create_iox_chunk(dds_writer *wr)
+/* Loans a chunk for a sample of sample_size bytes.  Chunks held by subscribers are returned
+   eventually, so running out of them is waited out for at most the max blocking time of the
+   writer, like a full writer history cache.  The other failures do not go away by waiting:
+   the writer itself holds too many loans, or no mempool has chunks this large. */
+static dds_return_t create_iox_chunk(dds_writer *wr, uint32_t sample_size, void **sample)
 {
     iceoryx_header_t *ice_hdr;
-    void *sample;
-    uint32_t sample_size = wr->m_topic->m_stype->iox_size;
     uint32_t chunk_size = DETERMINE_ICEORYX_CHUNK_SIZE(sample_size);
+    ddsrt_mtime_t timeout = { 0 };
     while (1)
     {
       enum iox_AllocationResult alloc_result = iox_pub_loan_chunk(wr->m_iox_pub, (void **) &ice_hdr, chunk_size);
       if (AllocationResult_SUCCESS == alloc_result)
         break;
-      // SHM_TODO: Maybe there is a better way to do while unable to allocate.
-      //           BTW, how long I should sleep is also another problem.
+      else if (AllocationResult_TOO_MANY_CHUNKS_ALLOCATED_IN_PARALLEL == alloc_result)
+        return DDS_RETCODE_OUT_OF_RESOURCES;
+      else if (AllocationResult_RUNNING_OUT_OF_CHUNKS != alloc_result)
+        return DDS_RETCODE_ERROR;
+
+      ddsrt_mtime_t tnow = ddsrt_time_monotonic ();
+      if (timeout.v == 0)
+        timeout = ddsrt_mtime_add_duration (tnow, wr->m_wr->xqos->reliability.max_blocking_time);
+      if (tnow.v >= timeout.v)
+        return DDS_RETCODE_TIMEOUT;
       dds_sleepfor (DDS_MSECS (1));
     }
     ice_hdr->data_size = sample_size;
-    sample = SHIFT_PAST_ICEORYX_HEADER(ice_hdr);
-    return sample;
+    ice_hdr->data_state = IOX_CHUNK_CONTAINS_RAW_DATA;
+    *sample = SHIFT_PAST_ICEORYX_HEADER(ice_hdr);
+    return DDS_RETCODE_OK;
+}
+
+/* Copies a sample of a type with a fixed size into a chunk, replacing data by the copy */
+static dds_return_t copy_into_iox_chunk(dds_writer *wr, const void **data)
+{
+    void *pub_loan;
+    dds_return_t ret;
+    if ((ret = create_iox_chunk(wr, wr->m_topic->m_stype->iox_size, &pub_loan)) != DDS_RETCODE_OK)
+      return ret;
+    memcpy (pub_loan, *data, wr->m_topic->m_stype->iox_size);
+    *data = pub_loan;
+    return DDS_RETCODE_OK;
+}
+
+/* Returns the chunk of a serdata that was not published to the publisher */
+static void release_iox_chunk(dds_writer *wr, struct ddsi_serdata *d)
+{
+    if (wr != NULL && wr->m_iox_pub != NULL && d->iox_chunk != NULL)
+    {
+      iox_pub_release_chunk (wr->m_iox_pub, d->iox_chunk);
+      d->iox_chunk = NULL;
+    }
+}
+
+/* Copies the serialized sample into a chunk for types that are exchanged serialized in shared
+   memory, failing if it exceeds the size the type allows for */
+static dds_return_t serialize_into_iox_chunk(dds_writer *wr, struct ddsi_serdata *d)
+{
+    iceoryx_header_t *ice_hdr;
+    void *chunk;
+    dds_return_t ret;
+    uint32_t size = ddsi_serdata_size (d);
+    if (size > wr->m_topic->m_stype->iox_size)
+      return DDS_RETCODE_OUT_OF_RESOURCES;
+    if ((ret = create_iox_chunk(wr, size, &chunk)) != DDS_RETCODE_OK)
+      return ret;
+    ddsi_serdata_to_ser (d, 0, size, chunk);
+    ice_hdr = SHIFT_BACK_TO_ICEORYX_HEADER(chunk);
+    ice_hdr->data_state = IOX_CHUNK_CONTAINS_SERIALIZED_DATA;
+    d->iox_chunk = ice_hdr;
+    return DDS_RETCODE_OK;
 }
 #endif
 
@@ -103,10 +156,11 @@ dds_return_t dds_loan_sample(dds_entity_t writer, void** sample)
   if ((ret = dds_writer_lock (writer, &wr)) != DDS_RETCODE_OK)
     return ret;
 
-  if (wr->m_iox_pub)
+  // only samples of types with a fixed size can be placed in shared memory as they are
+  if (wr->m_iox_pub && wr->m_topic->m_stype->fixed_size)
   {
-    *sample = create_iox_chunk(wr);
-    register_pub_loan(wr, *sample);
+    if ((ret = create_iox_chunk(wr, wr->m_topic->m_stype->iox_size, sample)) == DDS_RETCODE_OK)
+      register_pub_loan(wr, *sample);
   } else {
     ret = DDS_RETCODE_UNSUPPORTED;
   }
@@ -314,6 +368,13 @@ dds_return_t dds_write_impl (dds_writer *wr, const void * data, dds_time_t tstam
   /* Serialize and write data or key */
   if ((d = ddsi_serdata_from_sample (ddsi_wr->type, writekey ? SDK_KEY : SDK_DATA, data)) == NULL)
     ret = DDS_RETCODE_BAD_PARAMETER;
+#ifdef DDS_HAS_SHM
+  else if (wr->m_iox_pub && !wr->m_topic->m_stype->fixed_size && (ret = serialize_into_iox_chunk (wr, d)) != DDS_RETCODE_OK)
+    ddsi_serdata_unref (d);
+  else if (wr->m_iox_pub && wr->m_topic->m_stype->fixed_size && !deregister_pub_loan (wr, data) &&
+           (ret = copy_into_iox_chunk (wr, &data)) != DDS_RETCODE_OK)
+    ddsi_serdata_unref (d);
+#endif
   else
   {
     struct ddsi_tkmap_instance *tk;
@@ -328,15 +389,17 @@ dds_return_t dds_write_impl (dds_writer *wr, const void * data, dds_time_t tstam
     {
       iceoryx_header_t *ice_hdr;
 
-      if (!deregister_pub_loan(wr, data))
+      if (d->iox_chunk != NULL)
       {
-        void *pub_loan;
-
-        pub_loan = create_iox_chunk(wr);
-        memcpy (pub_loan, data, wr->m_topic->m_stype->iox_size);
-        data = pub_loan;
+        // serialized into a chunk above
+        ice_hdr = d->iox_chunk;
+        d->iox_chunk = NULL;
+      }
+      else
+      {
+        // a loaned sample, or a copy of the sample made above
+        ice_hdr = SHIFT_BACK_TO_ICEORYX_HEADER(data);
       }
-      ice_hdr = SHIFT_BACK_TO_ICEORYX_HEADER(data);
       ice_hdr->guid = ddsi_wr->e.guid;
       ice_hdr->tstamp = tstamp;
       ice_hdr->statusinfo = d->statusinfo;
@@ -413,10 +476,26 @@ static dds_return_t dds_writecdr_impl_common (struct writer *ddsi_wr, struct nn_
   {
     // dinp may not be NULL, so this means something bad happened
     // still must drop a dinp reference
+#ifdef DDS_HAS_SHM
+    release_iox_chunk (wr, dinp);
+#endif
     ddsi_serdata_unref (dinp);
     return DDS_RETCODE_ERROR;
   }
 
+#ifdef DDS_HAS_SHM
+  // samples of types that are exchanged serialized in shared memory may be written without a
+  // chunk, e.g. when the caller could not get one
+  if (wr && wr->m_iox_pub != NULL && dinp->iox_chunk == NULL && !wr->m_topic->m_stype->fixed_size &&
+      (ret = serialize_into_iox_chunk (wr, dinp)) != DDS_RETCODE_OK)
+  {
+    if (dact != dinp)
+      ddsi_serdata_unref (dinp);
+    ddsi_serdata_unref (dact);
+    return ret;
+  }
+#endif
+
   thread_state_awake (ts1, ddsi_wr->e.gv);
 
   // retain dact until after write_sample_gc so we can still pass it
@@ -467,6 +546,12 @@ static dds_return_t dds_writecdr_impl_common (struct writer *ddsi_wr, struct nn_
       iox_pub_publish_chunk (wr->m_iox_pub, ice_hdr);
     }
   }
+  else
+  {
+    // a chunk that is not published goes back to the publisher, rather than being lost for
+    // as long as the publisher exists
+    release_iox_chunk (wr, dinp);
+  }
 #else
   (void) wr;
 #endif
@@ -302,7 +302,8 @@ static bool dds_writer_support_shm(const struct ddsi_config* cfg, const dds_qos_
       false == cfg->enable_shm)
     return false;
 
-  if (!tp->m_stype->fixed_size)
+  // types without a fixed size can only be exchanged serialized, which the type must support
+  if (!tp->m_stype->fixed_size && !(tp->m_stype->shm_serialized && tp->m_stype->iox_size > 0))
     return false;
 
   uint32_t pub_history_cap = cfg->pub_history_capacity;
@@ -130,6 +130,20 @@ typedef struct ddsi_serdata * (*ddsi_serdata_to_ser_ref_t) (const struct ddsi_se
    - ref was previousy filled by ddsi_serdata_to_ser_ref_t */
 typedef void (*ddsi_serdata_to_ser_unref_t) (struct ddsi_serdata *d, const ddsrt_iovec_t *ref);
 
+/* Provide pointers to 'size' bytes of serialised data, starting from 'off', in at most *niov pieces
+   - see ddsi_serdata_to_ser_ref_t above
+   - for serdata of which the serialised representation is not in one block of memory
+   - on input *niov > 0 is the number of iovecs in ref, on output the number used
+   - the references must remain valid until the corresponding call to to_ser_unref_iov, which
+     gets the same iovecs
+   - optional: if absent, to_ser_ref is used */
+typedef struct ddsi_serdata * (*ddsi_serdata_to_ser_ref_iov_t) (const struct ddsi_serdata *d, size_t off, size_t sz, ddsrt_msg_iovlen_t *niov, ddsrt_iovec_t *ref);
+
+/* Release a lock on serialised data
+   - ref[0 .. niov-1] was previously filled by ddsi_serdata_to_ser_ref_iov_t
+   - optional: if absent, to_ser_unref is used */
+typedef void (*ddsi_serdata_to_ser_unref_iov_t) (struct ddsi_serdata *d, ddsrt_msg_iovlen_t niov, const ddsrt_iovec_t *ref);
+
 /* Turn serdata into an application sample (or just the key values if only key values are
    available); return false on error (typically out-of-memory, but if from_ser doesn't do any
    validation it might be a deserialisation error, too).
@@ -192,11 +206,14 @@ struct ddsi_serdata_ops {
   ddsi_serdata_iox_size_t get_sample_size;
   ddsi_serdata_from_iox_t from_iox_buffer;
 #endif
+  ddsi_serdata_to_ser_ref_iov_t to_ser_ref_iov;
+  ddsi_serdata_to_ser_unref_iov_t to_ser_unref_iov;
 };
 
 #define DDSI_SERDATA_HAS_PRINT 1
 #define DDSI_SERDATA_HAS_FROM_SER_IOV 1
 #define DDSI_SERDATA_HAS_GET_KEYHASH 1
+#define DDSI_SERDATA_HAS_TO_SER_REF_IOV 1
 
 DDS_EXPORT void ddsi_serdata_init (struct ddsi_serdata *d, const struct ddsi_sertype *type, enum ddsi_serdata_kind kind);
 
@@ -282,6 +299,21 @@ DDS_EXPORT inline void ddsi_serdata_to_ser_unref (struct ddsi_serdata *d, const
   d->ops->to_ser_unref (d, ref);
 }
 
+DDS_EXPORT inline struct ddsi_serdata *ddsi_serdata_to_ser_ref_iov (const struct ddsi_serdata *d, size_t off, size_t sz, ddsrt_msg_iovlen_t *niov, ddsrt_iovec_t *ref) {
+  if (d->ops->to_ser_ref_iov == 0) {
+    *niov = 1;
+    return d->ops->to_ser_ref (d, off, sz, ref);
+  }
+  return d->ops->to_ser_ref_iov (d, off, sz, niov, ref);
+}
+
+DDS_EXPORT inline void ddsi_serdata_to_ser_unref_iov (struct ddsi_serdata *d, ddsrt_msg_iovlen_t niov, const ddsrt_iovec_t *ref) {
+  if (d->ops->to_ser_unref_iov == 0)
+    d->ops->to_ser_unref (d, ref);
+  else
+    d->ops->to_ser_unref_iov (d, niov, ref);
+}
+
 DDS_EXPORT inline bool ddsi_serdata_to_sample (const struct ddsi_serdata *d, void *sample, void **bufptr, void *buflim) {
   return d->ops->to_sample (d, sample, bufptr, buflim);
 }
@@ -322,6 +354,10 @@ DDS_EXPORT inline struct ddsi_serdata* ddsi_serdata_from_iox(const struct ddsi_s
 {
   return type->serdata_ops->from_iox_buffer(type, kind, sub, iox_buffer);
 }
+
+/* Returns the iceoryx chunk a serdata received from its subscriber, for use when freeing a
+   serdata that holds on to its chunk; iox_chunk is a null pointer afterwards */
+DDS_EXPORT void ddsi_serdata_iox_release_chunk (struct ddsi_serdata *d);
 #endif
 
 #if defined (__cplusplus)
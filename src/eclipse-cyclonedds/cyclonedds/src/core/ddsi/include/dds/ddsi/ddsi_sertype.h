@@ -40,6 +40,7 @@ struct ddsi_sertype {
   uint32_t typekind_no_key : 1;
   uint32_t request_keyhash : 1;
   uint32_t fixed_size : 1;
+  uint32_t shm_serialized : 1; /* exchanged serialized in shared memory, up to iox_size bytes */
   char *type_name;
   ddsrt_atomic_voidp_t gv; /* set during registration */
   ddsrt_atomic_uint32_t flags_refc; /* counts refs from entities (topic, reader, writer), not from data */
@@ -149,8 +150,9 @@ void ddsi_sertype_register_locked (struct ddsi_domaingv *gv, struct ddsi_sertype
 #define DDSI_SERTYPE_FLAG_TOPICKIND_NO_KEY (1u)
 #define DDSI_SERTYPE_FLAG_REQUEST_KEYHASH  (2u)
 #define DDSI_SERTYPE_FLAG_FIXED_SIZE       (4u)
+#define DDSI_SERTYPE_FLAG_SHM_SERIALIZED   (8u)
 
-#define DDSI_SERTYPE_FLAG_MASK (0x7u)
+#define DDSI_SERTYPE_FLAG_MASK (0xfu)
 
 DDS_EXPORT void ddsi_sertype_init_flags (struct ddsi_sertype *tp, const char *type_name, const struct ddsi_sertype_ops *sertype_ops, const struct ddsi_serdata_ops *serdata_ops, uint32_t flags);
 DDS_EXPORT void ddsi_sertype_init (struct ddsi_sertype *tp, const char *type_name, const struct ddsi_sertype_ops *sertype_ops, const struct ddsi_serdata_ops *serdata_ops, bool topickind_no_key);
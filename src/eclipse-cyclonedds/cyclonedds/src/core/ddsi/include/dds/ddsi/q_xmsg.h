@@ -54,12 +54,20 @@ enum nn_xmsg_kind {
 };
 
 #ifdef DDS_HAS_SHM
+/* What the payload of an iceoryx chunk holds: the sample itself for types of a fixed size,
+   or the serialized sample (data_size bytes) for types that are exchanged serialized */
+enum iceoryx_chunk_data_state {
+   IOX_CHUNK_CONTAINS_RAW_DATA,
+   IOX_CHUNK_CONTAINS_SERIALIZED_DATA
+};
+
 struct iceoryx_header {
    struct ddsi_guid guid;
    dds_time_t tstamp;
    uint32_t statusinfo;
    uint32_t data_size;
    unsigned char data_kind;
+   unsigned char data_state;
    ddsi_keyhash_t keyhash;
 };
 
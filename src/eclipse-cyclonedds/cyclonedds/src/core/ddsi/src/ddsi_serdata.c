@@ -20,6 +20,9 @@
 #include "dds/ddsi/q_radmin.h"
 #include "dds/ddsi/q_freelist.h"
 #include "dds/ddsi/ddsi_serdata.h"
+#ifdef DDS_HAS_SHM
+#include "dds/ddsi/shm_sync.h"
+#endif
 
 void ddsi_serdata_init (struct ddsi_serdata *d, const struct ddsi_sertype *tp, enum ddsi_serdata_kind kind)
 {
@@ -77,6 +80,8 @@ extern inline struct ddsi_serdata *ddsi_serdata_to_untyped (const struct ddsi_se
 extern inline void ddsi_serdata_to_ser (const struct ddsi_serdata *d, size_t off, size_t sz, void *buf);
 extern inline struct ddsi_serdata *ddsi_serdata_to_ser_ref (const struct ddsi_serdata *d, size_t off, size_t sz, ddsrt_iovec_t *ref);
 extern inline void ddsi_serdata_to_ser_unref (struct ddsi_serdata *d, const ddsrt_iovec_t *ref);
+extern inline struct ddsi_serdata *ddsi_serdata_to_ser_ref_iov (const struct ddsi_serdata *d, size_t off, size_t sz, ddsrt_msg_iovlen_t *niov, ddsrt_iovec_t *ref);
+extern inline void ddsi_serdata_to_ser_unref_iov (struct ddsi_serdata *d, ddsrt_msg_iovlen_t niov, const ddsrt_iovec_t *ref);
 extern inline bool ddsi_serdata_to_sample (const struct ddsi_serdata *d, void *sample, void **bufptr, void *buflim);
 extern inline bool ddsi_serdata_untyped_to_sample (const struct ddsi_sertype *type, const struct ddsi_serdata *d, void *sample, void **bufptr, void *buflim);
 extern inline bool ddsi_serdata_eqkey (const struct ddsi_serdata *a, const struct ddsi_serdata *b);
@@ -87,4 +92,18 @@ extern inline void ddsi_serdata_get_keyhash (const struct ddsi_serdata *d, struc
 extern inline uint32_t ddsi_serdata_iox_size(const struct ddsi_serdata* d);
 // sub really is an iox_sub_t *
 extern inline struct ddsi_serdata* ddsi_serdata_from_iox(const struct ddsi_sertype* type, enum ddsi_serdata_kind kind, void* sub, void* iox_buffer);
+
+void ddsi_serdata_iox_release_chunk (struct ddsi_serdata *d)
+{
+  //ICEORYX_TODO the chunk is released concurrently to iox_sub_take_chunk here,
+  //                 we will need mutex protection for this call
+  if (d->iox_chunk)
+  {
+    iox_sub_t *sub = d->iox_subscriber;
+    shm_lock_iox_sub(*sub);
+    iox_sub_release_chunk(*sub, d->iox_chunk);
+    d->iox_chunk = NULL;
+    shm_unlock_iox_sub(*sub);
+  }
+}
 #endif
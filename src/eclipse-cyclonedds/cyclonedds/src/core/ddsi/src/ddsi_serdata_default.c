@@ -28,7 +28,6 @@
 #include "dds/ddsi/ddsi_serdata_default.h"
 #ifdef DDS_HAS_SHM
 #include "dds/ddsi/q_xmsg.h"
-#include "dds/ddsi/shm_sync.h"
 #endif
 
 #if DDSRT_ENDIAN == DDSRT_LITTLE_ENDIAN
@@ -161,17 +160,8 @@ static void serdata_default_free(struct ddsi_serdata *dcmn)
   assert(ddsrt_atomic_ld32(&d->c.refc) == 0);
 
 #ifdef DDS_HAS_SHM
-  //ICEORYX_TODO the chunk is released concurrently to iox_sub_take_chunk here,
-  //                 we will need mutex protection for this call
-  //                 when is the free called exactly?
-  if (d->c.iox_chunk)
-  {
-    iox_sub_t *sub = d->c.iox_subscriber;
-    shm_lock_iox_sub(*sub);
-    iox_sub_release_chunk(*sub, d->c.iox_chunk);
-    d->c.iox_chunk = NULL;
-    shm_unlock_iox_sub(*sub);
-  }
+  //ICEORYX_TODO when is the free called exactly?
+  ddsi_serdata_iox_release_chunk (&d->c);
 #endif
 
   if (d->size > MAX_SIZE_FOR_POOL || !nn_freelist_push (&d->serpool->freelist, d))
@@ -698,6 +698,94 @@ static void defer_hb_state_init (struct defer_hb_state *defer_hb_state)
   defer_hb_state->m = NULL;
 }
 
+/* Dropping acknowledged samples from a writer's WHC is deferred while the receive thread has
+   more packets to process: the ACKNACKs of the readers of a writer tend to arrive together, one
+   datagram per remote participant, and this way the WHC is cleaned up once for all of them.
+   The receive thread flushes them before it blocks waiting for data, and after a bounded number
+   of packets, so that a writer blocked on a full WHC is not kept waiting. */
+#define DEFER_ACK_MAX_WRITERS 8
+#define DEFER_ACK_MAX_PACKETS 32
+
+struct defer_ack_state {
+  uint32_t n_writers;
+  uint32_t n_packets;
+  ddsi_guid_t wr_guids[DEFER_ACK_MAX_WRITERS];
+};
+
+static void defer_ack_state_init (struct defer_ack_state *defer_ack_state)
+{
+  defer_ack_state->n_writers = 0;
+  defer_ack_state->n_packets = 0;
+}
+
+static bool defer_ack_state_pending (const struct defer_ack_state *defer_ack_state)
+{
+  return defer_ack_state->n_writers > 0;
+}
+
+static void defer_ack_state_flush (struct ddsi_domaingv * const gv, struct defer_ack_state *defer_ack_state)
+{
+  /* must be called while awake, the writers may be deleted in the meantime */
+  for (uint32_t i = 0; i < defer_ack_state->n_writers; i++)
+  {
+    struct writer *wr;
+    if ((wr = entidx_lookup_writer_guid (gv->entity_index, &defer_ack_state->wr_guids[i])) != NULL)
+    {
+      struct whc_node *deferred_free_list = NULL;
+      struct whc_state whcst;
+      unsigned n;
+      ddsrt_mutex_lock (&wr->e.lock);
+      n = remove_acked_messages (wr, &whcst, &deferred_free_list);
+      ddsrt_mutex_unlock (&wr->e.lock);
+      whc_free_deferred_free_list (wr->whc, deferred_free_list);
+      GVTRACE ("remove_acked_messages: "PGUIDFMT" RM%u\n", PGUID (defer_ack_state->wr_guids[i]), n);
+    }
+  }
+  defer_ack_state->n_writers = 0;
+  defer_ack_state->n_packets = 0;
+}
+
+static void defer_ack_state_flush_asleep (struct thread_state1 * const ts1, struct ddsi_domaingv * const gv, struct defer_ack_state *defer_ack_state)
+{
+  if (!defer_ack_state_pending (defer_ack_state))
+    return;
+  thread_state_awake_fixed_domain (ts1);
+  defer_ack_state_flush (gv, defer_ack_state);
+  thread_state_asleep (ts1);
+}
+
+static bool defer_ack_state_contains (const struct defer_ack_state *defer_ack_state, const struct writer *wr)
+{
+  for (uint32_t i = 0; i < defer_ack_state->n_writers; i++)
+    if (guid_eq (&defer_ack_state->wr_guids[i], &wr->e.guid))
+      return true;
+  return false;
+}
+
+static void defer_ack_state_reserve (struct ddsi_domaingv * const gv, struct defer_ack_state *defer_ack_state, const struct writer *wr)
+{
+  /* makes room for wr, must be called without holding wr->e.lock */
+  if (defer_ack_state->n_writers == DEFER_ACK_MAX_WRITERS && !defer_ack_state_contains (defer_ack_state, wr))
+    defer_ack_state_flush (gv, defer_ack_state);
+}
+
+static void defer_ack_state_add (struct defer_ack_state *defer_ack_state, const struct writer *wr)
+{
+  /* room was made by defer_ack_state_reserve */
+  if (!defer_ack_state_contains (defer_ack_state, wr))
+  {
+    assert (defer_ack_state->n_writers < DEFER_ACK_MAX_WRITERS);
+    defer_ack_state->wr_guids[defer_ack_state->n_writers++] = wr->e.guid;
+  }
+}
+
+static void defer_ack_state_packet_done (struct ddsi_domaingv * const gv, struct defer_ack_state *defer_ack_state)
+{
+  /* must be called while awake */
+  if (defer_ack_state_pending (defer_ack_state) && ++defer_ack_state->n_packets >= DEFER_ACK_MAX_PACKETS)
+    defer_ack_state_flush (gv, defer_ack_state);
+}
+
 static void defer_hb_state_fini (struct ddsi_domaingv * const gv, struct defer_hb_state *defer_hb_state)
 {
   if (defer_hb_state->m)
@@ -708,7 +796,7 @@ static void defer_hb_state_fini (struct ddsi_domaingv * const gv, struct defer_h
   }
 }
 
-static int handle_AckNack (struct receiver_state *rst, ddsrt_etime_t tnow, const AckNack_t *msg, ddsrt_wctime_t timestamp, SubmessageKind_t prev_smid, struct defer_hb_state *defer_hb_state)
+static int handle_AckNack (struct receiver_state *rst, ddsrt_etime_t tnow, const AckNack_t *msg, ddsrt_wctime_t timestamp, SubmessageKind_t prev_smid, struct defer_hb_state *defer_hb_state, struct defer_ack_state *defer_ack_state)
 {
   struct proxy_reader *prd;
   struct wr_prd_match *rn;
@@ -727,7 +815,6 @@ static int handle_AckNack (struct receiver_state *rst, ddsrt_etime_t tnow, const
   unsigned numbits;
   uint32_t msgs_sent, msgs_lost;
   seqno_t max_seq_in_reply;
-  struct whc_node *deferred_free_list = NULL;
   struct whc_state whcst;
   int hb_sent_in_response = 0;
   countp = (nn_count_t *) ((char *) msg + offsetof (AckNack_t, bits) + NN_SEQUENCE_NUMBER_SET_BITS_SIZE (msg->readerSNState.numbits));
@@ -777,6 +864,7 @@ static int handle_AckNack (struct receiver_state *rst, ddsrt_etime_t tnow, const
     return 1;
   }
 
+  defer_ack_state_reserve (rst->gv, defer_ack_state, wr);
   ddsrt_mutex_lock (&wr->e.lock);
   if (wr->test_ignore_acknack)
   {
@@ -827,12 +915,11 @@ static int handle_AckNack (struct receiver_state *rst, ddsrt_etime_t tnow, const
   }
 
   /* First, the ACK part: if the AckNack advances the highest sequence
-     number ack'd by the remote reader, update state & try dropping
-     some messages */
+     number ack'd by the remote reader, update state & schedule dropping
+     some messages once all submessages in the packet have been handled */
   if (seqbase - 1 > rn->seq)
   {
     int64_t n_ack = (seqbase - 1) - rn->seq;
-    unsigned n;
     rn->seq = seqbase - 1;
     if (rn->seq > wr->seq) {
       /* Prevent a reader from ACKing future samples (is only malicious because we require
@@ -840,15 +927,13 @@ static int handle_AckNack (struct receiver_state *rst, ddsrt_etime_t tnow, const
       rn->seq = wr->seq;
     }
     ddsrt_avl_augment_update (&wr_readers_treedef, rn);
-    n = remove_acked_messages (wr, &whcst, &deferred_free_list);
-    RSTTRACE (" ACK%"PRId64" RM%u", n_ack, n);
-  }
-  else
-  {
-    /* There's actually no guarantee that we need this information */
-    whc_get_state(wr->whc, &whcst);
+    defer_ack_state_add (defer_ack_state, wr);
+    RSTTRACE (" ACK%"PRId64, n_ack);
   }
 
+  /* There's actually no guarantee that we need this information */
+  whc_get_state(wr->whc, &whcst);
+
   /* If this reader was marked as "non-responsive" in the past, it's now responding again,
      so update its status */
   if (rn->seq == MAX_SEQ_NUMBER && prd->c.xqos->reliability.kind == DDS_RELIABILITY_RELIABLE)
@@ -1080,7 +1165,6 @@ static int handle_AckNack (struct receiver_state *rst, ddsrt_etime_t tnow, const
   RSTTRACE (")");
  out:
   ddsrt_mutex_unlock (&wr->e.lock);
-  whc_free_deferred_free_list (wr->whc, deferred_free_list);
   return 1;
 }
 
@@ -2846,7 +2930,8 @@ static int handle_submsg_sequence
   const size_t len,
   unsigned char * submsg /* aliases somewhere in msg */,
   struct nn_rmsg * const rmsg,
-  bool rtps_encoded /* indicate if the message was rtps encoded */
+  bool rtps_encoded /* indicate if the message was rtps encoded */,
+  struct defer_ack_state *defer_ack_state /* carried over from one message to the next */
 )
 {
   const char *state;
@@ -2946,7 +3031,7 @@ static int handle_submsg_sequence
         state = "parse:acknack";
         if (!valid_AckNack (rst, &sm->acknack, submsg_size, byteswap))
           goto malformed;
-        handle_AckNack (rst, tnowE, &sm->acknack, ts_for_latmeas ? timestamp : DDSRT_WCTIME_INVALID, prev_smid, &defer_hb_state);
+        handle_AckNack (rst, tnowE, &sm->acknack, ts_for_latmeas ? timestamp : DDSRT_WCTIME_INVALID, prev_smid, &defer_hb_state, defer_ack_state);
         ts_for_latmeas = 0;
         break;
       case SMID_HEARTBEAT:
@@ -3151,6 +3236,7 @@ static int handle_submsg_sequence
     submsg += submsg_size;
     GVTRACE ("\n");
   }
+  defer_ack_state_packet_done (gv, defer_ack_state);
   if (submsg != end)
   {
     state = "parse:shortmsg";
@@ -3166,6 +3252,7 @@ static int handle_submsg_sequence
   return 0;
 
 malformed:
+  defer_ack_state_packet_done (gv, defer_ack_state);
   thread_state_asleep (ts1);
   assert (thread_is_asleep ());
 malformed_asleep:
@@ -3177,7 +3264,29 @@ malformed_asleep:
   return -1;
 }
 
-static bool do_packet (struct thread_state1 * const ts1, struct ddsi_domaingv *gv, ddsi_tran_conn_t conn, const ddsi_guid_prefix_t *guidprefix, struct nn_rbufpool *rbpool)
+/* Whether a packet can be read from conn without blocking; transports without a socket are
+   assumed to have nothing pending */
+static bool conn_has_pending_data (ddsi_tran_conn_t conn)
+{
+  const ddsrt_socket_t sock = ddsi_conn_handle (conn);
+  fd_set fds;
+  int32_t ready = 0;
+  if (sock == DDSRT_INVALID_SOCKET)
+    return false;
+  FD_ZERO (&fds);
+#if LWIP_SOCKET == 1
+  DDSRT_WARNING_GNUC_OFF(sign-conversion)
+#endif
+  FD_SET (sock, &fds);
+#if LWIP_SOCKET == 1
+  DDSRT_WARNING_GNUC_ON(sign-conversion)
+#endif
+  if (ddsrt_select ((int32_t) sock + 1, &fds, NULL, NULL, 0, &ready) != DDS_RETCODE_OK)
+    return false;
+  return ready > 0;
+}
+
+static bool do_packet (struct thread_state1 * const ts1, struct ddsi_domaingv *gv, ddsi_tran_conn_t conn, const ddsi_guid_prefix_t *guidprefix, struct nn_rbufpool *rbpool, struct defer_ack_state *defer_ack_state)
 {
   /* UDP max packet size is 64kB */
 
@@ -3293,7 +3402,7 @@ static bool do_packet (struct thread_state1 * const ts1, struct ddsi_domaingv *g
       nn_rtps_msg_state_t res = decode_rtps_message (ts1, gv, &rmsg, &hdr, &buff, &sz, rbpool, conn->m_stream);
       if (res != NN_RTPS_MSG_STATE_ERROR)
       {
-        handle_submsg_sequence (ts1, gv, conn, &srcloc, ddsrt_time_wallclock (), ddsrt_time_elapsed (), &hdr->guid_prefix, guidprefix, buff, (size_t) sz, buff + RTPS_MESSAGE_HEADER_SIZE, rmsg, res == NN_RTPS_MSG_STATE_ENCODED);
+        handle_submsg_sequence (ts1, gv, conn, &srcloc, ddsrt_time_wallclock (), ddsrt_time_elapsed (), &hdr->guid_prefix, guidprefix, buff, (size_t) sz, buff + RTPS_MESSAGE_HEADER_SIZE, rmsg, res == NN_RTPS_MSG_STATE_ENCODED, defer_ack_state);
       }
       else
       {
@@ -3500,7 +3609,9 @@ uint32_t recv_thread (void *vrecv_thread_arg)
   struct nn_rbufpool *rbpool = recv_thread_arg->rbpool;
   os_sockWaitset waitset = recv_thread_arg->mode == RTM_MANY ? recv_thread_arg->u.many.ws : NULL;
   ddsrt_mtime_t next_thread_cputime = { 0 };
+  struct defer_ack_state defer_ack_state;
 
+  defer_ack_state_init (&defer_ack_state);
   nn_rbufpool_setowner (rbpool, ddsrt_thread_self ());
   if (waitset == NULL)
   {
@@ -3508,7 +3619,10 @@ uint32_t recv_thread (void *vrecv_thread_arg)
     while (ddsrt_atomic_ld32 (&gv->rtps_keepgoing))
     {
       LOG_THREAD_CPUTIME (&gv->logconfig, next_thread_cputime);
-      (void) do_packet (ts1, gv, conn, NULL, rbpool);
+      /* reading blocks once the socket is drained, deferred ACKs can't wait for that */
+      if (defer_ack_state_pending (&defer_ack_state) && !conn_has_pending_data (conn))
+        defer_ack_state_flush_asleep (ts1, gv, &defer_ack_state);
+      (void) do_packet (ts1, gv, conn, NULL, rbpool, &defer_ack_state);
     }
   }
   else
@@ -3565,6 +3679,7 @@ uint32_t recv_thread (void *vrecv_thread_arg)
       {
         int idx;
         ddsi_tran_conn_t conn;
+        bool more_pending = false;
         while ((idx = os_sockWaitsetNextEvent (ctx, &conn)) >= 0)
         {
           const ddsi_guid_prefix_t *guid_prefix;
@@ -3573,13 +3688,19 @@ uint32_t recv_thread (void *vrecv_thread_arg)
           else
             guid_prefix = &lps.ps[(unsigned)idx - num_fixed].guid_prefix;
           /* Process message and clean out connection if failed or closed */
-          if (!do_packet (ts1, gv, conn, guid_prefix, rbpool) && !conn->m_connless)
+          if (!do_packet (ts1, gv, conn, guid_prefix, rbpool, &defer_ack_state) && !conn->m_connless)
             ddsi_conn_free (conn);
+          else if (!more_pending && defer_ack_state_pending (&defer_ack_state))
+            more_pending = conn_has_pending_data (conn);
         }
+        /* waiting blocks once the sockets are drained, deferred ACKs can't wait for that */
+        if (!more_pending)
+          defer_ack_state_flush_asleep (ts1, gv, &defer_ack_state);
       }
     }
     local_participant_set_fini (&lps);
   }
+  defer_ack_state_flush_asleep (ts1, gv, &defer_ack_state);
   
   GVTRACE ("done\n");
   return 0;
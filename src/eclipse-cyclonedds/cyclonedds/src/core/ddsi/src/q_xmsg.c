@@ -43,6 +43,11 @@
 #include "dds/ddsi/ddsi_security_omg.h"
 
 #define NN_XMSG_MAX_ALIGN 8
+
+/* Serialised data of which the representation is in a few blocks of memory (e.g., when it
+   references large sequences in the application's sample) can be referenced without copying
+   if it is in at most this many pieces */
+#define NN_XMSG_MAX_PAYLOAD_IOVECS 4
 #define NN_XMSG_CHUNK_SIZE 128
 
 struct nn_xmsgpool {
@@ -72,7 +77,9 @@ struct nn_xmsg {
   size_t sz;
   int have_params;
   struct ddsi_serdata *refd_payload;
-  ddsrt_iovec_t refd_payload_iov;
+  ddsrt_msg_iovlen_t refd_payload_niov;
+  ddsrt_iovec_t refd_payload_iov[NN_XMSG_MAX_PAYLOAD_IOVECS];
+  size_t refd_payload_size;
 #ifdef DDS_HAS_SECURITY
   /* Used as pointer to contain encoded payload to which iov can alias. */
   unsigned char *refd_payload_encoded;
@@ -115,9 +122,9 @@ struct nn_xmsg {
 };
 
 /* Worst-case: change of SRC [+1] but no DST, submessage [+1], ref'd
-   payload [+1].  So 128 iovecs => at least ~40 submessages, so for
-   very small ones still >1kB. */
-#define NN_XMSG_MAX_SUBMESSAGE_IOVECS 3
+   payload [+NN_XMSG_MAX_PAYLOAD_IOVECS].  So 128 iovecs => at least ~20
+   submessages, so for very small ones still >500B. */
+#define NN_XMSG_MAX_SUBMESSAGE_IOVECS (2 + NN_XMSG_MAX_PAYLOAD_IOVECS)
 
 #ifdef IOV_MAX
 #if IOV_MAX > 0 && IOV_MAX < 256
@@ -247,6 +254,8 @@ static void nn_xmsg_reinit (struct nn_xmsg *m, enum nn_xmsg_kind kind)
   m->sz = 0;
   m->have_params = 0;
   m->refd_payload = NULL;
+  m->refd_payload_niov = 0;
+  m->refd_payload_size = 0;
   m->dstmode = NN_XMSG_DST_UNSET;
   m->kind = kind;
   m->maxdelay = 0;
@@ -318,6 +327,19 @@ struct nn_xmsg *nn_xmsg_new (struct nn_xmsgpool *pool, const ddsi_guid_t *src_gu
   return m;
 }
 
+static void nn_xmsg_unref_payload (struct nn_xmsg *m)
+{
+#ifdef DDS_HAS_SECURITY
+  /* The encoded payload replaced the reference obtained from ddsi_serdata_to_ser_ref */
+  if (m->refd_payload_encoded)
+  {
+    ddsi_serdata_to_ser_unref (m->refd_payload, &m->refd_payload_iov[0]);
+    return;
+  }
+#endif
+  ddsi_serdata_to_ser_unref_iov (m->refd_payload, m->refd_payload_niov, m->refd_payload_iov);
+}
+
 static void nn_xmsg_realfree (struct nn_xmsg *m)
 {
   ddsrt_free (m->data);
@@ -328,7 +350,7 @@ void nn_xmsg_free (struct nn_xmsg *m)
 {
   struct nn_xmsgpool *pool = m->pool;
   if (m->refd_payload)
-    ddsi_serdata_to_ser_unref (m->refd_payload, &m->refd_payload_iov);
+    nn_xmsg_unref_payload (m);
 #ifdef DDS_HAS_SECURITY
   ddsrt_free(m->refd_payload_encoded);
 #endif
@@ -454,7 +476,7 @@ int nn_xmsg_compare_fragid (const struct nn_xmsg *a, const struct nn_xmsg *b)
 
 size_t nn_xmsg_size (const struct nn_xmsg *m)
 {
-  return m->sz + (m->refd_payload ? (size_t) m->refd_payload_iov.iov_len : 0);
+  return m->sz + (m->refd_payload ? m->refd_payload_size : 0);
 }
 
 enum nn_xmsg_kind nn_xmsg_kind (const struct nn_xmsg *m)
@@ -495,7 +517,7 @@ void nn_xmsg_submsg_init (struct nn_xmsg *msg, struct nn_xmsg_marker marker, Sub
 void nn_xmsg_submsg_setnext (struct nn_xmsg *msg, struct nn_xmsg_marker marker)
 {
   SubmessageHeader_t *hdr = (SubmessageHeader_t *) (msg->data->payload + marker.offset);
-  unsigned plsize = msg->refd_payload ? (unsigned) msg->refd_payload_iov.iov_len : 0;
+  unsigned plsize = msg->refd_payload ? (unsigned) msg->refd_payload_size : 0;
   assert ((msg->sz % 4) == 0);
   assert ((plsize % 4) == 0);
   assert ((unsigned) (msg->data->payload + msg->sz + plsize - (char *) hdr) >= RTPS_SUBMESSAGE_HEADER_SIZE);
@@ -569,21 +591,23 @@ void nn_xmsg_submsg_append_refd_payload(struct nn_xmsg *msg, struct nn_xmsg_mark
    */
   if (msg->refd_payload)
   {
-    void *dst;
-
-    /* Get payload information. */
-    char  *payload_ptr = msg->refd_payload_iov.iov_base;
-    size_t payload_len = msg->refd_payload_iov.iov_len;
+    char *dst;
 
     /* Make space for the payload (dst points to the start of the appended space). */
-    dst = nn_xmsg_append(msg, NULL, payload_len);
+    dst = nn_xmsg_append(msg, NULL, msg->refd_payload_size);
 
     /* Copy the payload into the submessage. */
-    memcpy(dst, payload_ptr, payload_len);
+    for (ddsrt_msg_iovlen_t i = 0; i < msg->refd_payload_niov; i++)
+    {
+      memcpy(dst, msg->refd_payload_iov[i].iov_base, msg->refd_payload_iov[i].iov_len);
+      dst += msg->refd_payload_iov[i].iov_len;
+    }
 
     /* No need to remember the payload now. */
-    ddsi_serdata_unref(msg->refd_payload);
+    nn_xmsg_unref_payload(msg);
     msg->refd_payload = NULL;
+    msg->refd_payload_niov = 0;
+    msg->refd_payload_size = 0;
     if (msg->refd_payload_encoded)
     {
       ddsrt_free(msg->refd_payload_encoded);
@@ -666,25 +690,39 @@ void nn_xmsg_serdata (struct nn_xmsg *m, struct ddsi_serdata *serdata, size_t of
   {
     size_t len4 = align4u (len);
     assert (m->refd_payload == NULL);
-    m->refd_payload = ddsi_serdata_to_ser_ref (serdata, off, len4, &m->refd_payload_iov);
-
 #ifdef DDS_HAS_SECURITY
-    assert (m->refd_payload_encoded == NULL);
-    /* When encoding is necessary, m->refd_payload_encoded will be allocated
-     * and m->refd_payload_iov contents will change to point to that buffer.
-     * If no encoding is necessary, nothing changes. */
-    if (!encode_payload(wr, &(m->refd_payload_iov), &(m->refd_payload_encoded)))
+    /* Encoding the payload needs it in one piece */
+    if (q_omg_writer_is_payload_protected (wr))
     {
-      DDS_CWARNING (&wr->e.gv->logconfig, "nn_xmsg_serdata: failed to encrypt data for "PGUIDFMT"", PGUID (wr->e.guid));
-      ddsi_serdata_to_ser_unref (m->refd_payload, &m->refd_payload_iov);
+      m->refd_payload = ddsi_serdata_to_ser_ref (serdata, off, len4, &m->refd_payload_iov[0]);
+      m->refd_payload_niov = 1;
       assert (m->refd_payload_encoded == NULL);
-      m->refd_payload_iov.iov_base = NULL;
-      m->refd_payload_iov.iov_len = 0;
-      m->refd_payload = NULL;
+      /* When encoding is necessary, m->refd_payload_encoded will be allocated
+       * and m->refd_payload_iov contents will change to point to that buffer.
+       * If no encoding is necessary, nothing changes. */
+      if (!encode_payload(wr, &(m->refd_payload_iov[0]), &(m->refd_payload_encoded)))
+      {
+        DDS_CWARNING (&wr->e.gv->logconfig, "nn_xmsg_serdata: failed to encrypt data for "PGUIDFMT"", PGUID (wr->e.guid));
+        ddsi_serdata_to_ser_unref (m->refd_payload, &m->refd_payload_iov[0]);
+        assert (m->refd_payload_encoded == NULL);
+        m->refd_payload_iov[0].iov_base = NULL;
+        m->refd_payload_iov[0].iov_len = 0;
+        m->refd_payload_niov = 0;
+        m->refd_payload = NULL;
+      }
+      else
+      {
+        m->refd_payload_size = m->refd_payload_iov[0].iov_len;
+      }
+      return;
     }
 #else
     DDSRT_UNUSED_ARG(wr);
 #endif
+    m->refd_payload_niov = NN_XMSG_MAX_PAYLOAD_IOVECS;
+    m->refd_payload = ddsi_serdata_to_ser_ref_iov (serdata, off, len4, &m->refd_payload_niov, m->refd_payload_iov);
+    assert (1 <= m->refd_payload_niov && m->refd_payload_niov <= NN_XMSG_MAX_PAYLOAD_IOVECS);
+    m->refd_payload_size = len4;
   }
 }
 
@@ -1511,7 +1549,7 @@ static int nn_xpack_mayaddmsg (const struct nn_xpack *xp, const struct nn_xmsg *
   if (xp->niov + NN_XMSG_MAX_SUBMESSAGE_IOVECS > NN_XMSG_MAX_MESSAGE_IOVECS)
     return 0;
 
-  payload_size = m->refd_payload ? (unsigned) m->refd_payload_iov.iov_len : 0;
+  payload_size = m->refd_payload ? (unsigned) m->refd_payload_size : 0;
 
   /* Check if max message size exceeded */
 
@@ -1561,7 +1599,7 @@ int nn_xpack_addmsg (struct nn_xpack *xp, struct nn_xmsg *m, const uint32_t flag
      aligned all the time, we don't need to check for padding here. */
   assert ((xp->msg_len.length % 4) == 0);
   assert ((m->sz % 4) == 0);
-  assert (m->refd_payload == NULL || (m->refd_payload_iov.iov_len % 4) == 0);
+  assert (m->refd_payload == NULL || (m->refd_payload_size % 4) == 0);
 
   if (xp->iov == NULL)
     xp->iov = ddsrt_malloc (NN_XMSG_MAX_MESSAGE_IOVECS * sizeof (*xp->iov));
@@ -1696,12 +1734,13 @@ int nn_xpack_addmsg (struct nn_xpack *xp, struct nn_xmsg *m, const uint32_t flag
   /* Append ref'd payload if given; whoever constructed the message
      should've taken care of proper alignment for the payload.  The
      ref'd payload is always at some weird address, so no chance of
-     merging iovecs here. */
+     merging iovecs here.  It may be in several pieces, which are then
+     gathered by the socket write. */
   if (m->refd_payload)
   {
-    xp->iov[niov] = m->refd_payload_iov;
-    sz += m->refd_payload_iov.iov_len;
-    niov++;
+    for (ddsrt_msg_iovlen_t i = 0; i < m->refd_payload_niov; i++)
+      xp->iov[niov++] = m->refd_payload_iov[i];
+    sz += m->refd_payload_size;
   }
 
   /* Shouldn't've overrun iov, and shouldn't've tried to add a
@@ -26,23 +26,27 @@
 
 #include "rmw/rmw.h"
 
-#include "rclcpp/executor.hpp"
+#include "rclcpp/executors/static_single_threaded_executor.hpp"
 #include "rclcpp/macros.hpp"
 #include "rclcpp/memory_strategies.hpp"
 
 namespace pendulum_control
 {
 /// Instrumented executor that syncs Executor::spin functions with rttest_spin.
-class RttExecutor : public rclcpp::Executor
+/**
+ * It is based on the static single threaded executor, whose spin_some does not allocate once
+ * the nodes have been added.
+ */
+class RttExecutor : public rclcpp::executors::StaticSingleThreadedExecutor
 {
 public:
   /// Constructor
   /**
-   * Extends default Executor constructor
+   * Extends default StaticSingleThreadedExecutor constructor
    */
   RttExecutor(
     const rclcpp::ExecutorOptions & options = rclcpp::ExecutorOptions())
-  : rclcpp::Executor(options), running(false)
+  : rclcpp::executors::StaticSingleThreadedExecutor(options), running(false)
   {
     rttest_ready = rttest_running();
     memset(&start_time_, 0, sizeof(timespec));
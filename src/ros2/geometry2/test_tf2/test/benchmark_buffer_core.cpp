@@ -0,0 +1,154 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "geometry_msgs/msg/transform_stamped.hpp"
+#include "tf2/buffer_core.h"
+#include "tf2/time.h"
+
+namespace
+{
+
+// Frames looked up from, each at the end of a chain below base_link
+constexpr int SENSOR_COUNT = 20;
+// Frames between base_link and each sensor
+constexpr int CHAIN_LENGTH = 3;
+// Time between two transforms of a frame
+constexpr int64_t PERIOD = 10000000;
+
+std::unique_ptr<tf2::BufferCore> buffer;
+// Parent and child of every frame, from the map to the sensors
+std::vector<std::pair<std::string, std::string>> frames;
+// Latest time stamp set in the buffer
+int64_t latest_stamp = 0;
+
+std::string chainFrame(int sensor, int link)
+{
+  if (link == 0) {
+    return "base_link";
+  }
+  if (link == CHAIN_LENGTH + 1) {
+    return "sensor_" + std::to_string(sensor);
+  }
+  return "link_" + std::to_string(sensor) + "_" + std::to_string(link);
+}
+
+geometry_msgs::msg::TransformStamped makeTransform(
+  const std::string & parent, const std::string & child, int64_t stamp)
+{
+  geometry_msgs::msg::TransformStamped transform;
+  transform.header.stamp.sec = static_cast<int32_t>(stamp / 1000000000);
+  transform.header.stamp.nanosec = static_cast<uint32_t>(stamp % 1000000000);
+  transform.header.frame_id = parent;
+  transform.child_frame_id = child;
+  transform.transform.translation.x = 1.0;
+  transform.transform.rotation.w = 1.0;
+  return transform;
+}
+
+// Set the transform of the frame with the given index
+void setTransform(size_t frame, int64_t stamp)
+{
+  buffer->setTransform(
+    makeTransform(frames[frame].first, frames[frame].second, stamp), "benchmark");
+}
+
+// Create the buffer shared by the threads, holding a second of transforms
+void setUp(const benchmark::State & state)
+{
+  if (state.thread_index == 0) {
+    frames.clear();
+    frames.emplace_back("map", "odom");
+    frames.emplace_back("odom", "base_link");
+    for (int sensor = 0; sensor < SENSOR_COUNT; ++sensor) {
+      for (int link = 0; link <= CHAIN_LENGTH; ++link) {
+        frames.emplace_back(chainFrame(sensor, link), chainFrame(sensor, link + 1));
+      }
+    }
+
+    buffer = std::make_unique<tf2::BufferCore>();
+    for (latest_stamp = PERIOD; latest_stamp <= 100 * PERIOD; latest_stamp += PERIOD) {
+      for (size_t frame = 0; frame < frames.size(); ++frame) {
+        setTransform(frame, latest_stamp);
+      }
+    }
+  }
+}
+
+void tearDown(const benchmark::State & state)
+{
+  if (state.thread_index == 0) {
+    buffer.reset();
+  }
+}
+
+// Look up the latest transform from one of the sensors to the map
+void lookUp(int64_t & count)
+{
+  const std::string source = chainFrame(static_cast<int>(count % SENSOR_COUNT), CHAIN_LENGTH + 1);
+  benchmark::DoNotOptimize(buffer->lookupTransform("map", source, tf2::TimePointZero));
+  ++count;
+}
+
+}  // namespace
+
+// All threads look up transforms
+static void BM_lookup_transform(benchmark::State & state)
+{
+  setUp(state);
+  int64_t lookups = 0;
+  for (auto _ : state) {
+    lookUp(lookups);
+  }
+  state.counters["lookups"] = benchmark::Counter(
+    static_cast<double>(lookups), benchmark::Counter::kIsRate);
+  tearDown(state);
+}
+BENCHMARK(BM_lookup_transform)->ThreadRange(1, 8)->UseRealTime();
+
+// The first thread adds transforms, as a transform listener would, the others look up transforms
+static void BM_lookup_transform_while_setting(benchmark::State & state)
+{
+  setUp(state);
+  int64_t lookups = 0;
+  int64_t transforms = 0;
+  // Only the first thread set up the buffer before the threads started together
+  int64_t stamp = state.thread_index == 0 ? latest_stamp : 0;
+  for (auto _ : state) {
+    if (state.thread_index == 0) {
+      // Update all frames in turns, so that the latest common time keeps moving
+      size_t frame = static_cast<size_t>(transforms) % frames.size();
+      if (frame == 0) {
+        stamp += PERIOD;
+      }
+      setTransform(frame, stamp);
+      ++transforms;
+    } else {
+      lookUp(lookups);
+    }
+  }
+  state.counters["lookups"] = benchmark::Counter(
+    static_cast<double>(lookups), benchmark::Counter::kIsRate);
+  state.counters["transforms_set"] = benchmark::Counter(
+    static_cast<double>(transforms), benchmark::Counter::kIsRate);
+  tearDown(state);
+}
+BENCHMARK(BM_lookup_transform_while_setting)->ThreadRange(2, 8)->UseRealTime();
@@ -38,6 +38,7 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -65,6 +66,17 @@ enum TransformableResult
   TransformFailure,
 };
 
+/** \brief A transform to look up with BufferCore::lookupTransforms() */
+struct TransformLookup
+{
+  /// The frame to which data should be transformed
+  std::string target_frame;
+  /// The frame where the data originated
+  std::string source_frame;
+  /// The time at which the value of the transform is desired. (0 will get the latest)
+  TimePoint time;
+};
+
 //!< The default amount of time to cache data in seconds
 static constexpr Duration BUFFER_CORE_DEFAULT_CACHE_TIME = std::chrono::seconds(10);
 
@@ -156,6 +168,29 @@ public:
     const std::string & source_frame, const TimePoint & source_time,
     const std::string & fixed_frame) const override;
 
+  /** \brief Get the transforms between several pairs of frames.
+   * The lookups share one lock of the frame tree, frame IDs repeated by consecutive lookups are
+   * resolved once, and the paths between the frames are cached until the frame tree changes.
+   * Lookups only walk the tree up to the common parent of their frames.
+   * \param lookups The frames and times of the transforms
+   * \return The transforms, in the order of the lookups
+   *
+   * Possible exceptions tf2::LookupException, tf2::ConnectivityException,
+   * tf2::ExtrapolationException, tf2::InvalidArgumentException
+   */
+  TF2_PUBLIC
+  std::vector<geometry_msgs::msg::TransformStamped>
+  lookupTransforms(const std::vector<TransformLookup> & lookups) const;
+
+  /** \brief Get the transforms from several frames to one frame.
+   * \sa lookupTransforms(const std::vector<TransformLookup>&)
+   */
+  TF2_PUBLIC
+  std::vector<geometry_msgs::msg::TransformStamped>
+  lookupTransforms(
+    const std::string & target_frame, const std::vector<std::string> & source_frames,
+    const TimePoint & time) const;
+
   /** \brief Test if a transform is possible
    * \param target_frame The frame into which to transform
    * \param source_frame The frame from which to transform
@@ -267,7 +302,7 @@ public:
     CompactFrameID target_frame, CompactFrameID source_frame,
     TimePoint & time, std::string * error_string) const
   {
-    std::unique_lock<std::mutex> lock(frame_mutex_);
+    std::shared_lock<std::shared_timed_mutex> lock(frame_mutex_);
     return getLatestCommonTime(target_frame, source_frame, time, error_string);
   }
 
@@ -315,8 +350,9 @@ private:
   typedef std::vector<TimeCacheInterfacePtr> V_TimeCacheInterface;
   V_TimeCacheInterface frames_;
 
-  /** \brief A mutex to protect testing and allocating new frames on the above vector. */
-  mutable std::mutex frame_mutex_;
+  /** \brief A mutex to protect testing and allocating new frames on the above vector.
+   * Lookups only read the frames and share it, adding transforms holds it exclusively. */
+  mutable std::shared_timed_mutex frame_mutex_;
 
   /** \brief A map from string frame ids to CompactFrameID */
   typedef std::unordered_map<std::string, CompactFrameID> M_StringToCompactFrameID;
@@ -327,6 +363,20 @@ private:
   std::map<CompactFrameID, std::string> frame_authority_;
 
 
+  /** \brief The frames walked from a source and a target frame up to their common parent.
+   * The parent of each frame is the next one of its chain, or the common parent for the last. */
+  struct FramePath
+  {
+    std::vector<CompactFrameID> source_chain;
+    std::vector<CompactFrameID> target_chain;
+    CompactFrameID common_parent;
+  };
+  /** \brief The paths of lookupTransforms(), keyed by target and source frame.
+   * Cleared while holding frame_mutex_ exclusively whenever a frame gets a new parent. */
+  mutable std::unordered_map<uint64_t, FramePath> frame_paths_;
+  /** \brief Protects frame_paths_ between lookups holding frame_mutex_ shared. */
+  mutable std::shared_timed_mutex frame_paths_mutex_;
+
   /// How long to cache transform history
   tf2::Duration cache_time_;
 
@@ -364,6 +414,29 @@ private:
     const std::string & target_frame, const std::string & source_frame,
     const TimePoint & time_in, tf2::Transform & transform, TimePoint & time_out) const;
 
+  // Look up a transform, frame_mutex_ must be held.
+  void lookupTransformNoLock(
+    const std::string & target_frame, const std::string & source_frame,
+    const TimePoint & time_in, tf2::Transform & transform, TimePoint & time_out) const;
+
+  // Look up a transform between different existing frames, frame_mutex_ must be held.
+  void lookupTransformNoLock(
+    CompactFrameID target_id, CompactFrameID source_id,
+    const TimePoint & time_in, tf2::Transform & transform, TimePoint & time_out) const;
+
+  /** \brief Get the cached path between two different frames, finding it if needed.
+   * The path is found along the latest parents of the frames, frame_mutex_ must be held.
+   * \return The path, or NULL if the frames are not connected
+   */
+  const FramePath * getFramePath(CompactFrameID target_id, CompactFrameID source_id) const;
+
+  /** \brief Look up a transform along a path, frame_mutex_ must be held.
+   * \return False if the path does not hold at the time or data is missing
+   */
+  bool lookupTransformOnPath(
+    const FramePath & path, const TimePoint & time_in,
+    tf2::Transform & transform, TimePoint & time_out) const;
+
   void lookupTransformImpl(
     const std::string & target_frame, const TimePoint & target_time,
     const std::string & source_frame, const TimePoint & source_time,
@@ -32,10 +32,10 @@
 
 #include <chrono>
 #include <memory>
-#include <list>
 #include <sstream>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "tf2/visibility_control.h"
 #include "tf2/transform_storage.h"
@@ -95,10 +95,12 @@ using TimeCacheInterfacePtr = std::shared_ptr<TimeCacheInterface>;
 /// default value of 10 seconds storage
 constexpr tf2::Duration TIMECACHE_DEFAULT_MAX_STORAGE_TIME = std::chrono::seconds(10);
 
-/** \brief A class to keep a sorted linked list in time
+/** \brief A class to keep a sorted list in time
  * This builds and maintains a list of timestamped
  * data.  And provides lookup functions to get
- * data out as a function of time. */
+ * data out as a function of time.
+ * The data is kept in a circular buffer ordered from oldest to latest, which only
+ * allocates when it grows, and is searched with a binary search. */
 class TimeCache : public TimeCacheInterface
 {
 public:
@@ -136,11 +138,26 @@ public:
   virtual TimePoint getOldestTimestamp();
 
 private:
-  typedef std::list<TransformStorage> L_TransformStorage;
-  L_TransformStorage storage_;
+  /// Initial capacity of the circular buffer, a power of two.
+  static const size_t INITIAL_CAPACITY = 16;
+
+  // Circular buffer whose size is its capacity, always a power of two
+  std::vector<TransformStorage> storage_;
+  // Index of the oldest element in storage_
+  size_t oldest_;
+  // Number of elements stored
+  size_t length_;
 
   tf2::Duration max_storage_time_;
 
+  // Access the element at the given position from the oldest
+  inline TransformStorage & at(size_t position);
+
+  // Position of the first element newer than the time, length_ if there is none
+  inline size_t upperBound(tf2::TimePoint time);
+
+  // Double the capacity of the circular buffer
+  void grow();
 
   // A helper function for getData
   // Assumes storage is already locked for it
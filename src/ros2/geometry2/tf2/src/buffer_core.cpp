@@ -32,6 +32,7 @@
 #include <cassert>
 #include <map>
 #include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -225,7 +226,8 @@ BufferCore::~BufferCore() {}
 
 void BufferCore::clear()
 {
-  std::unique_lock<std::mutex> lock(frame_mutex_);
+  std::unique_lock<std::shared_timed_mutex> lock(frame_mutex_);
+  frame_paths_.clear();
   if (frames_.size() > 1) {
     for (std::vector<TimeCacheInterfacePtr>::iterator cache_it = frames_.begin() + 1;
       cache_it != frames_.end(); ++cache_it)
@@ -328,7 +330,7 @@ bool BufferCore::setTransformImpl(
   }
 
   {
-    std::unique_lock<std::mutex> lock(frame_mutex_);
+    std::unique_lock<std::shared_timed_mutex> lock(frame_mutex_);
     CompactFrameID frame_number = lookupOrInsertFrameNumber(stripped_child_frame_id);
     TimeCacheInterfacePtr frame = getFrame(frame_number);
     if (frame == NULL) {
@@ -344,10 +346,16 @@ bool BufferCore::setTransformImpl(
       }
     }
 
+    CompactFrameID parent_number = lookupOrInsertFrameNumber(stripped_frame_id);
+    // The paths of lookupTransforms() follow the latest parents
+    if (frame->getLatestTimeAndParent().second != parent_number && !frame_paths_.empty()) {
+      frame_paths_.clear();
+    }
+
     if (frame->insertData(
         TransformStorage(
           stamp, transform_in.getRotation(),
-          transform_in.getOrigin(), lookupOrInsertFrameNumber(stripped_frame_id), frame_number)))
+          transform_in.getOrigin(), parent_number, frame_number)))
     {
       frame_authority_[frame_number] = authority;
     } else {
@@ -639,14 +647,13 @@ struct TransformAccum
   tf2::Vector3 result_vec;
 };
 
-geometry_msgs::msg::TransformStamped
-BufferCore::lookupTransform(
-  const std::string & target_frame, const std::string & source_frame,
-  const TimePoint & time) const
+namespace
+{
+
+geometry_msgs::msg::TransformStamped transformToMsg(
+  const tf2::Transform & transform, const TimePoint & time,
+  const std::string & target_frame, const std::string & source_frame)
 {
-  tf2::Transform transform;
-  TimePoint time_out;
-  lookupTransformImpl(target_frame, source_frame, time, transform, time_out);
   geometry_msgs::msg::TransformStamped msg;
   msg.transform.translation.x = transform.getOrigin().x();
   msg.transform.translation.y = transform.getOrigin().y();
@@ -656,9 +663,9 @@ BufferCore::lookupTransform(
   msg.transform.rotation.z = transform.getRotation().z();
   msg.transform.rotation.w = transform.getRotation().w();
   std::chrono::nanoseconds ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
-    time_out.time_since_epoch());
+    time.time_since_epoch());
   std::chrono::seconds s = std::chrono::duration_cast<std::chrono::seconds>(
-    time_out.time_since_epoch());
+    time.time_since_epoch());
   msg.header.stamp.sec = (int32_t)s.count();
   msg.header.stamp.nanosec = (uint32_t)(ns.count() % 1000000000ull);
   msg.header.frame_id = target_frame;
@@ -667,6 +674,19 @@ BufferCore::lookupTransform(
   return msg;
 }
 
+}  // anonymous namespace
+
+geometry_msgs::msg::TransformStamped
+BufferCore::lookupTransform(
+  const std::string & target_frame, const std::string & source_frame,
+  const TimePoint & time) const
+{
+  tf2::Transform transform;
+  TimePoint time_out;
+  lookupTransformImpl(target_frame, source_frame, time, transform, time_out);
+  return transformToMsg(transform, time_out, target_frame, source_frame);
+}
+
 geometry_msgs::msg::TransformStamped
 BufferCore::lookupTransform(
   const std::string & target_frame, const TimePoint & target_time,
@@ -678,24 +698,166 @@ BufferCore::lookupTransform(
   lookupTransformImpl(
     target_frame, target_time, source_frame, source_time,
     fixed_frame, transform, time_out);
-  geometry_msgs::msg::TransformStamped msg;
-  msg.transform.translation.x = transform.getOrigin().x();
-  msg.transform.translation.y = transform.getOrigin().y();
-  msg.transform.translation.z = transform.getOrigin().z();
-  msg.transform.rotation.x = transform.getRotation().x();
-  msg.transform.rotation.y = transform.getRotation().y();
-  msg.transform.rotation.z = transform.getRotation().z();
-  msg.transform.rotation.w = transform.getRotation().w();
-  std::chrono::nanoseconds ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
-    time_out.time_since_epoch());
-  std::chrono::seconds s = std::chrono::duration_cast<std::chrono::seconds>(
-    time_out.time_since_epoch());
-  msg.header.stamp.sec = (int32_t)s.count();
-  msg.header.stamp.nanosec = (uint32_t)(ns.count() % 1000000000ull);
-  msg.header.frame_id = target_frame;
-  msg.child_frame_id = source_frame;
+  return transformToMsg(transform, time_out, target_frame, source_frame);
+}
 
-  return msg;
+std::vector<geometry_msgs::msg::TransformStamped>
+BufferCore::lookupTransforms(const std::vector<TransformLookup> & lookups) const
+{
+  std::vector<geometry_msgs::msg::TransformStamped> transforms;
+  transforms.reserve(lookups.size());
+
+  std::shared_lock<std::shared_timed_mutex> lock(frame_mutex_);
+
+  const std::string * last_target_frame = nullptr;
+  const std::string * last_source_frame = nullptr;
+  CompactFrameID target_id = 0;
+  CompactFrameID source_id = 0;
+  for (const TransformLookup & lookup : lookups) {
+    tf2::Transform transform;
+    TimePoint time_out;
+    if (lookup.target_frame == lookup.source_frame) {
+      lookupTransformNoLock(
+        lookup.target_frame, lookup.source_frame, lookup.time, transform, time_out);
+    } else {
+      if (!last_target_frame || *last_target_frame != lookup.target_frame) {
+        target_id = validateFrameId("lookupTransforms argument target_frame", lookup.target_frame);
+        last_target_frame = &lookup.target_frame;
+      }
+      if (!last_source_frame || *last_source_frame != lookup.source_frame) {
+        source_id = validateFrameId("lookupTransforms argument source_frame", lookup.source_frame);
+        last_source_frame = &lookup.source_frame;
+      }
+
+      const FramePath * path = getFramePath(target_id, source_id);
+      if (!path || !lookupTransformOnPath(*path, lookup.time, transform, time_out)) {
+        // Walk the tree as usual, which also reports the error if there is one
+        lookupTransformNoLock(target_id, source_id, lookup.time, transform, time_out);
+      }
+    }
+    transforms.push_back(
+      transformToMsg(transform, time_out, lookup.target_frame, lookup.source_frame));
+  }
+
+  return transforms;
+}
+
+std::vector<geometry_msgs::msg::TransformStamped>
+BufferCore::lookupTransforms(
+  const std::string & target_frame, const std::vector<std::string> & source_frames,
+  const TimePoint & time) const
+{
+  std::vector<TransformLookup> lookups;
+  lookups.reserve(source_frames.size());
+  for (const std::string & source_frame : source_frames) {
+    lookups.push_back(TransformLookup{target_frame, source_frame, time});
+  }
+  return lookupTransforms(lookups);
+}
+
+const BufferCore::FramePath * BufferCore::getFramePath(
+  CompactFrameID target_id, CompactFrameID source_id) const
+{
+  const uint64_t key = (static_cast<uint64_t>(target_id) << 32) | source_id;
+  {
+    std::shared_lock<std::shared_timed_mutex> lock(frame_paths_mutex_);
+    auto path_it = frame_paths_.find(key);
+    if (path_it != frame_paths_.end()) {
+      return &path_it->second;
+    }
+  }
+
+  // Walk the tree to its root from the source frame
+  std::vector<CompactFrameID> source_ancestors;
+  CompactFrameID frame = source_id;
+  while (frame != 0) {
+    source_ancestors.push_back(frame);
+    if (source_ancestors.size() > MAX_GRAPH_DEPTH) {
+      return NULL;
+    }
+
+    TimeCacheInterfacePtr cache = getFrame(frame);
+    if (!cache) {
+      break;
+    }
+    frame = cache->getLatestTimeAndParent().second;
+  }
+
+  // Now walk from the target frame until reaching one of the ancestors of the source frame
+  FramePath path;
+  frame = target_id;
+  std::vector<CompactFrameID>::iterator common_it;
+  while ((common_it = std::find(source_ancestors.begin(), source_ancestors.end(), frame)) ==
+    source_ancestors.end())
+  {
+    path.target_chain.push_back(frame);
+    if (path.target_chain.size() > MAX_GRAPH_DEPTH) {
+      return NULL;
+    }
+
+    TimeCacheInterfacePtr cache = getFrame(frame);
+    if (!cache) {
+      return NULL;
+    }
+    frame = cache->getLatestTimeAndParent().second;
+    if (frame == 0) {
+      return NULL;
+    }
+  }
+  path.source_chain.assign(source_ancestors.begin(), common_it);
+  path.common_parent = frame;
+
+  std::unique_lock<std::shared_timed_mutex> lock(frame_paths_mutex_);
+  return &frame_paths_.emplace(key, std::move(path)).first->second;
+}
+
+bool BufferCore::lookupTransformOnPath(
+  const FramePath & path, const TimePoint & time_in,
+  tf2::Transform & transform, TimePoint & time_out) const
+{
+  TimePoint time = time_in;
+  // If getting the latest get the latest common time, as getLatestCommonTime() does
+  if (time == TimePointZero) {
+    TimePoint common_time = TimePoint::max();
+    for (const std::vector<CompactFrameID> * chain : {&path.source_chain, &path.target_chain}) {
+      for (size_t i = 0; i < chain->size(); ++i) {
+        TimeCacheInterfacePtr cache = getFrame((*chain)[i]);
+        if (!cache) {
+          return false;
+        }
+        P_TimeAndFrameID latest = cache->getLatestTimeAndParent();
+        CompactFrameID parent = i + 1 < chain->size() ? (*chain)[i + 1] : path.common_parent;
+        if (latest.second != parent) {
+          return false;
+        }
+        if (latest.first != TimePointZero) {
+          common_time = std::min(latest.first, common_time);
+        }
+      }
+    }
+    time = common_time == TimePoint::max() ? TimePointZero : common_time;
+  }
+
+  TransformAccum accum;
+  for (const std::vector<CompactFrameID> * chain : {&path.source_chain, &path.target_chain}) {
+    for (size_t i = 0; i < chain->size(); ++i) {
+      TimeCacheInterfacePtr cache = getFrame((*chain)[i]);
+      if (!cache) {
+        return false;
+      }
+      CompactFrameID parent = i + 1 < chain->size() ? (*chain)[i + 1] : path.common_parent;
+      if (accum.gather(cache, time, NULL) != parent) {
+        return false;
+      }
+      accum.accum(chain == &path.source_chain);
+    }
+  }
+  accum.finalize(FullPath, time);
+
+  time_out = accum.time;
+  transform.setOrigin(accum.result_vec);
+  transform.setRotation(accum.result_quat);
+  return true;
 }
 
 void BufferCore::lookupTransformImpl(
@@ -704,8 +866,16 @@ void BufferCore::lookupTransformImpl(
   const TimePoint & time, tf2::Transform & transform,
   TimePoint & time_out) const
 {
-  std::unique_lock<std::mutex> lock(frame_mutex_);
+  std::shared_lock<std::shared_timed_mutex> lock(frame_mutex_);
+  lookupTransformNoLock(target_frame, source_frame, time, transform, time_out);
+}
 
+void BufferCore::lookupTransformNoLock(
+  const std::string & target_frame,
+  const std::string & source_frame,
+  const TimePoint & time, tf2::Transform & transform,
+  TimePoint & time_out) const
+{
   if (target_frame == source_frame) {
     transform.setIdentity();
 
@@ -727,6 +897,14 @@ void BufferCore::lookupTransformImpl(
   CompactFrameID target_id = validateFrameId("lookupTransform argument target_frame", target_frame);
   CompactFrameID source_id = validateFrameId("lookupTransform argument source_frame", source_frame);
 
+  lookupTransformNoLock(target_id, source_id, time, transform, time_out);
+}
+
+void BufferCore::lookupTransformNoLock(
+  CompactFrameID target_id, CompactFrameID source_id,
+  const TimePoint & time, tf2::Transform & transform,
+  TimePoint & time_out) const
+{
   std::string error_string;
   TransformAccum accum;
   tf2::TF2Error retval = walkToTopParent(accum, time, target_id, source_id, &error_string);
@@ -757,9 +935,12 @@ void BufferCore::lookupTransformImpl(
   const std::string & fixed_frame, tf2::Transform & transform,
   TimePoint & time_out) const
 {
-  validateFrameId("lookupTransform argument target_frame", target_frame);
-  validateFrameId("lookupTransform argument source_frame", source_frame);
-  validateFrameId("lookupTransform argument fixed_frame", fixed_frame);
+  {
+    std::shared_lock<std::shared_timed_mutex> lock(frame_mutex_);
+    validateFrameId("lookupTransform argument target_frame", target_frame);
+    validateFrameId("lookupTransform argument source_frame", source_frame);
+    validateFrameId("lookupTransform argument fixed_frame", fixed_frame);
+  }
 
   tf2::Transform tf1, tf2;
 
@@ -817,7 +998,7 @@ bool BufferCore::canTransformInternal(
   CompactFrameID target_id, CompactFrameID source_id,
   const TimePoint & time, std::string * error_msg) const
 {
-  std::unique_lock<std::mutex> lock(frame_mutex_);
+  std::shared_lock<std::shared_timed_mutex> lock(frame_mutex_);
   return canTransformNoLock(target_id, source_id, time, error_msg);
 }
 
@@ -830,6 +1011,7 @@ bool BufferCore::canTransform(
     return true;
   }
 
+  std::shared_lock<std::shared_timed_mutex> lock(frame_mutex_);
   CompactFrameID target_id = validateFrameId(
     "canTransform argument target_frame", target_frame, error_msg);
   if (target_id == 0) {
@@ -841,7 +1023,7 @@ bool BufferCore::canTransform(
     return false;
   }
 
-  return canTransformInternal(target_id, source_id, time, error_msg);
+  return canTransformNoLock(target_id, source_id, time, error_msg);
 }
 
 bool BufferCore::canTransform(
@@ -849,6 +1031,7 @@ bool BufferCore::canTransform(
   const std::string & source_frame, const TimePoint & source_time,
   const std::string & fixed_frame, std::string * error_msg) const
 {
+  std::shared_lock<std::shared_timed_mutex> lock(frame_mutex_);
   CompactFrameID target_id = validateFrameId(
     "canTransform argument target_frame", target_frame, error_msg);
   if (target_id == 0) {
@@ -866,8 +1049,8 @@ bool BufferCore::canTransform(
   }
 
   return
-    canTransformInternal(target_id, fixed_id, target_time, error_msg) &&
-    canTransformInternal(fixed_id, source_id, source_time, error_msg);
+    canTransformNoLock(target_id, fixed_id, target_time, error_msg) &&
+    canTransformNoLock(fixed_id, source_id, source_time, error_msg);
 }
 
 tf2::TimeCacheInterfacePtr BufferCore::getFrame(CompactFrameID frame_id) const
@@ -940,7 +1123,7 @@ std::vector<std::string> BufferCore::getAllFrameNames() const
 
 std::string BufferCore::allFramesAsString() const
 {
-  std::unique_lock<std::mutex> lock(frame_mutex_);
+  std::shared_lock<std::shared_timed_mutex> lock(frame_mutex_);
   return this->allFramesAsStringNoLock();
 }
 
@@ -1137,7 +1320,7 @@ tf2::TF2Error BufferCore::getLatestCommonTime(
 std::string BufferCore::allFramesAsYAML(TimePoint current_time) const
 {
   std::stringstream mstream;
-  std::unique_lock<std::mutex> lock(frame_mutex_);
+  std::shared_lock<std::shared_timed_mutex> lock(frame_mutex_);
 
   TransformStorage temp;
 
@@ -1301,7 +1484,7 @@ void BufferCore::cancelTransformableRequest(TransformableRequestHandle handle)
 // backwards compability for tf methods
 bool BufferCore::_frameExists(const std::string & frame_id_str) const
 {
-  std::unique_lock<std::mutex> lock(frame_mutex_);
+  std::shared_lock<std::shared_timed_mutex> lock(frame_mutex_);
   return frameIDs_.count(frame_id_str) != 0;
 }
 
@@ -1309,7 +1492,7 @@ bool BufferCore::_getParent(
   const std::string & frame_id, TimePoint time,
   std::string & parent) const
 {
-  std::unique_lock<std::mutex> lock(frame_mutex_);
+  std::shared_lock<std::shared_timed_mutex> lock(frame_mutex_);
   CompactFrameID frame_number = lookupFrameNumber(frame_id);
   TimeCacheInterfacePtr frame = getFrame(frame_number);
 
@@ -1330,7 +1513,7 @@ void BufferCore::_getFrameStrings(std::vector<std::string> & vec) const
 {
   vec.clear();
 
-  std::unique_lock<std::mutex> lock(frame_mutex_);
+  std::shared_lock<std::shared_timed_mutex> lock(frame_mutex_);
 
   TransformStorage temp;
 
@@ -1403,7 +1586,7 @@ std::string BufferCore::_allFramesAsDot(TimePoint current_time) const
 {
   std::stringstream mstream;
   mstream << "digraph G {" << std::endl;
-  std::unique_lock<std::mutex> lock(frame_mutex_);
+  std::shared_lock<std::shared_timed_mutex> lock(frame_mutex_);
 
   TransformStorage temp;
 
@@ -1512,7 +1695,7 @@ void BufferCore::_chainAsVector(
   output.clear();  // empty vector
 
   std::stringstream mstream;
-  std::unique_lock<std::mutex> lock(frame_mutex_);
+  std::shared_lock<std::shared_timed_mutex> lock(frame_mutex_);
 
   TransformAccum accum;
 
@@ -32,6 +32,7 @@
 
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "tf2/time_cache.h"
 #include "tf2/exceptions.h"
@@ -59,9 +60,43 @@ TransformStorage::TransformStorage(
 }
 
 TimeCache::TimeCache(tf2::Duration max_storage_time)
-: max_storage_time_(max_storage_time)
+: storage_(INITIAL_CAPACITY),
+  oldest_(0),
+  length_(0),
+  max_storage_time_(max_storage_time)
 {}
 
+TransformStorage & TimeCache::at(size_t position)
+{
+  return storage_[(oldest_ + position) & (storage_.size() - 1)];
+}
+
+size_t TimeCache::upperBound(TimePoint time)
+{
+  size_t first = 0;
+  size_t count = length_;
+  while (count > 0) {
+    size_t step = count / 2;
+    if (at(first + step).stamp_ <= time) {
+      first += step + 1;
+      count -= step + 1;
+    } else {
+      count = step;
+    }
+  }
+  return first;
+}
+
+void TimeCache::grow()
+{
+  std::vector<TransformStorage> storage(storage_.size() * 2);
+  for (size_t i = 0; i < length_; ++i) {
+    storage[i] = at(i);
+  }
+  storage_.swap(storage);
+  oldest_ = 0;
+}
+
 // Avoid ODR collisions https://github.com/ros/geometry2/issues/175
 namespace cache
 {
@@ -103,19 +138,19 @@ uint8_t TimeCache::findClosest(
   TimePoint target_time, std::string * error_str)
 {
   // No values stored
-  if (storage_.empty()) {
+  if (length_ == 0) {
     return 0;
   }
 
   // If time == 0 return the latest
   if (target_time == TimePointZero) {
-    one = &storage_.front();
+    one = &at(length_ - 1);
     return 1;
   }
 
   // One value stored
-  if (++storage_.begin() == storage_.end()) {
-    TransformStorage & ts = *storage_.begin();
+  if (length_ == 1) {
+    TransformStorage & ts = at(0);
     if (ts.stamp_ == target_time) {
       one = &ts;
       return 1;
@@ -125,14 +160,14 @@ uint8_t TimeCache::findClosest(
     }
   }
 
-  TimePoint latest_time = (*storage_.begin()).stamp_;
-  TimePoint earliest_time = (*(storage_.rbegin())).stamp_;
+  TimePoint latest_time = at(length_ - 1).stamp_;
+  TimePoint earliest_time = at(0).stamp_;
 
   if (target_time == latest_time) {
-    one = &(*storage_.begin());
+    one = &at(length_ - 1);
     return 1;
   } else if (target_time == earliest_time) {
-    one = &(*storage_.rbegin());
+    one = &at(0);
     return 1;
   } else {   // Catch cases that would require extrapolation
     if (target_time > latest_time) {
@@ -147,18 +182,12 @@ uint8_t TimeCache::findClosest(
   }
 
   // At least 2 values stored
-  // Find the first value less than the target value
-  L_TransformStorage::iterator storage_it = storage_.begin();
-  while (storage_it != storage_.end()) {
-    if (storage_it->stamp_ <= target_time) {
-      break;
-    }
-    storage_it++;
-  }
+  // Find the first value greater than the target value
+  size_t position = upperBound(target_time);
 
   // Finally the case were somewhere in the middle  Guarenteed no extrapolation :-)
-  one = &*(storage_it);  // Older
-  two = &*(--storage_it);  // Newer
+  one = &at(position - 1);  // Older
+  two = &at(position);  // Newer
   return 2;
 }
 
@@ -226,21 +255,26 @@ CompactFrameID TimeCache::getParent(TimePoint time, std::string * error_str)
 
 bool TimeCache::insertData(const TransformStorage & new_data)
 {
-  L_TransformStorage::iterator storage_it = storage_.begin();
-
-  if (storage_it != storage_.end()) {
-    if (storage_it->stamp_ > new_data.stamp_ + max_storage_time_) {
+  if (length_ != 0) {
+    if (at(length_ - 1).stamp_ > new_data.stamp_ + max_storage_time_) {
       return false;
     }
   }
 
-  while (storage_it != storage_.end()) {
-    if (storage_it->stamp_ <= new_data.stamp_) {
-      break;
+  if (length_ == storage_.size()) {
+    grow();
+  }
+
+  // Data usually arrives in order, only older data needs to move the newer data
+  size_t position = length_;
+  if (length_ != 0 && at(length_ - 1).stamp_ > new_data.stamp_) {
+    position = upperBound(new_data.stamp_);
+    for (size_t i = length_; i > position; --i) {
+      at(i) = at(i - 1);
     }
-    storage_it++;
   }
-  storage_.insert(storage_it, new_data);
+  at(position) = new_data;
+  ++length_;
 
   pruneList();
   return true;
@@ -248,48 +282,51 @@ bool TimeCache::insertData(const TransformStorage & new_data)
 
 void TimeCache::clearList()
 {
-  storage_.clear();
+  // The capacity is kept for the data to come
+  oldest_ = 0;
+  length_ = 0;
 }
 
 unsigned int TimeCache::getListLength()
 {
-  return (unsigned int)storage_.size();
+  return (unsigned int)length_;
 }
 
 P_TimeAndFrameID TimeCache::getLatestTimeAndParent()
 {
-  if (storage_.empty()) {
+  if (length_ == 0) {
     return std::make_pair(TimePoint(), 0);
   }
 
-  const TransformStorage & ts = storage_.front();
+  const TransformStorage & ts = at(length_ - 1);
   return std::make_pair(ts.stamp_, ts.frame_id_);
 }
 
 TimePoint TimeCache::getLatestTimestamp()
 {
   // empty list case
-  if (storage_.empty()) {
+  if (length_ == 0) {
     return TimePoint();
   }
-  return storage_.front().stamp_;
+  return at(length_ - 1).stamp_;
 }
 
 TimePoint TimeCache::getOldestTimestamp()
 {
   // empty list case
-  if (storage_.empty()) {
+  if (length_ == 0) {
     return TimePoint();
   }
-  return storage_.back().stamp_;
+  return at(0).stamp_;
 }
 
 void TimeCache::pruneList()
 {
-  TimePoint latest_time = storage_.begin()->stamp_;
+  TimePoint latest_time = at(length_ - 1).stamp_;
 
-  while (!storage_.empty() && storage_.back().stamp_ + max_storage_time_ < latest_time) {
-    storage_.pop_back();
+  while (length_ != 0 && at(0).stamp_ + max_storage_time_ < latest_time) {
+    oldest_ = (oldest_ + 1) & (storage_.size() - 1);
+    --length_;
   }
 }
 }  // namespace tf2
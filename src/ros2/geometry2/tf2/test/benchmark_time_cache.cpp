@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2021, Open Source Robotics Foundation, Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Willow Garage, Inc. nor the names of its
+ *       contributors may be used to endorse or promote products derived from
+ *       this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstdint>
+
+#include "tf2/time_cache.h"
+
+namespace
+{
+
+// Time between two transforms in the caches
+constexpr int64_t PERIOD = 10;
+
+tf2::TransformStorage makeStorage(int64_t stamp)
+{
+  tf2::TransformStorage storage;
+  storage.translation_.setValue(1.0, 2.0, 3.0);
+  storage.rotation_.setValue(0.0, 0.0, 0.0, 1.0);
+  storage.stamp_ = tf2::TimePoint(std::chrono::nanoseconds(stamp));
+  storage.frame_id_ = 1;
+  storage.child_frame_id_ = 2;
+  return storage;
+}
+
+// A cache holding state.range(0) transforms, with the latest at the given stamp
+tf2::TimeCache makeFullCache(const benchmark::State & state, int64_t latest_stamp)
+{
+  tf2::TimeCache cache(std::chrono::nanoseconds((state.range(0) - 1) * PERIOD));
+  for (int64_t i = state.range(0) - 1; i >= 0; --i) {
+    cache.insertData(makeStorage(latest_stamp - i * PERIOD));
+  }
+  return cache;
+}
+
+}  // namespace
+
+// Insert the latest transform, pruning the oldest one
+static void BM_insert_latest(benchmark::State & state)
+{
+  int64_t stamp = state.range(0) * PERIOD;
+  tf2::TimeCache cache = makeFullCache(state, stamp);
+  for (auto _ : state) {
+    stamp += PERIOD;
+    cache.insertData(makeStorage(stamp));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_insert_latest)->RangeMultiplier(4)->Range(16, 16384);
+
+// Insert a transform half-way into the cache, as with data arriving late
+static void BM_insert_out_of_order(benchmark::State & state)
+{
+  int64_t stamp = state.range(0) * PERIOD;
+  tf2::TimeCache cache = makeFullCache(state, stamp);
+  for (auto _ : state) {
+    state.PauseTiming();
+    stamp += PERIOD;
+    cache.insertData(makeStorage(stamp));
+    state.ResumeTiming();
+    cache.insertData(makeStorage(stamp - state.range(0) / 2 * PERIOD + PERIOD / 2));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_insert_out_of_order)->RangeMultiplier(4)->Range(16, 16384);
+
+// Look up a transform interpolated half-way into the cache
+static void BM_lookup_interpolated(benchmark::State & state)
+{
+  int64_t latest_stamp = state.range(0) * PERIOD;
+  tf2::TimeCache cache = makeFullCache(state, latest_stamp);
+  tf2::TimePoint time(
+    std::chrono::nanoseconds(latest_stamp - state.range(0) / 2 * PERIOD + PERIOD / 2));
+  tf2::TransformStorage output;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(cache.getData(time, output));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_lookup_interpolated)->RangeMultiplier(4)->Range(16, 16384);
+
+// Look up the latest transform, as done for time zero
+static void BM_lookup_latest(benchmark::State & state)
+{
+  tf2::TimeCache cache = makeFullCache(state, state.range(0) * PERIOD);
+  tf2::TransformStorage output;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(cache.getData(tf2::TimePointZero, output));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_lookup_latest)->RangeMultiplier(4)->Range(16, 16384);
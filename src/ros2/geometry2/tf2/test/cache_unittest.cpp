@@ -28,6 +28,7 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <cmath>
 #include <stdexcept>
 #include <string>
@@ -322,6 +323,75 @@ TEST(TimeCache, DuplicateEntries)
   EXPECT_TRUE(!std::isnan(stor.rotation_.w()));
 }
 
+TEST(TimeCache, PruneWhileWrappingAround)
+{
+  tf2::TimeCache cache(std::chrono::nanoseconds(10));
+
+  tf2::TransformStorage stor;
+  setIdentity(stor);
+
+  // Inserting far more data than kept reuses the storage of the pruned data
+  for (uint64_t i = 1; i < 1000; i++) {
+    stor.frame_id_ = tf2::CompactFrameID(i);
+    stor.stamp_ = tf2::TimePoint(std::chrono::nanoseconds(i));
+    EXPECT_TRUE(cache.insertData(stor));
+
+    EXPECT_EQ(cache.getListLength(), std::min<uint64_t>(i, 11));
+    EXPECT_EQ(cache.getLatestTimestamp(), tf2::TimePoint(std::chrono::nanoseconds(i)));
+    EXPECT_EQ(
+      cache.getOldestTimestamp(),
+      tf2::TimePoint(std::chrono::nanoseconds(i < 11 ? 1 : i - 10)));
+  }
+
+  for (uint64_t i = 989; i < 1000; i++) {
+    ASSERT_TRUE(cache.getData(tf2::TimePoint(std::chrono::nanoseconds(i)), stor));
+    EXPECT_EQ(stor.frame_id_, i);
+  }
+  EXPECT_FALSE(cache.getData(tf2::TimePoint(std::chrono::nanoseconds(988)), stor));
+
+  // Too old to be inserted
+  stor.stamp_ = tf2::TimePoint(std::chrono::nanoseconds(988));
+  EXPECT_FALSE(cache.insertData(stor));
+
+  cache.clearList();
+  EXPECT_EQ(cache.getListLength(), 0u);
+  EXPECT_FALSE(cache.getData(tf2::TimePoint(std::chrono::nanoseconds(999)), stor));
+}
+
+TEST(TimeCache, OutOfOrderInsertWhileWrappingAround)
+{
+  tf2::TimeCache cache(std::chrono::nanoseconds(100));
+
+  tf2::TransformStorage stor;
+  setIdentity(stor);
+
+  // Move the oldest data to the middle of the storage, then fill it in a shuffled order
+  for (uint64_t i = 0; i < 10; i++) {
+    stor.frame_id_ = 1;
+    stor.stamp_ = tf2::TimePoint(std::chrono::nanoseconds(i));
+    cache.insertData(stor);
+  }
+  stor.stamp_ = tf2::TimePoint(std::chrono::nanoseconds(110));
+  cache.insertData(stor);
+  ASSERT_EQ(cache.getListLength(), 1u);
+
+  for (uint64_t i = 0; i < 60; i++) {
+    uint64_t stamp = 111 + (i * 37) % 60;
+    stor.frame_id_ = tf2::CompactFrameID(stamp);
+    stor.stamp_ = tf2::TimePoint(std::chrono::nanoseconds(stamp));
+    EXPECT_TRUE(cache.insertData(stor));
+  }
+  ASSERT_EQ(cache.getListLength(), 61u);
+  EXPECT_EQ(cache.getOldestTimestamp(), tf2::TimePoint(std::chrono::nanoseconds(110)));
+  EXPECT_EQ(cache.getLatestTimestamp(), tf2::TimePoint(std::chrono::nanoseconds(170)));
+
+  for (uint64_t i = 111; i < 171; i++) {
+    ASSERT_TRUE(cache.getData(tf2::TimePoint(std::chrono::nanoseconds(i)), stor));
+    EXPECT_EQ(stor.frame_id_, i);
+    EXPECT_EQ(stor.stamp_, tf2::TimePoint(std::chrono::nanoseconds(i)));
+  }
+}
+
 int main(int argc, char ** argv)
 {
   testing::InitGoogleTest(&argc, argv);
@@ -33,6 +33,7 @@
 #include <vector>
 
 #include "tf2/buffer_core.h"
+#include "tf2/LinearMath/Quaternion.h"
 #include "tf2/LinearMath/Vector3.h"
 #include "tf2/exceptions.h"
 #include "tf2/time.h"
@@ -204,6 +205,131 @@ TEST(tf2_clear, LookUp_Static_Transfrom_Fail)
   );
 }
 
+namespace
+{
+
+geometry_msgs::msg::TransformStamped makeTransform(
+  const std::string & parent, const std::string & child, double time, double x, double yaw)
+{
+  tf2::Quaternion rotation;
+  rotation.setRPY(0.0, 0.0, yaw);
+  geometry_msgs::msg::TransformStamped transform;
+  transform.header.frame_id = parent;
+  transform.header.stamp.sec = static_cast<int32_t>(time);
+  transform.header.stamp.nanosec = static_cast<uint32_t>((time - static_cast<int32_t>(time)) * 1e9);
+  transform.child_frame_id = child;
+  transform.transform.translation.x = x;
+  transform.transform.translation.y = 2.0 * x;
+  transform.transform.rotation.x = rotation.x();
+  transform.transform.rotation.y = rotation.y();
+  transform.transform.rotation.z = rotation.z();
+  transform.transform.rotation.w = rotation.w();
+  return transform;
+}
+
+void expectTransformNear(
+  const geometry_msgs::msg::TransformStamped & expected,
+  const geometry_msgs::msg::TransformStamped & actual)
+{
+  EXPECT_EQ(expected.header.frame_id, actual.header.frame_id);
+  EXPECT_EQ(expected.child_frame_id, actual.child_frame_id);
+  EXPECT_EQ(expected.header.stamp.sec, actual.header.stamp.sec);
+  EXPECT_EQ(expected.header.stamp.nanosec, actual.header.stamp.nanosec);
+  EXPECT_NEAR(expected.transform.translation.x, actual.transform.translation.x, 1e-9);
+  EXPECT_NEAR(expected.transform.translation.y, actual.transform.translation.y, 1e-9);
+  EXPECT_NEAR(expected.transform.translation.z, actual.transform.translation.z, 1e-9);
+  EXPECT_NEAR(expected.transform.rotation.x, actual.transform.rotation.x, 1e-9);
+  EXPECT_NEAR(expected.transform.rotation.y, actual.transform.rotation.y, 1e-9);
+  EXPECT_NEAR(expected.transform.rotation.z, actual.transform.rotation.z, 1e-9);
+  EXPECT_NEAR(expected.transform.rotation.w, actual.transform.rotation.w, 1e-9);
+}
+
+// map -> odom -> base_link -> {arm, camera}, with a static laser on the base_link
+void setTree(tf2::BufferCore & buffer)
+{
+  for (double time : {1.0, 2.0}) {
+    buffer.setTransform(makeTransform("map", "odom", time, time, 0.1 * time), "authority");
+    buffer.setTransform(
+      makeTransform("odom", "base_link", time, 2 * time, 0.2 * time), "authority");
+    buffer.setTransform(makeTransform("base_link", "arm", time, -time, 0.3 * time), "authority");
+  }
+  buffer.setTransform(makeTransform("base_link", "camera", 1.5, 0.5, -0.4), "authority");
+  buffer.setTransform(makeTransform("base_link", "laser", 0.0, 0.7, 0.5), "authority", true);
+}
+
+}  // namespace
+
+TEST(tf2_lookupTransforms, Same_As_LookupTransform)
+{
+  tf2::BufferCore buffer;
+  setTree(buffer);
+
+  std::vector<tf2::TransformLookup> lookups;
+  const std::vector<std::string> frames = {"map", "odom", "base_link", "arm", "camera", "laser"};
+  for (const tf2::TimePoint & time : {tf2::TimePointZero, tf2::timeFromSec(1.5)}) {
+    for (const std::string & target_frame : frames) {
+      for (const std::string & source_frame : frames) {
+        lookups.push_back(tf2::TransformLookup{target_frame, source_frame, time});
+      }
+    }
+  }
+
+  // Twice, the second time along the cached paths
+  for (int i = 0; i < 2; ++i) {
+    std::vector<geometry_msgs::msg::TransformStamped> transforms = buffer.lookupTransforms(lookups);
+    ASSERT_EQ(transforms.size(), lookups.size());
+    for (size_t j = 0; j < lookups.size(); ++j) {
+      expectTransformNear(
+        buffer.lookupTransform(lookups[j].target_frame, lookups[j].source_frame, lookups[j].time),
+        transforms[j]);
+    }
+  }
+
+  std::vector<geometry_msgs::msg::TransformStamped> transforms = buffer.lookupTransforms(
+    "map", {"arm", "laser"}, tf2::timeFromSec(1.25));
+  ASSERT_EQ(transforms.size(), 2u);
+  expectTransformNear(
+    buffer.lookupTransform("map", "arm", tf2::timeFromSec(1.25)), transforms[0]);
+  expectTransformNear(
+    buffer.lookupTransform("map", "laser", tf2::timeFromSec(1.25)), transforms[1]);
+}
+
+TEST(tf2_lookupTransforms, Reparented_Frame)
+{
+  tf2::BufferCore buffer;
+  setTree(buffer);
+  EXPECT_EQ(buffer.lookupTransforms("map", {"arm"}, tf2::TimePointZero).size(), 1u);
+
+  // The arm moves from the base_link to the odom frame
+  buffer.setTransform(makeTransform("odom", "arm", 3.0, 3.0, 0.9), "authority");
+  buffer.setTransform(makeTransform("map", "odom", 3.0, 3.0, 0.3), "authority");
+
+  for (const tf2::TimePoint & time : {tf2::TimePointZero, tf2::timeFromSec(1.5)}) {
+    std::vector<geometry_msgs::msg::TransformStamped> transforms = buffer.lookupTransforms(
+      "map", {"arm"}, time);
+    ASSERT_EQ(transforms.size(), 1u);
+    expectTransformNear(buffer.lookupTransform("map", "arm", time), transforms[0]);
+  }
+}
+
+TEST(tf2_lookupTransforms, Exceptions)
+{
+  tf2::BufferCore buffer;
+  setTree(buffer);
+
+  EXPECT_THROW(
+    buffer.lookupTransforms("map", {"arm", "unknown"}, tf2::TimePointZero), tf2::LookupException);
+  EXPECT_THROW(
+    buffer.lookupTransforms("map", {"arm", "/camera"}, tf2::TimePointZero),
+    tf2::InvalidArgumentException);
+  EXPECT_THROW(
+    buffer.lookupTransforms("map", {"arm"}, tf2::timeFromSec(3.0)), tf2::ExtrapolationException);
+
+  buffer.setTransform(makeTransform("world", "robot", 1.0, 1.0, 0.0), "authority");
+  EXPECT_THROW(
+    buffer.lookupTransforms("map", {"robot"}, tf2::TimePointZero), tf2::ConnectivityException);
+}
+
 TEST(tf2_time, Display_Time_Point)
 {
   tf2::TimePoint t = tf2::get_now();
@@ -48,6 +48,7 @@
 #include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace tf2_ros
 {
@@ -62,6 +63,7 @@ class Buffer : public BufferInterface, public AsyncBufferInterface, public tf2::
 {
 public:
   using tf2::BufferCore::lookupTransform;
+  using tf2::BufferCore::lookupTransforms;
   using tf2::BufferCore::canTransform;
 
   /** \brief  Constructor for a Buffer object
@@ -142,6 +144,21 @@ public:
       fixed_frame, fromRclcpp(timeout));
   }
 
+  /** \brief Get the transforms of a batch of lookups.
+   * \param lookups The target frame, source frame and time of each transform
+   * \param timeout How long to block in total before failing
+   * \return The transforms, in the order of the lookups
+   *
+   * Waits until all transforms are available, then looks them up together.
+   *
+   * Possible exceptions tf2::LookupException, tf2::ConnectivityException,
+   * tf2::ExtrapolationException, tf2::InvalidArgumentException
+   */
+  TF2_ROS_PUBLIC
+  std::vector<geometry_msgs::msg::TransformStamped>
+  lookupTransforms(
+    const std::vector<tf2::TransformLookup> & lookups, const tf2::Duration timeout) const;
+
   /** \brief Test if a transform is possible
    * \param target_frame The frame into which to transform
    * \param source_frame The frame from which to transform
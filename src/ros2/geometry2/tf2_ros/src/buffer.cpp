@@ -32,6 +32,7 @@
 
 #include "tf2_ros/buffer.h"
 
+#include <algorithm>
 #include <exception>
 #include <limits>
 #include <memory>
@@ -95,6 +96,24 @@ Buffer::lookupTransform(
   return lookupTransform(target_frame, source_frame, lookup_time);
 }
 
+std::vector<geometry_msgs::msg::TransformStamped>
+Buffer::lookupTransforms(
+  const std::vector<tf2::TransformLookup> & lookups, const tf2::Duration timeout) const
+{
+  // The timeout is shared by all lookups
+  rclcpp::Time start_time = clock_->now();
+  for (const tf2::TransformLookup & lookup : lookups) {
+    tf2::Duration remaining = timeout - from_rclcpp(clock_->now() - start_time);
+    if (!canTransform(
+        lookup.target_frame, lookup.source_frame, lookup.time,
+        std::max(remaining, tf2::Duration::zero())))
+    {
+      break;
+    }
+  }
+  return lookupTransforms(lookups);
+}
+
 void Buffer::onTimeJump(const rcl_time_jump_t & jump)
 {
   if (RCL_ROS_TIME_ACTIVATED == jump.clock_change ||
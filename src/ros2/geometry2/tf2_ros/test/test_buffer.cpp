@@ -137,6 +137,42 @@ TEST(test_buffer, can_transform_valid_transform)
   EXPECT_DOUBLE_EQ(transform.transform.translation.z, output_rclcpp.transform.translation.z);
 }
 
+TEST(test_buffer, lookup_transforms_with_timeout)
+{
+  rclcpp::Clock::SharedPtr clock = std::make_shared<rclcpp::Clock>(RCL_SYSTEM_TIME);
+  tf2_ros::Buffer buffer(clock);
+  // Silence error about dedicated thread's being necessary
+  buffer.setUsingDedicatedThread(true);
+
+  rclcpp::Time rclcpp_time = clock->now();
+  tf2::TimePoint tf2_time(std::chrono::nanoseconds(rclcpp_time.nanoseconds()));
+
+  geometry_msgs::msg::TransformStamped transform;
+  transform.header.frame_id = "foo";
+  transform.header.stamp = builtin_interfaces::msg::Time(rclcpp_time);
+  transform.child_frame_id = "bar";
+  transform.transform.translation.x = 42.0;
+  transform.transform.rotation.w = 1.0;
+  EXPECT_TRUE(buffer.setTransform(transform, "unittest"));
+  transform.child_frame_id = "baz";
+  transform.transform.translation.x = -3.14;
+  EXPECT_TRUE(buffer.setTransform(transform, "unittest"));
+
+  auto outputs = buffer.lookupTransforms(
+    {{"foo", "bar", tf2_time}, {"bar", "baz", tf2_time}}, tf2::durationFromSec(0.1));
+  ASSERT_EQ(2u, outputs.size());
+  EXPECT_STREQ("bar", outputs[0].child_frame_id.c_str());
+  EXPECT_DOUBLE_EQ(42.0, outputs[0].transform.translation.x);
+  EXPECT_STREQ("baz", outputs[1].child_frame_id.c_str());
+  EXPECT_DOUBLE_EQ(-3.14 - 42.0, outputs[1].transform.translation.x);
+
+  // The transforms will not become available, so the lookup fails after the timeout
+  EXPECT_THROW(
+    buffer.lookupTransforms(
+      {{"foo", "bar", tf2_time}, {"foo", "unknown", tf2_time}}, tf2::durationFromSec(0.1)),
+    tf2::LookupException);
+}
+
 TEST(test_buffer, wait_for_transform_valid)
 {
   rclcpp::Clock::SharedPtr clock = std::make_shared<rclcpp::Clock>(RCL_SYSTEM_TIME);
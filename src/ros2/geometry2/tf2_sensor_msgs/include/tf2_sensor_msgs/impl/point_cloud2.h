@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2021, Open Source Robotics Foundation, Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Willow Garage, Inc. nor the names of its
+ *       contributors may be used to endorse or promote products derived from
+ *       this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TF2_SENSOR_MSGS__IMPL__POINT_CLOUD2_H_
+#define TF2_SENSOR_MSGS__IMPL__POINT_CLOUD2_H_
+
+#include <sensor_msgs/msg/point_cloud2.hpp>
+#include <sensor_msgs/msg/point_field.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
+namespace tf2
+{
+namespace impl
+{
+
+/// Offset of a single float field of the points in host byte order, or -1 if there is none.
+inline int floatFieldOffset(const sensor_msgs::msg::PointCloud2 & cloud, const std::string & name)
+{
+  const uint16_t one = 1;
+  uint8_t first_byte;
+  std::memcpy(&first_byte, &one, 1);
+  if (cloud.is_bigendian == (first_byte == 1)) {
+    return -1;
+  }
+  for (const auto & field : cloud.fields) {
+    if (field.name == name) {
+      if (field.datatype != sensor_msgs::msg::PointField::FLOAT32 || field.count != 1 ||
+        field.offset + sizeof(float) > cloud.point_step)
+      {
+        return -1;
+      }
+      return static_cast<int>(field.offset);
+    }
+  }
+  return -1;
+}
+
+/// Transforms vectors of three floats, stored at the offsets of points `point_step` bytes apart.
+/**
+ * \param matrix The affine transform, as a row major 3x4 matrix
+ * \param translate Whether to translate the vectors, which is left out for directions
+ * \param in The first point read
+ * \param out The first point written, which may be the same as `in`
+ * \param count The number of points
+ * \param point_step The number of bytes between two points
+ * \param offsets The offsets of the x, y and z floats in a point
+ */
+inline void transformVectors(
+  const float (& matrix)[12], bool translate, const uint8_t * in, uint8_t * out,
+  size_t count, size_t point_step, const int (& offsets)[3])
+{
+  const float tx = translate ? matrix[3] : 0.0f;
+  const float ty = translate ? matrix[7] : 0.0f;
+  const float tz = translate ? matrix[11] : 0.0f;
+  size_t i = 0;
+
+  // The vector instructions need the three floats next to each other
+  if (offsets[1] == offsets[0] + 4 && offsets[2] == offsets[0] + 8) {
+    in += offsets[0];
+    out += offsets[0];
+#if defined(__AVX2__)
+    // Two points per iteration, one in each half of the registers
+    const __m256 column_x = _mm256_setr_ps(
+      matrix[0], matrix[4], matrix[8], 0.0f, matrix[0], matrix[4], matrix[8], 0.0f);
+    const __m256 column_y = _mm256_setr_ps(
+      matrix[1], matrix[5], matrix[9], 0.0f, matrix[1], matrix[5], matrix[9], 0.0f);
+    const __m256 column_z = _mm256_setr_ps(
+      matrix[2], matrix[6], matrix[10], 0.0f, matrix[2], matrix[6], matrix[10], 0.0f);
+    const __m256 translation = _mm256_setr_ps(tx, ty, tz, 0.0f, tx, ty, tz, 0.0f);
+    // Only the three floats of a vector are loaded and stored, the fourth belongs to another field
+    const __m128i mask = _mm_setr_epi32(-1, -1, -1, 0);
+    for (; i + 2 <= count; i += 2) {
+      const float * first = reinterpret_cast<const float *>(in + i * point_step);
+      const float * second = reinterpret_cast<const float *>(in + (i + 1) * point_step);
+      const __m256 vectors = _mm256_insertf128_ps(
+        _mm256_castps128_ps256(_mm_maskload_ps(first, mask)), _mm_maskload_ps(second, mask), 1);
+#if defined(__FMA__)
+      __m256 result = _mm256_fmadd_ps(
+        column_x, _mm256_permute_ps(vectors, 0x00), translation);
+      result = _mm256_fmadd_ps(column_y, _mm256_permute_ps(vectors, 0x55), result);
+      result = _mm256_fmadd_ps(column_z, _mm256_permute_ps(vectors, 0xAA), result);
+#else
+      __m256 result = _mm256_add_ps(
+        _mm256_mul_ps(column_x, _mm256_permute_ps(vectors, 0x00)), translation);
+      result = _mm256_add_ps(_mm256_mul_ps(column_y, _mm256_permute_ps(vectors, 0x55)), result);
+      result = _mm256_add_ps(_mm256_mul_ps(column_z, _mm256_permute_ps(vectors, 0xAA)), result);
+#endif
+      _mm_maskstore_ps(
+        reinterpret_cast<float *>(out + i * point_step), mask, _mm256_castps256_ps128(result));
+      _mm_maskstore_ps(
+        reinterpret_cast<float *>(out + (i + 1) * point_step), mask,
+        _mm256_extractf128_ps(result, 1));
+    }
+#elif defined(__SSE2__) || defined(_M_X64)
+    const __m128 column_x = _mm_setr_ps(matrix[0], matrix[4], matrix[8], 0.0f);
+    const __m128 column_y = _mm_setr_ps(matrix[1], matrix[5], matrix[9], 0.0f);
+    const __m128 column_z = _mm_setr_ps(matrix[2], matrix[6], matrix[10], 0.0f);
+    const __m128 translation = _mm_setr_ps(tx, ty, tz, 0.0f);
+    for (; i < count; ++i) {
+      const float * vector = reinterpret_cast<const float *>(in + i * point_step);
+      __m128 result = _mm_add_ps(_mm_mul_ps(column_x, _mm_load1_ps(vector)), translation);
+      result = _mm_add_ps(_mm_mul_ps(column_y, _mm_load1_ps(vector + 1)), result);
+      result = _mm_add_ps(_mm_mul_ps(column_z, _mm_load1_ps(vector + 2)), result);
+      // Only the three floats of the vector are stored, the fourth belongs to another field
+      float * output = reinterpret_cast<float *>(out + i * point_step);
+      _mm_storel_pi(reinterpret_cast<__m64 *>(output), result);
+      _mm_store_ss(output + 2, _mm_movehl_ps(result, result));
+    }
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    const float32x4_t column_x = {matrix[0], matrix[4], matrix[8], 0.0f};
+    const float32x4_t column_y = {matrix[1], matrix[5], matrix[9], 0.0f};
+    const float32x4_t column_z = {matrix[2], matrix[6], matrix[10], 0.0f};
+    const float32x4_t translation = {tx, ty, tz, 0.0f};
+    for (; i < count; ++i) {
+      const float * vector = reinterpret_cast<const float *>(in + i * point_step);
+      float32x4_t result = vmlaq_n_f32(translation, column_x, vector[0]);
+      result = vmlaq_n_f32(result, column_y, vector[1]);
+      result = vmlaq_n_f32(result, column_z, vector[2]);
+      // Only the three floats of the vector are stored, the fourth belongs to another field
+      float * output = reinterpret_cast<float *>(out + i * point_step);
+      vst1_f32(output, vget_low_f32(result));
+      vst1q_lane_f32(output + 2, result, 2);
+    }
+#endif
+    in -= offsets[0];
+    out -= offsets[0];
+  }
+
+  for (; i < count; ++i) {
+    const uint8_t * point_in = in + i * point_step;
+    uint8_t * point_out = out + i * point_step;
+    float x, y, z;
+    std::memcpy(&x, point_in + offsets[0], sizeof(float));
+    std::memcpy(&y, point_in + offsets[1], sizeof(float));
+    std::memcpy(&z, point_in + offsets[2], sizeof(float));
+    const float result[3] = {
+      matrix[0] * x + matrix[1] * y + matrix[2] * z + tx,
+      matrix[4] * x + matrix[5] * y + matrix[6] * z + ty,
+      matrix[8] * x + matrix[9] * y + matrix[10] * z + tz};
+    std::memcpy(point_out + offsets[0], &result[0], sizeof(float));
+    std::memcpy(point_out + offsets[1], &result[1], sizeof(float));
+    std::memcpy(point_out + offsets[2], &result[2], sizeof(float));
+  }
+}
+
+/// Transforms the points, and the normals if there are any, of a cloud.
+/**
+ * The transformed points of `in` are written to `out`, which must have the layout of `in` and
+ * may be the same message. The padding at the end of the rows is skipped.
+ * \param matrix The affine transform, as a row major 3x4 matrix
+ * \return false without changing `out` if the points are not single floats in host byte order
+ */
+inline bool transformPointCloud2(
+  const float (& matrix)[12], const sensor_msgs::msg::PointCloud2 & in,
+  sensor_msgs::msg::PointCloud2 & out)
+{
+  const int points[3] = {
+    floatFieldOffset(in, "x"), floatFieldOffset(in, "y"), floatFieldOffset(in, "z")};
+  if (points[0] < 0 || points[1] < 0 || points[2] < 0) {
+    return false;
+  }
+  const int normals[3] = {
+    floatFieldOffset(in, "normal_x"), floatFieldOffset(in, "normal_y"),
+    floatFieldOffset(in, "normal_z")};
+  const bool has_normals = normals[0] >= 0 && normals[1] >= 0 && normals[2] >= 0;
+
+  const size_t row_size = static_cast<size_t>(in.width) * in.point_step;
+  if (in.height == 0 || in.width == 0) {
+    return true;
+  }
+  if (row_size > in.row_step ||
+    (in.height - 1) * static_cast<size_t>(in.row_step) + row_size > in.data.size() ||
+    out.data.size() != in.data.size())
+  {
+    return false;
+  }
+  for (size_t row = 0; row < in.height; ++row) {
+    const uint8_t * row_in = in.data.data() + row * in.row_step;
+    uint8_t * row_out = out.data.data() + row * in.row_step;
+    transformVectors(matrix, true, row_in, row_out, in.width, in.point_step, points);
+    if (has_normals) {
+      transformVectors(matrix, false, row_in, row_out, in.width, in.point_step, normals);
+    }
+  }
+  return true;
+}
+
+}  // namespace impl
+}  // namespace tf2
+
+#endif  // TF2_SENSOR_MSGS__IMPL__POINT_CLOUD2_H_
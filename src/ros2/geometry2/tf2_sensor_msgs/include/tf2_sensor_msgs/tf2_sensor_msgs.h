@@ -37,6 +37,7 @@
 #include <Eigen/Eigen>
 #include <Eigen/Geometry>
 #include <tf2_ros/buffer_interface.h>
+#include <tf2_sensor_msgs/impl/point_cloud2.h>
 
 namespace tf2
 {
@@ -56,28 +57,44 @@ inline
 std::string getFrameId(const sensor_msgs::msg::PointCloud2 &p) {return p.header.frame_id;}
 
 // this method needs to be implemented by client library developers
+/**
+ * Transforms the x, y and z fields of the points, and rotates the normal_x, normal_y and normal_z
+ * fields if there are any. p_in and p_out may be the same message, and the data buffer of p_out
+ * is reused if it is large enough.
+ */
 template <>
 inline
 void doTransform(const sensor_msgs::msg::PointCloud2 &p_in, sensor_msgs::msg::PointCloud2 &p_out, const geometry_msgs::msg::TransformStamped& t_in)
 {
-  p_out = p_in;
-  p_out.header = t_in.header;
   Eigen::Transform<float,3,Eigen::Affine> t = Eigen::Translation3f(t_in.transform.translation.x, t_in.transform.translation.y,
                                                                    t_in.transform.translation.z) * Eigen::Quaternion<float>(
                                                                      t_in.transform.rotation.w, t_in.transform.rotation.x,
                                                                      t_in.transform.rotation.y, t_in.transform.rotation.z);
 
-  sensor_msgs::PointCloud2ConstIterator<float> x_in(p_in, std::string("x"));
-  sensor_msgs::PointCloud2ConstIterator<float> y_in(p_in, std::string("y"));
-  sensor_msgs::PointCloud2ConstIterator<float> z_in(p_in, std::string("z"));
+  // The other fields of the points are copied along, the points are overwritten below
+  if (&p_in != &p_out) {
+    p_out = p_in;
+  }
+  p_out.header = t_in.header;
+
+  float matrix[12];
+  for (int row = 0; row < 3; ++row) {
+    for (int column = 0; column < 4; ++column) {
+      matrix[row * 4 + column] = t.matrix()(row, column);
+    }
+  }
+  if (impl::transformPointCloud2(matrix, p_in, p_out)) {
+    return;
+  }
 
+  // Points which are not single floats in host byte order are read as floats one by one
   sensor_msgs::PointCloud2Iterator<float> x_out(p_out, std::string("x"));
   sensor_msgs::PointCloud2Iterator<float> y_out(p_out, std::string("y"));
   sensor_msgs::PointCloud2Iterator<float> z_out(p_out, std::string("z"));
 
   Eigen::Vector3f point;
-  for(; x_in != x_in.end(); ++x_in, ++y_in, ++z_in, ++x_out, ++y_out, ++z_out) {
-    point = t * Eigen::Vector3f(*x_in, *y_in, *z_in);
+  for(; x_out != x_out.end(); ++x_out, ++y_out, ++z_out) {
+    point = t * Eigen::Vector3f(*x_out, *y_out, *z_out);
     *x_out = point.x();
     *y_out = point.y();
     *z_out = point.z();
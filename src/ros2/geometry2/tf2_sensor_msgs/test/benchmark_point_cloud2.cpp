@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2021, Open Source Robotics Foundation, Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Willow Garage, Inc. nor the names of its
+ *       contributors may be used to endorse or promote products derived from
+ *       this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <benchmark/benchmark.h>
+#include <tf2_sensor_msgs/tf2_sensor_msgs.h>
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+
+namespace
+{
+
+// A lidar frame of 128 beams with 2048 points each
+constexpr uint32_t kBeams = 128;
+constexpr uint32_t kPointsPerBeam = 2048;
+
+geometry_msgs::msg::TransformStamped makeTransform()
+{
+  geometry_msgs::msg::TransformStamped t;
+  t.header.frame_id = "base_link";
+  t.transform.translation.x = 1.0;
+  t.transform.translation.y = 0.5;
+  t.transform.translation.z = 1.8;
+  t.transform.rotation.z = std::sqrt(0.5);
+  t.transform.rotation.w = std::sqrt(0.5);
+  return t;
+}
+
+// Points with an intensity, or with a normal and a curvature
+sensor_msgs::msg::PointCloud2 makeCloud(bool with_normals)
+{
+  sensor_msgs::msg::PointCloud2 cloud;
+  cloud.header.frame_id = "lidar";
+  sensor_msgs::PointCloud2Modifier modifier(cloud);
+  if (with_normals) {
+    modifier.setPointCloud2Fields(
+      8,
+      "x", 1, sensor_msgs::msg::PointField::FLOAT32,
+      "y", 1, sensor_msgs::msg::PointField::FLOAT32,
+      "z", 1, sensor_msgs::msg::PointField::FLOAT32,
+      "intensity", 1, sensor_msgs::msg::PointField::FLOAT32,
+      "normal_x", 1, sensor_msgs::msg::PointField::FLOAT32,
+      "normal_y", 1, sensor_msgs::msg::PointField::FLOAT32,
+      "normal_z", 1, sensor_msgs::msg::PointField::FLOAT32,
+      "curvature", 1, sensor_msgs::msg::PointField::FLOAT32);
+  } else {
+    modifier.setPointCloud2Fields(
+      4,
+      "x", 1, sensor_msgs::msg::PointField::FLOAT32,
+      "y", 1, sensor_msgs::msg::PointField::FLOAT32,
+      "z", 1, sensor_msgs::msg::PointField::FLOAT32,
+      "intensity", 1, sensor_msgs::msg::PointField::FLOAT32);
+  }
+  modifier.resize(kBeams * kPointsPerBeam);
+  cloud.height = kBeams;
+  cloud.width = kPointsPerBeam;
+  cloud.row_step = kPointsPerBeam * cloud.point_step;
+
+  sensor_msgs::PointCloud2Iterator<float> x(cloud, "x");
+  sensor_msgs::PointCloud2Iterator<float> y(cloud, "y");
+  sensor_msgs::PointCloud2Iterator<float> z(cloud, "z");
+  for (uint32_t i = 0; x != x.end(); ++x, ++y, ++z, ++i) {
+    *x = static_cast<float>(i % kPointsPerBeam) * 0.01f;
+    *y = static_cast<float>(i / kPointsPerBeam) * 0.02f;
+    *z = 1.0f;
+  }
+  return cloud;
+}
+
+// The transform of the points with iterators, as doTransform did before
+void iteratorTransform(
+  const sensor_msgs::msg::PointCloud2 & p_in, sensor_msgs::msg::PointCloud2 & p_out,
+  const geometry_msgs::msg::TransformStamped & t_in)
+{
+  p_out = p_in;
+  p_out.header = t_in.header;
+  Eigen::Transform<float, 3, Eigen::Affine> t = Eigen::Translation3f(
+    t_in.transform.translation.x, t_in.transform.translation.y, t_in.transform.translation.z) *
+    Eigen::Quaternion<float>(
+    t_in.transform.rotation.w, t_in.transform.rotation.x, t_in.transform.rotation.y,
+    t_in.transform.rotation.z);
+
+  sensor_msgs::PointCloud2ConstIterator<float> x_in(p_in, std::string("x"));
+  sensor_msgs::PointCloud2ConstIterator<float> y_in(p_in, std::string("y"));
+  sensor_msgs::PointCloud2ConstIterator<float> z_in(p_in, std::string("z"));
+
+  sensor_msgs::PointCloud2Iterator<float> x_out(p_out, std::string("x"));
+  sensor_msgs::PointCloud2Iterator<float> y_out(p_out, std::string("y"));
+  sensor_msgs::PointCloud2Iterator<float> z_out(p_out, std::string("z"));
+
+  Eigen::Vector3f point;
+  for (; x_in != x_in.end(); ++x_in, ++y_in, ++z_in, ++x_out, ++y_out, ++z_out) {
+    point = t * Eigen::Vector3f(*x_in, *y_in, *z_in);
+    *x_out = point.x();
+    *y_out = point.y();
+    *z_out = point.z();
+  }
+}
+
+}  // namespace
+
+// The argument is whether the points have normals
+static void BM_iterator_transform(benchmark::State & state)
+{
+  const sensor_msgs::msg::PointCloud2 cloud = makeCloud(state.range(0) != 0);
+  const geometry_msgs::msg::TransformStamped t = makeTransform();
+  sensor_msgs::msg::PointCloud2 cloud_out;
+
+  for (auto _ : state) {
+    iteratorTransform(cloud, cloud_out, t);
+    benchmark::DoNotOptimize(cloud_out.data.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kBeams * kPointsPerBeam);
+}
+BENCHMARK(BM_iterator_transform)->Arg(0)->Arg(1);
+
+static void BM_do_transform(benchmark::State & state)
+{
+  const sensor_msgs::msg::PointCloud2 cloud = makeCloud(state.range(0) != 0);
+  const geometry_msgs::msg::TransformStamped t = makeTransform();
+  sensor_msgs::msg::PointCloud2 cloud_out;
+
+  for (auto _ : state) {
+    tf2::doTransform(cloud, cloud_out, t);
+    benchmark::DoNotOptimize(cloud_out.data.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kBeams * kPointsPerBeam);
+}
+BENCHMARK(BM_do_transform)->Arg(0)->Arg(1);
+
+static void BM_do_transform_in_place(benchmark::State & state)
+{
+  sensor_msgs::msg::PointCloud2 cloud = makeCloud(state.range(0) != 0);
+  const geometry_msgs::msg::TransformStamped t = makeTransform();
+
+  for (auto _ : state) {
+    tf2::doTransform(cloud, cloud, t);
+    benchmark::DoNotOptimize(cloud.data.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kBeams * kPointsPerBeam);
+}
+BENCHMARK(BM_do_transform_in_place)->Arg(0)->Arg(1);
@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2021, Open Source Robotics Foundation, Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Willow Garage, Inc. nor the names of its
+ *       contributors may be used to endorse or promote products derived from
+ *       this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <tf2_sensor_msgs/tf2_sensor_msgs.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+geometry_msgs::msg::TransformStamped makeTransform()
+{
+  geometry_msgs::msg::TransformStamped t;
+  t.header.frame_id = "B";
+  t.header.stamp.sec = 2;
+  t.transform.translation.x = 10;
+  t.transform.translation.y = -20;
+  t.transform.translation.z = 30;
+  // 60 degrees about (1, 2, 3)
+  const double norm = std::sqrt(14.0);
+  t.transform.rotation.x = 0.5 * 1 / norm;
+  t.transform.rotation.y = 0.5 * 2 / norm;
+  t.transform.rotation.z = 0.5 * 3 / norm;
+  t.transform.rotation.w = std::sqrt(0.75);
+  return t;
+}
+
+sensor_msgs::msg::PointField makeField(const std::string & name, uint32_t offset)
+{
+  sensor_msgs::msg::PointField field;
+  field.name = name;
+  field.offset = offset;
+  field.datatype = sensor_msgs::msg::PointField::FLOAT32;
+  field.count = 1;
+  return field;
+}
+
+// A cloud with the given float fields and random values, with point_step and row_step bytes
+// between points and rows
+sensor_msgs::msg::PointCloud2 makeCloud(
+  const std::vector<sensor_msgs::msg::PointField> & fields, uint32_t point_step,
+  uint32_t width, uint32_t height, uint32_t row_step)
+{
+  sensor_msgs::msg::PointCloud2 cloud;
+  cloud.header.frame_id = "A";
+  cloud.fields = fields;
+  cloud.point_step = point_step;
+  cloud.width = width;
+  cloud.height = height;
+  cloud.row_step = row_step;
+  cloud.data.resize(static_cast<size_t>(row_step) * height);
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<float> distribution(-100.0f, 100.0f);
+  for (size_t i = 0; i + sizeof(float) <= cloud.data.size(); i += sizeof(float)) {
+    const float value = distribution(generator);
+    std::memcpy(&cloud.data[i], &value, sizeof(float));
+  }
+  return cloud;
+}
+
+float readFloat(const sensor_msgs::msg::PointCloud2 & cloud, size_t offset)
+{
+  float value;
+  std::memcpy(&value, &cloud.data[offset], sizeof(float));
+  return value;
+}
+
+// Compares the transformed cloud with the transform of every point and normal computed by Eigen
+void expectTransformed(
+  const sensor_msgs::msg::PointCloud2 & in, const sensor_msgs::msg::PointCloud2 & out,
+  const geometry_msgs::msg::TransformStamped & t_in, const uint32_t (& point)[3],
+  const std::vector<uint32_t> & normal = {})
+{
+  const Eigen::Affine3f t = Eigen::Translation3f(
+    t_in.transform.translation.x, t_in.transform.translation.y, t_in.transform.translation.z) *
+    Eigen::Quaternionf(
+    t_in.transform.rotation.w, t_in.transform.rotation.x, t_in.transform.rotation.y,
+    t_in.transform.rotation.z);
+
+  EXPECT_EQ(t_in.header.frame_id, out.header.frame_id);
+  ASSERT_EQ(in.data.size(), out.data.size());
+  std::vector<bool> transformed(in.data.size(), false);
+  for (size_t row = 0; row < in.height; ++row) {
+    for (size_t column = 0; column < in.width; ++column) {
+      const size_t offset = row * in.row_step + column * in.point_step;
+      const Eigen::Vector3f expected_point = t * Eigen::Vector3f(
+        readFloat(in, offset + point[0]), readFloat(in, offset + point[1]),
+        readFloat(in, offset + point[2]));
+      for (int i = 0; i < 3; ++i) {
+        EXPECT_NEAR(expected_point[i], readFloat(out, offset + point[i]), 1e-3);
+        std::fill_n(transformed.begin() + offset + point[i], sizeof(float), true);
+      }
+      if (!normal.empty()) {
+        const Eigen::Vector3f expected_normal = t.linear() * Eigen::Vector3f(
+          readFloat(in, offset + normal[0]), readFloat(in, offset + normal[1]),
+          readFloat(in, offset + normal[2]));
+        for (int i = 0; i < 3; ++i) {
+          EXPECT_NEAR(expected_normal[i], readFloat(out, offset + normal[i]), 1e-3);
+          std::fill_n(transformed.begin() + offset + normal[i], sizeof(float), true);
+        }
+      }
+    }
+  }
+  // The other fields and the padding are copied as they are
+  for (size_t i = 0; i < in.data.size(); ++i) {
+    if (!transformed[i]) {
+      EXPECT_EQ(in.data[i], out.data[i]);
+    }
+  }
+}
+
+}  // namespace
+
+TEST(Tf2Sensor, PointCloud2Dense)
+{
+  // Only the points, without any bytes in between, and an odd number of them
+  const sensor_msgs::msg::PointCloud2 cloud = makeCloud(
+    {makeField("x", 0), makeField("y", 4), makeField("z", 8)}, 12, 101, 1, 12 * 101);
+  sensor_msgs::msg::PointCloud2 cloud_out;
+  tf2::doTransform(cloud, cloud_out, makeTransform());
+  expectTransformed(cloud, cloud_out, makeTransform(), {0, 4, 8});
+}
+
+TEST(Tf2Sensor, PointCloud2WithOtherFields)
+{
+  const sensor_msgs::msg::PointCloud2 cloud = makeCloud(
+    {makeField("x", 0), makeField("y", 4), makeField("z", 8), makeField("intensity", 12)},
+    16, 33, 3, 16 * 33);
+  sensor_msgs::msg::PointCloud2 cloud_out;
+  tf2::doTransform(cloud, cloud_out, makeTransform());
+  expectTransformed(cloud, cloud_out, makeTransform(), {0, 4, 8});
+}
+
+TEST(Tf2Sensor, PointCloud2Normals)
+{
+  const sensor_msgs::msg::PointCloud2 cloud = makeCloud(
+    {makeField("x", 0), makeField("y", 4), makeField("z", 8),
+      makeField("normal_x", 16), makeField("normal_y", 20), makeField("normal_z", 24),
+      makeField("curvature", 28)},
+    32, 17, 2, 32 * 17);
+  sensor_msgs::msg::PointCloud2 cloud_out;
+  tf2::doTransform(cloud, cloud_out, makeTransform());
+  expectTransformed(cloud, cloud_out, makeTransform(), {0, 4, 8}, {16, 20, 24});
+}
+
+TEST(Tf2Sensor, PointCloud2Strided)
+{
+  // The fields of the points are not next to each other and the rows are padded
+  const sensor_msgs::msg::PointCloud2 cloud = makeCloud(
+    {makeField("x", 4), makeField("intensity", 8), makeField("y", 12), makeField("z", 20)},
+    28, 9, 4, 28 * 9 + 12);
+  sensor_msgs::msg::PointCloud2 cloud_out;
+  tf2::doTransform(cloud, cloud_out, makeTransform());
+  expectTransformed(cloud, cloud_out, makeTransform(), {4, 12, 20});
+}
+
+TEST(Tf2Sensor, PointCloud2InPlace)
+{
+  const sensor_msgs::msg::PointCloud2 cloud = makeCloud(
+    {makeField("x", 0), makeField("y", 4), makeField("z", 8),
+      makeField("normal_x", 16), makeField("normal_y", 20), makeField("normal_z", 24)},
+    32, 64, 1, 32 * 64);
+  sensor_msgs::msg::PointCloud2 cloud_in_place = cloud;
+  tf2::doTransform(cloud_in_place, cloud_in_place, makeTransform());
+  expectTransformed(cloud, cloud_in_place, makeTransform(), {0, 4, 8}, {16, 20, 24});
+
+  // A preallocated output keeps its buffer
+  sensor_msgs::msg::PointCloud2 cloud_out;
+  cloud_out.data.resize(cloud.data.size());
+  const uint8_t * buffer = cloud_out.data.data();
+  tf2::doTransform(cloud, cloud_out, makeTransform());
+  EXPECT_EQ(buffer, cloud_out.data.data());
+  expectTransformed(cloud, cloud_out, makeTransform(), {0, 4, 8}, {16, 20, 24});
+}
+
+TEST(Tf2Sensor, PointCloud2MissingField)
+{
+  const sensor_msgs::msg::PointCloud2 cloud = makeCloud(
+    {makeField("x", 0), makeField("y", 4)}, 8, 4, 1, 8 * 4);
+  sensor_msgs::msg::PointCloud2 cloud_out;
+  EXPECT_THROW(tf2::doTransform(cloud, cloud_out, makeTransform()), std::runtime_error);
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,639 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2021, Open Source Robotics Foundation, Inc.
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Willow Garage nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#ifndef MESSAGE_FILTERS__APPROXIMATE_TIME_SYNCHRONIZER_H_
+#define MESSAGE_FILTERS__APPROXIMATE_TIME_SYNCHRONIZER_H_
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <inttypes.h>
+
+#include <rclcpp/rclcpp.hpp>
+#include <rcutils/logging_macros.h>
+
+#include "message_filters/connection.h"
+#include "message_filters/message_event.h"
+#include "message_filters/message_traits.h"
+
+#ifndef RCUTILS_ASSERT
+// TODO(tfoote) remove this after it's implemented upstream
+// https://github.com/ros2/rcutils/pull/112
+#define RCUTILS_ASSERT assert
+#endif
+
+namespace message_filters
+{
+
+/**
+ * \brief Synchronizes any number of inputs by approximately matching the timestamps of their messages.
+ *
+ * ApproximateTimeSynchronizer implements the algorithm of sync_policies::ApproximateTime and outputs the
+ * same sets of messages, but is not limited to 9 inputs and needs less work per message:
+ * - The messages of each input are kept in a ring buffer of queue_size + 1 events allocated up front,
+ *   together with their timestamps in nanoseconds, so that no memory is allocated while synchronizing.
+ * - The messages which are set aside while searching for a better candidate stay in the ring buffer, so that
+ *   moving them out of the way and back is a counter update.
+ * - The candidate set is the first message of every input, so that it is never copied.
+ *
+ * Sets are published to the callbacks registered with registerCallback(), which take a shared pointer to each
+ * message, and registerEventCallback(), which take the message events.
+ *
+ * \section usage USAGE
+\verbatim
+ApproximateTimeSynchronizer<sensor_msgs::msg::Image, sensor_msgs::msg::Image, sensor_msgs::msg::Image> sync(
+  10, image0_sub, image1_sub, image2_sub);
+sync.registerCallback(callback);
+\endverbatim
+ */
+template<typename... Ms>
+class ApproximateTimeSynchronizer : public noncopyable
+{
+public:
+  static_assert(sizeof...(Ms) >= 2, "ApproximateTimeSynchronizer needs at least two inputs");
+
+  typedef std::tuple<Ms...> Messages;
+  typedef std::tuple<MessageEvent<Ms const>...> Events;
+  typedef std::function<void(const std::shared_ptr<Ms const>&...)> Callback;
+  typedef std::function<void(const MessageEvent<Ms const>&...)> EventCallback;
+
+  static const uint32_t INPUT_COUNT = sizeof...(Ms);
+
+  explicit ApproximateTimeSynchronizer(uint32_t queue_size)
+  : queue_size_(queue_size)
+  , capacity_(queue_size + 1)
+  , num_non_empty_deques_(0)
+  , pivot_(NO_PIVOT)
+  , pivot_time_(0)
+  , candidate_start_(0)
+  , candidate_end_(0)
+  , max_interval_duration_(std::numeric_limits<int64_t>::max())
+  , age_penalty_(0.1)
+  , next_callback_id_(0)
+  {
+    RCUTILS_ASSERT(queue_size_ > 0);  // The synchronizer will tend to drop many messages with a queue size of 1. At least 2 is recommended.
+    allocate(std::make_integer_sequence<int, INPUT_COUNT>());
+    for (uint32_t i = 0; i < INPUT_COUNT; ++i)
+    {
+      stamps_[i].resize(capacity_);
+      head_[i] = 0;
+      num_past_[i] = 0;
+      num_deque_[i] = 0;
+      has_dropped_messages_[i] = false;
+      inter_message_lower_bounds_[i] = 0;
+      warned_about_incorrect_bound_[i] = false;
+    }
+  }
+
+  template<class... Fs>
+  ApproximateTimeSynchronizer(uint32_t queue_size, Fs&... filters)
+  : ApproximateTimeSynchronizer(queue_size)
+  {
+    connectInput(filters...);
+  }
+
+  ~ApproximateTimeSynchronizer()
+  {
+    disconnectAll();
+  }
+
+  template<class... Fs>
+  void connectInput(Fs&... filters)
+  {
+    static_assert(sizeof...(Fs) == sizeof...(Ms), "One filter per input is needed");
+    disconnectAll();
+    connectInput(std::make_integer_sequence<int, INPUT_COUNT>(), filters...);
+  }
+
+  Connection registerCallback(const Callback& callback)
+  {
+    return registerEventCallback(
+      [callback](const MessageEvent<Ms const>&... events) {callback(events.getMessage()...);});
+  }
+
+  Connection registerEventCallback(const EventCallback& callback)
+  {
+    std::lock_guard<std::mutex> lock(callbacks_mutex_);
+    const uint64_t id = next_callback_id_++;
+    callbacks_.emplace_back(id, callback);
+    return Connection(std::bind(&ApproximateTimeSynchronizer::removeCallback, this, id));
+  }
+
+  template<int i>
+  void add(const std::shared_ptr<typename std::tuple_element<i, Messages>::type const>& msg)
+  {
+    add<i>(typename std::tuple_element<i, Events>::type(msg));
+  }
+
+  template<int i>
+  void add(const typename std::tuple_element<i, Events>::type& evt)
+  {
+    namespace mt = message_filters::message_traits;
+    std::lock_guard<std::mutex> lock(data_mutex_);
+
+    const size_t position = index(i, num_past_[i] + num_deque_[i]);
+    std::get<i>(events_)[position] = evt;
+    stamps_[i][position] =
+      mt::TimeStamp<typename std::tuple_element<i, Messages>::type>::value(*evt.getMessage()).nanoseconds();
+    ++num_deque_[i];
+    if (num_deque_[i] == 1)
+    {
+      // We have just added the first message, so it was empty before
+      ++num_non_empty_deques_;
+      if (num_non_empty_deques_ == INPUT_COUNT)
+      {
+        // All deques have messages
+        process();
+      }
+    }
+    else
+    {
+      checkInterMessageBound(i);
+    }
+    // Check whether we have more messages than allowed in the queue.
+    // Note that during the above call to process(), queue i may contain queue_size_+1 messages.
+    if (num_past_[i] + num_deque_[i] > queue_size_)
+    {
+      // Cancel ongoing candidate search, if any:
+      num_non_empty_deques_ = 0;  // We will recompute it from scratch
+      for (uint32_t j = 0; j < INPUT_COUNT; ++j)
+      {
+        recover(j, num_past_[j]);
+      }
+      // Drop the oldest message in the offending topic
+      RCUTILS_ASSERT(num_deque_[i] > 1);
+      popFront(i);
+      --num_deque_[i];
+      has_dropped_messages_[i] = true;
+      if (pivot_ != NO_PIVOT)
+      {
+        // The candidate is no longer valid
+        pivot_ = NO_PIVOT;
+        // There might still be enough messages to create a new candidate:
+        process();
+      }
+    }
+  }
+
+  void setAgePenalty(double age_penalty)
+  {
+    // For correctness we only need age_penalty > -1.0, but most likely a negative age_penalty is a mistake.
+    RCUTILS_ASSERT(age_penalty >= 0);
+    std::lock_guard<std::mutex> lock(data_mutex_);
+    age_penalty_ = age_penalty;
+  }
+
+  void setInterMessageLowerBound(int i, rclcpp::Duration lower_bound)
+  {
+    RCUTILS_ASSERT(lower_bound >= rclcpp::Duration(0, 0));
+    if (i < 0 || static_cast<uint32_t>(i) >= INPUT_COUNT)
+    {
+      RCUTILS_LOG_ERROR("Ignoring the lower bound of input %d, there are %u inputs", i, INPUT_COUNT);
+      return;
+    }
+    std::lock_guard<std::mutex> lock(data_mutex_);
+    inter_message_lower_bounds_[i] = lower_bound.nanoseconds();
+  }
+
+  void setMaxIntervalDuration(rclcpp::Duration max_interval_duration)
+  {
+    RCUTILS_ASSERT(max_interval_duration >= rclcpp::Duration(0, 0));
+    std::lock_guard<std::mutex> lock(data_mutex_);
+    max_interval_duration_ = max_interval_duration.nanoseconds();
+  }
+
+private:
+  static const uint32_t NO_PIVOT = INPUT_COUNT;  // Special value for the pivot indicating that no pivot has been selected
+
+  template<int... Is>
+  void allocate(std::integer_sequence<int, Is...>)
+  {
+    int expand[] = {0, (std::get<Is>(events_).resize(capacity_), 0)...};
+    (void)expand;
+  }
+
+  template<class... Fs, int... Is>
+  void connectInput(std::integer_sequence<int, Is...>, Fs&... filters)
+  {
+    int expand[] = {0, (input_connections_[Is] = filters.registerCallback(
+      std::function<void(const typename std::tuple_element<Is, Events>::type&)>(
+        [this](const typename std::tuple_element<Is, Events>::type& evt) {this->template add<Is>(evt);})), 0)...};
+    (void)expand;
+  }
+
+  void disconnectAll()
+  {
+    for (auto & connection : input_connections_)
+    {
+      connection.disconnect();
+    }
+  }
+
+  void removeCallback(uint64_t id)
+  {
+    std::lock_guard<std::mutex> lock(callbacks_mutex_);
+    for (auto it = callbacks_.begin(); it != callbacks_.end(); ++it)
+    {
+      if (it->first == id)
+      {
+        callbacks_.erase(it);
+        return;
+      }
+    }
+  }
+
+  // Position in the ring buffer of input i of its message number n, counting the past messages first
+  size_t index(uint32_t i, size_t n) const
+  {
+    const size_t position = head_[i] + n;
+    return position < capacity_ ? position : position - capacity_;
+  }
+
+  // Assumes that deque number i is non empty
+  int64_t dequeFrontTime(uint32_t i) const
+  {
+    return stamps_[i][index(i, num_past_[i])];
+  }
+
+  // Time difference scaled like rclcpp::Duration::operator*(double)
+  int64_t scale(int64_t duration, double factor) const
+  {
+    return static_cast<int64_t>(static_cast<long double>(duration) * static_cast<long double>(factor));
+  }
+
+  // Releases the first message of input i, past or not, without updating the counts
+  void popFront(uint32_t i)
+  {
+    releaseEvent(i, head_[i], std::make_integer_sequence<int, INPUT_COUNT>());
+    head_[i] = index(i, 1);
+  }
+
+  template<int... Is>
+  void releaseEvent(uint32_t i, size_t position, std::integer_sequence<int, Is...>)
+  {
+    int expand[] = {0, (static_cast<uint32_t>(Is) == i ?
+      (std::get<Is>(events_)[position] = typename std::tuple_element<Is, Events>::type(), 0) : 0)...};
+    (void)expand;
+  }
+
+  void checkInterMessageBound(uint32_t i)
+  {
+    if (warned_about_incorrect_bound_[i])
+    {
+      return;
+    }
+    // There are at least 2 elements in the deque. Check that the gap respects the bound if it was provided.
+    const size_t count = num_past_[i] + num_deque_[i];
+    const int64_t msg_time = stamps_[i][index(i, count - 1)];
+    const int64_t previous_msg_time = stamps_[i][index(i, count - 2)];
+    if (msg_time < previous_msg_time)
+    {
+      RCUTILS_LOG_WARN_ONCE("Messages of type %d arrived out of order (will print only once)", static_cast<int>(i));
+      warned_about_incorrect_bound_[i] = true;
+    }
+    else if ((msg_time - previous_msg_time) < inter_message_lower_bounds_[i])
+    {
+      RCUTILS_LOG_WARN_ONCE("Messages of type %d arrived closer ("
+        "%" PRId64 ") than the lower bound you provided ("
+        "%" PRId64 ") (will print only once)",
+        static_cast<int>(i),
+        msg_time - previous_msg_time,
+        inter_message_lower_bounds_[i]);
+      warned_about_incorrect_bound_[i] = true;
+    }
+  }
+
+  // Assumes that deque number i is non empty and that there are no past messages
+  void dequeDeleteFront(uint32_t i)
+  {
+    RCUTILS_ASSERT(num_deque_[i] > 0 && num_past_[i] == 0);
+    popFront(i);
+    --num_deque_[i];
+    if (num_deque_[i] == 0)
+    {
+      --num_non_empty_deques_;
+    }
+  }
+
+  // Assumes that deque number i is non empty
+  void dequeMoveFrontToPast(uint32_t i)
+  {
+    RCUTILS_ASSERT(num_deque_[i] > 0);
+    ++num_past_[i];
+    --num_deque_[i];
+    if (num_deque_[i] == 0)
+    {
+      --num_non_empty_deques_;
+    }
+  }
+
+  // Makes the first messages of the deques the candidate
+  void makeCandidate()
+  {
+    // Delete all past messages, since we have found a better candidate
+    for (uint32_t i = 0; i < INPUT_COUNT; ++i)
+    {
+      for (; num_past_[i] > 0; --num_past_[i])
+      {
+        popFront(i);
+      }
+    }
+  }
+
+  // ASSUMES: num_messages <= num_past_[i]
+  void recover(uint32_t i, size_t num_messages)
+  {
+    RCUTILS_ASSERT(num_messages <= num_past_[i]);
+    num_past_[i] -= num_messages;
+    num_deque_[i] += num_messages;
+    if (num_deque_[i] > 0)
+    {
+      ++num_non_empty_deques_;
+    }
+  }
+
+  // Assumes: we have a candidate, which is at the front of every ring buffer
+  void publishCandidate()
+  {
+    publish(std::make_integer_sequence<int, INPUT_COUNT>());
+    pivot_ = NO_PIVOT;
+
+    // Recover hidden messages, and delete the ones corresponding to the candidate
+    num_non_empty_deques_ = 0;  // We will recompute it from scratch
+    for (uint32_t i = 0; i < INPUT_COUNT; ++i)
+    {
+      num_deque_[i] += num_past_[i];
+      num_past_[i] = 0;
+      RCUTILS_ASSERT(num_deque_[i] > 0);
+      popFront(i);
+      --num_deque_[i];
+      if (num_deque_[i] > 0)
+      {
+        ++num_non_empty_deques_;
+      }
+    }
+  }
+
+  template<int... Is>
+  void publish(std::integer_sequence<int, Is...>)
+  {
+    std::lock_guard<std::mutex> lock(callbacks_mutex_);
+    for (const auto & callback : callbacks_)
+    {
+      callback.second(std::get<Is>(events_)[head_[Is]]...);
+    }
+  }
+
+  // ASSUMES: all deques are non-empty
+  // end = true: look for the latest head of deque
+  //       false: look for the earliest head of deque
+  void getCandidateBoundary(uint32_t &index, int64_t &time, bool end) const
+  {
+    time = dequeFrontTime(0);
+    index = 0;
+    for (uint32_t i = 1; i < INPUT_COUNT; ++i)
+    {
+      const int64_t t = dequeFrontTime(i);
+      if ((t < time) ^ end)
+      {
+        time = t;
+        index = i;
+      }
+    }
+  }
+
+  // ASSUMES: we have a pivot and candidate
+  int64_t getVirtualTime(uint32_t i) const
+  {
+    RCUTILS_ASSERT(pivot_ != NO_PIVOT);
+    if (num_deque_[i] == 0)
+    {
+      RCUTILS_ASSERT(num_past_[i] > 0);  // Because we have a candidate
+      const int64_t last_msg_time = stamps_[i][index(i, num_past_[i] - 1)];
+      const int64_t msg_time_lower_bound = last_msg_time + inter_message_lower_bounds_[i];
+      if (msg_time_lower_bound > pivot_time_)  // Take the max
+      {
+        return msg_time_lower_bound;
+      }
+      return pivot_time_;
+    }
+    return dequeFrontTime(i);
+  }
+
+  // ASSUMES: we have a pivot and candidate
+  // end = true: look for the latest head of deque
+  //       false: look for the earliest head of deque
+  void getVirtualCandidateBoundary(uint32_t &index, int64_t &time, bool end) const
+  {
+    time = getVirtualTime(0);
+    index = 0;
+    for (uint32_t i = 1; i < INPUT_COUNT; ++i)
+    {
+      const int64_t t = getVirtualTime(i);
+      if ((t < time) ^ end)
+      {
+        time = t;
+        index = i;
+      }
+    }
+  }
+
+  // assumes data_mutex_ is already locked
+  void process()
+  {
+    // While no deque is empty
+    while (num_non_empty_deques_ == INPUT_COUNT)
+    {
+      // Find the start and end of the current interval
+      int64_t end_time, start_time;
+      uint32_t end_index, start_index;
+      getCandidateBoundary(end_index, end_time, true);
+      getCandidateBoundary(start_index, start_time, false);
+      for (uint32_t i = 0; i < INPUT_COUNT; i++)
+      {
+        if (i != end_index)
+        {
+          // No dropped message could have been better to use than the ones we have,
+          // so it becomes ok to use this topic as pivot in the future
+          has_dropped_messages_[i] = false;
+        }
+      }
+      if (pivot_ == NO_PIVOT)
+      {
+        // We do not have a candidate
+        // INVARIANT: there are no past messages
+        if (end_time - start_time > max_interval_duration_)
+        {
+          // This interval is too big to be a valid candidate, move to the next
+          dequeDeleteFront(start_index);
+          continue;
+        }
+        if (has_dropped_messages_[end_index])
+        {
+          // The topic that would become pivot has dropped messages, so it is not a good pivot
+          dequeDeleteFront(start_index);
+          continue;
+        }
+        // This is a valid candidate, and we don't have any, so take it
+        makeCandidate();
+        candidate_start_ = start_time;
+        candidate_end_ = end_time;
+        pivot_ = end_index;
+        pivot_time_ = end_time;
+        dequeMoveFrontToPast(start_index);
+      }
+      else
+      {
+        // We already have a candidate
+        // Is this one better than the current candidate?
+        // INVARIANT: has_dropped_messages_ is all false
+        if (scale(end_time - candidate_end_, 1 + age_penalty_) >= (start_time - candidate_start_))
+        {
+          // This is not a better candidate, move to the next
+          dequeMoveFrontToPast(start_index);
+        }
+        else
+        {
+          // This is a better candidate
+          makeCandidate();
+          candidate_start_ = start_time;
+          candidate_end_ = end_time;
+          dequeMoveFrontToPast(start_index);
+          // Keep the same pivot (and pivot time)
+        }
+      }
+      // INVARIANT: we have a candidate and pivot
+      RCUTILS_ASSERT(pivot_ != NO_PIVOT);
+      if (start_index == pivot_)
+      {
+        // We have exhausted all possible candidates for this pivot, we now can output the best one
+        publishCandidate();
+      }
+      else if (scale(end_time - candidate_end_, 1 + age_penalty_) >= (pivot_time_ - candidate_start_))
+      {
+        // We have not exhausted all candidates, but this candidate is already provably optimal
+        // Indeed, any future candidate must contain the interval [pivot_time_ end_time], which
+        // is already too big.
+        publishCandidate();
+      }
+      else if (num_non_empty_deques_ < INPUT_COUNT)
+      {
+        uint32_t num_non_empty_deques_before_virtual_search = num_non_empty_deques_;
+
+        // Before giving up, use the rate bounds, if provided, to further try to prove optimality
+        std::array<size_t, INPUT_COUNT> num_virtual_moves{};
+        while (1)
+        {
+          int64_t end_time, start_time;
+          uint32_t end_index, start_index;
+          getVirtualCandidateBoundary(end_index, end_time, true);
+          getVirtualCandidateBoundary(start_index, start_time, false);
+          if (scale(end_time - candidate_end_, 1 + age_penalty_) >= (pivot_time_ - candidate_start_))
+          {
+            // We have proved optimality
+            // As above, any future candidate must contain the interval [pivot_time_ end_time], which
+            // is already too big.
+            publishCandidate();  // This cleans up the virtual moves as a byproduct
+            break;  // From the while(1) loop only
+          }
+          if (scale(end_time - candidate_end_, 1 + age_penalty_) < (start_time - candidate_start_))
+          {
+            // We cannot prove optimality
+            // Indeed, we have a virtual (i.e. optimistic) candidate that is better than the current
+            // candidate
+            // Cleanup the virtual search:
+            num_non_empty_deques_ = 0;  // We will recompute it from scratch
+            for (uint32_t i = 0; i < INPUT_COUNT; ++i)
+            {
+              recover(i, num_virtual_moves[i]);
+            }
+            (void)num_non_empty_deques_before_virtual_search;  // unused variable warning stopper
+            RCUTILS_ASSERT(num_non_empty_deques_before_virtual_search == num_non_empty_deques_);
+            break;
+          }
+          // Note: we cannot reach this point with start_index == pivot_ since in that case we would
+          //       have start_time == pivot_time, in which case the two tests above are the negation
+          //       of each other, so that one must be true. Therefore the while loop always terminates.
+          RCUTILS_ASSERT(start_index != pivot_);
+          RCUTILS_ASSERT(start_time < pivot_time_);
+          dequeMoveFrontToPast(start_index);
+          num_virtual_moves[start_index]++;
+        }  // while(1)
+      }
+    }  // while(num_non_empty_deques_ == INPUT_COUNT)
+  }
+
+  const uint32_t queue_size_;
+  // One more than the queue size, as an input may hold one message too many until it is dropped
+  const size_t capacity_;
+
+  // The ring buffers of the inputs. The first num_past_ messages after the head were set aside while
+  // looking for a better candidate, the following num_deque_ messages are still to be looked at.
+  std::tuple<std::vector<MessageEvent<Ms const>>...> events_;
+  std::array<std::vector<int64_t>, INPUT_COUNT> stamps_;
+  std::array<size_t, INPUT_COUNT> head_;
+  std::array<size_t, INPUT_COUNT> num_past_;
+  std::array<size_t, INPUT_COUNT> num_deque_;
+
+  uint32_t num_non_empty_deques_;
+  uint32_t pivot_;  // Equal to NO_PIVOT if there is no candidate
+  int64_t pivot_time_;
+  int64_t candidate_start_;
+  int64_t candidate_end_;
+  int64_t max_interval_duration_;
+  double age_penalty_;
+
+  std::array<bool, INPUT_COUNT> has_dropped_messages_;
+  std::array<int64_t, INPUT_COUNT> inter_message_lower_bounds_;
+  std::array<bool, INPUT_COUNT> warned_about_incorrect_bound_;
+  std::mutex data_mutex_;  // Protects all of the above
+
+  std::mutex callbacks_mutex_;
+  std::vector<std::pair<uint64_t, EventCallback>> callbacks_;
+  uint64_t next_callback_id_;
+
+  std::array<Connection, INPUT_COUNT> input_connections_;
+};
+
+}  // namespace message_filters
+
+#endif  // MESSAGE_FILTERS__APPROXIMATE_TIME_SYNCHRONIZER_H_
@@ -0,0 +1,227 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2021, Open Source Robotics Foundation, Inc.
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Willow Garage nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#ifndef MESSAGE_FILTERS__SYNC_FAST_APPROXIMATE_TIME_H_
+#define MESSAGE_FILTERS__SYNC_FAST_APPROXIMATE_TIME_H_
+
+#include <limits>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <rclcpp/rclcpp.hpp>
+
+#include "message_filters/approximate_time_synchronizer.h"
+#include "message_filters/connection.h"
+#include "message_filters/null_types.h"
+#include "message_filters/signal9.h"
+#include "message_filters/synchronizer.h"
+
+namespace message_filters
+{
+namespace sync_policies
+{
+
+/**
+ * \brief Synchronization policy matching the messages like ApproximateTime, with ApproximateTimeSynchronizer.
+ *
+ * FastApproximateTime outputs the same sets of messages as ApproximateTime with the same settings, with less
+ * work per message. It can replace ApproximateTime in a Synchronizer:
+\verbatim
+typedef message_filters::sync_policies::FastApproximateTime<sensor_msgs::msg::Image,
+                                                            sensor_msgs::msg::CameraInfo> SyncPolicy;
+message_filters::Synchronizer<SyncPolicy> sync(SyncPolicy(10), image_sub, info_sub);
+\endverbatim
+ * To synchronize more than 9 inputs, use ApproximateTimeSynchronizer directly.
+ */
+template<typename M0, typename M1, typename M2 = NullType, typename M3 = NullType, typename M4 = NullType,
+         typename M5 = NullType, typename M6 = NullType, typename M7 = NullType, typename M8 = NullType>
+struct FastApproximateTime : public PolicyBase<M0, M1, M2, M3, M4, M5, M6, M7, M8>
+{
+  typedef Synchronizer<FastApproximateTime> Sync;
+  typedef PolicyBase<M0, M1, M2, M3, M4, M5, M6, M7, M8> Super;
+  typedef typename Super::Messages Messages;
+  typedef typename Super::Signal Signal;
+  typedef typename Super::Events Events;
+  typedef typename Super::RealTypeCount RealTypeCount;
+  typedef typename Super::M0Event M0Event;
+  typedef typename Super::M1Event M1Event;
+  typedef typename Super::M2Event M2Event;
+  typedef typename Super::M3Event M3Event;
+  typedef typename Super::M4Event M4Event;
+  typedef typename Super::M5Event M5Event;
+  typedef typename Super::M6Event M6Event;
+  typedef typename Super::M7Event M7Event;
+  typedef typename Super::M8Event M8Event;
+  typedef std::make_integer_sequence<int, RealTypeCount::value> RealIndices;
+
+  FastApproximateTime(uint32_t queue_size)
+  : parent_(0)
+  , queue_size_(queue_size)
+  , max_interval_duration_(rclcpp::Duration(std::numeric_limits<int32_t>::max(), 999999999))
+  , age_penalty_(0.1)
+  , inter_message_lower_bounds_(9, rclcpp::Duration(0, 0))
+  {
+    makeSynchronizer();
+  }
+
+  // Copies the settings, the messages waiting to be synchronized are not copied
+  FastApproximateTime(const FastApproximateTime& e)
+  : max_interval_duration_(e.max_interval_duration_)
+  {
+    *this = e;
+  }
+
+  FastApproximateTime& operator=(const FastApproximateTime& rhs)
+  {
+    parent_ = rhs.parent_;
+    queue_size_ = rhs.queue_size_;
+    max_interval_duration_ = rhs.max_interval_duration_;
+    age_penalty_ = rhs.age_penalty_;
+    inter_message_lower_bounds_ = rhs.inter_message_lower_bounds_;
+    makeSynchronizer();
+    if (parent_)
+    {
+      initParent(parent_);
+    }
+
+    return *this;
+  }
+
+  void initParent(Sync* parent)
+  {
+    parent_ = parent;
+    connectSignal(RealIndices());
+  }
+
+  template<int i>
+  void add(const typename std::tuple_element<i, Events>::type& evt)
+  {
+    addInput<i>(evt, std::integral_constant<bool, (i < RealTypeCount::value)>());
+  }
+
+  void setAgePenalty(double age_penalty)
+  {
+    age_penalty_ = age_penalty;
+    sync_->setAgePenalty(age_penalty);
+  }
+
+  void setInterMessageLowerBound(int i, rclcpp::Duration lower_bound)
+  {
+    // The synchronizer only has the real inputs, the others never get a message
+    if (i < 0 || i >= RealTypeCount::value)
+    {
+      RCUTILS_LOG_ERROR("Ignoring the lower bound of input %d, there are %d inputs", i,
+                        static_cast<int>(RealTypeCount::value));
+      return;
+    }
+    inter_message_lower_bounds_[i] = lower_bound;
+    sync_->setInterMessageLowerBound(i, lower_bound);
+  }
+
+  void setMaxIntervalDuration(rclcpp::Duration max_interval_duration)
+  {
+    max_interval_duration_ = max_interval_duration;
+    sync_->setMaxIntervalDuration(max_interval_duration);
+  }
+
+private:
+  template<typename Indices>
+  struct SynchronizerOf;
+
+  template<int... Is>
+  struct SynchronizerOf<std::integer_sequence<int, Is...> >
+  {
+    typedef ApproximateTimeSynchronizer<typename std::tuple_element<Is, Messages>::type...> type;
+  };
+
+  typedef typename SynchronizerOf<RealIndices>::type ApproximateSync;
+
+  void makeSynchronizer()
+  {
+    signal_connection_.disconnect();
+    signal_connection_ = Connection();
+    sync_.reset(new ApproximateSync(queue_size_));
+    sync_->setAgePenalty(age_penalty_);
+    sync_->setMaxIntervalDuration(max_interval_duration_);
+    for (int i = 0; i < RealTypeCount::value; ++i)
+    {
+      sync_->setInterMessageLowerBound(i, inter_message_lower_bounds_[i]);
+    }
+  }
+
+  template<int... Is>
+  void connectSignal(std::integer_sequence<int, Is...>)
+  {
+    signal_connection_ = sync_->registerEventCallback(
+      [this](const typename std::tuple_element<Is, Events>::type&... evts)
+      {
+        // The inputs past the real ones are left empty
+        Events events;
+        int expand[] = {0, (std::get<Is>(events) = evts, 0)...};
+        (void)expand;
+        parent_->signal(std::get<0>(events), std::get<1>(events), std::get<2>(events),
+                        std::get<3>(events), std::get<4>(events), std::get<5>(events),
+                        std::get<6>(events), std::get<7>(events), std::get<8>(events));
+      });
+  }
+
+  template<int i>
+  void addInput(const typename std::tuple_element<i, Events>::type& evt, std::true_type)
+  {
+    RCUTILS_ASSERT(parent_);
+    sync_->template add<i>(evt);
+  }
+
+  template<int i>
+  void addInput(const typename std::tuple_element<i, Events>::type&, std::false_type)
+  {
+  }
+
+  Sync* parent_;
+  uint32_t queue_size_;
+  rclcpp::Duration max_interval_duration_;
+  double age_penalty_;
+  std::vector<rclcpp::Duration> inter_message_lower_bounds_;
+
+  std::unique_ptr<ApproximateSync> sync_;
+  Connection signal_connection_;
+};
+
+}  // namespace sync_policies
+}  // namespace message_filters
+
+#endif  // MESSAGE_FILTERS__SYNC_FAST_APPROXIMATE_TIME_H_
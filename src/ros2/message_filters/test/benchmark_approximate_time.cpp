@@ -0,0 +1,156 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2021, Open Source Robotics Foundation, Inc.
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Willow Garage nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+
+#include <benchmark/benchmark.h>
+#include <rclcpp/rclcpp.hpp>
+#include "message_filters/synchronizer.h"
+#include "message_filters/sync_policies/approximate_time.h"
+#include "message_filters/sync_policies/fast_approximate_time.h"
+#include "message_filters/message_traits.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace message_filters;
+using namespace message_filters::sync_policies;
+
+struct Header
+{
+  rclcpp::Time stamp;
+};
+
+
+struct Msg
+{
+  Header header;
+  int data;
+};
+typedef std::shared_ptr<Msg const> MsgConstPtr;
+namespace message_filters
+{
+namespace message_traits
+{
+template<>
+struct TimeStamp<Msg>
+{
+  static rclcpp::Time value(const Msg& m)
+  {
+    return m.header.stamp;
+  }
+};
+}
+}
+
+namespace
+{
+
+const int NUM_CAMERAS = 6;
+
+typedef std::pair<MsgConstPtr, int> MessageAndCamera;
+
+// 10 seconds of 6 cameras at 30 Hz with 5 ms of jitter, which drop 5% of their frames and deliver them
+// up to 20 ms late
+std::vector<MessageAndCamera> makeInput()
+{
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> unit(0.0, 1.0);
+  std::vector<std::pair<int64_t, MessageAndCamera>> arrivals;
+  const int64_t period = 1000000000 / 30;
+  for (int camera = 0; camera < NUM_CAMERAS; ++camera)
+  {
+    for (int64_t frame = 0; frame < 300; ++frame)
+    {
+      if (unit(gen) < 0.05)
+      {
+        continue;
+      }
+      auto msg = std::make_shared<Msg>();
+      const int64_t stamp = 1000000000 + frame * period + static_cast<int64_t>((unit(gen) - 0.5) * 10000000);
+      msg->header.stamp = rclcpp::Time(stamp);
+      arrivals.emplace_back(stamp + static_cast<int64_t>(unit(gen) * 20000000), MessageAndCamera(msg, camera));
+    }
+  }
+  std::stable_sort(arrivals.begin(), arrivals.end(),
+    [](const std::pair<int64_t, MessageAndCamera>& a, const std::pair<int64_t, MessageAndCamera>& b)
+    {
+      return a.first < b.first;
+    });
+  std::vector<MessageAndCamera> input;
+  for (const auto & arrival : arrivals)
+  {
+    input.push_back(arrival.second);
+  }
+  return input;
+}
+
+template<class Sync, int... Is>
+void add(Sync& sync, const MessageAndCamera& message, std::integer_sequence<int, Is...>)
+{
+  int expand[] = {0, (message.second == Is ? (sync.template add<Is>(message.first), 0) : 0)...};
+  (void)expand;
+}
+
+// The argument is the queue size
+template<class Policy>
+void synchronizeCameras(benchmark::State& state)
+{
+  const std::vector<MessageAndCamera> input = makeInput();
+  size_t num_sets = 0;
+  for (auto _ : state)
+  {
+    Synchronizer<Policy> sync{Policy(static_cast<uint32_t>(state.range(0)))};
+    sync.registerCallback(std::bind([&num_sets]() {++num_sets;}));
+    for (const auto & message : input)
+    {
+      add(sync, message, std::make_integer_sequence<int, NUM_CAMERAS>());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * input.size());
+  state.counters["sets"] = benchmark::Counter(static_cast<double>(num_sets) / state.iterations());
+}
+
+}  // namespace
+
+static void BM_approximate_time(benchmark::State& state)
+{
+  synchronizeCameras<ApproximateTime<Msg, Msg, Msg, Msg, Msg, Msg> >(state);
+}
+BENCHMARK(BM_approximate_time)->Arg(10)->Arg(100);
+
+static void BM_fast_approximate_time(benchmark::State& state)
+{
+  synchronizeCameras<FastApproximateTime<Msg, Msg, Msg, Msg, Msg, Msg> >(state);
+}
+BENCHMARK(BM_fast_approximate_time)->Arg(10)->Arg(100);
@@ -0,0 +1,373 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2021, Open Source Robotics Foundation, Inc.
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Willow Garage nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+#include <gtest/gtest.h>
+#include <rclcpp/rclcpp.hpp>
+#include "message_filters/approximate_time_synchronizer.h"
+#include "message_filters/pass_through.h"
+#include "message_filters/synchronizer.h"
+#include "message_filters/sync_policies/approximate_time.h"
+#include "message_filters/sync_policies/fast_approximate_time.h"
+#include "message_filters/message_traits.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace message_filters;
+using namespace message_filters::sync_policies;
+
+struct Header
+{
+  rclcpp::Time stamp;
+};
+
+
+struct Msg
+{
+  Header header;
+  int data;
+};
+typedef std::shared_ptr<Msg> MsgPtr;
+typedef std::shared_ptr<Msg const> MsgConstPtr;
+namespace message_filters
+{
+namespace message_traits
+{
+template<>
+struct TimeStamp<Msg>
+{
+  static rclcpp::Time value(const Msg& m)
+  {
+    return m.header.stamp;
+  }
+};
+}
+}
+
+typedef std::pair<int64_t, int> TimeAndTopic;
+typedef std::vector<int64_t> TimeSet;
+
+struct Settings
+{
+  uint32_t queue_size;
+  double age_penalty;
+  std::vector<int64_t> inter_message_lower_bounds;
+  int64_t max_interval_duration;  // 0 for none
+};
+
+// Messages of every topic at a period with jitter, some of them dropped, and some of the topics
+// slightly out of order. The time stamps are rounded to make messages with the same time stamp.
+std::vector<TimeAndTopic> makeInput(int num_topics, std::mt19937& gen)
+{
+  std::uniform_int_distribution<int64_t> period_dist(10000000, 100000000);
+  std::uniform_real_distribution<double> unit(0.0, 1.0);
+  const int64_t resolution = unit(gen) < 0.5 ? 1 : 10000000;
+  std::vector<TimeAndTopic> input;
+  for (int topic = 0; topic < num_topics; ++topic)
+  {
+    const int64_t period = period_dist(gen);
+    const double jitter = unit(gen) * 0.5;
+    const double drop_rate = unit(gen) * 0.3;
+    int64_t t = 1000000000 + static_cast<int64_t>(unit(gen) * period);
+    while (t < 5000000000)
+    {
+      if (unit(gen) >= drop_rate)
+      {
+        const int64_t stamp = t + static_cast<int64_t>((unit(gen) - 0.5) * jitter * period);
+        input.emplace_back(stamp / resolution * resolution, topic);
+      }
+      t += period;
+    }
+  }
+  // Arrival order: by time stamp, with the messages of each topic delayed by a random latency
+  std::vector<std::pair<int64_t, TimeAndTopic>> arrivals;
+  for (const auto & message : input)
+  {
+    arrivals.emplace_back(message.first + static_cast<int64_t>(unit(gen) * 30000000), message);
+  }
+  std::stable_sort(arrivals.begin(), arrivals.end(),
+    [](const std::pair<int64_t, TimeAndTopic>& a, const std::pair<int64_t, TimeAndTopic>& b)
+    {
+      return a.first < b.first;
+    });
+  input.clear();
+  for (const auto & arrival : arrivals)
+  {
+    input.push_back(arrival.second);
+  }
+  return input;
+}
+
+Settings makeSettings(int num_topics, std::mt19937& gen)
+{
+  const uint32_t queue_sizes[] = {1, 2, 3, 5, 10, 50};
+  std::uniform_int_distribution<int> index(0, 5);
+  std::uniform_real_distribution<double> unit(0.0, 1.0);
+  Settings settings;
+  settings.queue_size = queue_sizes[index(gen)];
+  settings.age_penalty = unit(gen) < 0.5 ? 0.1 : unit(gen);
+  for (int topic = 0; topic < num_topics; ++topic)
+  {
+    settings.inter_message_lower_bounds.push_back(unit(gen) < 0.5 ? 0 : static_cast<int64_t>(unit(gen) * 20000000));
+  }
+  settings.max_interval_duration = unit(gen) < 0.5 ? 0 : static_cast<int64_t>(unit(gen) * 50000000);
+  return settings;
+}
+
+int64_t stamp(const MessageEvent<Msg const>& evt)
+{
+  return evt.getMessage()->header.stamp.nanoseconds();
+}
+
+template<class Policy>
+void applySettings(Policy& policy, const Settings& settings)
+{
+  policy.setAgePenalty(settings.age_penalty);
+  for (size_t topic = 0; topic < settings.inter_message_lower_bounds.size(); ++topic)
+  {
+    policy.setInterMessageLowerBound(topic, rclcpp::Duration::from_nanoseconds(settings.inter_message_lower_bounds[topic]));
+  }
+  if (settings.max_interval_duration > 0)
+  {
+    policy.setMaxIntervalDuration(rclcpp::Duration::from_nanoseconds(settings.max_interval_duration));
+  }
+}
+
+void record(std::vector<TimeSet>& output, const MessageEvent<NullType const>&)
+{
+  (void)output;
+}
+
+void record(std::vector<TimeSet>& output, const MessageEvent<Msg const>& evt)
+{
+  output.back().push_back(stamp(evt));
+}
+
+template<class Sync, int... Is>
+void add(Sync& sync, const TimeAndTopic& message, std::integer_sequence<int, Is...>)
+{
+  MsgPtr msg(std::make_shared<Msg>());
+  msg->header.stamp = rclcpp::Time(message.first);
+  int expand[] = {0, (message.second == Is ? (sync.template add<Is>(msg), 0) : 0)...};
+  (void)expand;
+}
+
+// Feeds the messages to a Synchronizer with the policy and returns the time stamps of the sets it outputs
+template<class Policy>
+std::vector<TimeSet> synchronize(const std::vector<TimeAndTopic>& input, const Settings& settings)
+{
+  typedef typename Policy::Events Events;
+  Policy policy(settings.queue_size);
+  applySettings(policy, settings);
+  Synchronizer<Policy> sync(policy);
+  std::vector<TimeSet> output;
+  sync.registerCallback(std::function<void(
+    const typename std::tuple_element<0, Events>::type&, const typename std::tuple_element<1, Events>::type&,
+    const typename std::tuple_element<2, Events>::type&, const typename std::tuple_element<3, Events>::type&,
+    const typename std::tuple_element<4, Events>::type&, const typename std::tuple_element<5, Events>::type&,
+    const typename std::tuple_element<6, Events>::type&, const typename std::tuple_element<7, Events>::type&,
+    const typename std::tuple_element<8, Events>::type&)>(
+      [&output](const auto& e0, const auto& e1, const auto& e2, const auto& e3, const auto& e4, const auto& e5,
+                const auto& e6, const auto& e7, const auto& e8)
+      {
+        output.emplace_back();
+        record(output, e0);
+        record(output, e1);
+        record(output, e2);
+        record(output, e3);
+        record(output, e4);
+        record(output, e5);
+        record(output, e6);
+        record(output, e7);
+        record(output, e8);
+      }));
+  for (const auto & message : input)
+  {
+    add(sync, message, std::make_integer_sequence<int, Policy::RealTypeCount::value>());
+  }
+  return output;
+}
+
+template<class OldPolicy, class NewPolicy>
+void testSameOutput(int num_topics, unsigned int seed)
+{
+  std::mt19937 gen(seed);
+  size_t num_sets = 0;
+  for (int i = 0; i < 50; ++i)
+  {
+    const std::vector<TimeAndTopic> input = makeInput(num_topics, gen);
+    const Settings settings = makeSettings(num_topics, gen);
+    const std::vector<TimeSet> expected = synchronize<OldPolicy>(input, settings);
+    const std::vector<TimeSet> output = synchronize<NewPolicy>(input, settings);
+    ASSERT_EQ(expected, output) << "Different sets with queue size " << settings.queue_size <<
+      ", age penalty " << settings.age_penalty << " and max interval " << settings.max_interval_duration;
+    num_sets += output.size();
+  }
+  EXPECT_GT(num_sets, 0u);
+}
+
+TEST(FastApproxTimeSync, SameOutputTwoTopics)
+{
+  testSameOutput<ApproximateTime<Msg, Msg>, FastApproximateTime<Msg, Msg> >(2, 1);
+}
+
+TEST(FastApproxTimeSync, SameOutputThreeTopics)
+{
+  testSameOutput<ApproximateTime<Msg, Msg, Msg>, FastApproximateTime<Msg, Msg, Msg> >(3, 2);
+}
+
+TEST(FastApproxTimeSync, SameOutputSixTopics)
+{
+  testSameOutput<ApproximateTime<Msg, Msg, Msg, Msg, Msg, Msg>,
+                 FastApproximateTime<Msg, Msg, Msg, Msg, Msg, Msg> >(6, 3);
+}
+
+TEST(FastApproxTimeSync, SameOutputNineTopics)
+{
+  testSameOutput<ApproximateTime<Msg, Msg, Msg, Msg, Msg, Msg, Msg, Msg, Msg>,
+                 FastApproximateTime<Msg, Msg, Msg, Msg, Msg, Msg, Msg, Msg, Msg> >(9, 4);
+}
+
+TEST(FastApproxTimeSync, CopiedPolicyKeepsSettings)
+{
+  // Input A:  a..b..c
+  // Input B:  .A..B..C
+  // Output:   a..b..c
+  //           .A..B..C
+  // With a lower bound of 3 on A, b can be published as soon as B arrives.
+  typedef FastApproximateTime<Msg, Msg> Policy;
+  Policy policy(10);
+  policy.setInterMessageLowerBound(0, rclcpp::Duration::from_nanoseconds(3));
+  Synchronizer<Policy> sync(policy);
+  std::vector<TimeSet> output;
+  sync.registerCallback(std::bind(
+    [&output](const MsgConstPtr& p, const MsgConstPtr& q)
+    {
+      output.push_back(TimeSet{p->header.stamp.nanoseconds(), q->header.stamp.nanoseconds()});
+    }, std::placeholders::_1, std::placeholders::_2));
+  const TimeAndTopic input[] = {{0, 0}, {1, 1}, {3, 0}, {4, 1}};
+  for (const auto & message : input)
+  {
+    add(sync, message, std::make_integer_sequence<int, 2>());
+  }
+  const std::vector<TimeSet> expected = {{0, 1}, {3, 4}};
+  EXPECT_EQ(expected, output);
+}
+
+TEST(FastApproxTimeSync, LowerBoundOfMissingInputIsIgnored)
+{
+  typedef FastApproximateTime<Msg, Msg> Policy;
+  auto run = [](const Policy & policy)
+    {
+      Synchronizer<Policy> sync(policy);
+      std::vector<TimeSet> output;
+      sync.registerCallback(std::bind(
+        [&output](const MsgConstPtr& p, const MsgConstPtr& q)
+        {
+          output.push_back(TimeSet{p->header.stamp.nanoseconds(), q->header.stamp.nanoseconds()});
+        }, std::placeholders::_1, std::placeholders::_2));
+      const TimeAndTopic input[] = {{0, 0}, {1, 1}, {3, 0}, {4, 1}, {6, 0}, {7, 1}, {9, 0}};
+      for (const auto & message : input)
+      {
+        add(sync, message, std::make_integer_sequence<int, 2>());
+      }
+      return output;
+    };
+  Policy policy(10);
+  // Only inputs 0 and 1 exist, the others must not reach the synchronizer
+  policy.setInterMessageLowerBound(2, rclcpp::Duration::from_nanoseconds(3));
+  policy.setInterMessageLowerBound(8, rclcpp::Duration::from_nanoseconds(3));
+  policy.setInterMessageLowerBound(-1, rclcpp::Duration::from_nanoseconds(3));
+  const std::vector<TimeSet> output = run(policy);
+  EXPECT_FALSE(output.empty());
+  EXPECT_EQ(run(Policy(10)), output);
+}
+
+TEST(FastApproxTimeSync, TwelveInputs)
+{
+  typedef ApproximateTimeSynchronizer<Msg, Msg, Msg, Msg, Msg, Msg, Msg, Msg, Msg, Msg, Msg, Msg> Sync;
+  std::vector<PassThrough<Msg> > inputs(12);
+  Sync sync(5, inputs[0], inputs[1], inputs[2], inputs[3], inputs[4], inputs[5],
+            inputs[6], inputs[7], inputs[8], inputs[9], inputs[10], inputs[11]);
+  std::vector<TimeSet> output;
+  Connection connection = sync.registerEventCallback(
+    [&output](const MessageEvent<Msg const>& e0, const MessageEvent<Msg const>& e1,
+              const MessageEvent<Msg const>& e2, const MessageEvent<Msg const>& e3,
+              const MessageEvent<Msg const>& e4, const MessageEvent<Msg const>& e5,
+              const MessageEvent<Msg const>& e6, const MessageEvent<Msg const>& e7,
+              const MessageEvent<Msg const>& e8, const MessageEvent<Msg const>& e9,
+              const MessageEvent<Msg const>& e10, const MessageEvent<Msg const>& e11)
+    {
+      output.push_back(TimeSet{stamp(e0), stamp(e1), stamp(e2), stamp(e3), stamp(e4), stamp(e5),
+                               stamp(e6), stamp(e7), stamp(e8), stamp(e9), stamp(e10), stamp(e11)});
+    });
+
+  // Every input gets a message per period, a little later than the previous input
+  const int64_t period = 100;
+  auto add_period = [&inputs](int64_t n)
+    {
+      for (int i = 0; i < 12; ++i)
+      {
+        MsgPtr msg(std::make_shared<Msg>());
+        msg->header.stamp = rclcpp::Time(n * period + i);
+        inputs[i].add(msg);
+      }
+    };
+  // A set is only known to be the best one once the next messages arrived
+  for (int64_t n = 0; n < 6; ++n)
+  {
+    add_period(n);
+  }
+  ASSERT_EQ(5u, output.size());
+  for (int64_t n = 0; n < 5; ++n)
+  {
+    for (int i = 0; i < 12; ++i)
+    {
+      EXPECT_EQ(n * period + i, output[n][i]);
+    }
+  }
+
+  // Callbacks can be disconnected
+  connection.disconnect();
+  add_period(6);
+  EXPECT_EQ(5u, output.size());
+}
+
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  rclcpp::init(argc, argv);
+
+  return RUN_ALL_TESTS();
+}
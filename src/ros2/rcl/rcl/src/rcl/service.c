@@ -30,6 +30,8 @@ extern "C"
 #include "rmw/rmw.h"
 #include "tracetools/tracetools.h"
 
+#include "./common.h"
+
 typedef struct rcl_service_impl_t
 {
   rcl_service_options_t options;
@@ -301,6 +303,24 @@ rcl_service_is_valid(const rcl_service_t * service)
   return true;
 }
 
+rcl_ret_t
+rcl_service_set_on_new_request_callback(
+  const rcl_service_t * service,
+  rcl_event_callback_t callback,
+  const void * user_data)
+{
+  if (!rcl_service_is_valid(service)) {
+    // error state already set
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+
+  return rcl_convert_rmw_ret_to_rcl_ret(
+    rmw_service_set_on_new_request_callback(
+      service->impl->rmw_handle,
+      callback,
+      user_data));
+}
+
 #ifdef __cplusplus
 }
 #endif
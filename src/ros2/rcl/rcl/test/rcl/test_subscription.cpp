@@ -14,6 +14,7 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
 #include <chrono>
 #include <string>
 #include <thread>
@@ -1100,6 +1101,59 @@ TEST_F(CLASSNAME(TestSubscriptionFixtureInit, RMW_IMPLEMENTATION), test_subscrip
   rcl_reset_error();
 }
 
+/* Test setting and clearing the new message callback.
+ */
+TEST_F(CLASSNAME(TestSubscriptionFixtureInit, RMW_IMPLEMENTATION), test_on_new_message_callback) {
+  auto callback = [](const void * user_data, size_t number_of_events) {
+      const_cast<std::atomic_size_t *>(
+        static_cast<const std::atomic_size_t *>(user_data))->fetch_add(number_of_events);
+    };
+  std::atomic_size_t count{0u};
+
+  EXPECT_EQ(
+    RCL_RET_INVALID_ARGUMENT,
+    rcl_subscription_set_on_new_message_callback(nullptr, callback, &count));
+  rcl_reset_error();
+  EXPECT_EQ(
+    RCL_RET_INVALID_ARGUMENT,
+    rcl_subscription_set_on_new_message_callback(&subscription_zero_init, callback, &count));
+  rcl_reset_error();
+
+  ret = rcl_subscription_set_on_new_message_callback(&subscription, callback, &count);
+  if (RCL_RET_UNSUPPORTED == ret) {
+    rcl_reset_error();
+    return;
+  }
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+  ret = rcl_publisher_init(&publisher, this->node_ptr, ts, topic, &publisher_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_ret_t ret = rcl_publisher_fini(&publisher, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  ASSERT_TRUE(wait_for_established_subscription(&publisher, 10, 100));
+  {
+    test_msgs__msg__BasicTypes msg;
+    test_msgs__msg__BasicTypes__init(&msg);
+    ret = rcl_publish(&publisher, &msg, nullptr);
+    test_msgs__msg__BasicTypes__fini(&msg);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  }
+  ASSERT_TRUE(wait_for_subscription_to_be_ready(&subscription, context_ptr, 10, 100));
+  // The listener may run on a middleware thread slightly after the wait set was triggered.
+  for (int i = 0; i < 100 && 0u == count.load(); ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_EQ(1u, count.load());
+
+  ret = rcl_subscription_set_on_new_message_callback(&subscription, nullptr, nullptr);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+}
+
 TEST_F(CLASSNAME(TestSubscriptionFixture, RMW_IMPLEMENTATION), test_init_fini_maybe_fail)
 {
   const rosidl_message_type_support_t * ts =
@@ -21,6 +21,7 @@
 #include <type_traits>
 #include <utility>
 #include <variant>  // NOLINT[build/include_order]
+#include <vector>
 
 #include "tracetools/tracetools.h"
 #include "tracetools/utils.hpp"
@@ -78,6 +79,15 @@ struct AnySubscriptionCallbackHelper
   using SharedPtrWithInfoCallback =
     std::function<void (std::shared_ptr<MessageT>, const rclcpp::MessageInfo &)>;
 
+  // Batch signatures, called with all messages taken at once, see
+  // rclcpp::SubscriptionOptionsBase::take_batch_size:
+  using BatchCallback =
+    std::function<void (const std::vector<std::shared_ptr<const MessageT>> &)>;
+  using BatchWithInfoCallback =
+    std::function<void (
+        const std::vector<std::shared_ptr<const MessageT>> &,
+        const std::vector<rclcpp::MessageInfo> &)>;
+
   using variant_type = std::variant<
     ConstRefCallback,
     ConstRefWithInfoCallback,
@@ -88,7 +98,9 @@ struct AnySubscriptionCallbackHelper
     ConstRefSharedConstPtrCallback,
     ConstRefSharedConstPtrWithInfoCallback,
     SharedPtrCallback,
-    SharedPtrWithInfoCallback
+    SharedPtrWithInfoCallback,
+    BatchCallback,
+    BatchWithInfoCallback
   >;
 };
 
@@ -126,6 +138,9 @@ private:
   using SharedPtrCallback = typename HelperT::SharedPtrCallback;
   using SharedPtrWithInfoCallback = typename HelperT::SharedPtrWithInfoCallback;
 
+  using BatchCallback = typename HelperT::BatchCallback;
+  using BatchWithInfoCallback = typename HelperT::BatchWithInfoCallback;
+
 public:
   explicit
   AnySubscriptionCallback(const AllocatorT & allocator = AllocatorT())  // NOLINT[runtime/explicit]
@@ -259,6 +274,10 @@ public:
           std::is_same_v<T, SharedPtrWithInfoCallback>)
         {
           callback(message, message_info);
+        } else if constexpr (std::is_same_v<T, BatchCallback>) {
+          callback({message});
+        } else if constexpr (std::is_same_v<T, BatchWithInfoCallback>) {
+          callback({message}, {message_info});
         } else {
           static_assert(always_false_v<T>, "unhandled callback type");
         }
@@ -266,6 +285,26 @@ public:
     TRACEPOINT(callback_end, static_cast<const void *>(this));
   }
 
+  /// Dispatch several messages, taken at once, to a batch callback.
+  /**
+   * \throws std::runtime_error if the callback does not take batches, \sa is_batch_callback()
+   */
+  void
+  dispatch_batch(
+    const std::vector<std::shared_ptr<const MessageT>> & messages,
+    const std::vector<rclcpp::MessageInfo> & message_infos)
+  {
+    TRACEPOINT(callback_start, static_cast<const void *>(this), false);
+    if (auto callback = std::get_if<BatchCallback>(&callback_variant_)) {
+      (*callback)(messages);
+    } else if (auto callback = std::get_if<BatchWithInfoCallback>(&callback_variant_)) {
+      (*callback)(messages, message_infos);
+    } else {
+      throw std::runtime_error("dispatch_batch called on a callback which does not take batches");
+    }
+    TRACEPOINT(callback_end, static_cast<const void *>(this));
+  }
+
   void
   dispatch_intra_process(
     std::shared_ptr<const MessageT> message,
@@ -308,6 +347,10 @@ public:
           std::is_same_v<T, ConstRefSharedConstPtrWithInfoCallback>)
         {
           callback(message, message_info);
+        } else if constexpr (std::is_same_v<T, BatchCallback>) {
+          callback({message});
+        } else if constexpr (std::is_same_v<T, BatchWithInfoCallback>) {
+          callback({message}, {message_info});
         } else {
           static_assert(always_false_v<T>, "unhandled callback type");
         }
@@ -351,6 +394,10 @@ public:
           std::is_same_v<T, SharedPtrWithInfoCallback>)
         {
           callback(std::move(message), message_info);
+        } else if constexpr (std::is_same_v<T, BatchCallback>) {
+          callback({std::shared_ptr<const MessageT>(std::move(message))});
+        } else if constexpr (std::is_same_v<T, BatchWithInfoCallback>) {
+          callback({std::shared_ptr<const MessageT>(std::move(message))}, {message_info});
         } else {
           static_assert(always_false_v<T>, "unhandled callback type");
         }
@@ -358,15 +405,29 @@ public:
     TRACEPOINT(callback_end, static_cast<const void *>(this));
   }
 
+  /// Return true if the callback never needs ownership of the message.
   constexpr
   bool
   use_take_shared_method() const
   {
     return
+      std::holds_alternative<ConstRefCallback>(callback_variant_) ||
+      std::holds_alternative<ConstRefWithInfoCallback>(callback_variant_) ||
       std::holds_alternative<SharedConstPtrCallback>(callback_variant_) ||
       std::holds_alternative<SharedConstPtrWithInfoCallback>(callback_variant_) ||
       std::holds_alternative<ConstRefSharedConstPtrCallback>(callback_variant_) ||
-      std::holds_alternative<ConstRefSharedConstPtrWithInfoCallback>(callback_variant_);
+      std::holds_alternative<ConstRefSharedConstPtrWithInfoCallback>(callback_variant_) ||
+      is_batch_callback();
+  }
+
+  /// Return true if the callback takes all messages taken at once in one call.
+  constexpr
+  bool
+  is_batch_callback() const
+  {
+    return
+      std::holds_alternative<BatchCallback>(callback_variant_) ||
+      std::holds_alternative<BatchWithInfoCallback>(callback_variant_);
   }
 
   void
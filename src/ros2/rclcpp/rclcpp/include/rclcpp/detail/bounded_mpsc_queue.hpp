@@ -0,0 +1,150 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__DETAIL__BOUNDED_MPSC_QUEUE_HPP_
+#define RCLCPP__DETAIL__BOUNDED_MPSC_QUEUE_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+namespace rclcpp
+{
+namespace detail
+{
+
+/// \internal Bounded, lock-free multi-producer/single-consumer queue.
+/**
+ * Every slot carries a sequence number telling producers and the consumer whether it is free
+ * or holds a value, as in Dmitry Vyukov's bounded queue.
+ * Producers claim a slot with a compare-and-swap on the enqueue index, while the single
+ * consumer owns the dequeue index and needs no atomic read-modify-write at all.
+ * Neither side ever blocks, a full queue is reported to the producer instead.
+ *
+ * The element type must be trivially copyable, values are copied in and out of the slots.
+ */
+template<typename T>
+class BoundedMPSCQueue
+{
+  static_assert(
+    std::is_trivially_copyable<T>::value,
+    "BoundedMPSCQueue elements must be trivially copyable");
+
+public:
+  /// Construct a queue able to hold `capacity` elements, rounded up to a power of two.
+  /**
+   * \throws std::invalid_argument if capacity is zero
+   */
+  explicit BoundedMPSCQueue(size_t capacity)
+  {
+    if (0u == capacity) {
+      throw std::invalid_argument("BoundedMPSCQueue capacity must be greater than zero");
+    }
+    size_t rounded = 1u;
+    while (rounded < capacity) {
+      rounded <<= 1u;
+    }
+    mask_ = rounded - 1u;
+    cells_.reset(new Cell[rounded]);
+    for (size_t i = 0u; i < rounded; ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  BoundedMPSCQueue(const BoundedMPSCQueue &) = delete;
+  BoundedMPSCQueue & operator=(const BoundedMPSCQueue &) = delete;
+
+  /// Push an element, may be called concurrently from any number of threads.
+  /**
+   * \return false if the queue is full, in which case it is left unchanged
+   */
+  bool
+  push(const T & value)
+  {
+    size_t position = enqueue_position_.load(std::memory_order_relaxed);
+    Cell * cell;
+    while (true) {
+      cell = &cells_[position & mask_];
+      const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      const auto difference =
+        static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+      if (0 == difference) {
+        if (enqueue_position_.compare_exchange_weak(
+            position, position + 1u, std::memory_order_relaxed))
+        {
+          break;
+        }
+      } else if (difference < 0) {
+        return false;
+      } else {
+        position = enqueue_position_.load(std::memory_order_relaxed);
+      }
+    }
+    cell->value = value;
+    cell->sequence.store(position + 1u, std::memory_order_release);
+    return true;
+  }
+
+  /// Pop the oldest element, may only be called by the single consumer.
+  /**
+   * \return false if the queue was empty
+   */
+  bool
+  pop(T & value)
+  {
+    Cell & cell = cells_[dequeue_position_ & mask_];
+    const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+    if (sequence != dequeue_position_ + 1u) {
+      return false;
+    }
+    value = cell.value;
+    cell.sequence.store(dequeue_position_ + mask_ + 1u, std::memory_order_release);
+    ++dequeue_position_;
+    return true;
+  }
+
+  /// Return true if there is nothing to pop, may only be called by the single consumer.
+  bool
+  empty() const
+  {
+    return cells_[dequeue_position_ & mask_].sequence.load(std::memory_order_acquire) !=
+           dequeue_position_ + 1u;
+  }
+
+  /// Return the number of elements the queue can hold.
+  size_t
+  capacity() const
+  {
+    return mask_ + 1u;
+  }
+
+private:
+  struct Cell
+  {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  alignas(64) std::atomic<size_t> enqueue_position_{0u};
+  alignas(64) size_t dequeue_position_{0u};
+  alignas(64) size_t mask_;
+  std::unique_ptr<Cell[]> cells_;
+};
+
+}  // namespace detail
+}  // namespace rclcpp
+
+#endif  // RCLCPP__DETAIL__BOUNDED_MPSC_QUEUE_HPP_
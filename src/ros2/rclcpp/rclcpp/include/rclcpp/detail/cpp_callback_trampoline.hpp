@@ -0,0 +1,55 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__DETAIL__CPP_CALLBACK_TRAMPOLINE_HPP_
+#define RCLCPP__DETAIL__CPP_CALLBACK_TRAMPOLINE_HPP_
+
+#include <functional>
+
+namespace rclcpp
+{
+namespace detail
+{
+
+/// \internal Trampoline from a C style callback to a std::function.
+/**
+ * C callbacks, like rcl_event_callback_t, take an opaque user data pointer as their first
+ * argument.
+ * Passing this function as the callback, together with the address of a std::function as the
+ * user data, forwards every call to that std::function.
+ *
+ * The std::function must outlive the registration of the callback, and it must not throw since
+ * the caller is C code.
+ *
+ * \param[in] user_data the address of a std::function<ReturnT(Args...)>
+ * \param[in] args the arguments forwarded to the std::function
+ * \return whatever the std::function returns
+ */
+template<
+  typename UserDataT,
+  typename ... Args,
+  typename ReturnT = void
+>
+ReturnT
+cpp_callback_trampoline(UserDataT user_data, Args ... args) noexcept
+{
+  const auto & actual_callback =
+    *reinterpret_cast<const std::function<ReturnT(Args...)> *>(user_data);
+  return actual_callback(args ...);
+}
+
+}  // namespace detail
+}  // namespace rclcpp
+
+#endif  // RCLCPP__DETAIL__CPP_CALLBACK_TRAMPOLINE_HPP_
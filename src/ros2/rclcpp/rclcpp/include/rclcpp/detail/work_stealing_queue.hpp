@@ -0,0 +1,137 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__DETAIL__WORK_STEALING_QUEUE_HPP_
+#define RCLCPP__DETAIL__WORK_STEALING_QUEUE_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+
+namespace rclcpp
+{
+namespace detail
+{
+
+/// \internal Bounded, lock-free single-producer/multi-consumer queue of pointers.
+/**
+ * This is the bounded array variant of the Chase-Lev work stealing deque, restricted to the
+ * operations needed by the work stealing executor: a single producer pushes at the bottom and
+ * any number of consumers (the owning worker as well as thieves) take from the top with a
+ * compare-and-swap on the top index.
+ *
+ * The queue does not own the pointed-to elements.
+ * The top and bottom indices live on separate cache lines to avoid false sharing between the
+ * producer and the consumers.
+ */
+template<typename T>
+class WorkStealingQueue
+{
+public:
+  /// Construct a queue able to hold `capacity` elements, rounded up to a power of two.
+  /**
+   * \throws std::invalid_argument if capacity is zero
+   */
+  explicit WorkStealingQueue(size_t capacity)
+  {
+    if (0u == capacity) {
+      throw std::invalid_argument("WorkStealingQueue capacity must be greater than zero");
+    }
+    size_t rounded = 1u;
+    while (rounded < capacity) {
+      rounded <<= 1u;
+    }
+    mask_ = rounded - 1u;
+    slots_.reset(new std::atomic<T *>[rounded]);
+    for (size_t i = 0u; i < rounded; ++i) {
+      slots_[i].store(nullptr, std::memory_order_relaxed);
+    }
+  }
+
+  WorkStealingQueue(const WorkStealingQueue &) = delete;
+  WorkStealingQueue & operator=(const WorkStealingQueue &) = delete;
+
+  /// Push an element at the bottom, may only be called by the single producer.
+  /**
+   * \return false if the queue is full, in which case it is left unchanged
+   */
+  bool
+  push(T * element)
+  {
+    const size_t bottom = bottom_.load(std::memory_order_relaxed);
+    const size_t top = top_.load(std::memory_order_acquire);
+    if (bottom - top > mask_) {
+      return false;
+    }
+    slots_[bottom & mask_].store(element, std::memory_order_relaxed);
+    bottom_.store(bottom + 1u, std::memory_order_release);
+    return true;
+  }
+
+  /// Take the oldest element from the top, may be called concurrently from any thread.
+  /**
+   * \return the element, or nullptr if the queue was empty or another consumer won the race
+   */
+  T *
+  steal()
+  {
+    size_t top = top_.load(std::memory_order_acquire);
+    const size_t bottom = bottom_.load(std::memory_order_acquire);
+    if (top >= bottom) {
+      return nullptr;
+    }
+    T * element = slots_[top & mask_].load(std::memory_order_acquire);
+    if (!top_.compare_exchange_strong(
+        top, top + 1u, std::memory_order_seq_cst, std::memory_order_relaxed))
+    {
+      return nullptr;
+    }
+    return element;
+  }
+
+  /// Return an approximation of the number of queued elements.
+  size_t
+  size() const
+  {
+    const size_t bottom = bottom_.load(std::memory_order_acquire);
+    const size_t top = top_.load(std::memory_order_acquire);
+    return bottom > top ? bottom - top : 0u;
+  }
+
+  /// Return true if the queue appeared empty at the time of the call.
+  bool
+  empty() const
+  {
+    return 0u == size();
+  }
+
+  /// Return the number of elements the queue can hold.
+  size_t
+  capacity() const
+  {
+    return mask_ + 1u;
+  }
+
+private:
+  alignas(64) std::atomic<size_t> top_{0u};
+  alignas(64) std::atomic<size_t> bottom_{0u};
+  alignas(64) size_t mask_;
+  std::unique_ptr<std::atomic<T *>[]> slots_;
+};
+
+}  // namespace detail
+}  // namespace rclcpp
+
+#endif  // RCLCPP__DETAIL__WORK_STEALING_QUEUE_HPP_
@@ -0,0 +1,242 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__EXECUTORS__EVENTS_EXECUTOR_HPP_
+#define RCLCPP__EXECUTORS__EVENTS_EXECUTOR_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "rcl/wait.h"
+
+#include "rclcpp/detail/bounded_mpsc_queue.hpp"
+#include "rclcpp/executor.hpp"
+#include "rclcpp/experimental/timers_manager.hpp"
+#include "rclcpp/macros.hpp"
+#include "rclcpp/visibility_control.hpp"
+
+namespace rclcpp
+{
+namespace executors
+{
+
+/// Single-threaded executor driven by middleware events instead of a wait set.
+/**
+ * Rather than building a wait set out of every entity and waiting on it, this executor
+ * registers a callback on each subscription, service and client, which the middleware calls
+ * whenever new data arrives (see SubscriptionBase::set_on_new_message_callback()).
+ * The callback pushes the entity into a lock-free event queue and wakes the executor, which
+ * then executes exactly the entities that have data, so the cost of a message does not grow
+ * with the number of entities.
+ * Steady clock timers are watched by a rclcpp::experimental::TimersManager, whose thread only
+ * queues an event when one of them is due, so the executor does not look at every timer on
+ * each wake up.
+ *
+ * Entities which cannot be driven by events are waited on by a helper thread using a small
+ * wait set: waitables, timers not using the steady clock, guard conditions signaling changes
+ * to the nodes, and entities whose middleware does not support the event callbacks.
+ * The helper hands what is ready to the executor thread and waits for it to be executed before
+ * waiting again, so every callback still runs on the thread calling spin().
+ *
+ * Only spin() is event driven, the other spin functions use the wait set based implementation
+ * of rclcpp::Executor.
+ */
+class EventsExecutor : public rclcpp::Executor
+{
+public:
+  RCLCPP_SMART_PTR_DEFINITIONS(EventsExecutor)
+
+  /// Constructor for EventsExecutor.
+  /**
+   * \param options common options for all executors
+   * \param events_queue_capacity number of entities which can have pending events at once
+   *   before the executor has to look for pending events in every entity, rounded up to a
+   *   power of two
+   * \throws std::invalid_argument if events_queue_capacity is zero
+   */
+  RCLCPP_PUBLIC
+  explicit EventsExecutor(
+    const rclcpp::ExecutorOptions & options = rclcpp::ExecutorOptions(),
+    size_t events_queue_capacity = 1024);
+
+  RCLCPP_PUBLIC
+  virtual ~EventsExecutor();
+
+  /// Execute events as they arrive until the executor is canceled or the context shut down.
+  /**
+   * \sa rclcpp::Executor:spin() for more details
+   * \throws std::runtime_error when spin() called while already spinning
+   */
+  RCLCPP_PUBLIC
+  void
+  spin() override;
+
+  /// Remove a callback group, its entities stop notifying this executor right away.
+  /**
+   * \sa rclcpp::Executor::remove_callback_group
+   */
+  RCLCPP_PUBLIC
+  void
+  remove_callback_group(
+    rclcpp::CallbackGroup::SharedPtr group_ptr,
+    bool notify = true) override;
+
+  /// Remove a node, its entities stop notifying this executor right away.
+  /**
+   * \sa rclcpp::Executor::remove_node
+   */
+  RCLCPP_PUBLIC
+  void
+  remove_node(
+    rclcpp::node_interfaces::NodeBaseInterface::SharedPtr node_ptr,
+    bool notify = true) override;
+
+  /// Convenience function which takes Node and forwards NodeBaseInterface.
+  /**
+   * \see rclcpp::executors::EventsExecutor::remove_node
+   */
+  RCLCPP_PUBLIC
+  void
+  remove_node(std::shared_ptr<rclcpp::Node> node_ptr, bool notify = true) override;
+
+private:
+  RCLCPP_DISABLE_COPY(EventsExecutor)
+
+  struct EntityEvents;
+
+  /// Entities waited on by the helper thread.
+  struct WaitSetEntities
+  {
+    std::vector<rclcpp::SubscriptionBase::WeakPtr> subscriptions;
+    std::vector<rclcpp::ServiceBase::WeakPtr> services;
+    std::vector<rclcpp::ClientBase::WeakPtr> clients;
+    std::vector<rclcpp::TimerBase::WeakPtr> timers;
+    std::vector<rclcpp::Waitable::WeakPtr> waitables;
+    std::vector<const rcl_guard_condition_t *> guard_conditions;
+  };
+
+  /// What the helper thread found ready, to be executed by the executor thread.
+  struct WaitSetResult
+  {
+    std::vector<rclcpp::SubscriptionBase::SharedPtr> subscriptions;
+    std::vector<rclcpp::ServiceBase::SharedPtr> services;
+    std::vector<rclcpp::ClientBase::SharedPtr> clients;
+    std::vector<rclcpp::TimerBase::SharedPtr> timers;
+    std::vector<std::pair<rclcpp::Waitable::SharedPtr, std::shared_ptr<void>>> waitables;
+    bool entities_changed{false};
+    std::exception_ptr exception;
+  };
+
+  /// Collect the entities of all callback groups, registering callbacks on new ones.
+  void
+  refresh_entities();
+
+  /// Return the callback groups associated with the executor, and the node guard conditions.
+  std::vector<rclcpp::CallbackGroup::SharedPtr>
+  get_associated_groups(std::vector<const rcl_guard_condition_t *> * guard_conditions);
+
+  /// Unregister the callbacks of entities no longer associated with the executor.
+  /**
+   * An entity has a single event callback, so once removed from this executor it may be
+   * registered by another one, which must not lose its callback later on.
+   */
+  void
+  release_removed_entities();
+
+  /// Unregister the callbacks of all entities.
+  void
+  release_entities();
+
+  /// Register the event callback on an entity, return false if it is not supported.
+  bool
+  set_callback(const std::shared_ptr<EntityEvents> & events);
+
+  /// Unregister the event callback of an entity, if it still exists.
+  void
+  clear_callback(const EntityEvents & events);
+
+  /// Queue an event and wake up the executor thread if it is waiting.
+  void
+  push_event(uint64_t key);
+
+  /// Sleep until an event is queued.
+  void
+  wait_for_events();
+
+  /// Execute the queued events.
+  void
+  execute_events();
+
+  /// Execute the pending events of a single entity.
+  void
+  execute_entity(EntityEvents & events);
+
+  /// Execute what the helper thread found ready and let it wait again.
+  void
+  execute_wait_set_result();
+
+  /// Helper thread loop, waits on the entities which are not driven by events.
+  void
+  run_wait_set();
+
+  /// Wait on the helper wait set once and return what is ready.
+  WaitSetResult
+  wait_once(const WaitSetEntities & weak_entities);
+
+  /// Stop the helper thread, which must be joined afterwards.
+  void
+  stop_wait_set_thread();
+
+  /// Event queue key of the helper thread.
+  static constexpr uint64_t wait_set_key_ = 0u;
+  /// Event queue key of the timers manager, entity keys start after it.
+  static constexpr uint64_t timers_key_ = 1u;
+
+  rclcpp::detail::BoundedMPSCQueue<uint64_t> events_queue_;
+  /// Set when an event did not fit into the queue, every entity has to be checked then.
+  std::atomic_bool events_queue_overflow_{false};
+
+  std::mutex wake_mutex_;
+  std::condition_variable wake_cv_;
+  std::atomic_bool sleeping_{false};
+
+  /// Protects entities_, which is also pruned by threads removing nodes and callback groups.
+  std::mutex entities_mutex_;
+  /// Entities driven by events, registered while spinning.
+  std::unordered_map<uint64_t, std::shared_ptr<EntityEvents>> entities_;
+  uint64_t next_key_{timers_key_ + 1u};
+
+  rclcpp::experimental::TimersManager::UniquePtr timers_manager_;
+
+  /// Wait set of the helper thread, only used by that thread.
+  rcl_wait_set_t events_wait_set_ = rcl_get_zero_initialized_wait_set();
+  std::atomic_bool wait_set_thread_running_{false};
+  std::mutex wait_set_mutex_;
+  std::condition_variable wait_set_cv_;
+  WaitSetEntities wait_set_entities_;
+  WaitSetResult wait_set_result_;
+  bool wait_set_result_pending_{false};
+};
+
+}  // namespace executors
+}  // namespace rclcpp
+
+#endif  // RCLCPP__EXECUTORS__EVENTS_EXECUTOR_HPP_
@@ -19,6 +19,7 @@
 #include <cassert>
 #include <cstdlib>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <string>
 
@@ -54,6 +55,15 @@ namespace executors
  * exec.add_node(node);
  * exec.spin();
  * exec.remove_node(node);
+ *
+ * Entities are collected and the wait set is sized when nodes or callback groups are added to
+ * or removed from the executor while it is not spinning, and again only when a node signals that
+ * its entities changed.
+ * Once collected, an iteration of spin(), spin_some() or spin_once() performs no heap allocation
+ * of its own, which makes this executor suitable for real-time loops as long as the memory
+ * strategy, the subscriptions' message memory strategies (for example
+ * rclcpp::strategies::message_pool_memory_strategy::MessagePoolMemoryStrategy) and the user
+ * callbacks do not allocate either.
  */
 class StaticSingleThreadedExecutor : public rclcpp::Executor
 {
@@ -213,6 +223,19 @@ protected:
 private:
   RCLCPP_DISABLE_COPY(StaticSingleThreadedExecutor)
 
+  /// Collect the entities and size the wait set now, unless the executor is spinning.
+  /**
+   * While spinning, changes are instead picked up by the spinning thread.
+   */
+  void
+  collect_entities();
+
+  /// Initialize the entities collector if needed, called by the spinning thread.
+  void
+  init_entities_collector();
+
+  /// Serializes collect_entities() with the spinning thread taking over the entities collector.
+  std::mutex collect_mutex_;
   StaticExecutorEntitiesCollector::SharedPtr entities_collector_;
 };
 
@@ -0,0 +1,165 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__EXECUTORS__WORK_STEALING_EXECUTOR_HPP_
+#define RCLCPP__EXECUTORS__WORK_STEALING_EXECUTOR_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "rclcpp/detail/work_stealing_queue.hpp"
+#include "rclcpp/executor.hpp"
+#include "rclcpp/macros.hpp"
+#include "rclcpp/memory_strategies.hpp"
+#include "rclcpp/visibility_control.hpp"
+
+namespace rclcpp
+{
+namespace executors
+{
+
+/// Multi-threaded executor in which worker threads never contend on the wait set.
+/**
+ * Unlike the MultiThreadedExecutor, where every thread takes turns waiting on the wait set
+ * and selecting the next executable under a shared mutex, this executor dedicates the thread
+ * that calls spin() to polling the wait set.
+ * Every ready executable it finds is pushed into the ready queue of one of the worker threads.
+ * Workers take from their own queue first and steal from the queues of the other workers when
+ * their own is empty, so selecting work never requires a lock.
+ *
+ * Callback group semantics are the same as for the other executors: at most one executable of
+ * a mutually exclusive callback group is queued or running at any time, and a timer is never
+ * executed by two threads at once, even in a reentrant callback group.
+ */
+class WorkStealingExecutor : public rclcpp::Executor
+{
+public:
+  RCLCPP_SMART_PTR_DEFINITIONS(WorkStealingExecutor)
+
+  /// Constructor for WorkStealingExecutor.
+  /**
+   * \param options common options for all executors
+   * \param number_of_threads number of worker threads, not counting the thread calling spin(),
+   *   the default 0 will use the number of cpu cores found instead
+   * \param queue_capacity number of executables each worker queue can hold before the polling
+   *   thread has to wait for the workers to catch up, rounded up to a power of two
+   * \param timeout maximum time to wait on the wait set
+   * \throws std::invalid_argument if queue_capacity is zero
+   */
+  RCLCPP_PUBLIC
+  WorkStealingExecutor(
+    const rclcpp::ExecutorOptions & options = rclcpp::ExecutorOptions(),
+    size_t number_of_threads = 0,
+    size_t queue_capacity = 256,
+    std::chrono::nanoseconds timeout = std::chrono::nanoseconds(-1));
+
+  RCLCPP_PUBLIC
+  virtual ~WorkStealingExecutor();
+
+  /**
+   * \sa rclcpp::Executor:spin() for more details
+   * \throws std::runtime_error when spin() called while already spinning
+   */
+  RCLCPP_PUBLIC
+  void
+  spin() override;
+
+  /// Return the number of worker threads, not counting the polling thread.
+  RCLCPP_PUBLIC
+  size_t
+  get_number_of_threads();
+
+protected:
+  /// Wait for work and hand every ready executable to the worker queues until spinning stops.
+  RCLCPP_PUBLIC
+  void
+  poll();
+
+  /// Worker loop, executes work from its own queue or stolen from the other queues.
+  RCLCPP_PUBLIC
+  void
+  run(size_t this_thread_number);
+
+private:
+  RCLCPP_DISABLE_COPY(WorkStealingExecutor)
+
+  /// An executable, with the in flight flag of its entity if it has one.
+  struct ReadyExecutable
+  {
+    AnyExecutable any_exec;
+    std::atomic_bool * in_flight{nullptr};
+  };
+
+  using ReadyQueue = rclcpp::detail::WorkStealingQueue<ReadyExecutable>;
+
+  /// Return the in flight flag of an entity, only called by the polling thread.
+  std::atomic_bool *
+  get_in_flight_flag(const void * entity);
+
+  /// Drop the flags of entities which are not in flight, once there are many of them.
+  void
+  prune_in_flight_flags();
+
+  /// Push an executable to the next worker queue, waiting while all of them are full.
+  bool
+  dispatch(std::unique_ptr<ReadyExecutable> ready_exec);
+
+  /// Take an executable from the given worker's queue, or steal one from another worker.
+  ReadyExecutable *
+  acquire(size_t this_thread_number);
+
+  /// Clear an in flight flag, if any, and wake the polling thread if it waits for progress.
+  void
+  mark_progress(std::atomic_bool * in_flight);
+
+  /// Wake up workers waiting for work.
+  void
+  notify_workers(bool all);
+
+  size_t number_of_threads_;
+  std::chrono::nanoseconds next_exec_timeout_;
+
+  std::vector<std::unique_ptr<ReadyQueue>> queues_;
+  size_t next_queue_{0u};
+
+  /// Number of executables pushed but not yet taken by a worker.
+  std::atomic_size_t pending_{0u};
+  std::mutex idle_mutex_;
+  std::condition_variable idle_cv_;
+
+  /// Set while an entity is queued, or for timers while queued or running.
+  /**
+   * Only the polling thread accesses the map and sets flags, workers clear them.
+   */
+  std::unordered_map<const void *, std::unique_ptr<std::atomic_bool>> in_flight_flags_;
+  size_t in_flight_flags_prune_size_{64u};
+
+  /// Number of executables taken or finished, which the polling thread may wait on.
+  std::atomic<uint64_t> progress_count_{0u};
+  std::atomic_bool poller_waiting_{false};
+  std::mutex progress_mutex_;
+  std::condition_variable progress_cv_;
+};
+
+}  // namespace executors
+}  // namespace rclcpp
+
+#endif  // RCLCPP__EXECUTORS__WORK_STEALING_EXECUTOR_HPP_
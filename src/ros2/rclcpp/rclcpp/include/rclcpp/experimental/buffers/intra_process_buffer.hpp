@@ -15,6 +15,7 @@
 #ifndef RCLCPP__EXPERIMENTAL__BUFFERS__INTRA_PROCESS_BUFFER_HPP_
 #define RCLCPP__EXPERIMENTAL__BUFFERS__INTRA_PROCESS_BUFFER_HPP_
 
+#include <atomic>
 #include <memory>
 #include <type_traits>
 #include <utility>
@@ -211,7 +212,17 @@ private:
     MessageUniquePtr unique_msg;
     MessageDeleter * deleter = std::get_deleter<MessageDeleter, const MessageT>(buffer_msg);
     auto ptr = MessageAllocTraits::allocate(*message_allocator_.get(), 1);
-    MessageAllocTraits::construct(*message_allocator_.get(), ptr, *buffer_msg);
+    if (buffer_msg.use_count() == 1) {
+      // Copy-on-write: nobody else can see the message anymore, so its content is moved out
+      // instead of copied. The intra-process manager only ever shares messages it created
+      // as non-const objects, which makes casting away the constness safe.
+      // The fence pairs with the release of the last other reference.
+      std::atomic_thread_fence(std::memory_order_acquire);
+      MessageAllocTraits::construct(
+        *message_allocator_.get(), ptr, std::move(*const_cast<MessageT *>(buffer_msg.get())));
+    } else {
+      MessageAllocTraits::construct(*message_allocator_.get(), ptr, *buffer_msg);
+    }
     if (deleter) {
       unique_msg = MessageUniquePtr(ptr, *deleter);
     } else {
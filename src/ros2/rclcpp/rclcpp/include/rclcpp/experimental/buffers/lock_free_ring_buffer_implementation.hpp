@@ -0,0 +1,220 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__EXPERIMENTAL__BUFFERS__LOCK_FREE_RING_BUFFER_IMPLEMENTATION_HPP_
+#define RCLCPP__EXPERIMENTAL__BUFFERS__LOCK_FREE_RING_BUFFER_IMPLEMENTATION_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "rclcpp/experimental/buffers/buffer_implementation_base.hpp"
+#include "rclcpp/logger.hpp"
+#include "rclcpp/logging.hpp"
+#include "rclcpp/macros.hpp"
+#include "rclcpp/visibility_control.hpp"
+
+namespace rclcpp
+{
+namespace experimental
+{
+namespace buffers
+{
+
+/// Store elements in a fixed-size, FIFO buffer without using a mutex
+/**
+ * Like RingBufferImplementation, the oldest element is dropped when enqueuing into a full
+ * buffer, but any number of threads can enqueue and dequeue concurrently without locking.
+ *
+ * Each slot carries a turn counter telling whether it is free or holds an element for the
+ * current round over the buffer.
+ * Producers and consumers claim a slot with a compare-and-swap on the head or tail index, which
+ * are kept on separate cache lines, and then only touch that slot.
+ *
+ * All public member functions are thread-safe.
+ */
+template<typename BufferT>
+class LockFreeRingBufferImplementation : public BufferImplementationBase<BufferT>
+{
+public:
+  explicit LockFreeRingBufferImplementation(size_t capacity)
+  : capacity_(capacity)
+  {
+    if (capacity == 0) {
+      throw std::invalid_argument("capacity must be a positive, non-zero value");
+    }
+    slots_.reset(new Slot[capacity_]);
+  }
+
+  virtual ~LockFreeRingBufferImplementation() {}
+
+  /// Add a new element to store in the ring buffer
+  /**
+   * This member function is thread-safe.
+   *
+   * \param request the element to be stored in the ring buffer
+   */
+  void enqueue(BufferT request)
+  {
+    while (!try_enqueue_(request)) {
+      // Read the tail first, so that the size computed is never negative.
+      const size_t tail = tail_.load(std::memory_order_acquire);
+      const size_t head = head_.load(std::memory_order_acquire);
+      if (head - tail >= capacity_) {
+        // The buffer is full, make room by dropping the oldest element.
+        BufferT oldest;
+        try_dequeue_(oldest);
+      } else {
+        // A consumer is still moving out the element of the slot we need.
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  /// Remove the oldest element from ring buffer
+  /**
+   * This member function is thread-safe.
+   *
+   * \return the element that is being removed from the ring buffer
+   */
+  BufferT dequeue()
+  {
+    BufferT request;
+    if (!try_dequeue_(request)) {
+      RCLCPP_ERROR(rclcpp::get_logger("rclcpp"), "Calling dequeue on empty intra-process buffer");
+      throw std::runtime_error("Calling dequeue on empty intra-process buffer");
+    }
+    return request;
+  }
+
+  /// Get if the ring buffer has at least one element stored
+  /**
+   * This member function is thread-safe.
+   *
+   * \return `true` if there is data and `false` otherwise
+   */
+  inline bool has_data() const
+  {
+    const size_t tail = tail_.load(std::memory_order_acquire);
+    return slots_[index_(tail)].turn.load(std::memory_order_acquire) == 2 * turn_(tail) + 1;
+  }
+
+  /// Get if the size of the buffer is equal to its capacity
+  /**
+   * This member function is thread-safe, the result may be outdated if other threads are
+   * using the buffer concurrently.
+   *
+   * \return `true` if the size of the buffer is equal is capacity
+   * and `false` otherwise
+   */
+  inline bool is_full() const
+  {
+    const size_t tail = tail_.load(std::memory_order_acquire);
+    const size_t head = head_.load(std::memory_order_acquire);
+    return head - tail >= capacity_;
+  }
+
+  /// Remove all the elements stored in the ring buffer
+  /**
+   * This member function is thread-safe.
+   */
+  void clear()
+  {
+    BufferT request;
+    while (try_dequeue_(request)) {
+    }
+  }
+
+private:
+  /// A slot is free for round n when turn is 2 * n, and full when it is 2 * n + 1.
+  struct alignas(64) Slot
+  {
+    std::atomic<size_t> turn{0u};
+    BufferT value{};
+  };
+
+  /// Claim the slot at the head and move the element into it, leaving it untouched on failure.
+  /**
+   * \return `false` if the slot at the head is not free yet
+   */
+  bool try_enqueue_(BufferT & request)
+  {
+    size_t head = head_.load(std::memory_order_acquire);
+    while (true) {
+      Slot & slot = slots_[index_(head)];
+      if (slot.turn.load(std::memory_order_acquire) == 2 * turn_(head)) {
+        if (head_.compare_exchange_strong(head, head + 1u)) {
+          slot.value = std::move(request);
+          slot.turn.store(2 * turn_(head) + 1, std::memory_order_release);
+          return true;
+        }
+      } else {
+        const size_t previous_head = head;
+        head = head_.load(std::memory_order_acquire);
+        if (head == previous_head) {
+          return false;
+        }
+      }
+    }
+  }
+
+  /// Claim the slot at the tail and move its element out.
+  /**
+   * \return `false` if the slot at the tail does not hold an element yet
+   */
+  bool try_dequeue_(BufferT & request)
+  {
+    size_t tail = tail_.load(std::memory_order_acquire);
+    while (true) {
+      Slot & slot = slots_[index_(tail)];
+      if (slot.turn.load(std::memory_order_acquire) == 2 * turn_(tail) + 1) {
+        if (tail_.compare_exchange_strong(tail, tail + 1u)) {
+          request = std::move(slot.value);
+          slot.turn.store(2 * turn_(tail) + 2, std::memory_order_release);
+          return true;
+        }
+      } else {
+        const size_t previous_tail = tail;
+        tail = tail_.load(std::memory_order_acquire);
+        if (tail == previous_tail) {
+          return false;
+        }
+      }
+    }
+  }
+
+  inline size_t index_(size_t position) const
+  {
+    return position % capacity_;
+  }
+
+  inline size_t turn_(size_t position) const
+  {
+    return position / capacity_;
+  }
+
+  alignas(64) std::atomic<size_t> head_{0u};
+  alignas(64) std::atomic<size_t> tail_{0u};
+  alignas(64) const size_t capacity_;
+  std::unique_ptr<Slot[]> slots_;
+};
+
+}  // namespace buffers
+}  // namespace experimental
+}  // namespace rclcpp
+
+#endif  // RCLCPP__EXPERIMENTAL__BUFFERS__LOCK_FREE_RING_BUFFER_IMPLEMENTATION_HPP_
@@ -16,12 +16,15 @@
 #define RCLCPP__EXPERIMENTAL__CREATE_INTRA_PROCESS_BUFFER_HPP_
 
 #include <memory>
+#include <stdexcept>
 #include <type_traits>
 #include <utility>
 
 #include "rcl/subscription.h"
 
+#include "rclcpp/experimental/buffers/buffer_implementation_base.hpp"
 #include "rclcpp/experimental/buffers/intra_process_buffer.hpp"
+#include "rclcpp/experimental/buffers/lock_free_ring_buffer_implementation.hpp"
 #include "rclcpp/experimental/buffers/ring_buffer_implementation.hpp"
 #include "rclcpp/intra_process_buffer_type.hpp"
 
@@ -30,6 +33,25 @@ namespace rclcpp
 namespace experimental
 {
 
+/// Create the buffer implementation selected, storing elements of type BufferT.
+template<typename BufferT>
+std::unique_ptr<rclcpp::experimental::buffers::BufferImplementationBase<BufferT>>
+create_buffer_implementation(
+  IntraProcessBufferImplementation buffer_implementation,
+  size_t buffer_size)
+{
+  switch (buffer_implementation) {
+    case IntraProcessBufferImplementation::RingBuffer:
+      return std::make_unique<rclcpp::experimental::buffers::RingBufferImplementation<BufferT>>(
+        buffer_size);
+    case IntraProcessBufferImplementation::LockFreeRingBuffer:
+      return std::make_unique<
+        rclcpp::experimental::buffers::LockFreeRingBufferImplementation<BufferT>>(buffer_size);
+    default:
+      throw std::runtime_error("Unrecognized IntraProcessBufferImplementation value");
+  }
+}
+
 template<
   typename MessageT,
   typename Alloc = std::allocator<void>,
@@ -38,7 +60,9 @@ typename rclcpp::experimental::buffers::IntraProcessBuffer<MessageT, Alloc, Dele
 create_intra_process_buffer(
   IntraProcessBufferType buffer_type,
   rmw_qos_profile_t qos,
-  std::shared_ptr<Alloc> allocator)
+  std::shared_ptr<Alloc> allocator,
+  IntraProcessBufferImplementation buffer_implementation =
+  IntraProcessBufferImplementation::RingBuffer)
 {
   using MessageSharedPtr = std::shared_ptr<const MessageT>;
   using MessageUniquePtr = std::unique_ptr<MessageT, Deleter>;
@@ -53,15 +77,14 @@ create_intra_process_buffer(
       {
         using BufferT = MessageSharedPtr;
 
-        auto buffer_implementation =
-          std::make_unique<rclcpp::experimental::buffers::RingBufferImplementation<BufferT>>(
-          buffer_size);
+        auto buffer_implementation_ptr =
+          create_buffer_implementation<BufferT>(buffer_implementation, buffer_size);
 
         // Construct the intra_process_buffer
         buffer =
           std::make_unique<rclcpp::experimental::buffers::TypedIntraProcessBuffer<MessageT, Alloc,
             Deleter, BufferT>>(
-          std::move(buffer_implementation),
+          std::move(buffer_implementation_ptr),
           allocator);
 
         break;
@@ -70,15 +93,14 @@ create_intra_process_buffer(
       {
         using BufferT = MessageUniquePtr;
 
-        auto buffer_implementation =
-          std::make_unique<rclcpp::experimental::buffers::RingBufferImplementation<BufferT>>(
-          buffer_size);
+        auto buffer_implementation_ptr =
+          create_buffer_implementation<BufferT>(buffer_implementation, buffer_size);
 
         // Construct the intra_process_buffer
         buffer =
           std::make_unique<rclcpp::experimental::buffers::TypedIntraProcessBuffer<MessageT, Alloc,
             Deleter, BufferT>>(
-          std::move(buffer_implementation),
+          std::move(buffer_implementation_ptr),
           allocator);
 
         break;
@@ -86,6 +86,10 @@ namespace experimental
  * This information allows this class to operate efficiently by performing the
  * fewest number of copies of the message required.
  *
+ * Publishing does not lock this class: the subscriptions of every publisher are kept in an
+ * immutable snapshot, which is replaced as a whole whenever a publisher or a subscription is
+ * added or removed, while publishers keep using the snapshot they loaded.
+ *
  * This class is neither CopyConstructable nor CopyAssignable.
  */
 class IntraProcessManager
@@ -186,52 +190,45 @@ public:
     using MessageAllocTraits = allocator::AllocRebind<MessageT, Alloc>;
     using MessageAllocatorT = typename MessageAllocTraits::allocator_type;
 
-    std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+    // The snapshot stays valid for this publish, even if the subscriptions change meanwhile.
+    auto snapshot = get_publisher_subscriptions();
 
-    auto publisher_it = pub_to_subs_.find(intra_process_publisher_id);
-    if (publisher_it == pub_to_subs_.end()) {
+    auto publisher_it = snapshot->find(intra_process_publisher_id);
+    if (publisher_it == snapshot->end()) {
       // Publisher is either invalid or no longer exists.
       RCLCPP_WARN(
         rclcpp::get_logger("rclcpp"),
         "Calling do_intra_process_publish for invalid or no longer existing publisher id");
       return;
     }
-    const auto & sub_ids = publisher_it->second;
+    const auto & subs = publisher_it->second;
 
-    if (sub_ids.take_ownership_subscriptions.empty()) {
+    if (subs.take_ownership_subscriptions.empty()) {
       // None of the buffers require ownership, so we promote the pointer
       std::shared_ptr<MessageT> msg = std::move(message);
 
       this->template add_shared_msg_to_buffers<MessageT, Alloc, Deleter>(
-        msg, sub_ids.take_shared_subscriptions);
-    } else if (!sub_ids.take_ownership_subscriptions.empty() && // NOLINT
-      sub_ids.take_shared_subscriptions.size() <= 1)
+        msg, subs.take_shared_subscriptions);
+    } else if (!subs.take_ownership_subscriptions.empty() && // NOLINT
+      subs.take_shared_subscriptions.size() <= 1)
     {
       // There is at maximum 1 buffer that does not require ownership.
       // So this case is equivalent to all the buffers requiring ownership
-
-      // Merge the two vector of ids into a unique one
-      std::vector<uint64_t> concatenated_vector(sub_ids.take_shared_subscriptions);
-      concatenated_vector.insert(
-        concatenated_vector.end(),
-        sub_ids.take_ownership_subscriptions.begin(),
-        sub_ids.take_ownership_subscriptions.end());
-
       this->template add_owned_msg_to_buffers<MessageT, Alloc, Deleter>(
         std::move(message),
-        concatenated_vector,
+        subs.all_subscriptions,
         allocator);
-    } else if (!sub_ids.take_ownership_subscriptions.empty() && // NOLINT
-      sub_ids.take_shared_subscriptions.size() > 1)
+    } else if (!subs.take_ownership_subscriptions.empty() && // NOLINT
+      subs.take_shared_subscriptions.size() > 1)
     {
       // Construct a new shared pointer from the message
       // for the buffers that do not require ownership
       auto shared_msg = std::allocate_shared<MessageT, MessageAllocatorT>(*allocator, *message);
 
       this->template add_shared_msg_to_buffers<MessageT, Alloc, Deleter>(
-        shared_msg, sub_ids.take_shared_subscriptions);
+        shared_msg, subs.take_shared_subscriptions);
       this->template add_owned_msg_to_buffers<MessageT, Alloc, Deleter>(
-        std::move(message), sub_ids.take_ownership_subscriptions, allocator);
+        std::move(message), subs.take_ownership_subscriptions, allocator);
     }
   }
 
@@ -248,24 +245,25 @@ public:
     using MessageAllocTraits = allocator::AllocRebind<MessageT, Alloc>;
     using MessageAllocatorT = typename MessageAllocTraits::allocator_type;
 
-    std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+    // The snapshot stays valid for this publish, even if the subscriptions change meanwhile.
+    auto snapshot = get_publisher_subscriptions();
 
-    auto publisher_it = pub_to_subs_.find(intra_process_publisher_id);
-    if (publisher_it == pub_to_subs_.end()) {
+    auto publisher_it = snapshot->find(intra_process_publisher_id);
+    if (publisher_it == snapshot->end()) {
       // Publisher is either invalid or no longer exists.
       RCLCPP_WARN(
         rclcpp::get_logger("rclcpp"),
         "Calling do_intra_process_publish for invalid or no longer existing publisher id");
       return nullptr;
     }
-    const auto & sub_ids = publisher_it->second;
+    const auto & subs = publisher_it->second;
 
-    if (sub_ids.take_ownership_subscriptions.empty()) {
+    if (subs.take_ownership_subscriptions.empty()) {
       // If there are no owning, just convert to shared.
       std::shared_ptr<MessageT> shared_msg = std::move(message);
-      if (!sub_ids.take_shared_subscriptions.empty()) {
+      if (!subs.take_shared_subscriptions.empty()) {
         this->template add_shared_msg_to_buffers<MessageT, Alloc, Deleter>(
-          shared_msg, sub_ids.take_shared_subscriptions);
+          shared_msg, subs.take_shared_subscriptions);
       }
       return shared_msg;
     } else {
@@ -273,15 +271,15 @@ public:
       // do not require ownership and to return.
       auto shared_msg = std::allocate_shared<MessageT, MessageAllocatorT>(*allocator, *message);
 
-      if (!sub_ids.take_shared_subscriptions.empty()) {
+      if (!subs.take_shared_subscriptions.empty()) {
         this->template add_shared_msg_to_buffers<MessageT, Alloc, Deleter>(
           shared_msg,
-          sub_ids.take_shared_subscriptions);
+          subs.take_shared_subscriptions);
       }
-      if (!sub_ids.take_ownership_subscriptions.empty()) {
+      if (!subs.take_ownership_subscriptions.empty()) {
         this->template add_owned_msg_to_buffers<MessageT, Alloc, Deleter>(
           std::move(message),
-          sub_ids.take_ownership_subscriptions,
+          subs.take_ownership_subscriptions,
           allocator);
       }
 
@@ -338,6 +336,33 @@ private:
   using PublisherToSubscriptionIdsMap =
     std::unordered_map<uint64_t, SplittedSubscriptions>;
 
+  using SubscriptionWeakPtrs =
+    std::vector<rclcpp::experimental::SubscriptionIntraProcessBase::WeakPtr>;
+
+  /// Subscriptions of a publisher, as seen by the publishing thread.
+  struct PublisherSubscriptions
+  {
+    SubscriptionWeakPtrs take_shared_subscriptions;
+    SubscriptionWeakPtrs take_ownership_subscriptions;
+    /// The shared subscriptions followed by the ownership ones.
+    SubscriptionWeakPtrs all_subscriptions;
+  };
+
+  using PublisherToSubscriptionsSnapshot =
+    std::unordered_map<uint64_t, PublisherSubscriptions>;
+
+  /// Return the current snapshot of the subscriptions of every publisher, without locking.
+  std::shared_ptr<const PublisherToSubscriptionsSnapshot>
+  get_publisher_subscriptions() const
+  {
+    return std::atomic_load(&pub_to_subs_snapshot_);
+  }
+
+  /// Replace the snapshot returned by get_publisher_subscriptions(), mutex_ must be held.
+  RCLCPP_PUBLIC
+  void
+  update_publisher_subscriptions();
+
   RCLCPP_PUBLIC
   static
   uint64_t
@@ -358,14 +383,10 @@ private:
   void
   add_shared_msg_to_buffers(
     std::shared_ptr<const MessageT> message,
-    std::vector<uint64_t> subscription_ids)
+    const SubscriptionWeakPtrs & subscriptions)
   {
-    for (auto id : subscription_ids) {
-      auto subscription_it = subscriptions_.find(id);
-      if (subscription_it == subscriptions_.end()) {
-        throw std::runtime_error("subscription has unexpectedly gone out of scope");
-      }
-      auto subscription_base = subscription_it->second.subscription.lock();
+    for (const auto & weak_subscription : subscriptions) {
+      auto subscription_base = weak_subscription.lock();
       if (subscription_base) {
         auto subscription = std::dynamic_pointer_cast<
           rclcpp::experimental::SubscriptionIntraProcess<MessageT, Alloc, Deleter>
@@ -379,8 +400,6 @@ private:
         }
 
         subscription->provide_intra_process_message(message);
-      } else {
-        subscriptions_.erase(id);
       }
     }
   }
@@ -392,18 +411,14 @@ private:
   void
   add_owned_msg_to_buffers(
     std::unique_ptr<MessageT, Deleter> message,
-    std::vector<uint64_t> subscription_ids,
+    const SubscriptionWeakPtrs & subscriptions,
     std::shared_ptr<typename allocator::AllocRebind<MessageT, Alloc>::allocator_type> allocator)
   {
     using MessageAllocTraits = allocator::AllocRebind<MessageT, Alloc>;
     using MessageUniquePtr = std::unique_ptr<MessageT, Deleter>;
 
-    for (auto it = subscription_ids.begin(); it != subscription_ids.end(); it++) {
-      auto subscription_it = subscriptions_.find(*it);
-      if (subscription_it == subscriptions_.end()) {
-        throw std::runtime_error("subscription has unexpectedly gone out of scope");
-      }
-      auto subscription_base = subscription_it->second.subscription.lock();
+    for (auto it = subscriptions.begin(); it != subscriptions.end(); it++) {
+      auto subscription_base = it->lock();
       if (subscription_base) {
         auto subscription = std::dynamic_pointer_cast<
           rclcpp::experimental::SubscriptionIntraProcess<MessageT, Alloc, Deleter>
@@ -416,7 +431,7 @@ private:
                   "allocator types, which is not supported");
         }
 
-        if (std::next(it) == subscription_ids.end()) {
+        if (std::next(it) == subscriptions.end()) {
           // If this is the last subscription, give up ownership
           subscription->provide_intra_process_message(std::move(message));
         } else {
@@ -429,8 +444,6 @@ private:
 
           subscription->provide_intra_process_message(std::move(copy_message));
         }
-      } else {
-        subscriptions_.erase(subscription_it);
       }
     }
   }
@@ -439,6 +452,9 @@ private:
   SubscriptionMap subscriptions_;
   PublisherMap publishers_;
 
+  /// Only accessed through std::atomic_load() and std::atomic_store().
+  std::shared_ptr<const PublisherToSubscriptionsSnapshot> pub_to_subs_snapshot_;
+
   mutable std::shared_timed_mutex mutex_;
 };
 
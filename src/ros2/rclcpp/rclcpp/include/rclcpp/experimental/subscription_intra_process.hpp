@@ -66,7 +66,9 @@ public:
     rclcpp::Context::SharedPtr context,
     const std::string & topic_name,
     rmw_qos_profile_t qos_profile,
-    rclcpp::IntraProcessBufferType buffer_type)
+    rclcpp::IntraProcessBufferType buffer_type,
+    rclcpp::IntraProcessBufferImplementation buffer_implementation =
+    rclcpp::IntraProcessBufferImplementation::RingBuffer)
   : SubscriptionIntraProcessBase(topic_name, qos_profile),
     any_callback_(callback)
   {
@@ -78,7 +80,8 @@ public:
     buffer_ = rclcpp::experimental::create_intra_process_buffer<MessageT, Alloc, Deleter>(
       buffer_type,
       qos_profile,
-      allocator);
+      allocator,
+      buffer_implementation);
 
     // Create the guard condition.
     rcl_guard_condition_options_t guard_condition_options =
@@ -0,0 +1,162 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__EXPERIMENTAL__TIMERS_MANAGER_HPP_
+#define RCLCPP__EXPERIMENTAL__TIMERS_MANAGER_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "rclcpp/macros.hpp"
+#include "rclcpp/timer.hpp"
+#include "rclcpp/visibility_control.hpp"
+
+namespace rclcpp
+{
+namespace experimental
+{
+
+/// Keep track of when a set of timers is due, without scanning all of them.
+/**
+ * The timers are kept in a min-heap ordered by the time of their next call, so scheduling a
+ * timer costs O(log n) and finding the next one due is O(1), whatever the number of timers.
+ * A dedicated thread sleeps until the timer at the top of the heap is due, moves it to a list
+ * of ready timers and calls the on ready callback, which is expected to wake up an executor.
+ * The executor then calls execute_ready_timers(), which runs the callbacks of the ready timers
+ * on its own thread and puts them back into the heap.
+ *
+ * The heap is keyed by the steady clock, so only timers using the steady clock should be
+ * managed, timers following ROS time may jump with simulated time.
+ * Resetting a timer only moves its next call later, the heap entry is corrected when it
+ * reaches the top.
+ * Canceled timers are set aside, and put back into the heap once they have been reset, the
+ * managed timers wake up the thread when they are reset, see TimerBase::set_on_reset_callback().
+ *
+ * All public member functions are thread-safe, except that execute_ready_timers() must only
+ * be called by one thread at a time.
+ */
+class TimersManager
+{
+public:
+  RCLCPP_SMART_PTR_DEFINITIONS_NOT_COPYABLE(TimersManager)
+
+  /// Constructor.
+  /**
+   * \param on_ready_callback called by the timers thread when ready timers are waiting to be
+   *   executed, it is not called again until execute_ready_timers() has run
+   */
+  RCLCPP_PUBLIC
+  explicit TimersManager(std::function<void()> on_ready_callback);
+
+  /// Destructor, stops the timers thread if it is running.
+  RCLCPP_PUBLIC
+  virtual ~TimersManager();
+
+  /// Replace the managed timers.
+  /**
+   * The heap is rebuilt from the current state of the timers.
+   * Timers which are ready but not yet executed stay ready if they are still managed.
+   * The on reset callback of the managed timers is set, and cleared for the timers which are
+   * no longer managed.
+   *
+   * \param timers the timers to manage
+   */
+  RCLCPP_PUBLIC
+  void
+  set_timers(const std::vector<rclcpp::TimerBase::WeakPtr> & timers);
+
+  /// Start the thread watching the timers.
+  /**
+   * \throws std::runtime_error if the thread is already running
+   */
+  RCLCPP_PUBLIC
+  void
+  start();
+
+  /// Stop the thread watching the timers and wait for it to exit.
+  RCLCPP_PUBLIC
+  void
+  stop();
+
+  /// Execute the callbacks of the ready timers and schedule them again.
+  /**
+   * This is meant to be called by the executor after the on ready callback was called.
+   * Timers which are no longer ready, e.g. because they were reset, are only scheduled again.
+   */
+  RCLCPP_PUBLIC
+  void
+  execute_ready_timers();
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  struct TimerEntry
+  {
+    Clock::time_point next_call;
+    rclcpp::TimerBase::WeakPtr timer;
+  };
+
+  /// Comparison building a min-heap with the std heap functions.
+  static bool
+  later(const TimerEntry & lhs, const TimerEntry & rhs)
+  {
+    return lhs.next_call > rhs.next_call;
+  }
+
+  /// Thread loop, moves timers from the heap to the ready list when they are due.
+  void
+  run_timers();
+
+  /// Compute the next call of a timer and push it into the heap, or set it aside if canceled.
+  void
+  schedule_timer_unsafe(const rclcpp::TimerBase::SharedPtr & timer, Clock::time_point now);
+
+  /// Put back into the heap the canceled timers which have been reset since.
+  void
+  reschedule_canceled_timers_unsafe(Clock::time_point now);
+
+  /// Wake up the thread, so that it notices a canceled timer which has been reset.
+  void
+  on_timer_reset();
+
+  std::function<void()> on_ready_callback_;
+
+  std::mutex mutex_;
+  std::condition_variable timers_cv_;
+  std::thread timers_thread_;
+  std::atomic_bool running_{false};
+
+  /// Timers waiting for their next call, the one due first is at the front.
+  std::vector<TimerEntry> heap_;
+  /// All the managed timers, whose on reset callback is set.
+  std::vector<rclcpp::TimerBase::WeakPtr> timers_;
+  /// Due timers waiting for execute_ready_timers().
+  std::vector<rclcpp::TimerBase::WeakPtr> ready_timers_;
+  /// Ready timers being executed, reused to avoid allocating on each call.
+  std::vector<rclcpp::TimerBase::WeakPtr> executing_timers_;
+  std::vector<rclcpp::TimerBase::WeakPtr> canceled_timers_;
+  /// Incremented by set_timers(), which schedules timers being executed itself.
+  uint64_t timers_generation_{0u};
+};
+
+}  // namespace experimental
+}  // namespace rclcpp
+
+#endif  // RCLCPP__EXPERIMENTAL__TIMERS_MANAGER_HPP_
@@ -23,6 +23,12 @@ namespace rclcpp
 enum class IntraProcessBufferType
 {
   /// Set the data type used in the intra-process buffer as std::shared_ptr<MessageT>
+  /**
+   * All the subscriptions with this buffer type share a single immutable instance of each
+   * message, whatever their callback type.
+   * Callbacks requiring ownership get a copy when the message is taken, unless no one else
+   * holds the message anymore, in which case its content is moved instead.
+   */
   SharedPtr,
   /// Set the data type used in the intra-process buffer as std::unique_ptr<MessageT>
   UniquePtr,
@@ -30,6 +36,16 @@ enum class IntraProcessBufferType
   CallbackDefault
 };
 
+/// Used as argument in create_subscription when intra-process communication is enabled
+/// to select how the intra-process buffer is implemented
+enum class IntraProcessBufferImplementation
+{
+  /// Ring buffer guarded by a mutex
+  RingBuffer,
+  /// Ring buffer which publishers and the executor can use concurrently without locking
+  LockFreeRingBuffer
+};
+
 }  // namespace rclcpp
 
 #endif  // RCLCPP__INTRA_PROCESS_BUFFER_TYPE_HPP_
@@ -23,6 +23,7 @@
 #include <memory>
 #include <sstream>
 #include <string>
+#include <type_traits>
 #include <utility>
 
 #include "rcl/error_handling.h"
@@ -242,6 +243,11 @@ public:
    * after being published.
    * The instance of the loaned message is no longer valid after this call.
    *
+   * With intra-process communication enabled, a message allocated by this publisher is
+   * handed to the intra-process subscriptions without being copied.
+   * A message loaned by the middleware has to be returned to it, so it is copied once for the
+   * intra-process subscriptions instead.
+   *
    * \param loaned_msg The LoanedMessage instance to be published.
    */
   void
@@ -251,8 +257,8 @@ public:
       throw std::runtime_error("loaned message is not valid");
     }
     if (intra_process_is_enabled_) {
-      // TODO(Karsten1987): support loaned message passed by intraprocess
-      throw std::runtime_error("storing loaned messages in intra process is not supported yet");
+      this->do_intra_process_loaned_message_publish(std::move(loaned_msg));
+      return;
     }
 
     // verify that publisher supports loaned messages
@@ -353,6 +359,35 @@ protected:
       message_allocator_);
   }
 
+  void
+  do_intra_process_loaned_message_publish(
+    rclcpp::LoanedMessage<MessageT, AllocatorT> && loaned_msg)
+  {
+    if constexpr (std::is_same<MessageDeleter, std::default_delete<MessageT>>::value) {
+      if (!this->can_loan_messages()) {
+        // The message was allocated locally with std::allocator, which the deleter of this
+        // publisher matches, so its ownership can be transferred.
+        this->publish(MessageUniquePtr(loaned_msg.release().release()));
+        return;
+      }
+    }
+
+    bool inter_process_publish_needed =
+      get_subscription_count() > get_intra_process_subscription_count();
+
+    auto ptr = MessageAllocatorTraits::allocate(*message_allocator_.get(), 1);
+    MessageAllocatorTraits::construct(*message_allocator_.get(), ptr, loaned_msg.get());
+    this->do_intra_process_publish(MessageUniquePtr(ptr, message_deleter_));
+
+    if (inter_process_publish_needed) {
+      if (this->can_loan_messages()) {
+        this->do_loaned_message_publish(std::move(loaned_msg.release()));
+      } else {
+        this->do_inter_process_publish(loaned_msg.get());
+      }
+    }
+  }
+
   std::shared_ptr<const MessageT>
   do_intra_process_publish_and_return_shared(std::unique_ptr<MessageT, MessageDeleter> msg)
   {
@@ -75,10 +75,16 @@
  *   - rclcpp::executors::MultiThreadedExecutor
  *   - rclcpp::executors::MultiThreadedExecutor::add_node()
  *   - rclcpp::executors::MultiThreadedExecutor::spin()
+ *   - rclcpp::executors::WorkStealingExecutor
+ *   - rclcpp::executors::WorkStealingExecutor::spin()
+ *   - rclcpp::executors::EventsExecutor
+ *   - rclcpp::executors::EventsExecutor::spin()
  *   - rclcpp/executor.hpp
  *   - rclcpp/executors.hpp
  *   - rclcpp/executors/single_threaded_executor.hpp
  *   - rclcpp/executors/multi_threaded_executor.hpp
+ *   - rclcpp/executors/work_stealing_executor.hpp
+ *   - rclcpp/executors/events_executor.hpp
  * - CallbackGroups (mechanism for enforcing concurrency rules for callbacks):
  *   - rclcpp::Node::create_callback_group()
  *   - rclcpp::CallbackGroup
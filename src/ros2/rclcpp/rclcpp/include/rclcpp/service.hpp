@@ -19,6 +19,7 @@
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
 
@@ -121,6 +122,34 @@ public:
   bool
   exchange_in_use_by_wait_set_state(bool in_use_state);
 
+  /// Set a callback to be called when each new request is received.
+  /**
+   * The callback receives the number of requests received since it was last called.
+   * That is usually one, but can be more when requests were received while no callback was
+   * set, in which case the callback is called once right away with their number.
+   *
+   * The callback is called from a middleware thread, so it should return quickly and must not
+   * take from this service itself; it is meant to notify an executor that there is work.
+   * Exceptions thrown from the callback are caught and logged.
+   *
+   * Calling this again replaces the previous callback.
+   * The callback is cleared when the service is destroyed.
+   *
+   * \sa rcl_service_set_on_new_request_callback
+   * \param[in] callback functor to be called when a new request is received
+   * \throws std::invalid_argument if the callback is empty
+   * \throws rclcpp::exceptions::RCLError based exceptions if the underlying rcl call fails,
+   *   e.g. if the middleware does not support these callbacks
+   */
+  RCLCPP_PUBLIC
+  void
+  set_on_new_request_callback(std::function<void(size_t)> callback);
+
+  /// Unset the callback registered for new requests, if any.
+  RCLCPP_PUBLIC
+  void
+  clear_on_new_request_callback();
+
 protected:
   RCLCPP_DISABLE_COPY(ServiceBase)
 
@@ -138,6 +167,10 @@ protected:
   bool owns_rcl_handle_ = true;
 
   std::atomic<bool> in_use_by_wait_set_{false};
+
+  std::mutex on_new_request_callback_mutex_;
+  /// The callback registered with rcl, heap allocated so its address stays valid.
+  std::unique_ptr<std::function<void(size_t)>> on_new_request_callback_;
 };
 
 template<typename ServiceT>
@@ -203,7 +203,7 @@ public:
 
   bool add_handles_to_wait_set(rcl_wait_set_t * wait_set) override
   {
-    for (auto subscription : subscription_handles_) {
+    for (const auto & subscription : subscription_handles_) {
       if (rcl_wait_set_add_subscription(wait_set, subscription.get(), NULL) != RCL_RET_OK) {
         RCUTILS_LOG_ERROR_NAMED(
           "rclcpp",
@@ -212,7 +212,7 @@ public:
       }
     }
 
-    for (auto client : client_handles_) {
+    for (const auto & client : client_handles_) {
       if (rcl_wait_set_add_client(wait_set, client.get(), NULL) != RCL_RET_OK) {
         RCUTILS_LOG_ERROR_NAMED(
           "rclcpp",
@@ -221,7 +221,7 @@ public:
       }
     }
 
-    for (auto service : service_handles_) {
+    for (const auto & service : service_handles_) {
       if (rcl_wait_set_add_service(wait_set, service.get(), NULL) != RCL_RET_OK) {
         RCUTILS_LOG_ERROR_NAMED(
           "rclcpp",
@@ -230,7 +230,7 @@ public:
       }
     }
 
-    for (auto timer : timer_handles_) {
+    for (const auto & timer : timer_handles_) {
       if (rcl_wait_set_add_timer(wait_set, timer.get(), NULL) != RCL_RET_OK) {
         RCUTILS_LOG_ERROR_NAMED(
           "rclcpp",
@@ -239,7 +239,7 @@ public:
       }
     }
 
-    for (auto guard_condition : guard_conditions_) {
+    for (const auto & guard_condition : guard_conditions_) {
       if (rcl_wait_set_add_guard_condition(wait_set, guard_condition, NULL) != RCL_RET_OK) {
         RCUTILS_LOG_ERROR_NAMED(
           "rclcpp",
@@ -249,7 +249,7 @@ public:
       }
     }
 
-    for (auto waitable : waitable_handles_) {
+    for (const auto & waitable : waitable_handles_) {
       if (!waitable->add_to_wait_set(wait_set)) {
         RCUTILS_LOG_ERROR_NAMED(
           "rclcpp",
@@ -25,6 +25,7 @@
 #include <sstream>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "rcl/error_handling.h"
 #include "rcl/subscription.h"
@@ -118,6 +119,11 @@ public:
     options_(options),
     message_memory_strategy_(message_memory_strategy)
   {
+    if (options.take_batch_size == 0u) {
+      throw std::invalid_argument("take_batch_size must be a positive, non-zero value");
+    }
+    this->take_batch_size_ = options.take_batch_size;
+
     if (options.event_callbacks.deadline_callback) {
       this->add_event_handler(
         options.event_callbacks.deadline_callback,
@@ -177,7 +183,8 @@ public:
         context,
         this->get_topic_name(),  // important to get like this, as it has the fully-qualified name
         qos_profile,
-        resolve_intra_process_buffer_type(options.intra_process_buffer_type, callback));
+        resolve_intra_process_buffer_type(options.intra_process_buffer_type, callback),
+        options.intra_process_buffer_implementation);
       TRACEPOINT(
         rclcpp_subscription_init,
         static_cast<const void *>(get_subscription_handle().get()),
@@ -290,6 +297,53 @@ public:
     }
   }
 
+  void
+  handle_message_sequence(TakeSequenceStorage & storage, size_t count) override
+  {
+    if (!any_callback_.is_batch_callback()) {
+      SubscriptionBase::handle_message_sequence(storage, count);
+      return;
+    }
+    auto & typed_storage = static_cast<TypedTakeSequenceStorage &>(storage);
+    typed_storage.callback_messages.clear();
+    typed_storage.callback_message_infos.clear();
+    for (size_t i = 0u; i < count; ++i) {
+      const rclcpp::MessageInfo & message_info = storage.message_infos[i];
+      const rmw_gid_t & publisher_gid = message_info.get_rmw_message_info().publisher_gid;
+      if (matches_any_intra_process_publishers(&publisher_gid)) {
+        // In this case, the message will be delivered via intra process and
+        // we should ignore this copy of the message.
+        continue;
+      }
+      typed_storage.callback_messages.push_back(
+        std::static_pointer_cast<const CallbackMessageT>(storage.messages[i]));
+      typed_storage.callback_message_infos.push_back(message_info);
+    }
+    if (typed_storage.callback_messages.empty()) {
+      return;
+    }
+
+    std::chrono::time_point<std::chrono::system_clock> now;
+    if (subscription_topic_statistics_) {
+      // get current time before executing callback to
+      // exclude callback duration from topic statistics result.
+      now = std::chrono::system_clock::now();
+    }
+
+    any_callback_.dispatch_batch(
+      typed_storage.callback_messages, typed_storage.callback_message_infos);
+
+    if (subscription_topic_statistics_) {
+      const auto nanos = std::chrono::time_point_cast<std::chrono::nanoseconds>(now);
+      const auto time = rclcpp::Time(nanos.time_since_epoch().count());
+      for (const auto & message : typed_storage.callback_messages) {
+        subscription_topic_statistics_->handle_message(*message, time);
+      }
+    }
+    // Drop these references, so that the messages can be reused for the next take.
+    typed_storage.callback_messages.clear();
+  }
+
   void
   handle_loaned_message(
     void * loaned_message,
@@ -329,6 +383,20 @@ public:
     return any_callback_.use_take_shared_method();
   }
 
+protected:
+  /// Storage for taking messages in batches, with room to hand them to a batch callback.
+  struct TypedTakeSequenceStorage : public TakeSequenceStorage
+  {
+    std::vector<std::shared_ptr<const CallbackMessageT>> callback_messages;
+    std::vector<rclcpp::MessageInfo> callback_message_infos;
+  };
+
+  std::unique_ptr<TakeSequenceStorage>
+  create_take_sequence_storage() override
+  {
+    return std::make_unique<TypedTakeSequenceStorage>();
+  }
+
 private:
   RCLCPP_DISABLE_COPY(Subscription)
 
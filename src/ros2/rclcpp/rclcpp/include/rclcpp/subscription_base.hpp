@@ -16,7 +16,9 @@
 #define RCLCPP__SUBSCRIPTION_BASE_HPP_
 
 #include <atomic>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -62,6 +64,28 @@ class SubscriptionBase : public std::enable_shared_from_this<SubscriptionBase>
 public:
   RCLCPP_SMART_PTR_DEFINITIONS_NOT_COPYABLE(SubscriptionBase)
 
+  /// Messages and message infos into which several messages are taken at once.
+  /**
+   * The messages are lent by the message memory strategy and kept from one take to the next,
+   * so that taking a batch does not allocate, and messages with unbounded fields keep their
+   * capacity.
+   *
+   * \sa take_type_erased_sequence()
+   */
+  struct TakeSequenceStorage
+  {
+    RCLCPP_PUBLIC
+    virtual ~TakeSequenceStorage();
+
+    /// Messages lent by the message memory strategy, the taken ones first.
+    std::vector<std::shared_ptr<void>> messages;
+    /// Message infos of the taken messages.
+    std::vector<rclcpp::MessageInfo> message_infos;
+    /// Scratch space for rcl_take_sequence().
+    std::vector<void *> message_ptrs;
+    std::vector<rmw_message_info_t> rmw_message_infos;
+  };
+
   /// Constructor.
   /**
    * This accepts rcl_subscription_options_t instead of rclcpp::SubscriptionOptions because
@@ -141,6 +165,48 @@ public:
   bool
   take_type_erased(void * message_out, rclcpp::MessageInfo & message_info_out);
 
+  /// Take several inter-process messages at once as type erased pointers.
+  /**
+   * Up to get_take_batch_size() messages are taken with a single call to rcl_take_sequence().
+   * They are taken into the messages in `storage`, which are borrowed with create_message() as
+   * needed. A message that is still referenced elsewhere, e.g. because a callback kept it, is
+   * returned with return_message() and replaced rather than overwritten.
+   *
+   * On return, the messages which were taken are at the front of `storage.messages`, in the
+   * order in which they were received, and `storage.message_infos` holds their message infos.
+   * Unlike take_type_erased(), messages from intra-process publishers are not filtered out
+   * here, SubscriptionBase::handle_message_sequence() ignores them.
+   *
+   * \param[inout] storage The messages into which take will copy the data, and their infos.
+   * \returns the number of messages taken
+   * \throws any rcl errors from rcl_take_sequence, \sa rclcpp::exceptions::throw_from_rcl_error()
+   */
+  RCLCPP_PUBLIC
+  size_t
+  take_type_erased_sequence(TakeSequenceStorage & storage);
+
+  /// Borrow the storage of this subscription for take_type_erased_sequence().
+  /**
+   * The storage is kept by the subscription between takes.  If it is already borrowed, e.g. by
+   * another thread of a multi-threaded executor, a new one is created.
+   */
+  RCLCPP_PUBLIC
+  std::unique_ptr<TakeSequenceStorage>
+  borrow_take_sequence_storage();
+
+  /// Return the storage borrowed with borrow_take_sequence_storage().
+  RCLCPP_PUBLIC
+  void
+  return_take_sequence_storage(std::unique_ptr<TakeSequenceStorage> storage);
+
+  /// Get the maximum number of messages taken from the middleware each time data is available.
+  /**
+   * \sa rclcpp::SubscriptionOptionsBase::take_batch_size
+   */
+  RCLCPP_PUBLIC
+  size_t
+  get_take_batch_size() const;
+
   /// Take the next inter-process message, in its serialized form, from the subscription.
   /**
    * For now, if data is taken (written) into the message_out and
@@ -188,6 +254,18 @@ public:
   void
   handle_loaned_message(void * loaned_message, const rclcpp::MessageInfo & message_info) = 0;
 
+  /// Handle the messages taken with take_type_erased_sequence().
+  /**
+   * The default implementation calls handle_message() for each message.
+   *
+   * \param[in] storage The storage passed to take_type_erased_sequence().
+   * \param[in] count The number of messages taken.
+   */
+  RCLCPP_PUBLIC
+  virtual
+  void
+  handle_message_sequence(TakeSequenceStorage & storage, size_t count);
+
   /// Return the message borrowed in create_message.
   /** \param[in] message Shared pointer to the returned message. */
   RCLCPP_PUBLIC
@@ -276,6 +354,34 @@ public:
   std::vector<rclcpp::NetworkFlowEndpoint>
   get_network_flow_endpoints() const;
 
+  /// Set a callback to be called when each new message is received.
+  /**
+   * The callback receives the number of messages received since it was last called.
+   * That is usually one, but can be more when messages were received while no callback was
+   * set, in which case the callback is called once right away with their number.
+   *
+   * The callback is called from a middleware thread, so it should return quickly and must not
+   * take from this subscription itself; it is meant to notify an executor that there is work.
+   * Exceptions thrown from the callback are caught and logged.
+   *
+   * Calling this again replaces the previous callback.
+   * The callback is cleared when the subscription is destroyed.
+   *
+   * \sa rcl_subscription_set_on_new_message_callback
+   * \param[in] callback functor to be called when a new message is received
+   * \throws std::invalid_argument if the callback is empty
+   * \throws rclcpp::exceptions::RCLError based exceptions if the underlying rcl call fails,
+   *   e.g. if the middleware does not support these callbacks
+   */
+  RCLCPP_PUBLIC
+  void
+  set_on_new_message_callback(std::function<void(size_t)> callback);
+
+  /// Unset the callback registered for new messages, if any.
+  RCLCPP_PUBLIC
+  void
+  clear_on_new_message_callback();
+
 protected:
   template<typename EventCallbackT>
   void
@@ -312,6 +418,14 @@ protected:
   IntraProcessManagerWeakPtr weak_ipm_;
   uint64_t intra_process_subscription_id_;
 
+  size_t take_batch_size_;
+
+  /// Create the storage lent by borrow_take_sequence_storage().
+  RCLCPP_PUBLIC
+  virtual
+  std::unique_ptr<TakeSequenceStorage>
+  create_take_sequence_storage();
+
 private:
   RCLCPP_DISABLE_COPY(SubscriptionBase)
 
@@ -322,6 +436,13 @@ private:
   std::atomic<bool> intra_process_subscription_waitable_in_use_by_wait_set_{false};
   std::unordered_map<rclcpp::QOSEventHandlerBase *,
     std::atomic<bool>> qos_events_in_use_by_wait_set_;
+
+  std::mutex take_sequence_storage_mutex_;
+  std::unique_ptr<TakeSequenceStorage> take_sequence_storage_;
+
+  std::mutex on_new_message_callback_mutex_;
+  /// The callback registered with rcl, heap allocated so its address stays valid.
+  std::unique_ptr<std::function<void(size_t)>> on_new_message_callback_;
 };
 
 }  // namespace rclcpp
@@ -59,6 +59,14 @@ struct SubscriptionOptionsBase
   /// Setting the data-type stored in the intraprocess buffer
   IntraProcessBufferType intra_process_buffer_type = IntraProcessBufferType::CallbackDefault;
 
+  /// Setting the implementation of the intraprocess buffer
+  IntraProcessBufferImplementation intra_process_buffer_implementation =
+    IntraProcessBufferImplementation::RingBuffer;
+
+  /// Maximum number of messages taken from the middleware at once, each time data is available.
+  /// The message memory strategy must be able to lend that many messages at the same time.
+  size_t take_batch_size = 1u;
+
   /// Optional RMW implementation specific payload to be used during creation of the subscription.
   std::shared_ptr<rclcpp::detail::RMWImplementationSpecificSubscriptionPayload>
   rmw_implementation_payload = nullptr;
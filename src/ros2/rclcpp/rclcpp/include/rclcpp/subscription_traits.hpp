@@ -16,6 +16,7 @@
 #define RCLCPP__SUBSCRIPTION_TRAITS_HPP_
 
 #include <memory>
+#include <vector>
 
 #include "rclcpp/function_traits.hpp"
 #include "rclcpp/serialized_message.hpp"
@@ -75,6 +76,17 @@ template<typename MessageT, typename Deleter>
 struct extract_message_type<std::unique_ptr<MessageT, Deleter>>: extract_message_type<MessageT>
 {};
 
+// Batch callbacks, see rclcpp::SubscriptionOptionsBase::take_batch_size
+template<typename MessageT, typename AllocatorT>
+struct extract_message_type<std::vector<std::shared_ptr<MessageT>, AllocatorT>>
+  : extract_message_type<MessageT>
+{};
+
+template<typename MessageT, typename AllocatorT>
+struct extract_message_type<const std::vector<std::shared_ptr<MessageT>, AllocatorT> &>
+  : extract_message_type<MessageT>
+{};
+
 template<
   typename CallbackT,
   typename AllocatorT = std::allocator<void>,
@@ -19,6 +19,7 @@
 #include <chrono>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <thread>
 #include <type_traits>
@@ -91,6 +92,34 @@ public:
   void
   reset();
 
+  /// Set a callback to be called each time the timer is reset.
+  /**
+   * This lets whoever waits for the timer on its own, e.g. a
+   * rclcpp::experimental::TimersManager, notice that a canceled timer runs again.
+   *
+   * The callback is called by reset(), on the thread resetting the timer, with an internal
+   * lock held, so it should return quickly and must not set or clear the callback itself.
+   * Calling this again replaces the previous callback, so the owner identifies who set the
+   * callback, and lets it clear only its own callback later on.
+   *
+   * \param[in] callback functor to be called when the timer is reset
+   * \param[in] owner whoever sets the callback, or nullptr
+   * \throws std::invalid_argument if the callback is empty
+   */
+  RCLCPP_PUBLIC
+  void
+  set_on_reset_callback(std::function<void()> callback, const void * owner = nullptr);
+
+  /// Unset the callback registered with set_on_reset_callback().
+  /**
+   * Once this returns, the callback is not being called and will not be called anymore.
+   *
+   * \param[in] owner if not nullptr, the callback is only unset if it was set with this owner
+   */
+  RCLCPP_PUBLIC
+  void
+  clear_on_reset_callback(const void * owner = nullptr);
+
   /// Call the callback function when the timer signal is emitted.
   RCLCPP_PUBLIC
   virtual void
@@ -142,6 +171,10 @@ protected:
   std::shared_ptr<rcl_timer_t> timer_handle_;
 
   std::atomic<bool> in_use_by_wait_set_{false};
+
+  std::mutex on_reset_callback_mutex_;
+  std::function<void()> on_reset_callback_;
+  const void * on_reset_callback_owner_ = nullptr;
 };
 
 
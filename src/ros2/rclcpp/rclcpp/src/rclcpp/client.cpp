@@ -19,10 +19,12 @@
 #include <cstdio>
 #include <memory>
 #include <string>
+#include <utility>
 
 #include "rcl/graph.h"
 #include "rcl/node.h"
 #include "rcl/wait.h"
+#include "rclcpp/detail/cpp_callback_trampoline.hpp"
 #include "rclcpp/exceptions.hpp"
 #include "rclcpp/node_interfaces/node_base_interface.hpp"
 #include "rclcpp/node_interfaces/node_graph_interface.hpp"
@@ -66,6 +68,14 @@ ClientBase::ClientBase(
 
 ClientBase::~ClientBase()
 {
+  try {
+    clear_on_new_response_callback();
+  } catch (const std::exception & exception) {
+    RCLCPP_ERROR(
+      rclcpp::get_node_logger(node_handle_.get()).get_child("rclcpp"),
+      "Error clearing the on new response callback of client: %s", exception.what());
+  }
+
   // Make sure the client handle is destructed as early as possible and before the node handle
   client_handle_.reset();
 }
@@ -198,3 +208,56 @@ ClientBase::exchange_in_use_by_wait_set_state(bool in_use_state)
 {
   return in_use_by_wait_set_.exchange(in_use_state);
 }
+
+void
+ClientBase::set_on_new_response_callback(std::function<void(size_t)> callback)
+{
+  if (!callback) {
+    throw std::invalid_argument(
+            "The callback passed to set_on_new_response_callback is not callable.");
+  }
+
+  // The callback is called from C code in the middleware, exceptions must not escape it.
+  auto new_callback = std::make_unique<std::function<void(size_t)>>(
+    [callback, logger = rclcpp::get_node_logger(node_handle_.get()).get_child("rclcpp"),
+    service_name = std::string(get_service_name())](size_t number_of_responses) {
+      try {
+        callback(number_of_responses);
+      } catch (const std::exception & exception) {
+        RCLCPP_ERROR(
+          logger,
+          "Exception thrown from the on new response callback of client for service '%s': %s",
+          service_name.c_str(), exception.what());
+      } catch (...) {
+        RCLCPP_ERROR(
+          logger,
+          "Unknown exception thrown from the on new response callback of client for service '%s'",
+          service_name.c_str());
+      }
+    });
+
+  std::lock_guard<std::mutex> lock(on_new_response_callback_mutex_);
+  rcl_ret_t ret = rcl_client_set_on_new_response_callback(
+    client_handle_.get(),
+    rclcpp::detail::cpp_callback_trampoline<const void *, size_t>,
+    new_callback.get());
+  if (RCL_RET_OK != ret) {
+    rclcpp::exceptions::throw_from_rcl_error(ret, "failed to set the on new response callback");
+  }
+  // The middleware calls the new callback from now on, so the previous one can be released.
+  on_new_response_callback_ = std::move(new_callback);
+}
+
+void
+ClientBase::clear_on_new_response_callback()
+{
+  std::lock_guard<std::mutex> lock(on_new_response_callback_mutex_);
+  if (!on_new_response_callback_) {
+    return;
+  }
+  rcl_ret_t ret = rcl_client_set_on_new_response_callback(client_handle_.get(), nullptr, nullptr);
+  if (RCL_RET_OK != ret) {
+    rclcpp::exceptions::throw_from_rcl_error(ret, "failed to clear the on new response callback");
+  }
+  on_new_response_callback_.reset();
+}
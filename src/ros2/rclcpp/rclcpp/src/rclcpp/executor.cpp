@@ -537,20 +537,24 @@ Executor::execute_any_executable(AnyExecutable & any_exec)
   }
 }
 
+// The actions are taken as template parameters rather than std::function, because the lambdas
+// passed by the execute_* functions capture too much to avoid a heap allocation per call.
+template<typename TakeActionT, typename HandleActionT>
 static
 void
 take_and_do_error_handling(
   const char * action_description,
   const char * topic_or_service_name,
-  std::function<bool()> take_action,
-  std::function<void()> handle_action)
+  TakeActionT && take_action,
+  HandleActionT && handle_action)
 {
+  static const rclcpp::Logger logger = rclcpp::get_logger("rclcpp");
   bool taken = false;
   try {
     taken = take_action();
   } catch (const rclcpp::exceptions::RCLError & rcl_error) {
     RCLCPP_ERROR(
-      rclcpp::get_logger("rclcpp"),
+      logger,
       "executor %s '%s' unexpectedly failed: %s",
       action_description,
       topic_or_service_name,
@@ -566,7 +570,7 @@ take_and_do_error_handling(
     // spurious wake up and an entity actually having data until trying
     // to take the data.
     RCLCPP_DEBUG(
-      rclcpp::get_logger("rclcpp"),
+      logger,
       "executor %s '%s' failed to take anything",
       action_description,
       topic_or_service_name);
@@ -630,6 +634,23 @@ Executor::execute_subscription(rclcpp::SubscriptionBase::SharedPtr subscription)
       }
       loaned_msg = nullptr;
     }
+  } else if (subscription->get_take_batch_size() > 1u) {
+    // This case is taking copies of several messages from the middleware via
+    // inter-process communication at once, so that a backlog of messages is
+    // handled without waiting again for each of them.
+    // The messages are kept by the subscription from one batch to the next.
+    auto storage = subscription->borrow_take_sequence_storage();
+    size_t taken = 0u;
+    take_and_do_error_handling(
+      "taking messages from topic",
+      subscription->get_topic_name(),
+      [&]()
+      {
+        taken = subscription->take_type_erased_sequence(*storage);
+        return taken > 0u;
+      },
+      [&]() {subscription->handle_message_sequence(*storage, taken);});
+    subscription->return_take_sequence_storage(std::move(storage));
   } else {
     // This case is taking a copy of the message data from the middleware via
     // inter-process communication.
@@ -0,0 +1,691 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rclcpp/executors/events_executor.hpp"
+
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "rcl/error_handling.h"
+
+#include "rclcpp/exceptions.hpp"
+#include "rclcpp/logging.hpp"
+#include "rclcpp/node.hpp"
+#include "rclcpp/scope_exit.hpp"
+#include "rclcpp/utilities.hpp"
+
+using rclcpp::exceptions::throw_from_rcl_error;
+using rclcpp::executors::EventsExecutor;
+
+/// Event bookkeeping of a subscription, service or client, exactly one of which is set.
+struct EventsExecutor::EntityEvents
+{
+  uint64_t key{0u};
+  /// Number of events reported by the middleware which have not been executed yet.
+  /**
+   * The entity is queued only when this goes from zero to non-zero, so a burst of messages
+   * costs a single queue slot.
+   */
+  std::atomic_size_t pending{0u};
+  rclcpp::SubscriptionBase::WeakPtr subscription;
+  rclcpp::ServiceBase::WeakPtr service;
+  rclcpp::ClientBase::WeakPtr client;
+};
+
+namespace
+{
+
+/// Return the address of the entity, or nullptr if it was destroyed.
+template<typename EntityEventsT>
+const void *
+get_entity_address(const EntityEventsT & events)
+{
+  if (auto subscription = events.subscription.lock()) {
+    return subscription.get();
+  }
+  if (auto service = events.service.lock()) {
+    return service.get();
+  }
+  if (auto client = events.client.lock()) {
+    return client.get();
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+EventsExecutor::EventsExecutor(
+  const rclcpp::ExecutorOptions & options,
+  size_t events_queue_capacity)
+: rclcpp::Executor(options),
+  events_queue_(events_queue_capacity)
+{
+  timers_manager_ = std::make_unique<rclcpp::experimental::TimersManager>(
+    [this]() {this->push_event(timers_key_);});
+
+  rcl_ret_t ret = rcl_wait_set_init(
+    &events_wait_set_,
+    0, 2, 0, 0, 0, 0,
+    context_->get_rcl_context().get(),
+    rcl_get_default_allocator());
+  if (RCL_RET_OK != ret) {
+    throw_from_rcl_error(ret, "Failed to create wait set in EventsExecutor constructor");
+  }
+}
+
+EventsExecutor::~EventsExecutor()
+{
+  // Only entities still associated with this executor can be left here, the others may notify
+  // another executor by now.
+  try {
+    release_entities();
+  } catch (const std::exception & exception) {
+    RCLCPP_ERROR(
+      rclcpp::get_logger("rclcpp"),
+      "failed to clear an event callback in EventsExecutor destructor: %s", exception.what());
+  }
+
+  if (rcl_wait_set_fini(&events_wait_set_) != RCL_RET_OK) {
+    RCLCPP_ERROR(
+      rclcpp::get_logger("rclcpp"),
+      "failed to destroy wait set: %s", rcl_get_error_string().str);
+    rcl_reset_error();
+  }
+}
+
+void
+EventsExecutor::spin()
+{
+  if (spinning.exchange(true)) {
+    throw std::runtime_error("spin() called while already spinning");
+  }
+  RCLCPP_SCOPE_EXIT(this->spinning.store(false); );
+
+  wait_set_result_pending_ = false;
+  wait_set_result_ = WaitSetResult();
+  // The entities may be spun by another executor before this one spins again.
+  RCLCPP_SCOPE_EXIT(
+  {
+    this->timers_manager_->set_timers({});
+    this->release_entities();
+  });
+  refresh_entities();
+
+  wait_set_thread_running_.store(true);
+  std::thread wait_set_thread(&EventsExecutor::run_wait_set, this);
+  RCLCPP_SCOPE_EXIT(
+  {
+    this->stop_wait_set_thread();
+    wait_set_thread.join();
+  });
+  timers_manager_->start();
+  RCLCPP_SCOPE_EXIT(this->timers_manager_->stop(); );
+
+  while (rclcpp::ok(this->context_) && spinning.load()) {
+    wait_for_events();
+    execute_events();
+  }
+}
+
+void
+EventsExecutor::remove_callback_group(
+  rclcpp::CallbackGroup::SharedPtr group_ptr,
+  bool notify)
+{
+  rclcpp::Executor::remove_callback_group(group_ptr, notify);
+  release_removed_entities();
+}
+
+void
+EventsExecutor::remove_node(
+  rclcpp::node_interfaces::NodeBaseInterface::SharedPtr node_ptr,
+  bool notify)
+{
+  rclcpp::Executor::remove_node(node_ptr, notify);
+  release_removed_entities();
+}
+
+void
+EventsExecutor::remove_node(std::shared_ptr<rclcpp::Node> node_ptr, bool notify)
+{
+  this->remove_node(node_ptr->get_node_base_interface(), notify);
+}
+
+std::vector<rclcpp::CallbackGroup::SharedPtr>
+EventsExecutor::get_associated_groups(std::vector<const rcl_guard_condition_t *> * guard_conditions)
+{
+  std::vector<rclcpp::CallbackGroup::SharedPtr> groups;
+  std::lock_guard<std::mutex> guard{mutex_};
+  add_callback_groups_from_nodes_associated_to_executor();
+  for (const auto & pair : weak_groups_to_nodes_) {
+    auto group = pair.first.lock();
+    if (group) {
+      groups.push_back(group);
+    }
+  }
+  if (guard_conditions) {
+    for (const auto & pair : weak_nodes_to_guard_conditions_) {
+      guard_conditions->push_back(pair.second);
+    }
+  }
+  return groups;
+}
+
+void
+EventsExecutor::release_removed_entities()
+{
+  std::lock_guard<std::mutex> lock(entities_mutex_);
+  std::unordered_set<const void *> associated;
+  for (const auto & group : get_associated_groups(nullptr)) {
+    group->find_subscription_ptrs_if(
+      [&associated](const rclcpp::SubscriptionBase::SharedPtr & subscription) {
+        associated.insert(subscription.get());
+        return false;
+      });
+    group->find_service_ptrs_if(
+      [&associated](const rclcpp::ServiceBase::SharedPtr & service) {
+        associated.insert(service.get());
+        return false;
+      });
+    group->find_client_ptrs_if(
+      [&associated](const rclcpp::ClientBase::SharedPtr & client) {
+        associated.insert(client.get());
+        return false;
+      });
+  }
+  for (auto it = entities_.begin(); it != entities_.end(); ) {
+    if (associated.count(get_entity_address(*it->second)) == 0u) {
+      clear_callback(*it->second);
+      it = entities_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void
+EventsExecutor::release_entities()
+{
+  std::lock_guard<std::mutex> lock(entities_mutex_);
+  for (const auto & pair : entities_) {
+    clear_callback(*pair.second);
+  }
+  entities_.clear();
+}
+
+void
+EventsExecutor::refresh_entities()
+{
+  // Held throughout, so that entities removed from the executor meanwhile are not registered
+  std::lock_guard<std::mutex> entities_lock(entities_mutex_);
+  WaitSetEntities wait_set_entities;
+  wait_set_entities.guard_conditions.push_back(
+    &shutdown_guard_condition_->get_rcl_guard_condition());
+  wait_set_entities.guard_conditions.push_back(&interrupt_guard_condition_);
+  const auto groups = get_associated_groups(&wait_set_entities.guard_conditions);
+
+  // Entities already known keep their events, the others get a callback registered.
+  std::unordered_map<const void *, std::shared_ptr<EntityEvents>> previous;
+  for (const auto & pair : entities_) {
+    const void * address = get_entity_address(*pair.second);
+    if (address) {
+      previous.emplace(address, pair.second);
+    }
+  }
+  std::unordered_map<uint64_t, std::shared_ptr<EntityEvents>> entities;
+  auto track =
+    [this, &previous, &entities](std::shared_ptr<EntityEvents> events, const void * address) {
+      auto it = previous.find(address);
+      if (it != previous.end()) {
+        events = it->second;
+        previous.erase(it);
+      } else if (!set_callback(events)) {
+        return false;
+      }
+      entities.emplace(events->key, events);
+      return true;
+    };
+
+  std::vector<rclcpp::TimerBase::WeakPtr> timers;
+  for (const auto & group : groups) {
+    group->find_subscription_ptrs_if(
+      [&](const rclcpp::SubscriptionBase::SharedPtr & subscription) {
+        auto events = std::make_shared<EntityEvents>();
+        events->subscription = subscription;
+        if (!track(events, subscription.get())) {
+          wait_set_entities.subscriptions.push_back(subscription);
+        }
+        return false;
+      });
+    group->find_service_ptrs_if(
+      [&](const rclcpp::ServiceBase::SharedPtr & service) {
+        auto events = std::make_shared<EntityEvents>();
+        events->service = service;
+        if (!track(events, service.get())) {
+          wait_set_entities.services.push_back(service);
+        }
+        return false;
+      });
+    group->find_client_ptrs_if(
+      [&](const rclcpp::ClientBase::SharedPtr & client) {
+        auto events = std::make_shared<EntityEvents>();
+        events->client = client;
+        if (!track(events, client.get())) {
+          wait_set_entities.clients.push_back(client);
+        }
+        return false;
+      });
+    group->find_timer_ptrs_if(
+      [&](const rclcpp::TimerBase::SharedPtr & timer) {
+        // Timers on other clocks may follow simulated time, which only a wait set handles.
+        if (timer->is_steady()) {
+          timers.push_back(timer);
+        } else {
+          wait_set_entities.timers.push_back(timer);
+        }
+        return false;
+      });
+    group->find_waitable_ptrs_if(
+      [&](const rclcpp::Waitable::SharedPtr & waitable) {
+        wait_set_entities.waitables.push_back(waitable);
+        return false;
+      });
+  }
+
+  // Entities which are no longer associated with this executor stop notifying it.
+  for (const auto & pair : previous) {
+    clear_callback(*pair.second);
+  }
+  entities_ = std::move(entities);
+  timers_manager_->set_timers(timers);
+
+  std::lock_guard<std::mutex> lock(wait_set_mutex_);
+  wait_set_entities_ = std::move(wait_set_entities);
+}
+
+bool
+EventsExecutor::set_callback(const std::shared_ptr<EntityEvents> & events)
+{
+  events->key = next_key_++;
+  // The callback keeps the events alive, it is cleared before the executor goes away.
+  auto callback = [this, events](size_t number_of_events) {
+      if (number_of_events > 0u && 0u == events->pending.fetch_add(number_of_events)) {
+        push_event(events->key);
+      }
+    };
+  try {
+    if (auto subscription = events->subscription.lock()) {
+      subscription->set_on_new_message_callback(callback);
+    } else if (auto service = events->service.lock()) {
+      service->set_on_new_request_callback(callback);
+    } else if (auto client = events->client.lock()) {
+      client->set_on_new_response_callback(callback);
+    }
+  } catch (const rclcpp::exceptions::RCLError & rcl_error) {
+    if (RCL_RET_UNSUPPORTED != rcl_error.ret) {
+      throw;
+    }
+    return false;
+  }
+  return true;
+}
+
+void
+EventsExecutor::clear_callback(const EntityEvents & events)
+{
+  if (auto subscription = events.subscription.lock()) {
+    subscription->clear_on_new_message_callback();
+  } else if (auto service = events.service.lock()) {
+    service->clear_on_new_request_callback();
+  } else if (auto client = events.client.lock()) {
+    client->clear_on_new_response_callback();
+  }
+}
+
+void
+EventsExecutor::push_event(uint64_t key)
+{
+  if (!events_queue_.push(key)) {
+    // The pending counter of the entity still records the events.
+    events_queue_overflow_.store(true);
+  }
+  // Pairs with the fence in wait_for_events(): either this thread sees the executor sleeping,
+  // or the executor sees the event before going to sleep.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (sleeping_.load(std::memory_order_relaxed)) {
+    {
+      std::lock_guard<std::mutex> lock(wake_mutex_);
+    }
+    wake_cv_.notify_one();
+  }
+}
+
+void
+EventsExecutor::wait_for_events()
+{
+  std::unique_lock<std::mutex> lock(wake_mutex_);
+  sleeping_.store(true, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  auto has_events = [this]() {
+      return !events_queue_.empty() || events_queue_overflow_.load() || !spinning.load();
+    };
+  wake_cv_.wait(lock, has_events);
+  sleeping_.store(false, std::memory_order_relaxed);
+}
+
+void
+EventsExecutor::execute_events()
+{
+  // Stop after a queue worth of events, so timers are not starved by a busy publisher.
+  uint64_t key;
+  for (size_t i = 0u; i < events_queue_.capacity() && events_queue_.pop(key); ++i) {
+    if (wait_set_key_ == key) {
+      execute_wait_set_result();
+      continue;
+    }
+    if (timers_key_ == key) {
+      timers_manager_->execute_ready_timers();
+      continue;
+    }
+    std::shared_ptr<EntityEvents> events;
+    {
+      std::lock_guard<std::mutex> lock(entities_mutex_);
+      auto it = entities_.find(key);
+      if (it != entities_.end()) {
+        events = it->second;
+      }
+    }
+    if (events) {
+      execute_entity(*events);
+    }
+  }
+
+  if (events_queue_overflow_.exchange(false)) {
+    std::vector<std::shared_ptr<EntityEvents>> all_events;
+    {
+      std::lock_guard<std::mutex> lock(entities_mutex_);
+      for (const auto & pair : entities_) {
+        all_events.push_back(pair.second);
+      }
+    }
+    for (const auto & events : all_events) {
+      execute_entity(*events);
+    }
+    timers_manager_->execute_ready_timers();
+    execute_wait_set_result();
+  }
+}
+
+void
+EventsExecutor::execute_entity(EntityEvents & events)
+{
+  // Events arriving from now on queue the entity again.
+  size_t count = events.pending.exchange(0u);
+  if (0u == count) {
+    return;
+  }
+  if (auto subscription = events.subscription.lock()) {
+    for (size_t i = 0u; i < count; ++i) {
+      execute_subscription(subscription);
+    }
+  } else if (auto service = events.service.lock()) {
+    for (size_t i = 0u; i < count; ++i) {
+      execute_service(service);
+    }
+  } else if (auto client = events.client.lock()) {
+    for (size_t i = 0u; i < count; ++i) {
+      execute_client(client);
+    }
+  }
+}
+
+void
+EventsExecutor::execute_wait_set_result()
+{
+  WaitSetResult result;
+  {
+    std::lock_guard<std::mutex> lock(wait_set_mutex_);
+    if (!wait_set_result_pending_) {
+      return;
+    }
+    result = std::move(wait_set_result_);
+    wait_set_result_ = WaitSetResult();
+  }
+  // Let the helper thread wait again, even if a callback throws.
+  RCLCPP_SCOPE_EXIT(
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->wait_set_mutex_);
+      this->wait_set_result_pending_ = false;
+    }
+    this->wait_set_cv_.notify_one();
+  });
+
+  if (result.exception) {
+    std::rethrow_exception(result.exception);
+  }
+  for (auto & subscription : result.subscriptions) {
+    execute_subscription(subscription);
+  }
+  for (auto & service : result.services) {
+    execute_service(service);
+  }
+  for (auto & client : result.clients) {
+    execute_client(client);
+  }
+  for (auto & timer : result.timers) {
+    if (timer->is_ready()) {
+      execute_timer(timer);
+    }
+  }
+  for (auto & pair : result.waitables) {
+    pair.first->execute(pair.second);
+  }
+  if (result.entities_changed) {
+    refresh_entities();
+  }
+}
+
+void
+EventsExecutor::run_wait_set()
+{
+  while (wait_set_thread_running_.load()) {
+    WaitSetEntities weak_entities;
+    {
+      std::lock_guard<std::mutex> lock(wait_set_mutex_);
+      weak_entities = wait_set_entities_;
+    }
+
+    WaitSetResult result;
+    try {
+      result = wait_once(weak_entities);
+    } catch (...) {
+      // Hand the error over to the thread calling spin(), which rethrows it.
+      result = WaitSetResult();
+      result.exception = std::current_exception();
+    }
+    if (!wait_set_thread_running_.load()) {
+      return;
+    }
+    if (!result.exception && !result.entities_changed && result.subscriptions.empty() &&
+      result.services.empty() && result.clients.empty() && result.timers.empty() &&
+      result.waitables.empty())
+    {
+      continue;
+    }
+
+    const bool failed = static_cast<bool>(result.exception);
+    std::unique_lock<std::mutex> lock(wait_set_mutex_);
+    wait_set_result_ = std::move(result);
+    wait_set_result_pending_ = true;
+    lock.unlock();
+    push_event(wait_set_key_);
+    lock.lock();
+    // Wait for the executor thread, so nothing is reported twice and entities are refreshed.
+    wait_set_cv_.wait(
+      lock, [this]() {
+        return !wait_set_result_pending_ || !wait_set_thread_running_.load();
+      });
+    if (failed) {
+      return;
+    }
+  }
+}
+
+EventsExecutor::WaitSetResult
+EventsExecutor::wait_once(const WaitSetEntities & weak_entities)
+{
+  std::vector<rclcpp::SubscriptionBase::SharedPtr> subscriptions;
+  std::vector<rclcpp::ServiceBase::SharedPtr> services;
+  std::vector<rclcpp::ClientBase::SharedPtr> clients;
+  std::vector<rclcpp::TimerBase::SharedPtr> timers;
+  std::vector<rclcpp::Waitable::SharedPtr> waitables;
+  auto lock_all = [](const auto & weak_ptrs, auto & shared_ptrs) {
+      for (const auto & weak_ptr : weak_ptrs) {
+        if (auto shared_ptr = weak_ptr.lock()) {
+          shared_ptrs.push_back(shared_ptr);
+        }
+      }
+    };
+  lock_all(weak_entities.subscriptions, subscriptions);
+  lock_all(weak_entities.services, services);
+  lock_all(weak_entities.clients, clients);
+  lock_all(weak_entities.timers, timers);
+  lock_all(weak_entities.waitables, waitables);
+
+  size_t number_of_subscriptions = subscriptions.size();
+  size_t number_of_guard_conditions = weak_entities.guard_conditions.size();
+  size_t number_of_timers = timers.size();
+  size_t number_of_clients = clients.size();
+  size_t number_of_services = services.size();
+  size_t number_of_events = 0u;
+  for (const auto & waitable : waitables) {
+    number_of_subscriptions += waitable->get_number_of_ready_subscriptions();
+    number_of_guard_conditions += waitable->get_number_of_ready_guard_conditions();
+    number_of_timers += waitable->get_number_of_ready_timers();
+    number_of_clients += waitable->get_number_of_ready_clients();
+    number_of_services += waitable->get_number_of_ready_services();
+    number_of_events += waitable->get_number_of_ready_events();
+  }
+
+  rcl_ret_t ret = rcl_wait_set_clear(&events_wait_set_);
+  if (RCL_RET_OK != ret) {
+    throw_from_rcl_error(ret, "Couldn't clear wait set");
+  }
+  ret = rcl_wait_set_resize(
+    &events_wait_set_,
+    number_of_subscriptions, number_of_guard_conditions, number_of_timers,
+    number_of_clients, number_of_services, number_of_events);
+  if (RCL_RET_OK != ret) {
+    throw_from_rcl_error(ret, "Couldn't resize the wait set");
+  }
+
+  // The executor's own guard conditions come first, waitables may add more after them.
+  for (const rcl_guard_condition_t * guard_condition : weak_entities.guard_conditions) {
+    ret = rcl_wait_set_add_guard_condition(&events_wait_set_, guard_condition, nullptr);
+    if (RCL_RET_OK != ret) {
+      throw_from_rcl_error(ret, "Couldn't add guard condition to wait set");
+    }
+  }
+  for (const auto & subscription : subscriptions) {
+    ret = rcl_wait_set_add_subscription(
+      &events_wait_set_, subscription->get_subscription_handle().get(), nullptr);
+    if (RCL_RET_OK != ret) {
+      throw_from_rcl_error(ret, "Couldn't add subscription to wait set");
+    }
+  }
+  for (const auto & service : services) {
+    ret = rcl_wait_set_add_service(
+      &events_wait_set_, service->get_service_handle().get(), nullptr);
+    if (RCL_RET_OK != ret) {
+      throw_from_rcl_error(ret, "Couldn't add service to wait set");
+    }
+  }
+  for (const auto & client : clients) {
+    ret = rcl_wait_set_add_client(
+      &events_wait_set_, client->get_client_handle().get(), nullptr);
+    if (RCL_RET_OK != ret) {
+      throw_from_rcl_error(ret, "Couldn't add client to wait set");
+    }
+  }
+  for (const auto & timer : timers) {
+    ret = rcl_wait_set_add_timer(&events_wait_set_, timer->get_timer_handle().get(), nullptr);
+    if (RCL_RET_OK != ret) {
+      throw_from_rcl_error(ret, "Couldn't add timer to wait set");
+    }
+  }
+  for (const auto & waitable : waitables) {
+    waitable->add_to_wait_set(&events_wait_set_);
+  }
+
+  ret = rcl_wait(&events_wait_set_, -1);
+  if (RCL_RET_OK != ret && RCL_RET_TIMEOUT != ret) {
+    throw_from_rcl_error(ret, "rcl_wait() failed");
+  }
+
+  WaitSetResult result;
+  for (size_t i = 0u; i < weak_entities.guard_conditions.size(); ++i) {
+    if (events_wait_set_.guard_conditions[i]) {
+      result.entities_changed = true;
+    }
+  }
+  for (size_t i = 0u; i < subscriptions.size(); ++i) {
+    if (events_wait_set_.subscriptions[i]) {
+      result.subscriptions.push_back(subscriptions[i]);
+    }
+  }
+  for (size_t i = 0u; i < services.size(); ++i) {
+    if (events_wait_set_.services[i]) {
+      result.services.push_back(services[i]);
+    }
+  }
+  for (size_t i = 0u; i < clients.size(); ++i) {
+    if (events_wait_set_.clients[i]) {
+      result.clients.push_back(clients[i]);
+    }
+  }
+  for (size_t i = 0u; i < timers.size(); ++i) {
+    if (events_wait_set_.timers[i]) {
+      result.timers.push_back(timers[i]);
+    }
+  }
+  for (const auto & waitable : waitables) {
+    if (waitable->is_ready(&events_wait_set_)) {
+      result.waitables.emplace_back(waitable, waitable->take_data());
+    }
+  }
+  return result;
+}
+
+void
+EventsExecutor::stop_wait_set_thread()
+{
+  wait_set_thread_running_.store(false);
+  // Interrupt rcl_wait(), or the wait for the executor thread.
+  rcl_ret_t ret = rcl_trigger_guard_condition(&interrupt_guard_condition_);
+  if (RCL_RET_OK != ret) {
+    RCLCPP_ERROR(
+      rclcpp::get_logger("rclcpp"),
+      "failed to trigger the interrupt guard condition: %s", rcl_get_error_string().str);
+    rcl_reset_error();
+  }
+  {
+    std::lock_guard<std::mutex> lock(wait_set_mutex_);
+  }
+  wait_set_cv_.notify_one();
+}
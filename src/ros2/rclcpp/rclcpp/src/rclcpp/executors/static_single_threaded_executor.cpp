@@ -16,6 +16,7 @@
 
 #include <chrono>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include "rclcpp/scope_exit.hpp"
@@ -45,9 +46,13 @@ StaticSingleThreadedExecutor::spin()
   }
   RCLCPP_SCOPE_EXIT(this->spinning.store(false); );
 
-  // Set memory_strategy_ and exec_list_ based on weak_nodes_
-  // Prepare wait_set_ based on memory_strategy_
-  entities_collector_->init(&wait_set_, memory_strategy_, &interrupt_guard_condition_);
+  {
+    // Wait for a collection started while not spinning, from now on this thread collects.
+    std::lock_guard<std::mutex> lock(collect_mutex_);
+    // Set memory_strategy_ and exec_list_ based on weak_nodes_
+    // Prepare wait_set_ based on memory_strategy_
+    entities_collector_->init(&wait_set_, memory_strategy_, &interrupt_guard_condition_);
+  }
 
   while (rclcpp::ok(this->context_) && spinning.load()) {
     // Refresh wait set and wait for work
@@ -79,11 +84,6 @@ StaticSingleThreadedExecutor::spin_all(std::chrono::nanoseconds max_duration)
 void
 StaticSingleThreadedExecutor::spin_some_impl(std::chrono::nanoseconds max_duration, bool exhaustive)
 {
-  // Make sure the entities collector has been initialized
-  if (!entities_collector_->is_init()) {
-    entities_collector_->init(&wait_set_, memory_strategy_, &interrupt_guard_condition_);
-  }
-
   auto start = std::chrono::steady_clock::now();
   auto max_duration_not_elapsed = [max_duration, start]() {
       if (std::chrono::nanoseconds(0) == max_duration) {
@@ -101,6 +101,7 @@ StaticSingleThreadedExecutor::spin_some_impl(std::chrono::nanoseconds max_durati
     throw std::runtime_error("spin_some() called while already spinning");
   }
   RCLCPP_SCOPE_EXIT(this->spinning.store(false); );
+  init_entities_collector();
 
   while (rclcpp::ok(context_) && spinning.load() && max_duration_not_elapsed()) {
     // Get executables that are ready now
@@ -116,10 +117,7 @@ StaticSingleThreadedExecutor::spin_some_impl(std::chrono::nanoseconds max_durati
 void
 StaticSingleThreadedExecutor::spin_once_impl(std::chrono::nanoseconds timeout)
 {
-  // Make sure the entities collector has been initialized
-  if (!entities_collector_->is_init()) {
-    entities_collector_->init(&wait_set_, memory_strategy_, &interrupt_guard_condition_);
-  }
+  init_entities_collector();
 
   if (rclcpp::ok(context_) && spinning.load()) {
     // Wait until we have a ready entity or timeout expired
@@ -136,6 +134,7 @@ StaticSingleThreadedExecutor::add_callback_group(
   bool notify)
 {
   bool is_new_node = entities_collector_->add_callback_group(group_ptr, node_ptr);
+  collect_entities();
   if (is_new_node && notify) {
     // Interrupt waiting to handle new node
     if (rcl_trigger_guard_condition(&interrupt_guard_condition_) != RCL_RET_OK) {
@@ -149,6 +148,7 @@ StaticSingleThreadedExecutor::add_node(
   rclcpp::node_interfaces::NodeBaseInterface::SharedPtr node_ptr, bool notify)
 {
   bool is_new_node = entities_collector_->add_node(node_ptr);
+  collect_entities();
   if (is_new_node && notify) {
     // Interrupt waiting to handle new node
     if (rcl_trigger_guard_condition(&interrupt_guard_condition_) != RCL_RET_OK) {
@@ -168,6 +168,7 @@ StaticSingleThreadedExecutor::remove_callback_group(
   rclcpp::CallbackGroup::SharedPtr group_ptr, bool notify)
 {
   bool node_removed = entities_collector_->remove_callback_group(group_ptr);
+  collect_entities();
   // If the node was matched and removed, interrupt waiting
   if (node_removed && notify) {
     if (rcl_trigger_guard_condition(&interrupt_guard_condition_) != RCL_RET_OK) {
@@ -184,6 +185,7 @@ StaticSingleThreadedExecutor::remove_node(
   if (!node_removed) {
     throw std::runtime_error("Node needs to be associated with this executor.");
   }
+  collect_entities();
   // If the node was matched and removed, interrupt waiting
   if (notify) {
     if (rcl_trigger_guard_condition(&interrupt_guard_condition_) != RCL_RET_OK) {
@@ -216,6 +218,33 @@ StaticSingleThreadedExecutor::remove_node(std::shared_ptr<rclcpp::Node> node_ptr
   this->remove_node(node_ptr->get_node_base_interface(), notify);
 }
 
+void
+StaticSingleThreadedExecutor::init_entities_collector()
+{
+  // Wait for a collection started while not spinning, from now on this thread collects.
+  std::lock_guard<std::mutex> lock(collect_mutex_);
+  // Make sure the entities collector has been initialized
+  if (!entities_collector_->is_init()) {
+    entities_collector_->init(&wait_set_, memory_strategy_, &interrupt_guard_condition_);
+  }
+}
+
+void
+StaticSingleThreadedExecutor::collect_entities()
+{
+  // spinning is set before the spinning thread takes the lock, so no collection can overlap it.
+  std::lock_guard<std::mutex> lock(collect_mutex_);
+  if (spinning.load()) {
+    return;
+  }
+  if (!entities_collector_->is_init()) {
+    entities_collector_->init(&wait_set_, memory_strategy_, &interrupt_guard_condition_);
+  } else {
+    std::shared_ptr<void> data;
+    entities_collector_->execute(data);
+  }
+}
+
 bool
 StaticSingleThreadedExecutor::execute_ready_executables(bool spin_once)
 {
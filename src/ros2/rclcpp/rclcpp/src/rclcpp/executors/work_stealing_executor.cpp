@@ -0,0 +1,295 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rclcpp/executors/work_stealing_executor.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "rclcpp/utilities.hpp"
+#include "rclcpp/scope_exit.hpp"
+
+using rclcpp::executors::WorkStealingExecutor;
+
+namespace
+{
+
+/// Return the entity an executable was created for, or nullptr for waitables.
+/**
+ * Waitables are excluded because their data is taken while selecting them, so a second
+ * selection of the same waitable carries different data and must not be discarded.
+ */
+const void *
+get_entity(const rclcpp::AnyExecutable & any_exec)
+{
+  if (any_exec.timer) {
+    return any_exec.timer.get();
+  }
+  if (any_exec.subscription) {
+    return any_exec.subscription.get();
+  }
+  if (any_exec.service) {
+    return any_exec.service.get();
+  }
+  if (any_exec.client) {
+    return any_exec.client.get();
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+WorkStealingExecutor::WorkStealingExecutor(
+  const rclcpp::ExecutorOptions & options,
+  size_t number_of_threads,
+  size_t queue_capacity,
+  std::chrono::nanoseconds next_exec_timeout)
+: rclcpp::Executor(options),
+  next_exec_timeout_(next_exec_timeout)
+{
+  number_of_threads_ = number_of_threads ? number_of_threads : std::thread::hardware_concurrency();
+  if (number_of_threads_ == 0) {
+    number_of_threads_ = 1;
+  }
+  queues_.reserve(number_of_threads_);
+  for (size_t i = 0; i < number_of_threads_; ++i) {
+    queues_.emplace_back(std::make_unique<ReadyQueue>(queue_capacity));
+  }
+}
+
+WorkStealingExecutor::~WorkStealingExecutor() {}
+
+void
+WorkStealingExecutor::spin()
+{
+  if (spinning.exchange(true)) {
+    throw std::runtime_error("spin() called while already spinning");
+  }
+  std::vector<std::thread> threads;
+  RCLCPP_SCOPE_EXIT(
+  {
+    this->spinning.store(false);
+    notify_workers(true);
+    for (auto & thread : threads) {
+      thread.join();
+    }
+    // Discard whatever was still queued, which resets the callback groups.
+    for (auto & queue : queues_) {
+      while (ReadyExecutable * ready_exec = queue->steal()) {
+        delete ready_exec;
+      }
+    }
+    pending_.store(0u);
+    in_flight_flags_.clear();
+  });
+  for (size_t thread_id = 0; thread_id < number_of_threads_; ++thread_id) {
+    auto func = std::bind(&WorkStealingExecutor::run, this, thread_id);
+    threads.emplace_back(func);
+  }
+
+  poll();
+}
+
+size_t
+WorkStealingExecutor::get_number_of_threads()
+{
+  return number_of_threads_;
+}
+
+void
+WorkStealingExecutor::poll()
+{
+  while (rclcpp::ok(this->context_) && spinning.load()) {
+    wait_for_work(next_exec_timeout_);
+    if (!spinning.load()) {
+      return;
+    }
+
+    const uint64_t progress_before = progress_count_.load();
+    bool skipped = false;
+    size_t dispatched = 0u;
+    while (true) {
+      auto ready_exec = std::make_unique<ReadyExecutable>();
+      if (!get_next_ready_executable(ready_exec->any_exec)) {
+        break;
+      }
+      const void * entity = get_entity(ready_exec->any_exec);
+      if (entity) {
+        ready_exec->in_flight = get_in_flight_flag(entity);
+        if (ready_exec->in_flight->exchange(true)) {
+          // Already queued, or a timer which is still running; dropping the executable
+          // resets its callback group.
+          skipped = true;
+          continue;
+        }
+      }
+      if (!dispatch(std::move(ready_exec))) {
+        return;
+      }
+      ++dispatched;
+    }
+    if (dispatched > 0u) {
+      notify_workers(dispatched > 1u);
+    }
+
+    if (skipped) {
+      // Entities that are queued but not taken yet keep the wait set ready, so wait for the
+      // workers to make progress rather than spinning on rcl_wait().
+      std::unique_lock<std::mutex> lock(progress_mutex_);
+      // Set before checking the count, so a worker making progress meanwhile sees it and notifies.
+      poller_waiting_.store(true);
+      progress_cv_.wait(
+        lock, [this, progress_before]() {
+          return progress_count_.load() != progress_before ||
+          !spinning.load() || !rclcpp::ok(this->context_);
+        });
+      poller_waiting_.store(false);
+    }
+    prune_in_flight_flags();
+  }
+}
+
+std::atomic_bool *
+WorkStealingExecutor::get_in_flight_flag(const void * entity)
+{
+  auto & flag = in_flight_flags_[entity];
+  if (!flag) {
+    flag = std::make_unique<std::atomic_bool>(false);
+  }
+  return flag.get();
+}
+
+void
+WorkStealingExecutor::prune_in_flight_flags()
+{
+  if (in_flight_flags_.size() < in_flight_flags_prune_size_) {
+    return;
+  }
+  // A cleared flag is not accessed by the workers anymore, and only this thread sets it again.
+  for (auto it = in_flight_flags_.begin(); it != in_flight_flags_.end(); ) {
+    if (it->second->load()) {
+      ++it;
+    } else {
+      it = in_flight_flags_.erase(it);
+    }
+  }
+  in_flight_flags_prune_size_ = std::max<size_t>(64u, 2u * in_flight_flags_.size());
+}
+
+void
+WorkStealingExecutor::run(size_t this_thread_number)
+{
+  RCLCPP_SCOPE_EXIT(
+  {
+    // Make sure the polling thread does not wait on a worker that is gone.
+    mark_progress(nullptr);
+  });
+  while (rclcpp::ok(this->context_) && spinning.load()) {
+    std::unique_ptr<ReadyExecutable> ready_exec(acquire(this_thread_number));
+    if (!ready_exec) {
+      std::unique_lock<std::mutex> lock(idle_mutex_);
+      idle_cv_.wait(
+        lock, [this]() {
+          return pending_.load() > 0u || !spinning.load() || !rclcpp::ok(this->context_);
+        });
+      continue;
+    }
+    pending_.fetch_sub(1u);
+
+    AnyExecutable & any_exec = ready_exec->any_exec;
+    if (ready_exec->in_flight && !any_exec.timer) {
+      // From here on the entity is taken from, so it may be selected again.
+      mark_progress(ready_exec->in_flight);
+    }
+
+    execute_any_executable(any_exec);
+
+    if (ready_exec->in_flight && any_exec.timer) {
+      mark_progress(ready_exec->in_flight);
+    }
+    // Clear the callback_group to prevent the AnyExecutable destructor from
+    // resetting the callback group `can_be_taken_from`
+    any_exec.callback_group.reset();
+  }
+}
+
+bool
+WorkStealingExecutor::dispatch(std::unique_ptr<ReadyExecutable> ready_exec)
+{
+  // Count the executable before it becomes visible, so workers never see the counter wrap.
+  pending_.fetch_add(1u);
+  while (spinning.load()) {
+    for (size_t i = 0; i < queues_.size(); ++i) {
+      ReadyQueue & queue = *queues_[next_queue_];
+      next_queue_ = (next_queue_ + 1u) % queues_.size();
+      if (queue.push(ready_exec.get())) {
+        ready_exec.release();
+        return true;
+      }
+    }
+    // Every queue is full, let the workers catch up.
+    notify_workers(true);
+    std::this_thread::yield();
+  }
+  pending_.fetch_sub(1u);
+  return false;
+}
+
+WorkStealingExecutor::ReadyExecutable *
+WorkStealingExecutor::acquire(size_t this_thread_number)
+{
+  for (size_t i = 0; i < queues_.size(); ++i) {
+    ReadyExecutable * ready_exec = queues_[(this_thread_number + i) % queues_.size()]->steal();
+    if (ready_exec) {
+      return ready_exec;
+    }
+  }
+  return nullptr;
+}
+
+void
+WorkStealingExecutor::mark_progress(std::atomic_bool * in_flight)
+{
+  if (in_flight) {
+    // Last access to the flag, the polling thread may drop it once cleared.
+    in_flight->store(false);
+  }
+  progress_count_.fetch_add(1u);
+  if (poller_waiting_.load()) {
+    // Taking the mutex ensures the polling thread is blocked, not between checking and waiting.
+    {
+      std::lock_guard<std::mutex> lock(progress_mutex_);
+    }
+    progress_cv_.notify_one();
+  }
+}
+
+void
+WorkStealingExecutor::notify_workers(bool all)
+{
+  // Taking the mutex ensures a worker cannot miss the notification between evaluating its
+  // wait predicate and blocking.
+  {
+    std::lock_guard<std::mutex> lock(idle_mutex_);
+  }
+  if (all) {
+    idle_cv_.notify_all();
+  } else {
+    idle_cv_.notify_one();
+  }
+}
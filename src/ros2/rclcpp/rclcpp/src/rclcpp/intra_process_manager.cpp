@@ -17,6 +17,9 @@
 #include <atomic>
 #include <memory>
 #include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 
 namespace rclcpp
 {
@@ -26,6 +29,7 @@ namespace experimental
 static std::atomic<uint64_t> _next_unique_id {1};
 
 IntraProcessManager::IntraProcessManager()
+: pub_to_subs_snapshot_(std::make_shared<const PublisherToSubscriptionsSnapshot>())
 {}
 
 IntraProcessManager::~IntraProcessManager()
@@ -51,6 +55,7 @@ IntraProcessManager::add_publisher(rclcpp::PublisherBase::SharedPtr publisher)
       insert_sub_id_for_pub(pair.first, id, pair.second.use_take_shared_method);
     }
   }
+  update_publisher_subscriptions();
 
   return id;
 }
@@ -73,6 +78,7 @@ IntraProcessManager::add_subscription(SubscriptionIntraProcessBase::SharedPtr su
       insert_sub_id_for_pub(id, pair.first, subscriptions_[id].use_take_shared_method);
     }
   }
+  update_publisher_subscriptions();
 
   return id;
 }
@@ -99,6 +105,7 @@ IntraProcessManager::remove_subscription(uint64_t intra_process_subscription_id)
         intra_process_subscription_id),
       pair.second.take_ownership_subscriptions.end());
   }
+  update_publisher_subscriptions();
 }
 
 void
@@ -108,6 +115,7 @@ IntraProcessManager::remove_publisher(uint64_t intra_process_publisher_id)
 
   publishers_.erase(intra_process_publisher_id);
   pub_to_subs_.erase(intra_process_publisher_id);
+  update_publisher_subscriptions();
 }
 
 bool
@@ -130,10 +138,10 @@ IntraProcessManager::matches_any_publishers(const rmw_gid_t * id) const
 size_t
 IntraProcessManager::get_subscription_count(uint64_t intra_process_publisher_id) const
 {
-  std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+  auto snapshot = get_publisher_subscriptions();
 
-  auto publisher_it = pub_to_subs_.find(intra_process_publisher_id);
-  if (publisher_it == pub_to_subs_.end()) {
+  auto publisher_it = snapshot->find(intra_process_publisher_id);
+  if (publisher_it == snapshot->end()) {
     // Publisher is either invalid or no longer exists.
     RCLCPP_WARN(
       rclcpp::get_logger("rclcpp"),
@@ -141,11 +149,7 @@ IntraProcessManager::get_subscription_count(uint64_t intra_process_publisher_id)
     return 0;
   }
 
-  auto count =
-    publisher_it->second.take_shared_subscriptions.size() +
-    publisher_it->second.take_ownership_subscriptions.size();
-
-  return count;
+  return publisher_it->second.all_subscriptions.size();
 }
 
 SubscriptionIntraProcessBase::SharedPtr
@@ -157,13 +161,9 @@ IntraProcessManager::get_subscription_intra_process(uint64_t intra_process_subsc
   if (subscription_it == subscriptions_.end()) {
     return nullptr;
   } else {
-    auto subscription = subscription_it->second.subscription.lock();
-    if (subscription) {
-      return subscription;
-    } else {
-      subscriptions_.erase(subscription_it);
-      return nullptr;
-    }
+    // An expired subscription is left for remove_subscription(), as this only holds a
+    // shared lock.
+    return subscription_it->second.subscription.lock();
   }
 }
 
@@ -202,6 +202,44 @@ IntraProcessManager::insert_sub_id_for_pub(
   }
 }
 
+void
+IntraProcessManager::update_publisher_subscriptions()
+{
+  auto snapshot = std::make_shared<PublisherToSubscriptionsSnapshot>();
+  snapshot->reserve(pub_to_subs_.size());
+
+  auto resolve = [this](const std::vector<uint64_t> & ids, SubscriptionWeakPtrs & subscriptions) {
+      subscriptions.reserve(ids.size());
+      for (auto id : ids) {
+        auto subscription_it = subscriptions_.find(id);
+        if (subscription_it == subscriptions_.end()) {
+          throw std::runtime_error("subscription has unexpectedly gone out of scope");
+        }
+        subscriptions.push_back(subscription_it->second.subscription);
+      }
+    };
+
+  for (auto & pair : pub_to_subs_) {
+    auto & subs = (*snapshot)[pair.first];
+    resolve(pair.second.take_shared_subscriptions, subs.take_shared_subscriptions);
+    resolve(pair.second.take_ownership_subscriptions, subs.take_ownership_subscriptions);
+    subs.all_subscriptions.reserve(
+      subs.take_shared_subscriptions.size() + subs.take_ownership_subscriptions.size());
+    subs.all_subscriptions.insert(
+      subs.all_subscriptions.end(),
+      subs.take_shared_subscriptions.begin(),
+      subs.take_shared_subscriptions.end());
+    subs.all_subscriptions.insert(
+      subs.all_subscriptions.end(),
+      subs.take_ownership_subscriptions.begin(),
+      subs.take_ownership_subscriptions.end());
+  }
+
+  std::atomic_store(
+    &pub_to_subs_snapshot_,
+    std::shared_ptr<const PublisherToSubscriptionsSnapshot>(std::move(snapshot)));
+}
+
 bool
 IntraProcessManager::can_communicate(
   PublisherInfo pub_info,
@@ -19,8 +19,10 @@
 #include <memory>
 #include <sstream>
 #include <string>
+#include <utility>
 
 #include "rclcpp/any_service_callback.hpp"
+#include "rclcpp/detail/cpp_callback_trampoline.hpp"
 #include "rclcpp/macros.hpp"
 #include "rmw/error_handling.h"
 #include "rmw/rmw.h"
@@ -32,7 +34,15 @@ ServiceBase::ServiceBase(std::shared_ptr<rcl_node_t> node_handle)
 {}
 
 ServiceBase::~ServiceBase()
-{}
+{
+  try {
+    clear_on_new_request_callback();
+  } catch (const std::exception & exception) {
+    RCLCPP_ERROR(
+      rclcpp::get_node_logger(node_handle_.get()).get_child("rclcpp"),
+      "Error clearing the on new request callback of service: %s", exception.what());
+  }
+}
 
 bool
 ServiceBase::take_type_erased_request(void * request_out, rmw_request_id_t & request_id_out)
@@ -84,3 +94,56 @@ ServiceBase::exchange_in_use_by_wait_set_state(bool in_use_state)
 {
   return in_use_by_wait_set_.exchange(in_use_state);
 }
+
+void
+ServiceBase::set_on_new_request_callback(std::function<void(size_t)> callback)
+{
+  if (!callback) {
+    throw std::invalid_argument(
+            "The callback passed to set_on_new_request_callback is not callable.");
+  }
+
+  // The callback is called from C code in the middleware, exceptions must not escape it.
+  auto new_callback = std::make_unique<std::function<void(size_t)>>(
+    [callback, logger = rclcpp::get_node_logger(node_handle_.get()).get_child("rclcpp"),
+    service_name = std::string(get_service_name())](size_t number_of_requests) {
+      try {
+        callback(number_of_requests);
+      } catch (const std::exception & exception) {
+        RCLCPP_ERROR(
+          logger,
+          "Exception thrown from the on new request callback of service '%s': %s",
+          service_name.c_str(), exception.what());
+      } catch (...) {
+        RCLCPP_ERROR(
+          logger,
+          "Unknown exception thrown from the on new request callback of service '%s'",
+          service_name.c_str());
+      }
+    });
+
+  std::lock_guard<std::mutex> lock(on_new_request_callback_mutex_);
+  rcl_ret_t ret = rcl_service_set_on_new_request_callback(
+    service_handle_.get(),
+    rclcpp::detail::cpp_callback_trampoline<const void *, size_t>,
+    new_callback.get());
+  if (RCL_RET_OK != ret) {
+    rclcpp::exceptions::throw_from_rcl_error(ret, "failed to set the on new request callback");
+  }
+  // The middleware calls the new callback from now on, so the previous one can be released.
+  on_new_request_callback_ = std::move(new_callback);
+}
+
+void
+ServiceBase::clear_on_new_request_callback()
+{
+  std::lock_guard<std::mutex> lock(on_new_request_callback_mutex_);
+  if (!on_new_request_callback_) {
+    return;
+  }
+  rcl_ret_t ret = rcl_service_set_on_new_request_callback(service_handle_.get(), nullptr, nullptr);
+  if (RCL_RET_OK != ret) {
+    rclcpp::exceptions::throw_from_rcl_error(ret, "failed to clear the on new request callback");
+  }
+  on_new_request_callback_.reset();
+}
@@ -15,10 +15,13 @@
 #include "rclcpp/subscription_base.hpp"
 
 #include <cstdio>
+#include <functional>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "rclcpp/detail/cpp_callback_trampoline.hpp"
 #include "rclcpp/exceptions.hpp"
 #include "rclcpp/expand_topic_or_service_name.hpp"
 #include "rclcpp/experimental/intra_process_manager.hpp"
@@ -27,6 +30,7 @@
 #include "rclcpp/qos_event.hpp"
 
 #include "rmw/error_handling.h"
+#include "rmw/message_sequence.h"
 #include "rmw/rmw.h"
 
 using rclcpp::SubscriptionBase;
@@ -41,6 +45,7 @@ SubscriptionBase::SubscriptionBase(
   node_handle_(node_base_->get_shared_rcl_node_handle()),
   use_intra_process_(false),
   intra_process_subscription_id_(0),
+  take_batch_size_(1u),
   type_support_(type_support_handle),
   is_serialized_(is_serialized)
 {
@@ -83,6 +88,14 @@ SubscriptionBase::SubscriptionBase(
 
 SubscriptionBase::~SubscriptionBase()
 {
+  try {
+    clear_on_new_message_callback();
+  } catch (const std::exception & exception) {
+    RCLCPP_ERROR(
+      rclcpp::get_node_logger(node_handle_.get()).get_child("rclcpp"),
+      "Error clearing the on new message callback of subscription: %s", exception.what());
+  }
+
   if (!use_intra_process_) {
     return;
   }
@@ -158,6 +171,111 @@ SubscriptionBase::take_type_erased(void * message_out, rclcpp::MessageInfo & mes
   return true;
 }
 
+SubscriptionBase::TakeSequenceStorage::~TakeSequenceStorage()
+{
+}
+
+size_t
+SubscriptionBase::take_type_erased_sequence(TakeSequenceStorage & storage)
+{
+  storage.message_infos.clear();
+  storage.messages.resize(take_batch_size_);
+  for (auto & message : storage.messages) {
+    // Never overwrite a message that is referenced elsewhere, e.g. because a callback kept it
+    // or because a pooling memory strategy tracks it, borrow a new one instead.
+    if (message && message.use_count() > 1) {
+      return_message(message);
+      message.reset();
+    }
+    if (!message) {
+      message = create_message();
+    }
+  }
+
+  const size_t batch_size = storage.messages.size();
+  storage.message_ptrs.resize(batch_size);
+  for (size_t i = 0u; i < batch_size; ++i) {
+    storage.message_ptrs[i] = storage.messages[i].get();
+  }
+  storage.rmw_message_infos.resize(batch_size);
+
+  rmw_message_sequence_t message_sequence = rmw_get_zero_initialized_message_sequence();
+  message_sequence.data = storage.message_ptrs.data();
+  message_sequence.capacity = batch_size;
+  rmw_message_info_sequence_t message_info_sequence =
+    rmw_get_zero_initialized_message_info_sequence();
+  message_info_sequence.data = storage.rmw_message_infos.data();
+  message_info_sequence.capacity = batch_size;
+
+  rcl_ret_t ret = rcl_take_sequence(
+    this->get_subscription_handle().get(),
+    batch_size,
+    &message_sequence,
+    &message_info_sequence,
+    nullptr  // rmw_subscription_allocation_t is unused here
+  );
+  if (RCL_RET_SUBSCRIPTION_TAKE_FAILED == ret) {
+    return 0u;
+  } else if (RCL_RET_OK != ret) {
+    rclcpp::exceptions::throw_from_rcl_error(ret);
+  }
+
+  // The middleware may reorder the message pointers, put the owning pointers in the same order.
+  const size_t taken = message_sequence.size;
+  for (size_t i = 0u; i < taken; ++i) {
+    for (size_t j = i; j < batch_size; ++j) {
+      if (storage.messages[j].get() == message_sequence.data[i]) {
+        std::swap(storage.messages[i], storage.messages[j]);
+        break;
+      }
+    }
+    storage.message_infos.emplace_back(storage.rmw_message_infos[i]);
+    storage.message_infos.back().get_rmw_message_info().from_intra_process = false;
+  }
+  return taken;
+}
+
+std::unique_ptr<SubscriptionBase::TakeSequenceStorage>
+SubscriptionBase::borrow_take_sequence_storage()
+{
+  {
+    std::lock_guard<std::mutex> lock(take_sequence_storage_mutex_);
+    if (take_sequence_storage_) {
+      return std::move(take_sequence_storage_);
+    }
+  }
+  return create_take_sequence_storage();
+}
+
+void
+SubscriptionBase::return_take_sequence_storage(std::unique_ptr<TakeSequenceStorage> storage)
+{
+  std::lock_guard<std::mutex> lock(take_sequence_storage_mutex_);
+  if (!take_sequence_storage_) {
+    take_sequence_storage_ = std::move(storage);
+  }
+}
+
+std::unique_ptr<SubscriptionBase::TakeSequenceStorage>
+SubscriptionBase::create_take_sequence_storage()
+{
+  return std::make_unique<TakeSequenceStorage>();
+}
+
+void
+SubscriptionBase::handle_message_sequence(TakeSequenceStorage & storage, size_t count)
+{
+  for (size_t i = 0u; i < count; ++i) {
+    handle_message(storage.messages[i], storage.message_infos[i]);
+  }
+}
+
+size_t
+SubscriptionBase::get_take_batch_size() const
+{
+  return take_batch_size_;
+}
+
 bool
 SubscriptionBase::take_serialized(
   rclcpp::SerializedMessage & message_out,
@@ -325,3 +443,57 @@ std::vector<rclcpp::NetworkFlowEndpoint> SubscriptionBase::get_network_flow_endp
 
   return network_flow_endpoint_vector;
 }
+
+void
+SubscriptionBase::set_on_new_message_callback(std::function<void(size_t)> callback)
+{
+  if (!callback) {
+    throw std::invalid_argument(
+            "The callback passed to set_on_new_message_callback is not callable.");
+  }
+
+  // The callback is called from C code in the middleware, exceptions must not escape it.
+  auto new_callback = std::make_unique<std::function<void(size_t)>>(
+    [callback, logger = rclcpp::get_node_logger(node_handle_.get()).get_child("rclcpp"),
+    topic_name = std::string(get_topic_name())](size_t number_of_messages) {
+      try {
+        callback(number_of_messages);
+      } catch (const std::exception & exception) {
+        RCLCPP_ERROR(
+          logger,
+          "Exception thrown from the on new message callback of subscription on '%s': %s",
+          topic_name.c_str(), exception.what());
+      } catch (...) {
+        RCLCPP_ERROR(
+          logger,
+          "Unknown exception thrown from the on new message callback of subscription on '%s'",
+          topic_name.c_str());
+      }
+    });
+
+  std::lock_guard<std::mutex> lock(on_new_message_callback_mutex_);
+  rcl_ret_t ret = rcl_subscription_set_on_new_message_callback(
+    subscription_handle_.get(),
+    rclcpp::detail::cpp_callback_trampoline<const void *, size_t>,
+    new_callback.get());
+  if (RCL_RET_OK != ret) {
+    rclcpp::exceptions::throw_from_rcl_error(ret, "failed to set the on new message callback");
+  }
+  // The middleware calls the new callback from now on, so the previous one can be released.
+  on_new_message_callback_ = std::move(new_callback);
+}
+
+void
+SubscriptionBase::clear_on_new_message_callback()
+{
+  std::lock_guard<std::mutex> lock(on_new_message_callback_mutex_);
+  if (!on_new_message_callback_) {
+    return;
+  }
+  rcl_ret_t ret = rcl_subscription_set_on_new_message_callback(
+    subscription_handle_.get(), nullptr, nullptr);
+  if (RCL_RET_OK != ret) {
+    rclcpp::exceptions::throw_from_rcl_error(ret, "failed to clear the on new message callback");
+  }
+  on_new_message_callback_.reset();
+}
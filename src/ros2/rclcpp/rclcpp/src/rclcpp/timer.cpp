@@ -17,7 +17,10 @@
 #include <chrono>
 #include <string>
 #include <memory>
+#include <mutex>
+#include <stdexcept>
 #include <thread>
+#include <utility>
 
 #include "rclcpp/contexts/default_context.hpp"
 #include "rclcpp/exceptions.hpp"
@@ -100,6 +103,33 @@ TimerBase::reset()
   if (ret != RCL_RET_OK) {
     rclcpp::exceptions::throw_from_rcl_error(ret, "Couldn't reset timer");
   }
+  std::lock_guard<std::mutex> lock(on_reset_callback_mutex_);
+  if (on_reset_callback_) {
+    on_reset_callback_();
+  }
+}
+
+void
+TimerBase::set_on_reset_callback(std::function<void()> callback, const void * owner)
+{
+  if (!callback) {
+    throw std::invalid_argument(
+            "The callback passed to set_on_reset_callback is not callable.");
+  }
+  std::lock_guard<std::mutex> lock(on_reset_callback_mutex_);
+  on_reset_callback_ = std::move(callback);
+  on_reset_callback_owner_ = owner;
+}
+
+void
+TimerBase::clear_on_reset_callback(const void * owner)
+{
+  std::lock_guard<std::mutex> lock(on_reset_callback_mutex_);
+  if (owner != nullptr && owner != on_reset_callback_owner_) {
+    return;
+  }
+  on_reset_callback_ = nullptr;
+  on_reset_callback_owner_ = nullptr;
 }
 
 bool
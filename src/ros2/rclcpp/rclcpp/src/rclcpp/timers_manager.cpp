@@ -0,0 +1,269 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rclcpp/experimental/timers_manager.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "rclcpp/exceptions.hpp"
+#include "rclcpp/scope_exit.hpp"
+
+using rclcpp::experimental::TimersManager;
+
+namespace
+{
+
+bool
+same_timer(const rclcpp::TimerBase::WeakPtr & lhs, const rclcpp::TimerBase::WeakPtr & rhs)
+{
+  return !lhs.owner_before(rhs) && !rhs.owner_before(lhs);
+}
+
+bool
+contains_timer(
+  const std::vector<rclcpp::TimerBase::WeakPtr> & timers,
+  const rclcpp::TimerBase::WeakPtr & timer)
+{
+  return std::any_of(
+    timers.begin(), timers.end(),
+    [&timer](const rclcpp::TimerBase::WeakPtr & other) {return same_timer(timer, other);});
+}
+
+}  // namespace
+
+TimersManager::TimersManager(std::function<void()> on_ready_callback)
+: on_ready_callback_(std::move(on_ready_callback))
+{}
+
+TimersManager::~TimersManager()
+{
+  stop();
+  // The timers may be managed by another manager by now, which must keep its callback.
+  for (const auto & weak_timer : timers_) {
+    if (auto timer = weak_timer.lock()) {
+      timer->clear_on_reset_callback(this);
+    }
+  }
+}
+
+void
+TimersManager::set_timers(const std::vector<rclcpp::TimerBase::WeakPtr> & timers)
+{
+  std::vector<rclcpp::TimerBase::WeakPtr> previous_timers;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    previous_timers.swap(timers_);
+    timers_ = timers;
+    ready_timers_.erase(
+      std::remove_if(
+        ready_timers_.begin(), ready_timers_.end(),
+        [&timers](const rclcpp::TimerBase::WeakPtr & timer) {
+          return !contains_timer(timers, timer);
+        }),
+      ready_timers_.end());
+
+    heap_.clear();
+    canceled_timers_.clear();
+    const auto now = Clock::now();
+    for (const auto & weak_timer : timers) {
+      if (contains_timer(ready_timers_, weak_timer)) {
+        continue;
+      }
+      if (auto timer = weak_timer.lock()) {
+        schedule_timer_unsafe(timer, now);
+      }
+    }
+    ++timers_generation_;
+  }
+  timers_cv_.notify_one();
+
+  // Not under mutex_, the timers call on_timer_reset() with their own lock held.
+  for (const auto & weak_timer : previous_timers) {
+    if (contains_timer(timers, weak_timer)) {
+      continue;
+    }
+    if (auto timer = weak_timer.lock()) {
+      timer->clear_on_reset_callback(this);
+    }
+  }
+  for (const auto & weak_timer : timers) {
+    if (auto timer = weak_timer.lock()) {
+      timer->set_on_reset_callback([this]() {this->on_timer_reset();}, this);
+    }
+  }
+}
+
+void
+TimersManager::start()
+{
+  if (running_.exchange(true)) {
+    throw std::runtime_error("TimersManager thread is already running");
+  }
+  timers_thread_ = std::thread(&TimersManager::run_timers, this);
+}
+
+void
+TimersManager::stop()
+{
+  {
+    // Store under the lock, so the thread cannot miss it between checking and waiting.
+    std::lock_guard<std::mutex> lock(mutex_);
+    running_.store(false);
+  }
+  timers_cv_.notify_one();
+  if (timers_thread_.joinable()) {
+    timers_thread_.join();
+  }
+}
+
+void
+TimersManager::execute_ready_timers()
+{
+  uint64_t generation;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    executing_timers_.swap(ready_timers_);
+    generation = timers_generation_;
+  }
+  // Schedule the timers again even if a callback throws, the ones not executed are still due.
+  RCLCPP_SCOPE_EXIT(
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->mutex_);
+      // Otherwise set_timers() already scheduled them.
+      if (generation == this->timers_generation_) {
+        const auto now = Clock::now();
+        for (const auto & weak_timer : this->executing_timers_) {
+          if (auto timer = weak_timer.lock()) {
+            this->schedule_timer_unsafe(timer, now);
+          }
+        }
+      }
+      this->executing_timers_.clear();
+    }
+    this->timers_cv_.notify_one();
+  });
+
+  for (const auto & weak_timer : executing_timers_) {
+    auto timer = weak_timer.lock();
+    if (timer && timer->is_ready()) {
+      timer->execute_callback();
+    }
+  }
+}
+
+void
+TimersManager::run_timers()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (running_.load()) {
+    const auto now = Clock::now();
+    reschedule_canceled_timers_unsafe(now);
+    if (heap_.empty()) {
+      timers_cv_.wait(lock);
+      continue;
+    }
+    if (heap_.front().next_call > now) {
+      timers_cv_.wait_until(lock, heap_.front().next_call);
+      continue;
+    }
+
+    std::pop_heap(heap_.begin(), heap_.end(), later);
+    auto timer = heap_.back().timer.lock();
+    heap_.pop_back();
+    if (!timer) {
+      continue;
+    }
+    // The entry is outdated if the timer was reset or canceled after being scheduled.
+    bool ready = false;
+    try {
+      ready = timer->is_ready();
+    } catch (const rclcpp::exceptions::RCLError &) {
+    }
+    if (!ready) {
+      schedule_timer_unsafe(timer, now);
+      continue;
+    }
+
+    const bool notify = ready_timers_.empty();
+    ready_timers_.push_back(timer);
+    if (notify) {
+      lock.unlock();
+      on_ready_callback_();
+      lock.lock();
+    }
+  }
+}
+
+void
+TimersManager::schedule_timer_unsafe(
+  const rclcpp::TimerBase::SharedPtr & timer,
+  Clock::time_point now)
+{
+  std::chrono::nanoseconds time_until_trigger;
+  try {
+    if (timer->is_canceled()) {
+      canceled_timers_.push_back(timer);
+      return;
+    }
+    time_until_trigger = timer->time_until_trigger();
+  } catch (const rclcpp::exceptions::RCLError &) {
+    // Most likely canceled by another thread in the meantime.
+    canceled_timers_.push_back(timer);
+    return;
+  }
+  heap_.push_back({now + time_until_trigger, timer});
+  std::push_heap(heap_.begin(), heap_.end(), later);
+}
+
+void
+TimersManager::reschedule_canceled_timers_unsafe(Clock::time_point now)
+{
+  size_t i = 0u;
+  while (i < canceled_timers_.size()) {
+    auto timer = canceled_timers_[i].lock();
+    bool canceled = true;
+    if (timer) {
+      try {
+        canceled = timer->is_canceled();
+      } catch (const rclcpp::exceptions::RCLError &) {
+      }
+    }
+    if (timer && canceled) {
+      ++i;
+      continue;
+    }
+    canceled_timers_[i] = std::move(canceled_timers_.back());
+    canceled_timers_.pop_back();
+    if (timer) {
+      schedule_timer_unsafe(timer, now);
+    }
+  }
+}
+
+void
+TimersManager::on_timer_reset()
+{
+  {
+    // Take the lock, so the thread cannot miss the notification between checking and waiting.
+    std::lock_guard<std::mutex> lock(mutex_);
+  }
+  timers_cv_.notify_one();
+}
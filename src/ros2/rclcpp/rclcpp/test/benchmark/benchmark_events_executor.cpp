@@ -0,0 +1,133 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "performance_test_fixture/performance_test_fixture.hpp"
+
+#include "rclcpp/rclcpp.hpp"
+#include "test_msgs/msg/empty.hpp"
+
+using namespace std::chrono_literals;
+using performance_test_fixture::PerformanceTest;
+
+/// Cost of handling a message as a function of the number of entities in the executor.
+/**
+ * A single topic is active while st.range(0) other subscriptions never receive anything.
+ * A wait set based executor pays for every entity on each wake up, while an event driven one
+ * should only pay for the entity which has data.
+ */
+class PerformanceTestExecutorEntities : public PerformanceTest
+{
+public:
+  void SetUp(benchmark::State & st)
+  {
+    rclcpp::init(0, nullptr);
+    callback_count = 0;
+    node = std::make_shared<rclcpp::Node>("my_node");
+
+    auto do_nothing = [](test_msgs::msg::Empty::ConstSharedPtr) {};
+    for (int64_t i = 0; i < st.range(0); i++) {
+      idle_subscriptions.push_back(
+        node->create_subscription<test_msgs::msg::Empty>(
+          "/idle_msgs_" + std::to_string(i), rclcpp::QoS(1), do_nothing));
+    }
+
+    publisher = node->create_publisher<test_msgs::msg::Empty>("/empty_msgs", rclcpp::QoS(10));
+    subscription = node->create_subscription<test_msgs::msg::Empty>(
+      "/empty_msgs", rclcpp::QoS(10),
+      [this](test_msgs::msg::Empty::ConstSharedPtr) {this->callback_count++;});
+    PerformanceTest::SetUp(st);
+  }
+
+  void TearDown(benchmark::State & st)
+  {
+    PerformanceTest::TearDown(st);
+    subscription.reset();
+    idle_subscriptions.clear();
+    publisher.reset();
+    node.reset();
+    rclcpp::shutdown();
+  }
+
+  template<typename ExecutorT>
+  void run_benchmark(ExecutorT & executor, benchmark::State & st)
+  {
+    executor.add_node(node);
+    std::thread spinner([&executor]() {executor.spin();});
+
+    reset_heap_counters();
+
+    int expected = 0;
+    for (auto _ : st) {
+      publisher->publish(empty_msgs);
+      expected++;
+      auto start = std::chrono::steady_clock::now();
+      while (callback_count.load() < expected) {
+        if (std::chrono::steady_clock::now() - start > 10s) {
+          st.SkipWithError("Timed out waiting for messages");
+          break;
+        }
+        std::this_thread::yield();
+      }
+      if (st.error_occurred()) {
+        break;
+      }
+    }
+    st.SetItemsProcessed(static_cast<int64_t>(callback_count.load()));
+
+    executor.cancel();
+    spinner.join();
+  }
+
+  test_msgs::msg::Empty empty_msgs;
+  rclcpp::Node::SharedPtr node;
+  rclcpp::Publisher<test_msgs::msg::Empty>::SharedPtr publisher;
+  rclcpp::Subscription<test_msgs::msg::Empty>::SharedPtr subscription;
+  std::vector<rclcpp::Subscription<test_msgs::msg::Empty>::SharedPtr> idle_subscriptions;
+  std::atomic_int callback_count;
+};
+
+BENCHMARK_DEFINE_F(PerformanceTestExecutorEntities, single_thread_executor_message)(
+  benchmark::State & st)
+{
+  rclcpp::executors::SingleThreadedExecutor executor;
+  run_benchmark(executor, st);
+}
+BENCHMARK_REGISTER_F(PerformanceTestExecutorEntities, single_thread_executor_message)
+->RangeMultiplier(4)->Range(1, 1024)->UseRealTime();
+
+BENCHMARK_DEFINE_F(PerformanceTestExecutorEntities, static_single_thread_executor_message)(
+  benchmark::State & st)
+{
+  rclcpp::executors::StaticSingleThreadedExecutor executor;
+  run_benchmark(executor, st);
+}
+BENCHMARK_REGISTER_F(PerformanceTestExecutorEntities, static_single_thread_executor_message)
+->RangeMultiplier(4)->Range(1, 1024)->UseRealTime();
+
+BENCHMARK_DEFINE_F(PerformanceTestExecutorEntities, events_executor_message)(
+  benchmark::State & st)
+{
+  rclcpp::executors::EventsExecutor executor;
+  run_benchmark(executor, st);
+}
+BENCHMARK_REGISTER_F(PerformanceTestExecutorEntities, events_executor_message)
+->RangeMultiplier(4)->Range(1, 1024)->UseRealTime();
@@ -0,0 +1,120 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "performance_test_fixture/performance_test_fixture.hpp"
+
+#include "rclcpp/experimental/buffers/lock_free_ring_buffer_implementation.hpp"
+#include "rclcpp/experimental/buffers/ring_buffer_implementation.hpp"
+
+using performance_test_fixture::PerformanceTest;
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+using BufferT = std::unique_ptr<Clock::time_point>;
+
+/// Latency from enqueue to dequeue of an intra-process buffer implementation.
+/**
+ * The benchmark thread enqueues time stamps while a consumer thread, standing in for the
+ * executor, dequeues them and records how long each one waited.
+ * st.range(0) additional threads publish into the same buffer, as other publishers would.
+ */
+template<typename BufferImplementationT>
+void
+run_latency_benchmark(benchmark::State & st)
+{
+  BufferImplementationT buffer(10);
+
+  std::atomic_bool done {false};
+  std::vector<int64_t> latencies;
+  latencies.reserve(1000000);
+  std::thread consumer(
+    [&buffer, &done, &latencies]() {
+      while (!done) {
+        if (!buffer.has_data()) {
+          continue;
+        }
+        auto stamp = buffer.dequeue();
+        if (stamp && latencies.size() < latencies.capacity()) {
+          latencies.push_back(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - *stamp).count());
+        }
+      }
+    });
+
+  std::vector<std::thread> publishers;
+  for (int64_t i = 0; i < st.range(0); ++i) {
+    publishers.emplace_back(
+      [&buffer, &done]() {
+        while (!done) {
+          buffer.enqueue(nullptr);
+          std::this_thread::yield();
+        }
+      });
+  }
+
+  for (auto _ : st) {
+    buffer.enqueue(std::make_unique<Clock::time_point>(Clock::now()));
+  }
+
+  done = true;
+  consumer.join();
+  for (auto & publisher : publishers) {
+    publisher.join();
+  }
+
+  if (latencies.empty()) {
+    return;
+  }
+  std::sort(latencies.begin(), latencies.end());
+  auto percentile = [&latencies](double p) {
+      return static_cast<double>(latencies[static_cast<size_t>(p * (latencies.size() - 1))]);
+    };
+  st.counters["latency_p50_ns"] = percentile(0.5);
+  st.counters["latency_p99_ns"] = percentile(0.99);
+  st.counters["latency_p999_ns"] = percentile(0.999);
+  st.counters["latency_max_ns"] = static_cast<double>(latencies.back());
+}
+
+}  // namespace
+
+class PerformanceTestIntraProcessBuffer : public PerformanceTest
+{
+};
+
+BENCHMARK_DEFINE_F(PerformanceTestIntraProcessBuffer, ring_buffer_latency)(
+  benchmark::State & st)
+{
+  run_latency_benchmark<rclcpp::experimental::buffers::RingBufferImplementation<BufferT>>(st);
+}
+BENCHMARK_REGISTER_F(PerformanceTestIntraProcessBuffer, ring_buffer_latency)
+->Arg(0)->Arg(3)->UseRealTime();
+
+BENCHMARK_DEFINE_F(PerformanceTestIntraProcessBuffer, lock_free_ring_buffer_latency)(
+  benchmark::State & st)
+{
+  run_latency_benchmark<
+    rclcpp::experimental::buffers::LockFreeRingBufferImplementation<BufferT>>(st);
+}
+BENCHMARK_REGISTER_F(PerformanceTestIntraProcessBuffer, lock_free_ring_buffer_latency)
+->Arg(0)->Arg(3)->UseRealTime();
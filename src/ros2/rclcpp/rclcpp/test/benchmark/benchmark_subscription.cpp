@@ -0,0 +1,113 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <memory>
+
+#include "performance_test_fixture/performance_test_fixture.hpp"
+
+#include "rclcpp/rclcpp.hpp"
+#include "test_msgs/msg/empty.hpp"
+
+using namespace std::chrono_literals;
+using performance_test_fixture::PerformanceTest;
+
+constexpr size_t kBurstSize = 32u;
+
+/// Throughput of a subscription handling bursts of messages.
+/**
+ * Each iteration publishes kBurstSize messages at once, then spins until all of them were
+ * handled.
+ * st.range(0) is the subscription's take_batch_size, one meaning a wait per message.
+ */
+class PerformanceTestSubscriptionTake : public PerformanceTest
+{
+public:
+  void SetUp(benchmark::State & st)
+  {
+    rclcpp::init(0, nullptr);
+    callback_count = 0u;
+    node = std::make_shared<rclcpp::Node>("my_node");
+
+    rclcpp::PublisherOptions pub_options;
+    pub_options.use_intra_process_comm = rclcpp::IntraProcessSetting::Disable;
+    publisher = node->create_publisher<test_msgs::msg::Empty>(
+      "/empty_msgs", rclcpp::QoS(kBurstSize), pub_options);
+
+    rclcpp::SubscriptionOptions sub_options;
+    sub_options.use_intra_process_comm = rclcpp::IntraProcessSetting::Disable;
+    sub_options.take_batch_size = static_cast<size_t>(st.range(0));
+    subscription = node->create_subscription<test_msgs::msg::Empty>(
+      "/empty_msgs", rclcpp::QoS(kBurstSize),
+      [this](test_msgs::msg::Empty::ConstSharedPtr) {this->callback_count++;}, sub_options);
+    PerformanceTest::SetUp(st);
+  }
+
+  void TearDown(benchmark::State & st)
+  {
+    PerformanceTest::TearDown(st);
+    subscription.reset();
+    publisher.reset();
+    node.reset();
+    rclcpp::shutdown();
+  }
+
+  test_msgs::msg::Empty empty_msgs;
+  rclcpp::Node::SharedPtr node;
+  rclcpp::Publisher<test_msgs::msg::Empty>::SharedPtr publisher;
+  rclcpp::Subscription<test_msgs::msg::Empty>::SharedPtr subscription;
+  size_t callback_count;
+};
+
+BENCHMARK_DEFINE_F(PerformanceTestSubscriptionTake, burst)(benchmark::State & st)
+{
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(node);
+
+  // Warm up, so discovery is done before measuring.
+  publisher->publish(empty_msgs);
+  auto start = std::chrono::steady_clock::now();
+  while (callback_count == 0u && std::chrono::steady_clock::now() - start < 10s) {
+    executor.spin_some(10ms);
+  }
+  if (callback_count == 0u) {
+    st.SkipWithError("Timed out waiting for the first message");
+    return;
+  }
+
+  callback_count = 0u;
+  reset_heap_counters();
+
+  size_t expected = 0u;
+  for (auto _ : st) {
+    for (size_t i = 0u; i < kBurstSize; ++i) {
+      publisher->publish(empty_msgs);
+    }
+    expected += kBurstSize;
+    start = std::chrono::steady_clock::now();
+    while (callback_count < expected) {
+      if (std::chrono::steady_clock::now() - start > 10s) {
+        st.SkipWithError("Timed out waiting for messages");
+        break;
+      }
+      executor.spin_some();
+    }
+    if (st.error_occurred()) {
+      break;
+    }
+  }
+  st.SetItemsProcessed(static_cast<int64_t>(callback_count));
+}
+BENCHMARK_REGISTER_F(PerformanceTestSubscriptionTake, burst)
+->Arg(1)->Arg(8)->Arg(32)->UseRealTime();
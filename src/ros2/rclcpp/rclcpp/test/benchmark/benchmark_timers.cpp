@@ -0,0 +1,149 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "performance_test_fixture/performance_test_fixture.hpp"
+
+#include "rclcpp/rclcpp.hpp"
+
+using namespace std::chrono_literals;
+using performance_test_fixture::PerformanceTest;
+
+/// Wake up jitter of a timer as a function of the number of timers in the executor.
+/**
+ * A probe timer fires every millisecond while st.range(0) other timers have a period long
+ * enough to never fire during the benchmark.
+ * Each iteration waits for one call of the probe timer and records how far the time since the
+ * previous call is from the period.
+ */
+class PerformanceTestTimerJitter : public PerformanceTest
+{
+public:
+  void SetUp(benchmark::State & st)
+  {
+    rclcpp::init(0, nullptr);
+    node = std::make_shared<rclcpp::Node>("my_node");
+
+    for (int64_t i = 0; i < st.range(0); i++) {
+      idle_timers.push_back(node->create_wall_timer(1h, []() {}));
+    }
+
+    call_count = 0;
+    jitters.clear();
+    jitters.reserve(1000000);
+    probe_timer = node->create_wall_timer(
+      period, [this]() {
+        auto now = std::chrono::steady_clock::now();
+        if (call_count > 0 && jitters.size() < jitters.capacity()) {
+          auto jitter = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            now - last_call - period).count();
+          jitters.push_back(std::abs(jitter));
+        }
+        last_call = now;
+        call_count++;
+      });
+    PerformanceTest::SetUp(st);
+  }
+
+  void TearDown(benchmark::State & st)
+  {
+    PerformanceTest::TearDown(st);
+    probe_timer.reset();
+    idle_timers.clear();
+    node.reset();
+    rclcpp::shutdown();
+  }
+
+  template<typename ExecutorT>
+  void run_benchmark(ExecutorT & executor, benchmark::State & st)
+  {
+    executor.add_node(node);
+    std::thread spinner([&executor]() {executor.spin();});
+
+    reset_heap_counters();
+
+    int expected = call_count.load();
+    for (auto _ : st) {
+      expected++;
+      auto start = std::chrono::steady_clock::now();
+      while (call_count.load() < expected) {
+        if (std::chrono::steady_clock::now() - start > 10s) {
+          st.SkipWithError("Timed out waiting for the timer");
+          break;
+        }
+        std::this_thread::yield();
+      }
+      if (st.error_occurred()) {
+        break;
+      }
+    }
+
+    executor.cancel();
+    spinner.join();
+
+    if (jitters.empty()) {
+      return;
+    }
+    std::sort(jitters.begin(), jitters.end());
+    auto percentile = [this](double p) {
+        return static_cast<double>(jitters[static_cast<size_t>(p * (jitters.size() - 1))]);
+      };
+    st.counters["jitter_p50_ns"] = percentile(0.5);
+    st.counters["jitter_p99_ns"] = percentile(0.99);
+    st.counters["jitter_max_ns"] = static_cast<double>(jitters.back());
+  }
+
+  const std::chrono::nanoseconds period{1ms};
+  rclcpp::Node::SharedPtr node;
+  rclcpp::TimerBase::SharedPtr probe_timer;
+  std::vector<rclcpp::TimerBase::SharedPtr> idle_timers;
+  std::atomic_int call_count;
+  std::chrono::steady_clock::time_point last_call;
+  std::vector<int64_t> jitters;
+};
+
+BENCHMARK_DEFINE_F(PerformanceTestTimerJitter, single_thread_executor_timer)(
+  benchmark::State & st)
+{
+  rclcpp::executors::SingleThreadedExecutor executor;
+  run_benchmark(executor, st);
+}
+BENCHMARK_REGISTER_F(PerformanceTestTimerJitter, single_thread_executor_timer)
+->RangeMultiplier(4)->Range(1, 1024)->UseRealTime();
+
+BENCHMARK_DEFINE_F(PerformanceTestTimerJitter, static_single_thread_executor_timer)(
+  benchmark::State & st)
+{
+  rclcpp::executors::StaticSingleThreadedExecutor executor;
+  run_benchmark(executor, st);
+}
+BENCHMARK_REGISTER_F(PerformanceTestTimerJitter, static_single_thread_executor_timer)
+->RangeMultiplier(4)->Range(1, 1024)->UseRealTime();
+
+BENCHMARK_DEFINE_F(PerformanceTestTimerJitter, events_executor_timer)(
+  benchmark::State & st)
+{
+  rclcpp::executors::EventsExecutor executor;
+  run_benchmark(executor, st);
+}
+BENCHMARK_REGISTER_F(PerformanceTestTimerJitter, events_executor_timer)
+->RangeMultiplier(4)->Range(1, 1024)->UseRealTime();
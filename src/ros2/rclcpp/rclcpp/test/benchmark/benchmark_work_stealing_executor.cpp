@@ -0,0 +1,145 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "performance_test_fixture/performance_test_fixture.hpp"
+
+#include "rclcpp/rclcpp.hpp"
+#include "test_msgs/msg/empty.hpp"
+
+using namespace std::chrono_literals;
+using performance_test_fixture::PerformanceTest;
+
+constexpr unsigned int kNumberOfNodes = 16;
+constexpr unsigned int kMessagesPerNode = 8;
+// Simulated cost of a callback, so the benchmark measures how well work is spread over the
+// threads rather than only the dispatch overhead.
+constexpr std::chrono::microseconds kCallbackWork = 20us;
+
+/// Throughput of the multi-threaded executors as a function of the number of threads.
+/**
+ * Every iteration publishes kMessagesPerNode messages on each of the kNumberOfNodes topics and
+ * waits until all of them have been handled by a spinning executor.
+ * The subscriptions use a reentrant callback group, so the only limit on parallelism is the
+ * executor itself.
+ */
+class PerformanceTestMultiThreadedExecutors : public PerformanceTest
+{
+public:
+  void SetUp(benchmark::State & st)
+  {
+    rclcpp::init(0, nullptr);
+    callback_count = 0;
+    for (unsigned int i = 0u; i < kNumberOfNodes; i++) {
+      nodes.push_back(std::make_shared<rclcpp::Node>("my_node_" + std::to_string(i)));
+      auto group = nodes[i]->create_callback_group(rclcpp::CallbackGroupType::Reentrant);
+
+      publishers.push_back(
+        nodes[i]->create_publisher<test_msgs::msg::Empty>(
+          "/empty_msgs_" + std::to_string(i), rclcpp::QoS(kMessagesPerNode * 2)));
+
+      auto callback = [this](test_msgs::msg::Empty::ConstSharedPtr) {
+          auto start = std::chrono::steady_clock::now();
+          while (std::chrono::steady_clock::now() - start < kCallbackWork) {
+          }
+          this->callback_count++;
+        };
+      rclcpp::SubscriptionOptions options;
+      options.callback_group = group;
+      subscriptions.push_back(
+        nodes[i]->create_subscription<test_msgs::msg::Empty>(
+          "/empty_msgs_" + std::to_string(i), rclcpp::QoS(kMessagesPerNode * 2),
+          std::move(callback), options));
+    }
+    PerformanceTest::SetUp(st);
+  }
+
+  void TearDown(benchmark::State & st)
+  {
+    PerformanceTest::TearDown(st);
+    subscriptions.clear();
+    publishers.clear();
+    nodes.clear();
+    rclcpp::shutdown();
+  }
+
+  template<typename ExecutorT>
+  void run_benchmark(ExecutorT & executor, benchmark::State & st)
+  {
+    for (auto & node : nodes) {
+      executor.add_node(node);
+    }
+    std::thread spinner([&executor]() {executor.spin();});
+
+    reset_heap_counters();
+
+    int expected = 0;
+    for (auto _ : st) {
+      expected += static_cast<int>(kNumberOfNodes * kMessagesPerNode);
+      for (unsigned int j = 0u; j < kMessagesPerNode; j++) {
+        for (auto & publisher : publishers) {
+          publisher->publish(empty_msgs);
+        }
+      }
+      auto start = std::chrono::steady_clock::now();
+      while (callback_count.load() < expected) {
+        if (std::chrono::steady_clock::now() - start > 10s) {
+          st.SkipWithError("Timed out waiting for messages");
+          break;
+        }
+        std::this_thread::yield();
+      }
+      if (st.error_occurred()) {
+        break;
+      }
+    }
+    st.SetItemsProcessed(static_cast<int64_t>(callback_count.load()));
+
+    executor.cancel();
+    spinner.join();
+  }
+
+  test_msgs::msg::Empty empty_msgs;
+  std::vector<rclcpp::Node::SharedPtr> nodes;
+  std::vector<rclcpp::Publisher<test_msgs::msg::Empty>::SharedPtr> publishers;
+  std::vector<rclcpp::Subscription<test_msgs::msg::Empty>::SharedPtr> subscriptions;
+  std::atomic_int callback_count;
+};
+
+BENCHMARK_DEFINE_F(PerformanceTestMultiThreadedExecutors, multi_thread_executor_throughput)(
+  benchmark::State & st)
+{
+  rclcpp::executors::MultiThreadedExecutor executor(
+    rclcpp::ExecutorOptions(), static_cast<size_t>(st.range(0)));
+  run_benchmark(executor, st);
+}
+BENCHMARK_REGISTER_F(PerformanceTestMultiThreadedExecutors, multi_thread_executor_throughput)
+->RangeMultiplier(2)->Range(1, 32)->UseRealTime();
+
+BENCHMARK_DEFINE_F(PerformanceTestMultiThreadedExecutors, work_stealing_executor_throughput)(
+  benchmark::State & st)
+{
+  rclcpp::executors::WorkStealingExecutor executor(
+    rclcpp::ExecutorOptions(), static_cast<size_t>(st.range(0)));
+  run_benchmark(executor, st);
+}
+BENCHMARK_REGISTER_F(PerformanceTestMultiThreadedExecutors, work_stealing_executor_throughput)
+->RangeMultiplier(2)->Range(1, 32)->UseRealTime();
@@ -0,0 +1,321 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rclcpp/detail/bounded_mpsc_queue.hpp"
+#include "rclcpp/executors.hpp"
+#include "rclcpp/rclcpp.hpp"
+
+#include "test_msgs/msg/empty.hpp"
+#include "test_msgs/srv/empty.hpp"
+
+using namespace std::chrono_literals;
+
+class TestEventsExecutor : public ::testing::Test
+{
+protected:
+  static void SetUpTestCase()
+  {
+    rclcpp::init(0, nullptr);
+  }
+
+  static void TearDownTestCase()
+  {
+    rclcpp::shutdown();
+  }
+
+  /// Spin the executor in a thread until the condition holds or a timeout expires.
+  template<typename ConditionT>
+  bool
+  spin_until(rclcpp::executors::EventsExecutor & executor, ConditionT condition)
+  {
+    std::thread spinner([&executor]() {executor.spin();});
+    auto start = std::chrono::steady_clock::now();
+    while (!condition() && std::chrono::steady_clock::now() - start < 10s) {
+      std::this_thread::sleep_for(10ms);
+    }
+    executor.cancel();
+    spinner.join();
+    return condition();
+  }
+};
+
+TEST(TestBoundedMPSCQueue, push_and_pop) {
+  EXPECT_THROW(rclcpp::detail::BoundedMPSCQueue<uint64_t>(0u), std::invalid_argument);
+
+  rclcpp::detail::BoundedMPSCQueue<uint64_t> queue(3u);
+  EXPECT_EQ(4u, queue.capacity());
+  EXPECT_TRUE(queue.empty());
+  uint64_t value = 0u;
+  EXPECT_FALSE(queue.pop(value));
+
+  for (uint64_t i = 0u; i < 4u; ++i) {
+    EXPECT_TRUE(queue.push(i));
+  }
+  EXPECT_FALSE(queue.push(4u));
+  EXPECT_FALSE(queue.empty());
+
+  // Elements come out in the order they were pushed.
+  ASSERT_TRUE(queue.pop(value));
+  EXPECT_EQ(0u, value);
+  EXPECT_TRUE(queue.push(4u));
+  for (uint64_t i = 1u; i < 5u; ++i) {
+    ASSERT_TRUE(queue.pop(value));
+    EXPECT_EQ(i, value);
+  }
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(TestBoundedMPSCQueue, concurrent_push) {
+  constexpr uint64_t kElements = 100000u;
+  constexpr uint64_t kProducers = 4u;
+  rclcpp::detail::BoundedMPSCQueue<uint64_t> queue(64u);
+
+  std::vector<std::thread> producers;
+  for (uint64_t producer = 0u; producer < kProducers; ++producer) {
+    producers.emplace_back(
+      [&queue, producer]() {
+        for (uint64_t i = 0u; i < kElements; ++i) {
+          while (!queue.push(producer * kElements + i)) {
+            std::this_thread::yield();
+          }
+        }
+      });
+  }
+
+  // Every producer's elements must come out complete and in order.
+  std::vector<uint64_t> next(kProducers, 0u);
+  uint64_t popped = 0u;
+  while (popped < kElements * kProducers) {
+    uint64_t value;
+    if (!queue.pop(value)) {
+      std::this_thread::yield();
+      continue;
+    }
+    const uint64_t producer = value / kElements;
+    ASSERT_LT(producer, kProducers);
+    ASSERT_EQ(next[producer], value % kElements);
+    ++next[producer];
+    ++popped;
+  }
+  for (auto & producer : producers) {
+    producer.join();
+  }
+  EXPECT_TRUE(queue.empty());
+}
+
+/*
+   Test that every message of a burst is executed, not only one per event.
+ */
+TEST_F(TestEventsExecutor, subscription_burst) {
+  rclcpp::executors::EventsExecutor executor;
+  auto node = std::make_shared<rclcpp::Node>("test_events_executor_subscription_burst");
+
+  rclcpp::SubscriptionOptions sub_options;
+  sub_options.use_intra_process_comm = rclcpp::IntraProcessSetting::Disable;
+  std::atomic_int count {0};
+  auto subscription = node->create_subscription<test_msgs::msg::Empty>(
+    "topic", rclcpp::QoS(100),
+    [&count](test_msgs::msg::Empty::ConstSharedPtr) {count++;}, sub_options);
+
+  rclcpp::PublisherOptions pub_options;
+  pub_options.use_intra_process_comm = rclcpp::IntraProcessSetting::Disable;
+  auto publisher = node->create_publisher<test_msgs::msg::Empty>(
+    "topic", rclcpp::QoS(100), pub_options);
+
+  executor.add_node(node);
+  // Published before spinning, so the executor learns about them when registering callbacks.
+  for (int i = 0; i < 10; ++i) {
+    publisher->publish(test_msgs::msg::Empty());
+  }
+  EXPECT_TRUE(spin_until(executor, [&count]() {return count >= 10;}));
+
+  for (int i = 0; i < 50; ++i) {
+    publisher->publish(test_msgs::msg::Empty());
+  }
+  EXPECT_TRUE(spin_until(executor, [&count]() {return count >= 60;}));
+  EXPECT_EQ(60, count.load());
+}
+
+/*
+   Test entities created while spinning, which are picked up through the node guard condition.
+ */
+TEST_F(TestEventsExecutor, entities_added_while_spinning) {
+  rclcpp::executors::EventsExecutor executor;
+  auto node = std::make_shared<rclcpp::Node>("test_events_executor_entities_added");
+  executor.add_node(node);
+
+  std::atomic_int count {0};
+  std::thread spinner([&executor]() {executor.spin();});
+
+  auto subscription = node->create_subscription<test_msgs::msg::Empty>(
+    "topic", rclcpp::QoS(10), [&count](test_msgs::msg::Empty::ConstSharedPtr) {count++;});
+  auto publisher = node->create_publisher<test_msgs::msg::Empty>("topic", rclcpp::QoS(10));
+
+  auto start = std::chrono::steady_clock::now();
+  while (count == 0 && std::chrono::steady_clock::now() - start < 10s) {
+    publisher->publish(test_msgs::msg::Empty());
+    std::this_thread::sleep_for(50ms);
+  }
+  executor.cancel();
+  spinner.join();
+  EXPECT_GT(count.load(), 0);
+}
+
+/*
+   Test a service and a client served by the same executor.
+ */
+TEST_F(TestEventsExecutor, service_and_client) {
+  rclcpp::executors::EventsExecutor executor;
+  auto node = std::make_shared<rclcpp::Node>("test_events_executor_service_and_client");
+
+  std::atomic_int requests {0};
+  auto service = node->create_service<test_msgs::srv::Empty>(
+    "service",
+    [&requests](
+      const test_msgs::srv::Empty::Request::SharedPtr,
+      test_msgs::srv::Empty::Response::SharedPtr) {requests++;});
+  auto client = node->create_client<test_msgs::srv::Empty>("service");
+  ASSERT_TRUE(client->wait_for_service(10s));
+
+  executor.add_node(node);
+  std::atomic_int responses {0};
+  for (int i = 0; i < 5; ++i) {
+    client->async_send_request(
+      std::make_shared<test_msgs::srv::Empty::Request>(),
+      [&responses](rclcpp::Client<test_msgs::srv::Empty>::SharedFuture) {responses++;});
+  }
+  EXPECT_TRUE(spin_until(executor, [&responses]() {return responses >= 5;}));
+  EXPECT_EQ(5, requests.load());
+  EXPECT_EQ(5, responses.load());
+}
+
+/*
+   Test intra-process subscriptions, which are waitables handled through the helper wait set.
+ */
+TEST_F(TestEventsExecutor, intra_process_subscription) {
+  rclcpp::executors::EventsExecutor executor;
+  auto node = std::make_shared<rclcpp::Node>(
+    "test_events_executor_intra_process",
+    rclcpp::NodeOptions().use_intra_process_comms(true));
+
+  std::atomic_int count {0};
+  auto subscription = node->create_subscription<test_msgs::msg::Empty>(
+    "topic", rclcpp::QoS(10), [&count](test_msgs::msg::Empty::ConstSharedPtr) {count++;});
+  auto publisher = node->create_publisher<test_msgs::msg::Empty>("topic", rclcpp::QoS(10));
+
+  executor.add_node(node);
+  for (int i = 0; i < 5; ++i) {
+    publisher->publish(test_msgs::msg::Empty());
+  }
+  EXPECT_TRUE(spin_until(executor, [&count]() {return count >= 5;}));
+  EXPECT_EQ(5, count.load());
+}
+
+/*
+   Test that a destroyed subscription no longer notifies the executor.
+ */
+TEST_F(TestEventsExecutor, subscription_destroyed_while_spinning) {
+  rclcpp::executors::EventsExecutor executor;
+  auto node = std::make_shared<rclcpp::Node>("test_events_executor_subscription_destroyed");
+
+  std::atomic_int count {0};
+  auto subscription = node->create_subscription<test_msgs::msg::Empty>(
+    "topic", rclcpp::QoS(10), [&count](test_msgs::msg::Empty::ConstSharedPtr) {count++;});
+  auto publisher = node->create_publisher<test_msgs::msg::Empty>("topic", rclcpp::QoS(10));
+  executor.add_node(node);
+
+  std::thread spinner([&executor]() {executor.spin();});
+  auto start = std::chrono::steady_clock::now();
+  while (count == 0 && std::chrono::steady_clock::now() - start < 10s) {
+    publisher->publish(test_msgs::msg::Empty());
+    std::this_thread::sleep_for(50ms);
+  }
+  subscription.reset();
+  for (int i = 0; i < 10; ++i) {
+    publisher->publish(test_msgs::msg::Empty());
+  }
+  std::this_thread::sleep_for(100ms);
+  executor.cancel();
+  spinner.join();
+  EXPECT_GT(count.load(), 0);
+}
+
+/*
+   Test that steady timers are executed through the timers manager, and can cancel themselves.
+ */
+TEST_F(TestEventsExecutor, timers) {
+  rclcpp::executors::EventsExecutor executor;
+  auto node = std::make_shared<rclcpp::Node>("test_events_executor_timers");
+
+  std::atomic_int count {0};
+  std::atomic_int canceled_count {0};
+  auto timer = node->create_wall_timer(1ms, [&count]() {count++;});
+  rclcpp::TimerBase::SharedPtr canceled_timer;
+  canceled_timer = node->create_wall_timer(
+    1ms, [&canceled_count, &canceled_timer]() {
+      canceled_count++;
+      canceled_timer->cancel();
+    });
+
+  executor.add_node(node);
+  EXPECT_TRUE(spin_until(executor, [&count]() {return count >= 20;}));
+  EXPECT_EQ(1, canceled_count.load());
+}
+
+/*
+   Test that destroying an executor a node was removed from keeps it notifying its new executor.
+ */
+TEST_F(TestEventsExecutor, node_moved_between_executors) {
+  auto first_executor = std::make_unique<rclcpp::executors::EventsExecutor>();
+  rclcpp::executors::EventsExecutor second_executor;
+  auto node = std::make_shared<rclcpp::Node>("test_events_executor_node_moved");
+
+  std::atomic_int count {0};
+  auto subscription = node->create_subscription<test_msgs::msg::Empty>(
+    "topic", rclcpp::QoS(10), [&count](test_msgs::msg::Empty::ConstSharedPtr) {count++;});
+  auto publisher = node->create_publisher<test_msgs::msg::Empty>("topic", rclcpp::QoS(10));
+
+  first_executor->add_node(node);
+  publisher->publish(test_msgs::msg::Empty());
+  EXPECT_TRUE(spin_until(*first_executor, [&count]() {return count >= 1;}));
+  first_executor->remove_node(node);
+  second_executor.add_node(node);
+
+  auto publish_until = [&publisher, &count](int expected) {
+      auto start = std::chrono::steady_clock::now();
+      while (count < expected && std::chrono::steady_clock::now() - start < 10s) {
+        publisher->publish(test_msgs::msg::Empty());
+        std::this_thread::sleep_for(50ms);
+      }
+      return count >= expected;
+    };
+  std::thread spinner([&second_executor]() {second_executor.spin();});
+  EXPECT_TRUE(publish_until(2));
+  // Must not clear the callbacks registered by the second executor.
+  first_executor.reset();
+  const int received = count.load();
+  EXPECT_TRUE(publish_until(received + 5));
+  second_executor.cancel();
+  spinner.join();
+}
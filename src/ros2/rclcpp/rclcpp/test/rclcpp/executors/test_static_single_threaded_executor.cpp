@@ -18,12 +18,19 @@
 #include <future>
 #include <memory>
 #include <stdexcept>
+#include <thread>
+
+#include "osrf_testing_tools_cpp/memory_tools/memory_tools.hpp"
+#include "osrf_testing_tools_cpp/memory_tools/testing_helpers.hpp"
+#include "osrf_testing_tools_cpp/scope_exit.hpp"
 
 #include "rclcpp/exceptions.hpp"
 #include "rclcpp/node.hpp"
 #include "rclcpp/rclcpp.hpp"
 #include "rclcpp/executors.hpp"
+#include "rclcpp/strategies/message_pool_memory_strategy.hpp"
 
+#include "test_msgs/msg/empty.hpp"
 #include "test_msgs/srv/empty.hpp"
 
 #include "../../mocking_utils/patch.hpp"
@@ -140,3 +147,66 @@ TEST_F(TestStaticSingleThreadedExecutor, execute_service) {
   executor.remove_node(node);
   executor.spin_until_future_complete(future, std::chrono::milliseconds(1));
 }
+
+/*
+   Test that, once the entities are collected, spinning does not allocate.
+   Only the spinning thread is monitored, the middleware's own threads are out of scope.
+ */
+TEST_F(TestStaticSingleThreadedExecutor, spin_some_without_memory_operations) {
+  using MessagePoolMemoryStrategy =
+    rclcpp::strategies::message_pool_memory_strategy::MessagePoolMemoryStrategy<
+    test_msgs::msg::Empty, 1>;
+
+  rclcpp::executors::StaticSingleThreadedExecutor executor;
+  auto node = std::make_shared<rclcpp::Node>("node", "ns");
+
+  size_t timer_count = 0u;
+  auto timer = node->create_wall_timer(0ms, [&timer_count]() {++timer_count;});
+  size_t message_count = 0u;
+  auto subscription = node->create_subscription<test_msgs::msg::Empty>(
+    "topic", rclcpp::QoS(10),
+    [&message_count](test_msgs::msg::Empty::ConstSharedPtr) {++message_count;},
+    rclcpp::SubscriptionOptions(), std::make_shared<MessagePoolMemoryStrategy>());
+  auto publisher = node->create_publisher<test_msgs::msg::Empty>("topic", rclcpp::QoS(10));
+  executor.add_node(node);
+
+  // Spin until the first message is received, so discovery is done.
+  publisher->publish(test_msgs::msg::Empty());
+  auto start = std::chrono::steady_clock::now();
+  while (message_count == 0u && std::chrono::steady_clock::now() - start < 10s) {
+    executor.spin_some();
+  }
+  ASSERT_EQ(1u, message_count);
+  for (size_t i = 0u; i < 5u; ++i) {
+    publisher->publish(test_msgs::msg::Empty());
+  }
+  std::this_thread::sleep_for(100ms);
+
+  osrf_testing_tools_cpp::memory_tools::initialize();
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    osrf_testing_tools_cpp::memory_tools::uninitialize();
+  });
+  osrf_testing_tools_cpp::memory_tools::on_unexpected_malloc(
+    []() {ADD_FAILURE() << "UNEXPECTED MALLOC";});
+  osrf_testing_tools_cpp::memory_tools::on_unexpected_realloc(
+    []() {ADD_FAILURE() << "UNEXPECTED REALLOC";});
+  osrf_testing_tools_cpp::memory_tools::on_unexpected_calloc(
+    []() {ADD_FAILURE() << "UNEXPECTED CALLOC";});
+  osrf_testing_tools_cpp::memory_tools::on_unexpected_free(
+    []() {ADD_FAILURE() << "UNEXPECTED FREE";});
+  osrf_testing_tools_cpp::memory_tools::enable_monitoring();
+  ASSERT_TRUE(osrf_testing_tools_cpp::memory_tools::is_working());
+
+  timer_count = 0u;
+  EXPECT_NO_MEMORY_OPERATIONS(
+  {
+    for (size_t i = 0u; i < 100000u; ++i) {
+      executor.spin_some();
+    }
+  });
+  osrf_testing_tools_cpp::memory_tools::disable_monitoring();
+
+  EXPECT_EQ(100000u, timer_count);
+  EXPECT_EQ(6u, message_count);
+}
@@ -0,0 +1,215 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rclcpp/detail/work_stealing_queue.hpp"
+#include "rclcpp/exceptions.hpp"
+#include "rclcpp/node.hpp"
+#include "rclcpp/rclcpp.hpp"
+#include "rclcpp/executors.hpp"
+
+using namespace std::chrono_literals;
+
+class TestWorkStealingExecutor : public ::testing::Test
+{
+protected:
+  static void SetUpTestCase()
+  {
+    rclcpp::init(0, nullptr);
+  }
+
+  static void TearDownTestCase()
+  {
+    rclcpp::shutdown();
+  }
+};
+
+constexpr std::chrono::milliseconds PERIOD_MS = 1000ms;
+constexpr double PERIOD = PERIOD_MS.count() / 1000.0;
+constexpr double TOLERANCE = PERIOD / 4.0;
+
+TEST(TestWorkStealingQueue, push_and_steal) {
+  EXPECT_THROW(rclcpp::detail::WorkStealingQueue<int>(0u), std::invalid_argument);
+
+  rclcpp::detail::WorkStealingQueue<int> queue(3u);
+  EXPECT_EQ(4u, queue.capacity());
+  EXPECT_TRUE(queue.empty());
+  EXPECT_EQ(nullptr, queue.steal());
+
+  int values[5] = {0, 1, 2, 3, 4};
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(queue.push(&values[i]));
+  }
+  EXPECT_FALSE(queue.push(&values[4]));
+  EXPECT_EQ(4u, queue.size());
+
+  // Elements come out in the order they were pushed.
+  EXPECT_EQ(&values[0], queue.steal());
+  EXPECT_TRUE(queue.push(&values[4]));
+  for (int i = 1; i < 5; ++i) {
+    EXPECT_EQ(&values[i], queue.steal());
+  }
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(TestWorkStealingQueue, concurrent_steal) {
+  constexpr size_t kElements = 100000u;
+  constexpr size_t kThieves = 4u;
+  rclcpp::detail::WorkStealingQueue<size_t> queue(64u);
+  std::vector<size_t> elements(kElements);
+  std::vector<std::atomic_int> taken(kElements);
+  std::atomic_size_t total_taken{0u};
+  std::atomic_bool done{false};
+
+  std::vector<std::thread> thieves;
+  for (size_t i = 0; i < kThieves; ++i) {
+    thieves.emplace_back(
+      [&]() {
+        while (!done.load() || !queue.empty()) {
+          size_t * element = queue.steal();
+          if (element) {
+            taken[*element]++;
+            total_taken++;
+          } else {
+            std::this_thread::yield();
+          }
+        }
+      });
+  }
+  for (size_t i = 0; i < kElements; ++i) {
+    elements[i] = i;
+    while (!queue.push(&elements[i])) {
+      std::this_thread::yield();
+    }
+  }
+  done.store(true);
+  for (auto & thief : thieves) {
+    thief.join();
+  }
+
+  EXPECT_EQ(kElements, total_taken.load());
+  for (size_t i = 0; i < kElements; ++i) {
+    EXPECT_EQ(1, taken[i].load()) << "element " << i;
+  }
+}
+
+/*
+   Test that timers are not taken multiple times when using reentrant callback groups.
+ */
+TEST_F(TestWorkStealingExecutor, timer_over_take) {
+  rclcpp::executors::WorkStealingExecutor executor(rclcpp::ExecutorOptions(), 4u);
+
+  ASSERT_EQ(4u, executor.get_number_of_threads());
+
+  std::shared_ptr<rclcpp::Node> node =
+    std::make_shared<rclcpp::Node>("test_work_stealing_executor_timer_over_take");
+
+  auto cbg = node->create_callback_group(rclcpp::CallbackGroupType::Reentrant);
+
+  rclcpp::Clock system_clock(RCL_STEADY_TIME);
+  std::mutex last_mutex;
+  auto last = system_clock.now();
+
+  std::atomic_int timer_count {0};
+
+  auto timer_callback = [&timer_count, &executor, &system_clock, &last_mutex, &last]() {
+      rclcpp::Time now = system_clock.now();
+      timer_count++;
+
+      if (timer_count > 5) {
+        executor.cancel();
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(last_mutex);
+        double diff = static_cast<double>(std::abs((now - last).nanoseconds())) / 1.0e9;
+        last = now;
+
+        if (diff < PERIOD - TOLERANCE) {
+          executor.cancel();
+          ASSERT_GT(diff, PERIOD - TOLERANCE);
+        }
+      }
+    };
+
+  auto timer = node->create_wall_timer(PERIOD_MS, timer_callback, cbg);
+  executor.add_node(node);
+  executor.spin();
+}
+
+/*
+   Test that callbacks of a mutually exclusive callback group never run concurrently,
+   while callbacks of a reentrant callback group do.
+ */
+TEST_F(TestWorkStealingExecutor, callback_group_exclusivity) {
+  rclcpp::executors::WorkStealingExecutor executor(rclcpp::ExecutorOptions(), 4u);
+
+  std::shared_ptr<rclcpp::Node> node =
+    std::make_shared<rclcpp::Node>("test_work_stealing_executor_callback_group_exclusivity");
+
+  auto exclusive_cbg = node->create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive);
+  auto reentrant_cbg = node->create_callback_group(rclcpp::CallbackGroupType::Reentrant);
+
+  std::atomic_int exclusive_running {0};
+  std::atomic_int exclusive_max_running {0};
+  std::atomic_int reentrant_running {0};
+  std::atomic_int reentrant_max_running {0};
+  std::atomic_int count {0};
+
+  auto make_callback = [&count](std::atomic_int & running, std::atomic_int & max_running) {
+      return [&count, &running, &max_running]() {
+               int now_running = ++running;
+               int previous_max = max_running.load();
+               while (now_running > previous_max &&
+                 !max_running.compare_exchange_weak(previous_max, now_running))
+               {
+               }
+               std::this_thread::sleep_for(20ms);
+               --running;
+               ++count;
+             };
+    };
+
+  std::vector<rclcpp::TimerBase::SharedPtr> timers;
+  for (int i = 0; i < 4; ++i) {
+    timers.push_back(
+      node->create_wall_timer(
+        1ms, make_callback(exclusive_running, exclusive_max_running), exclusive_cbg));
+    timers.push_back(
+      node->create_wall_timer(
+        1ms, make_callback(reentrant_running, reentrant_max_running), reentrant_cbg));
+  }
+  executor.add_node(node);
+
+  std::thread spinner([&executor]() {executor.spin();});
+  auto start = std::chrono::steady_clock::now();
+  while (count < 40 && std::chrono::steady_clock::now() - start < 10s) {
+    std::this_thread::sleep_for(10ms);
+  }
+  executor.cancel();
+  spinner.join();
+
+  EXPECT_GE(count.load(), 40);
+  EXPECT_EQ(1, exclusive_max_running.load());
+  EXPECT_GT(reentrant_max_running.load(), 1);
+}
@@ -15,6 +15,7 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -192,6 +193,45 @@ TEST(TestIntraProcessBuffer, shared_buffer_consume) {
   EXPECT_NE(original_message_pointer, popped_message_pointer);
 }
 
+/*
+  Consume unique_ptr from an intra-process buffer with an implementations that stores shared_ptr
+  - Request unique_ptr while the message is still shared, its content is expected to be copied
+  - Request unique_ptr of a message held only by the buffer, its content is expected to be moved
+ */
+TEST(TestIntraProcessBuffer, shared_buffer_consume_unique_copy_on_write) {
+  using MessageT = std::vector<char>;
+  using Alloc = std::allocator<void>;
+  using Deleter = std::default_delete<MessageT>;
+  using SharedMessageT = std::shared_ptr<const MessageT>;
+  using UniqueMessageT = std::unique_ptr<MessageT, Deleter>;
+  using SharedIntraProcessBufferT = rclcpp::experimental::buffers::TypedIntraProcessBuffer<
+    MessageT, Alloc, Deleter, SharedMessageT>;
+
+  auto buffer_impl =
+    std::make_unique<rclcpp::experimental::buffers::RingBufferImplementation<SharedMessageT>>(2);
+
+  SharedIntraProcessBufferT intra_process_buffer(std::move(buffer_impl));
+
+  SharedMessageT original_shared_msg = std::make_shared<MessageT>(1024u, 'a');
+  auto original_data_pointer = reinterpret_cast<std::uintptr_t>(original_shared_msg->data());
+
+  intra_process_buffer.add_shared(original_shared_msg);
+
+  UniqueMessageT popped_unique_msg = intra_process_buffer.consume_unique();
+  auto popped_data_pointer = reinterpret_cast<std::uintptr_t>(popped_unique_msg->data());
+
+  EXPECT_EQ(*original_shared_msg, *popped_unique_msg);
+  EXPECT_NE(original_data_pointer, popped_data_pointer);
+
+  intra_process_buffer.add_shared(std::move(original_shared_msg));
+
+  popped_unique_msg = intra_process_buffer.consume_unique();
+  popped_data_pointer = reinterpret_cast<std::uintptr_t>(popped_unique_msg->data());
+
+  EXPECT_EQ(1024u, popped_unique_msg->size());
+  EXPECT_EQ(original_data_pointer, popped_data_pointer);
+}
+
 /*
   Consume data from an intra-process buffer with an implementations that stores unique_ptr
   Messages are inserted using the same data as the implementation, i.e. unique_ptr
@@ -238,3 +278,32 @@ TEST(TestIntraProcessBuffer, unique_buffer_consume) {
   EXPECT_EQ(original_value, *popped_unique_msg);
   EXPECT_EQ(original_message_pointer, popped_message_pointer);
 }
+
+/*
+  Create intra-process buffers backed by the lock-free ring buffer
+  - Both stored data types are expected to behave as with the default implementation
+ */
+TEST(TestIntraProcessBuffer, create_lock_free_buffer) {
+  using MessageT = char;
+  using Alloc = std::allocator<void>;
+
+  rmw_qos_profile_t qos = rmw_qos_profile_default;
+  qos.depth = 1;
+
+  for (auto buffer_type : {rclcpp::IntraProcessBufferType::SharedPtr,
+      rclcpp::IntraProcessBufferType::UniquePtr})
+  {
+    auto intra_process_buffer = rclcpp::experimental::create_intra_process_buffer<MessageT>(
+      buffer_type, qos, std::make_shared<Alloc>(),
+      rclcpp::IntraProcessBufferImplementation::LockFreeRingBuffer);
+
+    EXPECT_FALSE(intra_process_buffer->has_data());
+    intra_process_buffer->add_unique(std::make_unique<char>('a'));
+    intra_process_buffer->add_unique(std::make_unique<char>('b'));
+    EXPECT_TRUE(intra_process_buffer->has_data());
+
+    auto popped_unique_msg = intra_process_buffer->consume_unique();
+    EXPECT_EQ('b', *popped_unique_msg);
+    EXPECT_FALSE(intra_process_buffer->has_data());
+  }
+}
@@ -14,9 +14,11 @@
 
 #include <gmock/gmock.h>
 
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -673,3 +675,85 @@ TEST(TestIntraProcessManager, multiple_subscriptions_different_type) {
   EXPECT_EQ(original_message_pointer, received_message_pointer_10);
   EXPECT_NE(original_message_pointer, received_message_pointer_11);
 }
+
+/*
+   This tests subscriptions going out of scope without being removed:
+   - Publishes a unique_ptr message with 2 subscriptions requesting ownership.
+   - Destroy one of them without removing it from the intra-process manager.
+   - The other one is expected to still receive messages, while the count is unchanged
+     until the subscription is removed.
+ */
+TEST(TestIntraProcessManager, subscription_out_of_scope) {
+  using IntraProcessManagerT = rclcpp::experimental::IntraProcessManager;
+  using MessageT = rcl_interfaces::msg::Log;
+  using PublisherT = rclcpp::mock::Publisher<MessageT>;
+  using SubscriptionIntraProcessT = rclcpp::experimental::mock::SubscriptionIntraProcess<MessageT>;
+
+  auto ipm = std::make_shared<IntraProcessManagerT>();
+
+  auto p1 = std::make_shared<PublisherT>();
+  auto p1_id = ipm->add_publisher(p1);
+  p1->set_intra_process_manager(p1_id, ipm);
+
+  auto s1 = std::make_shared<SubscriptionIntraProcessT>();
+  s1->take_shared_method = false;
+  auto s1_id = ipm->add_subscription(s1);
+
+  auto s2 = std::make_shared<SubscriptionIntraProcessT>();
+  s2->take_shared_method = false;
+  auto s2_id = ipm->add_subscription(s2);
+  (void)s2_id;
+
+  s1.reset();
+  EXPECT_EQ(nullptr, ipm->get_subscription_intra_process(s1_id));
+  EXPECT_EQ(2u, ipm->get_subscription_count(p1_id));
+
+  auto unique_msg = std::make_unique<MessageT>();
+  auto original_message_pointer = reinterpret_cast<std::uintptr_t>(unique_msg.get());
+  p1->publish(std::move(unique_msg));
+  EXPECT_EQ(original_message_pointer, s2->pop());
+
+  ipm->remove_subscription(s1_id);
+  EXPECT_EQ(1u, ipm->get_subscription_count(p1_id));
+}
+
+/*
+   This tests publishing while subscriptions are added and removed from another thread:
+   - Publishes from one thread while another one adds and removes subscriptions.
+   - A subscription which is always there is expected to receive every message.
+ */
+TEST(TestIntraProcessManager, add_remove_subscriptions_while_publishing) {
+  using IntraProcessManagerT = rclcpp::experimental::IntraProcessManager;
+  using MessageT = rcl_interfaces::msg::Log;
+  using PublisherT = rclcpp::mock::Publisher<MessageT>;
+  using SubscriptionIntraProcessT = rclcpp::experimental::mock::SubscriptionIntraProcess<MessageT>;
+
+  auto ipm = std::make_shared<IntraProcessManagerT>();
+
+  auto p1 = std::make_shared<PublisherT>();
+  auto p1_id = ipm->add_publisher(p1);
+  p1->set_intra_process_manager(p1_id, ipm);
+
+  auto s1 = std::make_shared<SubscriptionIntraProcessT>();
+  s1->take_shared_method = true;
+  ipm->add_subscription(s1);
+
+  std::atomic_bool done {false};
+  std::thread churn([&ipm, &done]() {
+      while (!done) {
+        auto subscription = std::make_shared<SubscriptionIntraProcessT>();
+        subscription->take_shared_method = false;
+        auto id = ipm->add_subscription(subscription);
+        ipm->remove_subscription(id);
+      }
+    });
+
+  for (int i = 0; i < 1000; ++i) {
+    p1->publish(std::make_unique<MessageT>());
+    // Depending on the subscriptions present, s1 gets either the original or a copy.
+    EXPECT_NE(0u, s1->pop());
+  }
+  done = true;
+  churn.join();
+  EXPECT_EQ(1u, ipm->get_subscription_count(p1_id));
+}
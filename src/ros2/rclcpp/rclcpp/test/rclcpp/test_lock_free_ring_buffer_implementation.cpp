@@ -0,0 +1,153 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "rclcpp/experimental/buffers/buffer_implementation_base.hpp"
+#include "rclcpp/experimental/buffers/lock_free_ring_buffer_implementation.hpp"
+
+/*
+   Construtctor
+ */
+TEST(TestLockFreeRingBufferImplementation, constructor) {
+  // Cannot create a buffer of size zero.
+  EXPECT_THROW(
+    rclcpp::experimental::buffers::LockFreeRingBufferImplementation<char> rb(0),
+    std::invalid_argument);
+
+  rclcpp::experimental::buffers::LockFreeRingBufferImplementation<char> rb(1);
+
+  EXPECT_EQ(false, rb.has_data());
+  EXPECT_EQ(false, rb.is_full());
+  EXPECT_THROW(rb.dequeue(), std::runtime_error);
+}
+
+/*
+   Basic usage
+   - insert data and check that it has data
+   - extract data
+   - overwrite old data writing over the buffer capacity
+ */
+TEST(TestLockFreeRingBufferImplementation, basic_usage) {
+  rclcpp::experimental::buffers::LockFreeRingBufferImplementation<char> rb(2);
+
+  rb.enqueue('a');
+
+  EXPECT_EQ(true, rb.has_data());
+  EXPECT_EQ(false, rb.is_full());
+
+  char v = rb.dequeue();
+
+  EXPECT_EQ('a', v);
+  EXPECT_EQ(false, rb.has_data());
+  EXPECT_EQ(false, rb.is_full());
+
+  rb.enqueue('b');
+  rb.enqueue('c');
+
+  EXPECT_EQ(true, rb.has_data());
+  EXPECT_EQ(true, rb.is_full());
+
+  rb.enqueue('d');
+
+  EXPECT_EQ(true, rb.has_data());
+  EXPECT_EQ(true, rb.is_full());
+
+  v = rb.dequeue();
+
+  EXPECT_EQ('c', v);
+  EXPECT_EQ(true, rb.has_data());
+  EXPECT_EQ(false, rb.is_full());
+
+  v = rb.dequeue();
+
+  EXPECT_EQ('d', v);
+  EXPECT_EQ(false, rb.has_data());
+  EXPECT_EQ(false, rb.is_full());
+
+  rb.enqueue('e');
+  rb.enqueue('f');
+  rb.clear();
+
+  EXPECT_EQ(false, rb.has_data());
+}
+
+/*
+   Capacity of one, as used by a keep last history of depth 1
+   - every enqueue replaces the element stored
+ */
+TEST(TestLockFreeRingBufferImplementation, single_element) {
+  rclcpp::experimental::buffers::LockFreeRingBufferImplementation<std::unique_ptr<int>> rb(1);
+
+  for (int i = 0; i < 10; ++i) {
+    rb.enqueue(std::make_unique<int>(i));
+    EXPECT_EQ(true, rb.is_full());
+  }
+  auto v = rb.dequeue();
+  ASSERT_NE(nullptr, v);
+  EXPECT_EQ(9, *v);
+  EXPECT_EQ(false, rb.has_data());
+}
+
+/*
+   Concurrent usage
+   - several producers enqueue into a buffer smaller than what they produce
+   - a consumer dequeues concurrently
+   - elements of each producer are expected in order, and nothing is received twice
+ */
+TEST(TestLockFreeRingBufferImplementation, concurrent_usage) {
+  constexpr uint64_t kElements = 100000u;
+  constexpr uint64_t kProducers = 3u;
+  rclcpp::experimental::buffers::LockFreeRingBufferImplementation<uint64_t> rb(16);
+
+  std::atomic_size_t producers_done {0u};
+  std::vector<std::thread> producers;
+  for (uint64_t producer = 0u; producer < kProducers; ++producer) {
+    producers.emplace_back(
+      [&rb, &producers_done, producer]() {
+        for (uint64_t i = 0u; i < kElements; ++i) {
+          rb.enqueue(producer * kElements + i);
+        }
+        producers_done++;
+      });
+  }
+
+  std::vector<uint64_t> next(kProducers, 0u);
+  uint64_t received = 0u;
+  while (producers_done < kProducers || rb.has_data()) {
+    if (!rb.has_data()) {
+      std::this_thread::yield();
+      continue;
+    }
+    const uint64_t value = rb.dequeue();
+    const uint64_t producer = value / kElements;
+    ASSERT_LT(producer, kProducers);
+    // Elements may be dropped, but never reordered nor duplicated.
+    ASSERT_GE(value % kElements, next[producer]);
+    next[producer] = value % kElements + 1u;
+    ++received;
+  }
+  for (auto & producer : producers) {
+    producer.join();
+  }
+  EXPECT_GT(received, 0u);
+  EXPECT_EQ(false, rb.has_data());
+}
@@ -14,6 +14,7 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
 #include <string>
 #include <memory>
 #include <utility>
@@ -29,6 +30,8 @@
 
 #include "test_msgs/msg/empty.hpp"
 
+using namespace std::chrono_literals;
+
 class TestPublisher : public ::testing::Test
 {
 public:
@@ -393,9 +396,7 @@ TEST_F(TestPublisher, intra_process_publish_failures) {
   std::allocator<void> allocator;
   {
     rclcpp::LoanedMessage<test_msgs::msg::Empty> loaned_msg(*publisher, allocator);
-    RCLCPP_EXPECT_THROW_EQ(
-      publisher->publish(std::move(loaned_msg)),
-      std::runtime_error("storing loaned messages in intra process is not supported yet"));
+    EXPECT_NO_THROW(publisher->publish(std::move(loaned_msg)));
   }
 
   {
@@ -412,6 +413,37 @@ TEST_F(TestPublisher, intra_process_publish_failures) {
       "intraprocess communication is not allowed with a zero qos history depth value"));
 }
 
+/*
+   Testing that a loaned message reaches the intra-process subscriptions.
+ */
+TEST_F(TestPublisher, intra_process_loaned_message_publish) {
+  initialize(rclcpp::NodeOptions().use_intra_process_comms(true));
+  auto publisher = node->create_publisher<test_msgs::msg::Empty>("topic", 10);
+
+  std::vector<const test_msgs::msg::Empty *> received;
+  auto callback = [&received](const test_msgs::msg::Empty & msg) {received.push_back(&msg);};
+  auto subscription_1 = node->create_subscription<test_msgs::msg::Empty>("topic", 10, callback);
+  auto subscription_2 = node->create_subscription<test_msgs::msg::Empty>("topic", 10, callback);
+
+  auto loaned_msg = publisher->borrow_loaned_message();
+  const test_msgs::msg::Empty * loaned_msg_ptr = &loaned_msg.get();
+  publisher->publish(std::move(loaned_msg));
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(node);
+  auto start = std::chrono::steady_clock::now();
+  while (received.size() < 2u && std::chrono::steady_clock::now() - start < 10s) {
+    executor.spin_some(100ms);
+  }
+  ASSERT_EQ(2u, received.size());
+  // Both subscriptions share a single instance of the message.
+  EXPECT_EQ(received[0], received[1]);
+  if (!publisher->can_loan_messages()) {
+    // A locally allocated message is not even copied.
+    EXPECT_EQ(loaned_msg_ptr, received[0]);
+  }
+}
+
 TEST_F(TestPublisher, inter_process_publish_failures) {
   initialize();
   rclcpp::PublisherOptionsWithAllocator<std::allocator<void>> options;
@@ -14,11 +14,13 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
 #include <chrono>
 #include <functional>
 #include <memory>
 #include <string>
 #include <thread>
+#include <type_traits>
 #include <vector>
 
 #include "rclcpp/exceptions.hpp"
@@ -27,6 +29,7 @@
 #include "../mocking_utils/patch.hpp"
 #include "../utils/rclcpp_gtest_macros.hpp"
 
+#include "test_msgs/msg/basic_types.hpp"
 #include "test_msgs/msg/empty.hpp"
 
 using namespace std::chrono_literals;
@@ -324,6 +327,125 @@ TEST_F(TestSubscription, take) {
   // TODO(wjwwood): figure out a good way to test the intra-process exclusion behavior.
 }
 
+/*
+   Testing take_type_erased_sequence and the executor taking messages in batches.
+ */
+TEST_F(TestSubscription, take_batch) {
+  initialize();
+  using test_msgs::msg::Empty;
+  size_t callback_count = 0u;
+  auto count_messages = [&callback_count](std::shared_ptr<const Empty>) {++callback_count;};
+
+  rclcpp::SubscriptionOptions so;
+  so.use_intra_process_comm = rclcpp::IntraProcessSetting::Disable;
+  so.take_batch_size = 0u;
+  EXPECT_THROW(
+    node->create_subscription<Empty>("~/test_take_batch", 10, count_messages, so),
+    std::invalid_argument);
+
+  so.take_batch_size = 5u;
+  auto sub = node->create_subscription<Empty>("~/test_take_batch", 10, count_messages, so);
+  EXPECT_EQ(5u, sub->get_take_batch_size());
+  rclcpp::PublisherOptions po;
+  po.use_intra_process_comm = rclcpp::IntraProcessSetting::Disable;
+  auto pub = node->create_publisher<Empty>("~/test_take_batch", 10, po);
+
+  auto storage = sub->borrow_take_sequence_storage();
+  EXPECT_EQ(0u, sub->take_type_erased_sequence(*storage));
+  EXPECT_EQ(5u, storage->messages.size());
+  EXPECT_TRUE(storage->message_infos.empty());
+
+  // Every take returns at most the batch size, and in total every message published.
+  for (size_t i = 0u; i < 8u; ++i) {
+    pub->publish(Empty());
+  }
+  size_t taken = 0u;
+  auto start = std::chrono::steady_clock::now();
+  while (taken < 8u && std::chrono::steady_clock::now() - start < 10s) {
+    size_t batch = sub->take_type_erased_sequence(*storage);
+    EXPECT_LE(batch, 5u);
+    EXPECT_EQ(batch, storage->message_infos.size());
+    taken += batch;
+    std::this_thread::sleep_for(10ms);
+  }
+  EXPECT_EQ(8u, taken);
+  EXPECT_EQ(0u, callback_count);
+
+  // Messages are reused from one take to the next, unless someone else still references them.
+  const void * reused = storage->messages[0].get();
+  std::shared_ptr<void> kept = storage->messages[1];
+  EXPECT_EQ(0u, sub->take_type_erased_sequence(*storage));
+  EXPECT_EQ(reused, storage->messages[0].get());
+  EXPECT_NE(kept.get(), storage->messages[1].get());
+  sub->return_take_sequence_storage(std::move(storage));
+  EXPECT_EQ(reused, sub->borrow_take_sequence_storage()->messages[0].get());
+
+  // The executor hands every message of a batch to the callback.
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(node);
+  for (size_t i = 0u; i < 8u; ++i) {
+    pub->publish(Empty());
+  }
+  start = std::chrono::steady_clock::now();
+  while (callback_count < 8u && std::chrono::steady_clock::now() - start < 10s) {
+    executor.spin_some();
+    std::this_thread::sleep_for(10ms);
+  }
+  EXPECT_EQ(8u, callback_count);
+}
+
+/*
+   Testing a subscription callback which is called with a batch of messages at once.
+ */
+TEST_F(TestSubscription, take_batch_callback) {
+  initialize();
+  using test_msgs::msg::BasicTypes;
+  std::vector<int32_t> received;
+  size_t callback_count = 0u;
+  auto batch_callback =
+    [&received, &callback_count](
+    const std::vector<std::shared_ptr<const BasicTypes>> & messages,
+    const std::vector<rclcpp::MessageInfo> & message_infos)
+    {
+      EXPECT_EQ(messages.size(), message_infos.size());
+      for (const auto & message : messages) {
+        received.push_back(message->int32_value);
+      }
+      ++callback_count;
+    };
+
+  rclcpp::SubscriptionOptions so;
+  so.use_intra_process_comm = rclcpp::IntraProcessSetting::Disable;
+  so.take_batch_size = 4u;
+  auto sub = node->create_subscription<BasicTypes>(
+    "~/test_take_batch_callback", 10, batch_callback, so);
+  static_assert(
+    std::is_same_v<decltype(sub), std::shared_ptr<rclcpp::Subscription<BasicTypes>>>,
+    "a batch callback should subscribe to the message type itself");
+  rclcpp::PublisherOptions po;
+  po.use_intra_process_comm = rclcpp::IntraProcessSetting::Disable;
+  auto pub = node->create_publisher<BasicTypes>("~/test_take_batch_callback", 10, po);
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(node);
+  BasicTypes message;
+  for (int32_t i = 0; i < 10; ++i) {
+    message.int32_value = i;
+    pub->publish(message);
+  }
+  auto start = std::chrono::steady_clock::now();
+  while (received.size() < 10u && std::chrono::steady_clock::now() - start < 10s) {
+    executor.spin_some();
+    std::this_thread::sleep_for(10ms);
+  }
+  ASSERT_EQ(10u, received.size());
+  for (int32_t i = 0; i < 10; ++i) {
+    EXPECT_EQ(i, received[static_cast<size_t>(i)]);
+  }
+  // Messages which arrived together are handed over together.
+  EXPECT_LT(callback_count, 10u);
+}
+
 /*
    Testing take_serialized.
  */
@@ -540,3 +662,62 @@ TEST_F(TestSubscription, get_network_flow_endpoints_errors) {
     EXPECT_NO_THROW(subscription->get_network_flow_endpoints());
   }
 }
+
+TEST_F(TestSubscription, on_new_message_callback) {
+  initialize();
+  using test_msgs::msg::Empty;
+  auto do_nothing = [](std::shared_ptr<const test_msgs::msg::Empty>) {FAIL();};
+  rclcpp::SubscriptionOptions so;
+  so.use_intra_process_comm = rclcpp::IntraProcessSetting::Disable;
+  auto sub = node->create_subscription<Empty>("~/test_on_new_message", 10, do_nothing, so);
+
+  EXPECT_THROW(sub->set_on_new_message_callback(nullptr), std::invalid_argument);
+  // Clearing a callback which was never set is a no-op.
+  EXPECT_NO_THROW(sub->clear_on_new_message_callback());
+
+  std::atomic_size_t c1 {0u};
+  auto increase_c1_cb = [&c1](size_t count_msgs) {c1 += count_msgs;};
+  try {
+    sub->set_on_new_message_callback(increase_c1_cb);
+  } catch (const rclcpp::exceptions::RCLError & rcl_error) {
+    // Not every middleware supports these callbacks.
+    ASSERT_EQ(RCL_RET_UNSUPPORTED, rcl_error.ret);
+    return;
+  }
+
+  rclcpp::PublisherOptions po;
+  po.use_intra_process_comm = rclcpp::IntraProcessSetting::Disable;
+  auto pub = node->create_publisher<Empty>("~/test_on_new_message", 10, po);
+
+  auto wait_for = [](std::atomic_size_t & count, size_t expected) {
+      auto start = std::chrono::steady_clock::now();
+      while (count.load() < expected && std::chrono::steady_clock::now() - start < 10s) {
+        std::this_thread::sleep_for(10ms);
+      }
+      return count.load();
+    };
+
+  pub->publish(Empty());
+  EXPECT_EQ(1u, wait_for(c1, 1u));
+
+  // Messages received while no callback is set are reported when a new one is set.
+  sub->clear_on_new_message_callback();
+  pub->publish(Empty());
+  pub->publish(Empty());
+  std::this_thread::sleep_for(100ms);
+  EXPECT_EQ(1u, c1.load());
+
+  std::atomic_size_t c2 {0u};
+  auto increase_c2_cb = [&c2](size_t count_msgs) {c2 += count_msgs;};
+  sub->set_on_new_message_callback(increase_c2_cb);
+  EXPECT_EQ(2u, wait_for(c2, 2u));
+
+  // Exceptions do not escape into the middleware.
+  sub->set_on_new_message_callback([](size_t) {throw std::runtime_error("test");});
+  pub->publish(Empty());
+  std::this_thread::sleep_for(100ms);
+
+  sub->clear_on_new_message_callback();
+  EXPECT_EQ(1u, c1.load());
+  EXPECT_EQ(2u, c2.load());
+}
@@ -0,0 +1,191 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "rclcpp/contexts/default_context.hpp"
+#include "rclcpp/experimental/timers_manager.hpp"
+#include "rclcpp/timer.hpp"
+#include "rclcpp/utilities.hpp"
+
+using namespace std::chrono_literals;
+
+using rclcpp::experimental::TimersManager;
+
+class TestTimersManager : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    rclcpp::init(0, nullptr);
+    ready = false;
+    timers_manager = std::make_unique<TimersManager>([this]() {this->ready = true;});
+  }
+
+  void TearDown() override
+  {
+    timers_manager.reset();
+    rclcpp::shutdown();
+  }
+
+  rclcpp::TimerBase::SharedPtr
+  make_timer(std::chrono::nanoseconds period, std::atomic_int & count)
+  {
+    return rclcpp::WallTimer<rclcpp::VoidCallbackType>::make_shared(
+      period, [&count]() {count++;}, rclcpp::contexts::get_global_default_context());
+  }
+
+  /// Execute the ready timers, as an executor would, until the condition holds or 10s passed.
+  template<typename ConditionT>
+  bool
+  execute_until(ConditionT condition)
+  {
+    auto start = std::chrono::steady_clock::now();
+    while (!condition() && std::chrono::steady_clock::now() - start < 10s) {
+      if (ready.exchange(false)) {
+        timers_manager->execute_ready_timers();
+      } else {
+        std::this_thread::sleep_for(1ms);
+      }
+    }
+    return condition();
+  }
+
+  std::atomic_bool ready;
+  TimersManager::UniquePtr timers_manager;
+};
+
+TEST_F(TestTimersManager, start_twice) {
+  timers_manager->start();
+  EXPECT_THROW(timers_manager->start(), std::runtime_error);
+  timers_manager->stop();
+  // Stopping again is harmless.
+  timers_manager->stop();
+}
+
+/*
+   Test that each timer is executed at its own rate.
+ */
+TEST_F(TestTimersManager, execute_due_timers) {
+  std::atomic_int fast_count {0};
+  std::atomic_int slow_count {0};
+  auto fast_timer = make_timer(5ms, fast_count);
+  auto slow_timer = make_timer(50ms, slow_count);
+
+  timers_manager->set_timers({fast_timer, slow_timer});
+  timers_manager->start();
+  EXPECT_TRUE(execute_until([&slow_count]() {return slow_count >= 2;}));
+  timers_manager->stop();
+
+  EXPECT_GT(fast_count.load(), slow_count.load());
+}
+
+/*
+   Test that a canceled timer is not executed until it is reset.
+ */
+TEST_F(TestTimersManager, canceled_timer) {
+  std::atomic_int count {0};
+  std::atomic_int canceled_count {0};
+  auto timer = make_timer(5ms, count);
+  auto canceled_timer = make_timer(1ms, canceled_count);
+  canceled_timer->cancel();
+
+  timers_manager->set_timers({timer, canceled_timer});
+  timers_manager->start();
+  EXPECT_TRUE(execute_until([&count]() {return count >= 5;}));
+  EXPECT_EQ(0, canceled_count.load());
+
+  canceled_timer->reset();
+  EXPECT_TRUE(execute_until([&canceled_count]() {return canceled_count >= 1;}));
+  timers_manager->stop();
+}
+
+/*
+   Test that resetting a canceled timer wakes up the thread, even if no other timer does.
+ */
+TEST_F(TestTimersManager, reset_canceled_timer) {
+  std::atomic_int count {0};
+  auto timer = make_timer(1ms, count);
+  timer->cancel();
+
+  timers_manager->set_timers({timer});
+  timers_manager->start();
+  std::this_thread::sleep_for(20ms);
+  EXPECT_FALSE(ready.load());
+  EXPECT_EQ(0, count.load());
+
+  timer->reset();
+  EXPECT_TRUE(execute_until([&count]() {return count >= 1;}));
+
+  // Canceling and resetting again works the same.
+  timer->cancel();
+  std::this_thread::sleep_for(20ms);
+  const int count_before = count.load();
+  timer->reset();
+  EXPECT_TRUE(execute_until([&count, count_before]() {return count > count_before;}));
+  timers_manager->stop();
+}
+
+/*
+   Test that timers which are no longer managed are not executed.
+ */
+TEST_F(TestTimersManager, set_timers) {
+  std::atomic_int count {0};
+  std::atomic_int removed_count {0};
+  auto timer = make_timer(5ms, count);
+  auto removed_timer = make_timer(1ms, removed_count);
+
+  timers_manager->set_timers({removed_timer});
+  timers_manager->start();
+  EXPECT_TRUE(execute_until([&removed_count]() {return removed_count >= 1;}));
+
+  timers_manager->set_timers({timer});
+  const int removed_before = removed_count.load();
+  EXPECT_TRUE(execute_until([&count]() {return count >= 5;}));
+  EXPECT_EQ(removed_before, removed_count.load());
+
+  // A destroyed timer is dropped silently.
+  timer.reset();
+  std::this_thread::sleep_for(20ms);
+  timers_manager->stop();
+}
+
+/*
+   Test that a manager only clears the reset callbacks it set itself.
+ */
+TEST_F(TestTimersManager, timer_moved_between_managers) {
+  std::atomic_int count {0};
+  auto timer = make_timer(1ms, count);
+  timer->cancel();
+
+  auto first_manager = std::make_unique<TimersManager>([]() {});
+  auto second_manager = std::make_unique<TimersManager>([]() {});
+  first_manager->set_timers({timer});
+  second_manager->set_timers({timer});
+  timers_manager->set_timers({timer});
+  // Neither removing the timer from a previous manager nor destroying one clears the callback.
+  first_manager->set_timers({});
+  second_manager.reset();
+
+  timers_manager->start();
+  timer->reset();
+  EXPECT_TRUE(execute_until([&count]() {return count >= 1;}));
+  timers_manager->stop();
+}
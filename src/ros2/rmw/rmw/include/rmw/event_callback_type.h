@@ -0,0 +1,41 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RMW__EVENT_CALLBACK_TYPE_H_
+#define RMW__EVENT_CALLBACK_TYPE_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+
+/// Common event callback type signature.
+/**
+ * Event callbacks of this type can be called in various scenarios, e.g.
+ * data becomes available on a subscription, a request arrives at a service,
+ * or a response arrives at a client.
+ *
+ * \param[in] user_data A opaque pointer given when the callback was set.
+ * \param[in] number_of_events The number of events that occurred since the
+ *   callback was last called, usually 1.
+ */
+typedef void (* rmw_event_callback_t)(const void * user_data, size_t number_of_events);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RMW__EVENT_CALLBACK_TYPE_H_
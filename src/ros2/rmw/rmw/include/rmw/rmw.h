@@ -98,6 +98,7 @@ extern "C"
 #include "rosidl_runtime_c/service_type_support_struct.h"
 #include "rosidl_runtime_c/sequence_bound.h"
 
+#include "rmw/event_callback_type.h"
 #include "rmw/init.h"
 #include "rmw/macros.h"
 #include "rmw/qos_profiles.h"
@@ -2790,6 +2791,138 @@ RMW_WARN_UNUSED
 rmw_ret_t
 rmw_set_log_severity(rmw_log_severity_t severity);
 
+/// Set the callback to be called when new messages arrive at a subscription.
+/**
+ * The callback receives the number of messages that arrived since the last call.
+ *
+ * The callback may be called from any middleware thread, and it may be called
+ * concurrently with any other operation on the subscription, so it must be
+ * thread-safe and must not block.
+ * In particular, it must not call any rmw function on this subscription.
+ *
+ * If events arrived before a callback is set, the callback is called once,
+ * from within this function, with the number of events that arrived so far.
+ * Setting the callback to `NULL` stops notifications; events arriving while
+ * no callback is set are counted again.
+ *
+ * Implementations that do not support this feature return `RMW_RET_UNSUPPORTED`,
+ * in which case the subscription can only be used with wait sets.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Maybe [1]
+ * Lock-Free          | Maybe [1]
+ *
+ * <i>[1] implementation defined, check implementation documentation.</i>
+ *
+ * \param[in] subscription The subscription on which to set the callback.
+ * \param[in] callback The callback to be called, or `NULL` to clear it.
+ * \param[in] user_data Opaque pointer passed back to the callback on every call.
+ * \return `RMW_RET_OK` if the callback was set, or
+ * \return `RMW_RET_INVALID_ARGUMENT` if `subscription` is `NULL`, or
+ * \return `RMW_RET_INCORRECT_RMW_IMPLEMENTATION` if the `subscription`
+ *   implementation identifier does not match this implementation, or
+ * \return `RMW_RET_UNSUPPORTED` if the implementation does not support this feature.
+ */
+RMW_PUBLIC
+RMW_WARN_UNUSED
+rmw_ret_t
+rmw_subscription_set_on_new_message_callback(
+  rmw_subscription_t * subscription,
+  rmw_event_callback_t callback,
+  const void * user_data);
+
+/// Set the callback to be called when new requests arrive at a service server.
+/**
+ * The callback receives the number of requests that arrived since the last call.
+ *
+ * The callback may be called from any middleware thread, and it may be called
+ * concurrently with any other operation on the service, so it must be
+ * thread-safe and must not block.
+ * In particular, it must not call any rmw function on this service.
+ *
+ * If events arrived before a callback is set, the callback is called once,
+ * from within this function, with the number of events that arrived so far.
+ * Setting the callback to `NULL` stops notifications; events arriving while
+ * no callback is set are counted again.
+ *
+ * Implementations that do not support this feature return `RMW_RET_UNSUPPORTED`,
+ * in which case the service can only be used with wait sets.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Maybe [1]
+ * Lock-Free          | Maybe [1]
+ *
+ * <i>[1] implementation defined, check implementation documentation.</i>
+ *
+ * \param[in] service The service on which to set the callback.
+ * \param[in] callback The callback to be called, or `NULL` to clear it.
+ * \param[in] user_data Opaque pointer passed back to the callback on every call.
+ * \return `RMW_RET_OK` if the callback was set, or
+ * \return `RMW_RET_INVALID_ARGUMENT` if `service` is `NULL`, or
+ * \return `RMW_RET_INCORRECT_RMW_IMPLEMENTATION` if the `service`
+ *   implementation identifier does not match this implementation, or
+ * \return `RMW_RET_UNSUPPORTED` if the implementation does not support this feature.
+ */
+RMW_PUBLIC
+RMW_WARN_UNUSED
+rmw_ret_t
+rmw_service_set_on_new_request_callback(
+  rmw_service_t * service,
+  rmw_event_callback_t callback,
+  const void * user_data);
+
+/// Set the callback to be called when new responses arrive at a service client.
+/**
+ * The callback receives the number of responses that arrived since the last call.
+ *
+ * The callback may be called from any middleware thread, and it may be called
+ * concurrently with any other operation on the client, so it must be
+ * thread-safe and must not block.
+ * In particular, it must not call any rmw function on this client.
+ *
+ * If events arrived before a callback is set, the callback is called once,
+ * from within this function, with the number of events that arrived so far.
+ * Setting the callback to `NULL` stops notifications; events arriving while
+ * no callback is set are counted again.
+ *
+ * Implementations that do not support this feature return `RMW_RET_UNSUPPORTED`,
+ * in which case the client can only be used with wait sets.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Maybe [1]
+ * Lock-Free          | Maybe [1]
+ *
+ * <i>[1] implementation defined, check implementation documentation.</i>
+ *
+ * \param[in] client The client on which to set the callback.
+ * \param[in] callback The callback to be called, or `NULL` to clear it.
+ * \param[in] user_data Opaque pointer passed back to the callback on every call.
+ * \return `RMW_RET_OK` if the callback was set, or
+ * \return `RMW_RET_INVALID_ARGUMENT` if `client` is `NULL`, or
+ * \return `RMW_RET_INCORRECT_RMW_IMPLEMENTATION` if the `client`
+ *   implementation identifier does not match this implementation, or
+ * \return `RMW_RET_UNSUPPORTED` if the implementation does not support this feature.
+ */
+RMW_PUBLIC
+RMW_WARN_UNUSED
+rmw_ret_t
+rmw_client_set_on_new_response_callback(
+  rmw_client_t * client,
+  rmw_event_callback_t callback,
+  const void * user_data);
+
 #ifdef __cplusplus
 }
 #endif
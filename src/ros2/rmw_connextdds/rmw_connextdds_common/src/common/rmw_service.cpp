@@ -418,3 +418,31 @@ rmw_api_connextdds_destroy_service(
 
   return RMW_RET_OK;
 }
+
+
+rmw_ret_t
+rmw_api_connextdds_service_set_on_new_request_callback(
+  rmw_service_t * service,
+  rmw_event_callback_t callback,
+  const void * user_data)
+{
+  UNUSED_ARG(service);
+  UNUSED_ARG(callback);
+  UNUSED_ARG(user_data);
+  RMW_CONNEXT_LOG_NOT_IMPLEMENTED
+  return RMW_RET_UNSUPPORTED;
+}
+
+
+rmw_ret_t
+rmw_api_connextdds_client_set_on_new_response_callback(
+  rmw_client_t * client,
+  rmw_event_callback_t callback,
+  const void * user_data)
+{
+  UNUSED_ARG(client);
+  UNUSED_ARG(callback);
+  UNUSED_ARG(user_data);
+  RMW_CONNEXT_LOG_NOT_IMPLEMENTED
+  return RMW_RET_UNSUPPORTED;
+}
@@ -393,3 +393,17 @@ rmw_api_connextdds_return_loaned_message_from_subscription(
   RMW_CONNEXT_LOG_NOT_IMPLEMENTED
   return RMW_RET_UNSUPPORTED;
 }
+
+
+rmw_ret_t
+rmw_api_connextdds_subscription_set_on_new_message_callback(
+  rmw_subscription_t * subscription,
+  rmw_event_callback_t callback,
+  const void * user_data)
+{
+  UNUSED_ARG(subscription);
+  UNUSED_ARG(callback);
+  UNUSED_ARG(user_data);
+  RMW_CONNEXT_LOG_NOT_IMPLEMENTED
+  return RMW_RET_UNSUPPORTED;
+}
@@ -846,3 +846,38 @@ rmw_subscription_get_network_flow_endpoints(
     allocator,
     network_flow_endpoint_array);
 }
+
+/*****************************************************************************
+ * Event Callbacks API
+ *****************************************************************************/
+rmw_ret_t
+rmw_subscription_set_on_new_message_callback(
+  rmw_subscription_t * subscription,
+  rmw_event_callback_t callback,
+  const void * user_data)
+{
+  return rmw_api_connextdds_subscription_set_on_new_message_callback(
+    subscription, callback, user_data);
+}
+
+
+rmw_ret_t
+rmw_service_set_on_new_request_callback(
+  rmw_service_t * service,
+  rmw_event_callback_t callback,
+  const void * user_data)
+{
+  return rmw_api_connextdds_service_set_on_new_request_callback(
+    service, callback, user_data);
+}
+
+
+rmw_ret_t
+rmw_client_set_on_new_response_callback(
+  rmw_client_t * client,
+  rmw_event_callback_t callback,
+  const void * user_data)
+{
+  return rmw_api_connextdds_client_set_on_new_response_callback(
+    client, callback, user_data);
+}
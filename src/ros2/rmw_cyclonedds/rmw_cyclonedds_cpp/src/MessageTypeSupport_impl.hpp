@@ -32,6 +32,7 @@ MessageTypeSupport<MembersType>::MessageTypeSupport(const MembersType * members)
 {
   assert(members);
   this->members_ = members;
+  this->buildDeserializationPlan();
 
   std::ostringstream ss;
   std::string message_namespace(this->members_->message_namespace_);
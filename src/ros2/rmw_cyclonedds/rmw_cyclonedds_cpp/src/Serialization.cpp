@@ -21,6 +21,7 @@
 #include "Serialization.hpp"
 
 #include <array>
+#include <cstring>
 #include <limits>
 #include <memory>
 #include <unordered_map>
@@ -83,6 +84,7 @@ struct SizeCursor : public CDRCursor
   size_t offset() const final {return m_offset;}
   void advance(size_t n_bytes) final {m_offset += n_bytes;}
   void put_bytes(const void *, size_t n_bytes) final {advance(n_bytes);}
+  void put_sequence(const void * bytes, size_t n_bytes) {put_bytes(bytes, n_bytes);}
   bool ignores_data() const final {return true;}
   void rebase(ptrdiff_t relative_origin) override
   {
@@ -91,6 +93,24 @@ struct SizeCursor : public CDRCursor
   }
 };
 
+// Sizes what ReferencingCursor copies
+struct ReferencingSizeCursor : public SizeCursor
+{
+  const size_t min_reference_size;
+  size_t referenced_size {0};
+
+  explicit ReferencingSizeCursor(size_t min_reference_size)
+  : min_reference_size(min_reference_size) {}
+
+  void put_sequence(const void * bytes, size_t n_bytes)
+  {
+    if (n_bytes >= min_reference_size) {
+      referenced_size += n_bytes;
+    }
+    put_bytes(bytes, n_bytes);
+  }
+};
+
 struct DataCursor : public CDRCursor
 {
   const void * origin;
@@ -113,16 +133,103 @@ struct DataCursor : public CDRCursor
     std::memcpy(position, bytes, n_bytes);
     position = byte_offset(position, n_bytes);
   }
+  void put_sequence(const void * bytes, size_t n_bytes) {put_bytes(bytes, n_bytes);}
   bool ignores_data() const final {return false;}
   void rebase(ptrdiff_t relative_origin) final {origin = byte_offset(origin, relative_origin);}
 };
 
+// Like DataCursor, but records large sequences as references instead of copying them,
+// so the offset includes data which is not in the destination buffer
+struct ReferencingCursor : public CDRCursor
+{
+  void * const start;
+  void * position;
+  size_t m_offset {0};
+  const size_t min_reference_size;
+  std::vector<serdata_rmw_reference> & references;
+
+  ReferencingCursor(
+    void * position, size_t min_reference_size,
+    std::vector<serdata_rmw_reference> & references)
+  : start(position), position(position), min_reference_size(min_reference_size),
+    references(references) {}
+
+  size_t offset() const final {return m_offset;}
+  void advance(size_t n_bytes) final
+  {
+    std::memset(position, '\0', n_bytes);
+    position = byte_offset(position, n_bytes);
+    m_offset += n_bytes;
+  }
+  void put_bytes(const void * bytes, size_t n_bytes) final
+  {
+    if (n_bytes == 0) {
+      return;
+    }
+    std::memcpy(position, bytes, n_bytes);
+    position = byte_offset(position, n_bytes);
+    m_offset += n_bytes;
+  }
+  void put_sequence(const void * bytes, size_t n_bytes)
+  {
+    if (n_bytes < min_reference_size) {
+      return put_bytes(bytes, n_bytes);
+    }
+    auto copied_offset = static_cast<size_t>((const byte *)position - (const byte *)start);
+    references.push_back({copied_offset, bytes, n_bytes});
+    m_offset += n_bytes;
+  }
+  bool ignores_data() const final {return false;}
+  void rebase(ptrdiff_t relative_origin) final {m_offset -= relative_origin;}
+};
+
 enum class EncodingVersion
 {
   CDR_Legacy,
   CDR1,
 };
 
+/// Steps serializing a struct, computed once per type.
+/// Contiguous values whose memory representation is already their CDR representation are
+/// merged into runs which are copied with a single memcpy.
+struct SerializationPlan
+{
+  enum class StepKind
+  {
+    // copy `size` bytes, the first value of which has CDR alignment `align`
+    Copy,
+    // string of 1-byte characters
+    String,
+    // sequence of elements of `size` bytes which are copied at once
+    CopySequence,
+    // array or sequence of elements of `size` bytes, each serialized with `element_plan`
+    Elements,
+    // any other value, serialized by walking its value type
+    Value,
+  };
+
+  struct Step
+  {
+    StepKind kind;
+    // of the value in the struct
+    size_t offset;
+    size_t size;
+    size_t align;
+    const AnyValueType * value_type;
+    const SerializationPlan * element_plan;
+  };
+
+  std::vector<Step> steps;
+  std::vector<std::unique_ptr<SerializationPlan>> element_plans;
+
+  /// Whether an element serialized with this plan is a single copy of its memory
+  bool is_single_copy(size_t sizeof_element) const
+  {
+    return steps.size() == 1 && steps[0].kind == StepKind::Copy && steps[0].offset == 0 &&
+           steps[0].size == sizeof_element && sizeof_element % steps[0].align == 0;
+  }
+};
+
 class CDRWriter : public BaseCDRWriter
 {
 public:
@@ -149,6 +256,7 @@ public:
   const size_t max_align;
   std::unique_ptr<const StructValueType> m_root_value_type;
   std::unordered_map<CacheKey, bool, CacheKey::Hash> trivially_serialized_cache;
+  SerializationPlan m_plan;
 
 public:
   explicit CDRWriter(std::unique_ptr<const StructValueType> root_value_type)
@@ -158,6 +266,7 @@ public:
   {
     assert(m_root_value_type);
     register_serializable_type(m_root_value_type.get());
+    add_to_plan(m_plan, 0, m_root_value_type.get());
   }
 
   void register_serializable_type(const AnyValueType * t)
@@ -235,8 +344,26 @@ public:
     serialize_top_level(&cursor, request);
   }
 
+  size_t get_serialized_size_referencing(
+    const void * data, size_t min_reference_size, size_t * referenced_size) const override
+  {
+    ReferencingSizeCursor cursor(min_reference_size);
+    serialize_top_level(&cursor, data);
+    *referenced_size = cursor.referenced_size;
+    return cursor.offset() - cursor.referenced_size;
+  }
+
+  void serialize_referencing(
+    void * dest, const void * data, size_t min_reference_size,
+    std::vector<serdata_rmw_reference> & references) const override
+  {
+    ReferencingCursor cursor(dest, min_reference_size, references);
+    serialize_top_level(&cursor, data);
+  }
+
+  template<typename Cursor>
   void serialize_top_level(
-    CDRCursor * cursor, const void * data) const
+    Cursor * cursor, const void * data) const
   {
     put_rtps_header(cursor);
 
@@ -248,7 +375,7 @@ public:
       char dummy = '\0';
       cursor->put_bytes(&dummy, 1);
     } else {
-      serialize(cursor, data, m_root_value_type.get());
+      serialize(cursor, data, m_plan);
     }
 
     if (eversion == EncodingVersion::CDR_Legacy) {
@@ -256,8 +383,9 @@ public:
     }
   }
 
+  template<typename Cursor>
   void serialize_top_level(
-    CDRCursor * cursor, const cdds_request_wrapper_t & request) const
+    Cursor * cursor, const cdds_request_wrapper_t & request) const
   {
     put_rtps_header(cursor);
     if (eversion == EncodingVersion::CDR_Legacy) {
@@ -266,7 +394,7 @@ public:
     cursor->put_bytes(&request.header.guid, sizeof(request.header.guid));
     cursor->put_bytes(&request.header.seq, sizeof(request.header.seq));
 
-    serialize(cursor, request.data, m_root_value_type.get());
+    serialize(cursor, request.data, m_plan);
 
     if (eversion == EncodingVersion::CDR_Legacy) {
       cursor->rebase(-4);
@@ -296,11 +424,12 @@ protected:
     cursor->put_bytes(rtps_header.data(), rtps_header.size());
   }
 
-  void serialize_u32(CDRCursor * cursor, size_t value) const
+  template<typename Cursor>
+  void serialize_u32(Cursor * cursor, size_t value) const
   {
     assert(value <= std::numeric_limits<uint32_t>::max());
     auto u32_value = static_cast<uint32_t>(value);
-    cursor->align(4);
+    align_cursor(cursor, 4);
     cursor->put_bytes(&u32_value, 4);
   }
 
@@ -610,6 +739,165 @@ protected:
       serialize(cursor, member_data, value_type);
     }
   }
+
+  void add_step(
+    SerializationPlan & plan, SerializationPlan::StepKind kind, size_t offset,
+    const AnyValueType * value_type, size_t size = 0, size_t align = 1,
+    const SerializationPlan * element_plan = nullptr) const
+  {
+    plan.steps.push_back({kind, offset, size, align, value_type, element_plan});
+  }
+
+  void add_copy(SerializationPlan & plan, size_t offset, size_t size, size_t align) const
+  {
+    // A copy extends the previous one if it follows it in memory and is aligned relative to
+    // its start. The previous copy is aligned to a multiple of this alignment when serialized,
+    // so CDR puts no padding in between.
+    if (!plan.steps.empty()) {
+      auto & last = plan.steps.back();
+      if (last.kind == SerializationPlan::StepKind::Copy && last.offset + last.size == offset &&
+        align <= last.align && (offset - last.offset) % align == 0)
+      {
+        last.size += size;
+        return;
+      }
+    }
+    add_step(plan, SerializationPlan::StepKind::Copy, offset, nullptr, size, align);
+  }
+
+  const SerializationPlan * add_element_plan(
+    SerializationPlan & plan, const AnyValueType * element_value_type) const
+  {
+    plan.element_plans.push_back(std::make_unique<SerializationPlan>());
+    add_to_plan(*plan.element_plans.back(), 0, element_value_type);
+    return plan.element_plans.back().get();
+  }
+
+  void add_to_plan(SerializationPlan & plan, size_t offset, const AnyValueType * value_type) const
+  {
+    using StepKind = SerializationPlan::StepKind;
+    switch (value_type->e_value_type()) {
+      case EValueType::PrimitiveValueType: {
+          auto & vt = *static_cast<const PrimitiveValueType *>(value_type);
+          if (is_trivially_serialized(0, vt)) {
+            add_copy(plan, offset, vt.sizeof_type(), get_cdr_alignof_primitive(vt.type_kind()));
+          } else {
+            add_step(plan, StepKind::Value, offset, value_type);
+          }
+        }
+        break;
+      case EValueType::StructValueType: {
+          // nested structs are flattened into the plan of the enclosing struct
+          auto & vt = *static_cast<const StructValueType *>(value_type);
+          for (size_t i = 0; i < vt.n_members(); i++) {
+            auto member = vt.get_member(i);
+            add_to_plan(plan, offset + member->member_offset, member->value_type);
+          }
+        }
+        break;
+      case EValueType::ArrayValueType: {
+          auto & vt = *static_cast<const ArrayValueType *>(value_type);
+          auto element_size = vt.element_value_type()->sizeof_type();
+          auto element_plan = add_element_plan(plan, vt.element_value_type());
+          if (element_plan->is_single_copy(element_size)) {
+            add_copy(plan, offset, vt.sizeof_type(), element_plan->steps[0].align);
+          } else {
+            add_step(
+              plan, StepKind::Elements, offset, value_type, element_size, 1, element_plan);
+          }
+        }
+        break;
+      case EValueType::SpanSequenceValueType: {
+          auto & vt = *static_cast<const SpanSequenceValueType *>(value_type);
+          auto element_size = vt.element_value_type()->sizeof_type();
+          auto element_plan = add_element_plan(plan, vt.element_value_type());
+          if (element_plan->is_single_copy(element_size)) {
+            add_step(
+              plan, StepKind::CopySequence, offset, value_type, element_size,
+              element_plan->steps[0].align);
+          } else {
+            add_step(
+              plan, StepKind::Elements, offset, value_type, element_size, 1, element_plan);
+          }
+        }
+        break;
+      case EValueType::U8StringValueType:
+        add_step(plan, StepKind::String, offset, value_type);
+        break;
+      case EValueType::U16StringValueType:
+      case EValueType::BoolVectorValueType:
+        add_step(plan, StepKind::Value, offset, value_type);
+        break;
+      default:
+        unreachable();
+    }
+  }
+
+  // Same as CDRCursor::align, but without virtual calls for a concrete cursor
+  template<typename Cursor>
+  static void align_cursor(Cursor * cursor, size_t n_bytes)
+  {
+    size_t misalignment = cursor->offset() % n_bytes;
+    if (misalignment != 0) {
+      cursor->advance(n_bytes - misalignment);
+    }
+  }
+
+  template<typename Cursor>
+  void serialize(Cursor * cursor, const void * data, const SerializationPlan & plan) const
+  {
+    using StepKind = SerializationPlan::StepKind;
+    for (const auto & step : plan.steps) {
+      auto value = byte_offset(data, step.offset);
+      switch (step.kind) {
+        case StepKind::Copy:
+          align_cursor(cursor, step.align);
+          cursor->put_bytes(value, step.size);
+          break;
+        case StepKind::String: {
+            auto str = static_cast<const U8StringValueType *>(step.value_type)->data(value);
+            serialize_u32(cursor, str.size() + 1);
+            cursor->put_bytes(str.data(), str.size());
+            char terminator = '\0';
+            cursor->put_bytes(&terminator, 1);
+          }
+          break;
+        case StepKind::CopySequence: {
+            auto vt = static_cast<const SpanSequenceValueType *>(step.value_type);
+            size_t count = vt->sequence_size(value);
+            serialize_u32(cursor, count);
+            if (count != 0) {
+              align_cursor(cursor, step.align);
+              cursor->put_sequence(vt->sequence_contents(value), count * step.size);
+            }
+          }
+          break;
+        case StepKind::Elements: {
+            const void * elements;
+            size_t count;
+            if (step.value_type->e_value_type() == EValueType::ArrayValueType) {
+              auto vt = static_cast<const ArrayValueType *>(step.value_type);
+              elements = vt->get_data(value);
+              count = vt->array_size();
+            } else {
+              auto vt = static_cast<const SpanSequenceValueType *>(step.value_type);
+              count = vt->sequence_size(value);
+              serialize_u32(cursor, count);
+              elements = vt->sequence_contents(value);
+            }
+            for (size_t i = 0; i < count; i++) {
+              serialize(cursor, byte_offset(elements, i * step.size), *step.element_plan);
+            }
+          }
+          break;
+        case StepKind::Value:
+          serialize(cursor, value, step.value_type);
+          break;
+        default:
+          unreachable();
+      }
+    }
+  }
 };
 
 std::unique_ptr<BaseCDRWriter> make_cdr_writer(std::unique_ptr<StructValueType> value_type)
@@ -15,6 +15,7 @@
 #define SERIALIZATION_HPP_
 
 #include <memory>
+#include <vector>
 
 #include "TypeSupport2.hpp"
 #include "rosidl_runtime_c/service_type_support_struct.h"
@@ -30,6 +31,16 @@ public:
   virtual void serialize(void * dest, const void * data) const = 0;
   virtual size_t get_serialized_size(const cdds_request_wrapper_t & request) const = 0;
   virtual void serialize(void * dest, const cdds_request_wrapper_t & request) const = 0;
+  /// Size of what serialize_referencing copies into dest;
+  /// the size of the data it references is returned in referenced_size
+  virtual size_t get_serialized_size_referencing(
+    const void * data, size_t min_reference_size, size_t * referenced_size) const = 0;
+  /// Serializes like serialize, except that the contents of sequences of at least
+  /// min_reference_size bytes which need no conversion are appended to references
+  /// instead of being copied into dest
+  virtual void serialize_referencing(
+    void * dest, const void * data, size_t min_reference_size,
+    std::vector<serdata_rmw_reference> & references) const = 0;
   virtual ~BaseCDRWriter() = default;
 };
 
@@ -37,6 +37,7 @@ RequestTypeSupport<ServiceMembersType, MessageMembersType>::RequestTypeSupport(
 {
   assert(members);
   this->members_ = members->request_members_;
+  this->buildDeserializationPlan();
 
   std::ostringstream ss;
   std::string service_namespace(members->service_namespace_);
@@ -56,6 +57,7 @@ ResponseTypeSupport<ServiceMembersType, MessageMembersType>::ResponseTypeSupport
 {
   assert(members);
   this->members_ = members->response_members_;
+  this->buildDeserializationPlan();
 
 
   std::ostringstream ss;
@@ -19,6 +19,9 @@
 #include <cassert>
 #include <string>
 #include <functional>
+#include <memory>
+#include <type_traits>
+#include <vector>
 
 #include "rcutils/logging_macros.h"
 
@@ -121,16 +124,55 @@ protected:
   TypeSupport();
 
   void setName(const std::string & name);
+  // Must be called once members_ is set
+  void buildDeserializationPlan();
 
   const MembersType * members_;
   std::string name;
 
 private:
+  using MemberType =
+    typename std::remove_pointer<decltype(std::declval<MembersType>().members_)>::type;
+
+  // A step of deserializing a message in native byte order, precomputed from its members.
+  // Nested messages are flattened into the plan of the enclosing message.
+  struct DeserializationStep
+  {
+    enum class Kind
+    {
+      // memcpy `size` bytes of primitive values, the first of which has alignment `align`
+      Copy,
+      // a member deserialized on its own
+      Member,
+      // an array or sequence of messages, deserialized with `element_plan`; if `size` is not
+      // zero, the elements are memcpy'd as a whole like a Copy of `size` bytes per element
+      Messages,
+    };
+    Kind kind;
+    size_t offset;
+    size_t size;
+    size_t align;
+    const MemberType * member;
+    const std::vector<DeserializationStep> * element_plan;
+  };
+  using DeserializationPlan = std::vector<DeserializationStep>;
+
+  void addToDeserializationPlan(
+    DeserializationPlan & plan, const MembersType * members, size_t offset);
+  bool deserializeROSmessage(
+    cycdeser & deser, const DeserializationPlan & plan, void * ros_message);
   bool deserializeROSmessage(
     cycdeser & deser, const MembersType * members, void * ros_message);
+  bool deserializeMember(cycdeser & deser, const MemberType * member, void * field);
+  // Reads the size of an array or sequence of messages and resizes the sequence
+  bool deserializeMessageArraySize(
+    cycdeser & deser, const MemberType * member, void * field, size_t & array_size);
   bool printROSmessage(
     cycprint & deser, const MembersType * members);
   bool is_type_self_contained(const MembersType * members);
+
+  DeserializationPlan deserialization_plan_;
+  std::vector<std::unique_ptr<DeserializationPlan>> element_plans_;
 };
 
 size_t get_message_size(
@@ -231,6 +231,98 @@ inline void deserialize_field<std::wstring>(
   }
 }
 
+template<typename MembersType>
+bool TypeSupport<MembersType>::deserializeMessageArraySize(
+  cycdeser & deser, const MemberType * member, void * field, size_t & array_size)
+{
+  if (member->array_size_ && !member->is_upper_bound_) {
+    array_size = member->array_size_;
+  } else {
+    array_size = deser.deserialize_len(1);
+    if (!member->resize_function) {
+      RMW_SET_ERROR_MSG("unexpected error: resize function is null");
+      return false;
+    }
+    member->resize_function(field, array_size);
+  }
+
+  if (array_size != 0 && !member->get_function) {
+    RMW_SET_ERROR_MSG("unexpected error: get_function function is null");
+    return false;
+  }
+  return true;
+}
+
+template<typename MembersType>
+bool TypeSupport<MembersType>::deserializeMember(
+  cycdeser & deser, const MemberType * member, void * field)
+{
+  switch (member->type_id_) {
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_BOOL:
+      deserialize_field<bool>(member, field, deser);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_BYTE:
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT8:
+      deserialize_field<uint8_t>(member, field, deser);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_CHAR:
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_INT8:
+      deserialize_field<char>(member, field, deser);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_FLOAT32:
+      deserialize_field<float>(member, field, deser);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_FLOAT64:
+      deserialize_field<double>(member, field, deser);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_INT16:
+      deserialize_field<int16_t>(member, field, deser);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT16:
+      deserialize_field<uint16_t>(member, field, deser);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_INT32:
+      deserialize_field<int32_t>(member, field, deser);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT32:
+      deserialize_field<uint32_t>(member, field, deser);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_INT64:
+      deserialize_field<int64_t>(member, field, deser);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT64:
+      deserialize_field<uint64_t>(member, field, deser);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_STRING:
+      deserialize_field<std::string>(member, field, deser);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_WSTRING:
+      deserialize_field<std::wstring>(member, field, deser);
+      break;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_MESSAGE:
+      {
+        auto sub_members = (const MembersType *)member->members_->data;
+        if (!member->is_array_) {
+          return deserializeROSmessage(deser, sub_members, field);
+        }
+        size_t array_size;
+        if (!deserializeMessageArraySize(deser, member, field, array_size)) {
+          return false;
+        }
+        for (size_t index = 0; index < array_size; ++index) {
+          if (!deserializeROSmessage(deser, sub_members, member->get_function(field, index))) {
+            return false;
+          }
+        }
+      }
+      break;
+    default:
+      throw std::runtime_error("unknown type");
+  }
+
+  return true;
+}
+
 template<typename MembersType>
 bool TypeSupport<MembersType>::deserializeROSmessage(
   cycdeser & deser, const MembersType * members, void * ros_message)
@@ -241,80 +333,150 @@ bool TypeSupport<MembersType>::deserializeROSmessage(
   for (uint32_t i = 0; i < members->member_count_; ++i) {
     const auto * member = members->members_ + i;
     void * field = static_cast<char *>(ros_message) + member->offset_;
-    switch (member->type_id_) {
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_BOOL:
-        deserialize_field<bool>(member, field, deser);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_BYTE:
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT8:
-        deserialize_field<uint8_t>(member, field, deser);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_CHAR:
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_INT8:
-        deserialize_field<char>(member, field, deser);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_FLOAT32:
-        deserialize_field<float>(member, field, deser);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_FLOAT64:
-        deserialize_field<double>(member, field, deser);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_INT16:
-        deserialize_field<int16_t>(member, field, deser);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT16:
-        deserialize_field<uint16_t>(member, field, deser);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_INT32:
-        deserialize_field<int32_t>(member, field, deser);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT32:
-        deserialize_field<uint32_t>(member, field, deser);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_INT64:
-        deserialize_field<int64_t>(member, field, deser);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT64:
-        deserialize_field<uint64_t>(member, field, deser);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_STRING:
-        deserialize_field<std::string>(member, field, deser);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_WSTRING:
-        deserialize_field<std::wstring>(member, field, deser);
-        break;
-      case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_MESSAGE:
+    if (!deserializeMember(deser, member, field)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Size of the primitive types which are deserialized by copying their CDR representation,
+// or 0 for other types. Booleans are excluded, as any non-zero byte is true.
+inline size_t get_copied_primitive_size(uint8_t type_id)
+{
+  switch (type_id) {
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_BYTE:
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT8:
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_CHAR:
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_INT8:
+      return 1;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_INT16:
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT16:
+      return 2;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_FLOAT32:
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_INT32:
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT32:
+      return 4;
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_FLOAT64:
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_INT64:
+    case ::rosidl_typesupport_introspection_cpp::ROS_TYPE_UINT64:
+      return 8;
+    default:
+      return 0;
+  }
+}
+
+template<typename MembersType>
+void TypeSupport<MembersType>::buildDeserializationPlan()
+{
+  assert(members_);
+  deserialization_plan_.clear();
+  element_plans_.clear();
+  addToDeserializationPlan(deserialization_plan_, members_, 0);
+}
+
+template<typename MembersType>
+void TypeSupport<MembersType>::addToDeserializationPlan(
+  DeserializationPlan & plan, const MembersType * members, size_t offset)
+{
+  using Kind = typename DeserializationStep::Kind;
+  // A copy extends the previous one if it follows it in memory and is aligned relative to its
+  // start, as CDR then puts no padding in between.
+  auto add_copy = [&plan](size_t field_offset, size_t size, size_t align) {
+      if (!plan.empty()) {
+        auto & last = plan.back();
+        if (last.kind == Kind::Copy && last.offset + last.size == field_offset &&
+          align <= last.align && (field_offset - last.offset) % align == 0)
         {
-          auto sub_members = (const MembersType *)member->members_->data;
-          if (!member->is_array_) {
-            deserializeROSmessage(deser, sub_members, field);
-          } else {
-            size_t array_size = 0;
+          last.size += size;
+          return;
+        }
+      }
+      plan.push_back({Kind::Copy, field_offset, size, align, nullptr, nullptr});
+    };
 
-            if (member->array_size_ && !member->is_upper_bound_) {
-              array_size = member->array_size_;
-            } else {
-              array_size = deser.deserialize_len(1);
-              if (!member->resize_function) {
-                RMW_SET_ERROR_MSG("unexpected error: resize function is null");
-                return false;
-              }
-              member->resize_function(field, array_size);
-            }
+  for (uint32_t i = 0; i < members->member_count_; ++i) {
+    const auto * member = members->members_ + i;
+    const size_t field_offset = offset + member->offset_;
+    const bool is_fixed_array = member->is_array_ && member->array_size_ &&
+      !member->is_upper_bound_;
+
+    if (member->type_id_ == ::rosidl_typesupport_introspection_cpp::ROS_TYPE_MESSAGE) {
+      auto sub_members = (const MembersType *)member->members_->data;
+      if (!member->is_array_) {
+        addToDeserializationPlan(plan, sub_members, field_offset);
+        continue;
+      }
+      element_plans_.push_back(std::make_unique<DeserializationPlan>());
+      const auto & element_plan = *element_plans_.back();
+      addToDeserializationPlan(*element_plans_.back(), sub_members, 0);
+
+      const size_t element_size = sub_members->size_of_;
+      const bool is_single_copy = element_plan.size() == 1 &&
+        element_plan[0].kind == Kind::Copy && element_plan[0].offset == 0 &&
+        element_plan[0].size == element_size && element_size % element_plan[0].align == 0;
+      if (is_single_copy && is_fixed_array) {
+        add_copy(field_offset, element_size * member->array_size_, element_plan[0].align);
+      } else {
+        plan.push_back(
+        {
+          Kind::Messages, field_offset, is_single_copy ? element_size : 0,
+          is_single_copy ? element_plan[0].align : 1, member, &element_plan
+        });
+      }
+      continue;
+    }
 
-            if (array_size != 0 && !member->get_function) {
-              RMW_SET_ERROR_MSG("unexpected error: get_function function is null");
+    const size_t primitive_size = get_copied_primitive_size(member->type_id_);
+    if (primitive_size != 0 && (!member->is_array_ || is_fixed_array)) {
+      const size_t count = member->is_array_ ? member->array_size_ : 1;
+      add_copy(field_offset, primitive_size * count, primitive_size);
+    } else {
+      plan.push_back({Kind::Member, field_offset, 0, 1, member, nullptr});
+    }
+  }
+}
+
+template<typename MembersType>
+bool TypeSupport<MembersType>::deserializeROSmessage(
+  cycdeser & deser, const DeserializationPlan & plan, void * ros_message)
+{
+  using Kind = typename DeserializationStep::Kind;
+  for (const auto & step : plan) {
+    void * field = static_cast<char *>(ros_message) + step.offset;
+    switch (step.kind) {
+      case Kind::Copy:
+        deser.deserialize_bytes(field, step.size, step.align);
+        break;
+      case Kind::Member:
+        if (!deserializeMember(deser, step.member, field)) {
+          return false;
+        }
+        break;
+      case Kind::Messages:
+        {
+          size_t array_size;
+          if (!deserializeMessageArraySize(deser, step.member, field, array_size)) {
+            return false;
+          }
+          if (array_size == 0) {
+            break;
+          }
+          if (step.size != 0) {
+            deser.deserialize_bytes(
+              step.member->get_function(field, 0), array_size * step.size, step.align);
+            break;
+          }
+          for (size_t index = 0; index < array_size; ++index) {
+            if (!deserializeROSmessage(
+                deser, *step.element_plan, step.member->get_function(field, index)))
+            {
               return false;
             }
-            for (size_t index = 0; index < array_size; ++index) {
-              deserializeROSmessage(
-                deser, sub_members, member->get_function(field, index));
-            }
           }
         }
         break;
-      default:
-        throw std::runtime_error("unknown type");
     }
   }
 
@@ -433,7 +595,12 @@ bool TypeSupport<MembersType>::deserializeROSmessage(
   }
 
   if (members_->member_count_ != 0) {
-    TypeSupport::deserializeROSmessage(deser, members_, ros_message);
+    // the plan copies values as they are, so data in the other byte order is walked member
+    // by member
+    if (deser.swaps_bytes()) {
+      return TypeSupport::deserializeROSmessage(deser, members_, ros_message);
+    }
+    return TypeSupport::deserializeROSmessage(deser, deserialization_plan_, ros_message);
   } else {
     uint8_t dump = 0;
     deser >> dump;
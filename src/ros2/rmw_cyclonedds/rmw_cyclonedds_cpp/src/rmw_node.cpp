@@ -73,6 +73,7 @@
 #include "rmw_dds_common/qos.hpp"
 
 #include "rosidl_typesupport_cpp/message_type_support.hpp"
+#include "rosidl_typesupport_cyclonedds_cpp/identifier.hpp"
 
 #include "namespace_prefix.hpp"
 
@@ -350,6 +351,24 @@ struct CddsPublisher : CddsEntity
   dds_data_allocator_t data_allocator;
   uint32_t sample_size;
   bool is_loaning_available;
+  /* whether messages are serialized into shared memory, for types without a fixed size */
+  bool is_serialized_shm_available;
+  /* whether large sequences can be sent from the published message, because the writer does
+     not keep the samples it has sent */
+  bool is_referencing_available;
+};
+
+/* Bookkeeping for the optional "on new data" callback of a reader: events that arrive
+   while no callback is set are counted, and reported when a callback is set.  The count
+   is capped at the history depth of the reader, because older samples have been pushed
+   out of the reader cache by then. */
+struct user_callback_data_t
+{
+  std::mutex mutex;
+  rmw_event_callback_t callback {nullptr};
+  const void * user_data {nullptr};
+  size_t unread_count {0};
+  size_t max_unread_count {std::numeric_limits<size_t>::max()};
 };
 
 struct CddsSubscription : CddsEntity
@@ -359,6 +378,7 @@ struct CddsSubscription : CddsEntity
   rosidl_message_type_support_t type_supports;
   dds_data_allocator_t data_allocator;
   bool is_loaning_available;
+  user_callback_data_t user_callback_data;
 };
 
 struct client_service_id_t
@@ -1600,6 +1620,21 @@ static dds_entity_t create_topic(dds_entity_t pp, const char * name, struct ddsi
 ///////////                                                                   ///////////
 /////////////////////////////////////////////////////////////////////////////////////////
 
+#ifdef DDS_HAS_SHM
+/* Cyclone waits for a chunk held by a subscriber for at most the max blocking time of the
+   writer, and fails right away if the publisher can not get one at all */
+static void set_shm_publish_error(dds_return_t ret)
+{
+  if (ret == DDS_RETCODE_TIMEOUT) {
+    RMW_SET_ERROR_MSG("failed to publish data: no shared memory chunk was released in time");
+  } else if (ret == DDS_RETCODE_OUT_OF_RESOURCES) {
+    RMW_SET_ERROR_MSG("failed to publish data: no shared memory chunk is available");
+  } else {
+    RMW_SET_ERROR_MSG("failed to publish data");
+  }
+}
+#endif  // DDS_HAS_SHM
+
 extern "C" rmw_ret_t rmw_publish(
   const rmw_publisher_t * publisher, const void * ros_message,
   rmw_publisher_allocation_t * allocation)
@@ -1616,7 +1651,54 @@ extern "C" rmw_ret_t rmw_publish(
     return RMW_RET_INVALID_ARGUMENT);
   auto pub = static_cast<CddsPublisher *>(publisher->data);
   assert(pub);
-  if (dds_write(pub->enth, ros_message) >= 0) {
+#ifdef DDS_HAS_SHM
+  // dds_write copies the sample into shared memory
+  if (pub->is_loaning_available) {
+    const dds_return_t ret = dds_write(pub->enth, ros_message);
+    if (ret >= 0) {
+      return RMW_RET_OK;
+    } else {
+      set_shm_publish_error(ret);
+      return RMW_RET_ERROR;
+    }
+  }
+  // other types are serialized into shared memory
+  if (pub->is_serialized_shm_available) {
+    struct ddsi_serdata * d =
+      serdata_rmw_from_sample_in_iox_chunk(pub->sertype, ros_message, pub->enth);
+    if (d == nullptr) {
+      return RMW_RET_ERROR;
+    }
+    const dds_return_t ret = dds_writecdr(pub->enth, d);
+    if (ret >= 0) {
+      return RMW_RET_OK;
+    } else {
+      set_shm_publish_error(ret);
+      return RMW_RET_ERROR;
+    }
+  }
+#endif
+  // Writers keeping their samples would copy them all after the write anyway, and the write
+  // would wait until the references into the message are released
+  if (!pub->is_referencing_available) {
+    if (dds_write(pub->enth, ros_message) >= 0) {
+      return RMW_RET_OK;
+    } else {
+      RMW_SET_ERROR_MSG("failed to publish data");
+      return RMW_RET_ERROR;
+    }
+  }
+  // Large sequences are sent from the message itself; a serdata still kept by a local reader
+  // after the write gets a copy of them
+  struct ddsi_serdata * d = serdata_rmw_from_sample_referencing(pub->sertype, ros_message);
+  if (d == nullptr) {
+    RMW_SET_ERROR_MSG("failed to serialize data");
+    return RMW_RET_ERROR;
+  }
+  const bool ok = (dds_writecdr(pub->enth, ddsi_serdata_ref(d)) >= 0);
+  serdata_rmw_release_sample(d, pub->enth);
+  ddsi_serdata_unref(d);
+  if (ok) {
     return RMW_RET_OK;
   } else {
     RMW_SET_ERROR_MSG("failed to publish data");
@@ -1747,6 +1829,28 @@ static const rosidl_message_type_support_t * get_typesupport(
   }
 }
 
+/* Returns the generated serialization functions for a message type that uses the C++
+   introspection type support, or a null pointer if the message package doesn't provide them */
+static const rosidl_typesupport_cyclonedds_cpp::message_type_support_callbacks_t *
+get_generated_callbacks(
+  const rosidl_message_type_support_t * type_supports,
+  const rosidl_message_type_support_t * type_support)
+{
+  if (type_support->typesupport_identifier !=
+    rosidl_typesupport_introspection_cpp::typesupport_identifier)
+  {
+    return nullptr;
+  }
+  const rosidl_message_type_support_t * ts = get_message_typesupport_handle(
+    type_supports, rosidl_typesupport_cyclonedds_cpp::typesupport_identifier);
+  if (ts == nullptr) {
+    rcutils_reset_error();
+    return nullptr;
+  }
+  return static_cast<const rosidl_typesupport_cyclonedds_cpp::message_type_support_callbacks_t *>(
+    ts->data);
+}
+
 static std::string make_fqtopic(
   const char * prefix, const char * topic_name, const char * suffix,
   bool avoid_ros_namespace_conventions)
@@ -2059,6 +2163,17 @@ static bool is_type_self_contained(const rosidl_message_type_support_t * type_su
   }
 }
 
+/* Reliable writers keep samples until they are acknowledged, transient-local ones for late
+   joining readers; policies left unset take the defaults of a DDS writer */
+static bool writer_keeps_samples(const dds_qos_t * qos)
+{
+  dds_reliability_kind_t reliability = DDS_RELIABILITY_RELIABLE;
+  dds_durability_kind_t durability = DDS_DURABILITY_VOLATILE;
+  static_cast<void>(dds_qget_reliability(qos, &reliability, nullptr));
+  static_cast<void>(dds_qget_durability(qos, &durability));
+  return reliability != DDS_RELIABILITY_BEST_EFFORT || durability != DDS_DURABILITY_VOLATILE;
+}
+
 static CddsPublisher * create_cdds_publisher(
   dds_entity_t dds_ppant, dds_entity_t dds_pub,
   const rosidl_message_type_support_t * type_supports,
@@ -2079,7 +2194,8 @@ static CddsPublisher * create_cdds_publisher(
   auto sertype = create_sertype(
     fqtopic_name.c_str(), type_support->typesupport_identifier,
     create_message_type_support(type_support->data, type_support->typesupport_identifier), false,
-    rmw_cyclonedds_cpp::make_message_value_type(type_supports), sample_size, is_fixed_type);
+    rmw_cyclonedds_cpp::make_message_value_type(type_supports), sample_size, is_fixed_type,
+    get_generated_callbacks(type_supports, type_support));
   struct ddsi_sertype * stact;
   topic = create_topic(dds_ppant, fqtopic_name.c_str(), sertype, &stact);
   if (topic < 0) {
@@ -2106,6 +2222,13 @@ static CddsPublisher * create_cdds_publisher(
 #else
     false;
 #endif  // DDS_HAS_SHM
+  pub->is_serialized_shm_available =
+#ifdef DDS_HAS_SHM
+    !is_fixed_type && is_loan_available(pub->enth);
+#else
+    false;
+#endif  // DDS_HAS_SHM
+  pub->is_referencing_available = !writer_keeps_samples(qos);
   pub->sample_size = sample_size;
   dds_delete_qos(qos);
   dds_delete(topic);
@@ -2527,6 +2650,62 @@ extern "C" rmw_ret_t rmw_destroy_publisher(rmw_node_t * node, rmw_publisher_t *
 ///////////                                                                   ///////////
 /////////////////////////////////////////////////////////////////////////////////////////
 
+static void dds_listener_callback(dds_entity_t entity, void * arg)
+{
+  // Called by Cyclone with the listener lock held, so keep it short.
+  static_cast<void>(entity);
+  auto data = static_cast<user_callback_data_t *>(arg);
+  std::lock_guard<std::mutex> guard(data->mutex);
+  if (data->callback) {
+    data->callback(data->user_data, 1);
+  } else if (data->unread_count < data->max_unread_count) {
+    data->unread_count++;
+  }
+}
+
+static dds_listener_t * create_data_available_listener(
+  user_callback_data_t * data, const dds_qos_t * qos)
+{
+  dds_history_kind_t kind;
+  int32_t depth;
+  if (dds_qget_history(qos, &kind, &depth) && kind == DDS_HISTORY_KEEP_LAST) {
+    data->max_unread_count = static_cast<size_t>(depth);
+  }
+  dds_listener_t * listener = dds_create_listener(data);
+  dds_lset_data_available(listener, dds_listener_callback);
+  return listener;
+}
+
+static rmw_ret_t set_user_callback(
+  user_callback_data_t * data, rmw_event_callback_t callback, const void * user_data)
+{
+  std::lock_guard<std::mutex> guard(data->mutex);
+  data->callback = callback;
+  data->user_data = user_data;
+  if (callback && data->unread_count > 0) {
+    // Report the events that arrived while no callback was set.
+    callback(user_data, data->unread_count);
+    data->unread_count = 0;
+  }
+  return RMW_RET_OK;
+}
+
+extern "C" rmw_ret_t rmw_subscription_set_on_new_message_callback(
+  rmw_subscription_t * subscription,
+  rmw_event_callback_t callback,
+  const void * user_data)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(subscription, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    subscription,
+    subscription->implementation_identifier,
+    eclipse_cyclonedds_identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+
+  auto sub = static_cast<CddsSubscription *>(subscription->data);
+  return set_user_callback(&sub->user_callback_data, callback, user_data);
+}
+
 static CddsSubscription * create_cdds_subscription(
   dds_entity_t dds_ppant, dds_entity_t dds_sub,
   const rosidl_message_type_support_t * type_supports, const char * topic_name,
@@ -2546,7 +2725,8 @@ static CddsSubscription * create_cdds_subscription(
   auto sertype = create_sertype(
     fqtopic_name.c_str(), type_support->typesupport_identifier,
     create_message_type_support(type_support->data, type_support->typesupport_identifier), false,
-    rmw_cyclonedds_cpp::make_message_value_type(type_supports), sample_size, is_fixed_type);
+    rmw_cyclonedds_cpp::make_message_value_type(type_supports), sample_size, is_fixed_type,
+    get_generated_callbacks(type_supports, type_support));
   topic = create_topic(dds_ppant, fqtopic_name.c_str(), sertype);
   if (topic < 0) {
     RMW_SET_ERROR_MSG("failed to create topic");
@@ -2555,7 +2735,12 @@ static CddsSubscription * create_cdds_subscription(
   if ((qos = create_readwrite_qos(qos_policies, ignore_local_publications)) == nullptr) {
     goto fail_qos;
   }
-  if ((sub->enth = dds_create_reader(dds_sub, topic, qos, nullptr)) < 0) {
+  {
+    dds_listener_t * listener = create_data_available_listener(&sub->user_callback_data, qos);
+    sub->enth = dds_create_reader(dds_sub, topic, qos, listener);
+    dds_delete_listener(listener);
+  }
+  if (sub->enth < 0) {
     RMW_SET_ERROR_MSG("failed to create reader");
     goto fail_reader;
   }
@@ -2943,48 +3128,48 @@ static rmw_ret_t rmw_take_seq(
   CddsSubscription * sub = static_cast<CddsSubscription *>(subscription->data);
   RET_NULL(sub);
 
-  std::vector<dds_sample_info_t> infos(count);
+  // Sample infos for typical batch sizes live on the stack, so that taking does not allocate.
+  constexpr size_t max_stack_infos = 32u;
+  dds_sample_info_t stack_infos[max_stack_infos];
+  std::unique_ptr<dds_sample_info_t[]> heap_infos;
+  dds_sample_info_t * infos = stack_infos;
+  if (count > max_stack_infos) {
+    heap_infos.reset(new dds_sample_info_t[count]);
+    infos = heap_infos.get();
+  }
+
+  // A single take locks the reader once and deserializes all samples in one go.
   auto maxsamples = static_cast<uint32_t>(count);
-  auto ret = dds_take(sub->enth, message_sequence->data, infos.data(), count, maxsamples);
+  auto ret = dds_take(sub->enth, message_sequence->data, infos, count, maxsamples);
 
   // Returning 0 should not be an error, as it just indicates that no messages were available.
   if (ret < 0) {
     return RMW_RET_ERROR;
   }
 
-  // Keep track of taken/not taken to reorder sequence with valid messages at the front
-  std::vector<void *> taken_msg;
-  std::vector<void *> not_taken_msg;
+  // Move the valid messages to the front of the sequence, in order, swapping the invalid ones
+  // behind them, so that no bookkeeping needs to be allocated.
   *taken = 0u;
-
-  for (int ii = 0; ii < ret; ++ii) {
+  for (int32_t ii = 0; ii < ret; ++ii) {
     const dds_sample_info_t & info = infos[ii];
-
-    void * message = &message_sequence->data[ii];
-    rmw_message_info_t * message_info = &message_info_sequence->data[*taken];
-
-    if (info.valid_data) {
-      taken_msg.push_back(message);
-      (*taken)++;
-      if (message_info) {
-        message_info->publisher_gid.implementation_identifier = eclipse_cyclonedds_identifier;
-        memset(message_info->publisher_gid.data, 0, sizeof(message_info->publisher_gid.data));
-        assert(sizeof(info.publication_handle) <= sizeof(message_info->publisher_gid.data));
-        memcpy(
-          message_info->publisher_gid.data, &info.publication_handle,
-          sizeof(info.publication_handle));
-      }
-    } else {
-      not_taken_msg.push_back(message);
+    if (!info.valid_data) {
+      continue;
+    }
+    if (*taken != static_cast<size_t>(ii)) {
+      std::swap(message_sequence->data[*taken], message_sequence->data[ii]);
     }
-  }
-
-  for (size_t ii = 0; ii < taken_msg.size(); ++ii) {
-    message_sequence->data[ii] = taken_msg[ii];
-  }
 
-  for (size_t ii = 0; ii < not_taken_msg.size(); ++ii) {
-    message_sequence->data[ii + taken_msg.size()] = not_taken_msg[ii];
+    rmw_message_info_t * message_info = &message_info_sequence->data[*taken];
+    message_info->publisher_gid.implementation_identifier = eclipse_cyclonedds_identifier;
+    memset(message_info->publisher_gid.data, 0, sizeof(message_info->publisher_gid.data));
+    assert(sizeof(info.publication_handle) <= sizeof(message_info->publisher_gid.data));
+    memcpy(
+      message_info->publisher_gid.data, &info.publication_handle,
+      sizeof(info.publication_handle));
+    message_info->source_timestamp = info.source_timestamp;
+    // TODO(iluetkeb) add received timestamp, when implemented by Cyclone
+    message_info->received_timestamp = 0;
+    (*taken)++;
   }
 
   message_sequence->size = *taken;
@@ -4349,7 +4534,12 @@ static rmw_ret_t rmw_init_cs(
   }
   get_entity_gid(pub->enth, pub->gid);
   pub->sertype = pub_stact;
-  if ((sub->enth = dds_create_reader(node->context->impl->dds_sub, subtopic, qos, nullptr)) < 0) {
+  {
+    dds_listener_t * listener = create_data_available_listener(&sub->user_callback_data, qos);
+    sub->enth = dds_create_reader(node->context->impl->dds_sub, subtopic, qos, listener);
+    dds_delete_listener(listener);
+  }
+  if (sub->enth < 0) {
     RMW_SET_ERROR_MSG("failed to create reader");
     goto fail_reader;
   }
@@ -4779,6 +4969,30 @@ static rmw_ret_t check_for_service_reader_writer(const CddsCS & client, bool * i
   return RMW_RET_OK;
 }
 
+extern "C" rmw_ret_t rmw_client_set_on_new_response_callback(
+  rmw_client_t * client,
+  rmw_event_callback_t callback,
+  const void * user_data)
+{
+  RET_NULL_X(client, return RMW_RET_INVALID_ARGUMENT);
+  RET_WRONG_IMPLID(client);
+
+  auto info = static_cast<CddsClient *>(client->data);
+  return set_user_callback(&info->client.sub->user_callback_data, callback, user_data);
+}
+
+extern "C" rmw_ret_t rmw_service_set_on_new_request_callback(
+  rmw_service_t * service,
+  rmw_event_callback_t callback,
+  const void * user_data)
+{
+  RET_NULL_X(service, return RMW_RET_INVALID_ARGUMENT);
+  RET_WRONG_IMPLID(service);
+
+  auto info = static_cast<CddsService *>(service->data);
+  return set_user_callback(&info->service.sub->user_callback_data, callback, user_data);
+}
+
 extern "C" rmw_ret_t rmw_service_server_is_available(
   const rmw_node_t * node,
   const rmw_client_t * client,
@@ -13,6 +13,10 @@
 // limitations under the License.
 #include "serdata.hpp"
 
+#include <algorithm>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdlib>
 #include <cstring>
 #include <memory>
 #include <regex>
@@ -24,7 +28,10 @@
 #include "Serialization.hpp"
 #include "TypeSupport2.hpp"
 #include "bytewise.hpp"
+#include "dds/ddsc/dds_data_allocator.h"
 #include "dds/ddsi/q_radmin.h"
+#include "rcutils/get_env.h"
+#include "rcutils/logging_macros.h"
 #include "rmw/error_handling.h"
 #include "MessageTypeSupport.hpp"
 #include "ServiceTypeSupport.hpp"
@@ -119,9 +126,15 @@ static void serialize_into_serdata_rmw(serdata_rmw * d, const void * sample)
     if (d->kind != SDK_DATA) {
       /* ROS 2 doesn't do keys, so SDK_KEY is trivial */
     } else if (!type->is_request_header) {
-      size_t sz = type->cdr_writer->get_serialized_size(sample);
-      d->resize(sz);
-      type->cdr_writer->serialize(d->data(), sample);
+      if (type->generated_callbacks != nullptr) {
+        size_t sz = type->generated_callbacks->get_serialized_size(sample);
+        d->resize(sz);
+        type->generated_callbacks->serialize(sample, d->data(), sz);
+      } else {
+        size_t sz = type->cdr_writer->get_serialized_size(sample);
+        d->resize(sz);
+        type->cdr_writer->serialize(d->data(), sample);
+      }
     } else {
       /* inject the service invocation header data into the CDR stream --
        * I haven't checked how it is done in the official RMW implementations, so it is
@@ -136,6 +149,49 @@ static void serialize_into_serdata_rmw(serdata_rmw * d, const void * sample)
   }
 }
 
+/* Sequences referenced by serdata_rmw_from_sample_referencing are at least this large, so that
+   a fragment of a message spans only a few pieces of the serdata */
+static constexpr size_t min_reference_size = 64 * 1024;
+
+static void serialize_into_serdata_rmw_referencing(serdata_rmw * d, const void * sample)
+{
+  const struct sertype_rmw * type = static_cast<const struct sertype_rmw *>(d->type);
+  try {
+    if (type->generated_callbacks != nullptr) {
+      /* the generated code copies everything, which is what referencing would do anyway for
+         messages without large sequences */
+      size_t sz = type->generated_callbacks->get_serialized_size(sample);
+      if (sz < min_reference_size) {
+        d->resize(sz);
+        type->generated_callbacks->serialize(sample, d->data(), sz);
+        return;
+      }
+    }
+    size_t referenced_size;
+    size_t copied_size =
+      type->cdr_writer->get_serialized_size_referencing(sample, min_reference_size, &referenced_size);
+    if (referenced_size == 0) {
+      d->resize(copied_size);
+      type->cdr_writer->serialize(d->data(), sample);
+    } else {
+      d->resize_referencing(copied_size, referenced_size);
+      type->cdr_writer->serialize_referencing(
+        d->data(), sample, min_reference_size, d->references());
+    }
+  } catch (std::exception & e) {
+    RMW_SET_ERROR_MSG(e.what());
+  }
+}
+
+#ifdef DDS_HAS_SHM
+static bool has_serialized_iox_chunk(const serdata_rmw * d)
+{
+  return d->iox_chunk != nullptr &&
+         static_cast<const iceoryx_header_t *>(d->iox_chunk)->data_state ==
+         IOX_CHUNK_CONTAINS_SERIALIZED_DATA;
+}
+#endif  // DDS_HAS_SHM
+
 static void serialize_into_serdata_rmw_on_demand(serdata_rmw * d)
 {
 #ifdef DDS_HAS_SHM
@@ -143,9 +199,15 @@ static void serialize_into_serdata_rmw_on_demand(serdata_rmw * d)
   {
     std::lock_guard<std::mutex> lock(type->serialize_lock);
     if (d->iox_chunk && d->data() == nullptr) {
-      serialize_into_serdata_rmw(
-        const_cast<serdata_rmw *>(d),
-        SHIFT_PAST_ICEORYX_HEADER(d->iox_chunk));
+      if (has_serialized_iox_chunk(d)) {
+        auto ice_hdr = static_cast<const iceoryx_header_t *>(d->iox_chunk);
+        d->resize(ice_hdr->data_size);
+        memcpy(d->data(), SHIFT_PAST_ICEORYX_HEADER(d->iox_chunk), ice_hdr->data_size);
+      } else {
+        serialize_into_serdata_rmw(
+          const_cast<serdata_rmw *>(d),
+          SHIFT_PAST_ICEORYX_HEADER(d->iox_chunk));
+      }
     }
   }
 #endif
@@ -164,7 +226,14 @@ static uint32_t serdata_rmw_size(const struct ddsi_serdata * dcmn)
 
 static void serdata_rmw_free(struct ddsi_serdata * dcmn)
 {
-  auto * d = static_cast<const serdata_rmw *>(dcmn);
+  auto * d = static_cast<serdata_rmw *>(dcmn);
+#ifdef DDS_HAS_SHM
+  /* a received chunk with a serialized sample is only referenced by the serdata, whereas one
+     with the sample itself is handed out by rmw_take_loaned_message */
+  if (d->iox_subscriber != nullptr && has_serialized_iox_chunk(d)) {
+    ddsi_serdata_iox_release_chunk(d);
+  }
+#endif
   delete d;
 }
 
@@ -244,14 +313,101 @@ static struct ddsi_serdata * serdata_rmw_from_iox(
   const struct ddsi_sertype * typecmn,
   enum  ddsi_serdata_kind kind, void * sub, void * iox_buffer)
 {
-  static_cast<void>(sub);  // unused
   const struct sertype_rmw * type = static_cast<const struct sertype_rmw *>(typecmn);
   auto d = std::make_unique<serdata_rmw>(type, kind);
+  /* the data stays in the chunk: a serialized sample is deserialized from it when taken */
   d->iox_chunk = iox_buffer;
+  d->iox_subscriber = sub;
   return d.release();
 }
+
+struct ddsi_serdata * serdata_rmw_from_sample_in_iox_chunk(
+  const struct ddsi_sertype * typecmn,
+  const void * sample, dds_entity_t writer)
+{
+  try {
+    const struct sertype_rmw * type = static_cast<const struct sertype_rmw *>(typecmn);
+    size_t size;
+    if (type->generated_callbacks != nullptr) {
+      size = type->generated_callbacks->get_serialized_size(sample);
+    } else {
+      size = type->cdr_writer->get_serialized_size(sample);
+    }
+    if (size > type->iox_size) {
+      RMW_SET_ERROR_MSG_WITH_FORMAT_STRING(
+        "serialized message of %zu bytes exceeds RMW_CYCLONEDDS_SHM_MAX_SERIALIZED_SIZE of %"
+        PRIu32 " bytes", size, type->iox_size);
+      return nullptr;
+    }
+
+    auto d = std::make_unique<serdata_rmw>(type, SDK_DATA);
+    dds_data_allocator_t allocator;
+    if (dds_data_allocator_init(writer, &allocator) != DDS_RETCODE_OK) {
+      RMW_SET_ERROR_MSG("failed to initialize the data allocator of the writer");
+      return nullptr;
+    }
+    void * chunk = dds_data_allocator_alloc(&allocator, DETERMINE_ICEORYX_CHUNK_SIZE(size));
+    if (chunk == nullptr) {
+      /* all chunks are in use: Cyclone copies the data into one when it is written */
+      dds_data_allocator_fini(&allocator);
+      serialize_into_serdata_rmw(d.get(), sample);
+      return d.release();
+    }
+    try {
+      void * payload = SHIFT_PAST_ICEORYX_HEADER(chunk);
+      if (type->generated_callbacks != nullptr) {
+        type->generated_callbacks->serialize(sample, payload, size);
+      } else {
+        type->cdr_writer->serialize(payload, sample);
+      }
+    } catch (std::exception &) {
+      dds_data_allocator_free(&allocator, chunk);
+      dds_data_allocator_fini(&allocator);
+      throw;
+    }
+    dds_data_allocator_fini(&allocator);
+    auto ice_hdr = static_cast<iceoryx_header_t *>(chunk);
+    ice_hdr->data_size = static_cast<uint32_t>(size);
+    ice_hdr->data_state = IOX_CHUNK_CONTAINS_SERIALIZED_DATA;
+    d->iox_chunk = chunk;
+    return d.release();
+  } catch (std::exception & e) {
+    RMW_SET_ERROR_MSG(e.what());
+    return nullptr;
+  }
+}
 #endif  // DDS_HAS_SHM
 
+struct ddsi_serdata * serdata_rmw_from_sample_referencing(
+  const struct ddsi_sertype * typecmn,
+  const void * sample)
+{
+  try {
+    const struct sertype_rmw * type = static_cast<const struct sertype_rmw *>(typecmn);
+    auto d = std::make_unique<serdata_rmw>(type, SDK_DATA);
+    if (type->is_request_header) {
+      serialize_into_serdata_rmw(d.get(), sample);
+    } else {
+      serialize_into_serdata_rmw_referencing(d.get(), sample);
+    }
+    return d.release();
+  } catch (std::exception & e) {
+    RMW_SET_ERROR_MSG(e.what());
+    return nullptr;
+  }
+}
+
+void serdata_rmw_release_sample(struct ddsi_serdata * dcmn, dds_entity_t writer)
+{
+  auto d = static_cast<serdata_rmw *>(dcmn);
+  if (d->release_sample()) {
+    return;
+  }
+  /* a batching writer may not have sent the messages referencing the sample yet */
+  dds_write_flush(writer);
+  d->wait_for_sample_release();
+}
+
 struct ddsi_serdata * serdata_rmw_from_serialized_message(
   const struct ddsi_sertype * typecmn,
   const void * raw, size_t size)
@@ -282,7 +438,7 @@ static void serdata_rmw_to_ser(const struct ddsi_serdata * dcmn, size_t off, siz
 {
   auto d = static_cast<const serdata_rmw *>(dcmn);
   serialize_into_serdata_rmw_on_demand(const_cast<serdata_rmw *>(d));
-  memcpy(buf, byte_offset(d->data(), off), sz);
+  const_cast<serdata_rmw *>(d)->copy_serialized(off, sz, buf);
 }
 
 static struct ddsi_serdata * serdata_rmw_to_ser_ref(
@@ -291,6 +447,8 @@ static struct ddsi_serdata * serdata_rmw_to_ser_ref(
 {
   auto d = static_cast<const serdata_rmw *>(dcmn);
   serialize_into_serdata_rmw_on_demand(const_cast<serdata_rmw *>(d));
+  /* references into the sample are only handed out by to_ser_ref_iov */
+  const_cast<serdata_rmw *>(d)->make_contiguous();
   ref->iov_base = byte_offset(d->data(), off);
   ref->iov_len = (ddsrt_iov_len_t) sz;
   return ddsi_serdata_ref(d);
@@ -302,6 +460,28 @@ static void serdata_rmw_to_ser_unref(struct ddsi_serdata * dcmn, const ddsrt_iov
   ddsi_serdata_unref(static_cast<serdata_rmw *>(dcmn));
 }
 
+#if DDSI_SERDATA_HAS_TO_SER_REF_IOV
+static struct ddsi_serdata * serdata_rmw_to_ser_ref_iov(
+  const struct ddsi_serdata * dcmn, size_t off, size_t sz,
+  ddsrt_msg_iovlen_t * niov, ddsrt_iovec_t * ref)
+{
+  auto d = static_cast<const serdata_rmw *>(dcmn);
+  serialize_into_serdata_rmw_on_demand(const_cast<serdata_rmw *>(d));
+  *niov = static_cast<ddsrt_msg_iovlen_t>(
+    const_cast<serdata_rmw *>(d)->ref_serialized(off, sz, static_cast<size_t>(*niov), ref));
+  return ddsi_serdata_ref(d);
+}
+
+static void serdata_rmw_to_ser_unref_iov(
+  struct ddsi_serdata * dcmn, ddsrt_msg_iovlen_t niov,
+  const ddsrt_iovec_t * ref)
+{
+  auto d = static_cast<serdata_rmw *>(dcmn);
+  d->unref_serialized(static_cast<size_t>(niov), ref);
+  ddsi_serdata_unref(d);
+}
+#endif  // DDSI_SERDATA_HAS_TO_SER_REF_IOV
+
 static bool serdata_rmw_to_sample(
   const struct ddsi_serdata * dcmn, void * sample, void ** bufptr,
   void * buflim)
@@ -320,8 +500,29 @@ static bool serdata_rmw_to_sample(
     if (d->kind != SDK_DATA) {
       /* ROS 2 doesn't do keys in a meaningful way yet */
     } else if (!type->is_request_header) {
-      serialize_into_serdata_rmw_on_demand(const_cast<serdata_rmw *>(d));
-      cycdeser sd(d->data(), d->size());
+      const void * data;
+      size_t size;
+#ifdef DDS_HAS_SHM
+      if (has_serialized_iox_chunk(d) && d->data() == nullptr) {
+        /* deserialize straight from shared memory */
+        data = SHIFT_PAST_ICEORYX_HEADER(d->iox_chunk);
+        size = static_cast<const iceoryx_header_t *>(d->iox_chunk)->data_size;
+      } else  // NOLINT
+#endif
+      {
+        serialize_into_serdata_rmw_on_demand(const_cast<serdata_rmw *>(d));
+        const_cast<serdata_rmw *>(d)->make_contiguous();
+        data = d->data();
+        size = d->size();
+      }
+      /* the generated code only handles the native byte order, for anything else fall back
+         to introspection */
+      if (type->generated_callbacks != nullptr &&
+        type->generated_callbacks->deserialize(data, size, sample))
+      {
+        return true;
+      }
+      cycdeser sd(data, size);
       if (using_introspection_c_typesupport(type->type_support.typesupport_identifier_)) {
         auto typed_typesupport =
           static_cast<MessageTypeSupport_c *>(type->type_support.type_support_);
@@ -394,6 +595,7 @@ static size_t serdata_rmw_print(
       return static_cast<size_t>(snprintf(buf, bufsize, ":k:{}"));
     } else if (!type->is_request_header) {
       serialize_into_serdata_rmw_on_demand(const_cast<serdata_rmw *>(d));
+      const_cast<serdata_rmw *>(d)->make_contiguous();
       cycprint sd(buf, bufsize, d->data(), d->size());
       if (using_introspection_c_typesupport(type->type_support.typesupport_identifier_)) {
         auto typed_typesupport =
@@ -465,6 +667,10 @@ static const struct ddsi_serdata_ops serdata_rmw_ops = {
   , ddsi_serdata_iox_size,
   serdata_rmw_from_iox
 #endif  // DDS_HAS_SHM
+#if DDSI_SERDATA_HAS_TO_SER_REF_IOV
+  , serdata_rmw_to_ser_ref_iov,
+  serdata_rmw_to_ser_unref_iov
+#endif  // DDSI_SERDATA_HAS_TO_SER_REF_IOV
 };
 
 static void sertype_rmw_free(struct ddsi_sertype * tpcmn)
@@ -532,6 +738,9 @@ bool sertype_rmw_equal(
   if (a->is_request_header != b->is_request_header) {
     return false;
   }
+  if (a->generated_callbacks != b->generated_callbacks) {
+    return false;
+  }
   if (strcmp(
       a->type_support.typesupport_identifier_,
       b->type_support.typesupport_identifier_) != 0)
@@ -607,11 +816,42 @@ static std::string get_type_name(const char * type_support_identifier, void * ty
   }
 }
 
+#ifdef DDS_HAS_SHM
+/* Messages of types without a fixed size are exchanged through shared memory serialized, if
+   RMW_CYCLONEDDS_SHM_MAX_SERIALIZED_SIZE gives the largest serialized message to put in an
+   iceoryx chunk.  Chunks of that size must be available in the mempools iceoryx is configured
+   with; publishing a larger message fails. */
+static uint32_t read_shm_max_serialized_size()
+{
+  const char * value;
+  if (rcutils_get_env("RMW_CYCLONEDDS_SHM_MAX_SERIALIZED_SIZE", &value) != nullptr ||
+    *value == '\0')
+  {
+    return 0;
+  }
+  char * end;
+  unsigned long long size = std::strtoull(value, &end, 10);  // NOLINT
+  if (*end != '\0' || size > UINT32_MAX - DETERMINE_ICEORYX_CHUNK_SIZE(0)) {
+    RCUTILS_LOG_ERROR_NAMED(
+      "rmw_cyclonedds_cpp", "invalid RMW_CYCLONEDDS_SHM_MAX_SERIALIZED_SIZE: %s", value);
+    return 0;
+  }
+  return static_cast<uint32_t>(size);
+}
+
+static uint32_t get_shm_max_serialized_size()
+{
+  static const uint32_t max_serialized_size = read_shm_max_serialized_size();
+  return max_serialized_size;
+}
+#endif  // DDS_HAS_SHM
+
 struct sertype_rmw * create_sertype(
   const char * topicname, const char * type_support_identifier,
   void * type_support, bool is_request_header,
   std::unique_ptr<rmw_cyclonedds_cpp::StructValueType> message_type,
-  const uint32_t sample_size, const bool is_fixed_type)
+  const uint32_t sample_size, const bool is_fixed_type,
+  const rosidl_typesupport_cyclonedds_cpp::message_type_support_callbacks_t * generated_callbacks)
 {
   struct sertype_rmw * st = new struct sertype_rmw;
 #if DDS_HAS_DDSI_SERTYPE
@@ -620,14 +860,17 @@ struct sertype_rmw * create_sertype(
   // TODO(Sumanth) fix this once Cyclone supports this API in master
 #ifdef DDS_HAS_SHM
   uint32_t flags = DDSI_SERTYPE_FLAG_TOPICKIND_NO_KEY;
+  const uint32_t shm_max_serialized_size = get_shm_max_serialized_size();
   if (is_fixed_type) {
     flags |= DDSI_SERTYPE_FLAG_FIXED_SIZE;
+  } else if (!is_request_header && shm_max_serialized_size > 0) {
+    flags |= DDSI_SERTYPE_FLAG_SHM_SERIALIZED;
   }
   ddsi_sertype_init_flags(
     static_cast<struct ddsi_sertype *>(st),
     type_name.c_str(), &sertype_rmw_ops, &serdata_rmw_ops, flags);
   // TODO(Sumanth) needs some API in cyclone to set this
-  st->iox_size = sample_size;
+  st->iox_size = is_fixed_type ? sample_size : shm_max_serialized_size;
 #else
   (void)sample_size;
   (void)is_fixed_type;
@@ -645,6 +888,7 @@ struct sertype_rmw * create_sertype(
   st->type_support.type_support_ = type_support;
   st->is_request_header = is_request_header;
   st->cdr_writer = rmw_cyclonedds_cpp::make_cdr_writer(std::move(message_type));
+  st->generated_callbacks = generated_callbacks;
 
   return st;
 }
@@ -672,3 +916,171 @@ serdata_rmw::serdata_rmw(const ddsi_sertype * type, ddsi_serdata_kind kind)
 {
   ddsi_serdata_init(this, type, kind);
 }
+
+void serdata_rmw::resize_referencing(size_t copied_size, size_t referenced_size)
+{
+  /* the padding goes at the end of the copied data, which also holds the end of the data */
+  size_t n_pad_bytes = (0 - (copied_size + referenced_size)) % 4;
+  m_copied_size = copied_size + n_pad_bytes;
+  m_data.reset(new byte[m_copied_size]);
+  m_size = copied_size + referenced_size + n_pad_bytes;
+  std::memset(byte_offset(m_data.get(), copied_size), '\0', n_pad_bytes);
+  m_references.clear();
+  m_has_references = true;
+  m_referencing.store(true, std::memory_order_release);
+}
+
+/* Calls fn(data, size) for the pieces of bytes [off, off + sz) while referencing */
+template<typename Fn>
+void serdata_rmw::for_each_piece(size_t off, size_t sz, Fn && fn) const
+{
+  const size_t end = off + sz;
+  size_t pos = 0;
+  size_t copied_pos = 0;
+  auto piece = [&](const void * data, size_t size) {
+      if (size != 0 && pos < end && off < pos + size) {
+        size_t from = std::max(off, pos);
+        size_t to = std::min(end, pos + size);
+        fn(byte_offset(data, from - pos), to - from);
+      }
+      pos += size;
+    };
+  for (const auto & ref : m_references) {
+    piece(byte_offset(m_data.get(), copied_pos), ref.copied_offset - copied_pos);
+    piece(ref.data, ref.size);
+    copied_pos = ref.copied_offset;
+    if (pos >= end) {
+      return;
+    }
+  }
+  piece(byte_offset(m_data.get(), copied_pos), m_copied_size - copied_pos);
+}
+
+bool serdata_rmw::is_copied(const void * p) const
+{
+  auto in = [p](const void * buf, size_t size) {
+      auto a = reinterpret_cast<uintptr_t>(p);
+      auto b = reinterpret_cast<uintptr_t>(buf);
+      return buf != nullptr && b <= a && a < b + size;
+    };
+  if (m_referencing.load(std::memory_order_relaxed)) {
+    return in(m_data.get(), m_copied_size);
+  }
+  return in(m_data.get(), m_size) || in(m_copied_data.get(), m_copied_size);
+}
+
+void serdata_rmw::make_contiguous_locked()
+{
+  if (!m_referencing.load(std::memory_order_relaxed)) {
+    return;
+  }
+  std::unique_ptr<byte[]> data(new byte[m_size]);
+  void * cursor = data.get();
+  for_each_piece(
+    0, m_size, [&cursor](const void * piece, size_t size) {
+      std::memcpy(cursor, piece, size);
+      cursor = byte_offset(cursor, size);
+    });
+  /* to_ser_ref_iov may have handed out references to the copied data */
+  m_copied_data = std::move(m_data);
+  m_data = std::move(data);
+  m_references.clear();
+  m_referencing.store(false, std::memory_order_release);
+}
+
+void serdata_rmw::make_contiguous()
+{
+  if (!is_referencing()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(m_references_lock);
+  make_contiguous_locked();
+}
+
+void serdata_rmw::copy_serialized(size_t off, size_t sz, void * buf)
+{
+  if (!m_has_references) {
+    std::memcpy(buf, byte_offset(m_data.get(), off), sz);
+    return;
+  }
+  std::lock_guard<std::mutex> lock(m_references_lock);
+  if (!m_referencing.load(std::memory_order_relaxed)) {
+    std::memcpy(buf, byte_offset(m_data.get(), off), sz);
+    return;
+  }
+  for_each_piece(
+    off, sz, [&buf](const void * piece, size_t size) {
+      std::memcpy(buf, piece, size);
+      buf = byte_offset(buf, size);
+    });
+}
+
+size_t serdata_rmw::ref_serialized(size_t off, size_t sz, size_t niov, ddsrt_iovec_t * iov)
+{
+  assert(niov > 0);
+  if (!m_has_references) {
+    iov[0].iov_base = byte_offset(m_data.get(), off);
+    iov[0].iov_len = static_cast<ddsrt_iov_len_t>(sz);
+    return 1;
+  }
+  std::lock_guard<std::mutex> lock(m_references_lock);
+  if (m_referencing.load(std::memory_order_relaxed)) {
+    size_t n = 0;
+    for_each_piece(off, sz, [&n](const void *, size_t) {n++;});
+    if (n <= niov) {
+      bool refers_to_sample = false;
+      n = 0;
+      for_each_piece(
+        off, sz, [this, &n, iov, &refers_to_sample](const void * piece, size_t size) {
+          iov[n].iov_base = const_cast<void *>(piece);
+          iov[n].iov_len = static_cast<ddsrt_iov_len_t>(size);
+          refers_to_sample = refers_to_sample || !is_copied(piece);
+          n++;
+        });
+      if (refers_to_sample) {
+        m_sample_refs++;
+      }
+      return n;
+    }
+    make_contiguous_locked();
+  }
+  iov[0].iov_base = byte_offset(m_data.get(), off);
+  iov[0].iov_len = static_cast<ddsrt_iov_len_t>(sz);
+  return 1;
+}
+
+void serdata_rmw::unref_serialized(size_t niov, const ddsrt_iovec_t * iov)
+{
+  if (!m_has_references) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(m_references_lock);
+  for (size_t i = 0; i < niov; i++) {
+    if (!is_copied(iov[i].iov_base)) {
+      assert(m_sample_refs > 0);
+      if (--m_sample_refs == 0) {
+        m_sample_refs_released.notify_all();
+      }
+      return;
+    }
+  }
+}
+
+bool serdata_rmw::release_sample()
+{
+  if (!m_has_references) {
+    return true;
+  }
+  std::lock_guard<std::mutex> lock(m_references_lock);
+  /* the caller holds one reference, any other one may be used after it modified the sample */
+  if (ddsrt_atomic_ld32(&refc) > 1) {
+    make_contiguous_locked();
+  }
+  return m_sample_refs == 0;
+}
+
+void serdata_rmw::wait_for_sample_release()
+{
+  std::unique_lock<std::mutex> lock(m_references_lock);
+  m_sample_refs_released.wait(lock, [this]() {return m_sample_refs == 0;});
+}
@@ -14,9 +14,12 @@
 #ifndef SERDATA_HPP_
 #define SERDATA_HPP_
 
+#include <atomic>
+#include <condition_variable>
 #include <memory>
 #include <string>
 #include <mutex>
+#include <vector>
 
 #include "TypeSupport2.hpp"
 #include "bytewise.hpp"
@@ -25,6 +28,7 @@
 #ifdef DDS_HAS_SHM
 #include "dds/ddsi/q_xmsg.h"
 #endif  // DDS_HAS_SHM
+#include "rosidl_typesupport_cyclonedds_cpp/message_type_support.hpp"
 
 #if !DDS_HAS_DDSI_SERTYPE
 #define ddsi_sertype ddsi_sertopic
@@ -49,10 +53,23 @@ struct sertype_rmw : ddsi_sertype
   CddsTypeSupport type_support;
   bool is_request_header;
   std::unique_ptr<const rmw_cyclonedds_cpp::BaseCDRWriter> cdr_writer;
+  /* generated serialization functions of the message type, used instead of cdr_writer and
+     the introspection type support when the message package provides them */
+  const rosidl_typesupport_cyclonedds_cpp::message_type_support_callbacks_t * generated_callbacks;
   bool is_fixed;
   std::mutex serialize_lock;
 };
 
+/* Serialized data of a serdata_rmw which is not copied into it, but referenced in the sample
+   it was serialized from */
+struct serdata_rmw_reference
+{
+  /* offset in the copied data at which the referenced data belongs */
+  size_t copied_offset;
+  const void * data;
+  size_t size;
+};
+
 class serdata_rmw : public ddsi_serdata
 {
 protected:
@@ -61,11 +78,47 @@ protected:
      second two bytes are encoding options */
   std::unique_ptr<byte[]> m_data {nullptr};
 
+  /* While a sample is published, the contents of its large sequences can be referenced instead
+     of copied into m_data.  They are copied when the data is needed in one piece, or when the
+     serdata outlives the publication. */
+  bool m_has_references {false};
+  std::atomic<bool> m_referencing {false};
+  std::mutex m_references_lock;
+  std::condition_variable m_sample_refs_released;
+  std::vector<serdata_rmw_reference> m_references;
+  /* m_data while referencing, kept for references to it handed out before it was replaced */
+  std::unique_ptr<byte[]> m_copied_data {nullptr};
+  size_t m_copied_size {0};
+  /* number of to_ser_ref_iov references into the sample which are not released yet */
+  size_t m_sample_refs {0};
+
+  template<typename Fn>
+  void for_each_piece(size_t off, size_t sz, Fn && fn) const;
+  bool is_copied(const void * p) const;
+  void make_contiguous_locked();
+
 public:
   serdata_rmw(const ddsi_sertype * type, ddsi_serdata_kind kind);
   void resize(size_t requested_size);
   size_t size() const {return m_size;}
   void * data() const {return m_data.get();}
+
+  /* Allocates copied_size bytes for the data that is copied and prepares for adding the
+     references to the referenced_size bytes of data that are not */
+  void resize_referencing(size_t copied_size, size_t referenced_size);
+  std::vector<serdata_rmw_reference> & references() {return m_references;}
+  bool is_referencing() const {return m_referencing.load(std::memory_order_acquire);}
+
+  /* Copies the referenced data into m_data, so that data() holds all of it */
+  void make_contiguous();
+  void copy_serialized(size_t off, size_t sz, void * buf);
+  /* Fills up to niov iovecs with references to the data; returns the number used */
+  size_t ref_serialized(size_t off, size_t sz, size_t niov, ddsrt_iovec_t * iov);
+  void unref_serialized(size_t niov, const ddsrt_iovec_t * iov);
+  /* Copies the referenced data if others still use the serdata; returns whether nothing
+     refers to the sample anymore */
+  bool release_sample();
+  void wait_for_sample_release();
 };
 
 typedef struct cdds_request_header
@@ -95,10 +148,34 @@ struct sertype_rmw * create_sertype(
   void * type_support, bool is_request_header,
   std::unique_ptr<rmw_cyclonedds_cpp::StructValueType> message_type_support,
   const uint32_t sample_size = 0U,
-  const bool is_fixed_type = false);
+  const bool is_fixed_type = false,
+  const rosidl_typesupport_cyclonedds_cpp::message_type_support_callbacks_t *
+  generated_callbacks = nullptr);
 
 struct ddsi_serdata * serdata_rmw_from_serialized_message(
   const struct ddsi_sertype * typecmn,
   const void * raw, size_t size);
 
+/* Serializes a sample for dds_writecdr, referencing the contents of its large sequences
+   instead of copying them.  serdata_rmw_release_sample must be called before the sample
+   is modified.  Only worth it for writers that do not keep the samples they have sent. */
+struct ddsi_serdata * serdata_rmw_from_sample_referencing(
+  const struct ddsi_sertype * typecmn,
+  const void * sample);
+
+/* Ends the use of the sample a serdata from serdata_rmw_from_sample_referencing refers to,
+   copying what it references if it is still in use.  writer is flushed if it holds on to
+   messages referencing the sample. */
+void serdata_rmw_release_sample(struct ddsi_serdata * dcmn, dds_entity_t writer);
+
+#ifdef DDS_HAS_SHM
+/* Serializes a sample for dds_writecdr straight into an iceoryx chunk of writer, for types that
+   are exchanged serialized in shared memory.  Without a chunk to spare, the data is serialized
+   into the serdata instead, and dds_writecdr waits for a chunk or fails.  Fails if the data
+   would not fit in a chunk, as readers on this host only receive it through shared memory. */
+struct ddsi_serdata * serdata_rmw_from_sample_in_iox_chunk(
+  const struct ddsi_sertype * typecmn,
+  const void * sample, dds_entity_t writer);
+#endif  // DDS_HAS_SHM
+
 #endif  // SERDATA_HPP_
@@ -148,6 +148,16 @@ public:
   {
     deserialize(*reinterpret_cast<uint64_t *>(&x));
   }
+  inline bool swaps_bytes() const {return swap_bytes;}
+  // copy `size` bytes of values which are laid out in memory as in CDR, the first of which
+  // has alignment `a`
+  inline void deserialize_bytes(void * x, size_t size, size_t a)
+  {
+    align(a);
+    validate_size(size, 1);
+    memcpy(x, data + pos, size);
+    pos += size;
+  }
   inline uint32_t deserialize_len(size_t el_sz)
   {
     uint32_t sz;
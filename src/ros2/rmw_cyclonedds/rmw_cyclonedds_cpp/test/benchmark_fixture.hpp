@@ -0,0 +1,92 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef BENCHMARK_FIXTURE_HPP_
+#define BENCHMARK_FIXTURE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "rcutils/allocator.h"
+#include "rcutils/strdup.h"
+#include "rmw/rmw.h"
+#include "sensor_msgs/msg/image.hpp"
+
+namespace benchmark_fixture
+{
+
+// A context with one node, torn down when the benchmark is done.  node() is null if any step
+// failed, and only what was set up is torn down.
+class NodeFixture
+{
+public:
+  explicit NodeFixture(const char * node_name)
+  {
+    rcutils_allocator_t allocator = rcutils_get_default_allocator();
+    if (rmw_init_options_init(&init_options_, allocator) != RMW_RET_OK) {
+      return;
+    }
+    init_options_initialized_ = true;
+    init_options_.enclave = rcutils_strdup("/", allocator);
+    if (rmw_init(&init_options_, &context_) != RMW_RET_OK) {
+      return;
+    }
+    context_initialized_ = true;
+    node_ = rmw_create_node(&context_, node_name, "/");
+  }
+
+  ~NodeFixture()
+  {
+    if (node_ != nullptr) {
+      rmw_destroy_node(node_);
+    }
+    if (context_initialized_) {
+      rmw_shutdown(&context_);
+      rmw_context_fini(&context_);
+    }
+    if (init_options_initialized_) {
+      rmw_init_options_fini(&init_options_);
+    }
+  }
+
+  NodeFixture(const NodeFixture &) = delete;
+  NodeFixture & operator=(const NodeFixture &) = delete;
+
+  rmw_context_t * context() {return &context_;}
+  rmw_node_t * node() const {return node_;}
+
+private:
+  rmw_init_options_t init_options_ = rmw_get_zero_initialized_init_options();
+  rmw_context_t context_ = rmw_get_zero_initialized_context();
+  rmw_node_t * node_ = nullptr;
+  bool init_options_initialized_ = false;
+  bool context_initialized_ = false;
+};
+
+// A mono8 camera image of size bytes
+inline sensor_msgs::msg::Image make_image(size_t size)
+{
+  sensor_msgs::msg::Image image;
+  image.header.frame_id = "camera";
+  image.encoding = "mono8";
+  image.width = 1024;
+  image.height = static_cast<uint32_t>((size + image.width - 1) / image.width);
+  image.step = image.width;
+  image.data.assign(size, 0x42);
+  return image;
+}
+
+}  // namespace benchmark_fixture
+
+#endif  // BENCHMARK_FIXTURE_HPP_
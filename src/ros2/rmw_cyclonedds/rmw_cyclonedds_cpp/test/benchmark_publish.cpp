@@ -0,0 +1,104 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+
+#include "rmw/error_handling.h"
+#include "rmw/rmw.h"
+#include "rosidl_typesupport_cpp/message_type_support.hpp"
+#include "sensor_msgs/msg/image.hpp"
+
+#include "benchmark_fixture.hpp"
+
+namespace
+{
+
+using benchmark_fixture::NodeFixture;
+using benchmark_fixture::make_image;
+
+// Times rmw_publish of large images; with_subscription adds a matching subscription in the
+// same process, so the published sample is retained by its reader.
+void publish_image(
+  benchmark::State & state, rmw_qos_reliability_policy_t reliability, bool with_subscription)
+{
+  NodeFixture fixture("benchmark_publish");
+  if (fixture.node() == nullptr) {
+    state.SkipWithError(rmw_get_error_string().str);
+    rmw_reset_error();
+    return;
+  }
+
+  const auto type_support =
+    rosidl_typesupport_cpp::get_message_type_support_handle<sensor_msgs::msg::Image>();
+  rmw_qos_profile_t qos = rmw_qos_profile_default;
+  qos.reliability = reliability;
+  qos.depth = 1;
+  const std::string topic = "/benchmark_publish_" + std::to_string(state.range(0));
+  const rmw_publisher_options_t publisher_options = rmw_get_default_publisher_options();
+  rmw_publisher_t * publisher = rmw_create_publisher(
+    fixture.node(), type_support, topic.c_str(), &qos, &publisher_options);
+  rmw_subscription_t * subscription = nullptr;
+  if (with_subscription) {
+    const rmw_subscription_options_t subscription_options =
+      rmw_get_default_subscription_options();
+    subscription = rmw_create_subscription(
+      fixture.node(), type_support, topic.c_str(), &qos, &subscription_options);
+  }
+  if (publisher == nullptr || (with_subscription && subscription == nullptr)) {
+    state.SkipWithError(rmw_get_error_string().str);
+    rmw_reset_error();
+  } else {
+    const auto image = make_image(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+      if (rmw_publish(publisher, &image, nullptr) != RMW_RET_OK) {
+        state.SkipWithError(rmw_get_error_string().str);
+        rmw_reset_error();
+        break;
+      }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * image.data.size()));
+  }
+
+  if (subscription != nullptr) {
+    rmw_destroy_subscription(fixture.node(), subscription);
+  }
+  if (publisher != nullptr) {
+    rmw_destroy_publisher(fixture.node(), publisher);
+  }
+}
+
+void BM_publish_best_effort(benchmark::State & state)
+{
+  publish_image(state, RMW_QOS_POLICY_RELIABILITY_BEST_EFFORT, false);
+}
+
+void BM_publish_reliable(benchmark::State & state)
+{
+  publish_image(state, RMW_QOS_POLICY_RELIABILITY_RELIABLE, false);
+}
+
+void BM_publish_reliable_with_subscription(benchmark::State & state)
+{
+  publish_image(state, RMW_QOS_POLICY_RELIABILITY_RELIABLE, true);
+}
+
+}  // namespace
+
+// 1 MB to 16 MB
+BENCHMARK(BM_publish_best_effort)->RangeMultiplier(2)->Range(1 << 20, 16 << 20);
+BENCHMARK(BM_publish_reliable)->RangeMultiplier(2)->Range(1 << 20, 16 << 20);
+BENCHMARK(BM_publish_reliable_with_subscription)->RangeMultiplier(2)->Range(1 << 20, 16 << 20);
@@ -0,0 +1,179 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rmw/error_handling.h"
+#include "rosidl_typesupport_cpp/message_type_support.hpp"
+#include "rosidl_typesupport_introspection_cpp/identifier.hpp"
+#include "rosidl_typesupport_introspection_cpp/message_introspection.hpp"
+#include "sensor_msgs/msg/imu.hpp"
+#include "sensor_msgs/msg/joint_state.hpp"
+#include "sensor_msgs/msg/laser_scan.hpp"
+#include "sensor_msgs/msg/point_cloud2.hpp"
+
+#include "MessageTypeSupport.hpp"
+#include "Serialization.hpp"
+#include "TypeSupport2.hpp"
+#include "serdes.hpp"
+
+namespace
+{
+
+template<typename MessageT>
+const rosidl_message_type_support_t * get_introspection_type_support()
+{
+  return get_message_typesupport_handle(
+    rosidl_typesupport_cpp::get_message_type_support_handle<MessageT>(),
+    rosidl_typesupport_introspection_cpp::typesupport_identifier);
+}
+
+std_msgs::msg::Header make_header(const std::string & frame_id)
+{
+  std_msgs::msg::Header header;
+  header.stamp.sec = 1600000000;
+  header.stamp.nanosec = 123456789;
+  header.frame_id = frame_id;
+  return header;
+}
+
+template<typename MessageT>
+MessageT make_message();
+
+template<>
+sensor_msgs::msg::Imu make_message()
+{
+  sensor_msgs::msg::Imu imu;
+  imu.header = make_header("imu_link");
+  imu.orientation.w = 1.0;
+  imu.angular_velocity.z = 0.1;
+  imu.linear_acceleration.z = 9.81;
+  for (size_t i = 0; i < 9; i += 4) {
+    imu.orientation_covariance[i] = 0.01;
+    imu.angular_velocity_covariance[i] = 0.02;
+    imu.linear_acceleration_covariance[i] = 0.03;
+  }
+  return imu;
+}
+
+// An arm with 12 joints
+template<>
+sensor_msgs::msg::JointState make_message()
+{
+  sensor_msgs::msg::JointState joint_state;
+  joint_state.header = make_header("base_link");
+  for (int i = 0; i < 12; ++i) {
+    joint_state.name.push_back("joint_" + std::to_string(i));
+    joint_state.position.push_back(0.1 * i);
+    joint_state.velocity.push_back(0.01 * i);
+    joint_state.effort.push_back(-0.5 * i);
+  }
+  return joint_state;
+}
+
+template<>
+sensor_msgs::msg::LaserScan make_message()
+{
+  sensor_msgs::msg::LaserScan scan;
+  scan.header = make_header("laser");
+  scan.angle_min = -3.14f;
+  scan.angle_max = 3.14f;
+  scan.angle_increment = 6.28f / 1440;
+  scan.range_max = 30.0f;
+  scan.ranges.assign(1440, 5.0f);
+  scan.intensities.assign(1440, 100.0f);
+  return scan;
+}
+
+// A lidar frame of 16 beams with 2048 points of x, y, z and intensity
+template<>
+sensor_msgs::msg::PointCloud2 make_message()
+{
+  sensor_msgs::msg::PointCloud2 cloud;
+  cloud.header = make_header("lidar");
+  cloud.height = 16;
+  cloud.width = 2048;
+  for (const char * name : {"x", "y", "z", "intensity"}) {
+    sensor_msgs::msg::PointField field;
+    field.name = name;
+    field.offset = static_cast<uint32_t>(4 * cloud.fields.size());
+    field.datatype = sensor_msgs::msg::PointField::FLOAT32;
+    field.count = 1;
+    cloud.fields.push_back(field);
+  }
+  cloud.point_step = 16;
+  cloud.row_step = cloud.point_step * cloud.width;
+  cloud.data.assign(cloud.row_step * cloud.height, 0x42);
+  cloud.is_dense = true;
+  return cloud;
+}
+
+// Serializes like serialize_into_serdata_rmw: size first, then the data
+template<typename MessageT>
+void BM_serialize(benchmark::State & state)
+{
+  auto writer = rmw_cyclonedds_cpp::make_cdr_writer(
+    rmw_cyclonedds_cpp::make_message_value_type(get_introspection_type_support<MessageT>()));
+  const auto message = make_message<MessageT>();
+  std::vector<unsigned char> buffer(writer->get_serialized_size(&message));
+
+  for (auto _ : state) {
+    const size_t size = writer->get_serialized_size(&message);
+    writer->serialize(buffer.data(), &message);
+    benchmark::DoNotOptimize(size);
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * buffer.size()));
+}
+
+// Deserializes like serdata_rmw_to_sample, reusing the message
+template<typename MessageT>
+void BM_deserialize(benchmark::State & state)
+{
+  auto writer = rmw_cyclonedds_cpp::make_cdr_writer(
+    rmw_cyclonedds_cpp::make_message_value_type(get_introspection_type_support<MessageT>()));
+  rmw_cyclonedds_cpp::MessageTypeSupport<rosidl_typesupport_introspection_cpp::MessageMembers>
+  type_support(
+    static_cast<const rosidl_typesupport_introspection_cpp::MessageMembers *>(
+      get_introspection_type_support<MessageT>()->data));
+  const auto message = make_message<MessageT>();
+  std::vector<unsigned char> buffer(writer->get_serialized_size(&message));
+  writer->serialize(buffer.data(), &message);
+
+  MessageT result;
+  for (auto _ : state) {
+    cycdeser deser(buffer.data(), buffer.size());
+    type_support.deserializeROSmessage(deser, &result, nullptr);
+    benchmark::ClobberMemory();
+  }
+  if (result != message) {
+    state.SkipWithError("deserialized message differs from the serialized one");
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * buffer.size()));
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_serialize, sensor_msgs::msg::Imu);
+BENCHMARK_TEMPLATE(BM_deserialize, sensor_msgs::msg::Imu);
+BENCHMARK_TEMPLATE(BM_serialize, sensor_msgs::msg::JointState);
+BENCHMARK_TEMPLATE(BM_deserialize, sensor_msgs::msg::JointState);
+BENCHMARK_TEMPLATE(BM_serialize, sensor_msgs::msg::LaserScan);
+BENCHMARK_TEMPLATE(BM_deserialize, sensor_msgs::msg::LaserScan);
+BENCHMARK_TEMPLATE(BM_serialize, sensor_msgs::msg::PointCloud2);
+BENCHMARK_TEMPLATE(BM_deserialize, sensor_msgs::msg::PointCloud2);
@@ -0,0 +1,209 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Round trip latency of images between two processes on the same host.
+//
+// Without further configuration the images go over the loopback interface.  To exchange them
+// through shared memory, run RouDi, enable shared memory in the configuration CYCLONEDDS_URI
+// points to and set RMW_CYCLONEDDS_SHM_MAX_SERIALIZED_SIZE to at least the largest image plus
+// its header, with iceoryx mempools of chunks that large.
+
+#include <benchmark/benchmark.h>
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "rmw/error_handling.h"
+#include "rmw/rmw.h"
+#include "rosidl_typesupport_cpp/message_type_support.hpp"
+#include "sensor_msgs/msg/image.hpp"
+
+#include "benchmark_fixture.hpp"
+
+namespace
+{
+
+using benchmark_fixture::NodeFixture;
+using benchmark_fixture::make_image;
+
+// A publisher on one topic and a subscription on another, with a wait set for the latter
+class Endpoints
+{
+public:
+  Endpoints(NodeFixture & fixture, const std::string & out, const std::string & in)
+  : node_(fixture.node())
+  {
+    const auto type_support =
+      rosidl_typesupport_cpp::get_message_type_support_handle<sensor_msgs::msg::Image>();
+    rmw_qos_profile_t qos = rmw_qos_profile_default;
+    qos.depth = 1;
+    const rmw_publisher_options_t publisher_options = rmw_get_default_publisher_options();
+    const rmw_subscription_options_t subscription_options =
+      rmw_get_default_subscription_options();
+    publisher_ = rmw_create_publisher(node_, type_support, out.c_str(), &qos, &publisher_options);
+    subscription_ = rmw_create_subscription(
+      node_, type_support, in.c_str(), &qos, &subscription_options);
+    wait_set_ = rmw_create_wait_set(fixture.context(), 1);
+  }
+
+  ~Endpoints()
+  {
+    if (wait_set_ != nullptr) {
+      rmw_destroy_wait_set(wait_set_);
+    }
+    if (subscription_ != nullptr) {
+      rmw_destroy_subscription(node_, subscription_);
+    }
+    if (publisher_ != nullptr) {
+      rmw_destroy_publisher(node_, publisher_);
+    }
+  }
+
+  bool ok() const
+  {
+    return publisher_ != nullptr && subscription_ != nullptr && wait_set_ != nullptr;
+  }
+
+  rmw_ret_t publish(const sensor_msgs::msg::Image & image)
+  {
+    return rmw_publish(publisher_, &image, nullptr);
+  }
+
+  // Takes the next image, waiting at most timeout for it to arrive
+  rmw_ret_t take(sensor_msgs::msg::Image & image, std::chrono::nanoseconds timeout)
+  {
+    for (;;) {
+      bool taken = false;
+      rmw_ret_t ret = rmw_take(subscription_, &image, &taken, nullptr);
+      if (ret != RMW_RET_OK || taken) {
+        return ret;
+      }
+      void * subscriptions[1] = {subscription_->data};
+      rmw_subscriptions_t ready = {1, subscriptions};
+      const rmw_time_t wait_timeout = {
+        static_cast<uint64_t>(timeout.count() / 1000000000),
+        static_cast<uint64_t>(timeout.count() % 1000000000)};
+      ret = rmw_wait(&ready, nullptr, nullptr, nullptr, nullptr, wait_set_, &wait_timeout);
+      if (ret != RMW_RET_OK) {
+        return ret;
+      }
+    }
+  }
+
+private:
+  rmw_node_t * node_;
+  rmw_publisher_t * publisher_ = nullptr;
+  rmw_subscription_t * subscription_ = nullptr;
+  rmw_wait_set_t * wait_set_ = nullptr;
+};
+
+const char ping_topic[] = "/benchmark_shm_latency_ping";
+const char pong_topic[] = "/benchmark_shm_latency_pong";
+
+// Sends every image back until an empty one arrives
+void echo()
+{
+  NodeFixture fixture("benchmark_shm_latency_echo");
+  if (fixture.node() == nullptr) {
+    return;
+  }
+  Endpoints endpoints(fixture, pong_topic, ping_topic);
+  if (!endpoints.ok()) {
+    return;
+  }
+  sensor_msgs::msg::Image image;
+  while (endpoints.take(image, std::chrono::seconds(30)) == RMW_RET_OK &&
+    !image.data.empty())
+  {
+    if (endpoints.publish(image) != RMW_RET_OK) {
+      break;
+    }
+  }
+}
+
+// Times sending an image to an echo process and receiving it back, the sequence number of each
+// round trip is in the header stamp.
+void BM_round_trip(benchmark::State & state)
+{
+  const pid_t pid = fork();
+  if (pid < 0) {
+    state.SkipWithError("failed to start the echo process");
+    return;
+  }
+  if (pid == 0) {
+    echo();
+    _exit(0);
+  }
+
+  {
+    NodeFixture fixture("benchmark_shm_latency");
+    Endpoints endpoints(fixture, ping_topic, pong_topic);
+    auto image = make_image(static_cast<size_t>(state.range(0)));
+    sensor_msgs::msg::Image reply;
+    bool ok = fixture.node() != nullptr && endpoints.ok();
+
+    // repeat the first ping until the echo process has discovered both topics
+    int32_t seq = 0;
+    do {
+      image.header.stamp.sec = ++seq;
+      ok = ok && seq <= 100 && endpoints.publish(image) == RMW_RET_OK;
+      if (ok) {
+        const rmw_ret_t ret = endpoints.take(reply, std::chrono::milliseconds(100));
+        ok = ret == RMW_RET_OK || ret == RMW_RET_TIMEOUT;
+      }
+    } while (ok && reply.header.stamp.sec != seq);
+    if (!ok) {
+      state.SkipWithError(
+        rmw_error_is_set() ? rmw_get_error_string().str : "no reply from the echo process");
+      rmw_reset_error();
+    }
+
+    for (auto _ : state) {
+      if (!ok) {
+        break;
+      }
+      image.header.stamp.sec = ++seq;
+      const auto start = std::chrono::steady_clock::now();
+      ok = endpoints.publish(image) == RMW_RET_OK;
+      while (ok && reply.header.stamp.sec != seq) {
+        ok = endpoints.take(reply, std::chrono::seconds(5)) == RMW_RET_OK;
+      }
+      const auto end = std::chrono::steady_clock::now();
+      if (!ok) {
+        state.SkipWithError(rmw_get_error_string().str);
+        rmw_reset_error();
+        break;
+      }
+      state.SetIterationTime(std::chrono::duration<double>(end - start).count());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(2 * state.iterations() * image.data.size()));
+
+    // stop the echo process
+    if (endpoints.ok()) {
+      image.data.clear();
+      endpoints.publish(image);
+    }
+  }
+  waitpid(pid, nullptr, 0);
+}
+
+}  // namespace
+
+// 1 kB to 8 MB
+BENCHMARK(BM_round_trip)->RangeMultiplier(8)->Range(1 << 10, 8 << 20)->UseManualTime();
@@ -0,0 +1,233 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <vector>
+
+#include "rmw/error_handling.h"
+#include "rosidl_typesupport_cpp/message_type_support.hpp"
+#include "rosidl_typesupport_cyclonedds_cpp/identifier.hpp"
+#include "rosidl_typesupport_cyclonedds_cpp/message_type_support.hpp"
+#include "rosidl_typesupport_introspection_cpp/identifier.hpp"
+#include "rosidl_typesupport_introspection_cpp/message_introspection.hpp"
+#include "test_msgs/message_fixtures.hpp"
+
+#include "MessageTypeSupport.hpp"
+#include "Serialization.hpp"
+#include "TypeSupport2.hpp"
+#include "serdes.hpp"
+
+namespace
+{
+
+using rosidl_typesupport_cyclonedds_cpp::message_type_support_callbacks_t;
+
+template<typename MessageT>
+const rosidl_message_type_support_t * get_introspection_type_support()
+{
+  return get_message_typesupport_handle(
+    rosidl_typesupport_cpp::get_message_type_support_handle<MessageT>(),
+    rosidl_typesupport_introspection_cpp::typesupport_identifier);
+}
+
+template<typename MessageT>
+const message_type_support_callbacks_t * get_generated_callbacks()
+{
+  const rosidl_message_type_support_t * ts = get_message_typesupport_handle(
+    rosidl_typesupport_cpp::get_message_type_support_handle<MessageT>(),
+    rosidl_typesupport_cyclonedds_cpp::typesupport_identifier);
+  if (ts == nullptr) {
+    rmw_reset_error();
+    return nullptr;
+  }
+  return static_cast<const message_type_support_callbacks_t *>(ts->data);
+}
+
+template<typename MessageT>
+std::vector<std::shared_ptr<MessageT>> get_messages();
+
+#define TEST_MSGS_FIXTURES(MessageT, fixtures) \
+  template<> \
+  std::vector<std::shared_ptr<test_msgs::msg::MessageT>> get_messages() \
+  { \
+    return fixtures(); \
+  }
+
+TEST_MSGS_FIXTURES(BasicTypes, get_messages_basic_types)
+TEST_MSGS_FIXTURES(Strings, get_messages_strings)
+TEST_MSGS_FIXTURES(WStrings, get_messages_wstrings)
+TEST_MSGS_FIXTURES(Arrays, get_messages_arrays)
+TEST_MSGS_FIXTURES(UnboundedSequences, get_messages_unbounded_sequences)
+TEST_MSGS_FIXTURES(BoundedSequences, get_messages_bounded_sequences)
+TEST_MSGS_FIXTURES(Nested, get_messages_nested)
+TEST_MSGS_FIXTURES(MultiNested, get_messages_multi_nested)
+TEST_MSGS_FIXTURES(Builtins, get_messages_builtins)
+
+#undef TEST_MSGS_FIXTURES
+
+// The fixtures serialized with the introspection type support, as rmw_cyclonedds_cpp does
+// without generated code
+template<typename MessageT>
+std::vector<std::vector<unsigned char>> serialize_with_introspection(
+  const std::vector<std::shared_ptr<MessageT>> & messages)
+{
+  auto writer = rmw_cyclonedds_cpp::make_cdr_writer(
+    rmw_cyclonedds_cpp::make_message_value_type(get_introspection_type_support<MessageT>()));
+  std::vector<std::vector<unsigned char>> buffers;
+  for (const auto & message : messages) {
+    buffers.emplace_back(writer->get_serialized_size(message.get()));
+    writer->serialize(buffers.back().data(), message.get());
+  }
+  return buffers;
+}
+
+// Serializes all fixtures of a type like serialize_into_serdata_rmw: size first, then the data
+template<typename MessageT>
+void BM_serialize_introspection(benchmark::State & state)
+{
+  auto writer = rmw_cyclonedds_cpp::make_cdr_writer(
+    rmw_cyclonedds_cpp::make_message_value_type(get_introspection_type_support<MessageT>()));
+  const auto messages = get_messages<MessageT>();
+  const auto expected = serialize_with_introspection(messages);
+  std::vector<std::vector<unsigned char>> buffers(expected);
+  size_t bytes = 0;
+  for (const auto & buffer : expected) {
+    bytes += buffer.size();
+  }
+
+  for (auto _ : state) {
+    for (size_t i = 0; i < messages.size(); i++) {
+      const size_t size = writer->get_serialized_size(messages[i].get());
+      writer->serialize(buffers[i].data(), messages[i].get());
+      benchmark::DoNotOptimize(size);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+}
+
+template<typename MessageT>
+void BM_serialize_generated(benchmark::State & state)
+{
+  const message_type_support_callbacks_t * callbacks = get_generated_callbacks<MessageT>();
+  if (callbacks == nullptr) {
+    state.SkipWithError("test_msgs was built without rosidl_typesupport_cyclonedds_cpp");
+    return;
+  }
+  const auto messages = get_messages<MessageT>();
+  const auto expected = serialize_with_introspection(messages);
+  std::vector<std::vector<unsigned char>> buffers;
+  size_t bytes = 0;
+  for (size_t i = 0; i < messages.size(); i++) {
+    buffers.emplace_back(callbacks->get_serialized_size(messages[i].get()));
+    callbacks->serialize(messages[i].get(), buffers[i].data(), buffers[i].size());
+    if (buffers[i] != expected[i]) {
+      state.SkipWithError("generated code serializes differently from introspection");
+      return;
+    }
+    bytes += buffers[i].size();
+  }
+
+  for (auto _ : state) {
+    for (size_t i = 0; i < messages.size(); i++) {
+      const size_t size = callbacks->get_serialized_size(messages[i].get());
+      callbacks->serialize(messages[i].get(), buffers[i].data(), size);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+}
+
+// Deserializes all fixtures of a type like serdata_rmw_to_sample, reusing the messages
+template<typename MessageT>
+void BM_deserialize_introspection(benchmark::State & state)
+{
+  rmw_cyclonedds_cpp::MessageTypeSupport<rosidl_typesupport_introspection_cpp::MessageMembers>
+  type_support(
+    static_cast<const rosidl_typesupport_introspection_cpp::MessageMembers *>(
+      get_introspection_type_support<MessageT>()->data));
+  const auto messages = get_messages<MessageT>();
+  const auto buffers = serialize_with_introspection(messages);
+  size_t bytes = 0;
+  for (const auto & buffer : buffers) {
+    bytes += buffer.size();
+  }
+
+  std::vector<MessageT> results(messages.size());
+  for (auto _ : state) {
+    for (size_t i = 0; i < buffers.size(); i++) {
+      cycdeser deser(buffers[i].data(), buffers[i].size());
+      type_support.deserializeROSmessage(deser, &results[i], nullptr);
+    }
+    benchmark::ClobberMemory();
+  }
+  for (size_t i = 0; i < messages.size(); i++) {
+    if (results[i] != *messages[i]) {
+      state.SkipWithError("deserialized message differs from the serialized one");
+      break;
+    }
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+}
+
+template<typename MessageT>
+void BM_deserialize_generated(benchmark::State & state)
+{
+  const message_type_support_callbacks_t * callbacks = get_generated_callbacks<MessageT>();
+  if (callbacks == nullptr) {
+    state.SkipWithError("test_msgs was built without rosidl_typesupport_cyclonedds_cpp");
+    return;
+  }
+  const auto messages = get_messages<MessageT>();
+  const auto buffers = serialize_with_introspection(messages);
+  size_t bytes = 0;
+  for (const auto & buffer : buffers) {
+    bytes += buffer.size();
+  }
+
+  std::vector<MessageT> results(messages.size());
+  for (auto _ : state) {
+    for (size_t i = 0; i < buffers.size(); i++) {
+      callbacks->deserialize(buffers[i].data(), buffers[i].size(), &results[i]);
+    }
+    benchmark::ClobberMemory();
+  }
+  for (size_t i = 0; i < messages.size(); i++) {
+    if (results[i] != *messages[i]) {
+      state.SkipWithError("deserialized message differs from the serialized one");
+      break;
+    }
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+}
+
+}  // namespace
+
+#define BENCHMARK_TYPESUPPORTS(MessageT) \
+  BENCHMARK_TEMPLATE(BM_serialize_introspection, test_msgs::msg::MessageT); \
+  BENCHMARK_TEMPLATE(BM_serialize_generated, test_msgs::msg::MessageT); \
+  BENCHMARK_TEMPLATE(BM_deserialize_introspection, test_msgs::msg::MessageT); \
+  BENCHMARK_TEMPLATE(BM_deserialize_generated, test_msgs::msg::MessageT)
+
+BENCHMARK_TYPESUPPORTS(BasicTypes);
+BENCHMARK_TYPESUPPORTS(Strings);
+BENCHMARK_TYPESUPPORTS(WStrings);
+BENCHMARK_TYPESUPPORTS(Arrays);
+BENCHMARK_TYPESUPPORTS(UnboundedSequences);
+BENCHMARK_TYPESUPPORTS(BoundedSequences);
+BENCHMARK_TYPESUPPORTS(Nested);
+BENCHMARK_TYPESUPPORTS(MultiNested);
+BENCHMARK_TYPESUPPORTS(Builtins);
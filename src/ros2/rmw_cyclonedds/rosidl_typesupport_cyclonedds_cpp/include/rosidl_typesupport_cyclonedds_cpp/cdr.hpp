@@ -0,0 +1,295 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROSIDL_TYPESUPPORT_CYCLONEDDS_CPP__CDR_HPP_
+#define ROSIDL_TYPESUPPORT_CYCLONEDDS_CPP__CDR_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+/// Inline CDR primitives the generated serialization functions are made of.
+/**
+ * The data layout is the one rmw_cyclonedds_cpp produces from the introspection type support:
+ * classic CDR in the native byte order, aligned relative to the end of the 4 byte encapsulation
+ * header, with primitives aligned to their size up to 8 bytes, no alignment before empty
+ * sequences, and wide characters of strings stored as wchar_t.
+ */
+namespace rosidl_typesupport_cyclonedds_cpp
+{
+
+/// Size of the encapsulation header in front of the CDR data
+constexpr size_t encapsulation_header_size = 4;
+
+template<typename T>
+constexpr size_t cdr_alignof()
+{
+  return sizeof(T) < 8 ? sizeof(T) : 8;
+}
+
+inline size_t cdr_align(size_t offset, size_t alignment)
+{
+  return (offset + alignment - 1) & ~(alignment - 1);
+}
+
+inline bool native_little_endian()
+{
+  const uint16_t one = 1;
+  uint8_t first_byte;
+  std::memcpy(&first_byte, &one, 1);
+  return first_byte == 1;
+}
+
+/// Computes the size of the data a CdrWriter writes
+class CdrSizeCalculator
+{
+public:
+  explicit CdrSizeCalculator(size_t offset = 0)
+  : m_offset(offset) {}
+
+  size_t offset() const {return m_offset;}
+
+  template<typename T>
+  void add()
+  {
+    m_offset = cdr_align(m_offset, cdr_alignof<T>()) + sizeof(T);
+  }
+
+  template<typename T>
+  void add_array(size_t count)
+  {
+    if (count != 0) {
+      m_offset = cdr_align(m_offset, cdr_alignof<T>()) + count * sizeof(T);
+    }
+  }
+
+  void add_length() {add<uint32_t>();}
+
+  void add_string(const std::string & value)
+  {
+    add_length();
+    m_offset += value.size() + 1;
+  }
+
+  void add_wstring(const std::u16string & value)
+  {
+    add_length();
+    m_offset += value.size() * sizeof(wchar_t);
+  }
+
+private:
+  size_t m_offset;
+};
+
+/// Writes CDR data into a buffer, starting with the encapsulation header
+class CdrWriter
+{
+public:
+  CdrWriter(void * buffer, size_t size)
+  : m_data(static_cast<unsigned char *>(buffer) + encapsulation_header_size),
+    m_size(size - encapsulation_header_size), m_offset(0)
+  {
+    if (size < encapsulation_header_size) {
+      throw std::runtime_error("serialization buffer too small");
+    }
+    // classic CDR, in the native byte order, without options
+    const unsigned char header[encapsulation_header_size] =
+    {0, static_cast<unsigned char>(native_little_endian() ? 1 : 0), 0, 0};
+    std::memcpy(buffer, header, sizeof(header));
+  }
+
+  template<typename T>
+  void put(const T & value)
+  {
+    align(cdr_alignof<T>());
+    copy(&value, sizeof(T));
+  }
+
+  template<typename T>
+  void put_array(const T * values, size_t count)
+  {
+    if (count != 0) {
+      align(cdr_alignof<T>());
+      copy(values, count * sizeof(T));
+    }
+  }
+
+  void put_length(size_t length)
+  {
+    if (length > std::numeric_limits<uint32_t>::max()) {
+      throw std::runtime_error("sequence too long to serialize");
+    }
+    put(static_cast<uint32_t>(length));
+  }
+
+  void put_string(const std::string & value)
+  {
+    put_length(value.size() + 1);
+    copy(value.c_str(), value.size() + 1);
+  }
+
+  void put_wstring(const std::u16string & value)
+  {
+    put_length(value.size());
+    for (char16_t c : value) {
+      const wchar_t wc = static_cast<wchar_t>(c);
+      copy(&wc, sizeof(wc));
+    }
+  }
+
+private:
+  void align(size_t alignment)
+  {
+    const size_t aligned = cdr_align(m_offset, alignment);
+    if (aligned > m_size) {
+      throw std::runtime_error("serialized data exceeds the buffer");
+    }
+    std::memset(m_data + m_offset, 0, aligned - m_offset);
+    m_offset = aligned;
+  }
+
+  void copy(const void * data, size_t size)
+  {
+    if (size > m_size - m_offset) {
+      throw std::runtime_error("serialized data exceeds the buffer");
+    }
+    std::memcpy(m_data + m_offset, data, size);
+    m_offset += size;
+  }
+
+  unsigned char * m_data;
+  size_t m_size;
+  size_t m_offset;
+};
+
+/// Reads CDR data in the native byte order, checking it stays within the buffer
+class CdrReader
+{
+public:
+  CdrReader(const void * buffer, size_t size)
+  : m_data(static_cast<const unsigned char *>(buffer) + encapsulation_header_size),
+    m_size(size - encapsulation_header_size), m_offset(0)
+  {
+    if (size < encapsulation_header_size) {
+      throw std::runtime_error("invalid data size");
+    }
+  }
+
+  /// Returns whether the data is classic CDR in the native byte order
+  static bool is_native_encoding(const void * buffer, size_t size)
+  {
+    if (size < encapsulation_header_size) {
+      return false;
+    }
+    auto header = static_cast<const unsigned char *>(buffer);
+    return header[0] == 0 && header[1] == (native_little_endian() ? 1 : 0);
+  }
+
+  template<typename T>
+  void get(T & value)
+  {
+    align(cdr_alignof<T>());
+    copy(&value, sizeof(T));
+  }
+
+  void get(bool & value)
+  {
+    uint8_t byte;
+    get(byte);
+    value = (byte != 0);
+  }
+
+  template<typename T>
+  void get_array(T * values, size_t count)
+  {
+    if (count != 0) {
+      align(cdr_alignof<T>());
+      copy(values, count * sizeof(T));
+    }
+  }
+
+  void get_array(bool * values, size_t count)
+  {
+    for (size_t i = 0; i < count; i++) {
+      get(values[i]);
+    }
+  }
+
+  /// Reads the length of a sequence of elements of element_size bytes
+  size_t get_length(size_t element_size)
+  {
+    uint32_t length;
+    get(length);
+    if (length > (m_size - m_offset) / element_size) {
+      throw std::runtime_error("invalid data size");
+    }
+    return length;
+  }
+
+  void get_string(std::string & value)
+  {
+    const size_t length = get_length(1);
+    if (length == 0) {
+      value.clear();
+      return;
+    }
+    const char * data = reinterpret_cast<const char *>(m_data + m_offset);
+    if (data[length - 1] != '\0') {
+      throw std::runtime_error("string data is not null-terminated");
+    }
+    value.assign(data, length - 1);
+    m_offset += length;
+  }
+
+  void get_wstring(std::u16string & value)
+  {
+    const size_t length = get_length(sizeof(wchar_t));
+    value.resize(length);
+    for (size_t i = 0; i < length; i++) {
+      wchar_t wc;
+      copy(&wc, sizeof(wc));
+      value[i] = static_cast<char16_t>(wc);
+    }
+  }
+
+private:
+  void align(size_t alignment)
+  {
+    const size_t aligned = cdr_align(m_offset, alignment);
+    if (aligned > m_size) {
+      throw std::runtime_error("invalid data size");
+    }
+    m_offset = aligned;
+  }
+
+  void copy(void * data, size_t size)
+  {
+    if (size > m_size - m_offset) {
+      throw std::runtime_error("invalid data size");
+    }
+    std::memcpy(data, m_data + m_offset, size);
+    m_offset += size;
+  }
+
+  const unsigned char * m_data;
+  size_t m_size;
+  size_t m_offset;
+};
+
+}  // namespace rosidl_typesupport_cyclonedds_cpp
+
+#endif  // ROSIDL_TYPESUPPORT_CYCLONEDDS_CPP__CDR_HPP_
@@ -0,0 +1,67 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROSIDL_TYPESUPPORT_CYCLONEDDS_CPP__MESSAGE_TYPE_SUPPORT_HPP_
+#define ROSIDL_TYPESUPPORT_CYCLONEDDS_CPP__MESSAGE_TYPE_SUPPORT_HPP_
+
+#include <cstddef>
+
+#include "rosidl_runtime_c/message_type_support_struct.h"
+
+namespace rosidl_typesupport_cyclonedds_cpp
+{
+
+/// Encapsulates the callbacks for serializing this rosidl type.
+/**
+ * These callbacks are implemented in the generated sources.  The serialized data starts with
+ * the 4 byte encapsulation header, followed by the message in classic CDR.
+ */
+struct message_type_support_callbacks_t
+{
+  /// The C++ namespace of this message.
+  const char * message_namespace_;
+
+  /// The typename of this message.
+  const char * message_name_;
+
+  /// Callback function to get the size of the serialized message
+  /**
+   * \param[in] untyped_ros_message Type erased pointer to message instance.
+   * \return The size of the serialized message in bytes, including the encapsulation header.
+   */
+  size_t (* get_serialized_size)(const void * untyped_ros_message);
+
+  /// Callback function for message serialization
+  /**
+   * \param[in] untyped_ros_message Type erased pointer to message instance.
+   * \param[out] buffer Buffer of at least the size returned by get_serialized_size.
+   * \param[in] size Size of the buffer.
+   * \throws std::runtime_error if the message can not be serialized.
+   */
+  void (* serialize)(const void * untyped_ros_message, void * buffer, size_t size);
+
+  /// Callback function for message deserialization
+  /**
+   * \param[in] buffer Serialized message, starting with the encapsulation header.
+   * \param[in] size Size of the serialized message.
+   * \param[out] untyped_ros_message Type erased pointer to message instance.
+   * \return false if the data is not in the native byte order, true otherwise.
+   * \throws std::runtime_error if the data is malformed.
+   */
+  bool (* deserialize)(const void * buffer, size_t size, void * untyped_ros_message);
+};
+
+}  // namespace rosidl_typesupport_cyclonedds_cpp
+
+#endif  // ROSIDL_TYPESUPPORT_CYCLONEDDS_CPP__MESSAGE_TYPE_SUPPORT_HPP_
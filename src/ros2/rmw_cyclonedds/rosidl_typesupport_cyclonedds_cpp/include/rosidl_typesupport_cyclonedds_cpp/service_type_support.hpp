@@ -0,0 +1,42 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROSIDL_TYPESUPPORT_CYCLONEDDS_CPP__SERVICE_TYPE_SUPPORT_HPP_
+#define ROSIDL_TYPESUPPORT_CYCLONEDDS_CPP__SERVICE_TYPE_SUPPORT_HPP_
+
+#include "rosidl_runtime_c/message_type_support_struct.h"
+#include "rosidl_runtime_c/service_type_support_struct.h"
+
+#include "rosidl_typesupport_cyclonedds_cpp/message_type_support.hpp"
+
+namespace rosidl_typesupport_cyclonedds_cpp
+{
+
+/// Encapsulates the type supports of the request and response of this rosidl type.
+struct service_type_support_callbacks_t
+{
+  /// The C++ namespace of this service.
+  const char * service_namespace_;
+  /// The typename of this service.
+  const char * service_name_;
+
+  /// Type support of the request message, its data is a message_type_support_callbacks_t.
+  const rosidl_message_type_support_t * request_members_;
+  /// Type support of the response message, its data is a message_type_support_callbacks_t.
+  const rosidl_message_type_support_t * response_members_;
+};
+
+}  // namespace rosidl_typesupport_cyclonedds_cpp
+
+#endif  // ROSIDL_TYPESUPPORT_CYCLONEDDS_CPP__SERVICE_TYPE_SUPPORT_HPP_
@@ -0,0 +1,70 @@
+@# Included from rosidl_typesupport_cyclonedds_cpp/resource/idl__rosidl_typesupport_cyclonedds_cpp.hpp.em
+@{
+from rosidl_cmake import convert_camel_case_to_lower_case_underscore
+
+include_parts = [package_name] + list(interface_path.parents[0].parts) + [
+    'detail', convert_camel_case_to_lower_case_underscore(interface_path.stem)]
+include_base = '/'.join(include_parts)
+
+header_files = [
+    'rosidl_runtime_c/message_type_support_struct.h',
+    'rosidl_typesupport_interface/macros.h',
+    'rosidl_typesupport_cyclonedds_cpp/cdr.hpp',
+    package_name + '/msg/rosidl_typesupport_cyclonedds_cpp__visibility_control.h',
+    include_base + '__struct.hpp',
+]
+}@
+@[for header_file in header_files]@
+@[    if header_file in include_directives]@
+// already included above
+// @
+@[    else]@
+@{include_directives.add(header_file)}@
+@[    end if]@
+#include "@(header_file)"
+@[end for]@
+@[for ns in message.structure.namespaced_type.namespaces]@
+
+namespace @(ns)
+{
+@[end for]@
+
+namespace typesupport_cyclonedds_cpp
+{
+
+void
+ROSIDL_TYPESUPPORT_CYCLONEDDS_CPP_PUBLIC_@(package_name)
+get_serialized_size(
+  const @('::'.join([package_name] + list(interface_path.parents[0].parts) + [message.structure.namespaced_type.name])) & ros_message,
+  rosidl_typesupport_cyclonedds_cpp::CdrSizeCalculator & cdr);
+
+void
+ROSIDL_TYPESUPPORT_CYCLONEDDS_CPP_PUBLIC_@(package_name)
+cdr_serialize(
+  const @('::'.join([package_name] + list(interface_path.parents[0].parts) + [message.structure.namespaced_type.name])) & ros_message,
+  rosidl_typesupport_cyclonedds_cpp::CdrWriter & cdr);
+
+void
+ROSIDL_TYPESUPPORT_CYCLONEDDS_CPP_PUBLIC_@(package_name)
+cdr_deserialize(
+  rosidl_typesupport_cyclonedds_cpp::CdrReader & cdr,
+  @('::'.join([package_name] + list(interface_path.parents[0].parts) + [message.structure.namespaced_type.name])) & ros_message);
+
+}  // namespace typesupport_cyclonedds_cpp
+@[  for ns in reversed(message.structure.namespaced_type.namespaces)]@
+
+}  // namespace @(ns)
+@[  end for]@
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+ROSIDL_TYPESUPPORT_CYCLONEDDS_CPP_PUBLIC_@(package_name)
+const rosidl_message_type_support_t *
+  ROSIDL_TYPESUPPORT_INTERFACE__MESSAGE_SYMBOL_NAME(rosidl_typesupport_cyclonedds_cpp, @(', '.join([package_name] + list(interface_path.parents[0].parts) + [message.structure.namespaced_type.name])))();
+
+#ifdef __cplusplus
+}
+#endif
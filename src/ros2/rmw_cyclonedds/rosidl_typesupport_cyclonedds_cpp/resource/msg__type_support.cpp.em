@@ -0,0 +1,339 @@
+@# Included from rosidl_typesupport_cyclonedds_cpp/resource/idl__type_support.cpp.em
+@{
+from rosidl_parser.definition import AbstractNestedType
+from rosidl_parser.definition import AbstractString
+from rosidl_parser.definition import AbstractWString
+from rosidl_parser.definition import Array
+from rosidl_parser.definition import BasicType
+from rosidl_parser.definition import BoundedSequence
+from rosidl_parser.definition import NamespacedType
+
+header_files = [
+    'cstddef',
+    'stdexcept',
+    'rosidl_typesupport_cyclonedds_cpp/cdr.hpp',
+    'rosidl_typesupport_cyclonedds_cpp/identifier.hpp',
+    'rosidl_typesupport_cyclonedds_cpp/message_type_support.hpp',
+    'rosidl_typesupport_cyclonedds_cpp/message_type_support_decl.hpp',
+]
+
+message_type = '::'.join(
+    [package_name] + list(interface_path.parents[0].parts) +
+    [message.structure.namespaced_type.name])
+}@
+@[for header_file in header_files]@
+@[    if header_file in include_directives]@
+// already included above
+// @
+@[    else]@
+@{include_directives.add(header_file)}@
+@[    end if]@
+@[    if '/' not in header_file]@
+#include <@(header_file)>
+@[    else]@
+#include "@(header_file)"
+@[    end if]@
+@[end for]@
+
+
+// forward declaration of message dependencies and their serialization functions
+@[for member in message.structure.members]@
+@{
+type_ = member.type
+if isinstance(type_, AbstractNestedType):
+    type_ = type_.value_type
+}@
+@[  if isinstance(type_, NamespacedType)]@
+@[    for ns in type_.namespaces]@
+namespace @(ns)
+{
+@[    end for]@
+namespace typesupport_cyclonedds_cpp
+{
+void get_serialized_size(
+  const @('::'.join(type_.namespaced_name())) &,
+  rosidl_typesupport_cyclonedds_cpp::CdrSizeCalculator &);
+void cdr_serialize(
+  const @('::'.join(type_.namespaced_name())) &,
+  rosidl_typesupport_cyclonedds_cpp::CdrWriter &);
+void cdr_deserialize(
+  rosidl_typesupport_cyclonedds_cpp::CdrReader &,
+  @('::'.join(type_.namespaced_name())) &);
+}  // namespace typesupport_cyclonedds_cpp
+@[    for ns in reversed(type_.namespaces)]@
+}  // namespace @(ns)
+@[    end for]@
+
+@[  end if]@
+@[end for]@
+@
+@[  for ns in message.structure.namespaced_type.namespaces]@
+
+namespace @(ns)
+{
+@[  end for]@
+
+namespace typesupport_cyclonedds_cpp
+{
+
+void
+ROSIDL_TYPESUPPORT_CYCLONEDDS_CPP_PUBLIC_@(package_name)
+get_serialized_size(
+  const @(message_type) & ros_message,
+  rosidl_typesupport_cyclonedds_cpp::CdrSizeCalculator & cdr)
+{
+@[for member in message.structure.members]@
+@{
+type_ = member.type
+if isinstance(type_, AbstractNestedType):
+    type_ = type_.value_type
+}@
+  // Member: @(member.name)
+@[  if isinstance(member.type, AbstractNestedType)]@
+  {
+@[    if isinstance(member.type, Array)]@
+    const size_t size = @(member.type.size);
+@[    else]@
+    const size_t size = ros_message.@(member.name).size();
+@[      if isinstance(member.type, BoundedSequence)]@
+    if (size > @(member.type.maximum_size)) {
+      throw std::runtime_error("sequence size exceeds upper bound");
+    }
+@[      end if]@
+    cdr.add_length();
+@[    end if]@
+@[    if isinstance(type_, BasicType)]@
+    cdr.add_array<decltype(ros_message.@(member.name))::value_type>(size);
+@[    else]@
+    for (size_t i = 0; i < size; i++) {
+@[      if isinstance(type_, AbstractString)]@
+      cdr.add_string(ros_message.@(member.name)[i]);
+@[      elif isinstance(type_, AbstractWString)]@
+      cdr.add_wstring(ros_message.@(member.name)[i]);
+@[      else]@
+      @('::'.join(type_.namespaces))::typesupport_cyclonedds_cpp::get_serialized_size(
+        ros_message.@(member.name)[i], cdr);
+@[      end if]@
+    }
+@[    end if]@
+  }
+@[  elif isinstance(type_, BasicType)]@
+  cdr.add<decltype(ros_message.@(member.name))>();
+@[  elif isinstance(type_, AbstractString)]@
+  cdr.add_string(ros_message.@(member.name));
+@[  elif isinstance(type_, AbstractWString)]@
+  cdr.add_wstring(ros_message.@(member.name));
+@[  else]@
+  @('::'.join(type_.namespaces))::typesupport_cyclonedds_cpp::get_serialized_size(
+    ros_message.@(member.name), cdr);
+@[  end if]@
+@[end for]@
+}
+
+void
+ROSIDL_TYPESUPPORT_CYCLONEDDS_CPP_PUBLIC_@(package_name)
+cdr_serialize(
+  const @(message_type) & ros_message,
+  rosidl_typesupport_cyclonedds_cpp::CdrWriter & cdr)
+{
+@[for member in message.structure.members]@
+@{
+type_ = member.type
+if isinstance(type_, AbstractNestedType):
+    type_ = type_.value_type
+}@
+  // Member: @(member.name)
+@[  if isinstance(member.type, AbstractNestedType)]@
+  {
+@[    if isinstance(member.type, Array)]@
+    const size_t size = @(member.type.size);
+@[    else]@
+    const size_t size = ros_message.@(member.name).size();
+@[      if isinstance(member.type, BoundedSequence)]@
+    if (size > @(member.type.maximum_size)) {
+      throw std::runtime_error("sequence size exceeds upper bound");
+    }
+@[      end if]@
+    cdr.put_length(size);
+@[    end if]@
+@[    if isinstance(type_, BasicType) and (isinstance(member.type, Array) or type_.typename != 'boolean')]@
+@[      if isinstance(member.type, BoundedSequence)]@
+    // BoundedVector::data() can not be called for its own element type
+    cdr.put_array(size ? &ros_message.@(member.name)[0] : nullptr, size);
+@[      else]@
+    cdr.put_array(ros_message.@(member.name).data(), size);
+@[      end if]@
+@[    else]@
+    for (size_t i = 0; i < size; i++) {
+@[      if isinstance(type_, BasicType)]@
+      cdr.put(static_cast<bool>(ros_message.@(member.name)[i]));
+@[      elif isinstance(type_, AbstractString)]@
+      cdr.put_string(ros_message.@(member.name)[i]);
+@[      elif isinstance(type_, AbstractWString)]@
+      cdr.put_wstring(ros_message.@(member.name)[i]);
+@[      else]@
+      @('::'.join(type_.namespaces))::typesupport_cyclonedds_cpp::cdr_serialize(
+        ros_message.@(member.name)[i], cdr);
+@[      end if]@
+    }
+@[    end if]@
+  }
+@[  elif isinstance(type_, BasicType)]@
+  cdr.put(ros_message.@(member.name));
+@[  elif isinstance(type_, AbstractString)]@
+  cdr.put_string(ros_message.@(member.name));
+@[  elif isinstance(type_, AbstractWString)]@
+  cdr.put_wstring(ros_message.@(member.name));
+@[  else]@
+  @('::'.join(type_.namespaces))::typesupport_cyclonedds_cpp::cdr_serialize(
+    ros_message.@(member.name), cdr);
+@[  end if]@
+@[end for]@
+}
+
+void
+ROSIDL_TYPESUPPORT_CYCLONEDDS_CPP_PUBLIC_@(package_name)
+cdr_deserialize(
+  rosidl_typesupport_cyclonedds_cpp::CdrReader & cdr,
+  @(message_type) & ros_message)
+{
+@[for member in message.structure.members]@
+@{
+type_ = member.type
+if isinstance(type_, AbstractNestedType):
+    type_ = type_.value_type
+}@
+  // Member: @(member.name)
+@[  if isinstance(member.type, AbstractNestedType)]@
+  {
+@[    if isinstance(member.type, Array)]@
+    const size_t size = @(member.type.size);
+@[    else]@
+@[      if isinstance(type_, BasicType)]@
+    const size_t size =
+      cdr.get_length(sizeof(decltype(ros_message.@(member.name))::value_type));
+@[      elif isinstance(type_, (AbstractString, AbstractWString))]@
+    // each element starts with its length
+    const size_t size = cdr.get_length(4);
+@[      else]@
+    const size_t size = cdr.get_length(1);
+@[      end if]@
+@[      if isinstance(member.type, BoundedSequence)]@
+    if (size > @(member.type.maximum_size)) {
+      throw std::runtime_error("sequence size exceeds upper bound");
+    }
+@[      end if]@
+    ros_message.@(member.name).resize(size);
+@[    end if]@
+@[    if isinstance(type_, BasicType) and (isinstance(member.type, Array) or type_.typename != 'boolean')]@
+@[      if isinstance(member.type, BoundedSequence)]@
+    // BoundedVector::data() can not be called for its own element type
+    cdr.get_array(size ? &ros_message.@(member.name)[0] : nullptr, size);
+@[      else]@
+    cdr.get_array(ros_message.@(member.name).data(), size);
+@[      end if]@
+@[    else]@
+    for (size_t i = 0; i < size; i++) {
+@[      if isinstance(type_, BasicType)]@
+      bool value;
+      cdr.get(value);
+      ros_message.@(member.name)[i] = value;
+@[      elif isinstance(type_, AbstractString)]@
+      cdr.get_string(ros_message.@(member.name)[i]);
+@[      elif isinstance(type_, AbstractWString)]@
+      cdr.get_wstring(ros_message.@(member.name)[i]);
+@[      else]@
+      @('::'.join(type_.namespaces))::typesupport_cyclonedds_cpp::cdr_deserialize(
+        cdr, ros_message.@(member.name)[i]);
+@[      end if]@
+    }
+@[    end if]@
+  }
+@[  elif isinstance(type_, BasicType)]@
+  cdr.get(ros_message.@(member.name));
+@[  elif isinstance(type_, AbstractString)]@
+  cdr.get_string(ros_message.@(member.name));
+@[  elif isinstance(type_, AbstractWString)]@
+  cdr.get_wstring(ros_message.@(member.name));
+@[  else]@
+  @('::'.join(type_.namespaces))::typesupport_cyclonedds_cpp::cdr_deserialize(
+    cdr, ros_message.@(member.name));
+@[  end if]@
+@[end for]@
+}
+
+static size_t _@(message.structure.namespaced_type.name)__get_serialized_size(
+  const void * untyped_ros_message)
+{
+  auto typed_message = static_cast<const @(message_type) *>(untyped_ros_message);
+  rosidl_typesupport_cyclonedds_cpp::CdrSizeCalculator cdr;
+  get_serialized_size(*typed_message, cdr);
+  return rosidl_typesupport_cyclonedds_cpp::encapsulation_header_size + cdr.offset();
+}
+
+static void _@(message.structure.namespaced_type.name)__serialize(
+  const void * untyped_ros_message, void * buffer, size_t size)
+{
+  auto typed_message = static_cast<const @(message_type) *>(untyped_ros_message);
+  rosidl_typesupport_cyclonedds_cpp::CdrWriter cdr(buffer, size);
+  cdr_serialize(*typed_message, cdr);
+}
+
+static bool _@(message.structure.namespaced_type.name)__deserialize(
+  const void * buffer, size_t size, void * untyped_ros_message)
+{
+  if (!rosidl_typesupport_cyclonedds_cpp::CdrReader::is_native_encoding(buffer, size)) {
+    return false;
+  }
+  auto typed_message = static_cast<@(message_type) *>(untyped_ros_message);
+  rosidl_typesupport_cyclonedds_cpp::CdrReader cdr(buffer, size);
+  cdr_deserialize(cdr, *typed_message);
+  return true;
+}
+
+static rosidl_typesupport_cyclonedds_cpp::message_type_support_callbacks_t _@(message.structure.namespaced_type.name)__callbacks = {
+  "@('::'.join([package_name] + list(interface_path.parents[0].parts)))",
+  "@(message.structure.namespaced_type.name)",
+  _@(message.structure.namespaced_type.name)__get_serialized_size,
+  _@(message.structure.namespaced_type.name)__serialize,
+  _@(message.structure.namespaced_type.name)__deserialize
+};
+
+static rosidl_message_type_support_t _@(message.structure.namespaced_type.name)__handle = {
+  rosidl_typesupport_cyclonedds_cpp::typesupport_identifier,
+  &_@(message.structure.namespaced_type.name)__callbacks,
+  get_message_typesupport_handle_function,
+};
+
+}  // namespace typesupport_cyclonedds_cpp
+@[  for ns in reversed(message.structure.namespaced_type.namespaces)]@
+
+}  // namespace @(ns)
+@[  end for]@
+
+namespace rosidl_typesupport_cyclonedds_cpp
+{
+
+template<>
+ROSIDL_TYPESUPPORT_CYCLONEDDS_CPP_EXPORT_@(package_name)
+const rosidl_message_type_support_t *
+get_message_type_support_handle<@(message_type)>()
+{
+  return &@('::'.join([package_name] + list(interface_path.parents[0].parts)))::typesupport_cyclonedds_cpp::_@(message.structure.namespaced_type.name)__handle;
+}
+
+}  // namespace rosidl_typesupport_cyclonedds_cpp
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+const rosidl_message_type_support_t *
+ROSIDL_TYPESUPPORT_INTERFACE__MESSAGE_SYMBOL_NAME(rosidl_typesupport_cyclonedds_cpp, @(', '.join([package_name] + list(interface_path.parents[0].parts) + [message.structure.namespaced_type.name])))() {
+  return &@('::'.join([package_name] + list(interface_path.parents[0].parts)))::typesupport_cyclonedds_cpp::_@(message.structure.namespaced_type.name)__handle;
+}
+
+#ifdef __cplusplus
+}
+#endif
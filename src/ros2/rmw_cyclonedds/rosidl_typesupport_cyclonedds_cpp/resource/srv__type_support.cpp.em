@@ -0,0 +1,92 @@
+@# Included from rosidl_typesupport_cyclonedds_cpp/resource/idl__type_support.cpp.em
+@{
+from rosidl_cmake import convert_camel_case_to_lower_case_underscore
+
+include_parts = [package_name] + list(interface_path.parents[0].parts) + [
+    'detail', convert_camel_case_to_lower_case_underscore(interface_path.stem)]
+include_base = '/'.join(include_parts)
+}@
+@{
+TEMPLATE(
+    'msg__type_support.cpp.em',
+    package_name=package_name, interface_path=interface_path, message=service.request_message,
+    include_directives=include_directives)
+}@
+
+@{
+TEMPLATE(
+    'msg__type_support.cpp.em',
+    package_name=package_name, interface_path=interface_path, message=service.response_message,
+    include_directives=include_directives)
+}@
+
+@{
+header_files = [
+    'rosidl_typesupport_cyclonedds_cpp/identifier.hpp',
+    'rosidl_typesupport_cyclonedds_cpp/service_type_support.hpp',
+    'rosidl_typesupport_cyclonedds_cpp/service_type_support_decl.hpp',
+]
+}@
+@[for header_file in header_files]@
+@[    if header_file in include_directives]@
+// already included above
+// @
+@[    else]@
+@{include_directives.add(header_file)}@
+@[    end if]@
+#include "@(header_file)"
+@[end for]@
+@[  for ns in service.namespaced_type.namespaces]@
+
+namespace @(ns)
+{
+@[  end for]@
+
+namespace typesupport_cyclonedds_cpp
+{
+
+static rosidl_typesupport_cyclonedds_cpp::service_type_support_callbacks_t _@(service.namespaced_type.name)__callbacks = {
+  "@('::'.join([package_name] + list(interface_path.parents[0].parts)))",
+  "@(service.namespaced_type.name)",
+  ROSIDL_TYPESUPPORT_INTERFACE__MESSAGE_SYMBOL_NAME(rosidl_typesupport_cyclonedds_cpp, @(', '.join([package_name] + list(interface_path.parents[0].parts))), @(service.namespaced_type.name)_Request)(),
+  ROSIDL_TYPESUPPORT_INTERFACE__MESSAGE_SYMBOL_NAME(rosidl_typesupport_cyclonedds_cpp, @(', '.join([package_name] + list(interface_path.parents[0].parts))), @(service.namespaced_type.name)_Response)(),
+};
+
+static rosidl_service_type_support_t _@(service.namespaced_type.name)__handle = {
+  rosidl_typesupport_cyclonedds_cpp::typesupport_identifier,
+  &_@(service.namespaced_type.name)__callbacks,
+  get_service_typesupport_handle_function,
+};
+
+}  // namespace typesupport_cyclonedds_cpp
+@[  for ns in reversed(service.namespaced_type.namespaces)]@
+
+}  // namespace @(ns)
+@[  end for]@
+
+namespace rosidl_typesupport_cyclonedds_cpp
+{
+
+template<>
+ROSIDL_TYPESUPPORT_CYCLONEDDS_CPP_EXPORT_@(package_name)
+const rosidl_service_type_support_t *
+get_service_type_support_handle<@('::'.join([package_name] + list(interface_path.parents[0].parts) + [service.namespaced_type.name]))>()
+{
+  return &@('::'.join([package_name] + list(interface_path.parents[0].parts)))::typesupport_cyclonedds_cpp::_@(service.namespaced_type.name)__handle;
+}
+
+}  // namespace rosidl_typesupport_cyclonedds_cpp
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+const rosidl_service_type_support_t *
+ROSIDL_TYPESUPPORT_INTERFACE__SERVICE_SYMBOL_NAME(rosidl_typesupport_cyclonedds_cpp, @(', '.join([package_name] + list(interface_path.parents[0].parts))), @(service.namespaced_type.name))() {
+  return &@('::'.join([package_name] + list(interface_path.parents[0].parts)))::typesupport_cyclonedds_cpp::_@(service.namespaced_type.name)__handle;
+}
+
+#ifdef __cplusplus
+}
+#endif
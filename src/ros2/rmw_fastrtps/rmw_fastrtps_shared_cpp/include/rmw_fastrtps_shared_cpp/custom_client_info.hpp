@@ -41,6 +41,8 @@
 
 #include "rcpputils/thread_safety_annotations.hpp"
 
+#include "rmw/event_callback_type.h"
+
 #include "rmw_fastrtps_shared_cpp/TypeSupport.hpp"
 
 class ClientListener;
@@ -118,6 +120,12 @@ public:
             list.emplace_back(std::move(response));
             list_has_data_.store(true);
           }
+
+          if (on_new_response_cb_) {
+            on_new_response_cb_(user_data_, 1);
+          } else {
+            unread_count_++;
+          }
         }
       }
     }
@@ -157,6 +165,19 @@ public:
     return list_has_data_.load();
   }
 
+  void
+  set_on_new_response_callback(const void * user_data, rmw_event_callback_t callback)
+  {
+    std::lock_guard<std::mutex> lock(internalMutex_);
+    if (callback && unread_count_ > 0) {
+      // Report the responses that arrived while no callback was set.
+      callback(user_data, unread_count_);
+      unread_count_ = 0;
+    }
+    user_data_ = user_data;
+    on_new_response_cb_ = callback;
+  }
+
   void on_subscription_matched(
     eprosima::fastdds::dds::DataReader * /* reader */,
     const eprosima::fastdds::dds::SubscriptionMatchedStatus & info) final
@@ -193,6 +214,10 @@ private:
   std::mutex * conditionMutex_ RCPPUTILS_TSA_GUARDED_BY(internalMutex_);
   std::condition_variable * conditionVariable_ RCPPUTILS_TSA_GUARDED_BY(internalMutex_);
   std::set<eprosima::fastrtps::rtps::GUID_t> publishers_;
+
+  rmw_event_callback_t on_new_response_cb_ RCPPUTILS_TSA_GUARDED_BY(internalMutex_) {nullptr};
+  const void * user_data_ RCPPUTILS_TSA_GUARDED_BY(internalMutex_) {nullptr};
+  size_t unread_count_ RCPPUTILS_TSA_GUARDED_BY(internalMutex_) {0};
 };
 
 class ClientPubListener : public eprosima::fastdds::dds::DataWriterListener
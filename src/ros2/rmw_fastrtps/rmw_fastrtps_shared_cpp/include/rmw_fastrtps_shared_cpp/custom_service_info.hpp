@@ -39,6 +39,8 @@
 
 #include "rcpputils/thread_safety_annotations.hpp"
 
+#include "rmw/event_callback_type.h"
+
 #include "rmw_fastrtps_shared_cpp/guid_utils.hpp"
 #include "rmw_fastrtps_shared_cpp/TypeSupport.hpp"
 
@@ -239,6 +241,12 @@ public:
           list.push_back(request);
           list_has_data_.store(true);
         }
+
+        if (on_new_request_cb_) {
+          on_new_request_cb_(user_data_, 1);
+        } else {
+          unread_count_++;
+        }
       }
     }
   }
@@ -289,6 +297,19 @@ public:
     return list_has_data_.load();
   }
 
+  void
+  set_on_new_request_callback(const void * user_data, rmw_event_callback_t callback)
+  {
+    std::lock_guard<std::mutex> lock(internalMutex_);
+    if (callback && unread_count_ > 0) {
+      // Report the requests that arrived while no callback was set.
+      callback(user_data, unread_count_);
+      unread_count_ = 0;
+    }
+    user_data_ = user_data;
+    on_new_request_cb_ = callback;
+  }
+
 private:
   CustomServiceInfo * info_;
   std::mutex internalMutex_;
@@ -296,6 +317,10 @@ private:
   std::atomic_bool list_has_data_;
   std::mutex * conditionMutex_ RCPPUTILS_TSA_GUARDED_BY(internalMutex_);
   std::condition_variable * conditionVariable_ RCPPUTILS_TSA_GUARDED_BY(internalMutex_);
+
+  rmw_event_callback_t on_new_request_cb_ RCPPUTILS_TSA_GUARDED_BY(internalMutex_) {nullptr};
+  const void * user_data_ RCPPUTILS_TSA_GUARDED_BY(internalMutex_) {nullptr};
+  size_t unread_count_ RCPPUTILS_TSA_GUARDED_BY(internalMutex_) {0};
 };
 
 #endif  // RMW_FASTRTPS_SHARED_CPP__CUSTOM_SERVICE_INFO_HPP_
@@ -33,6 +33,7 @@
 
 #include "rcpputils/thread_safety_annotations.hpp"
 
+#include "rmw/event_callback_type.h"
 #include "rmw/impl/cpp/macros.hpp"
 
 #include "rmw_fastrtps_shared_cpp/custom_event_info.hpp"
@@ -91,6 +92,13 @@ public:
   on_data_available(eprosima::fastdds::dds::DataReader * reader) final
   {
     update_has_data(reader);
+
+    std::lock_guard<std::mutex> lock(internalMutex_);
+    if (on_new_message_cb_) {
+      on_new_message_cb_(user_data_, 1);
+    } else {
+      new_data_unread_count_++;
+    }
   }
 
   RMW_FASTRTPS_SHARED_CPP_PUBLIC
@@ -150,6 +158,19 @@ public:
     data_.store(has_data, std::memory_order_relaxed);
   }
 
+  void
+  set_on_new_message_callback(const void * user_data, rmw_event_callback_t callback)
+  {
+    std::lock_guard<std::mutex> lock(internalMutex_);
+    if (callback && new_data_unread_count_ > 0) {
+      // Report the messages that arrived while no callback was set.
+      callback(user_data, new_data_unread_count_);
+      new_data_unread_count_ = 0;
+    }
+    user_data_ = user_data;
+    on_new_message_cb_ = callback;
+  }
+
   size_t publisherCount()
   {
     std::lock_guard<std::mutex> lock(internalMutex_);
@@ -173,6 +194,10 @@ private:
   std::condition_variable * conditionVariable_ RCPPUTILS_TSA_GUARDED_BY(internalMutex_);
 
   std::set<eprosima::fastrtps::rtps::GUID_t> publishers_ RCPPUTILS_TSA_GUARDED_BY(internalMutex_);
+
+  rmw_event_callback_t on_new_message_cb_ RCPPUTILS_TSA_GUARDED_BY(internalMutex_) {nullptr};
+  const void * user_data_ RCPPUTILS_TSA_GUARDED_BY(internalMutex_) {nullptr};
+  size_t new_data_unread_count_ RCPPUTILS_TSA_GUARDED_BY(internalMutex_) {0};
 };
 
 #endif  // RMW_FASTRTPS_SHARED_CPP__CUSTOM_SUBSCRIBER_INFO_HPP_
@@ -126,4 +126,15 @@ __rmw_destroy_client(
   RCUTILS_CAN_RETURN_WITH_ERROR_OF(RMW_RET_ERROR);  // on completion
   return final_ret;
 }
+
+rmw_ret_t
+__rmw_client_set_on_new_response_callback(
+  rmw_client_t * client,
+  rmw_event_callback_t callback,
+  const void * user_data)
+{
+  auto info = static_cast<CustomClientInfo *>(client->data);
+  info->listener_->set_on_new_response_callback(user_data, callback);
+  return RMW_RET_OK;
+}
 }  // namespace rmw_fastrtps_shared_cpp
@@ -138,4 +138,15 @@ __rmw_destroy_service(
   RCUTILS_CAN_RETURN_WITH_ERROR_OF(RMW_RET_ERROR);  // on completion
   return final_ret;
 }
+
+rmw_ret_t
+__rmw_service_set_on_new_request_callback(
+  rmw_service_t * service,
+  rmw_event_callback_t callback,
+  const void * user_data)
+{
+  auto info = static_cast<CustomServiceInfo *>(service->data);
+  info->listener_->set_on_new_request_callback(user_data, callback);
+  return RMW_RET_OK;
+}
 }  // namespace rmw_fastrtps_shared_cpp
@@ -106,4 +106,15 @@ __rmw_subscription_get_actual_qos(
 
   return RMW_RET_OK;
 }
+
+rmw_ret_t
+__rmw_subscription_set_on_new_message_callback(
+  rmw_subscription_t * subscription,
+  rmw_event_callback_t callback,
+  const void * user_data)
+{
+  auto info = static_cast<CustomSubscriberInfo *>(subscription->data);
+  info->listener_->set_on_new_message_callback(user_data, callback);
+  return RMW_RET_OK;
+}
 }  // namespace rmw_fastrtps_shared_cpp
@@ -626,6 +626,23 @@ RMW_INTERFACE_FN(
     rcutils_allocator_t *,
     rmw_network_flow_endpoint_array_t *))
 
+// The following functions are optional, implementations which do not provide them
+// do not support event callbacks.
+RMW_INTERFACE_FN(
+  rmw_subscription_set_on_new_message_callback,
+  rmw_ret_t, RMW_RET_UNSUPPORTED,
+  3, ARG_TYPES(rmw_subscription_t *, rmw_event_callback_t, const void *))
+
+RMW_INTERFACE_FN(
+  rmw_service_set_on_new_request_callback,
+  rmw_ret_t, RMW_RET_UNSUPPORTED,
+  3, ARG_TYPES(rmw_service_t *, rmw_event_callback_t, const void *))
+
+RMW_INTERFACE_FN(
+  rmw_client_set_on_new_response_callback,
+  rmw_ret_t, RMW_RET_UNSUPPORTED,
+  3, ARG_TYPES(rmw_client_t *, rmw_event_callback_t, const void *))
+
 #define GET_SYMBOL(x) symbol_ ## x = get_symbol(#x);
 
 void prefetch_symbols(void)
@@ -706,6 +723,9 @@ void prefetch_symbols(void)
   GET_SYMBOL(rmw_qos_profile_check_compatible)
   GET_SYMBOL(rmw_publisher_get_network_flow_endpoints)
   GET_SYMBOL(rmw_subscription_get_network_flow_endpoints)
+  GET_SYMBOL(rmw_subscription_set_on_new_message_callback)
+  GET_SYMBOL(rmw_service_set_on_new_request_callback)
+  GET_SYMBOL(rmw_client_set_on_new_response_callback)
 }
 
 void * symbol_rmw_init = nullptr;
@@ -808,6 +828,9 @@ unload_library()
   symbol_rmw_qos_profile_check_compatible = nullptr;
   symbol_rmw_publisher_get_network_flow_endpoints = nullptr;
   symbol_rmw_subscription_get_network_flow_endpoints = nullptr;
+  symbol_rmw_subscription_set_on_new_message_callback = nullptr;
+  symbol_rmw_service_set_on_new_request_callback = nullptr;
+  symbol_rmw_client_set_on_new_response_callback = nullptr;
   symbol_rmw_init = nullptr;
   g_rmw_lib.reset();
 }
@@ -13,6 +13,7 @@
 # limitations under the License.
 
 from argparse import FileType
+import datetime
 
 from rclpy.qos import InvalidQoSProfileException
 from ros2bag.api import check_path_exists
@@ -82,6 +83,31 @@ class PlayVerb(VerbExtension):
             '--clock', type=positive_float, nargs='?', const=40, default=0,
             help='Publish to /clock at a specific frequency in Hz, to act as a ROS Time Source. '
                  'Value must be positive. Defaults to not publishing.')
+        parser.add_argument(
+            '--spin-wait-threshold', type=int, default=0,
+            help='time in microseconds before a message is due at which to stop sleeping and '
+                 'busy wait for it, reducing publish jitter at the cost of CPU time. '
+                 'Defaults to only sleeping.')
+        parser.add_argument(
+            '--publish-batch-window', type=int, default=0,
+            help='publish messages due within this many microseconds of bag time together, '
+                 'instead of sleeping until each of them is due. Defaults to no batching.')
+        parser.add_argument(
+            '--publish-thread-cpu', type=int, default=-1,
+            help='CPU to pin the thread publishing the messages to. '
+                 'Defaults to not pinning the thread.')
+        parser.add_argument(
+            '--report-timing', action='store_true',
+            help='log a histogram of how late messages were published at the end of playback.')
+        parser.add_argument(
+            '--publish-threads', type=int, default=0,
+            help='number of threads publishing the messages, each publishing the messages of '
+                 'its topics in order. Helps to keep up with several high-bandwidth topics. '
+                 'Defaults to publishing from the playing thread.')
+        parser.add_argument(
+            '--max-publish-skew', type=int, default=100,
+            help='maximum time in milliseconds by which a publishing thread may lag behind '
+                 'the playback when using --publish-threads.')
 
     def main(self, *, args):  # noqa: D102
         qos_profile_overrides = {}  # Specify a valid default
@@ -116,6 +142,14 @@ class PlayVerb(VerbExtension):
         play_options.loop = args.loop
         play_options.topic_remapping_options = topic_remapping
         play_options.clock_publish_frequency = args.clock
+        play_options.spin_wait_threshold = datetime.timedelta(
+            microseconds=args.spin_wait_threshold)
+        play_options.publish_batch_window = datetime.timedelta(
+            microseconds=args.publish_batch_window)
+        play_options.publish_thread_cpu = args.publish_thread_cpu
+        play_options.report_timing_statistics = args.report_timing
+        play_options.publish_threads = args.publish_threads
+        play_options.max_publish_skew = datetime.timedelta(milliseconds=args.max_publish_skew)
 
         player = Player()
         player.play(storage_options, play_options)
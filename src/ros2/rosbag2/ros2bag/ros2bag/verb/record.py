@@ -96,7 +96,7 @@ class RecordVerb(VerbExtension):
             help="Determine whether to compress by file or message. Default is 'none'."
         )
         parser.add_argument(
-            '--compression-format', type=str, default='', choices=['zstd'],
+            '--compression-format', type=str, default='', choices=['zstd', 'zstd_dict'],
             help='Specify the compression format/algorithm. Default is none.'
         )
         parser.add_argument(
@@ -118,13 +118,18 @@ class RecordVerb(VerbExtension):
             help='Path to a yaml file defining overrides of the QoS profile for specific topics.'
         )
         parser.add_argument(
-            '--storage-preset-profile', type=str, default='none', choices=['none', 'resilient'],
+            '--storage-preset-profile', type=str, default='none',
+            choices=['none', 'resilient', 'high_throughput'],
             help='Select a configuration preset for storage.'
                  'resilient (sqlite3):'
                  'indicate preference for avoiding data corruption in case of crashes,'
                  'at the cost of performance. Setting this flag disables optimization settings '
                  'for storage (the defaut). This flag settings can still be overriden by '
                  'corresponding settings in the config passed with --storage-config-file.'
+                 'high_throughput (sqlite3):'
+                 'insert several messages per statement and create the index when closing the '
+                 'bag, best used with --max-cache-size. Bags which were not closed properly '
+                 'are slower to read.'
         )
         parser.add_argument(
             '--storage-config-file', type=FileType('r'),
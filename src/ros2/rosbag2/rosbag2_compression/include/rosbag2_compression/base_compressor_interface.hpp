@@ -69,6 +69,18 @@ public:
    * This is appended to the extension of the compressed file.
    */
   virtual std::string get_compression_identifier() const = 0;
+
+  /**
+   * Set the folder of the bag being written, called before any message is compressed.
+   * A compressor may store data which is shared by several compressed messages in it, like
+   * compression dictionaries, for the decompressor to load when the bag is read.
+   *
+   * \param bag_folder Path to the folder of the bag.
+   */
+  virtual void set_bag_folder(const std::string & bag_folder)
+  {
+    (void) bag_folder;
+  }
 };
 
 }  // namespace rosbag2_compression
@@ -71,6 +71,17 @@ public:
    * compressed file.
    */
   virtual std::string get_decompression_identifier() const = 0;
+
+  /**
+   * Set the folder of the bag being read, called before any message is decompressed.
+   * This is where the compressor stored the data shared by several compressed messages.
+   *
+   * \param bag_folder Path to the folder of the bag.
+   */
+  virtual void set_bag_folder(const std::string & bag_folder)
+  {
+    (void) bag_folder;
+  }
 };
 
 }  // namespace rosbag2_compression
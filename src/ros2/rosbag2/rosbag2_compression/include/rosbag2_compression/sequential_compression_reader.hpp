@@ -17,6 +17,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "rosbag2_compression/base_decompressor_interface.hpp"
@@ -65,14 +66,15 @@ public:
     const rosbag2_storage::StorageOptions & storage_options,
     const rosbag2_cpp::ConverterOptions & converter_options) override;
 
-  std::shared_ptr<rosbag2_storage::SerializedBagMessage> read_next() override;
-
 protected:
   /**
    * Decompress the current bagfile so that it can be opened by the storage implementation.
+   * Files which were decompressed already, e.g. before seeking back to them, are reused.
    */
   void preprocess_current_file() override;
 
+  std::shared_ptr<rosbag2_storage::SerializedBagMessage> read_next_from_storage() override;
+
 private:
   /**
    * Initializes the decompressor if a compression mode is specified in the metadata.
@@ -88,6 +90,8 @@ private:
   rosbag2_compression::CompressionMode compression_mode_{
     rosbag2_compression::CompressionMode::NONE};
   std::unique_ptr<rosbag2_compression::CompressionFactory> compression_factory_{};
+  // Paths of the files decompressed so far
+  std::unordered_set<std::string> decompressed_files_{};
 
   rosbag2_storage::StorageOptions storage_options_;
 };
@@ -17,6 +17,7 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <queue>
@@ -94,6 +95,8 @@ public:
    * If the compression mode is FILE, write a message to a bagfile.
    * If the compression mode is MESSAGE, pushes the message into a queue that will be processed
    * by the compression threads.
+   * The compression threads work on several messages at once, but hand them to the storage in
+   * the order they were written.
    *
    * The topic needs to have been created before writing is possible.
    *
@@ -119,6 +122,14 @@ public:
    */
   void close() override;
 
+  /**
+   * Get the statistics of the writer pipeline, starting with the compression queue when the
+   * compression mode is MESSAGE.
+   *
+   * \return the statistics of each stage, in the order messages go through them
+   */
+  std::vector<rosbag2_cpp::writers::PipelineStageStatistics> get_pipeline_statistics() override;
+
 protected:
   /**
    * Compress a file and update the metadata file path.
@@ -174,6 +185,19 @@ private:
   std::queue<std::shared_ptr<rosbag2_storage::SerializedBagMessage>>
   compressor_message_queue_ RCPPUTILS_TSA_GUARDED_BY(compressor_queue_mutex_);
   std::queue<std::string> compressor_file_queue_ RCPPUTILS_TSA_GUARDED_BY(compressor_queue_mutex_);
+  std::unordered_map<std::string, uint64_t>
+  compressor_messages_dropped_ RCPPUTILS_TSA_GUARDED_BY(compressor_queue_mutex_);
+  size_t compressor_max_queue_depth_ RCPPUTILS_TSA_GUARDED_BY(compressor_queue_mutex_) = 0;
+  std::atomic<uint64_t> compressor_messages_processed_{0};
+  // Sequence number of the next message taken from the queue by a compression thread
+  uint64_t compressor_next_sequence_ RCPPUTILS_TSA_GUARDED_BY(compressor_queue_mutex_) = 0;
+  // Compressed messages waiting for the messages taken before them, by sequence number.
+  // A nullptr stands for a message which could not be compressed.
+  std::mutex compressed_messages_mutex_;
+  std::map<uint64_t, std::shared_ptr<rosbag2_storage::SerializedBagMessage>>
+  compressed_messages_ RCPPUTILS_TSA_GUARDED_BY(compressed_messages_mutex_);
+  uint64_t compressed_next_sequence_ RCPPUTILS_TSA_GUARDED_BY(compressed_messages_mutex_) = 0;
+  bool compressed_messages_writing_ RCPPUTILS_TSA_GUARDED_BY(compressed_messages_mutex_) = false;
   std::vector<std::thread> compression_threads_;
   /* *INDENT-OFF* */  // uncrustify doesn't understand the macro + brace initializer
   std::atomic_bool compression_is_running_
@@ -190,6 +214,12 @@ private:
   // compression_is_running_ is false; should be run in a separate thread
   void compression_thread_fn();
 
+  // Hands a compressed message to the storage once all the messages before it were written.
+  // Only one thread writes at a time, the others leave their messages for it.
+  void write_compressed_message(
+    uint64_t sequence,
+    std::shared_ptr<rosbag2_storage::SerializedBagMessage> message);
+
   // Closes the current backed storage and opens the next bagfile.
   void split_bagfile() override;
 
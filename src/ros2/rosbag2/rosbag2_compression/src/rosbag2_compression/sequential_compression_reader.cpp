@@ -39,7 +39,10 @@ SequentialCompressionReader::SequentialCompressionReader(
 {}
 
 SequentialCompressionReader::~SequentialCompressionReader()
-{}
+{
+  // The read-ahead thread uses the decompressor
+  stop_read_ahead();
+}
 
 void SequentialCompressionReader::setup_decompression()
 {
@@ -54,12 +57,17 @@ void SequentialCompressionReader::setup_decompression()
 
   decompressor_ = compression_factory_->create_decompressor(metadata_.compression_format);
   rcpputils::check_true(decompressor_ != nullptr, "Couldn't initialize decompressor.");
+  decompressor_->set_bag_folder(base_folder_);
 }
 
 void SequentialCompressionReader::preprocess_current_file()
 {
   setup_decompression();
 
+  if (decompressed_files_.count(get_current_file()) > 0u) {
+    return;
+  }
+
   if (metadata_.version == 4) {
     /*
      * Rosbag2 was released with incorrect relative file naming for compressed bags
@@ -86,6 +94,7 @@ void SequentialCompressionReader::preprocess_current_file()
   if (compression_mode_ == CompressionMode::FILE) {
     ROSBAG2_COMPRESSION_LOG_INFO_STREAM("Decompressing " << get_current_file().c_str());
     *current_file_iterator_ = decompressor_->decompress_uri(get_current_file());
+    decompressed_files_.insert(get_current_file());
   }
 }
 
@@ -102,16 +111,17 @@ void SequentialCompressionReader::open(
   SequentialReader::open(storage_options, converter_options);
 }
 
-std::shared_ptr<rosbag2_storage::SerializedBagMessage> SequentialCompressionReader::read_next()
+std::shared_ptr<rosbag2_storage::SerializedBagMessage>
+SequentialCompressionReader::read_next_from_storage()
 {
-  if (storage_ && decompressor_) {
-    auto message = storage_->read_next();
-    if (compression_mode_ == rosbag2_compression::CompressionMode::MESSAGE) {
-      decompressor_->decompress_serialized_bag_message(message.get());
-    }
-    return converter_ ? converter_->convert(message) : message;
+  if (!decompressor_) {
+    throw std::runtime_error{"Bag is not open. Call open() before reading."};
+  }
+  auto message = storage_->read_next();
+  if (compression_mode_ == rosbag2_compression::CompressionMode::MESSAGE) {
+    decompressor_->decompress_serialized_bag_message(message.get());
   }
-  throw std::runtime_error{"Bag is not open. Call open() before reading."};
+  return converter_ ? converter_->convert(message) : message;
 }
 
 }  // namespace rosbag2_compression
@@ -21,6 +21,7 @@
 #include <stdexcept>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "rcpputils/asserts.hpp"
 #include "rcpputils/filesystem_helper.hpp"
@@ -66,9 +67,11 @@ void SequentialCompressionWriter::compression_thread_fn()
   auto compressor = compression_factory_->create_compressor(
     compression_options_.compression_format);
   rcpputils::check_true(compressor != nullptr, "Could not create compressor.");
+  compressor->set_bag_folder(base_folder_);
 
   while (true) {
     std::shared_ptr<rosbag2_storage::SerializedBagMessage> message;
+    uint64_t sequence = 0;
     std::string file;
     {
       std::unique_lock<std::mutex> lock(compressor_queue_mutex_);
@@ -83,6 +86,9 @@ void SequentialCompressionWriter::compression_thread_fn()
       if (!compressor_message_queue_.empty()) {
         message = compressor_message_queue_.front();
         compressor_message_queue_.pop();
+        // Messages are numbered when they leave the queue, so dropping a message from the
+        // queue doesn't leave a gap in the sequence.
+        sequence = compressor_next_sequence_++;
       } else if (!compressor_file_queue_.empty()) {
         file = compressor_file_queue_.front();
         compressor_file_queue_.pop();
@@ -93,20 +99,76 @@ void SequentialCompressionWriter::compression_thread_fn()
     }
 
     if (message) {
-      compress_message(*compressor, message);
-
-      {
-        // Now that the message is compressed, it can be written to file using the
-        // normal method.
-        std::lock_guard<std::recursive_mutex> storage_lock(storage_mutex_);
-        SequentialWriter::write(message);
+      try {
+        compress_message(*compressor, message);
+      } catch (const std::exception & e) {
+        ROSBAG2_COMPRESSION_LOG_ERROR_STREAM(
+          "Failed to compress message on topic \"" << message->topic_name << "\": " << e.what());
+        {
+          std::lock_guard<std::mutex> lock(compressor_queue_mutex_);
+          ++compressor_messages_dropped_[message->topic_name];
+        }
+        message.reset();
       }
+      // Now that the message is compressed, it can be written to file using the
+      // normal method, once the messages before it are written.
+      write_compressed_message(sequence, message);
     } else if (!file.empty()) {
       compress_file(*compressor, file);
     }
   }
 }
 
+void SequentialCompressionWriter::write_compressed_message(
+  uint64_t sequence,
+  std::shared_ptr<rosbag2_storage::SerializedBagMessage> message)
+{
+  std::unique_lock<std::mutex> lock(compressed_messages_mutex_);
+  compressed_messages_.emplace(sequence, std::move(message));
+  if (compressed_messages_writing_) {
+    // The writing thread picks up the message when its turn comes.
+    return;
+  }
+  compressed_messages_writing_ = true;
+
+  std::vector<std::shared_ptr<rosbag2_storage::SerializedBagMessage>> ready_messages;
+  while (true) {
+    auto it = compressed_messages_.begin();
+    while (it != compressed_messages_.end() && it->first == compressed_next_sequence_) {
+      ready_messages.push_back(std::move(it->second));
+      it = compressed_messages_.erase(it);
+      ++compressed_next_sequence_;
+    }
+    if (ready_messages.empty()) {
+      compressed_messages_writing_ = false;
+      return;
+    }
+
+    // Other threads keep adding their messages while these are written.
+    lock.unlock();
+    {
+      std::lock_guard<std::recursive_mutex> storage_lock(storage_mutex_);
+      for (const auto & ready_message : ready_messages) {
+        if (!ready_message) {
+          continue;
+        }
+        try {
+          SequentialWriter::write(ready_message);
+          ++compressor_messages_processed_;
+        } catch (const std::exception & e) {
+          ROSBAG2_COMPRESSION_LOG_ERROR_STREAM(
+            "Failed to write compressed message on topic \"" << ready_message->topic_name <<
+              "\": " << e.what());
+          std::lock_guard<std::mutex> queue_lock(compressor_queue_mutex_);
+          ++compressor_messages_dropped_[ready_message->topic_name];
+        }
+      }
+    }
+    ready_messages.clear();
+    lock.lock();
+  }
+}
+
 void SequentialCompressionWriter::init_metadata()
 {
   std::lock_guard<std::recursive_mutex> lock(storage_mutex_);
@@ -203,6 +265,11 @@ void SequentialCompressionWriter::close()
     }
 
     stop_compressor_threads();
+    if (conversion_stage_) {
+      // Compressed messages go through the conversion stage into the cache, which is flushed
+      // below, so the stage is closed after the compressor threads and before the cache.
+      conversion_stage_->close();
+    }
 
     finalize_metadata();
     metadata_io_->write_metadata(base_folder_, metadata_);
@@ -253,6 +320,10 @@ void SequentialCompressionWriter::compress_file(
         file_relative_to_bag);
       if (iter != metadata_.relative_file_paths.end()) {
         *iter = relative_compressed_uri.string();
+        const auto index = static_cast<size_t>(iter - metadata_.relative_file_paths.begin());
+        if (index < metadata_.files.size()) {
+          metadata_.files[index].path = *iter;
+        }
       } else {
         ROSBAG2_COMPRESSION_LOG_ERROR_STREAM(
           "Failed to find path to uncompressed bag: \"" << file_relative_to_pwd.string() <<
@@ -315,13 +386,42 @@ void SequentialCompressionWriter::write(
   } else {
     std::lock_guard<std::mutex> lock(compressor_queue_mutex_);
     while (compressor_message_queue_.size() > compression_options_.compression_queue_size) {
+      ++compressor_messages_dropped_[compressor_message_queue_.front()->topic_name];
       compressor_message_queue_.pop();
     }
     compressor_message_queue_.push(message);
+    compressor_max_queue_depth_ =
+      std::max(compressor_max_queue_depth_, compressor_message_queue_.size());
     compressor_condition_.notify_one();
   }
 }
 
+std::vector<rosbag2_cpp::writers::PipelineStageStatistics>
+SequentialCompressionWriter::get_pipeline_statistics()
+{
+  auto statistics = SequentialWriter::get_pipeline_statistics();
+  if (compression_options_.compression_mode == CompressionMode::MESSAGE) {
+    rosbag2_cpp::writers::PipelineStageStatistics compression_statistics;
+    compression_statistics.stage_name = "compression";
+    compression_statistics.messages_processed = compressor_messages_processed_;
+    uint64_t messages_taken = 0;
+    {
+      std::lock_guard<std::mutex> lock(compressor_queue_mutex_);
+      compression_statistics.queue_depth = compressor_message_queue_.size();
+      compression_statistics.max_queue_depth = compressor_max_queue_depth_;
+      compression_statistics.messages_dropped_per_topic = compressor_messages_dropped_;
+      messages_taken = compressor_next_sequence_;
+    }
+    {
+      // Messages being compressed or waiting for their turn to be written
+      std::lock_guard<std::mutex> lock(compressed_messages_mutex_);
+      compression_statistics.queue_depth += messages_taken - compressed_next_sequence_;
+    }
+    statistics.insert(statistics.begin(), compression_statistics);
+  }
+  return statistics;
+}
+
 bool SequentialCompressionWriter::should_split_bagfile()
 {
   if (storage_options_.max_bagfile_size ==
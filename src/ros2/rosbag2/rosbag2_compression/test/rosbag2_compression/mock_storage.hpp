@@ -45,6 +45,9 @@ public:
   MOCK_METHOD0(get_metadata, rosbag2_storage::BagMetadata());
   MOCK_METHOD0(reset_filter, void());
   MOCK_METHOD1(set_filter, void(const rosbag2_storage::StorageFilter &));
+  MOCK_METHOD1(seek, void(const rcutils_time_point_value_t &));
+  MOCK_CONST_METHOD0(get_read_position, rosbag2_storage::ReadPosition());
+  MOCK_METHOD1(set_read_position, void(const rosbag2_storage::ReadPosition &));
   MOCK_CONST_METHOD0(get_bagfile_size, uint64_t());
   MOCK_CONST_METHOD0(get_relative_file_path, std::string());
   MOCK_CONST_METHOD0(get_storage_identifier, std::string());
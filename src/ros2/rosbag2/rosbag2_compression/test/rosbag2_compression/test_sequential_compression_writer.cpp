@@ -14,9 +14,11 @@
 
 #include <gmock/gmock.h>
 
+#include <chrono>
 #include <fstream>
 #include <memory>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -35,6 +37,7 @@
 #include "mock_storage.hpp"
 #include "mock_storage_factory.hpp"
 
+#include "mock_compression.hpp"
 #include "mock_compression_factory.hpp"
 
 using namespace testing;  // NOLINT
@@ -258,4 +261,63 @@ TEST_F(SequentialCompressionWriterTest, writer_creates_correct_metadata_relative
     counter++;
     EXPECT_EQ(ss.str(), path);
   }
+
+  // The per file information names the compressed files as well
+  ASSERT_EQ(intercepted_metadata_.files.size(), 2u);
+  for (size_t i = 0; i < intercepted_metadata_.files.size(); ++i) {
+    EXPECT_EQ(
+      intercepted_metadata_.files[i].path, intercepted_metadata_.relative_file_paths[i]);
+  }
+}
+
+TEST_F(SequentialCompressionWriterTest, compressed_messages_are_written_in_order)
+{
+  const std::string test_topic_name = "test_topic";
+  const uint64_t message_count = 100;
+  rosbag2_compression::CompressionOptions compression_options {
+    DefaultTestCompressor,
+    rosbag2_compression::CompressionMode::MESSAGE,
+    message_count,
+    kDefaultCompressionQueueThreads
+  };
+
+  // Every fourth message takes longer to compress, so the threads finish them out of order
+  auto compression_factory = std::make_unique<NiceMock<MockCompressionFactory>>();
+  ON_CALL(*compression_factory, create_compressor(_)).WillByDefault(
+    [](const std::string &) {
+      auto compressor = std::make_shared<NiceMock<MockCompressor>>();
+      ON_CALL(*compressor, compress_serialized_bag_message(_)).WillByDefault(
+        [](rosbag2_storage::SerializedBagMessage * message) {
+          if (message->time_stamp % 4 == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+          }
+        });
+      return compressor;
+    });
+
+  std::vector<rcutils_time_point_value_t> written_time_stamps;
+  ON_CALL(
+    *storage_,
+    write(An<std::shared_ptr<const rosbag2_storage::SerializedBagMessage>>())).WillByDefault(
+    [&written_time_stamps](std::shared_ptr<const rosbag2_storage::SerializedBagMessage> message) {
+      written_time_stamps.push_back(message->time_stamp);
+    });
+
+  initializeWriter(compression_options, std::move(compression_factory));
+  writer_->open(tmp_dir_storage_options_);
+  writer_->create_topic({test_topic_name, "test_msgs/BasicTypes", "", ""});
+
+  std::vector<rcutils_time_point_value_t> expected_time_stamps;
+  for (rcutils_time_point_value_t time_stamp = 0;
+    time_stamp < static_cast<rcutils_time_point_value_t>(message_count); ++time_stamp)
+  {
+    auto message = std::make_shared<rosbag2_storage::SerializedBagMessage>();
+    message->topic_name = test_topic_name;
+    message->time_stamp = time_stamp;
+    writer_->write(message);
+    expected_time_stamps.push_back(time_stamp);
+  }
+  writer_.reset();
+
+  EXPECT_THAT(written_time_stamps, ContainerEq(expected_time_stamps));
 }
@@ -48,7 +48,7 @@ public:
 
   std::string get_compression_identifier() const override;
 
-private:
+protected:
   ZSTD_CCtx * zstd_context_;
 };
 
@@ -48,7 +48,7 @@ public:
 
   std::string get_decompression_identifier() const override;
 
-private:
+protected:
   ZSTD_DCtx * zstd_context_;
 };
 
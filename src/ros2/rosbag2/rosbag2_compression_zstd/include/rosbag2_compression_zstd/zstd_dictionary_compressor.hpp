@@ -0,0 +1,76 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROSBAG2_COMPRESSION_ZSTD__ZSTD_DICTIONARY_COMPRESSOR_HPP_
+#define ROSBAG2_COMPRESSION_ZSTD__ZSTD_DICTIONARY_COMPRESSOR_HPP_
+
+#include <zstd.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "rosbag2_compression_zstd/visibility_control.hpp"
+#include "rosbag2_compression_zstd/zstd_compressor.hpp"
+
+namespace rosbag2_compression_zstd
+{
+
+/**
+ * A ZstdCompressor which compresses small messages with a dictionary of their topic.
+ *
+ * Small messages hold too little data to compress well on their own, but the messages of a topic
+ * share most of their content. The first small messages of each topic are compressed without a
+ * dictionary and used to train one for the topic, which compresses the following messages.
+ * Each message still gets a zstd frame of its own, so messages can be read in any order.
+ *
+ * Dictionaries are stored as files in the bag folder, the identifier of the dictionary of a
+ * message is in its frame header. Without a bag folder, messages are compressed without
+ * dictionaries.
+ */
+class ROSBAG2_COMPRESSION_ZSTD_PUBLIC ZstdDictionaryCompressor : public ZstdCompressor
+{
+public:
+  ZstdDictionaryCompressor() = default;
+
+  ~ZstdDictionaryCompressor() override = default;
+
+  void compress_serialized_bag_message(
+    rosbag2_storage::SerializedBagMessage * bag_message) override;
+
+  std::string get_compression_identifier() const override;
+
+  void set_bag_folder(const std::string & bag_folder) override;
+
+private:
+  struct TopicDictionary
+  {
+    std::vector<uint8_t> samples;
+    std::vector<size_t> sample_sizes;
+    std::shared_ptr<ZSTD_CDict> dictionary;
+    bool training_failed {false};
+  };
+
+  // Train the dictionary from the collected samples and store it in the bag folder
+  void train_dictionary(const std::string & topic_name, TopicDictionary & topic);
+
+  std::string bag_folder_;
+  std::unordered_map<std::string, TopicDictionary> topics_;
+};
+
+}  // namespace rosbag2_compression_zstd
+
+#endif  // ROSBAG2_COMPRESSION_ZSTD__ZSTD_DICTIONARY_COMPRESSOR_HPP_
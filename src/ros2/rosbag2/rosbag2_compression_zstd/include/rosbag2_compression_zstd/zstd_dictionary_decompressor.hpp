@@ -0,0 +1,59 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROSBAG2_COMPRESSION_ZSTD__ZSTD_DICTIONARY_DECOMPRESSOR_HPP_
+#define ROSBAG2_COMPRESSION_ZSTD__ZSTD_DICTIONARY_DECOMPRESSOR_HPP_
+
+#include <zstd.h>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "rosbag2_compression_zstd/visibility_control.hpp"
+#include "rosbag2_compression_zstd/zstd_decompressor.hpp"
+
+namespace rosbag2_compression_zstd
+{
+
+/**
+ * A ZstdDecompressor for messages compressed by a ZstdDictionaryCompressor.
+ *
+ * Dictionaries are loaded from the bag folder the first time a message needs them.
+ */
+class ROSBAG2_COMPRESSION_ZSTD_PUBLIC ZstdDictionaryDecompressor : public ZstdDecompressor
+{
+public:
+  ZstdDictionaryDecompressor() = default;
+
+  ~ZstdDictionaryDecompressor() override = default;
+
+  void decompress_serialized_bag_message(
+    rosbag2_storage::SerializedBagMessage * bag_message) override;
+
+  std::string get_decompression_identifier() const override;
+
+  void set_bag_folder(const std::string & bag_folder) override;
+
+private:
+  // Get the dictionary, loading it from the bag folder if needed
+  const ZSTD_DDict * get_dictionary(unsigned dictionary_id);
+
+  std::string bag_folder_;
+  std::unordered_map<unsigned, std::shared_ptr<ZSTD_DDict>> dictionaries_;
+};
+
+}  // namespace rosbag2_compression_zstd
+
+#endif  // ROSBAG2_COMPRESSION_ZSTD__ZSTD_DICTIONARY_DECOMPRESSOR_HPP_
@@ -84,6 +84,45 @@ void write_output_buffer(
   fclose(file_pointer);
 }
 
+std::vector<uint8_t> read_input_buffer(const std::string & uri)
+{
+  const auto file_pointer = open_file(uri, "rb");
+  if (file_pointer == nullptr) {
+    std::stringstream errmsg;
+    errmsg << "Failed to open file: \"" << uri <<
+      "\" for binary reading! errno(" << errno << ")";
+
+    throw std::runtime_error{errmsg.str()};
+  }
+
+  std::vector<uint8_t> input_buffer;
+  std::vector<uint8_t> read_buffer(4096);
+  size_t read_count = 0;
+  while ((read_count = fread(read_buffer.data(), sizeof(uint8_t), read_buffer.size(),
+    file_pointer)) > 0)
+  {
+    input_buffer.insert(input_buffer.end(), read_buffer.begin(), read_buffer.begin() + read_count);
+  }
+
+  if (ferror(file_pointer)) {
+    fclose(file_pointer);
+
+    std::stringstream errmsg;
+    errmsg << "Unable to read data from file: \"" << uri << "\"!";
+
+    throw std::runtime_error{errmsg.str()};
+  }
+
+  fclose(file_pointer);
+  return input_buffer;
+}
+
+std::string get_dictionary_path(const std::string & bag_folder, unsigned dictionary_id)
+{
+  const auto file_name =
+    "dictionary_" + std::to_string(dictionary_id) + "." + kDictionaryCompressionIdentifier;
+  return (rcpputils::fs::path(bag_folder) / file_name).string();
+}
 
 void throw_on_zstd_error(const ZstdDecompressReturnType compression_result)
 {
@@ -37,6 +37,15 @@ constexpr const int kDefaultZstdCompressionLevel = 1;
 constexpr const char kCompressionIdentifier[] = "zstd";
 // String constant used to identify ZstdDecompressor.
 constexpr const char kDecompressionIdentifier[] = "zstd";
+// String constant used to identify ZstdDictionaryCompressor and ZstdDictionaryDecompressor.
+constexpr const char kDictionaryCompressionIdentifier[] = "zstd_dict";
+// Number of messages of a topic used to train its dictionary.
+constexpr const size_t kDictionaryTrainingMessages = 100;
+// Messages larger than this are compressed without a dictionary, they hold enough data of their
+// own to compress well.
+constexpr const size_t kDictionaryMaxMessageSize = 16 * 1024;
+// Maximum size of a dictionary.
+constexpr const size_t kDictionaryMaxSize = 16 * 1024;
 // Used as a parameter type in a function that accepts the output of ZSTD_compress.
 using ZstdCompressReturnType = decltype(ZSTD_compress(
     nullptr, 0,
@@ -57,6 +66,21 @@ void write_output_buffer(
   const std::vector<uint8_t> & output_buffer,
   const std::string & uri);
 
+/**
+ * Reads a whole file.
+ * \param uri is the file path to read.
+ * \return the contents of the file.
+ */
+std::vector<uint8_t> read_input_buffer(const std::string & uri);
+
+/**
+ * Get the path of a dictionary file in a bag.
+ * \param bag_folder is the folder of the bag.
+ * \param dictionary_id is the identifier of the dictionary, as stored in zstd frames.
+ * \return the path of the dictionary file.
+ */
+std::string get_dictionary_path(const std::string & bag_folder, unsigned dictionary_id);
+
 /**
  * Checks compression_result and throws a runtime_error if there was a ZSTD error.
  * \param compression_result is the return value of ZSTD_compress or ZSTD_decompress.
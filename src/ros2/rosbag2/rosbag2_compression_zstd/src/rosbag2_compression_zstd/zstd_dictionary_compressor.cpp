@@ -0,0 +1,149 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <zdict.h>
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "rcpputils/filesystem_helper.hpp"
+
+#include "compression_utils.hpp"
+#include "rosbag2_compression_zstd/zstd_dictionary_compressor.hpp"
+
+namespace rosbag2_compression_zstd
+{
+
+namespace
+{
+// Dictionary identifiers below this value are reserved by the zstd format
+constexpr const uint32_t kMinDictionaryId = 32768;
+// The dictionary identifier follows the magic number in the dictionary header
+constexpr const size_t kDictionaryIdOffset = 4;
+}  // namespace
+
+void ZstdDictionaryCompressor::compress_serialized_bag_message(
+  rosbag2_storage::SerializedBagMessage * message)
+{
+  const auto uncompressed_length = message->serialized_data->buffer_length;
+  if (uncompressed_length > kDictionaryMaxMessageSize || bag_folder_.empty()) {
+    ZstdCompressor::compress_serialized_bag_message(message);
+    return;
+  }
+
+  auto & topic = topics_[message->topic_name];
+  if (!topic.dictionary && !topic.training_failed) {
+    topic.samples.insert(
+      topic.samples.end(),
+      message->serialized_data->buffer,
+      message->serialized_data->buffer + uncompressed_length);
+    topic.sample_sizes.push_back(uncompressed_length);
+    if (topic.sample_sizes.size() >= kDictionaryTrainingMessages) {
+      train_dictionary(message->topic_name, topic);
+    }
+  }
+  if (!topic.dictionary) {
+    ZstdCompressor::compress_serialized_bag_message(message);
+    return;
+  }
+
+  const auto start = std::chrono::high_resolution_clock::now();
+  const auto maximum_compressed_length = ZSTD_compressBound(uncompressed_length);
+  std::vector<uint8_t> compressed_buffer(maximum_compressed_length);
+
+  const auto compression_result = ZSTD_compress_usingCDict(
+    zstd_context_,
+    compressed_buffer.data(), maximum_compressed_length,
+    message->serialized_data->buffer, uncompressed_length,
+    topic.dictionary.get());
+  throw_on_zstd_error(compression_result);
+
+  const auto resize_result =
+    rcutils_uint8_array_resize(message->serialized_data.get(), compression_result);
+  throw_on_rcutils_resize_error(resize_result);
+
+  message->serialized_data->buffer_length = compression_result;
+  std::copy(
+    compressed_buffer.begin(), compressed_buffer.begin() + compression_result,
+    message->serialized_data->buffer);
+
+  const auto end = std::chrono::high_resolution_clock::now();
+  print_compression_statistics(start, end, uncompressed_length, compression_result);
+}
+
+void ZstdDictionaryCompressor::train_dictionary(
+  const std::string & topic_name, TopicDictionary & topic)
+{
+  std::vector<uint8_t> dictionary(std::min(kDictionaryMaxSize, topic.samples.size() / 10));
+  const auto dictionary_size = ZDICT_trainFromBuffer(
+    dictionary.data(), dictionary.size(),
+    topic.samples.data(), topic.sample_sizes.data(),
+    static_cast<unsigned>(topic.sample_sizes.size()));
+  topic.samples = std::vector<uint8_t>();
+  topic.sample_sizes = std::vector<size_t>();
+  if (ZDICT_isError(dictionary_size)) {
+    ROSBAG2_COMPRESSION_ZSTD_LOG_DEBUG_STREAM(
+      "Compressing topic " << topic_name << " without a dictionary, training failed: " <<
+        ZDICT_getErrorName(dictionary_size));
+    topic.training_failed = true;
+    return;
+  }
+  dictionary.resize(dictionary_size);
+
+  // Compressors of other threads store their dictionaries in the same folder, so pick an
+  // identifier which is not used yet instead of the one derived from the dictionary content.
+  std::random_device random_device;
+  std::uniform_int_distribution<uint32_t> distribution(kMinDictionaryId, INT32_MAX);
+  uint32_t dictionary_id = 0;
+  std::string dictionary_path;
+  do {
+    dictionary_id = distribution(random_device);
+    dictionary_path = get_dictionary_path(bag_folder_, dictionary_id);
+  } while (rcpputils::fs::path(dictionary_path).exists());
+  for (size_t i = 0; i < 4; ++i) {
+    dictionary[kDictionaryIdOffset + i] = static_cast<uint8_t>(dictionary_id >> (8 * i));
+  }
+
+  // The dictionary is stored before any message using it
+  write_output_buffer(dictionary, dictionary_path);
+  topic.dictionary = std::shared_ptr<ZSTD_CDict>(
+    ZSTD_createCDict(dictionary.data(), dictionary.size(), kDefaultZstdCompressionLevel),
+    ZSTD_freeCDict);
+  if (!topic.dictionary) {
+    throw std::runtime_error{"Failed to create compression dictionary for " + topic_name};
+  }
+  ROSBAG2_COMPRESSION_ZSTD_LOG_DEBUG_STREAM(
+    "Trained dictionary " << dictionary_id << " of " << dictionary.size() <<
+      " bytes for topic " << topic_name);
+}
+
+std::string ZstdDictionaryCompressor::get_compression_identifier() const
+{
+  return kDictionaryCompressionIdentifier;
+}
+
+void ZstdDictionaryCompressor::set_bag_folder(const std::string & bag_folder)
+{
+  bag_folder_ = bag_folder;
+}
+
+}  // namespace rosbag2_compression_zstd
+
+#include "pluginlib/class_list_macros.hpp"  // NOLINT
+PLUGINLIB_EXPORT_CLASS(
+  rosbag2_compression_zstd::ZstdDictionaryCompressor,
+  rosbag2_compression::BaseCompressorInterface)
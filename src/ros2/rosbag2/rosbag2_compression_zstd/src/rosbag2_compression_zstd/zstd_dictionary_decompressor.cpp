@@ -0,0 +1,105 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rcpputils/filesystem_helper.hpp"
+
+#include "compression_utils.hpp"
+#include "rosbag2_compression_zstd/zstd_dictionary_decompressor.hpp"
+
+namespace rosbag2_compression_zstd
+{
+
+void ZstdDictionaryDecompressor::decompress_serialized_bag_message(
+  rosbag2_storage::SerializedBagMessage * message)
+{
+  const auto compressed_buffer_length = message->serialized_data->buffer_length;
+  const auto dictionary_id =
+    ZSTD_getDictID_fromFrame(message->serialized_data->buffer, compressed_buffer_length);
+  if (dictionary_id == 0) {
+    ZstdDecompressor::decompress_serialized_bag_message(message);
+    return;
+  }
+
+  const auto start = std::chrono::high_resolution_clock::now();
+  const auto dictionary = get_dictionary(dictionary_id);
+  const auto decompressed_buffer_length =
+    ZSTD_getFrameContentSize(message->serialized_data->buffer, compressed_buffer_length);
+  throw_on_invalid_frame_content(decompressed_buffer_length);
+
+  std::vector<uint8_t> decompressed_buffer(decompressed_buffer_length);
+  const auto decompression_result = ZSTD_decompress_usingDDict(
+    zstd_context_,
+    decompressed_buffer.data(), decompressed_buffer_length,
+    message->serialized_data->buffer, compressed_buffer_length,
+    dictionary);
+  throw_on_zstd_error(decompression_result);
+
+  const auto resize_result =
+    rcutils_uint8_array_resize(message->serialized_data.get(), decompression_result);
+  throw_on_rcutils_resize_error(resize_result);
+
+  message->serialized_data->buffer_length = decompression_result;
+  std::copy(
+    decompressed_buffer.begin(), decompressed_buffer.end(),
+    message->serialized_data->buffer);
+
+  const auto end = std::chrono::high_resolution_clock::now();
+  print_compression_statistics(start, end, decompression_result, compressed_buffer_length);
+}
+
+const ZSTD_DDict * ZstdDictionaryDecompressor::get_dictionary(unsigned dictionary_id)
+{
+  const auto it = dictionaries_.find(dictionary_id);
+  if (it != dictionaries_.end()) {
+    return it->second.get();
+  }
+
+  const auto dictionary_path = get_dictionary_path(bag_folder_, dictionary_id);
+  if (!rcpputils::fs::path(dictionary_path).exists()) {
+    throw std::runtime_error{
+            "Missing compression dictionary \"" + dictionary_path + "\" to decompress message."};
+  }
+  const auto dictionary_buffer = read_input_buffer(dictionary_path);
+  std::shared_ptr<ZSTD_DDict> dictionary(
+    ZSTD_createDDict(dictionary_buffer.data(), dictionary_buffer.size()), ZSTD_freeDDict);
+  if (!dictionary || ZSTD_getDictID_fromDDict(dictionary.get()) != dictionary_id) {
+    throw std::runtime_error{"Invalid compression dictionary \"" + dictionary_path + "\"."};
+  }
+  dictionaries_.emplace(dictionary_id, dictionary);
+  return dictionary.get();
+}
+
+std::string ZstdDictionaryDecompressor::get_decompression_identifier() const
+{
+  return kDictionaryCompressionIdentifier;
+}
+
+void ZstdDictionaryDecompressor::set_bag_folder(const std::string & bag_folder)
+{
+  bag_folder_ = bag_folder;
+  dictionaries_.clear();
+}
+
+}  // namespace rosbag2_compression_zstd
+
+#include "pluginlib/class_list_macros.hpp"  // NOLINT
+PLUGINLIB_EXPORT_CLASS(
+  rosbag2_compression_zstd::ZstdDictionaryDecompressor,
+  rosbag2_compression::BaseDecompressorInterface)
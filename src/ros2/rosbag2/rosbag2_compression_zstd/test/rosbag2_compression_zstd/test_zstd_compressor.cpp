@@ -16,6 +16,7 @@
 #include <cstdio>
 #include <fstream>
 #include <memory>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -25,6 +26,8 @@
 
 #include "rosbag2_compression_zstd/zstd_compressor.hpp"
 #include "rosbag2_compression_zstd/zstd_decompressor.hpp"
+#include "rosbag2_compression_zstd/zstd_dictionary_compressor.hpp"
+#include "rosbag2_compression_zstd/zstd_dictionary_decompressor.hpp"
 
 #include "rosbag2_storage/ros_helper.hpp"
 
@@ -95,6 +98,27 @@ std::vector<char> read_file(const std::string & uri)
 
   return contents;
 }
+
+/**
+ * Creates a small message which shares most of its content with the other messages of its topic.
+ * \param topic_name Topic of the message.
+ * \param index Index of the message in the topic.
+ * \return The message.
+ */
+std::shared_ptr<rosbag2_storage::SerializedBagMessage> create_small_message(
+  const std::string & topic_name, int index)
+{
+  std::stringstream content;
+  content << "header: {stamp: {sec: " << 1600000000 + index / 100 << ", nanosec: " <<
+    (index % 100) * 10000000 << "}, frame_id: odom}, child_frame_id: base_link, " <<
+    "translation: {x: " << index * 0.01 << ", y: " << index * 0.02 << ", z: 0.0}, " <<
+    "rotation: {x: 0.0, y: 0.0, z: " << (index % 628) / 628.0 << ", w: 1.0}";
+  const auto data = content.str();
+  auto message = std::make_shared<rosbag2_storage::SerializedBagMessage>();
+  message->topic_name = topic_name;
+  message->serialized_data = rosbag2_storage::make_serialized_message(data.data(), data.size());
+  return message;
+}
 }  // namespace
 
 class CompressionHelperFixture : public rosbag2_test_common::TemporaryDirectoryFixture
@@ -297,3 +321,52 @@ TEST_F(CompressionHelperFixture, zstd_decompress_serialized_bag_message)
   std::string new_msg = deserialize_message(msg->serialized_data);
   EXPECT_EQ(new_msg, message_);
 }
+
+TEST_F(CompressionHelperFixture, zstd_dictionary_decompress_messages_in_any_order)
+{
+  const int message_count = 1000;
+  std::vector<std::shared_ptr<rosbag2_storage::SerializedBagMessage>> messages;
+  rosbag2_compression_zstd::ZstdDictionaryCompressor compressor;
+  compressor.set_bag_folder(temporary_dir_path_);
+  rosbag2_compression_zstd::ZstdCompressor plain_compressor;
+  size_t compressed_size = 0;
+  size_t plain_compressed_size = 0;
+  for (int i = 0; i < message_count; ++i) {
+    auto plain_message = create_small_message("/tf", i);
+    plain_compressor.compress_serialized_bag_message(plain_message.get());
+    plain_compressed_size += plain_message->serialized_data->buffer_length;
+
+    messages.push_back(create_small_message("/tf", i));
+    compressor.compress_serialized_bag_message(messages.back().get());
+    compressed_size += messages.back()->serialized_data->buffer_length;
+  }
+  EXPECT_LT(compressed_size, plain_compressed_size);
+
+  rosbag2_compression_zstd::ZstdDictionaryDecompressor decompressor;
+  decompressor.set_bag_folder(temporary_dir_path_);
+  for (int i = message_count - 1; i >= 0; i -= 7) {
+    decompressor.decompress_serialized_bag_message(messages[i].get());
+    EXPECT_EQ(
+      deserialize_message(messages[i]->serialized_data),
+      deserialize_message(create_small_message("/tf", i)->serialized_data));
+  }
+}
+
+TEST_F(CompressionHelperFixture, zstd_dictionary_decompress_fails_on_missing_dictionary)
+{
+  std::shared_ptr<rosbag2_storage::SerializedBagMessage> message;
+  {
+    rosbag2_compression_zstd::ZstdDictionaryCompressor compressor;
+    compressor.set_bag_folder(temporary_dir_path_);
+    for (int i = 0; i < 1000; ++i) {
+      message = create_small_message("/tf", i);
+      compressor.compress_serialized_bag_message(message.get());
+    }
+  }
+
+  // The dictionaries are in the folder of the bag, not in the one of another bag
+  const auto other_bag_folder = rcpputils::fs::path(temporary_dir_path_) / "other_bag";
+  rosbag2_compression_zstd::ZstdDictionaryDecompressor decompressor;
+  decompressor.set_bag_folder(other_bag_folder.string());
+  EXPECT_THROW(decompressor.decompress_serialized_bag_message(message.get()), std::runtime_error);
+}
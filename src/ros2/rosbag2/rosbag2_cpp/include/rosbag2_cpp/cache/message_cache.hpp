@@ -96,6 +96,12 @@ public:
   /// Exposes counts of messages dropped per topic
   std::unordered_map<std::string, uint32_t> messages_dropped() const;
 
+  /// Number of messages in the producer buffer, waiting for the consumer
+  size_t queue_depth() const;
+
+  /// Highest number of messages which were waiting in the producer buffer at once
+  size_t max_queue_depth() const;
+
 private:
   /// Double buffers
   std::shared_ptr<MessageCacheBuffer> primary_buffer_;
@@ -103,11 +109,12 @@ private:
 
   /// Dropped messages per topic. Used for printing in alphabetic order
   std::unordered_map<std::string, uint32_t> messages_dropped_per_topic_;
+  size_t max_queue_depth_ {0u};
 
   /// Double buffers sync (following cpp core guidelines for condition variables)
   bool primary_buffer_can_be_swapped_ {false};
   std::condition_variable cache_condition_var_;
-  std::mutex cache_mutex_;
+  mutable std::mutex cache_mutex_;
 
   /// Cache is no longer accepting messages and is in the process of flushing
   std::atomic_bool flushing_ {false};
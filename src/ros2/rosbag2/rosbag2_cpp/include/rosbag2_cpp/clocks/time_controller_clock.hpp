@@ -41,12 +41,16 @@ public:
    *   Used to control for unit testing, or for specialized needs
    * \param sleep_time_while_paused: Amount of time to sleep in `sleep_until` when the clock
    *   is paused. Allows the caller to spin at a defined rate while receiving `false`
+   * \param spin_wait_threshold: Steady time before the end of a `sleep_until` at which to stop
+   *   sleeping and busy wait instead, so that the wake-up latency of the scheduler does not
+   *   delay it. 0 disables busy waiting
    */
   ROSBAG2_CPP_PUBLIC
   TimeControllerClock(
     rcutils_time_point_value_t starting_time,
     NowFunction now_fn = std::chrono::steady_clock::now,
-    std::chrono::milliseconds sleep_time_while_paused = std::chrono::milliseconds{100});
+    std::chrono::milliseconds sleep_time_while_paused = std::chrono::milliseconds{100},
+    std::chrono::nanoseconds spin_wait_threshold = std::chrono::nanoseconds{0});
 
   ROSBAG2_CPP_PUBLIC
   virtual ~TimeControllerClock();
@@ -63,6 +67,7 @@ public:
    * Return true if the time has been reached, false if it was not successfully reached after sleeping
    * for the appropriate duration.
    * The user should not take action based on this sleep until it returns true.
+   * With a spin wait threshold, the last part of the sleep is spent busy waiting.
    */
   ROSBAG2_CPP_PUBLIC
   bool sleep_until(rcutils_time_point_value_t until) override;
@@ -15,6 +15,7 @@
 #ifndef ROSBAG2_CPP__CONVERTER_OPTIONS_HPP_
 #define ROSBAG2_CPP__CONVERTER_OPTIONS_HPP_
 
+#include <cstdint>
 #include <string>
 
 namespace rosbag2_cpp
@@ -24,6 +25,15 @@ struct ConverterOptions
 {
   std::string input_serialization_format;
   std::string output_serialization_format;
+
+  // Number of threads converting messages to the output serialization format, only used
+  // together with a message cache.
+  // A value of 0 converts every message on the thread which writes it.
+  // Ignored when the input and output formats are the same, as there is nothing to convert.
+  uint64_t conversion_threads = 0;
+
+  // The number of messages each conversion thread can hold before writing blocks.
+  uint64_t conversion_queue_size = 100;
 };
 
 }  // namespace rosbag2_cpp
@@ -23,6 +23,8 @@
 #include "rclcpp/serialization.hpp"
 #include "rclcpp/serialized_message.hpp"
 
+#include "rcutils/time.h"
+
 #include "rosbag2_cpp/converter_options.hpp"
 #include "rosbag2_cpp/readers/sequential_reader.hpp"
 #include "rosbag2_cpp/visibility_control.hpp"
@@ -169,6 +171,18 @@ public:
    */
   void reset_filter();
 
+  /**
+   * Continue reading with the first message at or after the given time, which may be before
+   * the messages read so far. The filter stays in effect.
+   *
+   * Bags with a per-file time index in their metadata jump directly to the file holding
+   * the time, older bags search the files from the first one.
+   *
+   * \param timestamp to continue reading from
+   * \throws runtime_error if the Reader is not open.
+   */
+  void seek(const rcutils_time_point_value_t & timestamp);
+
   reader_interfaces::BaseReaderInterface & get_implementation_handle() const
   {
     return *reader_impl_;
@@ -18,6 +18,8 @@
 #include <memory>
 #include <vector>
 
+#include "rcutils/time.h"
+
 #include "rosbag2_cpp/converter_options.hpp"
 #include "rosbag2_cpp/visibility_control.hpp"
 
@@ -54,6 +56,8 @@ public:
   virtual void set_filter(const rosbag2_storage::StorageFilter & storage_filter) = 0;
 
   virtual void reset_filter() = 0;
+
+  virtual void seek(const rcutils_time_point_value_t & timestamp) = 0;
 };
 
 }  // namespace reader_interfaces
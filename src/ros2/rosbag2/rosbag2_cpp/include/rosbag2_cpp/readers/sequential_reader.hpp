@@ -15,8 +15,13 @@
 #ifndef ROSBAG2_CPP__READERS__SEQUENTIAL_READER_HPP_
 #define ROSBAG2_CPP__READERS__SEQUENTIAL_READER_HPP_
 
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "rosbag2_cpp/converter.hpp"
@@ -26,6 +31,7 @@
 #include "rosbag2_cpp/visibility_control.hpp"
 
 #include "rosbag2_storage/metadata_io.hpp"
+#include "rosbag2_storage/read_position.hpp"
 #include "rosbag2_storage/storage_factory.hpp"
 #include "rosbag2_storage/storage_factory_interface.hpp"
 #include "rosbag2_storage/storage_filter.hpp"
@@ -44,6 +50,13 @@ namespace rosbag2_cpp
 namespace readers
 {
 
+/**
+ * Reader of the files of a bag one after the other.
+ *
+ * With storage_options.read_ahead_queue_size set, a background thread reads, decompresses and
+ * converts up to that many messages ahead of the caller. Seeking and changing the filter stop
+ * the thread and drop the messages read ahead, which are read again if they are still selected.
+ */
 class ROSBAG2_CPP_PUBLIC SequentialReader
   : public ::rosbag2_cpp::reader_interfaces::BaseReaderInterface
 {
@@ -76,6 +89,18 @@ public:
 
   void reset_filter() override;
 
+  /**
+   * Continue reading with the first message at or after the given time.
+   *
+   * The time index of the files in the metadata is used to open the first file which
+   * may hold the time directly, without reading or decompressing the files before it.
+   * The storage then seeks to the time within the file.
+   *
+   * \param timestamp to continue reading from
+   * \throws runtime_error if the bag is not open
+   */
+  void seek(const rcutils_time_point_value_t & timestamp) override;
+
   /**
    * Ask whether there is another database file to read from the list of relative
    * file paths.
@@ -139,6 +164,33 @@ protected:
     */
   virtual void preprocess_current_file() {}
 
+  /**
+   * Ask the storage whether there is another message, moving on to the next files
+   * when the current one has been read completely.
+   * This runs on the read-ahead thread when reading ahead.
+   */
+  virtual bool has_next_in_storage();
+
+  /**
+   * Read the next message from the storage, in the output serialization format.
+   * This runs on the read-ahead thread when reading ahead.
+   */
+  virtual std::shared_ptr<rosbag2_storage::SerializedBagMessage> read_next_from_storage();
+
+  /**
+   * Open the storage of the current file and apply the filter and the last seek to it.
+   * The storage is replaced under the read-ahead mutex, as the read-ahead thread opens the
+   * next files while other threads check whether the bag is open.
+   */
+  void open_current_file();
+
+  /**
+   * Stop the read-ahead thread and drop the messages it read.
+   * Subclasses overriding has_next_in_storage() or read_next_from_storage() must call this
+   * in their destructor, before the state used by these functions is destroyed.
+   */
+  void stop_read_ahead();
+
   std::unique_ptr<rosbag2_storage::StorageFactoryInterface> storage_factory_{};
   std::shared_ptr<rosbag2_storage::storage_interfaces::ReadOnlyInterface> storage_{};
   std::unique_ptr<Converter> converter_{};
@@ -153,8 +205,46 @@ protected:
   std::string base_folder_;
 
 private:
+  // A message read ahead, with the file and the position in it to read it again from
+  struct ReadAheadMessage
+  {
+    std::shared_ptr<rosbag2_storage::SerializedBagMessage> message;
+    size_t file_index;
+    rosbag2_storage::ReadPosition read_position;
+  };
+
+  // Whether a storage is open, also while the read-ahead thread replaces it
+  bool has_storage() const;
+  // Index of the first file which may hold messages at or after the time
+  size_t find_file_to_seek(const rcutils_time_point_value_t & timestamp) const;
+  size_t get_current_file_index() const;
+  // Continue with the first message which was read ahead, after changing the filter
+  void restart_read_ahead_at_next_message();
+  // Stop the read-ahead thread and wait for it, keeping the messages it read
+  void join_read_ahead();
+  // Wait for the read-ahead thread to read a message or to reach the end of the bag,
+  // the thread is started if it is not running yet
+  void wait_for_read_ahead(std::unique_lock<std::mutex> & lock);
+  void read_ahead();
+
   rosbag2_storage::StorageOptions storage_options_;
   std::shared_ptr<SerializationFormatConverterFactoryInterface> converter_factory_{};
+
+  // Time of the last seek, applied to every file opened after it
+  bool seek_requested_ = false;
+  rcutils_time_point_value_t seek_time_ = 0;
+
+  size_t read_ahead_queue_size_ = 0;
+  std::thread read_ahead_thread_;
+  // Protects the read-ahead queue, the state of the read-ahead thread below, and storage_
+  // while the read-ahead thread runs
+  mutable std::mutex read_ahead_mutex_;
+  std::condition_variable read_ahead_message_condition_;
+  std::condition_variable read_ahead_space_condition_;
+  std::deque<ReadAheadMessage> read_ahead_queue_;
+  bool read_ahead_finished_ = false;
+  bool stop_read_ahead_ = false;
+  std::exception_ptr read_ahead_error_;
 };
 
 }  // namespace readers
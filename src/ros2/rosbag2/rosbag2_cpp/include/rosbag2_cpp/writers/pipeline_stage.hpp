@@ -0,0 +1,146 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROSBAG2_CPP__WRITERS__PIPELINE_STAGE_HPP_
+#define ROSBAG2_CPP__WRITERS__PIPELINE_STAGE_HPP_
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "rosbag2_cpp/visibility_control.hpp"
+
+#include "rosbag2_storage/serialized_bag_message.hpp"
+
+// This is necessary because of using stl types here. It is completely safe, because
+// a) the member is not accessible from the outside
+// b) there are no inline functions.
+#ifdef _WIN32
+# pragma warning(push)
+# pragma warning(disable:4251)
+#endif
+
+namespace rosbag2_cpp
+{
+namespace writers
+{
+
+/// Queue depth and message counts of one stage of the writer pipeline.
+struct PipelineStageStatistics
+{
+  std::string stage_name;
+  // Number of messages currently waiting in or being processed by the stage.
+  size_t queue_depth = 0;
+  // Highest number of messages which were in the stage at once.
+  size_t max_queue_depth = 0;
+  // Number of messages which went through the stage.
+  uint64_t messages_processed = 0;
+  // Number of messages which were lost in the stage, per topic.
+  std::unordered_map<std::string, uint64_t> messages_dropped_per_topic;
+};
+
+/**
+* This class implements a stage of the writer pipeline, processing messages on a pool of
+* worker threads and handing the results to the next stage.
+*
+* Each worker has its own bounded queue and all the messages of a topic go to the same worker,
+* so the messages of a topic leave the stage in the order they entered it. When the queue of a
+* worker is full, push() blocks until there is room again: the producer is slowed down instead
+* of the stage growing without bounds or silently losing messages.
+*
+* Each worker gets its own process function from the factory given to the constructor, so it
+* can hold per-thread state like a compression context. A message for which the process
+* function throws or returns nullptr is counted as dropped for its topic.
+*/
+class ROSBAG2_CPP_PUBLIC PipelineStage
+{
+public:
+  using message_t = std::shared_ptr<rosbag2_storage::SerializedBagMessage>;
+  using process_function_t = std::function<message_t(message_t)>;
+  using process_function_factory_t = std::function<process_function_t()>;
+  using sink_function_t = std::function<void (message_t)>;
+
+  /**
+   * Starts the worker threads.
+   *
+   * \param stage_name name of the stage, used in statistics and log messages
+   * \param number_of_workers number of worker threads, at least one is started
+   * \param queue_size number of messages each worker can hold before push() blocks
+   * \param process_function_factory called once per worker to create its process function
+   * \param sink called by the workers with each processed message, must be thread safe
+   */
+  PipelineStage(
+    const std::string & stage_name,
+    size_t number_of_workers,
+    size_t queue_size,
+    process_function_factory_t process_function_factory,
+    sink_function_t sink);
+
+  ~PipelineStage();
+
+  /**
+   * Queue a message for processing, blocking while the queue of its worker is full.
+   *
+   * \throws std::runtime_error if the stage is closed
+   */
+  void push(message_t message);
+
+  /// Block until all the messages pushed so far have left the stage
+  void flush();
+
+  /// Process the remaining messages and stop the workers, the stage can't be used afterwards
+  void close();
+
+  PipelineStageStatistics get_statistics() const;
+
+private:
+  struct Worker
+  {
+    std::deque<message_t> queue;
+    std::condition_variable work_condition;
+    std::thread thread;
+  };
+
+  void exec_processing(Worker & worker, process_function_t process_function);
+
+  const std::string stage_name_;
+  const size_t queue_size_;
+  sink_function_t sink_;
+  std::vector<std::unique_ptr<Worker>> workers_;
+
+  mutable std::mutex stage_mutex_;
+  std::condition_variable space_condition_;
+  std::condition_variable idle_condition_;
+  bool running_ {true};
+  size_t messages_in_stage_ {0u};
+  size_t max_messages_in_stage_ {0u};
+  uint64_t messages_processed_ {0u};
+  std::unordered_map<std::string, uint64_t> messages_dropped_per_topic_;
+};
+
+}  // namespace writers
+}  // namespace rosbag2_cpp
+
+#ifdef _WIN32
+# pragma warning(pop)
+#endif
+
+#endif  // ROSBAG2_CPP__WRITERS__PIPELINE_STAGE_HPP_
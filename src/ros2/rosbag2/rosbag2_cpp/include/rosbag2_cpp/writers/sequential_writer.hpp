@@ -17,6 +17,7 @@
 
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -26,6 +27,7 @@
 #include "rosbag2_cpp/converter.hpp"
 #include "rosbag2_cpp/serialization_format_converter_factory.hpp"
 #include "rosbag2_cpp/writer_interfaces/base_writer_interface.hpp"
+#include "rosbag2_cpp/writers/pipeline_stage.hpp"
 #include "rosbag2_cpp/visibility_control.hpp"
 
 #include "rosbag2_storage/metadata_io.hpp"
@@ -106,6 +108,16 @@ public:
    */
   void write(std::shared_ptr<rosbag2_storage::SerializedBagMessage> message) override;
 
+  /**
+   * Get the queue depth and the dropped messages of each stage a message goes through before
+   * being written to storage, in that order.
+   * Stages only exist while a message cache is used, see StorageOptions::max_cache_size.
+   *
+   * \return statistics of the conversion stage, if conversion_threads is set in the
+   * ConverterOptions and the messages are converted, and of the message cache
+   */
+  virtual std::vector<PipelineStageStatistics> get_pipeline_statistics();
+
 protected:
   std::string base_folder_;
   std::unique_ptr<rosbag2_storage::StorageFactoryInterface> storage_factory_;
@@ -118,6 +130,11 @@ protected:
   std::shared_ptr<rosbag2_cpp::cache::MessageCache> message_cache_;
   std::unique_ptr<rosbag2_cpp::cache::CacheConsumer> cache_consumer_;
 
+  // Converts messages on worker threads before they are pushed into the message cache.
+  std::unique_ptr<PipelineStage> conversion_stage_;
+  // Protects the converter, whose topics may be added while conversion threads use it.
+  std::shared_timed_mutex converter_mutex_;
+
   void switch_to_next_storage();
 
   std::string format_storage_uri(
@@ -35,16 +35,19 @@ MessageCache::MessageCache(uint64_t max_buffer_size)
 
 void MessageCache::push(std::shared_ptr<const rosbag2_storage::SerializedBagMessage> msg)
 {
-  // While pushing, we keep track of inserted and dropped messages as well
-  bool pushed = false;
+  // While pushing, we keep track of inserted and dropped messages as well.
+  // Several threads may push at once, e.g. the workers of a pipeline stage.
   {
     std::lock_guard<std::mutex> cache_lock(cache_mutex_);
+    bool pushed = false;
     if (!flushing_) {
       pushed = primary_buffer_->push(msg);
     }
-  }
-  if (!pushed) {
-    messages_dropped_per_topic_[msg->topic_name]++;
+    if (pushed) {
+      max_queue_depth_ = std::max(max_queue_depth_, primary_buffer_->size());
+    } else {
+      messages_dropped_per_topic_[msg->topic_name]++;
+    }
   }
 
   notify_buffer_consumer();
@@ -94,9 +97,22 @@ std::shared_ptr<MessageCacheBuffer> MessageCache::consumer_buffer()
 
 std::unordered_map<std::string, uint32_t> MessageCache::messages_dropped() const
 {
+  std::lock_guard<std::mutex> cache_lock(cache_mutex_);
   return messages_dropped_per_topic_;
 }
 
+size_t MessageCache::queue_depth() const
+{
+  std::lock_guard<std::mutex> cache_lock(cache_mutex_);
+  return primary_buffer_->size();
+}
+
+size_t MessageCache::max_queue_depth() const
+{
+  std::lock_guard<std::mutex> cache_lock(cache_mutex_);
+  return max_queue_depth_;
+}
+
 void MessageCache::log_dropped()
 {
   uint64_t total_lost = 0;
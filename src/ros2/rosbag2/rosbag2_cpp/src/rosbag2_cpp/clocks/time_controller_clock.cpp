@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <atomic>
 #include <condition_variable>
 #include <memory>
 #include <mutex>
@@ -56,9 +57,11 @@ public:
   };
 
   explicit TimeControllerClockImpl(
-    PlayerClock::NowFunction now_fn, std::chrono::milliseconds sleep_time_while_paused)
+    PlayerClock::NowFunction now_fn, std::chrono::milliseconds sleep_time_while_paused,
+    std::chrono::nanoseconds spin_wait_threshold)
   : now_fn(now_fn),
-    sleep_time_while_paused(sleep_time_while_paused)
+    sleep_time_while_paused(sleep_time_while_paused),
+    spin_wait_threshold(spin_wait_threshold)
   {}
   virtual ~TimeControllerClockImpl() = default;
 
@@ -102,6 +105,7 @@ public:
   {
     reference.ros = ros_time;
     reference.steady = now_fn();
+    reference_version++;
   }
 
   /**
@@ -116,19 +120,24 @@ public:
 
   const PlayerClock::NowFunction now_fn;
   const std::chrono::milliseconds sleep_time_while_paused;
+  const std::chrono::nanoseconds spin_wait_threshold;
 
   std::mutex state_mutex;
   std::condition_variable cv RCPPUTILS_TSA_GUARDED_BY(state_mutex);
   double rate RCPPUTILS_TSA_GUARDED_BY(state_mutex) = 1.0;
   bool paused RCPPUTILS_TSA_GUARDED_BY(state_mutex) = false;
   TimeReference reference RCPPUTILS_TSA_GUARDED_BY(state_mutex);
+  // Incremented with every new reference, lets a busy wait notice changes without the mutex
+  std::atomic<uint64_t> reference_version{0};
 };
 
 TimeControllerClock::TimeControllerClock(
   rcutils_time_point_value_t starting_time,
   NowFunction now_fn,
-  std::chrono::milliseconds sleep_time_while_paused)
-: impl_(std::make_unique<TimeControllerClockImpl>(now_fn, sleep_time_while_paused))
+  std::chrono::milliseconds sleep_time_while_paused,
+  std::chrono::nanoseconds spin_wait_threshold)
+: impl_(std::make_unique<TimeControllerClockImpl>(
+      now_fn, sleep_time_while_paused, spin_wait_threshold))
 {
   if (now_fn == nullptr) {
     throw std::invalid_argument("TimeControllerClock now_fn must be non-empty.");
@@ -149,13 +158,26 @@ rcutils_time_point_value_t TimeControllerClock::now() const
 
 bool TimeControllerClock::sleep_until(rcutils_time_point_value_t until)
 {
+  std::chrono::steady_clock::time_point spin_until;
+  uint64_t spin_reference_version = 0;
+  bool spin = false;
   {
     TSAUniqueLock lock(impl_->state_mutex);
     if (impl_->paused) {
       impl_->cv.wait_for(lock, impl_->sleep_time_while_paused);
     } else {
       const auto steady_until = impl_->ros_to_steady(until);
-      impl_->cv.wait_until(lock, steady_until);
+      const auto spin_from = steady_until - impl_->spin_wait_threshold;
+      const auto version = impl_->reference_version.load();
+      impl_->cv.wait_until(lock, spin_from);
+      // Only busy wait for a deadline which is still valid, and not after a spurious wake-up
+      if (impl_->spin_wait_threshold.count() > 0 && version == impl_->reference_version &&
+        impl_->now_fn() >= spin_from)
+      {
+        spin_until = steady_until;
+        spin_reference_version = version;
+        spin = true;
+      }
     }
     if (impl_->paused) {
       // Don't allow publishing any messages while paused
@@ -163,6 +185,13 @@ bool TimeControllerClock::sleep_until(rcutils_time_point_value_t until)
       return false;
     }
   }
+  if (spin) {
+    while (impl_->now_fn() < spin_until &&
+      impl_->reference_version.load(std::memory_order_relaxed) == spin_reference_version)
+    {
+      std::this_thread::yield();
+    }
+  }
   return now() >= until;
 }
 
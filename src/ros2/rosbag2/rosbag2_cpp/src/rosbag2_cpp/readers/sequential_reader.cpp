@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <chrono>
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -74,6 +75,7 @@ SequentialReader::~SequentialReader()
 
 void SequentialReader::close()
 {
+  stop_read_ahead();
   if (storage_) {
     storage_.reset();
   }
@@ -83,8 +85,11 @@ void SequentialReader::open(
   const rosbag2_storage::StorageOptions & storage_options,
   const ConverterOptions & converter_options)
 {
+  stop_read_ahead();
   storage_options_ = storage_options;
   base_folder_ = storage_options.uri;
+  read_ahead_queue_size_ = storage_options.read_ahead_queue_size;
+  seek_requested_ = false;
 
   // If there is a metadata.yaml file present, load it.
   // If not, let's ask the storage with the given URI for its metadata.
@@ -136,48 +141,93 @@ void SequentialReader::open(
 
 bool SequentialReader::has_next()
 {
-  if (storage_) {
-    // If there's no new message, check if there's at least another file to read and update storage
-    // to read from there. Otherwise, check if there's another message.
-    if (!storage_->has_next() && has_next_file()) {
-      load_next_file();
-      storage_options_.uri = get_current_file();
-
-      storage_ = storage_factory_->open_read_only(storage_options_);
-      storage_->set_filter(topics_filter_);
-    }
-
-    return storage_->has_next();
+  if (!has_storage()) {
+    throw std::runtime_error("Bag is not open. Call open() before reading.");
   }
-  throw std::runtime_error("Bag is not open. Call open() before reading.");
+  if (read_ahead_queue_size_ == 0u) {
+    return has_next_in_storage();
+  }
+  std::unique_lock<std::mutex> lock(read_ahead_mutex_);
+  wait_for_read_ahead(lock);
+  return !read_ahead_queue_.empty();
 }
 
 std::shared_ptr<rosbag2_storage::SerializedBagMessage> SequentialReader::read_next()
 {
-  if (storage_) {
-    auto message = storage_->read_next();
-    return converter_ ? converter_->convert(message) : message;
+  if (!has_storage()) {
+    throw std::runtime_error("Bag is not open. Call open() before reading.");
+  }
+  if (read_ahead_queue_size_ == 0u) {
+    return read_next_from_storage();
+  }
+  std::unique_lock<std::mutex> lock(read_ahead_mutex_);
+  wait_for_read_ahead(lock);
+  if (read_ahead_queue_.empty()) {
+    throw std::runtime_error("No more messages to read.");
+  }
+  auto message = std::move(read_ahead_queue_.front().message);
+  read_ahead_queue_.pop_front();
+  read_ahead_space_condition_.notify_one();
+  return message;
+}
+
+bool SequentialReader::has_next_in_storage()
+{
+  // If there's no new message, check if there's at least another file to read and update storage
+  // to read from there. Otherwise, check if there's another message.
+  if (!storage_->has_next() && has_next_file()) {
+    load_next_file();
+    open_current_file();
+  }
+  return storage_->has_next();
+}
+
+std::shared_ptr<rosbag2_storage::SerializedBagMessage> SequentialReader::read_next_from_storage()
+{
+  auto message = storage_->read_next();
+  return converter_ ? converter_->convert(message) : message;
+}
+
+void SequentialReader::open_current_file()
+{
+  storage_options_.uri = get_current_file();
+  auto storage = storage_factory_->open_read_only(storage_options_);
+  if (!storage) {
+    throw std::runtime_error{"No storage could be initialized. Abort"};
+  }
+  if (seek_requested_) {
+    storage->seek(seek_time_);
   }
-  throw std::runtime_error("Bag is not open. Call open() before reading.");
+  storage->set_filter(topics_filter_);
+  std::lock_guard<std::mutex> lock(read_ahead_mutex_);
+  storage_ = std::move(storage);
+}
+
+bool SequentialReader::has_storage() const
+{
+  std::lock_guard<std::mutex> lock(read_ahead_mutex_);
+  return storage_ != nullptr;
 }
 
 const rosbag2_storage::BagMetadata & SequentialReader::get_metadata() const
 {
-  rcpputils::check_true(storage_ != nullptr, "Bag is not open. Call open() before reading.");
+  rcpputils::check_true(has_storage(), "Bag is not open. Call open() before reading.");
   return metadata_;
 }
 
 std::vector<rosbag2_storage::TopicMetadata> SequentialReader::get_all_topics_and_types() const
 {
-  rcpputils::check_true(storage_ != nullptr, "Bag is not open. Call open() before reading.");
+  rcpputils::check_true(has_storage(), "Bag is not open. Call open() before reading.");
   return topics_metadata_;
 }
 
 void SequentialReader::set_filter(
   const rosbag2_storage::StorageFilter & storage_filter)
 {
-  topics_filter_ = storage_filter;
-  if (storage_) {
+  if (has_storage()) {
+    // The read-ahead thread applies the filter to the files it opens, so it is stopped first
+    restart_read_ahead_at_next_message();
+    topics_filter_ = storage_filter;
     storage_->set_filter(topics_filter_);
     return;
   }
@@ -187,8 +237,9 @@ void SequentialReader::set_filter(
 
 void SequentialReader::reset_filter()
 {
-  topics_filter_ = rosbag2_storage::StorageFilter();
-  if (storage_) {
+  if (has_storage()) {
+    restart_read_ahead_at_next_message();
+    topics_filter_ = rosbag2_storage::StorageFilter();
     storage_->reset_filter();
     return;
   }
@@ -196,6 +247,154 @@ void SequentialReader::reset_filter()
           "Bag is not open. Call open() before resetting filter.");
 }
 
+void SequentialReader::seek(const rcutils_time_point_value_t & timestamp)
+{
+  if (!has_storage()) {
+    throw std::runtime_error("Bag is not open. Call open() before seeking.");
+  }
+  stop_read_ahead();
+  seek_requested_ = true;
+  seek_time_ = timestamp;
+  if (file_paths_.empty()) {
+    storage_->seek(timestamp);
+    return;
+  }
+  const auto file = file_paths_.begin() + find_file_to_seek(timestamp);
+  if (file != current_file_iterator_) {
+    current_file_iterator_ = file;
+    preprocess_current_file();
+    open_current_file();
+  } else {
+    storage_->seek(timestamp);
+  }
+}
+
+size_t SequentialReader::find_file_to_seek(const rcutils_time_point_value_t & timestamp) const
+{
+  // Without a time index, every file has to be searched for the time
+  if (metadata_.files.size() != file_paths_.size()) {
+    return 0u;
+  }
+  for (size_t i = 0; i < metadata_.files.size(); ++i) {
+    const auto & file = metadata_.files[i];
+    const auto end_time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      (file.starting_time + file.duration).time_since_epoch()).count();
+    if (file.message_count > 0u && end_time >= timestamp) {
+      return i;
+    }
+  }
+  // There are no messages after the time, the last file is left with nothing to read
+  return file_paths_.size() - 1u;
+}
+
+size_t SequentialReader::get_current_file_index() const
+{
+  if (file_paths_.empty()) {
+    return 0u;
+  }
+  return static_cast<size_t>(current_file_iterator_ - file_paths_.begin());
+}
+
+void SequentialReader::restart_read_ahead_at_next_message()
+{
+  if (read_ahead_queue_size_ == 0u) {
+    return;
+  }
+  // Once the thread is stopped, the front of the queue is the next message to return
+  join_read_ahead();
+  std::unique_ptr<ReadAheadMessage> next_message;
+  {
+    std::lock_guard<std::mutex> lock(read_ahead_mutex_);
+    if (!read_ahead_queue_.empty()) {
+      next_message = std::make_unique<ReadAheadMessage>(std::move(read_ahead_queue_.front()));
+    }
+  }
+  stop_read_ahead();
+  if (!next_message) {
+    // The storage is right after the last message returned
+    return;
+  }
+  // The storage has moved on past the messages read ahead, which may now be filtered
+  // differently. Go back to where the next message was read, its time is not enough to tell
+  // it apart from the messages before it with the same time.
+  if (next_message->file_index != get_current_file_index()) {
+    current_file_iterator_ = file_paths_.begin() + next_message->file_index;
+    preprocess_current_file();
+    open_current_file();
+  }
+  storage_->set_read_position(next_message->read_position);
+}
+
+void SequentialReader::join_read_ahead()
+{
+  {
+    std::lock_guard<std::mutex> lock(read_ahead_mutex_);
+    stop_read_ahead_ = true;
+  }
+  read_ahead_space_condition_.notify_all();
+  if (read_ahead_thread_.joinable()) {
+    read_ahead_thread_.join();
+  }
+}
+
+void SequentialReader::stop_read_ahead()
+{
+  join_read_ahead();
+  std::lock_guard<std::mutex> lock(read_ahead_mutex_);
+  read_ahead_queue_.clear();
+  read_ahead_finished_ = false;
+  stop_read_ahead_ = false;
+  read_ahead_error_ = nullptr;
+}
+
+void SequentialReader::wait_for_read_ahead(std::unique_lock<std::mutex> & lock)
+{
+  if (!read_ahead_thread_.joinable()) {
+    read_ahead_thread_ = std::thread(&SequentialReader::read_ahead, this);
+  }
+  read_ahead_message_condition_.wait(
+    lock, [this] {return !read_ahead_queue_.empty() || read_ahead_finished_;});
+  if (read_ahead_queue_.empty() && read_ahead_error_) {
+    // Report the error once, the bag then has no more messages
+    auto error = read_ahead_error_;
+    read_ahead_error_ = nullptr;
+    std::rethrow_exception(error);
+  }
+}
+
+void SequentialReader::read_ahead()
+{
+  try {
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(read_ahead_mutex_);
+        read_ahead_space_condition_.wait(
+          lock, [this] {
+            return stop_read_ahead_ || read_ahead_queue_.size() < read_ahead_queue_size_;
+          });
+        if (stop_read_ahead_) {
+          return;
+        }
+      }
+      if (!has_next_in_storage()) {
+        break;
+      }
+      const auto file_index = get_current_file_index();
+      const auto read_position = storage_->get_read_position();
+      auto message = read_next_from_storage();
+      std::lock_guard<std::mutex> lock(read_ahead_mutex_);
+      read_ahead_queue_.push_back({std::move(message), file_index, read_position});
+      read_ahead_message_condition_.notify_one();
+    }
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(read_ahead_mutex_);
+    read_ahead_error_ = std::current_exception();
+  }
+  std::lock_guard<std::mutex> lock(read_ahead_mutex_);
+  read_ahead_finished_ = true;
+  read_ahead_message_condition_.notify_all();
+}
+
 bool SequentialReader::has_next_file() const
 {
   return current_file_iterator_ + 1 != file_paths_.end();
@@ -154,8 +154,8 @@ void Reindexer::init_metadata(
 
 /// Iterate through the bag files to collect various metadata parameters
 /**
- * Collects the topic metadata, `starting_time`, and `duration` portions of the `BagMetadata`
- * being constructed
+ * Collects the topic metadata, `starting_time`, `duration` and the time index of the files
+ * of the `BagMetadata` being constructed
  * @param: files The list of bag files to reindex
  * @param: storage_options Used to construct the `Reader` needed to parse the bag files
  */
@@ -176,14 +176,8 @@ void Reindexer::aggregate_metadata(
     metadata_.bag_size += f_.file_size();
 
     // Set up reader
-    rosbag2_storage::StorageOptions temp_so = {
-      f_.string(),
-      storage_options.storage_id,
-      storage_options.max_bagfile_size,
-      storage_options.max_bagfile_duration,
-      storage_options.max_cache_size,
-      storage_options.storage_config_uri
-    };
+    auto temp_so = storage_options;
+    temp_so.uri = f_.string();
 
     // We aren't actually interested in reading messages, so use a blank converter option
     rosbag2_cpp::ConverterOptions blank_converter_options {};
@@ -196,6 +190,9 @@ void Reindexer::aggregate_metadata(
     metadata_.duration += temp_metadata.duration;
     ROSBAG2_CPP_LOG_DEBUG_STREAM("New duration: " + std::to_string(metadata_.duration.count()));
     metadata_.message_count += temp_metadata.message_count;
+    metadata_.files.push_back(
+      {f_.filename().string(), temp_metadata.starting_time, temp_metadata.duration,
+        temp_metadata.message_count});
 
     // Add the topic metadata
     for (const auto & topic : temp_metadata.topics_with_message_count) {
@@ -0,0 +1,156 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rosbag2_cpp/writers/pipeline_stage.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "rosbag2_cpp/logging.hpp"
+
+namespace rosbag2_cpp
+{
+namespace writers
+{
+
+PipelineStage::PipelineStage(
+  const std::string & stage_name,
+  size_t number_of_workers,
+  size_t queue_size,
+  process_function_factory_t process_function_factory,
+  sink_function_t sink)
+: stage_name_(stage_name),
+  queue_size_(std::max<size_t>(queue_size, 1u)),
+  sink_(std::move(sink))
+{
+  // Create all the process functions first, so no thread is left running if one throws.
+  std::vector<process_function_t> process_functions;
+  for (size_t i = 0; i < std::max<size_t>(number_of_workers, 1u); ++i) {
+    process_functions.push_back(process_function_factory());
+    workers_.push_back(std::make_unique<Worker>());
+  }
+  for (size_t i = 0; i < workers_.size(); ++i) {
+    workers_[i]->thread = std::thread(
+      &PipelineStage::exec_processing, this, std::ref(*workers_[i]),
+      std::move(process_functions[i]));
+  }
+}
+
+PipelineStage::~PipelineStage()
+{
+  close();
+}
+
+void PipelineStage::push(message_t message)
+{
+  auto & worker = *workers_[std::hash<std::string>{}(message->topic_name) % workers_.size()];
+
+  std::unique_lock<std::mutex> lock(stage_mutex_);
+  space_condition_.wait(
+    lock, [this, &worker] {
+      return worker.queue.size() < queue_size_ || !running_;
+    });
+  if (!running_) {
+    throw std::runtime_error("Can't push a message into closed pipeline stage " + stage_name_);
+  }
+  worker.queue.push_back(std::move(message));
+  ++messages_in_stage_;
+  max_messages_in_stage_ = std::max(max_messages_in_stage_, messages_in_stage_);
+  worker.work_condition.notify_one();
+}
+
+void PipelineStage::flush()
+{
+  std::unique_lock<std::mutex> lock(stage_mutex_);
+  idle_condition_.wait(lock, [this] {return messages_in_stage_ == 0u;});
+}
+
+void PipelineStage::close()
+{
+  {
+    std::lock_guard<std::mutex> lock(stage_mutex_);
+    running_ = false;
+    for (auto & worker : workers_) {
+      worker->work_condition.notify_one();
+    }
+  }
+  space_condition_.notify_all();
+
+  for (auto & worker : workers_) {
+    if (worker->thread.joinable()) {
+      worker->thread.join();
+    }
+  }
+}
+
+PipelineStageStatistics PipelineStage::get_statistics() const
+{
+  std::lock_guard<std::mutex> lock(stage_mutex_);
+  PipelineStageStatistics statistics;
+  statistics.stage_name = stage_name_;
+  statistics.queue_depth = messages_in_stage_;
+  statistics.max_queue_depth = max_messages_in_stage_;
+  statistics.messages_processed = messages_processed_;
+  statistics.messages_dropped_per_topic = messages_dropped_per_topic_;
+  return statistics;
+}
+
+void PipelineStage::exec_processing(Worker & worker, process_function_t process_function)
+{
+  std::unique_lock<std::mutex> lock(stage_mutex_);
+  while (true) {
+    // Keep going after close() until the queue is drained.
+    worker.work_condition.wait(
+      lock, [this, &worker] {
+        return !worker.queue.empty() || !running_;
+      });
+    if (worker.queue.empty()) {
+      return;
+    }
+    auto message = std::move(worker.queue.front());
+    worker.queue.pop_front();
+    space_condition_.notify_all();
+    lock.unlock();
+
+    bool processed = false;
+    try {
+      auto result = process_function(message);
+      if (result) {
+        sink_(std::move(result));
+        processed = true;
+      }
+    } catch (const std::exception & e) {
+      ROSBAG2_CPP_LOG_ERROR_STREAM(
+        "Pipeline stage " << stage_name_ << " failed to process a message on topic " <<
+          message->topic_name << ": " << e.what());
+    }
+
+    lock.lock();
+    if (processed) {
+      ++messages_processed_;
+    } else {
+      ++messages_dropped_per_topic_[message->topic_name];
+    }
+    if (--messages_in_stage_ == 0u) {
+      idle_condition_.notify_all();
+    }
+  }
+}
+
+}  // namespace writers
+}  // namespace rosbag2_cpp
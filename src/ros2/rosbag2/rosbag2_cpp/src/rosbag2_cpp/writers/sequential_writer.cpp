@@ -17,6 +17,8 @@
 #include <algorithm>
 #include <chrono>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <stdexcept>
 #include <string>
 #include <sstream>
@@ -27,6 +29,7 @@
 #include "rcpputils/filesystem_helper.hpp"
 
 #include "rosbag2_cpp/info.hpp"
+#include "rosbag2_cpp/logging.hpp"
 
 #include "rosbag2_storage/storage_options.hpp"
 
@@ -86,6 +89,7 @@ void SequentialWriter::init_metadata()
   metadata_.starting_time = std::chrono::time_point<std::chrono::high_resolution_clock>(
     std::chrono::nanoseconds::max());
   metadata_.relative_file_paths = {strip_parent_path(storage_->get_relative_file_path())};
+  metadata_.files = {{metadata_.relative_file_paths.back(), {}, {}, 0u}};
 }
 
 void SequentialWriter::open(
@@ -132,6 +136,7 @@ void SequentialWriter::open(
     throw std::runtime_error{error.str()};
   }
 
+  conversion_stage_.reset();
   use_cache_ = storage_options.max_cache_size > 0u;
   if (use_cache_) {
     message_cache_ = std::make_shared<rosbag2_cpp::cache::MessageCache>(
@@ -142,12 +147,41 @@ void SequentialWriter::open(
         storage_,
         topics_names_to_info_,
         topics_info_mutex_));
+
+    // Without a converter, write() only hands a pointer to the message cache, so a stage in
+    // front of the cache would add a thread hop per message without taking work off the writer.
+    // Per message compression already runs on threads of its own, see
+    // rosbag2_compression::CompressionOptions::compression_threads.
+    if (!converter_ && converter_options.conversion_threads > 0u) {
+      ROSBAG2_CPP_LOG_DEBUG(
+        "No serialization format conversion needed, ignoring the conversion threads.");
+    }
+    if (converter_ && converter_options.conversion_threads > 0u) {
+      conversion_stage_ = std::make_unique<PipelineStage>(
+        "conversion",
+        converter_options.conversion_threads,
+        converter_options.conversion_queue_size,
+        [this]() -> PipelineStage::process_function_t {
+          return [this](PipelineStage::message_t message) {
+                   std::shared_lock<std::shared_timed_mutex> lock(converter_mutex_);
+                   return get_writeable_message(message);
+                 };
+        },
+        [this](PipelineStage::message_t message) {
+          message_cache_->push(message);
+        });
+    }
   }
   init_metadata();
 }
 
 void SequentialWriter::close()
 {
+  if (conversion_stage_) {
+    // Converted messages go into the cache, so the conversion stage is flushed first.
+    conversion_stage_->close();
+  }
+
   if (use_cache_) {
     // destructor will flush message cache
     cache_consumer_.reset();
@@ -197,6 +231,7 @@ void SequentialWriter::create_topic(const rosbag2_storage::TopicMetadata & topic
   storage_->create_topic(topic_with_type);
 
   if (converter_) {
+    std::unique_lock<std::shared_timed_mutex> lock(converter_mutex_);
     converter_->add_topic(topic_with_type.name, topic_with_type.type);
   }
 }
@@ -240,6 +275,9 @@ void SequentialWriter::switch_to_next_storage()
 {
   // consumer remaining message cache
   if (use_cache_) {
+    if (conversion_stage_) {
+      conversion_stage_->flush();
+    }
     cache_consumer_->close();
     message_cache_->log_dropped();
   }
@@ -276,6 +314,7 @@ void SequentialWriter::split_bagfile()
   switch_to_next_storage();
 
   metadata_.relative_file_paths.push_back(strip_parent_path(storage_->get_relative_file_path()));
+  metadata_.files.push_back({metadata_.relative_file_paths.back(), {}, {}, 0u});
 }
 
 void SequentialWriter::write(std::shared_ptr<rosbag2_storage::SerializedBagMessage> message)
@@ -309,16 +348,54 @@ void SequentialWriter::write(std::shared_ptr<rosbag2_storage::SerializedBagMessa
   const auto duration = message_timestamp - metadata_.starting_time;
   metadata_.duration = std::max(metadata_.duration, duration);
 
-  auto converted_msg = get_writeable_message(message);
+  // Time range of the current file, for seeking when reading
+  auto & file = metadata_.files.back();
+  if (file.message_count == 0u) {
+    file.starting_time = message_timestamp;
+    file.duration = std::chrono::nanoseconds(0);
+  } else if (message_timestamp < file.starting_time) {
+    file.duration += file.starting_time - message_timestamp;
+    file.starting_time = message_timestamp;
+  } else {
+    file.duration = std::max<std::chrono::nanoseconds>(
+      file.duration, message_timestamp - file.starting_time);
+  }
+  ++file.message_count;
 
   if (storage_options_.max_cache_size == 0u) {
     // If cache size is set to zero, we write to storage directly
-    storage_->write(converted_msg);
+    storage_->write(get_writeable_message(message));
     ++topic_information->message_count;
+  } else if (conversion_stage_) {
+    // Conversion threads push the converted message into the cache buffer
+    conversion_stage_->push(message);
   } else {
     // Otherwise, use cache buffer
-    message_cache_->push(converted_msg);
+    message_cache_->push(get_writeable_message(message));
+  }
+}
+
+std::vector<PipelineStageStatistics> SequentialWriter::get_pipeline_statistics()
+{
+  std::vector<PipelineStageStatistics> statistics;
+  if (conversion_stage_) {
+    statistics.push_back(conversion_stage_->get_statistics());
+  }
+  if (message_cache_) {
+    PipelineStageStatistics cache_statistics;
+    cache_statistics.stage_name = "cache";
+    cache_statistics.queue_depth = message_cache_->queue_depth();
+    cache_statistics.max_queue_depth = message_cache_->max_queue_depth();
+    for (const auto & topic_dropped : message_cache_->messages_dropped()) {
+      cache_statistics.messages_dropped_per_topic[topic_dropped.first] = topic_dropped.second;
+    }
+    std::lock_guard<std::mutex> lock(topics_info_mutex_);
+    for (const auto & topic : topics_names_to_info_) {
+      cache_statistics.messages_processed += topic.second.message_count;
+    }
+    statistics.push_back(cache_statistics);
   }
+  return statistics;
 }
 
 std::shared_ptr<rosbag2_storage::SerializedBagMessage>
@@ -14,6 +14,7 @@
 
 #include <gmock/gmock.h>
 
+#include <chrono>
 #include <memory>
 #include <string>
 #include <utility>
@@ -118,6 +119,24 @@ public:
   }
 };
 
+class MultifileReaderTestWithTimeIndex : public MultifileReaderTest
+{
+public:
+  rosbag2_storage::BagMetadata get_metadata() const override
+  {
+    auto metadata = MultifileReaderTest::get_metadata();
+    // Each file holds 100 ns worth of messages
+    for (size_t i = 0; i < metadata.relative_file_paths.size(); ++i) {
+      metadata.files.push_back(
+        {metadata.relative_file_paths[i],
+          std::chrono::time_point<std::chrono::high_resolution_clock>(
+            std::chrono::nanoseconds(100 * i)),
+          std::chrono::nanoseconds(99), 10u});
+    }
+    return metadata;
+  }
+};
+
 TEST_F(MultifileReaderTest, has_next_reads_next_file)
 {
   init();
@@ -228,3 +247,45 @@ TEST_F(MultifileReaderTest, get_all_topics_and_types_returns_from_io_metadata)
   const auto all_topics_and_types = reader_->get_all_topics_and_types();
   EXPECT_FALSE(all_topics_and_types.empty());
 }
+
+TEST_F(MultifileReaderTestWithTimeIndex, seek_opens_the_file_holding_the_time)
+{
+  init();
+  reader_->open(default_storage_options_, {"", storage_serialization_format_});
+  auto & sr = static_cast<rosbag2_cpp::readers::SequentialReader &>(
+    reader_->get_implementation_handle());
+
+  EXPECT_CALL(*storage_, seek(150)).Times(1);
+  reader_->seek(150);
+  EXPECT_EQ(sr.get_current_file(), (rcpputils::fs::path(storage_uri_) / relative_path_2_).string());
+
+  EXPECT_CALL(*storage_, seek(10)).Times(1);
+  reader_->seek(10);
+  EXPECT_EQ(sr.get_current_file(), (rcpputils::fs::path(storage_uri_) / relative_path_1_).string());
+
+  // Nothing after the time, the last file is left at its end
+  EXPECT_CALL(*storage_, seek(1000)).Times(1);
+  reader_->seek(1000);
+  EXPECT_EQ(sr.get_current_file(), rcpputils::fs::path(absolute_path_1_).string());
+}
+
+TEST_F(MultifileReaderTest, seek_without_time_index_searches_from_the_first_file)
+{
+  init();
+  EXPECT_CALL(*storage_, has_next()).WillOnce(Return(false)).WillRepeatedly(Return(true));
+  reader_->open(default_storage_options_, {"", storage_serialization_format_});
+  auto & sr = static_cast<rosbag2_cpp::readers::SequentialReader &>(
+    reader_->get_implementation_handle());
+  reader_->has_next();
+  EXPECT_EQ(sr.get_current_file(), (rcpputils::fs::path(storage_uri_) / relative_path_2_).string());
+
+  EXPECT_CALL(*storage_, seek(150)).Times(1);
+  reader_->seek(150);
+  EXPECT_EQ(sr.get_current_file(), (rcpputils::fs::path(storage_uri_) / relative_path_1_).string());
+}
+
+TEST_F(MultifileReaderTest, seek_throws_if_no_storage)
+{
+  init();
+  EXPECT_ANY_THROW(reader_->seek(0));
+}
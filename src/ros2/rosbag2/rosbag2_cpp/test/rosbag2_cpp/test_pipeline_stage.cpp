@@ -0,0 +1,156 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rosbag2_cpp/writers/pipeline_stage.hpp"
+
+#include "rosbag2_storage/serialized_bag_message.hpp"
+
+using namespace testing;  // NOLINT
+using rosbag2_cpp::writers::PipelineStage;
+
+namespace
+{
+PipelineStage::message_t make_test_msg(const std::string & topic_name, int64_t time_stamp)
+{
+  auto message = std::make_shared<rosbag2_storage::SerializedBagMessage>();
+  message->topic_name = topic_name;
+  message->time_stamp = time_stamp;
+  return message;
+}
+
+PipelineStage::process_function_factory_t pass_through()
+{
+  return []() -> PipelineStage::process_function_t {
+           return [](PipelineStage::message_t message) {return message;};
+         };
+}
+}  // namespace
+
+class PipelineStageTest : public Test
+{
+public:
+  void sink(PipelineStage::message_t message)
+  {
+    std::lock_guard<std::mutex> lock(sink_mutex_);
+    received_[message->topic_name].push_back(message->time_stamp);
+  }
+
+  std::mutex sink_mutex_;
+  std::map<std::string, std::vector<int64_t>> received_;
+};
+
+TEST_F(PipelineStageTest, messages_of_a_topic_keep_their_order) {
+  const std::vector<std::string> topics {"a", "b", "c", "d", "e"};
+  const int64_t messages_per_topic = 1000;
+  {
+    PipelineStage stage(
+      "test", 3u, 4u, pass_through(),
+      [this](PipelineStage::message_t message) {sink(message);});
+    for (int64_t i = 0; i < messages_per_topic; ++i) {
+      for (const auto & topic : topics) {
+        stage.push(make_test_msg(topic, i));
+      }
+    }
+    stage.flush();
+
+    auto statistics = stage.get_statistics();
+    EXPECT_THAT(statistics.stage_name, Eq("test"));
+    EXPECT_THAT(statistics.queue_depth, Eq(0u));
+    EXPECT_THAT(statistics.max_queue_depth, Le(3u * 4u));
+    EXPECT_THAT(statistics.messages_processed, Eq(topics.size() * messages_per_topic));
+    EXPECT_THAT(statistics.messages_dropped_per_topic, IsEmpty());
+  }
+
+  ASSERT_THAT(received_.size(), Eq(topics.size()));
+  for (const auto & topic : received_) {
+    ASSERT_THAT(topic.second.size(), Eq(static_cast<size_t>(messages_per_topic)));
+    for (int64_t i = 0; i < messages_per_topic; ++i) {
+      EXPECT_THAT(topic.second[i], Eq(i));
+    }
+  }
+}
+
+TEST_F(PipelineStageTest, push_blocks_while_queue_is_full) {
+  std::atomic_bool release {false};
+  PipelineStage stage(
+    "test", 1u, 2u,
+    [&release]() -> PipelineStage::process_function_t {
+      return [&release](PipelineStage::message_t message) {
+               while (!release) {
+                 std::this_thread::sleep_for(std::chrono::milliseconds(1));
+               }
+               return message;
+             };
+    },
+    [this](PipelineStage::message_t message) {sink(message);});
+
+  // One message is being processed and two wait in the queue, the fourth has to wait.
+  std::atomic_int pushed {0};
+  std::thread producer([&stage, &pushed]() {
+      for (int64_t i = 0; i < 4; ++i) {
+        stage.push(make_test_msg("topic", i));
+        ++pushed;
+      }
+    });
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_THAT(pushed.load(), Eq(3));
+
+  release = true;
+  producer.join();
+  stage.close();
+  EXPECT_THAT(received_["topic"].size(), Eq(4u));
+  EXPECT_THROW(stage.push(make_test_msg("topic", 4)), std::runtime_error);
+}
+
+TEST_F(PipelineStageTest, failed_messages_are_counted_as_dropped_per_topic) {
+  PipelineStage stage(
+    "test", 2u, 10u,
+    []() -> PipelineStage::process_function_t {
+      return [](PipelineStage::message_t message) -> PipelineStage::message_t {
+               if (message->topic_name == "throws") {
+                 throw std::runtime_error("conversion failed");
+               }
+               if (message->topic_name == "filtered") {
+                 return nullptr;
+               }
+               return message;
+             };
+    },
+    [this](PipelineStage::message_t message) {sink(message);});
+
+  for (int64_t i = 0; i < 5; ++i) {
+    stage.push(make_test_msg("throws", i));
+    stage.push(make_test_msg("filtered", i));
+    stage.push(make_test_msg("ok", i));
+  }
+  stage.close();
+
+  auto statistics = stage.get_statistics();
+  EXPECT_THAT(statistics.messages_processed, Eq(5u));
+  EXPECT_THAT(statistics.messages_dropped_per_topic["throws"], Eq(5u));
+  EXPECT_THAT(statistics.messages_dropped_per_topic["filtered"], Eq(5u));
+  EXPECT_THAT(statistics.messages_dropped_per_topic.count("ok"), Eq(0u));
+}
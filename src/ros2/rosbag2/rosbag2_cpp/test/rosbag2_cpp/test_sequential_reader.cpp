@@ -151,3 +151,123 @@ TEST_F(SequentialReaderTest, set_filter_calls_storage) {
   reader_->get_implementation_handle().reset_filter();
   reader_->read_next();
 }
+
+class SequentialReaderReadAheadTest : public SequentialReaderTest
+{
+public:
+  SequentialReaderReadAheadTest()
+  {
+    // The storage holds messages with the time stamps 0 to 99
+    EXPECT_CALL(*storage_, has_next()).WillRepeatedly(
+      Invoke([this]() {return next_time_stamp_ < 100;}));
+    EXPECT_CALL(*storage_, read_next()).WillRepeatedly(
+      Invoke(
+        [this]() {
+          auto message = std::make_shared<rosbag2_storage::SerializedBagMessage>();
+          message->topic_name = "topic";
+          message->time_stamp = next_time_stamp_++;
+          return message;
+        }));
+    EXPECT_CALL(*storage_, seek(_)).WillRepeatedly(
+      Invoke(
+        [this](const rcutils_time_point_value_t & timestamp) {
+          next_time_stamp_ = timestamp;
+        }));
+    // The index of the next message tells apart messages with the same time
+    EXPECT_CALL(*storage_, get_read_position()).WillRepeatedly(
+      Invoke(
+        [this]() -> rosbag2_storage::ReadPosition {
+          return {next_time_stamp_, next_time_stamp_};
+        }));
+    EXPECT_CALL(*storage_, set_read_position(_)).WillRepeatedly(
+      Invoke(
+        [this](const rosbag2_storage::ReadPosition & read_position) {
+          next_time_stamp_ = read_position.sequence;
+        }));
+    default_storage_options_.read_ahead_queue_size = 10;
+  }
+
+  std::vector<rcutils_time_point_value_t> read_time_stamps(size_t max_count = 100)
+  {
+    std::vector<rcutils_time_point_value_t> time_stamps;
+    while (time_stamps.size() < max_count && reader_->has_next()) {
+      time_stamps.push_back(reader_->read_next()->time_stamp);
+    }
+    return time_stamps;
+  }
+
+  std::vector<rcutils_time_point_value_t> time_stamps_from(rcutils_time_point_value_t first)
+  {
+    std::vector<rcutils_time_point_value_t> time_stamps;
+    for (auto time_stamp = first; time_stamp < 100; ++time_stamp) {
+      time_stamps.push_back(time_stamp);
+    }
+    return time_stamps;
+  }
+
+  // Only accessed by the read-ahead thread, or while it is stopped
+  rcutils_time_point_value_t next_time_stamp_ = 0;
+};
+
+TEST_F(SequentialReaderReadAheadTest, read_ahead_returns_all_messages_in_order) {
+  reader_->open(default_storage_options_, {"", storage_serialization_format_});
+
+  EXPECT_THAT(read_time_stamps(), ElementsAreArray(time_stamps_from(0)));
+  EXPECT_FALSE(reader_->has_next());
+  EXPECT_ANY_THROW(reader_->read_next());
+}
+
+TEST_F(SequentialReaderReadAheadTest, seek_drops_the_messages_read_ahead) {
+  reader_->open(default_storage_options_, {"", storage_serialization_format_});
+  EXPECT_THAT(read_time_stamps(5), ElementsAre(0, 1, 2, 3, 4));
+
+  reader_->seek(50);
+  EXPECT_THAT(read_time_stamps(), ElementsAreArray(time_stamps_from(50)));
+}
+
+TEST_F(SequentialReaderReadAheadTest, set_filter_continues_with_the_next_message) {
+  reader_->open(default_storage_options_, {"", storage_serialization_format_});
+  EXPECT_THAT(read_time_stamps(5), ElementsAre(0, 1, 2, 3, 4));
+
+  rosbag2_storage::StorageFilter storage_filter;
+  storage_filter.topics.push_back("topic");
+  reader_->set_filter(storage_filter);
+  EXPECT_THAT(read_time_stamps(), ElementsAreArray(time_stamps_from(5)));
+}
+
+TEST_F(SequentialReaderReadAheadTest, set_filter_does_not_repeat_messages_with_the_same_time) {
+  // All the messages have the same time, their topic names tell them apart
+  EXPECT_CALL(*storage_, read_next()).WillRepeatedly(
+    Invoke(
+      [this]() {
+        auto message = std::make_shared<rosbag2_storage::SerializedBagMessage>();
+        message->topic_name = "topic" + std::to_string(next_time_stamp_++);
+        message->time_stamp = 0;
+        return message;
+      }));
+  EXPECT_CALL(*storage_, seek(_)).Times(0);
+  reader_->open(default_storage_options_, {"", storage_serialization_format_});
+  for (int i = 0; i < 5; ++i) {
+    ASSERT_TRUE(reader_->has_next());
+    EXPECT_THAT(reader_->read_next()->topic_name, Eq("topic" + std::to_string(i)));
+  }
+
+  reader_->reset_filter();
+  for (int i = 5; i < 100; ++i) {
+    ASSERT_TRUE(reader_->has_next());
+    EXPECT_THAT(reader_->read_next()->topic_name, Eq("topic" + std::to_string(i)));
+  }
+  EXPECT_FALSE(reader_->has_next());
+}
+
+TEST_F(SequentialReaderReadAheadTest, read_ahead_errors_are_reported_by_the_reader) {
+  EXPECT_CALL(*storage_, read_next()).WillRepeatedly(
+    Invoke(
+      []() -> std::shared_ptr<rosbag2_storage::SerializedBagMessage> {
+        throw std::runtime_error("corrupted file");
+      }));
+  reader_->open(default_storage_options_, {"", storage_serialization_format_});
+
+  EXPECT_THROW(reader_->has_next(), std::runtime_error);
+  EXPECT_FALSE(reader_->has_next());
+}
@@ -301,3 +301,100 @@ TEST_F(SequentialWriterTest, do_not_use_cache_if_cache_size_is_zero) {
     writer_->write(message);
   }
 }
+
+TEST_F(SequentialWriterTest, writer_converts_messages_on_conversion_threads) {
+  const size_t counter = 100;
+  std::string storage_serialization_format = "rmw1_format";
+  std::string input_format = "rmw2_format";
+
+  auto format1_converter = std::make_unique<StrictMock<MockConverter>>();
+  auto format2_converter = std::make_unique<StrictMock<MockConverter>>();
+  EXPECT_CALL(*format1_converter, serialize(_, _, _)).Times(counter);
+  EXPECT_CALL(*format2_converter, deserialize(_, _, _)).Times(counter);
+  EXPECT_CALL(*converter_factory_, load_serializer(storage_serialization_format))
+  .WillOnce(Return(ByMove(std::move(format1_converter))));
+  EXPECT_CALL(*converter_factory_, load_deserializer(input_format))
+  .WillOnce(Return(ByMove(std::move(format2_converter))));
+
+  size_t written = 0;
+  ON_CALL(
+    *storage_,
+    write(An<const std::vector<std::shared_ptr<const rosbag2_storage::SerializedBagMessage>> &>())).
+  WillByDefault(
+    Invoke(
+      [&written](
+        const std::vector<std::shared_ptr<const rosbag2_storage::SerializedBagMessage>> & msgs) {
+        written += msgs.size();
+      }));
+
+  auto sequential_writer = std::make_unique<rosbag2_cpp::writers::SequentialWriter>(
+    std::move(storage_factory_), converter_factory_, std::move(metadata_io_));
+  auto sequential_writer_ptr = sequential_writer.get();
+  writer_ = std::make_unique<rosbag2_cpp::Writer>(std::move(sequential_writer));
+
+  storage_options_.max_cache_size = 1000000;
+  rosbag2_cpp::ConverterOptions converter_options{input_format, storage_serialization_format};
+  converter_options.conversion_threads = 2;
+  converter_options.conversion_queue_size = 4;
+  writer_->open(storage_options_, converter_options);
+  writer_->create_topic({"test_topic", "test_msgs/BasicTypes", "", ""});
+
+  for (auto i = 0u; i < counter; ++i) {
+    auto message = std::make_shared<rosbag2_storage::SerializedBagMessage>();
+    message->topic_name = "test_topic";
+    writer_->write(message);
+  }
+
+  auto statistics = sequential_writer_ptr->get_pipeline_statistics();
+  ASSERT_THAT(statistics, SizeIs(2u));
+  EXPECT_THAT(statistics[0].stage_name, Eq("conversion"));
+  EXPECT_THAT(statistics[0].max_queue_depth, Le(2u * 4u));
+  EXPECT_THAT(statistics[0].messages_dropped_per_topic, IsEmpty());
+  EXPECT_THAT(statistics[1].stage_name, Eq("cache"));
+  EXPECT_THAT(statistics[1].messages_dropped_per_topic, IsEmpty());
+
+  writer_.reset();
+  EXPECT_THAT(written, Eq(counter));
+}
+
+TEST_F(SequentialWriterTest, writer_without_conversion_has_no_conversion_stage) {
+  const size_t counter = 100;
+  std::string rmw_format = "rmw_format";
+
+  size_t written = 0;
+  ON_CALL(
+    *storage_,
+    write(An<const std::vector<std::shared_ptr<const rosbag2_storage::SerializedBagMessage>> &>())).
+  WillByDefault(
+    Invoke(
+      [&written](
+        const std::vector<std::shared_ptr<const rosbag2_storage::SerializedBagMessage>> & msgs) {
+        written += msgs.size();
+      }));
+
+  auto sequential_writer = std::make_unique<rosbag2_cpp::writers::SequentialWriter>(
+    std::move(storage_factory_), converter_factory_, std::move(metadata_io_));
+  auto sequential_writer_ptr = sequential_writer.get();
+  writer_ = std::make_unique<rosbag2_cpp::Writer>(std::move(sequential_writer));
+
+  // Messages which need no conversion go straight into the cache, even with conversion threads.
+  storage_options_.max_cache_size = 1000000;
+  rosbag2_cpp::ConverterOptions converter_options{rmw_format, rmw_format};
+  converter_options.conversion_threads = 2;
+  writer_->open(storage_options_, converter_options);
+  writer_->create_topic({"test_topic", "test_msgs/BasicTypes", "", ""});
+
+  for (auto i = 0u; i < counter; ++i) {
+    auto message = std::make_shared<rosbag2_storage::SerializedBagMessage>();
+    message->topic_name = "test_topic";
+    writer_->write(message);
+  }
+
+  auto statistics = sequential_writer_ptr->get_pipeline_statistics();
+  ASSERT_THAT(statistics, SizeIs(1u));
+  EXPECT_THAT(statistics[0].stage_name, Eq("cache"));
+  EXPECT_THAT(statistics[0].messages_dropped_per_topic, IsEmpty());
+
+  writer_.reset();
+  EXPECT_THAT(written, Eq(counter));
+}
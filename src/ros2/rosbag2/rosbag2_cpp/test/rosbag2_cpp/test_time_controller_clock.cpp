@@ -258,3 +258,31 @@ TEST_F(TimeControllerClockTest, jump)
   return_time += std::chrono::seconds(2);
   EXPECT_EQ(clock.now(), RCUTILS_S_TO_NS(52));
 }
+
+TEST_F(TimeControllerClockTest, spin_wait_sleep_returns_true_at_the_time)
+{
+  rosbag2_cpp::TimeControllerClock clock(
+    ros_start_time, std::chrono::steady_clock::now, std::chrono::milliseconds{100},
+    std::chrono::milliseconds{2});
+  const auto until = clock.now() + RCUTILS_MS_TO_NS(20);
+  EXPECT_TRUE(clock.sleep_until(until));
+  EXPECT_GE(clock.now(), until);
+}
+
+TEST_F(TimeControllerClockTest, spin_wait_is_interrupted_by_pause)
+{
+  // Busy waits for the whole sleep, so that the pause happens while spinning
+  rosbag2_cpp::TimeControllerClock clock(
+    ros_start_time, std::chrono::steady_clock::now, std::chrono::milliseconds{100},
+    std::chrono::seconds{100});
+  std::atomic_bool thread_sleep_result{true};
+  auto sleep_long_thread = std::thread(
+    [&clock, &thread_sleep_result]() {
+      bool sleep_result = clock.sleep_until(clock.now() + RCUTILS_S_TO_NS(10));
+      thread_sleep_result.store(sleep_result);
+    });
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  clock.pause();
+  sleep_long_thread.join();
+  EXPECT_FALSE(thread_sleep_result);
+}
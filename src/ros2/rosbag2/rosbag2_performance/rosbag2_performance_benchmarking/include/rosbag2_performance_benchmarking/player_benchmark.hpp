@@ -0,0 +1,55 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROSBAG2_PERFORMANCE_BENCHMARKING__PLAYER_BENCHMARK_HPP_
+#define ROSBAG2_PERFORMANCE_BENCHMARKING__PLAYER_BENCHMARK_HPP_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "rclcpp/rclcpp.hpp"
+#include "rosbag2_transport/play_options.hpp"
+
+#include "rosbag2_performance_benchmarking/bag_config.hpp"
+#include "rosbag2_performance_benchmarking/publisher_group_config.hpp"
+
+/// Measures how fast the Player can publish a bag shaped like the configured publishers.
+/**
+ * A bag with the messages of the publisher groups is written first, then played back as fast
+ * as the playback rate allows.
+ */
+class PlayerBenchmark : public rclcpp::Node
+{
+public:
+  explicit PlayerBenchmark(const std::string & name);
+  void start_benchmark();
+
+private:
+  // Returns false if the bag could not be written
+  bool write_bag();
+  void write_results(double elapsed_seconds) const;
+
+  std::vector<PublisherGroupConfig> configurations_;
+  BagConfig bag_config_;
+  rosbag2_transport::PlayOptions play_options_;
+  std::string results_file_;
+
+  uint64_t message_count_ = 0;
+  uint64_t bytes_count_ = 0;
+  // Time between the first and the last message of the bag
+  double bag_duration_seconds_ = 0.0;
+};
+
+#endif  // ROSBAG2_PERFORMANCE_BENCHMARKING__PLAYER_BENCHMARK_HPP_
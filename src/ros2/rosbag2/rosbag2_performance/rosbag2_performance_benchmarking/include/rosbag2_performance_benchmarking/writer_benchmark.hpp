@@ -39,6 +39,7 @@ private:
   void create_producers();
   void create_writer();
   void start_producers();
+  void log_pipeline_statistics() const;
   void write_results() const;
   int get_message_count_from_metadata() const;
 
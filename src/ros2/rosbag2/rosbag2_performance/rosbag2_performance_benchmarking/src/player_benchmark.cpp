@@ -0,0 +1,186 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "rclcpp/serialization.hpp"
+#include "rclcpp/serialized_message.hpp"
+#include "rmw/rmw.h"
+#include "rosbag2_cpp/writers/sequential_writer.hpp"
+#include "rosbag2_storage/ros_helper.hpp"
+#include "rosbag2_storage/serialized_bag_message.hpp"
+#include "rosbag2_transport/player.hpp"
+#include "std_msgs/msg/byte_multi_array.hpp"
+
+#include "rosbag2_performance_benchmarking/config_utils.hpp"
+#include "rosbag2_performance_benchmarking/player_benchmark.hpp"
+
+PlayerBenchmark::PlayerBenchmark(const std::string & name)
+: rclcpp::Node(name)
+{
+  RCLCPP_INFO(get_logger(), "PlayerBenchmark parsing configurations");
+  configurations_ = config_utils::publisher_groups_from_node_parameters(*this);
+  if (configurations_.empty()) {
+    RCLCPP_ERROR(get_logger(), "No publishers/producers found in node parameters");
+    return;
+  }
+
+  bag_config_ = config_utils::bag_config_from_node_parameters(*this);
+  if (!bag_config_.compression_format.empty()) {
+    RCLCPP_WARN(get_logger(), "Compression is ignored when benchmarking playback");
+  }
+
+  int publish_threads = 0;
+  int max_publish_skew_ms = 100;
+  this->declare_parameter("publish_threads", publish_threads);
+  this->declare_parameter("playback_rate", static_cast<double>(play_options_.rate));
+  this->declare_parameter("max_publish_skew_ms", max_publish_skew_ms);
+  this->declare_parameter(
+    "results_file", bag_config_.storage_options.uri + "/playback_results.csv");
+  double playback_rate = play_options_.rate;
+  this->get_parameter("publish_threads", publish_threads);
+  this->get_parameter("playback_rate", playback_rate);
+  this->get_parameter("max_publish_skew_ms", max_publish_skew_ms);
+  this->get_parameter("results_file", results_file_);
+  play_options_.publish_threads = static_cast<size_t>(std::max(publish_threads, 0));
+  play_options_.rate = static_cast<float>(playback_rate);
+  play_options_.max_publish_skew = std::chrono::milliseconds(max_publish_skew_ms);
+
+  RCLCPP_INFO(get_logger(), "configuration parameters processed");
+}
+
+void PlayerBenchmark::start_benchmark()
+{
+  if (configurations_.empty() || !write_bag()) {
+    return;
+  }
+
+  RCLCPP_INFO_STREAM(
+    get_logger(), "Starting the PlayerBenchmark with " << play_options_.publish_threads <<
+      " publish threads at rate " << play_options_.rate);
+  auto player = std::make_shared<rosbag2_transport::Player>(
+    bag_config_.storage_options, play_options_, "rosbag2_player_benchmark");
+  const auto start_time = std::chrono::steady_clock::now();
+  player->play();
+  const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time);
+
+  RCLCPP_INFO_STREAM(
+    get_logger(), "Played " << message_count_ << " messages, " << bytes_count_ / 1000000.0 <<
+      " MB in " << elapsed.count() << " s: " << bytes_count_ / 1000000.0 / elapsed.count() <<
+      " MB/s, " << bag_duration_seconds_ / elapsed.count() << " times real time");
+  write_results(elapsed.count());
+}
+
+bool PlayerBenchmark::write_bag()
+{
+  RCLCPP_INFO_STREAM(
+    get_logger(), "Writing the bag to play to " << bag_config_.storage_options.uri);
+  const std::string serialization_format = rmw_get_serialization_format();
+  rosbag2_cpp::writers::SequentialWriter writer;
+  try {
+    writer.open(bag_config_.storage_options, {serialization_format, serialization_format});
+  } catch (const std::runtime_error & e) {
+    RCLCPP_ERROR_STREAM(get_logger(), "Failed to open the bag for writing: " << e.what());
+    return false;
+  }
+
+  // All messages of a topic share the same serialized data
+  std::vector<std::pair<std::string, std::shared_ptr<rcutils_uint8_array_t>>> topics;
+  // Time stamp and topic index of every message, written in time order like a recording
+  std::vector<std::pair<rcutils_time_point_value_t, size_t>> messages;
+  rclcpp::Serialization<std_msgs::msg::ByteMultiArray> serialization;
+  for (const auto & c : configurations_) {
+    std_msgs::msg::ByteMultiArray message;
+    message.data.resize(c.producer_config.message_size);
+    rclcpp::SerializedMessage serialized_message;
+    serialization.serialize_message(&message, &serialized_message);
+    const auto & rcl_message = serialized_message.get_rcl_serialized_message();
+    auto serialized_data = rosbag2_storage::make_serialized_message(
+      rcl_message.buffer, rcl_message.buffer_length);
+
+    const auto period = RCUTILS_S_TO_NS(1) / c.producer_config.frequency;
+    for (unsigned int i = 0; i < c.count; ++i) {
+      rosbag2_storage::TopicMetadata topic;
+      topic.name = c.topic_root + std::to_string(i);
+      topic.type = "std_msgs/msg/ByteMultiArray";
+      topic.serialization_format = serialization_format;
+      writer.create_topic(topic);
+      for (unsigned int j = 0; j < c.producer_config.max_count; ++j) {
+        messages.emplace_back(RCUTILS_S_TO_NS(1) + j * period, topics.size());
+      }
+      topics.emplace_back(topic.name, serialized_data);
+    }
+  }
+  std::sort(messages.begin(), messages.end());
+
+  for (const auto & time_and_topic : messages) {
+    auto message = std::make_shared<rosbag2_storage::SerializedBagMessage>();
+    message->time_stamp = time_and_topic.first;
+    message->topic_name = topics[time_and_topic.second].first;
+    message->serialized_data = topics[time_and_topic.second].second;
+    writer.write(message);
+    bytes_count_ += message->serialized_data->buffer_length;
+  }
+  writer.reset();
+
+  message_count_ = messages.size();
+  if (!messages.empty()) {
+    bag_duration_seconds_ =
+      static_cast<double>(messages.back().first - messages.front().first) / RCUTILS_S_TO_NS(1);
+  }
+  return true;
+}
+
+void PlayerBenchmark::write_results(double elapsed_seconds) const
+{
+  bool new_file = false;
+  {  // test if file exists - we want to write a csv header after creation if not
+    std::ifstream test_existence(results_file_);
+    if (!test_existence) {
+      new_file = true;
+    }
+  }
+
+  // append, we want to accumulate results from multiple runs
+  std::ofstream output_file(results_file_, std::ios_base::app);
+  if (new_file) {
+    output_file << "publish_threads playback_rate message_count megabytes elapsed_s " <<
+      "throughput_mbs realtime_factor" << std::endl;
+  }
+  output_file << play_options_.publish_threads << " ";
+  output_file << play_options_.rate << " ";
+  output_file << message_count_ << " ";
+  output_file << bytes_count_ / 1000000.0 << " ";
+  output_file << elapsed_seconds << " ";
+  output_file << bytes_count_ / 1000000.0 / elapsed_seconds << " ";
+  output_file << bag_duration_seconds_ / elapsed_seconds << std::endl;
+}
+
+int main(int argc, char * argv[])
+{
+  rclcpp::init(argc, argv);
+  auto bench = std::make_shared<PlayerBenchmark>("rosbag2_performance_benchmarking_node");
+  bench->start_benchmark();
+  RCLCPP_INFO(bench->get_logger(), "Benchmark terminated");
+  rclcpp::shutdown();
+  return 0;
+}
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <chrono>
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -58,6 +59,8 @@ WriterBenchmark::WriterBenchmark(const std::string & name)
 void WriterBenchmark::start_benchmark()
 {
   RCLCPP_INFO(get_logger(), "Starting the WriterBenchmark");
+  const auto start_time = std::chrono::steady_clock::now();
+  uint64_t bytes_written = 0;
   start_producers();
   while (rclcpp::ok()) {
     int count = 0;
@@ -105,6 +108,7 @@ void WriterBenchmark::start_benchmark()
           });
 
         serialized_data->buffer_length = byte_ma_message->data.size();
+        bytes_written += serialized_data->buffer_length;
 
         message->serialized_data = serialized_data;
 
@@ -136,11 +140,35 @@ void WriterBenchmark::start_benchmark()
   for (auto & prod_thread : producer_threads_) {
     prod_thread.join();
   }
+  log_pipeline_statistics();
+  // Closing the writer waits for the queued messages to be compressed and stored
   writer_->reset();
+  const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time);
+  RCLCPP_INFO_STREAM(
+    get_logger(), "Passed " << bytes_written / 1000000.0 << " MB to the writer in " <<
+      elapsed.count() << " s: " << bytes_written / 1000000.0 / elapsed.count() << " MB/s");
 
   result_utils::write_benchmark_results(configurations_, bag_config_, results_file_);
 }
 
+void WriterBenchmark::log_pipeline_statistics() const
+{
+  uint64_t total_dropped = 0;
+  for (const auto & stage : writer_->get_pipeline_statistics()) {
+    uint64_t stage_dropped = 0;
+    for (const auto & topic_dropped : stage.messages_dropped_per_topic) {
+      stage_dropped += topic_dropped.second;
+    }
+    total_dropped += stage_dropped;
+    RCLCPP_INFO_STREAM(
+      get_logger(), "Writer stage " << stage.stage_name <<
+        ": processed " << stage.messages_processed <<
+        ", dropped " << stage_dropped <<
+        ", max queue depth " << stage.max_queue_depth);
+  }
+  RCLCPP_INFO_STREAM(get_logger(), "Messages dropped by the writer: " << total_dropped);
+}
+
 void WriterBenchmark::create_producers()
 {
   RCLCPP_INFO_STREAM(get_logger(), "creating producers");
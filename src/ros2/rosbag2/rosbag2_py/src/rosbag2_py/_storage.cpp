@@ -30,27 +30,37 @@ PYBIND11_MODULE(_storage, m) {
 
   pybind11::class_<rosbag2_cpp::ConverterOptions>(m, "ConverterOptions")
   .def(
-    pybind11::init<std::string, std::string>(),
+    pybind11::init<std::string, std::string, uint64_t, uint64_t>(),
     pybind11::arg("input_serialization_format"),
-    pybind11::arg("output_serialization_format"))
+    pybind11::arg("output_serialization_format"),
+    pybind11::arg("conversion_threads") = 0,
+    pybind11::arg("conversion_queue_size") = 100)
   .def_readwrite(
     "input_serialization_format",
     &rosbag2_cpp::ConverterOptions::input_serialization_format)
   .def_readwrite(
     "output_serialization_format",
-    &rosbag2_cpp::ConverterOptions::output_serialization_format);
+    &rosbag2_cpp::ConverterOptions::output_serialization_format)
+  .def_readwrite(
+    "conversion_threads",
+    &rosbag2_cpp::ConverterOptions::conversion_threads)
+  .def_readwrite(
+    "conversion_queue_size",
+    &rosbag2_cpp::ConverterOptions::conversion_queue_size);
 
   pybind11::class_<rosbag2_storage::StorageOptions>(m, "StorageOptions")
   .def(
     pybind11::init<
-      std::string, std::string, uint64_t, uint64_t, uint64_t, std::string, std::string>(),
+      std::string, std::string, uint64_t, uint64_t, uint64_t, std::string, std::string,
+      uint64_t>(),
     pybind11::arg("uri"),
     pybind11::arg("storage_id"),
     pybind11::arg("max_bagfile_size") = 0,
     pybind11::arg("max_bagfile_duration") = 0,
     pybind11::arg("max_cache_size") = 0,
     pybind11::arg("storage_preset_profile") = "",
-    pybind11::arg("storage_config_uri") = "")
+    pybind11::arg("storage_config_uri") = "",
+    pybind11::arg("read_ahead_queue_size") = 0)
   .def_readwrite("uri", &rosbag2_storage::StorageOptions::uri)
   .def_readwrite("storage_id", &rosbag2_storage::StorageOptions::storage_id)
   .def_readwrite(
@@ -67,7 +77,10 @@ PYBIND11_MODULE(_storage, m) {
     &rosbag2_storage::StorageOptions::storage_preset_profile)
   .def_readwrite(
     "storage_config_uri",
-    &rosbag2_storage::StorageOptions::storage_config_uri);
+    &rosbag2_storage::StorageOptions::storage_config_uri)
+  .def_readwrite(
+    "read_ahead_queue_size",
+    &rosbag2_storage::StorageOptions::read_ahead_queue_size);
 
   pybind11::class_<rosbag2_storage::StorageFilter>(m, "StorageFilter")
   .def(
@@ -220,6 +220,12 @@ PYBIND11_MODULE(_transport, m) {
   .def_readwrite("loop", &PlayOptions::loop)
   .def_readwrite("topic_remapping_options", &PlayOptions::topic_remapping_options)
   .def_readwrite("clock_publish_frequency", &PlayOptions::clock_publish_frequency)
+  .def_readwrite("spin_wait_threshold", &PlayOptions::spin_wait_threshold)
+  .def_readwrite("publish_batch_window", &PlayOptions::publish_batch_window)
+  .def_readwrite("publish_thread_cpu", &PlayOptions::publish_thread_cpu)
+  .def_readwrite("report_timing_statistics", &PlayOptions::report_timing_statistics)
+  .def_readwrite("publish_threads", &PlayOptions::publish_threads)
+  .def_readwrite("max_publish_skew", &PlayOptions::max_publish_skew)
   ;
 
   py::class_<RecordOptions>(m, "RecordOptions")
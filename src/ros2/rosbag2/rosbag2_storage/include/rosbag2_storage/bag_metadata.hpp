@@ -31,9 +31,18 @@ struct TopicInformation
   size_t message_count;
 };
 
+/// Time range of the messages in one of the files of a bag, used to find the file to seek in.
+struct FileInformation
+{
+  std::string path;
+  std::chrono::time_point<std::chrono::high_resolution_clock> starting_time;
+  std::chrono::nanoseconds duration;
+  size_t message_count;
+};
+
 struct BagMetadata
 {
-  int version = 4;  // upgrade this number when changing the content of the struct
+  int version = 5;  // upgrade this number when changing the content of the struct
   uint64_t bag_size = 0;  // Will not be serialized
   std::string storage_identifier;
   std::vector<std::string> relative_file_paths;
@@ -43,6 +52,7 @@ struct BagMetadata
   std::vector<TopicInformation> topics_with_message_count;
   std::string compression_format;
   std::string compression_mode;
+  std::vector<FileInformation> files;  // in the order of relative_file_paths
 };
 
 }  // namespace rosbag2_storage
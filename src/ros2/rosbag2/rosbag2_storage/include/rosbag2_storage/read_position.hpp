@@ -0,0 +1,36 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROSBAG2_STORAGE__READ_POSITION_HPP_
+#define ROSBAG2_STORAGE__READ_POSITION_HPP_
+
+#include <cstdint>
+
+#include "rcutils/time.h"
+
+namespace rosbag2_storage
+{
+
+struct ReadPosition
+{
+  // Reading continues with the first message at or after this time.
+  rcutils_time_point_value_t time_stamp = INT64_MIN;
+  // Orders the messages with the same time, only meaningful to the storage which returned it,
+  // e.g. a row id. Messages at time_stamp before this are skipped.
+  int64_t sequence = 0;
+};
+
+}  // namespace rosbag2_storage
+
+#endif  // ROSBAG2_STORAGE__READ_POSITION_HPP_
@@ -17,6 +17,9 @@
 
 #include <string>
 
+#include "rcutils/time.h"
+
+#include "rosbag2_storage/read_position.hpp"
 #include "rosbag2_storage/storage_filter.hpp"
 #include "rosbag2_storage/storage_interfaces/base_info_interface.hpp"
 #include "rosbag2_storage/storage_interfaces/base_io_interface.hpp"
@@ -45,6 +48,31 @@ public:
   virtual void set_filter(const StorageFilter & storage_filter) = 0;
 
   virtual void reset_filter() = 0;
+
+  /**
+   * Continue reading with the first message at or after the given time.
+   * Seeking backwards is allowed. The filter stays in effect.
+   *
+   * \param timestamp to continue reading from
+   */
+  virtual void seek(const rcutils_time_point_value_t & timestamp) = 0;
+
+  /**
+   * Get the position of the next message to read, to come back to it with set_read_position().
+   * Unlike the time of a message, the position tells apart messages with the same time.
+   *
+   * \return the position after the last message read, or of the last seek
+   */
+  virtual ReadPosition get_read_position() const = 0;
+
+  /**
+   * Continue reading with the first message at or after a position from get_read_position().
+   * The filter stays in effect, so this also reads again the messages of topics which have
+   * been selected since the position was taken.
+   *
+   * \param read_position to continue reading from
+   */
+  virtual void set_read_position(const ReadPosition & read_position) = 0;
 };
 
 }  // namespace storage_interfaces
@@ -46,6 +46,11 @@ public:
   // Storage specific configuration file.
   // Defaults to empty string.
   std::string storage_config_uri = "";
+
+  // The number of messages which a reader reads ahead in a background thread,
+  // including their decompression and conversion.
+  // A value of 0 disables reading ahead and every read happens on the calling thread.
+  uint64_t read_ahead_queue_size = 0;
 };
 
 }  // namespace rosbag2_storage
@@ -171,6 +171,30 @@ struct convert<std::chrono::time_point<std::chrono::high_resolution_clock>>
   }
 };
 
+template<>
+struct convert<rosbag2_storage::FileInformation>
+{
+  static Node encode(const rosbag2_storage::FileInformation & metadata)
+  {
+    Node node;
+    node["path"] = metadata.path;
+    node["starting_time"] = metadata.starting_time;
+    node["duration"] = metadata.duration;
+    node["message_count"] = metadata.message_count;
+    return node;
+  }
+
+  static bool decode(const Node & node, rosbag2_storage::FileInformation & metadata)
+  {
+    metadata.path = node["path"].as<std::string>();
+    metadata.starting_time = node["starting_time"]
+      .as<std::chrono::time_point<std::chrono::high_resolution_clock>>();
+    metadata.duration = node["duration"].as<std::chrono::nanoseconds>();
+    metadata.message_count = node["message_count"].as<uint64_t>();
+    return true;
+  }
+};
+
 template<>
 struct convert<rosbag2_storage::BagMetadata>
 {
@@ -189,6 +213,9 @@ struct convert<rosbag2_storage::BagMetadata>
       node["compression_format"] = metadata.compression_format;
       node["compression_mode"] = metadata.compression_mode;
     }
+    if (metadata.version >= 5) {  // per-file time index for seeking
+      node["files"] = metadata.files;
+    }
     return node;
   }
 
@@ -209,6 +236,9 @@ struct convert<rosbag2_storage::BagMetadata>
       metadata.compression_format = node["compression_format"].as<std::string>();
       metadata.compression_mode = node["compression_mode"].as<std::string>();
     }
+    if (metadata.version >= 5) {  // per-file time index for seeking
+      metadata.files = node["files"].as<std::vector<rosbag2_storage::FileInformation>>();
+    }
     return true;
   }
 };
@@ -132,3 +132,30 @@ TEST_F(MetadataFixture, metadata_reads_v4_fills_offered_qos_profiles)
   auto actual_first_topic = read_metadata.topics_with_message_count[0];
   EXPECT_THAT(actual_first_topic.topic_metadata.offered_qos_profiles, Eq(offered_qos_profiles));
 }
+
+TEST_F(MetadataFixture, metadata_reads_v5_fills_files)
+{
+  BagMetadata metadata{};
+  metadata.version = 5;
+  metadata.relative_file_paths = {"bag_0.db3", "bag_1.db3"};
+  metadata.files.push_back(
+    {"bag_0.db3",
+      std::chrono::time_point<std::chrono::high_resolution_clock>(std::chrono::nanoseconds(1000)),
+      std::chrono::nanoseconds(500), 10});
+  metadata.files.push_back(
+    {"bag_1.db3",
+      std::chrono::time_point<std::chrono::high_resolution_clock>(std::chrono::nanoseconds(1600)),
+      std::chrono::nanoseconds(300), 20});
+  metadata_io_->write_metadata(temporary_dir_path_, metadata);
+  auto read_metadata = metadata_io_->read_metadata(temporary_dir_path_);
+  ASSERT_THAT(read_metadata.files, SizeIs(2));
+  EXPECT_THAT(read_metadata.files[1].path, Eq("bag_1.db3"));
+  EXPECT_THAT(read_metadata.files[1].starting_time, Eq(metadata.files[1].starting_time));
+  EXPECT_THAT(read_metadata.files[1].duration, Eq(metadata.files[1].duration));
+  EXPECT_THAT(read_metadata.files[1].message_count, Eq(20u));
+
+  // Older versions do not have the index
+  metadata.version = 4;
+  metadata_io_->write_metadata(temporary_dir_path_, metadata);
+  EXPECT_THAT(metadata_io_->read_metadata(temporary_dir_path_).files, IsEmpty());
+}
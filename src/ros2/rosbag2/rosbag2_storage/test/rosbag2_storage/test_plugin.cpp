@@ -124,4 +124,19 @@ void TestPlugin::reset_filter()
   std::cout << "\nresetting storage filter\n";
 }
 
+void TestPlugin::seek(const rcutils_time_point_value_t & /*timestamp*/)
+{
+  std::cout << "\nseeking\n";
+}
+
+rosbag2_storage::ReadPosition TestPlugin::get_read_position() const
+{
+  return {};
+}
+
+void TestPlugin::set_read_position(const rosbag2_storage::ReadPosition & /*read_position*/)
+{
+  std::cout << "\nsetting read position\n";
+}
+
 PLUGINLIB_EXPORT_CLASS(TestPlugin, rosbag2_storage::storage_interfaces::ReadWriteInterface)
@@ -61,6 +61,12 @@ public:
   void set_filter(const rosbag2_storage::StorageFilter & storage_filter) override;
 
   void reset_filter() override;
+
+  void seek(const rcutils_time_point_value_t & timestamp) override;
+
+  rosbag2_storage::ReadPosition get_read_position() const override;
+
+  void set_read_position(const rosbag2_storage::ReadPosition & read_position) override;
 };
 
 #endif  // ROSBAG2_STORAGE__TEST_PLUGIN_HPP_
@@ -92,4 +92,19 @@ void TestReadOnlyPlugin::reset_filter()
   std::cout << "\nresetting storage filter\n";
 }
 
+void TestReadOnlyPlugin::seek(const rcutils_time_point_value_t & /*timestamp*/)
+{
+  std::cout << "\nseeking\n";
+}
+
+rosbag2_storage::ReadPosition TestReadOnlyPlugin::get_read_position() const
+{
+  return {};
+}
+
+void TestReadOnlyPlugin::set_read_position(const rosbag2_storage::ReadPosition & /*read_position*/)
+{
+  std::cout << "\nsetting read position\n";
+}
+
 PLUGINLIB_EXPORT_CLASS(TestReadOnlyPlugin, rosbag2_storage::storage_interfaces::ReadOnlyInterface)
@@ -0,0 +1,110 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROSBAG2_STORAGE_DEFAULT_PLUGINS__CHUNKED__CHUNK_FORMAT_HPP_
+#define ROSBAG2_STORAGE_DEFAULT_PLUGINS__CHUNKED__CHUNK_FORMAT_HPP_
+
+#include <cstdint>
+
+// On-disk layout of the chunked storage plugin.
+//
+// A bag file is a sequence of chunks, each written with a single call once it is complete.
+// Chunks are CHUNK_ALIGNMENT aligned and usually all have the configured chunk size, only a
+// message which does not fit into an empty chunk gets a larger chunk of its own.
+// All values are stored in the byte order of the recording machine.
+//
+// Layout of a chunk:
+//   ChunkHeader
+//   message data, the serialized messages in the order they were written
+//   padding to 8 bytes
+//   MessageIndexEntry[message_count], sorted by time stamp
+//   TopicIndexEntry[topic_index_count], one per topic with messages in the chunk
+//   topic records, the topics created or removed since the previous chunk
+//   padding to chunk_size
+//
+// A topic record is a uint32_t topic id, a uint32_t of TopicRecordFlags and the topic name,
+// type, serialization format and offered QoS profiles, each as a uint32_t length followed by
+// the characters.
+
+namespace rosbag2_storage_plugins
+{
+namespace chunked
+{
+
+// "RB2C" when read as little endian
+constexpr uint32_t CHUNK_MAGIC = 0x43324252u;
+constexpr uint16_t CHUNK_FORMAT_VERSION = 1u;
+// Chunk sizes and offsets are multiples of the alignment, as required by direct I/O
+constexpr uint64_t CHUNK_ALIGNMENT = 4096u;
+
+struct ChunkHeader
+{
+  uint32_t magic;
+  uint16_t version;
+  uint16_t reserved;
+  // Size of the whole chunk including padding
+  uint64_t chunk_size;
+  uint64_t data_size;
+  uint32_t message_count;
+  uint32_t topic_index_count;
+  uint32_t topic_record_count;
+  uint32_t reserved2;
+  uint64_t topic_records_size;
+  int64_t start_time;
+  int64_t end_time;
+};
+
+struct MessageIndexEntry
+{
+  int64_t time_stamp;
+  // Offset of the serialized message from the start of the chunk
+  uint64_t offset;
+  uint64_t size;
+  uint32_t topic_id;
+  uint32_t reserved;
+};
+
+struct TopicIndexEntry
+{
+  uint32_t topic_id;
+  uint32_t message_count;
+  int64_t start_time;
+  int64_t end_time;
+};
+
+enum TopicRecordFlags : uint32_t
+{
+  TOPIC_CREATED = 0u,
+  TOPIC_REMOVED = 1u
+};
+
+static_assert(sizeof(ChunkHeader) == 64, "unexpected padding in ChunkHeader");
+static_assert(sizeof(MessageIndexEntry) == 32, "unexpected padding in MessageIndexEntry");
+static_assert(sizeof(TopicIndexEntry) == 24, "unexpected padding in TopicIndexEntry");
+
+// Offset of the message index from the start of a chunk
+inline uint64_t message_index_offset(uint64_t data_size)
+{
+  return (sizeof(ChunkHeader) + data_size + 7u) & ~uint64_t{7u};
+}
+
+inline uint64_t align_chunk_size(uint64_t size)
+{
+  return (size + CHUNK_ALIGNMENT - 1u) & ~(CHUNK_ALIGNMENT - 1u);
+}
+
+}  // namespace chunked
+}  // namespace rosbag2_storage_plugins
+
+#endif  // ROSBAG2_STORAGE_DEFAULT_PLUGINS__CHUNKED__CHUNK_FORMAT_HPP_
@@ -0,0 +1,120 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROSBAG2_STORAGE_DEFAULT_PLUGINS__CHUNKED__CHUNKED_FILE_HPP_
+#define ROSBAG2_STORAGE_DEFAULT_PLUGINS__CHUNKED__CHUNKED_FILE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "rosbag2_storage_default_plugins/visibility_control.hpp"
+
+// This is necessary because of using stl types here. It is completely safe, because
+// a) the member is not accessible from the outside
+// b) there are no inline functions.
+#ifdef _WIN32
+# pragma warning(push)
+# pragma warning(disable:4251)
+#endif
+
+namespace rosbag2_storage_plugins
+{
+namespace chunked
+{
+
+/// Read-only memory mapping of a whole file.
+class ROSBAG2_STORAGE_DEFAULT_PLUGINS_PUBLIC MappedFile
+{
+public:
+  /// Map the file, throws std::runtime_error if it can not be opened or mapped.
+  explicit MappedFile(const std::string & path);
+
+  ~MappedFile();
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile & operator=(const MappedFile &) = delete;
+
+  const uint8_t * data() const
+  {
+    return data_;
+  }
+
+  uint64_t size() const
+  {
+    return size_;
+  }
+
+private:
+  const uint8_t * data_ {nullptr};
+  uint64_t size_ {0};
+#ifdef _WIN32
+  void * file_handle_ {nullptr};
+  void * mapping_handle_ {nullptr};
+#endif
+};
+
+/// File which is only written at its end, in blocks of CHUNK_ALIGNMENT bytes.
+class ROSBAG2_STORAGE_DEFAULT_PLUGINS_PUBLIC ChunkFileWriter
+{
+public:
+  /**
+   * Open the file for writing, throws std::runtime_error on failure.
+   *
+   * \param path of the file
+   * \param create whether to create a new file, an existing file is appended to otherwise
+   * \param direct_io whether to bypass the page cache where supported, writes then need
+   *   buffers and sizes aligned to CHUNK_ALIGNMENT
+   */
+  ChunkFileWriter(const std::string & path, bool create, bool direct_io);
+
+  ~ChunkFileWriter();
+
+  ChunkFileWriter(const ChunkFileWriter &) = delete;
+  ChunkFileWriter & operator=(const ChunkFileWriter &) = delete;
+
+  /// Append the buffer to the file, throws std::runtime_error on failure.
+  void write(const uint8_t * buffer, size_t size);
+
+  /// Cut off anything after the given size, e.g. a chunk which was only partially written.
+  void truncate(uint64_t size);
+
+  /// Flush the written data to the disk.
+  void sync();
+
+  uint64_t size() const
+  {
+    return size_;
+  }
+
+  bool is_direct_io() const
+  {
+    return direct_io_;
+  }
+
+private:
+  int fd_ {-1};
+  uint64_t size_ {0};
+  bool direct_io_ {false};
+  std::string path_;
+};
+
+}  // namespace chunked
+}  // namespace rosbag2_storage_plugins
+
+#ifdef _WIN32
+# pragma warning(pop)
+#endif
+
+#endif  // ROSBAG2_STORAGE_DEFAULT_PLUGINS__CHUNKED__CHUNKED_FILE_HPP_
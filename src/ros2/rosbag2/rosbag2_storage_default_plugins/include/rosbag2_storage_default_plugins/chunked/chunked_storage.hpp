@@ -0,0 +1,234 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROSBAG2_STORAGE_DEFAULT_PLUGINS__CHUNKED__CHUNKED_STORAGE_HPP_
+#define ROSBAG2_STORAGE_DEFAULT_PLUGINS__CHUNKED__CHUNKED_STORAGE_HPP_
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "rcpputils/thread_safety_annotations.hpp"
+#include "rcutils/time.h"
+#include "rosbag2_storage/storage_interfaces/read_write_interface.hpp"
+#include "rosbag2_storage/serialized_bag_message.hpp"
+#include "rosbag2_storage/storage_filter.hpp"
+#include "rosbag2_storage/topic_metadata.hpp"
+#include "rosbag2_storage_default_plugins/chunked/chunk_format.hpp"
+#include "rosbag2_storage_default_plugins/chunked/chunked_file.hpp"
+#include "rosbag2_storage_default_plugins/visibility_control.hpp"
+
+// This is necessary because of using stl types here. It is completely safe, because
+// a) the member is not accessible from the outside
+// b) there are no inline functions.
+#ifdef _WIN32
+# pragma warning(push)
+# pragma warning(disable:4251)
+#endif
+
+namespace rosbag2_storage_plugins
+{
+
+/// Append-only storage writing messages in fixed-size chunks.
+/**
+ * Messages are copied into an in-memory chunk, which is written to the file with a single
+ * call once it is full, together with an index of its messages sorted by time and an index
+ * of its topics (see chunk_format.hpp).
+ * Bags are read through a memory mapping of the file, using the indexes to merge the chunks
+ * in time order and to skip chunks without messages of the selected topics.
+ *
+ * Reading only sees complete chunks, so a bag which was not closed properly loses the
+ * messages of the chunk being filled, but no others.
+ *
+ * The storage config file can set the following keys in its `write` section:
+ *   chunk_size: size of a chunk in bytes, a multiple of 4096 (default 4 MiB)
+ *   direct_io: whether to write chunks bypassing the page cache where supported
+ *
+ * The `resilient` storage preset flushes every chunk to the disk once it is written.
+ */
+class ROSBAG2_STORAGE_DEFAULT_PLUGINS_PUBLIC ChunkedStorage
+  : public rosbag2_storage::storage_interfaces::ReadWriteInterface
+{
+public:
+  ChunkedStorage() = default;
+
+  ~ChunkedStorage() override;
+
+  void open(
+    const rosbag2_storage::StorageOptions & storage_options,
+    rosbag2_storage::storage_interfaces::IOFlag io_flag =
+    rosbag2_storage::storage_interfaces::IOFlag::READ_WRITE) override;
+
+  void remove_topic(const rosbag2_storage::TopicMetadata & topic) override;
+
+  void create_topic(const rosbag2_storage::TopicMetadata & topic) override;
+
+  void write(std::shared_ptr<const rosbag2_storage::SerializedBagMessage> message) override;
+
+  void write(
+    const std::vector<std::shared_ptr<const rosbag2_storage::SerializedBagMessage>> & messages)
+  override;
+
+  bool has_next() override;
+
+  std::shared_ptr<rosbag2_storage::SerializedBagMessage> read_next() override;
+
+  std::vector<rosbag2_storage::TopicMetadata> get_all_topics_and_types() override;
+
+  rosbag2_storage::BagMetadata get_metadata() override;
+
+  std::string get_relative_file_path() const override;
+
+  uint64_t get_bagfile_size() const override;
+
+  std::string get_storage_identifier() const override;
+
+  uint64_t get_minimum_split_file_size() const override;
+
+  void set_filter(const rosbag2_storage::StorageFilter & storage_filter) override;
+
+  void reset_filter() override;
+
+  /// Continue reading with the first message at or after the given time.
+  /**
+   * The chunks ending before the time are skipped using their headers, and the first
+   * message in each remaining chunk is found with a binary search in its time index.
+   *
+   * \param timestamp to continue reading from
+   */
+  void seek(const rcutils_time_point_value_t & timestamp) override;
+
+  /// Get the position of the next message to read.
+  /**
+   * The sequence of the position holds the index of the chunk in the file in its upper 32 bits
+   * and the index of the message in the chunk in its lower 32 bits.
+   */
+  rosbag2_storage::ReadPosition get_read_position() const override;
+
+  void set_read_position(const rosbag2_storage::ReadPosition & read_position) override;
+
+private:
+  struct TopicInfo
+  {
+    rosbag2_storage::TopicMetadata metadata;
+    size_t message_count {0};
+    rcutils_time_point_value_t start_time {INT64_MAX};
+    rcutils_time_point_value_t end_time {INT64_MIN};
+  };
+
+  /// A chunk of the mapped file.
+  struct ChunkView
+  {
+    const uint8_t * data;
+    chunked::ChunkHeader header;
+    const chunked::MessageIndexEntry * messages;
+    const chunked::TopicIndexEntry * topics;
+  };
+
+  /// Position of the reader in a chunk.
+  struct ChunkCursor
+  {
+    rcutils_time_point_value_t time_stamp;
+    size_t chunk;
+    uint32_t position;
+  };
+
+  void write_locked(const rosbag2_storage::SerializedBagMessage & message)
+  RCPPUTILS_TSA_REQUIRES(write_mutex_);
+  // Write the chunk being filled to the file and start a new one
+  void flush_chunk_locked() RCPPUTILS_TSA_REQUIRES(write_mutex_);
+  void start_chunk_locked(uint64_t chunk_size) RCPPUTILS_TSA_REQUIRES(write_mutex_);
+  // Size of the index and topic records of the current chunk with the given number of messages
+  uint64_t chunk_tail_size_locked(uint32_t message_count) const
+  RCPPUTILS_TSA_REQUIRES(write_mutex_);
+  void add_topic_record_locked(uint32_t topic_id, const TopicInfo & topic, uint32_t flags)
+  RCPPUTILS_TSA_REQUIRES(write_mutex_);
+
+  /// Comparison building a min-heap of cursors with the std heap functions.
+  static bool later(const ChunkCursor & lhs, const ChunkCursor & rhs)
+  {
+    if (lhs.time_stamp != rhs.time_stamp) {
+      return lhs.time_stamp > rhs.time_stamp;
+    }
+    if (lhs.chunk != rhs.chunk) {
+      return lhs.chunk > rhs.chunk;
+    }
+    return lhs.position > rhs.position;
+  }
+
+  // Map the file and read the headers and topics of all complete chunks,
+  // returns the size of the complete chunks
+  uint64_t load_chunks();
+  // Returns false if the topic records of the chunk are corrupted
+  bool apply_topic_records_locked(const ChunkView & chunk) RCPPUTILS_TSA_REQUIRES(write_mutex_);
+  void prepare_for_reading();
+  void apply_filter();
+  bool is_chunk_selected(const ChunkView & chunk) const;
+  // Skip the messages of topics which are not selected, returns false at the end of the chunk
+  bool advance_to_selected(ChunkCursor & cursor) const;
+  void push_cursor(ChunkCursor cursor);
+  // Start reading the chunks which may hold messages before the next message
+  void activate_chunks();
+
+  std::string relative_path_;
+  uint64_t chunk_size_ {0};
+  bool direct_io_ {false};
+  bool sync_chunks_ {false};
+
+  std::unique_ptr<chunked::ChunkFileWriter> file_writer_ RCPPUTILS_TSA_GUARDED_BY(write_mutex_);
+  // Backing memory of the chunk being filled, with room to align it for direct I/O
+  std::vector<uint8_t> chunk_memory_ RCPPUTILS_TSA_GUARDED_BY(write_mutex_);
+  uint8_t * chunk_buffer_ RCPPUTILS_TSA_GUARDED_BY(write_mutex_) {nullptr};
+  uint64_t chunk_capacity_ RCPPUTILS_TSA_GUARDED_BY(write_mutex_) {0};
+  uint64_t chunk_data_size_ RCPPUTILS_TSA_GUARDED_BY(write_mutex_) {0};
+  std::vector<chunked::MessageIndexEntry> chunk_messages_ RCPPUTILS_TSA_GUARDED_BY(write_mutex_);
+  std::map<uint32_t, chunked::TopicIndexEntry> chunk_topics_ RCPPUTILS_TSA_GUARDED_BY(
+    write_mutex_);
+  std::vector<uint8_t> chunk_topic_records_ RCPPUTILS_TSA_GUARDED_BY(write_mutex_);
+  uint32_t chunk_topic_record_count_ RCPPUTILS_TSA_GUARDED_BY(write_mutex_) {0};
+  uint32_t next_topic_id_ RCPPUTILS_TSA_GUARDED_BY(write_mutex_) {1};
+
+  // Topics which were not removed, by id and by name
+  std::map<uint32_t, TopicInfo> topics_ RCPPUTILS_TSA_GUARDED_BY(write_mutex_);
+  std::unordered_map<std::string, uint32_t> topic_ids_ RCPPUTILS_TSA_GUARDED_BY(write_mutex_);
+
+  std::unique_ptr<chunked::MappedFile> mapped_file_;
+  std::vector<ChunkView> chunks_;
+  // Chunks ordered by their first time stamp, and the next one to be read from
+  std::vector<size_t> chunks_by_start_;
+  size_t next_chunk_ {0};
+  // Min-heap of the chunks being read, ordered by the time stamp of their next message
+  std::vector<ChunkCursor> cursors_;
+  bool reading_prepared_ {false};
+  // Position after the last message read, or of the last seek
+  rosbag2_storage::ReadPosition read_position_ {};
+  rosbag2_storage::StorageFilter storage_filter_ {};
+  // Topic names and whether the topic passes the filter, by topic id
+  std::vector<std::string> topic_names_;
+  std::vector<bool> selected_topics_;
+
+  // Protects the writing state and the topics, which may be created while writing
+  mutable std::mutex write_mutex_;
+};
+
+}  // namespace rosbag2_storage_plugins
+
+#ifdef _WIN32
+# pragma warning(pop)
+#endif
+
+#endif  // ROSBAG2_STORAGE_DEFAULT_PLUGINS__CHUNKED__CHUNKED_STORAGE_HPP_
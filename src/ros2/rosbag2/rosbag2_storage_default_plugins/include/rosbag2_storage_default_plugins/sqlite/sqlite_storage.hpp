@@ -85,10 +85,17 @@ public:
 
   void reset_filter() override;
 
+  void seek(const rcutils_time_point_value_t & timestamp) override;
+
+  rosbag2_storage::ReadPosition get_read_position() const override;
+
+  void set_read_position(const rosbag2_storage::ReadPosition & read_position) override;
+
   std::string get_storage_setting(const std::string & key);
 
 private:
   void initialize();
+  void create_indices();
   void prepare_for_writing();
   void prepare_for_reading();
   void fill_topics_and_types();
@@ -96,12 +103,21 @@ private:
   void commit_transaction();
   void write_locked(std::shared_ptr<const rosbag2_storage::SerializedBagMessage> message)
   RCPPUTILS_TSA_REQUIRES(database_write_mutex_);
+  // Insert messages with a single statement, the range must hold rows_per_insert_ messages
+  void write_batch_locked(
+    std::vector<std::shared_ptr<const rosbag2_storage::SerializedBagMessage>>::const_iterator begin,
+    std::vector<std::shared_ptr<const rosbag2_storage::SerializedBagMessage>>::const_iterator end)
+  RCPPUTILS_TSA_REQUIRES(database_write_mutex_);
+  int get_topic_id_locked(const std::string & topic_name) const
+  RCPPUTILS_TSA_REQUIRES(database_write_mutex_);
 
   using ReadQueryResult = SqliteStatementWrapper::QueryResult<
-    std::shared_ptr<rcutils_uint8_array_t>, rcutils_time_point_value_t, std::string>;
+    std::shared_ptr<rcutils_uint8_array_t>, rcutils_time_point_value_t, std::string, int64_t>;
 
   std::shared_ptr<SqliteWrapper> database_ RCPPUTILS_TSA_GUARDED_BY(database_write_mutex_);
   SqliteStatement write_statement_ {};
+  // Multi-row insert, only prepared when more than one row is inserted per statement
+  SqliteStatement batch_write_statement_ {};
   SqliteStatement read_statement_ {};
   ReadQueryResult message_result_ {nullptr};
   ReadQueryResult::Iterator current_message_row_ {
@@ -111,6 +127,13 @@ private:
   std::string relative_path_;
   std::atomic_bool active_transaction_ {false};
   rosbag2_storage::StorageFilter storage_filter_ {};
+  // Reading continues with the first message after this time and row, which is the message
+  // after the last one read or the time of the last seek
+  rcutils_time_point_value_t seek_time_ {INT64_MIN};
+  int64_t seek_row_id_ {0};
+  size_t rows_per_insert_ {1};
+  // The timestamp index is built when closing the bag instead of being updated on every insert
+  bool delay_index_creation_ {false};
 
   // This mutex is necessary to protect:
   // a) database access (this could also be done with FULLMUTEX), but see b)
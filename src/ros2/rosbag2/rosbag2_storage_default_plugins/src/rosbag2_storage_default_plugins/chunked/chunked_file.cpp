@@ -0,0 +1,259 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rosbag2_storage_default_plugins/chunked/chunked_file.hpp"
+
+#ifdef _WIN32
+# include <windows.h>
+# include <fcntl.h>
+# include <io.h>
+# include <sys/stat.h>
+#else
+# include <errno.h>
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "../logging.hpp"
+
+namespace rosbag2_storage_plugins
+{
+namespace chunked
+{
+
+namespace
+{
+std::string last_error_string()
+{
+#ifdef _WIN32
+  return "error code " + std::to_string(GetLastError());
+#else
+  return std::strerror(errno);
+#endif
+}
+}  // namespace
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string & path)
+{
+  file_handle_ = CreateFileA(
+    path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING,
+    FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if (file_handle_ == INVALID_HANDLE_VALUE) {
+    file_handle_ = nullptr;
+    throw std::runtime_error("Failed to open '" + path + "': " + last_error_string());
+  }
+  LARGE_INTEGER file_size;
+  if (!GetFileSizeEx(file_handle_, &file_size)) {
+    CloseHandle(file_handle_);
+    throw std::runtime_error("Failed to get size of '" + path + "': " + last_error_string());
+  }
+  size_ = static_cast<uint64_t>(file_size.QuadPart);
+  if (size_ == 0) {
+    return;
+  }
+  mapping_handle_ = CreateFileMappingA(file_handle_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (mapping_handle_ == nullptr) {
+    CloseHandle(file_handle_);
+    throw std::runtime_error("Failed to map '" + path + "': " + last_error_string());
+  }
+  data_ = static_cast<const uint8_t *>(MapViewOfFile(mapping_handle_, FILE_MAP_READ, 0, 0, 0));
+  if (data_ == nullptr) {
+    CloseHandle(mapping_handle_);
+    CloseHandle(file_handle_);
+    throw std::runtime_error("Failed to map '" + path + "': " + last_error_string());
+  }
+}
+
+MappedFile::~MappedFile()
+{
+  if (data_) {
+    UnmapViewOfFile(data_);
+  }
+  if (mapping_handle_) {
+    CloseHandle(mapping_handle_);
+  }
+  if (file_handle_) {
+    CloseHandle(file_handle_);
+  }
+}
+
+ChunkFileWriter::ChunkFileWriter(const std::string & path, bool create, bool direct_io)
+: path_(path)
+{
+  // Unbuffered writes are not exposed through the C runtime, whole chunks are written anyway
+  (void) direct_io;
+  const int flags = _O_BINARY | _O_WRONLY | (create ? _O_CREAT | _O_EXCL : _O_APPEND);
+  if (_sopen_s(&fd_, path.c_str(), flags, _SH_DENYWR, _S_IREAD | _S_IWRITE) != 0) {
+    throw std::runtime_error("Failed to open '" + path + "' for writing: " + last_error_string());
+  }
+  size_ = static_cast<uint64_t>(_lseeki64(fd_, 0, SEEK_END));
+}
+
+ChunkFileWriter::~ChunkFileWriter()
+{
+  if (fd_ >= 0) {
+    _close(fd_);
+  }
+}
+
+void ChunkFileWriter::write(const uint8_t * buffer, size_t size)
+{
+  while (size > 0) {
+    const auto to_write = static_cast<unsigned int>(std::min<size_t>(size, 1u << 30));
+    const int written = _write(fd_, buffer, to_write);
+    if (written < 0) {
+      throw std::runtime_error("Failed to write to '" + path_ + "': " + last_error_string());
+    }
+    buffer += written;
+    size -= static_cast<size_t>(written);
+    size_ += static_cast<uint64_t>(written);
+  }
+}
+
+void ChunkFileWriter::truncate(uint64_t size)
+{
+  if (_chsize_s(fd_, static_cast<__int64>(size)) != 0) {
+    throw std::runtime_error("Failed to truncate '" + path_ + "': " + last_error_string());
+  }
+  size_ = size;
+}
+
+void ChunkFileWriter::sync()
+{
+  _commit(fd_);
+}
+
+#else
+
+MappedFile::MappedFile(const std::string & path)
+{
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Failed to open '" + path + "': " + last_error_string());
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0) {
+    const auto error = last_error_string();
+    close(fd);
+    throw std::runtime_error("Failed to get size of '" + path + "': " + error);
+  }
+  size_ = static_cast<uint64_t>(file_stat.st_size);
+  if (size_ > 0) {
+    void * data = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) {
+      const auto error = last_error_string();
+      close(fd);
+      throw std::runtime_error("Failed to map '" + path + "': " + error);
+    }
+    // Messages are mostly read in the order they were written
+    madvise(data, size_, MADV_SEQUENTIAL);
+    data_ = static_cast<const uint8_t *>(data);
+  }
+  // The mapping stays valid without the file descriptor
+  close(fd);
+}
+
+MappedFile::~MappedFile()
+{
+  if (data_) {
+    munmap(const_cast<uint8_t *>(data_), size_);
+  }
+}
+
+ChunkFileWriter::ChunkFileWriter(const std::string & path, bool create, bool direct_io)
+: path_(path)
+{
+  const int flags = O_WRONLY | (create ? O_CREAT | O_EXCL : O_APPEND);
+#ifdef O_DIRECT
+  if (direct_io) {
+    fd_ = open(path.c_str(), flags | O_DIRECT, 0644);
+    if (fd_ >= 0) {
+      direct_io_ = true;
+    } else if (errno == EINVAL) {
+      ROSBAG2_STORAGE_DEFAULT_PLUGINS_LOG_WARN_STREAM(
+        "Direct I/O is not supported for '" << path << "', writing through the page cache.");
+    } else {
+      throw std::runtime_error(
+              "Failed to open '" + path + "' for writing: " + last_error_string());
+    }
+  }
+#else
+  if (direct_io) {
+    ROSBAG2_STORAGE_DEFAULT_PLUGINS_LOG_WARN_STREAM(
+      "Direct I/O is not supported on this platform, writing through the page cache.");
+  }
+#endif
+  if (fd_ < 0) {
+    fd_ = open(path.c_str(), flags, 0644);
+  }
+  if (fd_ < 0) {
+    throw std::runtime_error("Failed to open '" + path + "' for writing: " + last_error_string());
+  }
+  const auto end = lseek(fd_, 0, SEEK_END);
+  size_ = end < 0 ? 0u : static_cast<uint64_t>(end);
+}
+
+ChunkFileWriter::~ChunkFileWriter()
+{
+  if (fd_ >= 0) {
+    close(fd_);
+  }
+}
+
+void ChunkFileWriter::write(const uint8_t * buffer, size_t size)
+{
+  while (size > 0) {
+    const ssize_t written = ::write(fd_, buffer, size);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw std::runtime_error("Failed to write to '" + path_ + "': " + last_error_string());
+    }
+    buffer += written;
+    size -= static_cast<size_t>(written);
+    size_ += static_cast<uint64_t>(written);
+  }
+}
+
+void ChunkFileWriter::truncate(uint64_t size)
+{
+  if (ftruncate(fd_, static_cast<off_t>(size)) != 0) {
+    throw std::runtime_error("Failed to truncate '" + path_ + "': " + last_error_string());
+  }
+  size_ = size;
+}
+
+void ChunkFileWriter::sync()
+{
+#if defined(__APPLE__)
+  fsync(fd_);
+#else
+  fdatasync(fd_);
+#endif
+}
+
+#endif
+
+}  // namespace chunked
+}  // namespace rosbag2_storage_plugins
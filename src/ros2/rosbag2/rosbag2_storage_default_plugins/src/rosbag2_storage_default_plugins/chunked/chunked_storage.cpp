@@ -0,0 +1,801 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rosbag2_storage_default_plugins/chunked/chunked_storage.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "rcpputils/filesystem_helper.hpp"
+
+#include "rosbag2_storage/ros_helper.hpp"
+#include "rosbag2_storage/serialized_bag_message.hpp"
+
+#ifdef _WIN32
+// This is necessary because of a bug in yaml-cpp's cmake
+#define YAML_CPP_DLL
+// This is necessary because yaml-cpp does not always use dllimport/dllexport consistently
+# pragma warning(push)
+# pragma warning(disable:4251)
+# pragma warning(disable:4275)
+#endif
+#include "yaml-cpp/yaml.h"
+#ifdef _WIN32
+# pragma warning(pop)
+#endif
+
+#include "../logging.hpp"
+
+namespace
+{
+std::string to_string(rosbag2_storage::storage_interfaces::IOFlag io_flag)
+{
+  switch (io_flag) {
+    case rosbag2_storage::storage_interfaces::IOFlag::APPEND:
+      return "APPEND";
+    case rosbag2_storage::storage_interfaces::IOFlag::READ_ONLY:
+      return "READ_ONLY";
+    case rosbag2_storage::storage_interfaces::IOFlag::READ_WRITE:
+      return "READ_WRITE";
+    default:
+      return "UNKNOWN";
+  }
+}
+
+constexpr const auto FILE_EXTENSION = ".chunks";
+
+constexpr const uint64_t DEFAULT_CHUNK_SIZE = 4 * 1024 * 1024;
+
+constexpr const uint64_t MIN_CHUNK_SIZE = 16 * rosbag2_storage_plugins::chunked::CHUNK_ALIGNMENT;
+
+void append_uint32(std::vector<uint8_t> & buffer, uint32_t value)
+{
+  const auto bytes = reinterpret_cast<const uint8_t *>(&value);
+  buffer.insert(buffer.end(), bytes, bytes + sizeof(value));
+}
+
+void append_string(std::vector<uint8_t> & buffer, const std::string & value)
+{
+  append_uint32(buffer, static_cast<uint32_t>(value.size()));
+  buffer.insert(buffer.end(), value.begin(), value.end());
+}
+
+// Reads the fields of topic records, keeping track of the end of the records
+class RecordReader
+{
+public:
+  RecordReader(const uint8_t * begin, const uint8_t * end)
+  : current_(begin), end_(end) {}
+
+  bool read(uint32_t & value)
+  {
+    if (static_cast<size_t>(end_ - current_) < sizeof(value)) {
+      return false;
+    }
+    std::memcpy(&value, current_, sizeof(value));
+    current_ += sizeof(value);
+    return true;
+  }
+
+  bool read(std::string & value)
+  {
+    uint32_t size = 0;
+    if (!read(size) || static_cast<size_t>(end_ - current_) < size) {
+      return false;
+    }
+    value.assign(reinterpret_cast<const char *>(current_), size);
+    current_ += size;
+    return true;
+  }
+
+private:
+  const uint8_t * current_;
+  const uint8_t * end_;
+};
+
+}  // namespace
+
+namespace rosbag2_storage_plugins
+{
+
+ChunkedStorage::~ChunkedStorage()
+{
+  std::lock_guard<std::mutex> lock(write_mutex_);
+  if (file_writer_) {
+    try {
+      flush_chunk_locked();
+    } catch (const std::exception & e) {
+      ROSBAG2_STORAGE_DEFAULT_PLUGINS_LOG_ERROR_STREAM(
+        "Could not write the last chunk of '" << relative_path_ << "': " << e.what());
+    }
+  }
+}
+
+void ChunkedStorage::open(
+  const rosbag2_storage::StorageOptions & storage_options,
+  rosbag2_storage::storage_interfaces::IOFlag io_flag)
+{
+  using rosbag2_storage::storage_interfaces::IOFlag;
+
+  chunk_size_ = DEFAULT_CHUNK_SIZE;
+  direct_io_ = false;
+  if (io_flag != IOFlag::READ_ONLY && !storage_options.storage_config_uri.empty()) {
+    try {
+      YAML::Node config = YAML::LoadFile(storage_options.storage_config_uri)["write"];
+      if (config["chunk_size"]) {
+        chunk_size_ = config["chunk_size"].as<uint64_t>();
+      }
+      if (config["direct_io"]) {
+        direct_io_ = config["direct_io"].as<bool>();
+      }
+    } catch (const YAML::Exception & ex) {
+      throw std::runtime_error(
+              std::string("Exception on parsing chunked storage config file: ") + ex.what());
+    }
+    if (chunk_size_ < MIN_CHUNK_SIZE || chunk_size_ % chunked::CHUNK_ALIGNMENT != 0) {
+      throw std::runtime_error(
+              "Invalid chunk size " + std::to_string(chunk_size_) + ", it must be a multiple of " +
+              std::to_string(chunked::CHUNK_ALIGNMENT) + " of at least " +
+              std::to_string(MIN_CHUNK_SIZE) + " bytes.");
+    }
+  }
+  sync_chunks_ = "resilient" == storage_options.storage_preset_profile;
+
+  if (io_flag == IOFlag::READ_WRITE) {
+    relative_path_ = storage_options.uri + FILE_EXTENSION;
+
+    // READ_WRITE requires the bag file to not exist.
+    if (rcpputils::fs::path(relative_path_).exists()) {
+      throw std::runtime_error(
+              "Failed to create bag: File '" + relative_path_ + "' already exists!");
+    }
+  } else {  // APPEND and READ_ONLY
+    relative_path_ = storage_options.uri;
+
+    // APPEND and READ_ONLY require the bag file to exist
+    if (!rcpputils::fs::path(relative_path_).exists()) {
+      throw std::runtime_error(
+              "Failed to read from bag: File '" + relative_path_ + "' does not exist!");
+    }
+  }
+
+  reading_prepared_ = false;
+  cursors_.clear();
+  chunks_.clear();
+  mapped_file_.reset();
+  {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    file_writer_.reset();
+    topics_.clear();
+    topic_ids_.clear();
+    next_topic_id_ = 1;
+    chunk_topic_records_.clear();
+    chunk_topic_record_count_ = 0;
+    chunk_capacity_ = 0;
+  }
+
+  uint64_t loaded_size = 0;
+  if (io_flag != IOFlag::READ_WRITE) {
+    loaded_size = load_chunks();
+  }
+
+  if (io_flag != IOFlag::READ_ONLY) {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    file_writer_ = std::make_unique<chunked::ChunkFileWriter>(
+      relative_path_, io_flag == IOFlag::READ_WRITE, direct_io_);
+    if (io_flag == IOFlag::APPEND) {
+      // The mapping must be released before the file is changed
+      chunks_.clear();
+      mapped_file_.reset();
+      if (file_writer_->size() > loaded_size) {
+        ROSBAG2_STORAGE_DEFAULT_PLUGINS_LOG_WARN_STREAM(
+          "Removing " << file_writer_->size() - loaded_size << " bytes of an incomplete chunk "
+            "at the end of '" << relative_path_ << "'.");
+        file_writer_->truncate(loaded_size);
+      }
+    }
+    start_chunk_locked(chunk_size_);
+  }
+
+  ROSBAG2_STORAGE_DEFAULT_PLUGINS_LOG_INFO_STREAM(
+    "Opened chunked bag '" << relative_path_ << "' for " << to_string(io_flag) << ".");
+}
+
+void ChunkedStorage::create_topic(const rosbag2_storage::TopicMetadata & topic)
+{
+  std::lock_guard<std::mutex> lock(write_mutex_);
+  if (!file_writer_) {
+    throw std::runtime_error("Bag '" + relative_path_ + "' is not open for writing.");
+  }
+  if (topic_ids_.find(topic.name) != topic_ids_.end()) {
+    return;
+  }
+  const auto topic_id = next_topic_id_++;
+  TopicInfo & info = topics_[topic_id];
+  info.metadata = topic;
+  topic_ids_.emplace(topic.name, topic_id);
+  add_topic_record_locked(topic_id, info, chunked::TOPIC_CREATED);
+}
+
+void ChunkedStorage::remove_topic(const rosbag2_storage::TopicMetadata & topic)
+{
+  std::lock_guard<std::mutex> lock(write_mutex_);
+  if (!file_writer_) {
+    throw std::runtime_error("Bag '" + relative_path_ + "' is not open for writing.");
+  }
+  auto topic_id = topic_ids_.find(topic.name);
+  if (topic_id == topic_ids_.end()) {
+    return;
+  }
+  add_topic_record_locked(topic_id->second, topics_[topic_id->second], chunked::TOPIC_REMOVED);
+  topics_.erase(topic_id->second);
+  topic_ids_.erase(topic_id);
+}
+
+void ChunkedStorage::write(std::shared_ptr<const rosbag2_storage::SerializedBagMessage> message)
+{
+  std::lock_guard<std::mutex> lock(write_mutex_);
+  write_locked(*message);
+}
+
+void ChunkedStorage::write(
+  const std::vector<std::shared_ptr<const rosbag2_storage::SerializedBagMessage>> & messages)
+{
+  std::lock_guard<std::mutex> lock(write_mutex_);
+  for (const auto & message : messages) {
+    write_locked(*message);
+  }
+}
+
+void ChunkedStorage::write_locked(const rosbag2_storage::SerializedBagMessage & message)
+{
+  if (!file_writer_) {
+    throw std::runtime_error("Bag '" + relative_path_ + "' is not open for writing.");
+  }
+  auto topic_id = topic_ids_.find(message.topic_name);
+  if (topic_id == topic_ids_.end()) {
+    throw std::runtime_error(
+            "Topic '" + message.topic_name +
+            "' has not been created yet! Call 'create_topic' first.");
+  }
+
+  const uint64_t size = message.serialized_data->buffer_length;
+  auto required_size = [this, size]() {
+      return chunked::message_index_offset(chunk_data_size_ + size) +
+             chunk_tail_size_locked(static_cast<uint32_t>(chunk_messages_.size() + 1));
+    };
+  if (required_size() > chunk_capacity_ && !chunk_messages_.empty()) {
+    flush_chunk_locked();
+  }
+  if (required_size() > chunk_capacity_) {
+    // The message does not fit into an empty chunk, it gets a larger chunk of its own
+    start_chunk_locked(chunked::align_chunk_size(required_size()));
+  }
+
+  const uint64_t offset = sizeof(chunked::ChunkHeader) + chunk_data_size_;
+  if (size > 0) {
+    std::memcpy(chunk_buffer_ + offset, message.serialized_data->buffer, size);
+  }
+  chunk_data_size_ += size;
+  chunk_messages_.push_back({message.time_stamp, offset, size, topic_id->second, 0u});
+
+  auto topic_entry = chunk_topics_.emplace(
+    topic_id->second,
+    chunked::TopicIndexEntry{topic_id->second, 0u, message.time_stamp, message.time_stamp});
+  auto & entry = topic_entry.first->second;
+  ++entry.message_count;
+  entry.start_time = std::min(entry.start_time, message.time_stamp);
+  entry.end_time = std::max(entry.end_time, message.time_stamp);
+
+  auto & info = topics_[topic_id->second];
+  ++info.message_count;
+  info.start_time = std::min(info.start_time, message.time_stamp);
+  info.end_time = std::max(info.end_time, message.time_stamp);
+}
+
+uint64_t ChunkedStorage::chunk_tail_size_locked(uint32_t message_count) const
+{
+  // Leaves room for the topic index entry of a topic which is not in the chunk yet
+  return message_count * sizeof(chunked::MessageIndexEntry) +
+         (chunk_topics_.size() + 1) * sizeof(chunked::TopicIndexEntry) +
+         chunk_topic_records_.size();
+}
+
+void ChunkedStorage::add_topic_record_locked(
+  uint32_t topic_id, const TopicInfo & topic, uint32_t flags)
+{
+  std::vector<uint8_t> record;
+  append_uint32(record, topic_id);
+  append_uint32(record, flags);
+  append_string(record, topic.metadata.name);
+  append_string(record, topic.metadata.type);
+  append_string(record, topic.metadata.serialization_format);
+  append_string(record, topic.metadata.offered_qos_profiles);
+
+  auto required_size = [this, &record]() {
+      return chunked::message_index_offset(chunk_data_size_) +
+             chunk_tail_size_locked(static_cast<uint32_t>(chunk_messages_.size())) +
+             record.size();
+    };
+  if (required_size() > chunk_capacity_ &&
+    (!chunk_messages_.empty() || chunk_topic_record_count_ > 0))
+  {
+    flush_chunk_locked();
+  }
+  if (required_size() > chunk_capacity_) {
+    start_chunk_locked(chunked::align_chunk_size(required_size()));
+  }
+
+  chunk_topic_records_.insert(chunk_topic_records_.end(), record.begin(), record.end());
+  ++chunk_topic_record_count_;
+}
+
+void ChunkedStorage::start_chunk_locked(uint64_t chunk_size)
+{
+  if (chunk_capacity_ != chunk_size) {
+    std::vector<uint8_t>(chunk_size + chunked::CHUNK_ALIGNMENT).swap(chunk_memory_);
+    const auto address = reinterpret_cast<uintptr_t>(chunk_memory_.data());
+    chunk_buffer_ = chunk_memory_.data() +
+      (chunked::CHUNK_ALIGNMENT - address % chunked::CHUNK_ALIGNMENT) % chunked::CHUNK_ALIGNMENT;
+    chunk_capacity_ = chunk_size;
+  }
+  chunk_data_size_ = 0;
+  chunk_messages_.clear();
+  chunk_topics_.clear();
+}
+
+void ChunkedStorage::flush_chunk_locked()
+{
+  if (chunk_messages_.empty() && chunk_topic_record_count_ == 0) {
+    return;
+  }
+
+  std::stable_sort(
+    chunk_messages_.begin(), chunk_messages_.end(),
+    [](const chunked::MessageIndexEntry & lhs, const chunked::MessageIndexEntry & rhs) {
+      return lhs.time_stamp < rhs.time_stamp;
+    });
+
+  chunked::ChunkHeader header {};
+  header.magic = chunked::CHUNK_MAGIC;
+  header.version = chunked::CHUNK_FORMAT_VERSION;
+  header.chunk_size = chunk_capacity_;
+  header.data_size = chunk_data_size_;
+  header.message_count = static_cast<uint32_t>(chunk_messages_.size());
+  header.topic_index_count = static_cast<uint32_t>(chunk_topics_.size());
+  header.topic_record_count = chunk_topic_record_count_;
+  header.topic_records_size = chunk_topic_records_.size();
+  header.start_time = chunk_messages_.empty() ? 0 : chunk_messages_.front().time_stamp;
+  header.end_time = chunk_messages_.empty() ? 0 : chunk_messages_.back().time_stamp;
+  std::memcpy(chunk_buffer_, &header, sizeof(header));
+
+  const uint64_t data_end = sizeof(header) + chunk_data_size_;
+  uint64_t offset = chunked::message_index_offset(chunk_data_size_);
+  std::memset(chunk_buffer_ + data_end, 0, offset - data_end);
+  if (!chunk_messages_.empty()) {
+    std::memcpy(
+      chunk_buffer_ + offset, chunk_messages_.data(),
+      chunk_messages_.size() * sizeof(chunked::MessageIndexEntry));
+    offset += chunk_messages_.size() * sizeof(chunked::MessageIndexEntry);
+  }
+  for (const auto & topic : chunk_topics_) {
+    std::memcpy(chunk_buffer_ + offset, &topic.second, sizeof(topic.second));
+    offset += sizeof(topic.second);
+  }
+  if (!chunk_topic_records_.empty()) {
+    std::memcpy(chunk_buffer_ + offset, chunk_topic_records_.data(), chunk_topic_records_.size());
+    offset += chunk_topic_records_.size();
+  }
+  std::memset(chunk_buffer_ + offset, 0, chunk_capacity_ - offset);
+
+  file_writer_->write(chunk_buffer_, chunk_capacity_);
+  if (sync_chunks_) {
+    file_writer_->sync();
+  }
+  ROSBAG2_STORAGE_DEFAULT_PLUGINS_LOG_DEBUG_STREAM(
+    "wrote chunk with " << header.message_count << " messages");
+
+  chunk_topic_records_.clear();
+  chunk_topic_record_count_ = 0;
+  start_chunk_locked(chunk_size_);
+}
+
+uint64_t ChunkedStorage::load_chunks()
+{
+  mapped_file_ = std::make_unique<chunked::MappedFile>(relative_path_);
+  chunks_.clear();
+
+  std::lock_guard<std::mutex> lock(write_mutex_);
+  const uint8_t * file_data = mapped_file_->data();
+  const uint64_t file_size = mapped_file_->size();
+  uint64_t offset = 0;
+  while (file_size - offset >= sizeof(chunked::ChunkHeader)) {
+    ChunkView chunk;
+    chunk.data = file_data + offset;
+    std::memcpy(&chunk.header, chunk.data, sizeof(chunk.header));
+    const auto & header = chunk.header;
+    // Sizes are checked before computing offsets from them, which could wrap around otherwise
+    if (header.magic != chunked::CHUNK_MAGIC || header.version != chunked::CHUNK_FORMAT_VERSION ||
+      header.chunk_size < sizeof(chunked::ChunkHeader) ||
+      header.chunk_size % chunked::CHUNK_ALIGNMENT != 0 ||
+      header.chunk_size > file_size - offset ||
+      header.data_size > header.chunk_size - sizeof(chunked::ChunkHeader))
+    {
+      break;
+    }
+    const uint64_t index_offset = chunked::message_index_offset(header.data_size);
+    const uint64_t index_size =
+      uint64_t{header.message_count} * sizeof(chunked::MessageIndexEntry) +
+      uint64_t{header.topic_index_count} * sizeof(chunked::TopicIndexEntry);
+    if (index_offset > header.chunk_size ||
+      index_size > header.chunk_size - index_offset ||
+      header.topic_records_size > header.chunk_size - index_offset - index_size)
+    {
+      break;
+    }
+    chunk.messages = reinterpret_cast<const chunked::MessageIndexEntry *>(
+      chunk.data + index_offset);
+    chunk.topics = reinterpret_cast<const chunked::TopicIndexEntry *>(
+      chunk.data + index_offset + header.message_count * sizeof(chunked::MessageIndexEntry));
+
+    // Topics must be known before the messages of the chunk are counted
+    if (!apply_topic_records_locked(chunk)) {
+      break;
+    }
+    for (uint32_t i = 0; i < header.topic_index_count; ++i) {
+      auto topic = topics_.find(chunk.topics[i].topic_id);
+      if (topic != topics_.end()) {
+        topic->second.message_count += chunk.topics[i].message_count;
+        topic->second.start_time = std::min(topic->second.start_time, chunk.topics[i].start_time);
+        topic->second.end_time = std::max(topic->second.end_time, chunk.topics[i].end_time);
+      }
+    }
+
+    chunks_.push_back(chunk);
+    offset += header.chunk_size;
+  }
+
+  if (offset != file_size) {
+    ROSBAG2_STORAGE_DEFAULT_PLUGINS_LOG_WARN_STREAM(
+      "Ignoring " << file_size - offset << " bytes after the last complete chunk of '" <<
+        relative_path_ << "'.");
+  }
+  return offset;
+}
+
+bool ChunkedStorage::apply_topic_records_locked(const ChunkView & chunk)
+{
+  const uint8_t * records = chunk.data + chunked::message_index_offset(chunk.header.data_size) +
+    chunk.header.message_count * sizeof(chunked::MessageIndexEntry) +
+    chunk.header.topic_index_count * sizeof(chunked::TopicIndexEntry);
+  RecordReader reader(records, records + chunk.header.topic_records_size);
+
+  for (uint32_t i = 0; i < chunk.header.topic_record_count; ++i) {
+    uint32_t topic_id = 0;
+    uint32_t flags = 0;
+    rosbag2_storage::TopicMetadata metadata;
+    if (!reader.read(topic_id) || !reader.read(flags) || !reader.read(metadata.name) ||
+      !reader.read(metadata.type) || !reader.read(metadata.serialization_format) ||
+      !reader.read(metadata.offered_qos_profiles))
+    {
+      return false;
+    }
+
+    next_topic_id_ = std::max(next_topic_id_, topic_id + 1);
+    if (flags & chunked::TOPIC_REMOVED) {
+      topics_.erase(topic_id);
+      auto topic_name = topic_ids_.find(metadata.name);
+      if (topic_name != topic_ids_.end() && topic_name->second == topic_id) {
+        topic_ids_.erase(topic_name);
+      }
+    } else {
+      topic_ids_[metadata.name] = topic_id;
+      topics_[topic_id].metadata = std::move(metadata);
+    }
+  }
+  return true;
+}
+
+void ChunkedStorage::prepare_for_reading()
+{
+  if (!mapped_file_) {
+    throw std::runtime_error(
+            "Bag '" + relative_path_ + "' has to be opened READ_ONLY to read messages.");
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    const uint32_t topic_count = topics_.empty() ? 0u : topics_.rbegin()->first + 1;
+    topic_names_.assign(topic_count, std::string());
+    selected_topics_.assign(topic_count, false);
+    for (const auto & topic : topics_) {
+      const auto & name = topic.second.metadata.name;
+      topic_names_[topic.first] = name;
+      selected_topics_[topic.first] = storage_filter_.topics.empty() ||
+        std::find(
+        storage_filter_.topics.begin(), storage_filter_.topics.end(),
+        name) != storage_filter_.topics.end();
+    }
+  }
+
+  chunks_by_start_.clear();
+  for (size_t i = 0; i < chunks_.size(); ++i) {
+    if (chunks_[i].header.message_count > 0 && is_chunk_selected(chunks_[i])) {
+      chunks_by_start_.push_back(i);
+    }
+  }
+  std::stable_sort(
+    chunks_by_start_.begin(), chunks_by_start_.end(), [this](size_t lhs, size_t rhs) {
+      return chunks_[lhs].header.start_time < chunks_[rhs].header.start_time;
+    });
+  next_chunk_ = 0;
+  cursors_.clear();
+  reading_prepared_ = true;
+}
+
+bool ChunkedStorage::is_chunk_selected(const ChunkView & chunk) const
+{
+  for (uint32_t i = 0; i < chunk.header.topic_index_count; ++i) {
+    const auto topic_id = chunk.topics[i].topic_id;
+    if (topic_id < selected_topics_.size() && selected_topics_[topic_id]) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ChunkedStorage::advance_to_selected(ChunkCursor & cursor) const
+{
+  const auto & chunk = chunks_[cursor.chunk];
+  while (cursor.position < chunk.header.message_count) {
+    const auto & entry = chunk.messages[cursor.position];
+    if (entry.topic_id < selected_topics_.size() && selected_topics_[entry.topic_id]) {
+      cursor.time_stamp = entry.time_stamp;
+      return true;
+    }
+    ++cursor.position;
+  }
+  return false;
+}
+
+void ChunkedStorage::push_cursor(ChunkCursor cursor)
+{
+  if (advance_to_selected(cursor)) {
+    cursors_.push_back(cursor);
+    std::push_heap(cursors_.begin(), cursors_.end(), later);
+  }
+}
+
+void ChunkedStorage::activate_chunks()
+{
+  // A chunk starting after the next message can not hold any message before it
+  while (next_chunk_ < chunks_by_start_.size()) {
+    const auto chunk = chunks_by_start_[next_chunk_];
+    if (!cursors_.empty() && chunks_[chunk].header.start_time > cursors_.front().time_stamp) {
+      break;
+    }
+    push_cursor({chunks_[chunk].header.start_time, chunk, 0u});
+    ++next_chunk_;
+  }
+}
+
+bool ChunkedStorage::has_next()
+{
+  if (!reading_prepared_) {
+    prepare_for_reading();
+  }
+  activate_chunks();
+  return !cursors_.empty();
+}
+
+std::shared_ptr<rosbag2_storage::SerializedBagMessage> ChunkedStorage::read_next()
+{
+  if (!has_next()) {
+    throw std::runtime_error("No more messages in bag '" + relative_path_ + "'.");
+  }
+
+  std::pop_heap(cursors_.begin(), cursors_.end(), later);
+  auto cursor = cursors_.back();
+  cursors_.pop_back();
+
+  const auto & chunk = chunks_[cursor.chunk];
+  const auto & entry = chunk.messages[cursor.position];
+  auto bag_message = std::make_shared<rosbag2_storage::SerializedBagMessage>();
+  bag_message->serialized_data = rosbag2_storage::make_serialized_message(
+    chunk.data + entry.offset, entry.size);
+  bag_message->time_stamp = entry.time_stamp;
+  bag_message->topic_name = topic_names_[entry.topic_id];
+
+  ++cursor.position;
+  read_position_ = {
+    entry.time_stamp,
+    static_cast<int64_t>((static_cast<uint64_t>(cursor.chunk) << 32) | cursor.position)};
+  push_cursor(cursor);
+  return bag_message;
+}
+
+void ChunkedStorage::seek(const rcutils_time_point_value_t & timestamp)
+{
+  set_read_position({timestamp, 0});
+}
+
+rosbag2_storage::ReadPosition ChunkedStorage::get_read_position() const
+{
+  return read_position_;
+}
+
+void ChunkedStorage::set_read_position(const rosbag2_storage::ReadPosition & read_position)
+{
+  if (!reading_prepared_) {
+    prepare_for_reading();
+  }
+  read_position_ = read_position;
+
+  const auto timestamp = read_position.time_stamp;
+  const auto sequence = static_cast<uint64_t>(read_position.sequence);
+  const auto first_chunk = static_cast<size_t>(sequence >> 32);
+  const auto first_position = static_cast<uint32_t>(sequence & 0xFFFFFFFFu);
+
+  // Chunks starting at the time may hold messages at the time which are before the position,
+  // so they are started here as well
+  cursors_.clear();
+  next_chunk_ = static_cast<size_t>(
+    std::upper_bound(
+      chunks_by_start_.begin(), chunks_by_start_.end(), timestamp,
+      [this](rcutils_time_point_value_t time, size_t chunk) {
+        return time < chunks_[chunk].header.start_time;
+      }) - chunks_by_start_.begin());
+
+  // Earlier chunks still have to be read if they end after the time
+  for (size_t i = 0; i < next_chunk_; ++i) {
+    const auto chunk_index = chunks_by_start_[i];
+    const auto & chunk = chunks_[chunk_index];
+    if (chunk.header.end_time < timestamp) {
+      continue;
+    }
+    const auto begin = chunk.messages;
+    const auto end = chunk.messages + chunk.header.message_count;
+    // Messages with the same time are read in the order of their chunk and position
+    const chunked::MessageIndexEntry * first;
+    if (chunk_index < first_chunk) {
+      first = std::upper_bound(
+        begin, end, timestamp,
+        [](rcutils_time_point_value_t time, const chunked::MessageIndexEntry & entry) {
+          return time < entry.time_stamp;
+        });
+    } else {
+      first = std::lower_bound(
+        begin, end, timestamp,
+        [](const chunked::MessageIndexEntry & entry, rcutils_time_point_value_t time) {
+          return entry.time_stamp < time;
+        });
+      if (chunk_index == first_chunk) {
+        first = std::max(first, std::min(begin + first_position, end));
+      }
+    }
+    push_cursor({timestamp, chunk_index, static_cast<uint32_t>(first - begin)});
+  }
+}
+
+std::vector<rosbag2_storage::TopicMetadata> ChunkedStorage::get_all_topics_and_types()
+{
+  std::lock_guard<std::mutex> lock(write_mutex_);
+  std::vector<rosbag2_storage::TopicMetadata> topics;
+  topics.reserve(topics_.size());
+  for (const auto & topic : topics_) {
+    topics.push_back(topic.second.metadata);
+  }
+  return topics;
+}
+
+rosbag2_storage::BagMetadata ChunkedStorage::get_metadata()
+{
+  rosbag2_storage::BagMetadata metadata;
+  metadata.storage_identifier = get_storage_identifier();
+  metadata.relative_file_paths = {get_relative_file_path()};
+  metadata.message_count = 0;
+  metadata.topics_with_message_count = {};
+
+  rcutils_time_point_value_t min_time = INT64_MAX;
+  rcutils_time_point_value_t max_time = 0;
+  {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    for (const auto & topic : topics_) {
+      const auto & info = topic.second;
+      if (info.message_count == 0) {
+        continue;
+      }
+      metadata.topics_with_message_count.push_back({info.metadata, info.message_count});
+      metadata.message_count += info.message_count;
+      min_time = std::min(min_time, info.start_time);
+      max_time = std::max(max_time, info.end_time);
+    }
+  }
+
+  if (metadata.message_count == 0) {
+    min_time = 0;
+    max_time = 0;
+  }
+
+  metadata.starting_time =
+    std::chrono::time_point<std::chrono::high_resolution_clock>(std::chrono::nanoseconds(min_time));
+  metadata.duration = std::chrono::nanoseconds(max_time) - std::chrono::nanoseconds(min_time);
+  metadata.bag_size = get_bagfile_size();
+
+  return metadata;
+}
+
+std::string ChunkedStorage::get_relative_file_path() const
+{
+  return relative_path_;
+}
+
+uint64_t ChunkedStorage::get_bagfile_size() const
+{
+  std::lock_guard<std::mutex> lock(write_mutex_);
+  if (file_writer_) {
+    // Include the chunk being filled, so that bags are split at the requested size
+    const uint64_t pending = chunk_messages_.empty() ? 0u :
+      sizeof(chunked::ChunkHeader) + chunk_data_size_;
+    return file_writer_->size() + pending;
+  }
+  const auto bag_path = rcpputils::fs::path{relative_path_};
+  return bag_path.exists() ? bag_path.file_size() : 0u;
+}
+
+std::string ChunkedStorage::get_storage_identifier() const
+{
+  return "chunked";
+}
+
+uint64_t ChunkedStorage::get_minimum_split_file_size() const
+{
+  return chunk_size_;
+}
+
+void ChunkedStorage::set_filter(const rosbag2_storage::StorageFilter & storage_filter)
+{
+  storage_filter_ = storage_filter;
+  apply_filter();
+}
+
+void ChunkedStorage::reset_filter()
+{
+  storage_filter_ = rosbag2_storage::StorageFilter();
+  apply_filter();
+}
+
+void ChunkedStorage::apply_filter()
+{
+  if (!reading_prepared_) {
+    return;
+  }
+  // Continue with the selected topics from where reading stopped
+  const auto read_position = read_position_;
+  prepare_for_reading();
+  set_read_position(read_position);
+}
+
+}  // namespace rosbag2_storage_plugins
+
+#include "pluginlib/class_list_macros.hpp"  // NOLINT
+PLUGINLIB_EXPORT_CLASS(
+  rosbag2_storage_plugins::ChunkedStorage,
+  rosbag2_storage::storage_interfaces::ReadWriteInterface)
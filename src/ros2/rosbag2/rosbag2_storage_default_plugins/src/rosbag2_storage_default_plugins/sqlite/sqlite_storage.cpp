@@ -158,6 +158,10 @@ constexpr const auto FILE_EXTENSION = ".db3";
 
 // Minimum size of a sqlite3 database file in bytes (84 kiB).
 constexpr const uint64_t MIN_SPLIT_FILE_SIZE = 86016;
+
+// Number of messages inserted by a single statement with the high_throughput preset.
+// Each row binds 3 parameters, which stays below the default limit of 999 parameters.
+constexpr const size_t HIGH_THROUGHPUT_ROWS_PER_INSERT = 64;
 }  // namespace
 
 namespace rosbag2_storage_plugins
@@ -167,6 +171,14 @@ SqliteStorage::~SqliteStorage()
   if (active_transaction_) {
     commit_transaction();
   }
+  if (delay_index_creation_ && database_) {
+    try {
+      create_indices();
+    } catch (const SqliteException & e) {
+      ROSBAG2_STORAGE_DEFAULT_PLUGINS_LOG_ERROR_STREAM(
+        "Could not create indices of '" << relative_path_ << "': " << e.what());
+    }
+  }
 }
 
 void SqliteStorage::open(
@@ -174,10 +186,16 @@ void SqliteStorage::open(
   rosbag2_storage::storage_interfaces::IOFlag io_flag)
 {
   const bool resilient_preset = "resilient" == storage_options.storage_preset_profile;
+  const bool high_throughput_preset =
+    "high_throughput" == storage_options.storage_preset_profile && is_read_write(io_flag);
   auto pragmas = parse_pragmas(storage_options.storage_config_uri, io_flag);
   if (resilient_preset && is_read_write(io_flag)) {
     apply_resilient_storage_settings(pragmas);
   }
+  // The high_throughput preset keeps the default pragmas, but inserts several messages per
+  // statement and builds the timestamp index once when closing, instead of on every insert.
+  rows_per_insert_ = high_throughput_preset ? HIGH_THROUGHPUT_ROWS_PER_INSERT : 1u;
+  delay_index_creation_ = high_throughput_preset;
 
   if (is_read_write(io_flag)) {
     relative_path_ = storage_options.uri + FILE_EXTENSION;
@@ -212,6 +230,7 @@ void SqliteStorage::open(
   // These will be reinitialized lazily on the first read or write.
   read_statement_ = nullptr;
   write_statement_ = nullptr;
+  batch_write_statement_ = nullptr;
 
   ROSBAG2_STORAGE_DEFAULT_PLUGINS_LOG_INFO_STREAM(
     "Opened database '" << relative_path_ << "' for " << to_string(io_flag) << ".");
@@ -253,15 +272,39 @@ void SqliteStorage::write_locked(
   if (!write_statement_) {
     prepare_for_writing();
   }
-  auto topic_entry = topics_.find(message->topic_name);
+  write_statement_->bind(
+    message->time_stamp, get_topic_id_locked(message->topic_name), message->serialized_data);
+  write_statement_->execute_and_reset();
+}
+
+void SqliteStorage::write_batch_locked(
+  std::vector<std::shared_ptr<const rosbag2_storage::SerializedBagMessage>>::const_iterator begin,
+  std::vector<std::shared_ptr<const rosbag2_storage::SerializedBagMessage>>::const_iterator end)
+{
+  // Look up all topics before binding, so that an unknown topic does not leave the statement
+  // partially bound
+  std::vector<int> topic_ids;
+  topic_ids.reserve(rows_per_insert_);
+  for (auto message = begin; message != end; ++message) {
+    topic_ids.push_back(get_topic_id_locked((*message)->topic_name));
+  }
+
+  auto topic_id = topic_ids.begin();
+  for (auto message = begin; message != end; ++message, ++topic_id) {
+    batch_write_statement_->bind((*message)->time_stamp, *topic_id, (*message)->serialized_data);
+  }
+  batch_write_statement_->execute_and_reset();
+}
+
+int SqliteStorage::get_topic_id_locked(const std::string & topic_name) const
+{
+  auto topic_entry = topics_.find(topic_name);
   if (topic_entry == end(topics_)) {
     throw SqliteException(
-            "Topic '" + message->topic_name +
+            "Topic '" + topic_name +
             "' has not been created yet! Call 'create_topic' first.");
   }
-
-  write_statement_->bind(message->time_stamp, topic_entry->second, message->serialized_data);
-  write_statement_->execute_and_reset();
+  return topic_entry->second;
 }
 
 void SqliteStorage::write(
@@ -274,8 +317,15 @@ void SqliteStorage::write(
 
   activate_transaction();
 
-  for (auto & message : messages) {
-    write_locked(message);
+  auto message = messages.begin();
+  if (batch_write_statement_) {
+    while (static_cast<size_t>(messages.end() - message) >= rows_per_insert_) {
+      write_batch_locked(message, message + rows_per_insert_);
+      message += rows_per_insert_;
+    }
+  }
+  for (; message != messages.end(); ++message) {
+    write_locked(*message);
   }
 
   commit_transaction();
@@ -301,6 +351,10 @@ std::shared_ptr<rosbag2_storage::SerializedBagMessage> SqliteStorage::read_next(
   bag_message->time_stamp = std::get<1>(*current_message_row_);
   bag_message->topic_name = std::get<2>(*current_message_row_);
 
+  // Remember the position, so that changing the filter continues after this message
+  seek_time_ = bag_message->time_stamp;
+  seek_row_id_ = std::get<3>(*current_message_row_) + 1;
+
   ++current_message_row_;
   return bag_message;
 }
@@ -336,8 +390,16 @@ void SqliteStorage::initialize()
     "timestamp INTEGER NOT NULL, " \
     "data BLOB NOT NULL);";
   database_->prepare_statement(create_stmt)->execute_and_reset();
-  create_stmt = "CREATE INDEX timestamp_idx ON messages (timestamp ASC);";
-  database_->prepare_statement(create_stmt)->execute_and_reset();
+  if (!delay_index_creation_) {
+    create_indices();
+  }
+}
+
+void SqliteStorage::create_indices()
+{
+  ROSBAG2_STORAGE_DEFAULT_PLUGINS_LOG_DEBUG_STREAM("create indices");
+  database_->prepare_statement(
+    "CREATE INDEX IF NOT EXISTS timestamp_idx ON messages (timestamp ASC);")->execute_and_reset();
 }
 
 void SqliteStorage::create_topic(const rosbag2_storage::TopicMetadata & topic)
@@ -372,10 +434,23 @@ void SqliteStorage::prepare_for_writing()
 {
   write_statement_ = database_->prepare_statement(
     "INSERT INTO messages (timestamp, topic_id, data) VALUES (?, ?, ?);");
+
+  if (rows_per_insert_ > 1u) {
+    std::string batch_insert = "INSERT INTO messages (timestamp, topic_id, data) VALUES (?, ?, ?)";
+    for (size_t i = 1; i < rows_per_insert_; ++i) {
+      batch_insert += ", (?, ?, ?)";
+    }
+    batch_write_statement_ = database_->prepare_statement(batch_insert + ";");
+  }
 }
 
 void SqliteStorage::prepare_for_reading()
 {
+  // The time condition is checked with the timestamp index, the row id breaks ties
+  std::string statement =
+    "SELECT data, timestamp, topics.name, messages.id "
+    "FROM messages JOIN topics ON messages.topic_id = topics.id "
+    "WHERE messages.timestamp >= ? AND (messages.timestamp > ? OR messages.id >= ?) ";
   if (!storage_filter_.topics.empty()) {
     // Construct string for selected topics
     std::string topic_list{""};
@@ -385,20 +460,14 @@ void SqliteStorage::prepare_for_reading()
         topic_list += ",";
       }
     }
-
-    read_statement_ = database_->prepare_statement(
-      "SELECT data, timestamp, topics.name "
-      "FROM messages JOIN topics ON messages.topic_id = topics.id "
-      "WHERE topics.name IN (" + topic_list + ")"
-      "ORDER BY messages.timestamp;");
-  } else {
-    read_statement_ = database_->prepare_statement(
-      "SELECT data, timestamp, topics.name "
-      "FROM messages JOIN topics ON messages.topic_id = topics.id "
-      "ORDER BY messages.timestamp;");
+    statement += "AND topics.name IN (" + topic_list + ") ";
   }
+  statement += "ORDER BY messages.timestamp, messages.id;";
+
+  read_statement_ = database_->prepare_statement(statement);
+  read_statement_->bind(seek_time_, seek_time_, seek_row_id_);
   message_result_ = read_statement_->execute_query<
-    std::shared_ptr<rcutils_uint8_array_t>, rcutils_time_point_value_t, std::string>();
+    std::shared_ptr<rcutils_uint8_array_t>, rcutils_time_point_value_t, std::string, int64_t>();
   current_message_row_ = message_result_.begin();
 }
 
@@ -478,11 +547,32 @@ void SqliteStorage::set_filter(
   const rosbag2_storage::StorageFilter & storage_filter)
 {
   storage_filter_ = storage_filter;
+  read_statement_ = nullptr;
 }
 
 void SqliteStorage::reset_filter()
 {
   storage_filter_ = rosbag2_storage::StorageFilter();
+  read_statement_ = nullptr;
+}
+
+void SqliteStorage::seek(const rcutils_time_point_value_t & timestamp)
+{
+  seek_time_ = timestamp;
+  seek_row_id_ = 0;
+  read_statement_ = nullptr;
+}
+
+rosbag2_storage::ReadPosition SqliteStorage::get_read_position() const
+{
+  return {seek_time_, seek_row_id_};
+}
+
+void SqliteStorage::set_read_position(const rosbag2_storage::ReadPosition & read_position)
+{
+  seek_time_ = read_position.time_stamp;
+  seek_row_id_ = read_position.sequence;
+  read_statement_ = nullptr;
 }
 
 std::string SqliteStorage::get_storage_setting(const std::string & key)
@@ -99,15 +99,26 @@ void SqliteWrapper::apply_pragma_settings(
     }
   }
 
+  auto apply_pragma = [this](
+    const std::string & pragma_name, const std::string & pragma_statement) {
+      // Apply the setting. Note that statements that assign value do not reliably return value
+      prepare_statement(pragma_statement)->execute_and_reset();
+
+      // Check if the value is set, reading the pragma
+      auto statement_for_check = "PRAGMA " + pragma_name + ";";
+      prepare_statement(statement_for_check)->execute_and_reset(true);
+    };
+
+  // The page size can not be changed anymore once the database was switched to WAL mode,
+  // so it is applied before any other setting
+  const auto page_size = pragmas.find("page_size");
+  if (page_size != pragmas.end()) {
+    apply_pragma(page_size->first, page_size->second);
+  }
   for (auto & kv : pragmas) {
-    // Apply the setting. Note that statements that assign value do not reliably return value
-    auto pragma_name = kv.first;
-    auto pragma_statement = kv.second;
-    prepare_statement(pragma_statement)->execute_and_reset();
-
-    // Check if the value is set, reading the pragma
-    auto statement_for_check = "PRAGMA " + pragma_name + ";";
-    prepare_statement(statement_for_check)->execute_and_reset(true);
+    if (kv.first != "page_size") {
+      apply_pragma(kv.first, kv.second);
+    }
   }
 }
 
@@ -0,0 +1,355 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rcpputils/filesystem_helper.hpp"
+
+#include "rosbag2_storage/ros_helper.hpp"
+#include "rosbag2_storage/storage_filter.hpp"
+#include "rosbag2_storage_default_plugins/chunked/chunk_format.hpp"
+#include "rosbag2_storage_default_plugins/chunked/chunked_storage.hpp"
+
+#include "rosbag2_test_common/temporary_directory_fixture.hpp"
+
+using namespace ::testing;  // NOLINT
+using namespace rosbag2_test_common;  // NOLINT
+
+using rosbag2_storage::storage_interfaces::IOFlag;
+
+class ChunkedStorageTestFixture : public TemporaryDirectoryFixture
+{
+public:
+  ChunkedStorageTestFixture()
+  {
+    const auto temp_dir = rcpputils::fs::path(temporary_dir_path_);
+    storage_options_.uri = (temp_dir / "rosbag").string();
+    storage_options_.storage_id = "chunked";
+    storage_options_.storage_config_uri = (temp_dir / "chunked_config.yaml").string();
+    // Use the smallest chunks, so that a few messages span several chunks
+    std::ofstream config(storage_options_.storage_config_uri);
+    config << "write:\n  chunk_size: 65536\n";
+  }
+
+  std::shared_ptr<rosbag2_storage::SerializedBagMessage> make_message(
+    const std::string & topic, int64_t time_stamp, size_t size = 1000)
+  {
+    const std::string content = topic + ":" + std::to_string(time_stamp);
+    std::string data(std::max(size, content.size()), '.');
+    data.replace(0, content.size(), content);
+    auto message = std::make_shared<rosbag2_storage::SerializedBagMessage>();
+    message->serialized_data = rosbag2_storage::make_serialized_message(data.data(), data.size());
+    message->time_stamp = time_stamp;
+    message->topic_name = topic;
+    return message;
+  }
+
+  std::string content(const std::shared_ptr<rosbag2_storage::SerializedBagMessage> & message)
+  {
+    const auto data = reinterpret_cast<const char *>(message->serialized_data->buffer);
+    const std::string text(data, message->serialized_data->buffer_length);
+    return text.substr(0, text.find('.'));
+  }
+
+  std::unique_ptr<rosbag2_storage_plugins::ChunkedStorage> open_for_reading()
+  {
+    auto storage = std::make_unique<rosbag2_storage_plugins::ChunkedStorage>();
+    auto options = storage_options_;
+    options.uri = storage_options_.uri + ".chunks";
+    storage->open(options, IOFlag::READ_ONLY);
+    return storage;
+  }
+
+  std::vector<std::string> read_all(rosbag2_storage_plugins::ChunkedStorage & storage)
+  {
+    std::vector<std::string> contents;
+    while (storage.has_next()) {
+      contents.push_back(content(storage.read_next()));
+    }
+    return contents;
+  }
+
+  // Writes 300 messages on two topics, /b lagging 1 ms behind /a, which spans several chunks
+  void write_two_topics()
+  {
+    rosbag2_storage_plugins::ChunkedStorage storage;
+    storage.open(storage_options_);
+    storage.create_topic({"/a", "type_a", "cdr", "qos_a"});
+    storage.create_topic({"/b", "type_b", "cdr", "qos_b"});
+    for (int64_t i = 0; i < 150; ++i) {
+      storage.write(make_message("/a", i * 10));
+      storage.write(make_message("/b", i * 10 - 1000000));
+    }
+  }
+
+  rosbag2_storage::StorageOptions storage_options_;
+};
+
+TEST_F(ChunkedStorageTestFixture, messages_are_read_in_time_order_across_chunks) {
+  {
+    rosbag2_storage_plugins::ChunkedStorage storage;
+    storage.open(storage_options_);
+    storage.create_topic({"/a", "type_a", "cdr", ""});
+    storage.create_topic({"/b", "type_b", "cdr", ""});
+    std::vector<std::shared_ptr<const rosbag2_storage::SerializedBagMessage>> messages;
+    for (int64_t i = 0; i < 200; ++i) {
+      // Messages of /b arrive late, so time ranges of the chunks overlap
+      messages.push_back(make_message("/a", i * 10));
+      messages.push_back(make_message("/b", (i < 10 ? 0 : i - 10) * 10 + 5));
+    }
+    storage.write(messages);
+    EXPECT_THAT(storage.get_bagfile_size(), Gt(2u * 65536u));
+  }
+
+  auto storage = open_for_reading();
+  int64_t last_time_stamp = INT64_MIN;
+  size_t count = 0;
+  while (storage->has_next()) {
+    auto message = storage->read_next();
+    EXPECT_THAT(message->time_stamp, Ge(last_time_stamp));
+    last_time_stamp = message->time_stamp;
+    EXPECT_THAT(content(message), StartsWith(message->topic_name + ":"));
+    ++count;
+  }
+  EXPECT_THAT(count, Eq(400u));
+}
+
+TEST_F(ChunkedStorageTestFixture, get_metadata_and_topics_from_chunk_indexes) {
+  write_two_topics();
+
+  auto storage = open_for_reading();
+  auto metadata = storage->get_metadata();
+  EXPECT_THAT(metadata.storage_identifier, Eq("chunked"));
+  EXPECT_THAT(metadata.message_count, Eq(300u));
+  EXPECT_THAT(metadata.starting_time.time_since_epoch(), Eq(std::chrono::nanoseconds(-1000000)));
+  EXPECT_THAT(metadata.duration, Eq(std::chrono::nanoseconds(1490 + 1000000)));
+  ASSERT_THAT(metadata.topics_with_message_count, SizeIs(2));
+  EXPECT_THAT(metadata.topics_with_message_count[0].topic_metadata.name, Eq("/a"));
+  EXPECT_THAT(metadata.topics_with_message_count[0].message_count, Eq(150u));
+  EXPECT_THAT(metadata.topics_with_message_count[1].topic_metadata.name, Eq("/b"));
+  EXPECT_THAT(
+    metadata.topics_with_message_count[1].topic_metadata.offered_qos_profiles, Eq("qos_b"));
+
+  auto topics = storage->get_all_topics_and_types();
+  ASSERT_THAT(topics, SizeIs(2));
+  EXPECT_THAT(topics[0].type, Eq("type_a"));
+  EXPECT_THAT(topics[1].type, Eq("type_b"));
+}
+
+TEST_F(ChunkedStorageTestFixture, filter_skips_other_topics) {
+  write_two_topics();
+
+  auto storage = open_for_reading();
+  rosbag2_storage::StorageFilter filter;
+  filter.topics = {"/a"};
+  storage->set_filter(filter);
+
+  auto contents = read_all(*storage);
+  ASSERT_THAT(contents, SizeIs(150));
+  EXPECT_THAT(contents.front(), Eq("/a:0"));
+  EXPECT_THAT(contents.back(), Eq("/a:1490"));
+}
+
+TEST_F(ChunkedStorageTestFixture, seek_continues_at_the_first_message_at_or_after_the_time) {
+  write_two_topics();
+
+  auto storage = open_for_reading();
+  storage->seek(705);
+  auto contents = read_all(*storage);
+  ASSERT_THAT(contents, SizeIs(79));
+  EXPECT_THAT(contents.front(), Eq("/a:710"));
+
+  storage->seek(-1000000 + 700);
+  ASSERT_TRUE(storage->has_next());
+  EXPECT_THAT(content(storage->read_next()), Eq("/b:-999300"));
+
+  storage->seek(100000);
+  EXPECT_FALSE(storage->has_next());
+}
+
+TEST_F(ChunkedStorageTestFixture, set_read_position_tells_apart_messages_with_the_same_time) {
+  {
+    rosbag2_storage_plugins::ChunkedStorage storage;
+    storage.open(storage_options_);
+    storage.create_topic({"/a", "type_a", "cdr", ""});
+    storage.create_topic({"/b", "type_b", "cdr", ""});
+    // All the messages have the same time and span several chunks
+    for (int64_t i = 0; i < 100; ++i) {
+      storage.write(make_message(i % 2 == 0 ? "/a" : "/b", 5));
+    }
+  }
+
+  auto storage = open_for_reading();
+  rosbag2_storage::StorageFilter filter;
+  filter.topics = {"/a"};
+  storage->set_filter(filter);
+  std::vector<rosbag2_storage::ReadPosition> positions;
+  for (size_t i = 0; i < 40; ++i) {
+    positions.push_back(storage->get_read_position());
+    ASSERT_TRUE(storage->has_next());
+    EXPECT_THAT(storage->read_next()->topic_name, Eq("/a"));
+  }
+
+  // Reading continues right after the 30th message of /a, so without the filter the message
+  // of /b before the 31st message of /a is read as well
+  storage->reset_filter();
+  storage->set_read_position(positions[30]);
+  auto contents = read_all(*storage);
+  ASSERT_THAT(contents, SizeIs(100u - 59u));
+  EXPECT_THAT(contents[0], Eq("/b:5"));
+  EXPECT_THAT(contents[1], Eq("/a:5"));
+
+  storage->set_filter(filter);
+  storage->set_read_position(positions[30]);
+  EXPECT_THAT(read_all(*storage), SizeIs(20u));
+}
+
+TEST_F(ChunkedStorageTestFixture, large_messages_get_a_chunk_of_their_own) {
+  {
+    rosbag2_storage_plugins::ChunkedStorage storage;
+    storage.open(storage_options_);
+    storage.create_topic({"/small", "type", "cdr", ""});
+    storage.create_topic({"/large", "type", "cdr", ""});
+    storage.write(make_message("/small", 1));
+    storage.write(make_message("/large", 2, 200000));
+    storage.write(make_message("/small", 3));
+  }
+
+  auto storage = open_for_reading();
+  std::vector<size_t> sizes;
+  while (storage->has_next()) {
+    sizes.push_back(storage->read_next()->serialized_data->buffer_length);
+  }
+  EXPECT_THAT(sizes, ElementsAre(1000u, 200000u, 1000u));
+}
+
+TEST_F(ChunkedStorageTestFixture, removed_topics_are_not_read) {
+  {
+    rosbag2_storage_plugins::ChunkedStorage storage;
+    storage.open(storage_options_);
+    storage.create_topic({"/a", "type_a", "cdr", ""});
+    storage.create_topic({"/b", "type_b", "cdr", ""});
+    storage.write(make_message("/a", 1));
+    storage.write(make_message("/b", 2));
+    storage.remove_topic({"/b", "type_b", "cdr", ""});
+  }
+
+  auto storage = open_for_reading();
+  EXPECT_THAT(read_all(*storage), ElementsAre("/a:1"));
+  EXPECT_THAT(storage->get_all_topics_and_types(), SizeIs(1));
+}
+
+TEST_F(ChunkedStorageTestFixture, incomplete_chunk_is_ignored_and_removed_when_appending) {
+  write_two_topics();
+  const auto bag_path = storage_options_.uri + ".chunks";
+  const auto complete_size = rcpputils::fs::path(bag_path).file_size();
+  {
+    // Simulate a crash while writing a chunk
+    std::ofstream bag(bag_path, std::ios::binary | std::ios::app);
+    bag << std::string(1000, 'x');
+  }
+  EXPECT_THAT(read_all(*open_for_reading()), SizeIs(300));
+
+  {
+    rosbag2_storage_plugins::ChunkedStorage storage;
+    auto options = storage_options_;
+    options.uri = bag_path;
+    storage.open(options, IOFlag::APPEND);
+    EXPECT_THAT(storage.get_bagfile_size(), Eq(complete_size));
+    storage.create_topic({"/c", "type_c", "cdr", ""});
+    storage.write(make_message("/c", 2000));
+    storage.write(make_message("/a", 2001));
+  }
+
+  auto storage = open_for_reading();
+  auto contents = read_all(*storage);
+  ASSERT_THAT(contents, SizeIs(302));
+  EXPECT_THAT(contents[300], Eq("/c:2000"));
+  EXPECT_THAT(contents[301], Eq("/a:2001"));
+  EXPECT_THAT(storage->get_metadata().message_count, Eq(302u));
+}
+
+TEST_F(ChunkedStorageTestFixture, chunk_with_corrupt_sizes_is_ignored) {
+  namespace chunked = rosbag2_storage_plugins::chunked;
+  write_two_topics();
+  const auto bag_path = storage_options_.uri + ".chunks";
+  std::string complete_bag;
+  {
+    std::ifstream bag(bag_path, std::ios::binary);
+    complete_bag.assign(std::istreambuf_iterator<char>(bag), std::istreambuf_iterator<char>());
+  }
+
+  chunked::ChunkHeader valid_header{};
+  valid_header.magic = chunked::CHUNK_MAGIC;
+  valid_header.version = chunked::CHUNK_FORMAT_VERSION;
+  valid_header.chunk_size = chunked::CHUNK_ALIGNMENT;
+  std::vector<chunked::ChunkHeader> corrupt_headers(4, valid_header);
+  // The message index offset computed from this data size wraps around to 0
+  corrupt_headers[0].data_size = UINT64_MAX - sizeof(chunked::ChunkHeader) + 1u;
+  corrupt_headers[1].chunk_size = 0u;
+  corrupt_headers[1].data_size = corrupt_headers[0].data_size;
+  corrupt_headers[2].data_size = chunked::CHUNK_ALIGNMENT;
+  corrupt_headers[3].topic_records_size = UINT64_MAX - 16u;
+  for (const auto & header : corrupt_headers) {
+    {
+      std::string chunk(chunked::CHUNK_ALIGNMENT, '\0');
+      std::memcpy(&chunk[0], &header, sizeof(header));
+      std::ofstream bag(bag_path, std::ios::binary | std::ios::trunc);
+      bag << complete_bag << chunk;
+    }
+    EXPECT_THAT(read_all(*open_for_reading()), SizeIs(300));
+
+    // Appending starts right after the last valid chunk
+    rosbag2_storage_plugins::ChunkedStorage storage;
+    auto options = storage_options_;
+    options.uri = bag_path;
+    storage.open(options, IOFlag::APPEND);
+    EXPECT_THAT(storage.get_bagfile_size(), Eq(complete_bag.size()));
+  }
+}
+
+TEST_F(ChunkedStorageTestFixture, writing_to_unknown_topic_throws) {
+  rosbag2_storage_plugins::ChunkedStorage storage;
+  storage.open(storage_options_);
+  EXPECT_THROW(storage.write(make_message("/unknown", 1)), std::runtime_error);
+}
+
+TEST_F(ChunkedStorageTestFixture, invalid_chunk_size_throws) {
+  {
+    std::ofstream config(storage_options_.storage_config_uri);
+    config << "write:\n  chunk_size: 100000\n";
+  }
+  rosbag2_storage_plugins::ChunkedStorage storage;
+  EXPECT_THROW(storage.open(storage_options_), std::runtime_error);
+}
+
+TEST_F(ChunkedStorageTestFixture, direct_io_writes_a_readable_bag) {
+  {
+    // Falls back to writing through the page cache if the file system does not support it
+    std::ofstream config(storage_options_.storage_config_uri);
+    config << "write:\n  chunk_size: 65536\n  direct_io: true\n";
+  }
+  write_two_topics();
+
+  EXPECT_THAT(read_all(*open_for_reading()), SizeIs(300));
+}
@@ -162,6 +162,111 @@ TEST_F(StorageTestFixture, read_next_returns_filtered_messages) {
   EXPECT_FALSE(readable_storage2->has_next());
 }
 
+TEST_F(StorageTestFixture, seek_continues_with_the_first_message_at_or_after_the_time) {
+  std::vector<std::tuple<std::string, int64_t, std::string, std::string, std::string>>
+  string_messages =
+  {std::make_tuple("first message", 1, "topic1", "", ""),
+    std::make_tuple("second message", 3, "topic2", "", ""),
+    std::make_tuple("third message", 3, "topic1", "", ""),
+    std::make_tuple("fourth message", 5, "topic2", "", "")};
+
+  write_messages_to_sqlite(string_messages);
+  std::unique_ptr<rosbag2_storage::storage_interfaces::ReadOnlyInterface> readable_storage =
+    std::make_unique<rosbag2_storage_plugins::SqliteStorage>();
+
+  auto db_filename = (rcpputils::fs::path(temporary_dir_path_) / "rosbag.db3").string();
+  readable_storage->open({db_filename, kPluginID});
+
+  readable_storage->seek(2);
+  ASSERT_TRUE(readable_storage->has_next());
+  EXPECT_THAT(readable_storage->read_next()->time_stamp, Eq(3));
+  ASSERT_TRUE(readable_storage->has_next());
+  EXPECT_THAT(readable_storage->read_next()->time_stamp, Eq(3));
+
+  // Seeking backwards, with a filter which stays in effect
+  rosbag2_storage::StorageFilter storage_filter;
+  storage_filter.topics.push_back("topic1");
+  readable_storage->set_filter(storage_filter);
+  readable_storage->seek(0);
+  ASSERT_TRUE(readable_storage->has_next());
+  EXPECT_THAT(readable_storage->read_next()->time_stamp, Eq(1));
+
+  readable_storage->seek(6);
+  EXPECT_FALSE(readable_storage->has_next());
+}
+
+TEST_F(StorageTestFixture, set_filter_continues_after_the_last_message_read) {
+  std::vector<std::tuple<std::string, int64_t, std::string, std::string, std::string>>
+  string_messages =
+  {std::make_tuple("first message", 1, "topic1", "", ""),
+    std::make_tuple("second message", 2, "topic2", "", ""),
+    std::make_tuple("third message", 2, "topic1", "", ""),
+    std::make_tuple("fourth message", 4, "topic2", "", ""),
+    std::make_tuple("fifth message", 5, "topic1", "", "")};
+
+  write_messages_to_sqlite(string_messages);
+  std::unique_ptr<rosbag2_storage::storage_interfaces::ReadOnlyInterface> readable_storage =
+    std::make_unique<rosbag2_storage_plugins::SqliteStorage>();
+
+  auto db_filename = (rcpputils::fs::path(temporary_dir_path_) / "rosbag.db3").string();
+  readable_storage->open({db_filename, kPluginID});
+
+  ASSERT_TRUE(readable_storage->has_next());
+  readable_storage->read_next();
+  ASSERT_TRUE(readable_storage->has_next());
+  EXPECT_THAT(readable_storage->read_next()->topic_name, Eq("topic2"));
+
+  rosbag2_storage::StorageFilter storage_filter;
+  storage_filter.topics.push_back("topic1");
+  readable_storage->set_filter(storage_filter);
+  std::vector<int64_t> time_stamps;
+  while (readable_storage->has_next()) {
+    time_stamps.push_back(readable_storage->read_next()->time_stamp);
+  }
+  EXPECT_THAT(time_stamps, ElementsAre(2, 5));
+}
+
+TEST_F(StorageTestFixture, set_read_position_tells_apart_messages_with_the_same_time) {
+  std::vector<std::tuple<std::string, int64_t, std::string, std::string, std::string>>
+  string_messages =
+  {std::make_tuple("first message", 1, "topic1", "", ""),
+    std::make_tuple("second message", 2, "topic2", "", ""),
+    std::make_tuple("third message", 2, "topic1", "", ""),
+    std::make_tuple("fourth message", 2, "topic2", "", ""),
+    std::make_tuple("fifth message", 4, "topic1", "", "")};
+
+  write_messages_to_sqlite(string_messages);
+  std::unique_ptr<rosbag2_storage::storage_interfaces::ReadOnlyInterface> readable_storage =
+    std::make_unique<rosbag2_storage_plugins::SqliteStorage>();
+
+  auto db_filename = (rcpputils::fs::path(temporary_dir_path_) / "rosbag.db3").string();
+  readable_storage->open({db_filename, kPluginID});
+
+  rosbag2_storage::StorageFilter storage_filter;
+  storage_filter.topics.push_back("topic1");
+  readable_storage->set_filter(storage_filter);
+  ASSERT_TRUE(readable_storage->has_next());
+  readable_storage->read_next();
+  ASSERT_TRUE(readable_storage->has_next());
+  EXPECT_THAT(readable_storage->read_next()->time_stamp, Eq(2));
+  const auto read_position = readable_storage->get_read_position();
+  ASSERT_TRUE(readable_storage->has_next());
+  EXPECT_THAT(readable_storage->read_next()->time_stamp, Eq(4));
+
+  // Only the message at time 2 after the one read comes again, unlike with seek(2)
+  readable_storage->reset_filter();
+  readable_storage->set_read_position(read_position);
+  std::vector<std::string> topics;
+  std::vector<int64_t> time_stamps;
+  while (readable_storage->has_next()) {
+    auto message = readable_storage->read_next();
+    topics.push_back(message->topic_name);
+    time_stamps.push_back(message->time_stamp);
+  }
+  EXPECT_THAT(topics, ElementsAre("topic2", "topic1"));
+  EXPECT_THAT(time_stamps, ElementsAre(2, 4));
+}
+
 TEST_F(StorageTestFixture, get_all_topics_and_types_returns_the_correct_vector) {
   std::unique_ptr<rosbag2_storage::storage_interfaces::ReadWriteInterface> writable_storage =
     std::make_unique<rosbag2_storage_plugins::SqliteStorage>();
@@ -362,6 +467,54 @@ TEST_F(StorageTestFixture, storage_preset_profile_applies_over_defaults) {
   EXPECT_EQ(writable_storage->get_storage_setting("synchronous"), "1");
 }
 
+TEST_F(StorageTestFixture, high_throughput_preset_writes_batches_and_indexes_on_close) {
+  // The page size has to be applied before switching to WAL mode to take effect
+  const auto yaml = "write:\n  pragmas: [\"journal_mode = WAL\", \"wal_autocheckpoint = 4096\", "
+    "\"page_size = 16384\"]\n";
+  auto options = make_storage_options_with_config(yaml, kPluginID);
+  const auto storage_uri = options.uri;
+  options.storage_preset_profile = "high_throughput";
+
+  // Not a multiple of the number of rows per insert, so both insert statements are used
+  const size_t message_count = 150;
+  {
+    auto writable_storage = std::make_unique<rosbag2_storage_plugins::SqliteStorage>();
+    writable_storage->open(options, rosbag2_storage::storage_interfaces::IOFlag::READ_WRITE);
+    EXPECT_EQ(writable_storage->get_storage_setting("journal_mode"), "wal");
+    EXPECT_EQ(writable_storage->get_storage_setting("wal_autocheckpoint"), "4096");
+    EXPECT_EQ(writable_storage->get_storage_setting("page_size"), "16384");
+
+    writable_storage->create_topic({"topic1", "type1", "rmw1", ""});
+    writable_storage->create_topic({"topic2", "type2", "rmw2", ""});
+    std::vector<std::shared_ptr<const rosbag2_storage::SerializedBagMessage>> messages;
+    for (size_t i = 0; i < message_count; ++i) {
+      auto bag_message = std::make_shared<rosbag2_storage::SerializedBagMessage>();
+      bag_message->serialized_data = make_serialized_message("message " + std::to_string(i));
+      bag_message->time_stamp = static_cast<rcutils_time_point_value_t>(i);
+      bag_message->topic_name = i % 2 ? "topic2" : "topic1";
+      messages.push_back(bag_message);
+    }
+    writable_storage->write(messages);
+
+    EXPECT_EQ(writable_storage->get_metadata().message_count, message_count);
+  }
+
+  rosbag2_storage_plugins::SqliteWrapper database(
+    storage_uri + ".db3", rosbag2_storage::storage_interfaces::IOFlag::READ_ONLY);
+  auto index = database.prepare_statement(
+    "SELECT name FROM sqlite_master WHERE type = 'index';")->execute_query<std::string>();
+  EXPECT_EQ(std::get<0>(index.get_single_line()), "timestamp_idx");
+
+  auto read_messages = read_all_messages_from_sqlite();
+  ASSERT_THAT(read_messages, SizeIs(message_count));
+  for (size_t i = 0; i < message_count; ++i) {
+    EXPECT_THAT(
+      deserialize_message(read_messages[i]->serialized_data), Eq("message " + std::to_string(i)));
+    EXPECT_THAT(read_messages[i]->time_stamp, Eq(static_cast<rcutils_time_point_value_t>(i)));
+    EXPECT_THAT(read_messages[i]->topic_name, Eq(i % 2 ? "topic2" : "topic1"));
+  }
+}
+
 TEST_F(StorageTestFixture, throws_on_invalid_pragma_in_config_file) {
   // Check that storage throws on invalid pragma statement in sqlite config
   const auto invalid_yaml = "write:\n  pragmas: [\"unrecognized_pragma_name = 2\"]\n";
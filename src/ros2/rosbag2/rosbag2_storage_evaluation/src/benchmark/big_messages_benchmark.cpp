@@ -16,6 +16,7 @@
 
 #include "writer/sqlite/separate_topic_table_sqlite_writer.h"
 #include "benchmark/writer/sqlite/sqlite_writer_benchmark.h"
+#include "writer/chunked/chunked_writer.h"
 #include "generators/message_generator.h"
 #include "profiler/profiler.h"
 #include "writer/sqlite/one_table_sqlite_writer.h"
@@ -123,5 +124,21 @@ int main(int argc, char ** argv)
     msg_size_bytes,
     transaction_size);
 
+  run_benchmark_repeatedly(5,
+    "Chunked",
+    std::make_shared<ChunkedWriter>(db_name),
+    db_name,
+    msg_count,
+    msg_size_bytes,
+    transaction_size);
+
+  run_benchmark_repeatedly(5,
+    "ChunkedDirectIO",
+    std::make_shared<ChunkedWriter>(db_name, 4 * 1024 * 1024, true),
+    db_name,
+    msg_count,
+    msg_size_bytes,
+    transaction_size);
+
   return EXIT_SUCCESS;
 }
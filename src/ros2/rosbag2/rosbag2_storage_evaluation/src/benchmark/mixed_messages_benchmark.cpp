@@ -16,6 +16,7 @@
 
 #include "writer/sqlite/separate_topic_table_sqlite_writer.h"
 #include "benchmark/writer/sqlite/sqlite_writer_benchmark.h"
+#include "writer/chunked/chunked_writer.h"
 #include "generators/message_generator.h"
 #include "profiler/profiler.h"
 #include "writer/sqlite/one_table_sqlite_writer.h"
@@ -172,6 +173,18 @@ int main(int argc, char ** argv)
     big_messages,
     big_message_blob_size, transaction_size, write_header);
 
+  run_benchmark_repeatedly(5,
+    "Chunked",
+    std::make_shared<ChunkedWriter>(db_name),
+    db_name,
+    loop_count,
+    small_messages,
+    small_message_blob_size,
+    medium_messages,
+    medium_message_blob_size,
+    big_messages,
+    big_message_blob_size, transaction_size);
+
   return EXIT_SUCCESS;
 }
 
@@ -17,8 +17,10 @@
 #include "writer/sqlite/separate_topic_table_sqlite_writer.h"
 #include <utility>
 #include "benchmark/writer/sqlite/sqlite_writer_benchmark.h"
+#include "writer/chunked/chunked_writer.h"
 #include "generators/message_generator.h"
 #include "profiler/profiler.h"
+#include "writer/sqlite/multi_row_sqlite_writer.h"
 #include "writer/sqlite/one_table_sqlite_writer.h"
 
 using namespace ros2bag;
@@ -122,5 +124,30 @@ int main(int argc, char ** argv)
     msg_size_bytes,
     transaction_size);
 
+  run_benchmark_repeatedly(5,
+    "MultiRowSqlite",
+    std::make_shared<MultiRowSqliteWriter>(
+      db_name,
+      transaction_size,
+      64,
+      Indices({{"MESSAGES", "TIMESTAMP"},
+               {"MESSAGES", "TOPIC"}}),
+      // Setting to "journal_mode" to "OFF" increases writing speed, but turns off transactions.
+      Pragmas({{"journal_mode", "MEMORY"},
+               {"synchronous",  "OFF"}})
+    ),
+    db_name,
+    msg_count,
+    msg_size_bytes,
+    transaction_size);
+
+  run_benchmark_repeatedly(5,
+    "Chunked",
+    std::make_shared<ChunkedWriter>(db_name),
+    db_name,
+    msg_count,
+    msg_size_bytes,
+    transaction_size);
+
   return EXIT_SUCCESS;
 }
@@ -15,15 +15,16 @@
  */
 
 #include "benchmark/writer/sqlite/sqlite_writer_benchmark.h"
+#include "writer/sqlite/multi_row_sqlite_writer.h"
 #include "writer/sqlite/one_table_sqlite_writer.h"
 
 using namespace ros2bag;
 
 int main(int argc, char ** argv)
 {
-  if (argc != 5) {
+  if (argc != 5 && argc != 6) {
     std::cerr << "Usage: benchmark <database file name> <number of messages> <message blob size> "
-              << "<messages per transaction>"
+              << "<messages per transaction> [<rows per insert>]"
               << std::endl;
     return EXIT_FAILURE;
   }
@@ -32,13 +33,17 @@ int main(int argc, char ** argv)
   unsigned int number_messages = static_cast<unsigned int>(std::stol(argv[2]));
   unsigned int message_blob_size = static_cast<unsigned int>(std::stol(argv[3]));
   unsigned int messages_per_transaction = static_cast<unsigned int>(std::stol(argv[4]));
+  unsigned int rows_per_insert = argc == 6 ? static_cast<unsigned int>(std::stol(argv[5])) : 1;
 
   MessageGenerator::Specification specification = {std::make_tuple("topic", message_blob_size)};
 
   std::vector<std::pair<std::string, std::string>> meta_data = {};
   SqliteWriterBenchmark benchmark(
     std::make_unique<MessageGenerator>(number_messages, specification),
-    std::make_unique<OneTableSqliteWriter>(database_name, messages_per_transaction),
+    rows_per_insert > 1 ?
+    std::shared_ptr<MessageWriter>(std::make_shared<MultiRowSqliteWriter>(
+      database_name, messages_per_transaction, rows_per_insert)) :
+    std::make_shared<OneTableSqliteWriter>(database_name, messages_per_transaction),
     std::make_unique<Profiler>(meta_data, database_name));
 
   benchmark.run();
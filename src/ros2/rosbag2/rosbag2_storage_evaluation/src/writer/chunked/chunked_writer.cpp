@@ -0,0 +1,185 @@
+/*
+ *  Copyright (c) 2021,  Open Source Robotics Foundation, Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "writer/chunked/chunked_writer.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+#include "generators/message.h"
+
+using namespace ros2bag;
+using namespace rosbag2_storage_plugins::chunked;
+
+void ChunkedWriter::open()
+{
+  if (fd_ >= 0) {
+    return;
+  }
+  int flags = O_WRONLY | O_CREAT | O_TRUNC;
+#ifdef O_DIRECT
+  if (direct_io_) {
+    flags |= O_DIRECT;
+  }
+#endif
+  fd_ = ::open(filename_.c_str(), flags, 0644);
+  if (fd_ < 0) {
+    throw std::runtime_error("could not open " + filename_);
+  }
+  topic_ids_.clear();
+  chunk_topic_records_.clear();
+  chunk_topic_record_count_ = 0;
+  start_chunk(chunk_size_);
+}
+
+void ChunkedWriter::close()
+{
+  if (fd_ >= 0) {
+    flush_chunk();
+    ::close(fd_);
+    fd_ = -1;
+  }
+}
+
+uint64_t ChunkedWriter::required_size(uint64_t message_size) const
+{
+  return message_index_offset(chunk_data_size_ + message_size) +
+         (chunk_messages_.size() + 1) * sizeof(MessageIndexEntry) +
+         (chunk_topics_.size() + 1) * sizeof(TopicIndexEntry) +
+         chunk_topic_records_.size();
+}
+
+void ChunkedWriter::write(MessagePtr message)
+{
+  auto topic = topic_ids_.find(message->topic());
+  if (topic == topic_ids_.end()) {
+    auto const topic_id = static_cast<uint32_t>(topic_ids_.size() + 1);
+    topic = topic_ids_.emplace(message->topic(), topic_id).first;
+
+    auto append = [this](void const * data, size_t size) {
+        auto bytes = static_cast<unsigned char const *>(data);
+        chunk_topic_records_.insert(chunk_topic_records_.end(), bytes, bytes + size);
+      };
+    uint32_t const flags = TOPIC_CREATED;
+    append(&topic_id, sizeof(topic_id));
+    append(&flags, sizeof(flags));
+    for (auto const & field : {message->topic(), std::string(), std::string(), std::string()}) {
+      auto const size = static_cast<uint32_t>(field.size());
+      append(&size, sizeof(size));
+      append(field.data(), field.size());
+    }
+    ++chunk_topic_record_count_;
+  }
+
+  auto const & blob = *message->blob();
+  if (required_size(blob.size()) > chunk_capacity_ && !chunk_messages_.empty()) {
+    flush_chunk();
+  }
+  if (required_size(blob.size()) > chunk_capacity_) {
+    start_chunk(align_chunk_size(required_size(blob.size())));
+  }
+
+  uint64_t const offset = sizeof(ChunkHeader) + chunk_data_size_;
+  std::memcpy(chunk_buffer_ + offset, blob.data(), blob.size());
+  chunk_data_size_ += blob.size();
+
+  int64_t const time_stamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    message->timestamp().time_since_epoch()).count();
+  chunk_messages_.push_back({time_stamp, offset, blob.size(), topic->second, 0});
+  auto & entry = chunk_topics_.emplace(
+    topic->second, TopicIndexEntry{topic->second, 0, time_stamp, time_stamp}).first->second;
+  ++entry.message_count;
+  entry.start_time = std::min(entry.start_time, time_stamp);
+  entry.end_time = std::max(entry.end_time, time_stamp);
+}
+
+void ChunkedWriter::start_chunk(uint64_t chunk_size)
+{
+  if (chunk_capacity_ != chunk_size) {
+    std::vector<unsigned char>(chunk_size + CHUNK_ALIGNMENT).swap(chunk_memory_);
+    auto const address = reinterpret_cast<uintptr_t>(chunk_memory_.data());
+    chunk_buffer_ = chunk_memory_.data() +
+      (CHUNK_ALIGNMENT - address % CHUNK_ALIGNMENT) % CHUNK_ALIGNMENT;
+    chunk_capacity_ = chunk_size;
+  }
+  chunk_data_size_ = 0;
+  chunk_messages_.clear();
+  chunk_topics_.clear();
+}
+
+void ChunkedWriter::flush_chunk()
+{
+  if (chunk_messages_.empty() && chunk_topic_record_count_ == 0) {
+    return;
+  }
+
+  std::stable_sort(chunk_messages_.begin(), chunk_messages_.end(),
+    [](MessageIndexEntry const & lhs, MessageIndexEntry const & rhs) {
+      return lhs.time_stamp < rhs.time_stamp;
+    });
+
+  ChunkHeader header {};
+  header.magic = CHUNK_MAGIC;
+  header.version = CHUNK_FORMAT_VERSION;
+  header.chunk_size = chunk_capacity_;
+  header.data_size = chunk_data_size_;
+  header.message_count = static_cast<uint32_t>(chunk_messages_.size());
+  header.topic_index_count = static_cast<uint32_t>(chunk_topics_.size());
+  header.topic_record_count = chunk_topic_record_count_;
+  header.topic_records_size = chunk_topic_records_.size();
+  header.start_time = chunk_messages_.empty() ? 0 : chunk_messages_.front().time_stamp;
+  header.end_time = chunk_messages_.empty() ? 0 : chunk_messages_.back().time_stamp;
+  std::memcpy(chunk_buffer_, &header, sizeof(header));
+
+  uint64_t offset = message_index_offset(chunk_data_size_);
+  std::memset(
+    chunk_buffer_ + sizeof(header) + chunk_data_size_, 0,
+    offset - sizeof(header) - chunk_data_size_);
+  if (!chunk_messages_.empty()) {
+    std::memcpy(chunk_buffer_ + offset, chunk_messages_.data(),
+      chunk_messages_.size() * sizeof(MessageIndexEntry));
+    offset += chunk_messages_.size() * sizeof(MessageIndexEntry);
+  }
+  for (auto const & topic : chunk_topics_) {
+    std::memcpy(chunk_buffer_ + offset, &topic.second, sizeof(topic.second));
+    offset += sizeof(topic.second);
+  }
+  if (!chunk_topic_records_.empty()) {
+    std::memcpy(chunk_buffer_ + offset, chunk_topic_records_.data(), chunk_topic_records_.size());
+    offset += chunk_topic_records_.size();
+  }
+  std::memset(chunk_buffer_ + offset, 0, chunk_capacity_ - offset);
+
+  unsigned char const * buffer = chunk_buffer_;
+  uint64_t remaining = chunk_capacity_;
+  while (remaining > 0) {
+    auto const written = ::write(fd_, buffer, remaining);
+    if (written < 0) {
+      throw std::runtime_error("could not write to " + filename_);
+    }
+    buffer += written;
+    remaining -= static_cast<uint64_t>(written);
+  }
+
+  chunk_topic_records_.clear();
+  chunk_topic_record_count_ = 0;
+  start_chunk(chunk_size_);
+}
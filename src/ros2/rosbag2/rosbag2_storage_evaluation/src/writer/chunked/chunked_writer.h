@@ -0,0 +1,95 @@
+/*
+ *  Copyright (c) 2021,  Open Source Robotics Foundation, Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef ROS2_ROSBAG_EVALUATION_CHUNKED_WRITER_H
+#define ROS2_ROSBAG_EVALUATION_CHUNKED_WRITER_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "rosbag2_storage_default_plugins/chunked/chunk_format.hpp"
+#include "writer/message_writer.h"
+
+namespace ros2bag
+{
+
+/**
+ * Writes messages in the chunk format of the chunked storage plugin: messages are copied into
+ * fixed-size chunks, which are written with a single call together with their time and topic
+ * indices, so there is no index to create afterwards.
+ */
+class ChunkedWriter : public MessageWriter
+{
+public:
+  explicit ChunkedWriter(
+    std::string const & filename,
+    uint64_t const chunk_size = 4 * 1024 * 1024,
+    bool const direct_io = false
+  ) : filename_(filename)
+    , chunk_size_(chunk_size)
+    , direct_io_(direct_io)
+    , fd_(-1)
+    , chunk_buffer_(nullptr)
+    , chunk_capacity_(0)
+    , chunk_data_size_(0)
+  {}
+
+  ~ChunkedWriter() override
+  {
+    ChunkedWriter::close();
+  }
+
+  void open() override;
+
+  void close() override;
+
+  void write(MessagePtr message) override;
+
+  void create_index() override
+  {}
+
+  void reset() override
+  {
+    topic_ids_.clear();
+  }
+
+private:
+  std::string const filename_;
+  uint64_t const chunk_size_;
+  bool const direct_io_;
+  int fd_;
+  std::vector<unsigned char> chunk_memory_;
+  unsigned char * chunk_buffer_;
+  uint64_t chunk_capacity_;
+  uint64_t chunk_data_size_;
+  std::vector<rosbag2_storage_plugins::chunked::MessageIndexEntry> chunk_messages_;
+  std::map<uint32_t, rosbag2_storage_plugins::chunked::TopicIndexEntry> chunk_topics_;
+  std::vector<unsigned char> chunk_topic_records_;
+  uint32_t chunk_topic_record_count_ = 0;
+  std::map<std::string, uint32_t> topic_ids_;
+
+  uint64_t required_size(uint64_t message_size) const;
+
+  void start_chunk(uint64_t chunk_size);
+
+  void flush_chunk();
+};
+
+}
+
+#endif //ROS2_ROSBAG_EVALUATION_CHUNKED_WRITER_H
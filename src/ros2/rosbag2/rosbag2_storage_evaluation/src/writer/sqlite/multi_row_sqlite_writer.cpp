@@ -0,0 +1,93 @@
+/*
+ *  Copyright (c) 2021,  Open Source Robotics Foundation, Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "writer/sqlite/multi_row_sqlite_writer.h"
+
+#include <string>
+
+#include "generators/message.h"
+#include "writer/sqlite/sqlite.h"
+
+using namespace ros2bag;
+
+
+void MultiRowSqliteWriter::close()
+{
+  if (is_open()) {
+    // Messages which did not fill a multi-row insert are written one by one
+    for (auto const & message : pending_messages_) {
+      bind_message(insert_message_stmt_, 1, message);
+      sqlite3_step(insert_message_stmt_);
+      sqlite3_reset(insert_message_stmt_);
+    }
+    pending_messages_.clear();
+
+    sqlite::finalize(insert_message_stmt_);
+    sqlite::finalize(insert_messages_stmt_);
+    SqliteWriter::close();
+  }
+}
+
+void MultiRowSqliteWriter::write_to_database(MessagePtr message)
+{
+  pending_messages_.push_back(message);
+  if (pending_messages_.size() < rows_per_insert_) {
+    return;
+  }
+
+  int column = 1;
+  for (auto const & pending_message : pending_messages_) {
+    bind_message(insert_messages_stmt_, column, pending_message);
+    column += 3;
+  }
+  sqlite3_step(insert_messages_stmt_);
+  sqlite3_reset(insert_messages_stmt_);
+  pending_messages_.clear();
+}
+
+void MultiRowSqliteWriter::bind_message(
+  sqlite::StatementPtr statement, int first_column, MessagePtr const & message)
+{
+  sqlite3_bind_int64(statement,
+    first_column, message->timestamp().time_since_epoch().count());
+  sqlite3_bind_text(statement,
+    first_column + 1, message->topic().c_str(), static_cast<int>(message->topic().size()),
+    SQLITE_TRANSIENT);
+  sqlite3_bind_blob(statement,
+    first_column + 2, message->blob()->data(), static_cast<int>(message->blob()->size()),
+    nullptr);
+}
+
+void MultiRowSqliteWriter::initialize_tables(sqlite::DBPtr db)
+{
+  sqlite::create_table(db, "MESSAGES", {
+    "TIMESTAMP INTEGER NOT NULL",
+    "TOPIC TEXT NOT NULL",
+    "DATA BLOB NOT NULL"
+  });
+}
+
+void MultiRowSqliteWriter::prepare_statements(sqlite::DBPtr db)
+{
+  insert_message_stmt_ = sqlite::new_insert_stmt(db, "MESSAGES", {"TIMESTAMP", "TOPIC", "DATA"});
+
+  std::string sql = "INSERT INTO MESSAGES(TIMESTAMP,TOPIC,DATA) VALUES(?,?,?)";
+  for (unsigned int i = 1; i < rows_per_insert_; ++i) {
+    sql += ",(?,?,?)";
+  }
+  sql += ";";
+  sqlite3_prepare_v2(db, sql.c_str(), static_cast<int>(sql.size()), &insert_messages_stmt_, nullptr);
+}
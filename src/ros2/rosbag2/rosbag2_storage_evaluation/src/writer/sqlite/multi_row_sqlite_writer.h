@@ -0,0 +1,82 @@
+/*
+ *  Copyright (c) 2021,  Open Source Robotics Foundation, Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef ROS2_ROSBAG_EVALUATION_MULTI_ROW_SQLITE_WRITER_H
+#define ROS2_ROSBAG_EVALUATION_MULTI_ROW_SQLITE_WRITER_H
+
+#include <ostream>
+#include <sqlite3.h>
+#include <vector>
+
+#include "writer/message_writer.h"
+#include "writer/sqlite/sqlite.h"
+#include "writer/sqlite/sqlite_writer.h"
+
+namespace ros2bag
+{
+
+/**
+ * Same schema as the OneTableSqliteWriter, but messages are inserted rows_per_insert at a time
+ * with a single multi-row INSERT statement, as done by the high_throughput storage preset.
+ */
+class MultiRowSqliteWriter : public SqliteWriter
+{
+public:
+  explicit MultiRowSqliteWriter(
+    std::string const & filename,
+    unsigned int const messages_per_transaction = 0,
+    unsigned int const rows_per_insert = 64,
+    Indices const & indices = {{"MESSAGES", "TOPIC"},
+                               {"MESSAGES", "TIMESTAMP"}},
+    Pragmas const & pragmas = {{"journal_mode", "MEMORY"},
+                               {"synchronous",  "OFF"}}
+  ) : SqliteWriter(filename, messages_per_transaction, indices, pragmas)
+    , rows_per_insert_(rows_per_insert)
+    , insert_message_stmt_(nullptr)
+    , insert_messages_stmt_(nullptr)
+  {}
+
+  ~MultiRowSqliteWriter() override
+  {
+    MultiRowSqliteWriter::close();
+  }
+
+  void close() override;
+
+  void reset() override
+  {
+    pending_messages_.clear();
+  }
+
+protected:
+  void initialize_tables(sqlite::DBPtr db) final;
+
+  void write_to_database(MessagePtr message) final;
+
+  void prepare_statements(sqlite::DBPtr db) final;
+
+private:
+  unsigned int const rows_per_insert_;
+  std::vector<MessagePtr> pending_messages_;
+  sqlite::StatementPtr insert_message_stmt_;
+  sqlite::StatementPtr insert_messages_stmt_;
+
+  void bind_message(sqlite::StatementPtr statement, int first_column, MessagePtr const & message);
+};
+
+}
+
+#endif //ROS2_ROSBAG_EVALUATION_MULTI_ROW_SQLITE_WRITER_H
@@ -15,6 +15,7 @@
 #ifndef ROSBAG2_TRANSPORT__PLAY_OPTIONS_HPP_
 #define ROSBAG2_TRANSPORT__PLAY_OPTIONS_HPP_
 
+#include <chrono>
 #include <cstddef>
 #include <string>
 #include <unordered_map>
@@ -44,6 +45,32 @@ public:
   // Rate in Hz at which to publish to /clock.
   // 0 (or negative) means that no publisher will be created
   double clock_publish_frequency = 0.0;
+
+  // Time before a message is due at which to stop sleeping and busy wait for it instead,
+  // which avoids the wake-up latency of the scheduler at the cost of CPU time.
+  // 0 only sleeps.
+  std::chrono::nanoseconds spin_wait_threshold = std::chrono::nanoseconds{0};
+
+  // Messages due within this window of bag time after the message being published
+  // are published right after it, instead of sleeping until each of them is due.
+  // 0 waits for every message.
+  std::chrono::nanoseconds publish_batch_window = std::chrono::nanoseconds{0};
+
+  // CPU to pin the thread publishing the messages to while playing.
+  // Negative values leave the thread on any CPU.
+  int publish_thread_cpu = -1;
+
+  // Log a histogram of how late messages were published at the end of each playback.
+  bool report_timing_statistics = false;
+
+  // Number of threads publishing the messages, with the topics spread over them.
+  // Each topic is published by one thread, so its messages keep their order.
+  // 0 or 1 publishes all messages from the thread playing the bag.
+  size_t publish_threads = 0;
+
+  // Maximum bag time by which a publishing thread may lag behind the message being played.
+  // Playback waits for lagging threads, which bounds the skew between topics.
+  std::chrono::nanoseconds max_publish_skew = std::chrono::milliseconds{100};
 };
 
 }  // namespace rosbag2_transport
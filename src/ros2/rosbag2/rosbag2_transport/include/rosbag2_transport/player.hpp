@@ -52,6 +52,8 @@ class Reader;
 namespace rosbag2_transport
 {
 
+class PublisherThreadPool;
+
 class Player : public rclcpp::Node
 {
 public:
@@ -152,6 +154,8 @@ private:
   bool skip_message_in_main_play_loop_ RCPPUTILS_TSA_GUARDED_BY
     (skip_message_in_main_play_loop_mutex_) = false;
   std::atomic_bool is_in_play_{false};
+  // Publishes the messages played from the queue if several publish threads are configured
+  std::unique_ptr<PublisherThreadPool> publisher_thread_pool_;
 
   rclcpp::Service<rosbag2_interfaces::srv::Pause>::SharedPtr srv_pause_;
   rclcpp::Service<rosbag2_interfaces::srv::Resume>::SharedPtr srv_resume_;
@@ -0,0 +1,142 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "playback_timing_statistics.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <string>
+
+namespace rosbag2_transport
+{
+
+namespace
+{
+rcutils_duration_value_t bucket_upper_bound_us(size_t index)
+{
+  return rcutils_duration_value_t{1} << index;
+}
+}  // namespace
+
+constexpr size_t PlaybackTimingStatistics::bucket_count;
+
+size_t PlaybackTimingStatistics::bucket_index(rcutils_duration_value_t error)
+{
+  auto error_us = static_cast<uint64_t>(error / 1000);
+  size_t index = 0;
+  while (error_us > 0 && index + 1 < bucket_count) {
+    error_us >>= 1;
+    ++index;
+  }
+  return index;
+}
+
+void PlaybackTimingStatistics::add(rcutils_duration_value_t error)
+{
+  if (count_ == 0) {
+    min_ = error;
+    max_ = error;
+  } else {
+    min_ = std::min(min_, error);
+    max_ = std::max(max_, error);
+  }
+  ++count_;
+  sum_ += static_cast<double>(error);
+  if (error < 0) {
+    ++early_count_;
+  } else {
+    ++buckets_[bucket_index(error)];
+  }
+}
+
+void PlaybackTimingStatistics::reset()
+{
+  *this = PlaybackTimingStatistics();
+}
+
+size_t PlaybackTimingStatistics::count() const
+{
+  return count_;
+}
+
+size_t PlaybackTimingStatistics::early_count() const
+{
+  return early_count_;
+}
+
+size_t PlaybackTimingStatistics::bucket(size_t index) const
+{
+  return buckets_.at(index);
+}
+
+rcutils_duration_value_t PlaybackTimingStatistics::min() const
+{
+  return min_;
+}
+
+rcutils_duration_value_t PlaybackTimingStatistics::max() const
+{
+  return max_;
+}
+
+rcutils_duration_value_t PlaybackTimingStatistics::mean() const
+{
+  return count_ == 0 ? 0 : static_cast<rcutils_duration_value_t>(sum_ / count_);
+}
+
+rcutils_duration_value_t PlaybackTimingStatistics::percentile_upper_bound(double fraction) const
+{
+  if (count_ == 0) {
+    return 0;
+  }
+  const auto target = static_cast<size_t>(std::ceil(fraction * count_));
+  size_t seen = early_count_;
+  if (seen >= target) {
+    return std::min<rcutils_duration_value_t>(0, max_);
+  }
+  for (size_t i = 0; i + 1 < bucket_count; ++i) {
+    seen += buckets_[i];
+    if (seen >= target) {
+      return std::min<rcutils_duration_value_t>(
+        RCUTILS_US_TO_NS(bucket_upper_bound_us(i)), max_);
+    }
+  }
+  return max_;
+}
+
+std::string PlaybackTimingStatistics::to_string() const
+{
+  std::stringstream stream;
+  stream << "Timing errors of " << count_ << " played messages: min " <<
+    RCUTILS_NS_TO_US(min_) << " us, mean " << RCUTILS_NS_TO_US(mean()) << " us, max " <<
+    RCUTILS_NS_TO_US(max_) << " us, 99% below " <<
+    RCUTILS_NS_TO_US(percentile_upper_bound(0.99)) << " us";
+  if (early_count_ > 0) {
+    stream << "\n  early: " << early_count_;
+  }
+  for (size_t i = 0; i < bucket_count; ++i) {
+    if (buckets_[i] == 0) {
+      continue;
+    }
+    if (i + 1 < bucket_count) {
+      stream << "\n  < " << bucket_upper_bound_us(i) << " us: " << buckets_[i];
+    } else {
+      stream << "\n  >= " << bucket_upper_bound_us(i - 1) << " us: " << buckets_[i];
+    }
+  }
+  return stream.str();
+}
+
+}  // namespace rosbag2_transport
@@ -0,0 +1,78 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROSBAG2_TRANSPORT__PLAYBACK_TIMING_STATISTICS_HPP_
+#define ROSBAG2_TRANSPORT__PLAYBACK_TIMING_STATISTICS_HPP_
+
+#include <array>
+#include <cstddef>
+#include <string>
+
+#include "rcutils/time.h"
+
+#include "rosbag2_transport/visibility_control.hpp"
+
+namespace rosbag2_transport
+{
+
+/// Histogram of the differences between the publish times of messages and their time stamps.
+/**
+ * Messages published late are counted in buckets doubling in width, starting at 1 us,
+ * so that rare large delays stand out without keeping every sample.
+ * Messages published early, e.g. when batching, are counted together.
+ */
+class ROSBAG2_TRANSPORT_PUBLIC PlaybackTimingStatistics
+{
+public:
+  /// Number of buckets for late messages, the last one holds delays of at least 2^19 us.
+  static constexpr size_t bucket_count = 21;
+
+  /// Add the timing error of a message, positive if it was published late.
+  void add(rcutils_duration_value_t error);
+
+  void reset();
+
+  size_t count() const;
+
+  size_t early_count() const;
+
+  /// Number of messages in the bucket, which holds errors in [2^(i-1) us, 2^i us), or [0, 1 us).
+  size_t bucket(size_t index) const;
+
+  rcutils_duration_value_t min() const;
+
+  rcutils_duration_value_t max() const;
+
+  rcutils_duration_value_t mean() const;
+
+  /// Upper bound of the bucket holding the given fraction of the messages, in nanoseconds.
+  rcutils_duration_value_t percentile_upper_bound(double fraction) const;
+
+  /// Summary and non-empty buckets, one per line.
+  std::string to_string() const;
+
+private:
+  static size_t bucket_index(rcutils_duration_value_t error);
+
+  std::array<size_t, bucket_count> buckets_ {};
+  size_t early_count_ {0};
+  size_t count_ {0};
+  rcutils_duration_value_t min_ {0};
+  rcutils_duration_value_t max_ {0};
+  double sum_ {0.0};
+};
+
+}  // namespace rosbag2_transport
+
+#endif  // ROSBAG2_TRANSPORT__PLAYBACK_TIMING_STATISTICS_HPP_
@@ -14,6 +14,11 @@
 
 #include "rosbag2_transport/player.hpp"
 
+#ifdef __linux__
+# include <pthread.h>
+# include <sched.h>
+#endif
+
 #include <algorithm>
 #include <chrono>
 #include <memory>
@@ -35,6 +40,8 @@
 
 #include "rosbag2_storage/storage_filter.hpp"
 
+#include "playback_timing_statistics.hpp"
+#include "publisher_thread_pool.hpp"
 #include "qos.hpp"
 
 namespace
@@ -69,6 +76,54 @@ rclcpp::QoS publisher_qos_for_topic(
   const auto offered_qos_profiles = profiles_yaml.as<std::vector<Rosbag2QoS>>();
   return Rosbag2QoS::adapt_offer_to_recorded_offers(topic.name, offered_qos_profiles);
 }
+
+/// Pins the calling thread to a CPU while in scope, restoring its previous affinity afterwards.
+class ScopedThreadAffinity
+{
+public:
+  ScopedThreadAffinity(int cpu, const rclcpp::Logger & logger)
+  {
+    if (cpu < 0) {
+      return;
+    }
+#ifdef __linux__
+    if (cpu >= CPU_SETSIZE ||
+      pthread_getaffinity_np(pthread_self(), sizeof(previous_), &previous_) != 0)
+    {
+      RCLCPP_WARN(logger, "Failed to pin the playback thread to CPU %d.", cpu);
+      return;
+    }
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(cpu, &cpu_set);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) != 0) {
+      RCLCPP_WARN(logger, "Failed to pin the playback thread to CPU %d.", cpu);
+      return;
+    }
+    pinned_ = true;
+#else
+    RCLCPP_WARN(logger, "Pinning the playback thread to a CPU is not supported on this platform.");
+#endif
+  }
+
+  ~ScopedThreadAffinity()
+  {
+#ifdef __linux__
+    if (pinned_) {
+      pthread_setaffinity_np(pthread_self(), sizeof(previous_), &previous_);
+    }
+#endif
+  }
+
+  ScopedThreadAffinity(const ScopedThreadAffinity &) = delete;
+  ScopedThreadAffinity & operator=(const ScopedThreadAffinity &) = delete;
+
+private:
+  bool pinned_ = false;
+#ifdef __linux__
+  cpu_set_t previous_;
+#endif
+};
 }  // namespace
 
 namespace rosbag2_transport
@@ -110,7 +165,9 @@ Player::Player(
     reader_->open(storage_options_, {"", rmw_get_serialization_format()});
     const auto starting_time = std::chrono::duration_cast<std::chrono::nanoseconds>(
       reader_->get_metadata().starting_time.time_since_epoch()).count();
-    clock_ = std::make_unique<rosbag2_cpp::TimeControllerClock>(starting_time);
+    clock_ = std::make_unique<rosbag2_cpp::TimeControllerClock>(
+      starting_time, std::chrono::steady_clock::now, std::chrono::milliseconds{100},
+      play_options_.spin_wait_threshold);
     set_rate(play_options_.rate);
 
     topic_qos_profile_overrides_ = play_options_.topic_qos_profile_overrides;
@@ -119,6 +176,14 @@ Player::Player(
     reader_->close();
   }
 
+  if (play_options_.publish_threads > 1) {
+    publisher_thread_pool_ = std::make_unique<PublisherThreadPool>(
+      play_options_.publish_threads, play_options_.max_publish_skew.count(),
+      [this](rosbag2_storage::SerializedBagMessageSharedPtr message) {
+        publish_message(message);
+      });
+  }
+
   srv_pause_ = create_service<rosbag2_interfaces::srv::Pause>(
     "~/pause",
     [this](
@@ -290,6 +355,10 @@ bool Player::play_next()
   }
 
   skip_message_in_main_play_loop_ = true;
+  if (publisher_thread_pool_) {
+    // Keep the order with the messages played before pausing
+    publisher_thread_pool_->wait_until_published();
+  }
   rosbag2_storage::SerializedBagMessageSharedPtr * message_ptr = peek_next_message_from_queue();
 
   bool next_message_published = false;
@@ -345,30 +414,54 @@ void Player::enqueue_up_to_boundary(uint64_t boundary)
 void Player::play_messages_from_queue()
 {
   playing_messages_from_queue_ = true;
+  ScopedThreadAffinity thread_affinity(play_options_.publish_thread_cpu, this->get_logger());
+  PlaybackTimingStatistics timing_statistics;
+  const auto batch_window = play_options_.publish_batch_window.count();
+  // Messages due up to this time are published without sleeping, if batching
+  bool in_batch = false;
+  rcutils_time_point_value_t batch_end = 0;
   // Note: We need to use message_queue_.peek() instead of message_queue_.try_dequeue(message)
   // to support play_next() API logic.
   rosbag2_storage::SerializedBagMessageSharedPtr * message_ptr = peek_next_message_from_queue();
   while (message_ptr != nullptr && rclcpp::ok()) {
     {
       rosbag2_storage::SerializedBagMessageSharedPtr message = *message_ptr;
-      // Do not move on until sleep_until returns true
-      // It will always sleep, so this is not a tight busy loop on pause
-      while (rclcpp::ok() && !clock_->sleep_until(message->time_stamp)) {}
+      if (!in_batch || message->time_stamp > batch_end || clock_->is_paused()) {
+        // Do not move on until sleep_until returns true
+        // It will always sleep, so this is not a tight busy loop on pause
+        while (rclcpp::ok() && !clock_->sleep_until(message->time_stamp)) {}
+        in_batch = batch_window > 0;
+        batch_end = message->time_stamp + batch_window;
+      }
       if (rclcpp::ok()) {
         {
           std::lock_guard<std::mutex> lk(skip_message_in_main_play_loop_mutex_);
           if (skip_message_in_main_play_loop_) {
             skip_message_in_main_play_loop_ = false;
+            in_batch = false;
             message_ptr = peek_next_message_from_queue();
             continue;
           }
         }
-        publish_message(message);
+        if (play_options_.report_timing_statistics) {
+          timing_statistics.add(clock_->now() - message->time_stamp);
+        }
+        if (publisher_thread_pool_) {
+          publisher_thread_pool_->publish(message);
+        } else {
+          publish_message(message);
+        }
       }
       message_queue_.pop();
       message_ptr = peek_next_message_from_queue();
     }
   }
+  if (publisher_thread_pool_) {
+    publisher_thread_pool_->wait_until_published();
+  }
+  if (play_options_.report_timing_statistics) {
+    RCLCPP_INFO_STREAM(this->get_logger(), timing_statistics.to_string());
+  }
   playing_messages_from_queue_ = false;
 }
 
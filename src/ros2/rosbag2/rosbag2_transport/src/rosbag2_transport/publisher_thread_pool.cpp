@@ -0,0 +1,151 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "publisher_thread_pool.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace rosbag2_transport
+{
+
+PublisherThreadPool::PublisherThreadPool(
+  size_t thread_count, rcutils_duration_value_t max_skew, PublishCallback publish)
+: max_skew_(max_skew),
+  publish_(std::move(publish))
+{
+  if (thread_count == 0) {
+    throw std::invalid_argument("PublisherThreadPool needs at least one thread.");
+  }
+  for (size_t i = 0; i < thread_count; ++i) {
+    workers_.push_back(std::make_unique<Worker>());
+  }
+  for (auto & worker : workers_) {
+    worker->thread = std::thread(&PublisherThreadPool::run, this, std::ref(*worker));
+  }
+}
+
+PublisherThreadPool::~PublisherThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  for (auto & worker : workers_) {
+    worker->queue_condition.notify_one();
+  }
+  for (auto & worker : workers_) {
+    worker->thread.join();
+  }
+}
+
+void PublisherThreadPool::publish(rosbag2_storage::SerializedBagMessageSharedPtr message)
+{
+  auto & worker = *workers_[thread_for_topic(message->topic_name)];
+  const auto oldest_allowed = message->time_stamp < INT64_MIN + max_skew_ ?
+    INT64_MIN : message->time_stamp - max_skew_;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    published_condition_.wait(
+      lock, [this, oldest_allowed]() {return error_ || !is_lagging_locked(oldest_allowed);});
+    rethrow_error_locked();
+    worker.queue.push_back(std::move(message));
+  }
+  worker.queue_condition.notify_one();
+}
+
+void PublisherThreadPool::wait_until_published()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  published_condition_.wait(lock, [this]() {return error_ || is_idle_locked();});
+  rethrow_error_locked();
+}
+
+void PublisherThreadPool::run(Worker & worker)
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    worker.queue_condition.wait(lock, [this, &worker]() {return stop_ || !worker.queue.empty();});
+    if (worker.queue.empty()) {
+      return;
+    }
+    auto message = std::move(worker.queue.front());
+    worker.queue.pop_front();
+    worker.publishing = true;
+    worker.publishing_time_stamp = message->time_stamp;
+    lock.unlock();
+    std::exception_ptr error;
+    try {
+      publish_(std::move(message));
+    } catch (...) {
+      error = std::current_exception();
+    }
+    lock.lock();
+    worker.publishing = false;
+    if (error && !error_) {
+      error_ = error;
+    }
+    published_condition_.notify_all();
+  }
+}
+
+bool PublisherThreadPool::is_lagging_locked(rcutils_time_point_value_t time_stamp) const
+{
+  for (const auto & worker : workers_) {
+    // Messages are published in order, so the oldest one is being published or first in line
+    if (worker->publishing) {
+      if (worker->publishing_time_stamp < time_stamp) {
+        return true;
+      }
+    } else if (!worker->queue.empty() && worker->queue.front()->time_stamp < time_stamp) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool PublisherThreadPool::is_idle_locked() const
+{
+  for (const auto & worker : workers_) {
+    if (worker->publishing || !worker->queue.empty()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void PublisherThreadPool::rethrow_error_locked()
+{
+  if (error_) {
+    auto error = error_;
+    error_ = nullptr;
+    std::rethrow_exception(error);
+  }
+}
+
+size_t PublisherThreadPool::thread_for_topic(const std::string & topic_name)
+{
+  // Topics are assigned in turns as they appear, which spreads the first topics evenly
+  auto it = topic_threads_.find(topic_name);
+  if (it == topic_threads_.end()) {
+    const auto thread = topic_threads_.size() % workers_.size();
+    it = topic_threads_.emplace(topic_name, thread).first;
+  }
+  return it->second;
+}
+
+}  // namespace rosbag2_transport
@@ -0,0 +1,109 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROSBAG2_TRANSPORT__PUBLISHER_THREAD_POOL_HPP_
+#define ROSBAG2_TRANSPORT__PUBLISHER_THREAD_POOL_HPP_
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "rcutils/time.h"
+
+#include "rosbag2_storage/serialized_bag_message.hpp"
+
+#include "rosbag2_transport/visibility_control.hpp"
+
+namespace rosbag2_transport
+{
+
+/// Threads publishing the played messages, with the topics sharded over them.
+/**
+ * All messages of a topic are published by the same thread, in the order they were handed over.
+ * To bound the skew between topics, handing over a message waits while any thread still has to
+ * publish a message which is older than it by more than the maximum skew, in bag time.
+ */
+class ROSBAG2_TRANSPORT_PUBLIC PublisherThreadPool
+{
+public:
+  using PublishCallback = std::function<void (rosbag2_storage::SerializedBagMessageSharedPtr)>;
+
+  /**
+   * \param thread_count number of publishing threads
+   * \param max_skew maximum bag time by which a thread may lag behind the latest message
+   * \param publish called from the publishing threads for every message
+   */
+  PublisherThreadPool(
+    size_t thread_count, rcutils_duration_value_t max_skew, PublishCallback publish);
+
+  /// Publishes the remaining messages and stops the threads.
+  ~PublisherThreadPool();
+
+  PublisherThreadPool(const PublisherThreadPool &) = delete;
+  PublisherThreadPool & operator=(const PublisherThreadPool &) = delete;
+
+  /// Hand over a message to the thread of its topic.
+  /**
+   * Must only be called from one thread at a time.
+   * Rethrows the first exception thrown by the publish callback.
+   */
+  void publish(rosbag2_storage::SerializedBagMessageSharedPtr message);
+
+  /// Wait until all messages handed over are published.
+  /**
+   * Rethrows the first exception thrown by the publish callback.
+   */
+  void wait_until_published();
+
+private:
+  struct Worker
+  {
+    std::deque<rosbag2_storage::SerializedBagMessageSharedPtr> queue;
+    std::condition_variable queue_condition;
+    bool publishing = false;
+    rcutils_time_point_value_t publishing_time_stamp = 0;
+    std::thread thread;
+  };
+
+  void run(Worker & worker);
+  // Whether a thread still has to publish a message older than the time stamp
+  bool is_lagging_locked(rcutils_time_point_value_t time_stamp) const;
+  bool is_idle_locked() const;
+  void rethrow_error_locked();
+  size_t thread_for_topic(const std::string & topic_name);
+
+  const rcutils_duration_value_t max_skew_;
+  const PublishCallback publish_;
+
+  // Only used from the thread handing over the messages
+  std::unordered_map<std::string, size_t> topic_threads_;
+
+  std::mutex mutex_;
+  // Notified whenever a thread finished publishing a message
+  std::condition_variable published_condition_;
+  std::vector<std::unique_ptr<Worker>> workers_;
+  bool stop_ = false;
+  std::exception_ptr error_;
+};
+
+}  // namespace rosbag2_transport
+
+#endif  // ROSBAG2_TRANSPORT__PUBLISHER_THREAD_POOL_HPP_
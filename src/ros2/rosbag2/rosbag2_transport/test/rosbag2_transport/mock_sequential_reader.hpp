@@ -79,6 +79,15 @@ public:
     filter_ = rosbag2_storage::StorageFilter();
   }
 
+  void seek(const rcutils_time_point_value_t & timestamp) override
+  {
+    // Messages are prepared in time order
+    num_read_ = 0;
+    while (num_read_ < messages_.size() && messages_[num_read_]->time_stamp < timestamp) {
+      num_read_++;
+    }
+  }
+
   void prepare(
     std::vector<std::shared_ptr<rosbag2_storage::SerializedBagMessage>> messages,
     std::vector<rosbag2_storage::TopicMetadata> topics)
@@ -108,6 +108,48 @@ TEST_F(RosBag2PlayTestFixture, recorded_messages_are_played_for_all_topics)
           ElementsAre(40.0f, 2.0f, 0.0f)))));
 }
 
+TEST_F(RosBag2PlayTestFixture, recorded_messages_are_played_from_several_publish_threads)
+{
+  auto topic_types = std::vector<rosbag2_storage::TopicMetadata>{
+    {"topic1", "test_msgs/BasicTypes", "", ""},
+    {"topic2", "test_msgs/BasicTypes", "", ""},
+  };
+
+  std::vector<std::shared_ptr<rosbag2_storage::SerializedBagMessage>> messages;
+  for (int32_t i = 0; i < 3; ++i) {
+    auto message = get_messages_basic_types()[0];
+    message->int32_value = i;
+    messages.push_back(serialize_test_message("topic1", 500 + 200 * i, message));
+    messages.push_back(serialize_test_message("topic2", 550 + 200 * i, message));
+  }
+
+  auto prepared_mock_reader = std::make_unique<MockSequentialReader>();
+  prepared_mock_reader->prepare(messages, topic_types);
+  auto reader = std::make_unique<rosbag2_cpp::Reader>(std::move(prepared_mock_reader));
+
+  sub_->add_subscription<test_msgs::msg::BasicTypes>("/topic1", 2);
+  sub_->add_subscription<test_msgs::msg::BasicTypes>("/topic2", 2);
+
+  auto await_received_messages = sub_->spin_subscriptions();
+
+  play_options_.publish_threads = 2;
+  auto player = std::make_shared<rosbag2_transport::Player>(
+    std::move(reader), storage_options_, play_options_);
+  player->play();
+
+  await_received_messages.get();
+
+  for (const auto & topic : {"/topic1", "/topic2"}) {
+    auto replayed_messages = sub_->get_received_messages<test_msgs::msg::BasicTypes>(topic);
+    ASSERT_THAT(replayed_messages, SizeIs(Ge(2u)));
+    // Messages of a topic keep their order
+    for (size_t i = 1; i < replayed_messages.size(); ++i) {
+      EXPECT_THAT(
+        replayed_messages[i]->int32_value, Gt(replayed_messages[i - 1]->int32_value));
+    }
+  }
+}
+
 TEST_F(RosBag2PlayTestFixture, recorded_messages_are_played_for_all_topics_with_unknown_type)
 {
   auto primitive_message1 = get_messages_basic_types()[0];
@@ -191,3 +191,59 @@ TEST_F(PlayerTestFixture, playing_respects_rate)
     ASSERT_THAT(replay_time, Gt(message_time_difference));
   }
 }
+
+TEST_F(PlayerTestFixture, playing_with_spin_wait_respects_relative_timing)
+{
+  auto primitive_message = get_messages_strings()[0];
+  auto message_time_difference = std::chrono::milliseconds(500);
+  auto topics_and_types =
+    std::vector<rosbag2_storage::TopicMetadata>{{"topic1", "test_msgs/Strings", "", ""}};
+  std::vector<std::shared_ptr<rosbag2_storage::SerializedBagMessage>> messages =
+  {serialize_test_message("topic1", 0, primitive_message),
+    serialize_test_message("topic1", 0, primitive_message)};
+  messages[0]->time_stamp = 100;
+  messages[1]->time_stamp =
+    messages[0]->time_stamp + std::chrono::nanoseconds(message_time_difference).count();
+
+  play_options_.spin_wait_threshold = std::chrono::milliseconds(2);
+  play_options_.publish_thread_cpu = 0;
+  play_options_.report_timing_statistics = true;
+
+  auto prepared_mock_reader = std::make_unique<MockSequentialReader>();
+  prepared_mock_reader->prepare(messages, topics_and_types);
+  auto reader = std::make_unique<rosbag2_cpp::Reader>(std::move(prepared_mock_reader));
+  auto player = std::make_shared<rosbag2_transport::Player>(
+    std::move(reader), storage_options_, play_options_);
+  auto start = std::chrono::steady_clock::now();
+  player->play();
+  auto replay_time = std::chrono::steady_clock::now() - start;
+
+  ASSERT_THAT(replay_time, Gt(message_time_difference));
+}
+
+TEST_F(PlayerTestFixture, messages_within_batch_window_are_played_without_waiting)
+{
+  auto primitive_message = get_messages_strings()[0];
+  auto message_time_difference = std::chrono::seconds(1);
+  auto topics_and_types =
+    std::vector<rosbag2_storage::TopicMetadata>{{"topic1", "test_msgs/Strings", "", ""}};
+  std::vector<std::shared_ptr<rosbag2_storage::SerializedBagMessage>> messages =
+  {serialize_test_message("topic1", 0, primitive_message),
+    serialize_test_message("topic1", 0, primitive_message)};
+  messages[0]->time_stamp = 100;
+  messages[1]->time_stamp =
+    messages[0]->time_stamp + std::chrono::nanoseconds(message_time_difference).count();
+
+  play_options_.publish_batch_window = 2 * message_time_difference;
+
+  auto prepared_mock_reader = std::make_unique<MockSequentialReader>();
+  prepared_mock_reader->prepare(messages, topics_and_types);
+  auto reader = std::make_unique<rosbag2_cpp::Reader>(std::move(prepared_mock_reader));
+  auto player = std::make_shared<rosbag2_transport::Player>(
+    std::move(reader), storage_options_, play_options_);
+  auto start = std::chrono::steady_clock::now();
+  player->play();
+  auto replay_time = std::chrono::steady_clock::now() - start;
+
+  ASSERT_THAT(replay_time, Lt(message_time_difference));
+}
@@ -0,0 +1,77 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <string>
+
+#include "./playback_timing_statistics.hpp"
+
+using namespace ::testing;  // NOLINT
+
+using rosbag2_transport::PlaybackTimingStatistics;
+
+TEST(TestPlaybackTimingStatistics, errors_are_counted_in_doubling_buckets) {
+  PlaybackTimingStatistics statistics;
+  statistics.add(RCUTILS_US_TO_NS(-5));
+  statistics.add(500);
+  statistics.add(RCUTILS_US_TO_NS(1));
+  statistics.add(RCUTILS_US_TO_NS(3));
+  statistics.add(RCUTILS_US_TO_NS(1000));
+  statistics.add(RCUTILS_S_TO_NS(10));
+
+  EXPECT_THAT(statistics.count(), Eq(6u));
+  EXPECT_THAT(statistics.early_count(), Eq(1u));
+  EXPECT_THAT(statistics.bucket(0), Eq(1u));
+  EXPECT_THAT(statistics.bucket(1), Eq(1u));
+  EXPECT_THAT(statistics.bucket(2), Eq(1u));
+  // 1000 us is in [512 us, 1024 us)
+  EXPECT_THAT(statistics.bucket(10), Eq(1u));
+  EXPECT_THAT(statistics.bucket(PlaybackTimingStatistics::bucket_count - 1), Eq(1u));
+  EXPECT_THAT(statistics.min(), Eq(RCUTILS_US_TO_NS(-5)));
+  EXPECT_THAT(statistics.max(), Eq(RCUTILS_S_TO_NS(10)));
+}
+
+TEST(TestPlaybackTimingStatistics, percentile_upper_bound_is_the_end_of_the_bucket) {
+  PlaybackTimingStatistics statistics;
+  EXPECT_THAT(statistics.percentile_upper_bound(0.99), Eq(0));
+
+  for (int i = 0; i < 99; ++i) {
+    statistics.add(RCUTILS_US_TO_NS(20));
+  }
+  statistics.add(RCUTILS_US_TO_NS(5000));
+
+  EXPECT_THAT(statistics.percentile_upper_bound(0.5), Eq(RCUTILS_US_TO_NS(32)));
+  EXPECT_THAT(statistics.percentile_upper_bound(0.99), Eq(RCUTILS_US_TO_NS(32)));
+  EXPECT_THAT(statistics.percentile_upper_bound(1.0), Eq(RCUTILS_US_TO_NS(5000)));
+  EXPECT_THAT(statistics.mean(), Eq(RCUTILS_US_TO_NS(20 * 99 + 5000) / 100));
+}
+
+TEST(TestPlaybackTimingStatistics, to_string_lists_non_empty_buckets) {
+  PlaybackTimingStatistics statistics;
+  statistics.add(-1);
+  statistics.add(RCUTILS_US_TO_NS(3));
+  statistics.add(RCUTILS_S_TO_NS(10));
+
+  const auto text = statistics.to_string();
+  EXPECT_THAT(text, StartsWith("Timing errors of 3 played messages"));
+  EXPECT_THAT(text, HasSubstr("\n  early: 1"));
+  EXPECT_THAT(text, HasSubstr("\n  < 4 us: 1"));
+  EXPECT_THAT(text, HasSubstr("\n  >= 524288 us: 1"));
+  EXPECT_THAT(text, Not(HasSubstr("< 2 us")));
+
+  statistics.reset();
+  EXPECT_THAT(statistics.count(), Eq(0u));
+  EXPECT_THAT(statistics.early_count(), Eq(0u));
+}
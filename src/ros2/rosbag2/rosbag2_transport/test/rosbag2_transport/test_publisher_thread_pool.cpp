@@ -0,0 +1,112 @@
+// Copyright 2021 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "./publisher_thread_pool.hpp"
+
+using namespace ::testing;  // NOLINT
+
+using rosbag2_transport::PublisherThreadPool;
+
+namespace
+{
+rosbag2_storage::SerializedBagMessageSharedPtr make_message(
+  const std::string & topic_name, rcutils_time_point_value_t time_stamp)
+{
+  auto message = std::make_shared<rosbag2_storage::SerializedBagMessage>();
+  message->topic_name = topic_name;
+  message->time_stamp = time_stamp;
+  return message;
+}
+}  // namespace
+
+TEST(TestPublisherThreadPool, messages_of_a_topic_are_published_in_order) {
+  std::mutex mutex;
+  std::map<std::string, std::vector<rcutils_time_point_value_t>> published;
+  {
+    PublisherThreadPool pool(
+      4, RCUTILS_S_TO_NS(1),
+      [&mutex, &published](rosbag2_storage::SerializedBagMessageSharedPtr message) {
+        std::lock_guard<std::mutex> lock(mutex);
+        published[message->topic_name].push_back(message->time_stamp);
+      });
+    for (rcutils_time_point_value_t time_stamp = 0; time_stamp < 1000; ++time_stamp) {
+      pool.publish(make_message("topic_" + std::to_string(time_stamp % 10), time_stamp));
+    }
+    pool.wait_until_published();
+  }
+
+  ASSERT_THAT(published, SizeIs(10));
+  for (const auto & topic : published) {
+    ASSERT_THAT(topic.second, SizeIs(100));
+    EXPECT_TRUE(std::is_sorted(topic.second.begin(), topic.second.end()));
+  }
+}
+
+TEST(TestPublisherThreadPool, publish_waits_for_threads_lagging_more_than_the_skew) {
+  std::promise<void> slow_publish_done;
+  auto slow_publish_future = slow_publish_done.get_future().share();
+  PublisherThreadPool pool(
+    2, 100,
+    [slow_publish_future](rosbag2_storage::SerializedBagMessageSharedPtr message) {
+      if (message->topic_name == "slow") {
+        slow_publish_future.wait();
+      }
+    });
+  pool.publish(make_message("slow", 0));
+  // Within the skew of the slow message
+  pool.publish(make_message("fast", 100));
+
+  auto lagging_publish = std::async(
+    std::launch::async, [&pool]() {pool.publish(make_message("fast", 101));});
+  EXPECT_THAT(
+    lagging_publish.wait_for(std::chrono::milliseconds(100)), Eq(std::future_status::timeout));
+
+  slow_publish_done.set_value();
+  EXPECT_THAT(
+    lagging_publish.wait_for(std::chrono::seconds(10)), Eq(std::future_status::ready));
+  pool.wait_until_published();
+}
+
+TEST(TestPublisherThreadPool, publish_errors_are_rethrown) {
+  PublisherThreadPool pool(
+    2, RCUTILS_S_TO_NS(1),
+    [](rosbag2_storage::SerializedBagMessageSharedPtr message) {
+      if (message->topic_name == "broken") {
+        throw std::runtime_error("failed to publish");
+      }
+    });
+  pool.publish(make_message("broken", 0));
+  EXPECT_THROW(pool.wait_until_published(), std::runtime_error);
+
+  pool.publish(make_message("other", 1));
+  EXPECT_NO_THROW(pool.wait_until_published());
+}
+
+TEST(TestPublisherThreadPool, zero_threads_throws) {
+  EXPECT_THROW(
+    PublisherThreadPool(0, 0, [](rosbag2_storage::SerializedBagMessageSharedPtr) {}),
+    std::invalid_argument);
+}